@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/zip_io.h"
+#include "core/templates/local_vector.h"
 
 #include "thirdparty/misc/fastlz.h"
 
@@ -349,6 +350,433 @@ int Compression::decompress_dynamic(Vector<uint8_t> *p_dst_vect, int p_max_dst_s
 	}
 }
 
+int Compression::get_default_level(Mode p_mode) {
+	switch (p_mode) {
+		case MODE_DEFLATE:
+			return zlib_level;
+		case MODE_GZIP:
+			return gzip_level;
+		case MODE_ZSTD:
+			return zstd_level;
+		case MODE_FASTLZ:
+		case MODE_BROTLI:
+			return 0; // No configurable level.
+	}
+	return 0;
+}
+
+static _FORCE_INLINE_ uint32_t _dmer_hash(const uint8_t *p_data, uint32_t p_bits) {
+	uint64_t v;
+	memcpy(&v, p_data, sizeof(uint64_t));
+	return (uint32_t)((v * 0xCF1BBCDCB7A56463ULL) >> (64 - p_bits));
+}
+
+/**
+	Builds a raw content dictionary for Zstandard from sample payloads.
+	This is a reduced version of the "fast cover" algorithm used by the zstd trainer, which is not bundled:
+	8-byte d-mers are counted in a hashed frequency table, the samples are split into epochs, and the
+	64-byte segment with the highest score in each epoch is picked until the dictionary is full.
+	Segments picked first are placed at the end of the dictionary, where matches are cheapest.
+*/
+Vector<uint8_t> Compression::train_zstd_dictionary(const Vector<Vector<uint8_t>> &p_samples, int p_max_size) {
+	ERR_FAIL_COND_V(p_max_size <= 0, Vector<uint8_t>());
+
+	const int DMER_SIZE = 8;
+	const int SEGMENT_SIZE = 64;
+
+	int total = 0;
+	for (const Vector<uint8_t> &sample : p_samples) {
+		total += sample.size();
+	}
+
+	Vector<uint8_t> content;
+	content.resize(total);
+	uint8_t *content_ptr = content.ptrw();
+	for (const Vector<uint8_t> &sample : p_samples) {
+		memcpy(content_ptr, sample.ptr(), sample.size());
+		content_ptr += sample.size();
+	}
+
+	if (total <= p_max_size || total < SEGMENT_SIZE) {
+		// Everything fits, no need to pick.
+		return content;
+	}
+
+	const uint8_t *data = content.ptr();
+	const int dmer_count = total - DMER_SIZE + 1;
+	const uint32_t hash_bits = CLAMP(nearest_shift(dmer_count), 12u, 20u);
+
+	LocalVector<uint32_t> hashes;
+	hashes.resize(dmer_count);
+	LocalVector<uint32_t> freqs;
+	freqs.resize(1 << hash_bits);
+	memset(freqs.ptr(), 0, freqs.size() * sizeof(uint32_t));
+	for (int i = 0; i < dmer_count; i++) {
+		hashes[i] = _dmer_hash(data + i, hash_bits);
+		freqs[hashes[i]]++;
+	}
+
+	// Counts of each d-mer inside the sliding segment, so repeated d-mers only score once.
+	LocalVector<uint8_t> segment_freqs;
+	segment_freqs.resize(1 << hash_bits);
+	memset(segment_freqs.ptr(), 0, segment_freqs.size());
+
+	const int window = SEGMENT_SIZE - DMER_SIZE + 1;
+	const int epoch_size = MAX(SEGMENT_SIZE, dmer_count / MAX(1, p_max_size / SEGMENT_SIZE));
+	const int epoch_count = (dmer_count + epoch_size - 1) / epoch_size;
+
+	Vector<uint8_t> dictionary;
+	dictionary.resize(p_max_size);
+	int tail = p_max_size;
+	int empty_epochs = 0;
+
+	for (int epoch = 0; tail > 0 && empty_epochs < epoch_count; epoch = (epoch + 1) % epoch_count) {
+		const int begin = epoch * epoch_size;
+		const int end = MIN(begin + epoch_size, dmer_count);
+
+		uint64_t score = 0;
+		uint64_t best_score = 0;
+		int best_begin = begin;
+		int best_end = begin;
+		int active_begin = begin;
+		for (int pos = begin; pos < end; pos++) {
+			const uint32_t h = hashes[pos];
+			if (segment_freqs[h] == 0) {
+				score += freqs[h];
+			}
+			segment_freqs[h]++;
+
+			if (pos - active_begin >= window) {
+				const uint32_t old_h = hashes[active_begin];
+				segment_freqs[old_h]--;
+				if (segment_freqs[old_h] == 0) {
+					score -= freqs[old_h];
+				}
+				active_begin++;
+			}
+
+			if (score > best_score) {
+				best_score = score;
+				best_begin = active_begin;
+				best_end = pos + DMER_SIZE;
+			}
+		}
+		for (int pos = active_begin; pos < end; pos++) {
+			segment_freqs[hashes[pos]] = 0;
+		}
+
+		if (best_score == 0) {
+			empty_epochs++;
+			continue;
+		}
+		empty_epochs = 0;
+
+		// Content already in the dictionary is worthless for the following segments.
+		for (int pos = best_begin; pos <= best_end - DMER_SIZE; pos++) {
+			freqs[hashes[pos]] = 0;
+		}
+
+		const int segment_size = MIN(best_end - best_begin, tail);
+		tail -= segment_size;
+		memcpy(dictionary.ptrw() + tail, data + best_begin, segment_size);
+	}
+
+	if (tail > 0) {
+		dictionary = dictionary.slice(tail);
+	}
+	return dictionary;
+}
+
+CompressionStream::~CompressionStream() {
+	_free_context();
+}
+
+Error CompressionStream::_create_context() {
+	switch (mode) {
+		case Compression::MODE_FASTLZ: {
+			// Stateless, compress() and decompress() go straight to Compression.
+		} break;
+		case Compression::MODE_DEFLATE:
+		case Compression::MODE_GZIP: {
+			int window_bits = mode == Compression::MODE_DEFLATE ? 15 : 15 + 16;
+
+			z_stream *strm = (z_stream *)memalloc(sizeof(z_stream));
+			strm->zalloc = zipio_alloc;
+			strm->zfree = zipio_free;
+			strm->opaque = Z_NULL;
+			strm->avail_in = 0;
+			strm->next_in = Z_NULL;
+			int err = compressing ? deflateInit2(strm, level, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) : inflateInit2(strm, window_bits);
+			if (err != Z_OK) {
+				memfree(strm);
+				ERR_FAIL_V(FAILED);
+			}
+			ctx = strm;
+		} break;
+		case Compression::MODE_ZSTD: {
+			if (compressing) {
+				ZSTD_CCtx *cctx = ZSTD_createCCtx();
+				ERR_FAIL_NULL_V(cctx, ERR_OUT_OF_MEMORY);
+				ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
+				if (Compression::zstd_long_distance_matching) {
+					ZSTD_CCtx_setParameter(cctx, ZSTD_c_enableLongDistanceMatching, 1);
+					ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, Compression::zstd_window_log_size);
+				}
+				ctx = cctx;
+			} else {
+				ZSTD_DCtx *dctx = ZSTD_createDCtx();
+				ERR_FAIL_NULL_V(dctx, ERR_OUT_OF_MEMORY);
+				if (Compression::zstd_long_distance_matching) {
+					ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, Compression::zstd_window_log_size);
+				}
+				ctx = dctx;
+			}
+		} break;
+		case Compression::MODE_BROTLI: {
+#ifdef BROTLI_ENABLED
+			BrotliDecoderState *state = BrotliDecoderCreateInstance(nullptr, nullptr, nullptr);
+			ERR_FAIL_NULL_V(state, ERR_OUT_OF_MEMORY);
+			ctx = state;
+#else
+			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Godot was compiled without brotli support.");
+#endif
+		} break;
+	}
+
+	started = true;
+	finished = false;
+	applied_level = level;
+	return OK;
+}
+
+void CompressionStream::_free_context() {
+	if (!ctx) {
+		return;
+	}
+
+	switch (mode) {
+		case Compression::MODE_FASTLZ: {
+		} break;
+		case Compression::MODE_DEFLATE:
+		case Compression::MODE_GZIP: {
+			z_stream *strm = (z_stream *)ctx;
+			if (compressing) {
+				deflateEnd(strm);
+			} else {
+				inflateEnd(strm);
+			}
+			memfree(strm);
+		} break;
+		case Compression::MODE_ZSTD: {
+			if (compressing) {
+				ZSTD_freeCCtx((ZSTD_CCtx *)ctx);
+			} else {
+				ZSTD_freeDCtx((ZSTD_DCtx *)ctx);
+			}
+		} break;
+		case Compression::MODE_BROTLI: {
+#ifdef BROTLI_ENABLED
+			BrotliDecoderDestroyInstance((BrotliDecoderState *)ctx);
+#endif
+		} break;
+	}
+	ctx = nullptr;
+}
+
+Error CompressionStream::start_compression(Compression::Mode p_mode, int p_level) {
+	ERR_FAIL_COND_V_MSG(p_mode == Compression::MODE_BROTLI, ERR_UNAVAILABLE, "Only brotli decompression is supported.");
+	clear();
+	mode = p_mode;
+	compressing = true;
+	level = p_level;
+	return _create_context();
+}
+
+Error CompressionStream::start_decompression(Compression::Mode p_mode) {
+	clear();
+	mode = p_mode;
+	compressing = false;
+	level = 0;
+	return _create_context();
+}
+
+Error CompressionStream::set_dictionary(const Vector<uint8_t> &p_dictionary) {
+	ERR_FAIL_COND_V(!started, ERR_UNCONFIGURED);
+	ERR_FAIL_COND_V_MSG(mode != Compression::MODE_ZSTD, ERR_UNAVAILABLE, "Dictionaries are only supported with Zstandard.");
+
+	size_t ret;
+	if (compressing) {
+		ret = ZSTD_CCtx_loadDictionary((ZSTD_CCtx *)ctx, p_dictionary.ptr(), p_dictionary.size());
+	} else {
+		ret = ZSTD_DCtx_loadDictionary((ZSTD_DCtx *)ctx, p_dictionary.ptr(), p_dictionary.size());
+	}
+	ERR_FAIL_COND_V_MSG(ZSTD_isError(ret), ERR_INVALID_PARAMETER, ZSTD_getErrorName(ret));
+	dictionary = p_dictionary;
+	return OK;
+}
+
+Error CompressionStream::reset() {
+	ERR_FAIL_COND_V(!started, ERR_UNCONFIGURED);
+	finished = false;
+
+	switch (mode) {
+		case Compression::MODE_FASTLZ: {
+		} break;
+		case Compression::MODE_DEFLATE:
+		case Compression::MODE_GZIP: {
+			z_stream *strm = (z_stream *)ctx;
+			if (compressing) {
+				ERR_FAIL_COND_V(deflateReset(strm) != Z_OK, FAILED);
+				if (level != applied_level) {
+					ERR_FAIL_COND_V(deflateParams(strm, level, Z_DEFAULT_STRATEGY) != Z_OK, FAILED);
+					applied_level = level;
+				}
+			} else {
+				ERR_FAIL_COND_V(inflateReset(strm) != Z_OK, FAILED);
+			}
+		} break;
+		case Compression::MODE_ZSTD: {
+			if (compressing) {
+				ZSTD_CCtx *cctx = (ZSTD_CCtx *)ctx;
+				ZSTD_CCtx_reset(cctx, ZSTD_reset_session_only);
+				if (level != applied_level) {
+					ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
+					applied_level = level;
+				}
+			} else {
+				ZSTD_DCtx_reset((ZSTD_DCtx *)ctx, ZSTD_reset_session_only);
+			}
+		} break;
+		case Compression::MODE_BROTLI: {
+#ifdef BROTLI_ENABLED
+			// Brotli has no reset, but a decoder instance is cheap compared to its window.
+			BrotliDecoderDestroyInstance((BrotliDecoderState *)ctx);
+			ctx = BrotliDecoderCreateInstance(nullptr, nullptr, nullptr);
+			ERR_FAIL_NULL_V(ctx, ERR_OUT_OF_MEMORY);
+#endif
+		} break;
+	}
+	return OK;
+}
+
+Error CompressionStream::process(uint8_t *p_dst, int p_dst_size, const uint8_t *p_src, int p_src_size, int &r_consumed, int &r_produced, bool p_finish) {
+	ERR_FAIL_COND_V(!started, ERR_UNCONFIGURED);
+	ERR_FAIL_COND_V(p_dst_size < 0 || p_src_size < 0, ERR_INVALID_PARAMETER);
+
+	r_consumed = 0;
+	r_produced = 0;
+	if (finished) {
+		// Frame is complete, further input is ignored until reset().
+		return OK;
+	}
+
+	switch (mode) {
+		case Compression::MODE_FASTLZ: {
+			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "FastLZ does not support streaming, use compress() and decompress() instead.");
+		} break;
+		case Compression::MODE_DEFLATE:
+		case Compression::MODE_GZIP: {
+			z_stream *strm = (z_stream *)ctx;
+			strm->next_in = (Bytef *)p_src;
+			strm->avail_in = p_src_size;
+			strm->next_out = p_dst;
+			strm->avail_out = p_dst_size;
+			int err = compressing ? deflate(strm, p_finish ? Z_FINISH : Z_NO_FLUSH) : inflate(strm, Z_NO_FLUSH);
+			r_consumed = p_src_size - strm->avail_in;
+			r_produced = p_dst_size - strm->avail_out;
+			if (err == Z_STREAM_END) {
+				finished = true;
+			} else {
+				// Z_BUF_ERROR only means no progress was possible with the given buffers.
+				ERR_FAIL_COND_V_MSG(err != Z_OK && err != Z_BUF_ERROR, FAILED, strm->msg ? strm->msg : "Invalid stream.");
+			}
+		} break;
+		case Compression::MODE_ZSTD: {
+			ZSTD_inBuffer in = { p_src, (size_t)p_src_size, 0 };
+			ZSTD_outBuffer out = { p_dst, (size_t)p_dst_size, 0 };
+			size_t ret;
+			if (compressing) {
+				ret = ZSTD_compressStream2((ZSTD_CCtx *)ctx, &out, &in, p_finish ? ZSTD_e_end : ZSTD_e_continue);
+			} else {
+				ret = ZSTD_decompressStream((ZSTD_DCtx *)ctx, &out, &in);
+			}
+			ERR_FAIL_COND_V_MSG(ZSTD_isError(ret), FAILED, ZSTD_getErrorName(ret));
+			r_consumed = in.pos;
+			r_produced = out.pos;
+			// When compressing, zero means fully flushed, which only ends the frame with ZSTD_e_end.
+			finished = ret == 0 && (p_finish || !compressing);
+		} break;
+		case Compression::MODE_BROTLI: {
+#ifdef BROTLI_ENABLED
+			BrotliDecoderState *state = (BrotliDecoderState *)ctx;
+			const uint8_t *next_in = p_src;
+			size_t avail_in = p_src_size;
+			uint8_t *next_out = p_dst;
+			size_t avail_out = p_dst_size;
+			BrotliDecoderResult res = BrotliDecoderDecompressStream(state, &avail_in, &next_in, &avail_out, &next_out, nullptr);
+			ERR_FAIL_COND_V_MSG(res == BROTLI_DECODER_RESULT_ERROR, FAILED, BrotliDecoderErrorString(BrotliDecoderGetErrorCode(state)));
+			r_consumed = p_src_size - avail_in;
+			r_produced = p_dst_size - avail_out;
+			finished = res == BROTLI_DECODER_RESULT_SUCCESS;
+#endif
+		} break;
+	}
+	return OK;
+}
+
+int CompressionStream::compress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size) {
+	ERR_FAIL_COND_V(!started || !compressing, -1);
+	if (mode == Compression::MODE_FASTLZ) {
+		return Compression::compress(p_dst, p_src, p_src_size, mode);
+	}
+
+	if (reset() != OK) {
+		return -1;
+	}
+
+	if (mode == Compression::MODE_ZSTD) {
+		size_t ret = ZSTD_compress2((ZSTD_CCtx *)ctx, p_dst, p_dst_max_size, p_src, p_src_size);
+		ERR_FAIL_COND_V_MSG(ZSTD_isError(ret), -1, ZSTD_getErrorName(ret));
+		return ret;
+	}
+
+	int consumed = 0;
+	int produced = 0;
+	Error err = process(p_dst, p_dst_max_size, p_src, p_src_size, consumed, produced, true);
+	ERR_FAIL_COND_V(err != OK || !finished, -1);
+	return produced;
+}
+
+int CompressionStream::decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size) {
+	ERR_FAIL_COND_V(!started || compressing, -1);
+	if (mode == Compression::MODE_FASTLZ) {
+		return Compression::decompress(p_dst, p_dst_max_size, p_src, p_src_size, mode);
+	}
+
+	if (reset() != OK) {
+		return -1;
+	}
+
+	if (mode == Compression::MODE_ZSTD) {
+		size_t ret = ZSTD_decompressDCtx((ZSTD_DCtx *)ctx, p_dst, p_dst_max_size, p_src, p_src_size);
+		ERR_FAIL_COND_V_MSG(ZSTD_isError(ret), -1, ZSTD_getErrorName(ret));
+		return ret;
+	}
+
+	int consumed = 0;
+	int produced = 0;
+	Error err = process(p_dst, p_dst_max_size, p_src, p_src_size, consumed, produced, true);
+	ERR_FAIL_COND_V(err != OK || !finished, -1);
+	return produced;
+}
+
+void CompressionStream::clear() {
+	_free_context();
+	dictionary.clear();
+	started = false;
+	finished = false;
+}
+
 int Compression::zlib_level = Z_DEFAULT_COMPRESSION;
 int Compression::gzip_level = Z_DEFAULT_COMPRESSION;
 int Compression::zstd_level = 3;
@@ -31,6 +31,7 @@
 #ifndef COMPRESSION_H
 #define COMPRESSION_H
 
+#include "core/error/error_list.h"
 #include "core/templates/vector.h"
 #include "core/typedefs.h"
 
@@ -55,6 +56,60 @@ public:
 	static int get_max_compressed_buffer_size(int p_src_size, Mode p_mode = MODE_ZSTD);
 	static int decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, Mode p_mode = MODE_ZSTD);
 	static int decompress_dynamic(Vector<uint8_t> *p_dst_vect, int p_max_dst_size, const uint8_t *p_src, int p_src_size, Mode p_mode);
+
+	static int get_default_level(Mode p_mode);
+	static Vector<uint8_t> train_zstd_dictionary(const Vector<Vector<uint8_t>> &p_samples, int p_max_size);
+};
+
+// Stateful compressor or decompressor. Unlike the one-shot Compression methods, the
+// codec context (and any dictionary) is created once and reused for every frame,
+// which is what makes compressing many small payloads cheap.
+// Brotli is decode-only: start_compression() fails with MODE_BROTLI, use
+// start_decompression() to read brotli data.
+class CompressionStream {
+	Compression::Mode mode = Compression::MODE_ZSTD;
+	bool started = false;
+	bool compressing = true;
+	bool finished = false;
+	int level = 0;
+	int applied_level = 0;
+	void *ctx = nullptr;
+	Vector<uint8_t> dictionary;
+
+	Error _create_context();
+	void _free_context();
+
+public:
+	Error start_compression(Compression::Mode p_mode, int p_level);
+	Error start_decompression(Compression::Mode p_mode);
+
+	Error set_dictionary(const Vector<uint8_t> &p_dictionary);
+	Vector<uint8_t> get_dictionary() const { return dictionary; }
+
+	// Takes effect from the next frame, i.e. after reset() or on the next compress() call.
+	void set_level(int p_level) { level = p_level; }
+	int get_level() const { return level; }
+
+	Compression::Mode get_mode() const { return mode; }
+	bool is_compressing() const { return compressing; }
+	bool is_started() const { return started; }
+	bool is_finished() const { return finished; }
+
+	// Streaming interface. Each frame is fed through process() until it reports finished,
+	// then reset() starts a new frame while keeping the context, level and dictionary.
+	Error process(uint8_t *p_dst, int p_dst_size, const uint8_t *p_src, int p_src_size, int &r_consumed, int &r_produced, bool p_finish = false);
+	Error reset();
+
+	// One-shot helpers reusing the context. Same return convention as Compression.
+	int compress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size);
+	int decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size);
+
+	void clear();
+
+	CompressionStream() {}
+	CompressionStream(const CompressionStream &) = delete;
+	CompressionStream &operator=(const CompressionStream &) = delete;
+	~CompressionStream();
 };
 
 #endif // COMPRESSION_H
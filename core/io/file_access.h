@@ -150,6 +150,16 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+
+	/**
+	 * Zero-copy reading, for backends that can keep the whole file in memory.
+	 * map_for_read() maps the file (READ mode only) and returns false if that's not supported.
+	 * get_buffer_mapped() returns a read-only pointer to the next p_length bytes and advances the
+	 * position, or returns nullptr (leaving the position untouched) if those bytes aren't available
+	 * in memory. The pointer stays valid until the file is closed.
+	 */
+	virtual bool map_for_read() { return false; }
+	virtual const uint8_t *get_buffer_mapped(uint64_t p_length) const { return nullptr; }
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
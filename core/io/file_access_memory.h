@@ -58,6 +58,7 @@ public:
 	virtual uint8_t get_8() const override; ///< get a byte
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override; ///< get an array of bytes
+	virtual const uint8_t *get_buffer_mapped(uint64_t p_length) const override; ///< get a view of the next bytes, data is always in memory
 
 	virtual Error get_error() const override; ///< get last error
 
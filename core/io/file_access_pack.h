@@ -33,6 +33,7 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
@@ -103,10 +104,21 @@ private:
 
 	PackedDir *root = nullptr;
 
+	// Each pack is mapped once and shared by all the files opened from it.
+	struct MappedPack {
+		Ref<FileAccess> file; // Keeps the mapping alive.
+		const uint8_t *data = nullptr; // Null if the pack couldn't be mapped.
+		uint64_t size = 0;
+	};
+	HashMap<String, MappedPack> mapped_packs;
+	Mutex mapped_packs_mutex;
+
 	static PackedData *singleton;
 	bool disabled = false;
+	bool mmap_enabled = true;
 
 	void _free_packed_dirs(PackedDir *p_dir);
+	const uint8_t *_get_mapped_pack(const String &p_pack, uint64_t p_offset, uint64_t p_size);
 
 public:
 	void add_pack_source(PackSource *p_source);
@@ -115,6 +127,10 @@ public:
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
+	// Read unencrypted pack files straight from a memory mapping of the pack, when the platform allows it.
+	void set_mmap_enabled(bool p_enabled) { mmap_enabled = p_enabled; }
+	_FORCE_INLINE_ bool is_mmap_enabled() const { return mmap_enabled; }
+
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
 
@@ -148,6 +164,9 @@ class FileAccessPack : public FileAccess {
 	mutable bool eof;
 	uint64_t off;
 
+	// Contents of the file in the pack mapping, if mapped.
+	const uint8_t *data = nullptr;
+
 	Ref<FileAccess> f;
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
@@ -172,6 +191,7 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_buffer_mapped(uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
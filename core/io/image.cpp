@@ -32,15 +32,18 @@
 
 #include "core/error/error_list.h"
 #include "core/error/error_macros.h"
+#include "core/io/image_kernels.h"
 #include "core/io/image_loader.h"
 #include "core/io/resource_loader.h"
 #include "core/math/math_funcs.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_map.h"
 #include "core/variant/dictionary.h"
 
 #include <stdio.h>
 #include <cmath>
+#include <type_traits>
 
 const char *Image::format_names[Image::FORMAT_MAX] = {
 	"Lum8", //luminance
@@ -465,47 +468,89 @@ int Image::get_mipmap_count() const {
 	}
 }
 
+// Calls p_function(from_row, to_row) over bands of rows, on the WorkerThreadPool if there's enough work.
+// Pool threads process all rows themselves, as waiting for other tasks there could starve the pool.
+template <typename F>
+static void _process_row_bands(uint32_t p_rows, uint64_t p_row_cost, const F &p_function) {
+	const uint64_t MIN_BAND_COST = 32768;
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	uint32_t bands = 1;
+	if (pool && pool->get_thread_count() > 1 && WorkerThreadPool::get_thread_index() == -1) {
+		bands = MIN((uint64_t)p_rows, p_rows * p_row_cost / MIN_BAND_COST);
+		bands = MIN(bands, (uint32_t)pool->get_thread_count() * 4);
+	}
+
+	if (bands <= 1) {
+		p_function(0, p_rows);
+		return;
+	}
+
+	struct BandData {
+		const F *function;
+		uint32_t rows;
+		uint32_t band_rows;
+	};
+
+	BandData band_data;
+	band_data.function = &p_function;
+	band_data.rows = p_rows;
+	band_data.band_rows = (p_rows + bands - 1) / bands;
+	bands = (p_rows + band_data.band_rows - 1) / band_data.band_rows;
+
+	WorkerThreadPool::GroupID group = pool->add_native_group_task(
+			[](void *p_userdata, uint32_t p_band) {
+				const BandData *bd = (const BandData *)p_userdata;
+				uint32_t from = p_band * bd->band_rows;
+				(*bd->function)(from, MIN(from + bd->band_rows, bd->rows));
+			},
+			&band_data, bands, -1, true, "ImageRowBands");
+	pool->wait_for_group_task_completion(group);
+}
+
 //using template generates perfectly optimized code due to constant expression reduction and unused variable removal present in all compilers
 template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
 static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
 	constexpr uint32_t max_bytes = MAX(read_bytes, write_bytes);
 
-	for (int y = 0; y < p_height; y++) {
-		for (int x = 0; x < p_width; x++) {
-			const uint8_t *rofs = &p_src[((y * p_width) + x) * (read_bytes + (read_alpha ? 1 : 0))];
-			uint8_t *wofs = &p_dst[((y * p_width) + x) * (write_bytes + (write_alpha ? 1 : 0))];
+	_process_row_bands(p_height, p_width, [&](uint32_t p_from, uint32_t p_to) {
+		for (int y = p_from; y < (int)p_to; y++) {
+			for (int x = 0; x < p_width; x++) {
+				const uint8_t *rofs = &p_src[((y * p_width) + x) * (read_bytes + (read_alpha ? 1 : 0))];
+				uint8_t *wofs = &p_dst[((y * p_width) + x) * (write_bytes + (write_alpha ? 1 : 0))];
 
-			uint8_t rgba[4] = { 0, 0, 0, 255 };
+				uint8_t rgba[4] = { 0, 0, 0, 255 };
 
-			if constexpr (read_gray) {
-				rgba[0] = rofs[0];
-				rgba[1] = rofs[0];
-				rgba[2] = rofs[0];
-			} else {
-				for (uint32_t i = 0; i < max_bytes; i++) {
-					rgba[i] = (i < read_bytes) ? rofs[i] : 0;
+				if constexpr (read_gray) {
+					rgba[0] = rofs[0];
+					rgba[1] = rofs[0];
+					rgba[2] = rofs[0];
+				} else {
+					for (uint32_t i = 0; i < max_bytes; i++) {
+						rgba[i] = (i < read_bytes) ? rofs[i] : 0;
+					}
 				}
-			}
 
-			if constexpr (read_alpha || write_alpha) {
-				rgba[3] = read_alpha ? rofs[read_bytes] : 255;
-			}
+				if constexpr (read_alpha || write_alpha) {
+					rgba[3] = read_alpha ? rofs[read_bytes] : 255;
+				}
 
-			if constexpr (write_gray) {
-				// REC.709
-				const uint8_t luminance = (13938U * rgba[0] + 46869U * rgba[1] + 4729U * rgba[2] + 32768U) >> 16U;
-				wofs[0] = luminance;
-			} else {
-				for (uint32_t i = 0; i < write_bytes; i++) {
-					wofs[i] = rgba[i];
+				if constexpr (write_gray) {
+					// REC.709
+					const uint8_t luminance = (13938U * rgba[0] + 46869U * rgba[1] + 4729U * rgba[2] + 32768U) >> 16U;
+					wofs[0] = luminance;
+				} else {
+					for (uint32_t i = 0; i < write_bytes; i++) {
+						wofs[i] = rgba[i];
+					}
 				}
-			}
 
-			if constexpr (write_alpha) {
-				wofs[write_bytes] = rgba[3];
+				if constexpr (write_alpha) {
+					wofs[write_bytes] = rgba[3];
+				}
 			}
 		}
-	}
+	});
 }
 
 void Image::convert(Format p_new_format) {
@@ -525,24 +570,27 @@ void Image::convert(Format p_new_format) {
 		ERR_FAIL_MSG("Cannot convert to <-> from compressed formats. Use compress() and decompress() instead.");
 
 	} else if (format > FORMAT_RGBA8 || p_new_format > FORMAT_RGBA8) {
-		//use put/set pixel which is slower but works with non byte formats
+		//use get/set color which is slower but works with non byte formats
 		Image new_img(width, height, mipmaps, p_new_format);
 
-		for (int mip = 0; mip < mipmap_count; mip++) {
-			Ref<Image> src_mip = get_image_from_mipmap(mip);
-			Ref<Image> new_mip = new_img.get_image_from_mipmap(mip);
+		const uint8_t *src_ptr = data.ptr();
+		uint8_t *dst_ptr = new_img.data.ptrw();
 
-			for (int y = 0; y < src_mip->height; y++) {
-				for (int x = 0; x < src_mip->width; x++) {
-					new_mip->set_pixel(x, y, src_mip->get_pixel(x, y));
-				}
-			}
-
-			int mip_offset = 0;
+		for (int mip = 0; mip < mipmap_count; mip++) {
+			int src_offset = 0;
 			int mip_size = 0;
-			new_img.get_mipmap_offset_and_size(mip, mip_offset, mip_size);
+			int mip_width = 0;
+			int mip_height = 0;
+			get_mipmap_offset_size_and_dimensions(mip, src_offset, mip_size, mip_width, mip_height);
 
-			memcpy(new_img.data.ptrw() + mip_offset, new_mip->data.ptr(), mip_size);
+			const uint8_t *src_mip = src_ptr + src_offset;
+			uint8_t *dst_mip = dst_ptr + new_img.get_mipmap_offset(mip);
+
+			_process_row_bands(mip_height, mip_width, [&](uint32_t p_from, uint32_t p_to) {
+				for (uint32_t ofs = p_from * mip_width; ofs < p_to * mip_width; ofs++) {
+					new_img._set_color_at_ofs(dst_mip, ofs, _get_color_at_ofs(src_mip, ofs));
+				}
+			});
 		}
 
 		_copy_internals_from(new_img);
@@ -686,84 +734,88 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 	int height = p_src_height;
 	double xfac = (double)width / p_dst_width;
 	double yfac = (double)height / p_dst_height;
-	// coordinates of source points and coefficients
-	double ox, oy, dx, dy;
-	int ox1, oy1, ox2, oy2;
-	// destination pixel values
 	// width and height decreased by 1
 	int ymax = height - 1;
 	int xmax = width - 1;
-	// temporary pointer
 
-	for (uint32_t y = 0; y < p_dst_height; y++) {
-		// Y coordinates
-		oy = (double)y * yfac - 0.5f;
-		oy1 = (int)oy;
-		dy = oy - (double)oy1;
+	// Horizontal source pixels and coefficients are the same for every row.
+	struct CubicColumn {
+		int ofs[4];
+		double k[4];
+	};
+
+	LocalVector<CubicColumn> columns;
+	columns.resize(p_dst_width);
 
-		for (uint32_t x = 0; x < p_dst_width; x++) {
-			// X coordinates
-			ox = (double)x * xfac - 0.5f;
-			ox1 = (int)ox;
-			dx = ox - (double)ox1;
+	for (uint32_t x = 0; x < p_dst_width; x++) {
+		// X coordinates
+		double ox = (double)x * xfac - 0.5f;
+		int ox1 = (int)ox;
+		double dx = ox - (double)ox1;
 
-			// initial pixel value
+		for (int m = -1; m < 3; m++) {
+			columns[x].ofs[m + 1] = CLAMP(ox1 + m, 0, xmax) * CC;
+			columns[x].k[m + 1] = _bicubic_interp_kernel((double)m - dx);
+		}
+	}
 
-			T *__restrict dst = ((T *)p_dst) + (y * p_dst_width + x) * CC;
+	_process_row_bands(p_dst_height, p_dst_width * 16, [&](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t y = p_from; y < p_to; y++) {
+			// Y coordinates
+			double oy = (double)y * yfac - 0.5f;
+			int oy1 = (int)oy;
+			double dy = oy - (double)oy1;
 
-			double color[CC];
-			for (int i = 0; i < CC; i++) {
-				color[i] = 0;
+			const T *rows[4];
+			double ky[4];
+			for (int n = -1; n < 3; n++) {
+				rows[n + 1] = ((const T *)p_src) + CLAMP(oy1 + n, 0, ymax) * p_src_width * CC;
+				ky[n + 1] = _bicubic_interp_kernel(dy - (double)n);
 			}
 
-			for (int n = -1; n < 3; n++) {
-				// get Y coefficient
-				[[maybe_unused]] double k1 = _bicubic_interp_kernel(dy - (double)n);
+			for (uint32_t x = 0; x < p_dst_width; x++) {
+				const CubicColumn &column = columns[x];
 
-				oy2 = oy1 + n;
-				if (oy2 < 0) {
-					oy2 = 0;
-				}
-				if (oy2 > ymax) {
-					oy2 = ymax;
+				T *__restrict dst = ((T *)p_dst) + (y * p_dst_width + x) * CC;
+
+				double color[CC];
+				for (int i = 0; i < CC; i++) {
+					color[i] = 0;
 				}
 
-				for (int m = -1; m < 3; m++) {
-					// get X coefficient
-					[[maybe_unused]] double k2 = k1 * _bicubic_interp_kernel((double)m - dx);
+				for (int n = 0; n < 4; n++) {
+					// get Y coefficient
+					[[maybe_unused]] double k1 = ky[n];
 
-					ox2 = ox1 + m;
-					if (ox2 < 0) {
-						ox2 = 0;
-					}
-					if (ox2 > xmax) {
-						ox2 = xmax;
-					}
+					for (int m = 0; m < 4; m++) {
+						// get X coefficient
+						[[maybe_unused]] double k2 = k1 * column.k[m];
 
-					// get pixel of original image
-					const T *__restrict p = ((T *)p_src) + (oy2 * p_src_width + ox2) * CC;
+						// get pixel of original image
+						const T *__restrict p = rows[n] + column.ofs[m];
 
-					for (int i = 0; i < CC; i++) {
-						if constexpr (sizeof(T) == 2) { //half float
-							color[i] = Math::half_to_float(p[i]);
-						} else {
-							color[i] += p[i] * k2;
+						for (int i = 0; i < CC; i++) {
+							if constexpr (sizeof(T) == 2) { //half float
+								color[i] = Math::half_to_float(p[i]);
+							} else {
+								color[i] += p[i] * k2;
+							}
 						}
 					}
 				}
-			}
 
-			for (int i = 0; i < CC; i++) {
-				if constexpr (sizeof(T) == 1) { //byte
-					dst[i] = CLAMP(Math::fast_ftoi(color[i]), 0, 255);
-				} else if constexpr (sizeof(T) == 2) { //half float
-					dst[i] = Math::make_half_float(color[i]);
-				} else {
-					dst[i] = color[i];
+				for (int i = 0; i < CC; i++) {
+					if constexpr (sizeof(T) == 1) { //byte
+						dst[i] = CLAMP(Math::fast_ftoi(color[i]), 0, 255);
+					} else if constexpr (sizeof(T) == 2) { //half float
+						dst[i] = Math::make_half_float(color[i]);
+					} else {
+						dst[i] = color[i];
+					}
 				}
 			}
 		}
-	}
+	});
 }
 
 template <int CC, typename T>
@@ -775,106 +827,127 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 		FRAC_MASK = FRAC_LEN - 1
 	};
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
-		// Add 0.5 in order to interpolate based on pixel center
-		uint32_t src_yofs_up_fp = (i + 0.5) * p_src_height * FRAC_LEN / p_dst_height;
-		// Calculate nearest src pixel center above current, and truncate to get y index
-		uint32_t src_yofs_up = src_yofs_up_fp >= FRAC_HALF ? (src_yofs_up_fp - FRAC_HALF) >> FRAC_BITS : 0;
-		uint32_t src_yofs_down = (src_yofs_up_fp + FRAC_HALF) >> FRAC_BITS;
-		if (src_yofs_down >= p_src_height) {
-			src_yofs_down = p_src_height - 1;
+	// Horizontal source pixels and distances are the same for every row.
+	struct BilinearColumn {
+		uint32_t left;
+		uint32_t right;
+		uint32_t frac;
+	};
+
+	LocalVector<BilinearColumn> columns;
+	columns.resize(p_dst_width);
+
+	for (uint32_t j = 0; j < p_dst_width; j++) {
+		uint32_t src_xofs_left_fp = (j + 0.5) * p_src_width * FRAC_LEN / p_dst_width;
+		uint32_t src_xofs_left = src_xofs_left_fp >= FRAC_HALF ? (src_xofs_left_fp - FRAC_HALF) >> FRAC_BITS : 0;
+		uint32_t src_xofs_right = (src_xofs_left_fp + FRAC_HALF) >> FRAC_BITS;
+		if (src_xofs_right >= p_src_width) {
+			src_xofs_right = p_src_width - 1;
 		}
-		// Calculate distance to pixel center of src_yofs_up
-		uint32_t src_yofs_frac = src_yofs_up_fp & FRAC_MASK;
-		src_yofs_frac = src_yofs_frac >= FRAC_HALF ? src_yofs_frac - FRAC_HALF : src_yofs_frac + FRAC_HALF;
-
-		uint32_t y_ofs_up = src_yofs_up * p_src_width * CC;
-		uint32_t y_ofs_down = src_yofs_down * p_src_width * CC;
-
-		for (uint32_t j = 0; j < p_dst_width; j++) {
-			uint32_t src_xofs_left_fp = (j + 0.5) * p_src_width * FRAC_LEN / p_dst_width;
-			uint32_t src_xofs_left = src_xofs_left_fp >= FRAC_HALF ? (src_xofs_left_fp - FRAC_HALF) >> FRAC_BITS : 0;
-			uint32_t src_xofs_right = (src_xofs_left_fp + FRAC_HALF) >> FRAC_BITS;
-			if (src_xofs_right >= p_src_width) {
-				src_xofs_right = p_src_width - 1;
+		uint32_t src_xofs_frac = src_xofs_left_fp & FRAC_MASK;
+		src_xofs_frac = src_xofs_frac >= FRAC_HALF ? src_xofs_frac - FRAC_HALF : src_xofs_frac + FRAC_HALF;
+
+		columns[j].left = src_xofs_left * CC;
+		columns[j].right = src_xofs_right * CC;
+		columns[j].frac = src_xofs_frac;
+	}
+
+	_process_row_bands(p_dst_height, p_dst_width * 4, [&](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			// Add 0.5 in order to interpolate based on pixel center
+			uint32_t src_yofs_up_fp = (i + 0.5) * p_src_height * FRAC_LEN / p_dst_height;
+			// Calculate nearest src pixel center above current, and truncate to get y index
+			uint32_t src_yofs_up = src_yofs_up_fp >= FRAC_HALF ? (src_yofs_up_fp - FRAC_HALF) >> FRAC_BITS : 0;
+			uint32_t src_yofs_down = (src_yofs_up_fp + FRAC_HALF) >> FRAC_BITS;
+			if (src_yofs_down >= p_src_height) {
+				src_yofs_down = p_src_height - 1;
 			}
-			uint32_t src_xofs_frac = src_xofs_left_fp & FRAC_MASK;
-			src_xofs_frac = src_xofs_frac >= FRAC_HALF ? src_xofs_frac - FRAC_HALF : src_xofs_frac + FRAC_HALF;
-
-			src_xofs_left *= CC;
-			src_xofs_right *= CC;
-
-			for (uint32_t l = 0; l < CC; l++) {
-				if constexpr (sizeof(T) == 1) { //uint8
-					uint32_t p00 = p_src[y_ofs_up + src_xofs_left + l] << FRAC_BITS;
-					uint32_t p10 = p_src[y_ofs_up + src_xofs_right + l] << FRAC_BITS;
-					uint32_t p01 = p_src[y_ofs_down + src_xofs_left + l] << FRAC_BITS;
-					uint32_t p11 = p_src[y_ofs_down + src_xofs_right + l] << FRAC_BITS;
-
-					uint32_t interp_up = p00 + (((p10 - p00) * src_xofs_frac) >> FRAC_BITS);
-					uint32_t interp_down = p01 + (((p11 - p01) * src_xofs_frac) >> FRAC_BITS);
-					uint32_t interp = interp_up + (((interp_down - interp_up) * src_yofs_frac) >> FRAC_BITS);
-					interp >>= FRAC_BITS;
-					p_dst[i * p_dst_width * CC + j * CC + l] = uint8_t(interp);
-				} else if constexpr (sizeof(T) == 2) { //half float
-
-					float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
-					float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
-					const T *src = ((const T *)p_src);
-					T *dst = ((T *)p_dst);
+			// Calculate distance to pixel center of src_yofs_up
+			uint32_t src_yofs_frac = src_yofs_up_fp & FRAC_MASK;
+			src_yofs_frac = src_yofs_frac >= FRAC_HALF ? src_yofs_frac - FRAC_HALF : src_yofs_frac + FRAC_HALF;
+
+			uint32_t y_ofs_up = src_yofs_up * p_src_width * CC;
+			uint32_t y_ofs_down = src_yofs_down * p_src_width * CC;
+
+			for (uint32_t j = 0; j < p_dst_width; j++) {
+				const uint32_t src_xofs_left = columns[j].left;
+				const uint32_t src_xofs_right = columns[j].right;
+				const uint32_t src_xofs_frac = columns[j].frac;
+
+				for (uint32_t l = 0; l < CC; l++) {
+					if constexpr (sizeof(T) == 1) { //uint8
+						uint32_t p00 = p_src[y_ofs_up + src_xofs_left + l] << FRAC_BITS;
+						uint32_t p10 = p_src[y_ofs_up + src_xofs_right + l] << FRAC_BITS;
+						uint32_t p01 = p_src[y_ofs_down + src_xofs_left + l] << FRAC_BITS;
+						uint32_t p11 = p_src[y_ofs_down + src_xofs_right + l] << FRAC_BITS;
+
+						uint32_t interp_up = p00 + (((p10 - p00) * src_xofs_frac) >> FRAC_BITS);
+						uint32_t interp_down = p01 + (((p11 - p01) * src_xofs_frac) >> FRAC_BITS);
+						uint32_t interp = interp_up + (((interp_down - interp_up) * src_yofs_frac) >> FRAC_BITS);
+						interp >>= FRAC_BITS;
+						p_dst[i * p_dst_width * CC + j * CC + l] = uint8_t(interp);
+					} else if constexpr (sizeof(T) == 2) { //half float
 
-					float p00 = Math::half_to_float(src[y_ofs_up + src_xofs_left + l]);
-					float p10 = Math::half_to_float(src[y_ofs_up + src_xofs_right + l]);
-					float p01 = Math::half_to_float(src[y_ofs_down + src_xofs_left + l]);
-					float p11 = Math::half_to_float(src[y_ofs_down + src_xofs_right + l]);
+						float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
+						float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
+						const T *src = ((const T *)p_src);
+						T *dst = ((T *)p_dst);
 
-					float interp_up = p00 + (p10 - p00) * xofs_frac;
-					float interp_down = p01 + (p11 - p01) * xofs_frac;
-					float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
+						float p00 = Math::half_to_float(src[y_ofs_up + src_xofs_left + l]);
+						float p10 = Math::half_to_float(src[y_ofs_up + src_xofs_right + l]);
+						float p01 = Math::half_to_float(src[y_ofs_down + src_xofs_left + l]);
+						float p11 = Math::half_to_float(src[y_ofs_down + src_xofs_right + l]);
 
-					dst[i * p_dst_width * CC + j * CC + l] = Math::make_half_float(interp);
-				} else if constexpr (sizeof(T) == 4) { //float
+						float interp_up = p00 + (p10 - p00) * xofs_frac;
+						float interp_down = p01 + (p11 - p01) * xofs_frac;
+						float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
 
-					float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
-					float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
-					const T *src = ((const T *)p_src);
-					T *dst = ((T *)p_dst);
+						dst[i * p_dst_width * CC + j * CC + l] = Math::make_half_float(interp);
+					} else if constexpr (sizeof(T) == 4) { //float
+
+						float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
+						float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
+						const T *src = ((const T *)p_src);
+						T *dst = ((T *)p_dst);
 
-					float p00 = src[y_ofs_up + src_xofs_left + l];
-					float p10 = src[y_ofs_up + src_xofs_right + l];
-					float p01 = src[y_ofs_down + src_xofs_left + l];
-					float p11 = src[y_ofs_down + src_xofs_right + l];
+						float p00 = src[y_ofs_up + src_xofs_left + l];
+						float p10 = src[y_ofs_up + src_xofs_right + l];
+						float p01 = src[y_ofs_down + src_xofs_left + l];
+						float p11 = src[y_ofs_down + src_xofs_right + l];
 
-					float interp_up = p00 + (p10 - p00) * xofs_frac;
-					float interp_down = p01 + (p11 - p01) * xofs_frac;
-					float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
+						float interp_up = p00 + (p10 - p00) * xofs_frac;
+						float interp_down = p01 + (p11 - p01) * xofs_frac;
+						float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
 
-					dst[i * p_dst_width * CC + j * CC + l] = interp;
+						dst[i * p_dst_width * CC + j * CC + l] = interp;
+					}
 				}
 			}
 		}
-	}
+	});
 }
 
 template <int CC, typename T>
 static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
-	for (uint32_t i = 0; i < p_dst_height; i++) {
-		uint32_t src_yofs = i * p_src_height / p_dst_height;
-		uint32_t y_ofs = src_yofs * p_src_width * CC;
+	_process_row_bands(p_dst_height, p_dst_width, [&](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			uint32_t src_yofs = i * p_src_height / p_dst_height;
+			uint32_t y_ofs = src_yofs * p_src_width * CC;
 
-		for (uint32_t j = 0; j < p_dst_width; j++) {
-			uint32_t src_xofs = j * p_src_width / p_dst_width;
-			src_xofs *= CC;
+			for (uint32_t j = 0; j < p_dst_width; j++) {
+				uint32_t src_xofs = j * p_src_width / p_dst_width;
+				src_xofs *= CC;
 
-			for (uint32_t l = 0; l < CC; l++) {
-				const T *src = ((const T *)p_src);
-				T *dst = ((T *)p_dst);
+				for (uint32_t l = 0; l < CC; l++) {
+					const T *src = ((const T *)p_src);
+					T *dst = ((T *)p_dst);
 
-				T p = src[y_ofs + src_xofs + l];
-				dst[i * p_dst_width * CC + j * CC + l] = p;
+					T p = src[y_ofs + src_xofs + l];
+					dst[i * p_dst_width * CC + j * CC + l] = p;
+				}
 			}
 		}
-	}
+	});
 }
 
 #define LANCZOS_TYPE 3
@@ -883,6 +956,52 @@ static float _lanczos(float p_x) {
 	return Math::abs(p_x) >= LANCZOS_TYPE ? 0 : Math::sincn(p_x) * Math::sincn(p_x / LANCZOS_TYPE);
 }
 
+// Lanczos weights for every destination pixel along one axis, computed once instead of per pixel.
+struct LanczosKernels {
+	int32_t half_kernel = 0;
+	LocalVector<int32_t> start;
+	LocalVector<int32_t> end;
+	LocalVector<float> weights; // 2 * half_kernel values per destination pixel.
+	LocalVector<float> weight_sums;
+
+	void build(int32_t p_src_size, int32_t p_dst_size) {
+		float scale = float(p_src_size) / float(p_dst_size);
+
+		float scale_factor = MAX(scale, 1); // A larger kernel is required only when downscaling
+		half_kernel = LANCZOS_TYPE * scale_factor;
+
+		start.resize(p_dst_size);
+		end.resize(p_dst_size);
+		weights.resize(p_dst_size * half_kernel * 2);
+		weight_sums.resize(p_dst_size);
+
+		for (int32_t dst = 0; dst < p_dst_size; dst++) {
+			// The corresponding point on the source image
+			float src = (dst + 0.5f) * scale; // Offset by 0.5 so it uses the pixel's center
+			start[dst] = MAX(0, int32_t(src) - half_kernel + 1);
+			end[dst] = MIN(p_src_size - 1, int32_t(src) + half_kernel);
+
+			float *kernel = &weights[dst * half_kernel * 2];
+			float weight = 0;
+			for (int32_t target = start[dst]; target <= end[dst]; target++) {
+				kernel[target - start[dst]] = _lanczos((target + 0.5f - src) / scale_factor);
+				weight += kernel[target - start[dst]];
+			}
+			weight_sums[dst] = weight;
+		}
+	}
+
+	ImageKernels::LanczosWeights get_weights() const {
+		ImageKernels::LanczosWeights lanczos_weights;
+		lanczos_weights.start = start.ptr();
+		lanczos_weights.end = end.ptr();
+		lanczos_weights.weights = weights.ptr();
+		lanczos_weights.stride = half_kernel * 2;
+		lanczos_weights.weight_sums = weight_sums.ptr();
+		return lanczos_weights;
+	}
+};
+
 template <int CC, typename T>
 static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
 	int32_t src_width = p_src_width;
@@ -895,104 +1014,109 @@ static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict
 
 	{ // FIRST PASS (horizontal)
 
-		float x_scale = float(src_width) / float(dst_width);
-
-		float scale_factor = MAX(x_scale, 1); // A larger kernel is required only when downscaling
-		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
-
-		float *kernel = memnew_arr(float, half_kernel * 2);
-
-		for (int32_t buffer_x = 0; buffer_x < dst_width; buffer_x++) {
-			// The corresponding point on the source image
-			float src_x = (buffer_x + 0.5f) * x_scale; // Offset by 0.5 so it uses the pixel's center
-			int32_t start_x = MAX(0, int32_t(src_x) - half_kernel + 1);
-			int32_t end_x = MIN(src_width - 1, int32_t(src_x) + half_kernel);
-
-			// Create the kernel used by all the pixels of the column
-			for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
-				kernel[target_x - start_x] = _lanczos((target_x + 0.5f - src_x) / scale_factor);
+		LanczosKernels kernels;
+		kernels.build(src_width, dst_width);
+
+		_process_row_bands(src_height, dst_width * kernels.half_kernel * 2, [&](uint32_t p_from, uint32_t p_to) {
+			if constexpr (CC == 4 && (std::is_same_v<T, uint8_t> || std::is_same_v<T, float>)) {
+				const ImageKernels::LanczosWeights weights = kernels.get_weights();
+				for (int32_t buffer_y = p_from; buffer_y < (int32_t)p_to; buffer_y++) {
+					const T *src_row = ((const T *)p_src) + buffer_y * src_width * CC;
+					float *dst_row = buffer + buffer_y * dst_width * CC;
+					if constexpr (std::is_same_v<T, uint8_t>) {
+						ImageKernels::lanczos_row_rgba8(src_row, dst_row, dst_width, weights);
+					} else {
+						ImageKernels::lanczos_row_rgbaf(src_row, dst_row, dst_width, weights);
+					}
+				}
+				return;
 			}
 
-			for (int32_t buffer_y = 0; buffer_y < src_height; buffer_y++) {
-				float pixel[CC] = { 0 };
-				float weight = 0;
+			for (int32_t buffer_y = p_from; buffer_y < (int32_t)p_to; buffer_y++) {
+				for (int32_t buffer_x = 0; buffer_x < dst_width; buffer_x++) {
+					const int32_t start_x = kernels.start[buffer_x];
+					const int32_t end_x = kernels.end[buffer_x];
+					const float *kernel = &kernels.weights[buffer_x * kernels.half_kernel * 2];
 
-				for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
-					float lanczos_val = kernel[target_x - start_x];
-					weight += lanczos_val;
+					float pixel[CC] = { 0 };
 
-					const T *__restrict src_data = ((const T *)p_src) + (buffer_y * src_width + target_x) * CC;
+					for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
+						float lanczos_val = kernel[target_x - start_x];
 
-					for (uint32_t i = 0; i < CC; i++) {
-						if constexpr (sizeof(T) == 2) { //half float
-							pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
-						} else {
-							pixel[i] += src_data[i] * lanczos_val;
+						const T *__restrict src_data = ((const T *)p_src) + (buffer_y * src_width + target_x) * CC;
+
+						for (uint32_t i = 0; i < CC; i++) {
+							if constexpr (sizeof(T) == 2) { //half float
+								pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
+							} else {
+								pixel[i] += src_data[i] * lanczos_val;
+							}
 						}
 					}
-				}
 
-				float *dst_data = ((float *)buffer) + (buffer_y * dst_width + buffer_x) * CC;
+					float *dst_data = ((float *)buffer) + (buffer_y * dst_width + buffer_x) * CC;
 
-				for (uint32_t i = 0; i < CC; i++) {
-					dst_data[i] = pixel[i] / weight; // Normalize the sum of all the samples
+					for (uint32_t i = 0; i < CC; i++) {
+						dst_data[i] = pixel[i] / kernels.weight_sums[buffer_x]; // Normalize the sum of all the samples
+					}
 				}
 			}
-		}
-
-		memdelete_arr(kernel);
+		});
 	} // End of first pass
 
 	{ // SECOND PASS (vertical + result)
 
-		float y_scale = float(src_height) / float(dst_height);
-
-		float scale_factor = MAX(y_scale, 1);
-		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
-
-		float *kernel = memnew_arr(float, half_kernel * 2);
+		LanczosKernels kernels;
+		kernels.build(src_height, dst_height);
 
-		for (int32_t dst_y = 0; dst_y < dst_height; dst_y++) {
-			float buffer_y = (dst_y + 0.5f) * y_scale;
-			int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
-			int32_t end_y = MIN(src_height - 1, int32_t(buffer_y) + half_kernel);
-
-			for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-				kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
+		_process_row_bands(dst_height, dst_width * kernels.half_kernel * 2, [&](uint32_t p_from, uint32_t p_to) {
+			if constexpr (CC == 4 && (std::is_same_v<T, uint8_t> || std::is_same_v<T, float>)) {
+				const ImageKernels::LanczosWeights weights = kernels.get_weights();
+				for (int32_t dst_y = p_from; dst_y < (int32_t)p_to; dst_y++) {
+					T *dst_row = ((T *)p_dst) + dst_y * dst_width * CC;
+					if constexpr (std::is_same_v<T, uint8_t>) {
+						ImageKernels::lanczos_column_rgba8(buffer, dst_row, dst_width, dst_y, weights);
+					} else {
+						ImageKernels::lanczos_column_rgbaf(buffer, dst_row, dst_width, dst_y, weights);
+					}
+				}
+				return;
 			}
 
-			for (int32_t dst_x = 0; dst_x < dst_width; dst_x++) {
-				float pixel[CC] = { 0 };
-				float weight = 0;
+			for (int32_t dst_y = p_from; dst_y < (int32_t)p_to; dst_y++) {
+				const int32_t start_y = kernels.start[dst_y];
+				const int32_t end_y = kernels.end[dst_y];
+				const float *kernel = &kernels.weights[dst_y * kernels.half_kernel * 2];
 
-				for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-					float lanczos_val = kernel[target_y - start_y];
-					weight += lanczos_val;
+				for (int32_t dst_x = 0; dst_x < dst_width; dst_x++) {
+					float pixel[CC] = { 0 };
 
-					float *buffer_data = ((float *)buffer) + (target_y * dst_width + dst_x) * CC;
+					for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
+						float lanczos_val = kernel[target_y - start_y];
 
-					for (uint32_t i = 0; i < CC; i++) {
-						pixel[i] += buffer_data[i] * lanczos_val;
-					}
-				}
+						float *buffer_data = ((float *)buffer) + (target_y * dst_width + dst_x) * CC;
 
-				T *dst_data = ((T *)p_dst) + (dst_y * dst_width + dst_x) * CC;
+						for (uint32_t i = 0; i < CC; i++) {
+							pixel[i] += buffer_data[i] * lanczos_val;
+						}
+					}
 
-				for (uint32_t i = 0; i < CC; i++) {
-					pixel[i] /= weight;
+					T *dst_data = ((T *)p_dst) + (dst_y * dst_width + dst_x) * CC;
 
-					if constexpr (sizeof(T) == 1) { //byte
-						dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
-					} else if constexpr (sizeof(T) == 2) { //half float
-						dst_data[i] = Math::make_half_float(pixel[i]);
-					} else { // float
-						dst_data[i] = pixel[i];
+					for (uint32_t i = 0; i < CC; i++) {
+						pixel[i] /= kernels.weight_sums[dst_y];
+
+						if constexpr (sizeof(T) == 1) { //byte
+							dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
+						} else if constexpr (sizeof(T) == 2) { //half float
+							dst_data[i] = Math::make_half_float(pixel[i]);
+						} else { // float
+							dst_data[i] = pixel[i];
+						}
 					}
 				}
 			}
-		}
-
-		memdelete_arr(kernel);
+		});
 	} // End of second pass
 
 	memdelete_arr(buffer);
@@ -1676,27 +1800,41 @@ static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint3
 	int right_step = (p_width == 1) ? 0 : CC;
 	int down_step = (p_height == 1) ? 0 : (p_width * CC);
 
-	for (uint32_t i = 0; i < dst_h; i++) {
-		const Component *rup_ptr = &p_src[i * 2 * down_step];
-		const Component *rdown_ptr = rup_ptr + down_step;
-		Component *dst_ptr = &p_dst[i * dst_w * CC];
-		uint32_t count = dst_w;
+	_process_row_bands(dst_h, dst_w * 4, [&](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			const Component *rup_ptr = &p_src[i * 2 * down_step];
+			const Component *rdown_ptr = rup_ptr + down_step;
+			Component *dst_ptr = &p_dst[i * dst_w * CC];
 
-		while (count) {
-			count--;
-			for (int j = 0; j < CC; j++) {
-				average_func(dst_ptr[j], rup_ptr[j], rup_ptr[j + right_step], rdown_ptr[j], rdown_ptr[j + right_step]);
+			if constexpr (CC == 4 && !renormalize && (std::is_same_v<Component, uint8_t> || std::is_same_v<Component, float>)) {
+				if (right_step) {
+					if constexpr (std::is_same_v<Component, uint8_t>) {
+						ImageKernels::average_row_rgba8(rup_ptr, rdown_ptr, dst_ptr, dst_w);
+					} else {
+						ImageKernels::average_row_rgbaf(rup_ptr, rdown_ptr, dst_ptr, dst_w);
+					}
+					continue;
+				}
 			}
 
-			if (renormalize) {
-				renormalize_func(dst_ptr);
-			}
+			uint32_t count = dst_w;
+
+			while (count) {
+				count--;
+				for (int j = 0; j < CC; j++) {
+					average_func(dst_ptr[j], rup_ptr[j], rup_ptr[j + right_step], rdown_ptr[j], rdown_ptr[j + right_step]);
+				}
 
-			dst_ptr += CC;
-			rup_ptr += right_step * 2;
-			rdown_ptr += right_step * 2;
+				if (renormalize) {
+					renormalize_func(dst_ptr);
+				}
+
+				dst_ptr += CC;
+				rup_ptr += right_step * 2;
+				rdown_ptr += right_step * 2;
+			}
 		}
-	}
+	});
 }
 
 void Image::shrink_x2() {
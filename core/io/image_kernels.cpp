@@ -0,0 +1,474 @@
+/**************************************************************************/
+/*  image_kernels.cpp                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "image_kernels.h"
+
+#include "core/error/error_macros.h"
+#include "core/math/math_funcs.h"
+
+#include <string.h>
+
+// SSE2 and NEON are part of the x86-64 and ARM64 baselines, so they can be used whenever they're
+// enabled at build time.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_KERNELS_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define IMAGE_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+/* Shared by all backends, for the remaining pixels. */
+
+static _FORCE_INLINE_ void _average_pixel_rgba8(const uint8_t *p_up, const uint8_t *p_down, uint8_t *p_dst) {
+	// Same as Image::average_4_uint8().
+	for (int i = 0; i < 4; i++) {
+		p_dst[i] = static_cast<uint8_t>((p_up[i] + p_up[i + 4] + p_down[i] + p_down[i + 4] + 2) >> 2);
+	}
+}
+
+static _FORCE_INLINE_ void _average_pixel_rgbaf(const float *p_up, const float *p_down, float *p_dst) {
+	// Same as Image::average_4_float().
+	for (int i = 0; i < 4; i++) {
+		p_dst[i] = (p_up[i] + p_up[i + 4] + p_down[i] + p_down[i + 4]) * 0.25f;
+	}
+}
+
+/* Scalar */
+
+static void _average_row_rgba8_scalar(const uint8_t *p_src_up, const uint8_t *p_src_down, uint8_t *p_dst, uint32_t p_dst_width) {
+	for (uint32_t x = 0; x < p_dst_width; x++) {
+		_average_pixel_rgba8(p_src_up + x * 8, p_src_down + x * 8, p_dst + x * 4);
+	}
+}
+
+static void _average_row_rgbaf_scalar(const float *p_src_up, const float *p_src_down, float *p_dst, uint32_t p_dst_width) {
+	for (uint32_t x = 0; x < p_dst_width; x++) {
+		_average_pixel_rgbaf(p_src_up + x * 8, p_src_down + x * 8, p_dst + x * 4);
+	}
+}
+
+template <typename T>
+static _FORCE_INLINE_ void _lanczos_row_scalar(const T *p_src, float *p_dst, uint32_t p_dst_width, const ImageKernels::LanczosWeights &p_weights) {
+	for (uint32_t x = 0; x < p_dst_width; x++) {
+		const int32_t start = p_weights.start[x];
+		const int32_t end = p_weights.end[x];
+		const float *kernel = p_weights.weights + x * p_weights.stride;
+
+		float pixel[4] = { 0, 0, 0, 0 };
+		for (int32_t target = start; target <= end; target++) {
+			const float weight = kernel[target - start];
+			const T *src = p_src + target * 4;
+			for (int i = 0; i < 4; i++) {
+				pixel[i] += src[i] * weight;
+			}
+		}
+
+		for (int i = 0; i < 4; i++) {
+			p_dst[x * 4 + i] = pixel[i] / p_weights.weight_sums[x];
+		}
+	}
+}
+
+static void _lanczos_row_rgba8_scalar(const uint8_t *p_src, float *p_dst, uint32_t p_dst_width, const ImageKernels::LanczosWeights &p_weights) {
+	_lanczos_row_scalar(p_src, p_dst, p_dst_width, p_weights);
+}
+
+static void _lanczos_row_rgbaf_scalar(const float *p_src, float *p_dst, uint32_t p_dst_width, const ImageKernels::LanczosWeights &p_weights) {
+	_lanczos_row_scalar(p_src, p_dst, p_dst_width, p_weights);
+}
+
+template <typename T>
+static _FORCE_INLINE_ void _lanczos_column_scalar(const float *p_src, T *p_dst, uint32_t p_width, uint32_t p_row, const ImageKernels::LanczosWeights &p_weights) {
+	const int32_t start = p_weights.start[p_row];
+	const int32_t end = p_weights.end[p_row];
+	const float *kernel = p_weights.weights + p_row * p_weights.stride;
+	const float weight_sum = p_weights.weight_sums[p_row];
+
+	for (uint32_t x = 0; x < p_width; x++) {
+		float pixel[4] = { 0, 0, 0, 0 };
+		for (int32_t target = start; target <= end; target++) {
+			const float weight = kernel[target - start];
+			const float *src = p_src + (target * p_width + x) * 4;
+			for (int i = 0; i < 4; i++) {
+				pixel[i] += src[i] * weight;
+			}
+		}
+
+		for (int i = 0; i < 4; i++) {
+			pixel[i] /= weight_sum;
+			if constexpr (sizeof(T) == 1) {
+				p_dst[x * 4 + i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
+			} else {
+				p_dst[x * 4 + i] = pixel[i];
+			}
+		}
+	}
+}
+
+static void _lanczos_column_rgba8_scalar(const float *p_src, uint8_t *p_dst, uint32_t p_width, uint32_t p_row, const ImageKernels::LanczosWeights &p_weights) {
+	_lanczos_column_scalar(p_src, p_dst, p_width, p_row, p_weights);
+}
+
+static void _lanczos_column_rgbaf_scalar(const float *p_src, float *p_dst, uint32_t p_width, uint32_t p_row, const ImageKernels::LanczosWeights &p_weights) {
+	_lanczos_column_scalar(p_src, p_dst, p_width, p_row, p_weights);
+}
+
+/* SSE2 */
+
+#ifdef IMAGE_KERNELS_SSE2
+
+static _FORCE_INLINE_ __m128 _load_rgba8_sse2(const uint8_t *p_src) {
+	int32_t pixel;
+	memcpy(&pixel, p_src, 4);
+	const __m128i zero = _mm_setzero_si128();
+	return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pixel), zero), zero));
+}
+
+static _FORCE_INLINE_ void _store_rgba8_sse2(uint8_t *p_dst, __m128 p_pixel) {
+	// Rounds to nearest like Math::fast_ftoi(), then the saturating packs clamp to [0, 255].
+	const __m128i words = _mm_packs_epi32(_mm_cvtps_epi32(p_pixel), _mm_setzero_si128());
+	const int32_t pixel = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+	memcpy(p_dst, &pixel, 4);
+}
+
+static void _average_row_rgba8_sse2(const uint8_t *p_src_up, const uint8_t *p_src_down, uint8_t *p_dst, uint32_t p_dst_width) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i two = _mm_set1_epi16(2);
+
+	// 4 destination pixels from 8 source pixels of each row. Pixels are 32 bits, so the left and
+	// right pixel of each block are split with a float shuffle, then summed in 16 bits.
+	uint32_t x = 0;
+	for (; x + 4 <= p_dst_width; x += 4) {
+		const __m128 up_a = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)(p_src_up + x * 8)));
+		const __m128 up_b = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)(p_src_up + x * 8 + 16)));
+		const __m128 down_a = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)(p_src_down + x * 8)));
+		const __m128 down_b = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)(p_src_down + x * 8 + 16)));
+
+		const __m128i up_left = _mm_castps_si128(_mm_shuffle_ps(up_a, up_b, _MM_SHUFFLE(2, 0, 2, 0)));
+		const __m128i up_right = _mm_castps_si128(_mm_shuffle_ps(up_a, up_b, _MM_SHUFFLE(3, 1, 3, 1)));
+		const __m128i down_left = _mm_castps_si128(_mm_shuffle_ps(down_a, down_b, _MM_SHUFFLE(2, 0, 2, 0)));
+		const __m128i down_right = _mm_castps_si128(_mm_shuffle_ps(down_a, down_b, _MM_SHUFFLE(3, 1, 3, 1)));
+
+		__m128i low = _mm_add_epi16(_mm_unpacklo_epi8(up_left, zero), _mm_unpacklo_epi8(up_right, zero));
+		low = _mm_add_epi16(low, _mm_add_epi16(_mm_unpacklo_epi8(down_left, zero), _mm_unpacklo_epi8(down_right, zero)));
+		low = _mm_srli_epi16(_mm_add_epi16(low, two), 2);
+
+		__m128i high = _mm_add_epi16(_mm_unpackhi_epi8(up_left, zero), _mm_unpackhi_epi8(up_right, zero));
+		high = _mm_add_epi16(high, _mm_add_epi16(_mm_unpackhi_epi8(down_left, zero), _mm_unpackhi_epi8(down_right, zero)));
+		high = _mm_srli_epi16(_mm_add_epi16(high, two), 2);
+
+		_mm_storeu_si128((__m128i *)(p_dst + x * 4), _mm_packus_epi16(low, high));
+	}
+	for (; x < p_dst_width; x++) {
+		_average_pixel_rgba8(p_src_up + x * 8, p_src_down + x * 8, p_dst + x * 4);
+	}
+}
+
+static void _average_row_rgbaf_sse2(const float *p_src_up, const float *p_src_down, float *p_dst, uint32_t p_dst_width) {
+	const __m128 quarter = _mm_set1_ps(0.25f);
+	for (uint32_t x = 0; x < p_dst_width; x++) {
+		__m128 sum = _mm_add_ps(_mm_loadu_ps(p_src_up + x * 8), _mm_loadu_ps(p_src_up + x * 8 + 4));
+		sum = _mm_add_ps(sum, _mm_loadu_ps(p_src_down + x * 8));
+		sum = _mm_add_ps(sum, _mm_loadu_ps(p_src_down + x * 8 + 4));
+		_mm_storeu_ps(p_dst + x * 4, _mm_mul_ps(sum, quarter));
+	}
+}
+
+static void _lanczos_row_rgba8_sse2(const uint8_t *p_src, float *p_dst, uint32_t p_dst_width, const ImageKernels::LanczosWeights &p_weights) {
+	for (uint32_t x = 0; x < p_dst_width; x++) {
+		const int32_t start = p_weights.start[x];
+		const int32_t end = p_weights.end[x];
+		const float *kernel = p_weights.weights + x * p_weights.stride;
+
+		__m128 pixel = _mm_setzero_ps();
+		for (int32_t target = start; target <= end; target++) {
+			pixel = _mm_add_ps(pixel, _mm_mul_ps(_load_rgba8_sse2(p_src + target * 4), _mm_set1_ps(kernel[target - start])));
+		}
+		_mm_storeu_ps(p_dst + x * 4, _mm_div_ps(pixel, _mm_set1_ps(p_weights.weight_sums[x])));
+	}
+}
+
+static void _lanczos_row_rgbaf_sse2(const float *p_src, float *p_dst, uint32_t p_dst_width, const ImageKernels::LanczosWeights &p_weights) {
+	for (uint32_t x = 0; x < p_dst_width; x++) {
+		const int32_t start = p_weights.start[x];
+		const int32_t end = p_weights.end[x];
+		const float *kernel = p_weights.weights + x * p_weights.stride;
+
+		__m128 pixel = _mm_setzero_ps();
+		for (int32_t target = start; target <= end; target++) {
+			pixel = _mm_add_ps(pixel, _mm_mul_ps(_mm_loadu_ps(p_src + target * 4), _mm_set1_ps(kernel[target - start])));
+		}
+		_mm_storeu_ps(p_dst + x * 4, _mm_div_ps(pixel, _mm_set1_ps(p_weights.weight_sums[x])));
+	}
+}
+
+static _FORCE_INLINE_ __m128 _lanczos_column_pixel_sse2(const float *p_src, uint32_t p_width, uint32_t p_x, int32_t p_start, int32_t p_end, const float *p_kernel, __m128 p_weight_sum) {
+	__m128 pixel = _mm_setzero_ps();
+	for (int32_t target = p_start; target <= p_end; target++) {
+		pixel = _mm_add_ps(pixel, _mm_mul_ps(_mm_loadu_ps(p_src + (target * p_width + p_x) * 4), _mm_set1_ps(p_kernel[target - p_start])));
+	}
+	return _mm_div_ps(pixel, p_weight_sum);
+}
+
+static void _lanczos_column_rgba8_sse2(const float *p_src, uint8_t *p_dst, uint32_t p_width, uint32_t p_row, const ImageKernels::LanczosWeights &p_weights) {
+	const float *kernel = p_weights.weights + p_row * p_weights.stride;
+	const __m128 weight_sum = _mm_set1_ps(p_weights.weight_sums[p_row]);
+	for (uint32_t x = 0; x < p_width; x++) {
+		_store_rgba8_sse2(p_dst + x * 4, _lanczos_column_pixel_sse2(p_src, p_width, x, p_weights.start[p_row], p_weights.end[p_row], kernel, weight_sum));
+	}
+}
+
+static void _lanczos_column_rgbaf_sse2(const float *p_src, float *p_dst, uint32_t p_width, uint32_t p_row, const ImageKernels::LanczosWeights &p_weights) {
+	const float *kernel = p_weights.weights + p_row * p_weights.stride;
+	const __m128 weight_sum = _mm_set1_ps(p_weights.weight_sums[p_row]);
+	for (uint32_t x = 0; x < p_width; x++) {
+		_mm_storeu_ps(p_dst + x * 4, _lanczos_column_pixel_sse2(p_src, p_width, x, p_weights.start[p_row], p_weights.end[p_row], kernel, weight_sum));
+	}
+}
+
+#endif // IMAGE_KERNELS_SSE2
+
+/* NEON */
+
+#ifdef IMAGE_KERNELS_NEON
+
+static _FORCE_INLINE_ float32x4_t _load_rgba8_neon(const uint8_t *p_src) {
+	uint32_t pixel;
+	memcpy(&pixel, p_src, 4);
+	const uint16x8_t words = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(pixel)));
+	return vcvtq_f32_u32(vmovl_u16(vget_low_u16(words)));
+}
+
+static _FORCE_INLINE_ void _store_rgba8_neon(uint8_t *p_dst, float32x4_t p_pixel) {
+	// Rounds to nearest like Math::fast_ftoi(), then the saturating narrows clamp to [0, 255].
+	const uint16x4_t words = vqmovun_s32(vcvtnq_s32_f32(p_pixel));
+	const uint8x8_t bytes = vqmovn_u16(vcombine_u16(words, words));
+	const uint32_t pixel = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+	memcpy(p_dst, &pixel, 4);
+}
+
+static void _average_row_rgba8_neon(const uint8_t *p_src_up, const uint8_t *p_src_down, uint8_t *p_dst, uint32_t p_dst_width) {
+	// 4 destination pixels from 8 source pixels of each row. Loading them as 32 bit lanes splits the
+	// left and right pixel of each block, then they are summed in 16 bits.
+	uint32_t x = 0;
+	for (; x + 4 <= p_dst_width; x += 4) {
+		uint32_t up_pixels[8];
+		uint32_t down_pixels[8];
+		memcpy(up_pixels, p_src_up + x * 8, 32);
+		memcpy(down_pixels, p_src_down + x * 8, 32);
+		const uint32x4x2_t up = vld2q_u32(up_pixels);
+		const uint32x4x2_t down = vld2q_u32(down_pixels);
+
+		const uint8x16_t up_left = vreinterpretq_u8_u32(up.val[0]);
+		const uint8x16_t up_right = vreinterpretq_u8_u32(up.val[1]);
+		const uint8x16_t down_left = vreinterpretq_u8_u32(down.val[0]);
+		const uint8x16_t down_right = vreinterpretq_u8_u32(down.val[1]);
+
+		const uint16x8_t low = vaddq_u16(vaddl_u8(vget_low_u8(up_left), vget_low_u8(up_right)), vaddl_u8(vget_low_u8(down_left), vget_low_u8(down_right)));
+		const uint16x8_t high = vaddq_u16(vaddl_u8(vget_high_u8(up_left), vget_high_u8(up_right)), vaddl_u8(vget_high_u8(down_left), vget_high_u8(down_right)));
+
+		// Rounding shift, (sum + 2) >> 2.
+		vst1q_u8(p_dst + x * 4, vcombine_u8(vrshrn_n_u16(low, 2), vrshrn_n_u16(high, 2)));
+	}
+	for (; x < p_dst_width; x++) {
+		_average_pixel_rgba8(p_src_up + x * 8, p_src_down + x * 8, p_dst + x * 4);
+	}
+}
+
+static void _average_row_rgbaf_neon(const float *p_src_up, const float *p_src_down, float *p_dst, uint32_t p_dst_width) {
+	const float32x4_t quarter = vdupq_n_f32(0.25f);
+	for (uint32_t x = 0; x < p_dst_width; x++) {
+		float32x4_t sum = vaddq_f32(vld1q_f32(p_src_up + x * 8), vld1q_f32(p_src_up + x * 8 + 4));
+		sum = vaddq_f32(sum, vld1q_f32(p_src_down + x * 8));
+		sum = vaddq_f32(sum, vld1q_f32(p_src_down + x * 8 + 4));
+		vst1q_f32(p_dst + x * 4, vmulq_f32(sum, quarter));
+	}
+}
+
+static void _lanczos_row_rgba8_neon(const uint8_t *p_src, float *p_dst, uint32_t p_dst_width, const ImageKernels::LanczosWeights &p_weights) {
+	for (uint32_t x = 0; x < p_dst_width; x++) {
+		const int32_t start = p_weights.start[x];
+		const int32_t end = p_weights.end[x];
+		const float *kernel = p_weights.weights + x * p_weights.stride;
+
+		float32x4_t pixel = vdupq_n_f32(0.0f);
+		for (int32_t target = start; target <= end; target++) {
+			pixel = vaddq_f32(pixel, vmulq_n_f32(_load_rgba8_neon(p_src + target * 4), kernel[target - start]));
+		}
+		vst1q_f32(p_dst + x * 4, vdivq_f32(pixel, vdupq_n_f32(p_weights.weight_sums[x])));
+	}
+}
+
+static void _lanczos_row_rgbaf_neon(const float *p_src, float *p_dst, uint32_t p_dst_width, const ImageKernels::LanczosWeights &p_weights) {
+	for (uint32_t x = 0; x < p_dst_width; x++) {
+		const int32_t start = p_weights.start[x];
+		const int32_t end = p_weights.end[x];
+		const float *kernel = p_weights.weights + x * p_weights.stride;
+
+		float32x4_t pixel = vdupq_n_f32(0.0f);
+		for (int32_t target = start; target <= end; target++) {
+			pixel = vaddq_f32(pixel, vmulq_n_f32(vld1q_f32(p_src + target * 4), kernel[target - start]));
+		}
+		vst1q_f32(p_dst + x * 4, vdivq_f32(pixel, vdupq_n_f32(p_weights.weight_sums[x])));
+	}
+}
+
+static _FORCE_INLINE_ float32x4_t _lanczos_column_pixel_neon(const float *p_src, uint32_t p_width, uint32_t p_x, int32_t p_start, int32_t p_end, const float *p_kernel, float32x4_t p_weight_sum) {
+	float32x4_t pixel = vdupq_n_f32(0.0f);
+	for (int32_t target = p_start; target <= p_end; target++) {
+		pixel = vaddq_f32(pixel, vmulq_n_f32(vld1q_f32(p_src + (target * p_width + p_x) * 4), p_kernel[target - p_start]));
+	}
+	return vdivq_f32(pixel, p_weight_sum);
+}
+
+static void _lanczos_column_rgba8_neon(const float *p_src, uint8_t *p_dst, uint32_t p_width, uint32_t p_row, const ImageKernels::LanczosWeights &p_weights) {
+	const float *kernel = p_weights.weights + p_row * p_weights.stride;
+	const float32x4_t weight_sum = vdupq_n_f32(p_weights.weight_sums[p_row]);
+	for (uint32_t x = 0; x < p_width; x++) {
+		_store_rgba8_neon(p_dst + x * 4, _lanczos_column_pixel_neon(p_src, p_width, x, p_weights.start[p_row], p_weights.end[p_row], kernel, weight_sum));
+	}
+}
+
+static void _lanczos_column_rgbaf_neon(const float *p_src, float *p_dst, uint32_t p_width, uint32_t p_row, const ImageKernels::LanczosWeights &p_weights) {
+	const float *kernel = p_weights.weights + p_row * p_weights.stride;
+	const float32x4_t weight_sum = vdupq_n_f32(p_weights.weight_sums[p_row]);
+	for (uint32_t x = 0; x < p_width; x++) {
+		vst1q_f32(p_dst + x * 4, _lanczos_column_pixel_neon(p_src, p_width, x, p_weights.start[p_row], p_weights.end[p_row], kernel, weight_sum));
+	}
+}
+
+#endif // IMAGE_KERNELS_NEON
+
+/* Backend selection */
+
+#if defined(IMAGE_KERNELS_SSE2)
+ImageKernels::Backend ImageKernels::backend = BACKEND_SSE2;
+ImageKernels::AverageRowRGBA8Func ImageKernels::average_row_rgba8 = _average_row_rgba8_sse2;
+ImageKernels::AverageRowRGBAFFunc ImageKernels::average_row_rgbaf = _average_row_rgbaf_sse2;
+ImageKernels::LanczosRowRGBA8Func ImageKernels::lanczos_row_rgba8 = _lanczos_row_rgba8_sse2;
+ImageKernels::LanczosRowRGBAFFunc ImageKernels::lanczos_row_rgbaf = _lanczos_row_rgbaf_sse2;
+ImageKernels::LanczosColumnRGBA8Func ImageKernels::lanczos_column_rgba8 = _lanczos_column_rgba8_sse2;
+ImageKernels::LanczosColumnRGBAFFunc ImageKernels::lanczos_column_rgbaf = _lanczos_column_rgbaf_sse2;
+#elif defined(IMAGE_KERNELS_NEON)
+ImageKernels::Backend ImageKernels::backend = BACKEND_NEON;
+ImageKernels::AverageRowRGBA8Func ImageKernels::average_row_rgba8 = _average_row_rgba8_neon;
+ImageKernels::AverageRowRGBAFFunc ImageKernels::average_row_rgbaf = _average_row_rgbaf_neon;
+ImageKernels::LanczosRowRGBA8Func ImageKernels::lanczos_row_rgba8 = _lanczos_row_rgba8_neon;
+ImageKernels::LanczosRowRGBAFFunc ImageKernels::lanczos_row_rgbaf = _lanczos_row_rgbaf_neon;
+ImageKernels::LanczosColumnRGBA8Func ImageKernels::lanczos_column_rgba8 = _lanczos_column_rgba8_neon;
+ImageKernels::LanczosColumnRGBAFFunc ImageKernels::lanczos_column_rgbaf = _lanczos_column_rgbaf_neon;
+#else
+ImageKernels::Backend ImageKernels::backend = BACKEND_SCALAR;
+ImageKernels::AverageRowRGBA8Func ImageKernels::average_row_rgba8 = _average_row_rgba8_scalar;
+ImageKernels::AverageRowRGBAFFunc ImageKernels::average_row_rgbaf = _average_row_rgbaf_scalar;
+ImageKernels::LanczosRowRGBA8Func ImageKernels::lanczos_row_rgba8 = _lanczos_row_rgba8_scalar;
+ImageKernels::LanczosRowRGBAFFunc ImageKernels::lanczos_row_rgbaf = _lanczos_row_rgbaf_scalar;
+ImageKernels::LanczosColumnRGBA8Func ImageKernels::lanczos_column_rgba8 = _lanczos_column_rgba8_scalar;
+ImageKernels::LanczosColumnRGBAFFunc ImageKernels::lanczos_column_rgbaf = _lanczos_column_rgbaf_scalar;
+#endif
+
+bool ImageKernels::is_backend_supported(Backend p_backend) {
+	switch (p_backend) {
+		case BACKEND_SCALAR:
+			return true;
+		case BACKEND_SSE2:
+#ifdef IMAGE_KERNELS_SSE2
+			return true;
+#else
+			return false;
+#endif
+		case BACKEND_NEON:
+#ifdef IMAGE_KERNELS_NEON
+			return true;
+#else
+			return false;
+#endif
+	}
+	return false;
+}
+
+ImageKernels::Backend ImageKernels::get_best_backend() {
+#if defined(IMAGE_KERNELS_SSE2)
+	return BACKEND_SSE2;
+#elif defined(IMAGE_KERNELS_NEON)
+	return BACKEND_NEON;
+#else
+	return BACKEND_SCALAR;
+#endif
+}
+
+void ImageKernels::set_backend(Backend p_backend) {
+	ERR_FAIL_COND_MSG(!is_backend_supported(p_backend), "This image kernel backend isn't supported by this build.");
+
+	backend = p_backend;
+	switch (p_backend) {
+		case BACKEND_SCALAR: {
+			average_row_rgba8 = _average_row_rgba8_scalar;
+			average_row_rgbaf = _average_row_rgbaf_scalar;
+			lanczos_row_rgba8 = _lanczos_row_rgba8_scalar;
+			lanczos_row_rgbaf = _lanczos_row_rgbaf_scalar;
+			lanczos_column_rgba8 = _lanczos_column_rgba8_scalar;
+			lanczos_column_rgbaf = _lanczos_column_rgbaf_scalar;
+		} break;
+		case BACKEND_SSE2: {
+#ifdef IMAGE_KERNELS_SSE2
+			average_row_rgba8 = _average_row_rgba8_sse2;
+			average_row_rgbaf = _average_row_rgbaf_sse2;
+			lanczos_row_rgba8 = _lanczos_row_rgba8_sse2;
+			lanczos_row_rgbaf = _lanczos_row_rgbaf_sse2;
+			lanczos_column_rgba8 = _lanczos_column_rgba8_sse2;
+			lanczos_column_rgbaf = _lanczos_column_rgbaf_sse2;
+#endif
+		} break;
+		case BACKEND_NEON: {
+#ifdef IMAGE_KERNELS_NEON
+			average_row_rgba8 = _average_row_rgba8_neon;
+			average_row_rgbaf = _average_row_rgbaf_neon;
+			lanczos_row_rgba8 = _lanczos_row_rgba8_neon;
+			lanczos_row_rgbaf = _lanczos_row_rgbaf_neon;
+			lanczos_column_rgba8 = _lanczos_column_rgba8_neon;
+			lanczos_column_rgbaf = _lanczos_column_rgbaf_neon;
+#endif
+		} break;
+	}
+}
+
+const char *ImageKernels::get_backend_name(Backend p_backend) {
+	switch (p_backend) {
+		case BACKEND_SCALAR:
+			return "Scalar";
+		case BACKEND_SSE2:
+			return "SSE2";
+		case BACKEND_NEON:
+			return "NEON";
+	}
+	return "Unknown";
+}
@@ -0,0 +1,86 @@
+/**************************************************************************/
+/*  image_kernels.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef IMAGE_KERNELS_H
+#define IMAGE_KERNELS_H
+
+#include "core/typedefs.h"
+
+// Row kernels for the most common RGBA8 and RGBAF image operations. SSE2 and NEON versions are
+// used when the build supports them, and the backend can be changed at runtime. The scalar versions
+// do the same operations in the same order, so every backend gives the same results.
+class ImageKernels {
+public:
+	enum Backend {
+		BACKEND_SCALAR,
+		BACKEND_SSE2,
+		BACKEND_NEON,
+	};
+
+	// Weights of a Lanczos pass along one axis. Destination pixel `i` sums the source pixels
+	// `start[i]` to `end[i]`, weighted by `weights[i * stride]` onwards, then divides by `weight_sums[i]`.
+	struct LanczosWeights {
+		const int32_t *start = nullptr;
+		const int32_t *end = nullptr;
+		const float *weights = nullptr;
+		uint32_t stride = 0;
+		const float *weight_sums = nullptr;
+	};
+
+	// One destination row of a power of 2 mipmap, averaging each 2x2 block of the two source rows.
+	// Same as Image::average_4_uint8() and Image::average_4_float() for each component.
+	typedef void (*AverageRowRGBA8Func)(const uint8_t *p_src_up, const uint8_t *p_src_down, uint8_t *p_dst, uint32_t p_dst_width);
+	typedef void (*AverageRowRGBAFFunc)(const float *p_src_up, const float *p_src_down, float *p_dst, uint32_t p_dst_width);
+	// Horizontal Lanczos pass of one row, into a row of RGBAF pixels.
+	typedef void (*LanczosRowRGBA8Func)(const uint8_t *p_src, float *p_dst, uint32_t p_dst_width, const LanczosWeights &p_weights);
+	typedef void (*LanczosRowRGBAFFunc)(const float *p_src, float *p_dst, uint32_t p_dst_width, const LanczosWeights &p_weights);
+	// Vertical Lanczos pass for destination row `p_row`, from the RGBAF rows of the horizontal pass.
+	typedef void (*LanczosColumnRGBA8Func)(const float *p_src, uint8_t *p_dst, uint32_t p_width, uint32_t p_row, const LanczosWeights &p_weights);
+	typedef void (*LanczosColumnRGBAFFunc)(const float *p_src, float *p_dst, uint32_t p_width, uint32_t p_row, const LanczosWeights &p_weights);
+
+private:
+	static Backend backend;
+
+public:
+	static AverageRowRGBA8Func average_row_rgba8;
+	static AverageRowRGBAFFunc average_row_rgbaf;
+	static LanczosRowRGBA8Func lanczos_row_rgba8;
+	static LanczosRowRGBAFFunc lanczos_row_rgbaf;
+	static LanczosColumnRGBA8Func lanczos_column_rgba8;
+	static LanczosColumnRGBAFFunc lanczos_column_rgbaf;
+
+	static bool is_backend_supported(Backend p_backend);
+	static Backend get_best_backend();
+	static void set_backend(Backend p_backend);
+	static Backend get_backend() { return backend; }
+	static const char *get_backend_name(Backend p_backend);
+};
+
+#endif // IMAGE_KERNELS_H
@@ -1955,6 +1955,135 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 	return OK;
 }
 
+Error VariantEncoder::append(const Variant &p_variant) {
+	uint32_t ofs = buffer.size();
+
+	switch (p_variant.get_type()) {
+		case Variant::BOOL: {
+			if (compact) {
+				buffer.push_back(uint8_t(Variant::BOOL | (p_variant.operator bool() ? COMPACT_BOOL_MASK : 0)));
+				return OK;
+			}
+		} break;
+		case Variant::INT: {
+			if (compact) {
+				int64_t val = p_variant;
+				buffer.resize(ofs + 1 + sizeof(int64_t));
+				uint8_t *buf = buffer.ptr() + ofs;
+				int len = 1;
+				if (val <= (int64_t)INT8_MAX && val >= (int64_t)INT8_MIN) {
+					buf[0] = COMPACT_MODE_8 | Variant::INT;
+					buf[1] = val;
+					len += 1;
+				} else if (val <= (int64_t)INT16_MAX && val >= (int64_t)INT16_MIN) {
+					buf[0] = COMPACT_MODE_16 | Variant::INT;
+					len += encode_uint16(val, &buf[1]);
+				} else if (val <= (int64_t)INT32_MAX && val >= (int64_t)INT32_MIN) {
+					buf[0] = COMPACT_MODE_32 | Variant::INT;
+					len += encode_uint32(val, &buf[1]);
+				} else {
+					buf[0] = COMPACT_MODE_64 | Variant::INT;
+					len += encode_uint64(val, &buf[1]);
+				}
+				buffer.resize(ofs + len);
+				return OK;
+			}
+		} break;
+		case Variant::NIL:
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR2I:
+		case Variant::RECT2:
+		case Variant::RECT2I:
+		case Variant::VECTOR3:
+		case Variant::VECTOR3I:
+		case Variant::VECTOR4:
+		case Variant::VECTOR4I:
+		case Variant::TRANSFORM2D:
+		case Variant::PLANE:
+		case Variant::QUATERNION:
+		case Variant::AABB:
+		case Variant::BASIS:
+		case Variant::TRANSFORM3D:
+		case Variant::PROJECTION:
+		case Variant::COLOR:
+		case Variant::RID: {
+		} break;
+		default: {
+			// Variable size, measure first and then write in place.
+			int len = 0;
+			Error err = encode_variant(p_variant, nullptr, len, full_objects);
+			ERR_FAIL_COND_V(err != OK, err);
+			buffer.resize(ofs + len);
+			return encode_variant(p_variant, buffer.ptr() + ofs, len, full_objects);
+		}
+	}
+
+	// Fixed size, reserve enough for the largest one (a Projection of doubles) and encode once.
+	const int MAX_FIXED_SIZE = 4 + sizeof(double) * 16;
+	buffer.resize(ofs + MAX_FIXED_SIZE);
+	int len = 0;
+	Error err = encode_variant(p_variant, buffer.ptr() + ofs, len, full_objects);
+	buffer.resize(err == OK ? ofs + len : ofs);
+	return err;
+}
+
+Error VariantEncoder::append_array(const Variant **p_variants, int p_count) {
+	for (int i = 0; i < p_count; i++) {
+		Error err = append(*p_variants[i]);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+	return OK;
+}
+
+Error VariantDecoder::next(Variant &r_variant) {
+	ERR_FAIL_COND_V(position >= size, ERR_FILE_EOF);
+	const uint8_t *buf = data + position;
+	int len = size - position;
+
+	if (compact) {
+		const uint8_t type = buf[0] & VariantEncoder::COMPACT_TYPE_MASK;
+		const uint8_t mode = buf[0] & VariantEncoder::COMPACT_MODE_MASK;
+		if (type == Variant::BOOL) {
+			r_variant = (buf[0] & VariantEncoder::COMPACT_BOOL_MASK) != 0;
+			position += 1;
+			return OK;
+		} else if (type == Variant::INT) {
+			buf += 1;
+			len -= 1;
+			switch (mode) {
+				case VariantEncoder::COMPACT_MODE_8: {
+					ERR_FAIL_COND_V(len < 1, ERR_INVALID_DATA);
+					r_variant = (int8_t)buf[0];
+					position += 2;
+				} break;
+				case VariantEncoder::COMPACT_MODE_16: {
+					ERR_FAIL_COND_V(len < 2, ERR_INVALID_DATA);
+					r_variant = (int16_t)decode_uint16(buf);
+					position += 3;
+				} break;
+				case VariantEncoder::COMPACT_MODE_32: {
+					ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+					r_variant = (int32_t)decode_uint32(buf);
+					position += 5;
+				} break;
+				default: {
+					ERR_FAIL_COND_V(len < 8, ERR_INVALID_DATA);
+					r_variant = (int64_t)decode_uint64(buf);
+					position += 9;
+				} break;
+			}
+			return OK;
+		}
+	}
+
+	int used = 0;
+	Error err = decode_variant(r_variant, buf, len, &used, allow_objects);
+	ERR_FAIL_COND_V(err != OK, err);
+	position += used;
+	return OK;
+}
+
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count) {
 	// We always allocate a new array, and we don't memcpy.
 	// We also don't consider returning a pointer to the passed vectors when sizeof(real_t) == 4.
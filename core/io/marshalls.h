@@ -33,6 +33,7 @@
 
 #include "core/math/math_defs.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 #include "core/variant/variant.h"
 
@@ -215,6 +216,62 @@ public:
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false, int p_depth = 0);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0);
 
+// Encodes a sequence of Variants back to back into a buffer that is kept across calls,
+// so encoding the same kind of data every frame doesn't allocate once it has warmed up.
+// Fixed size types are written in a single pass, instead of being measured first.
+//
+// With compact encoding, booleans take a single byte and integers are stored in the
+// smallest of 1, 2, 4 or 8 bytes. The first byte then holds the type in its 6 lower
+// bits and the encoding mode (or the boolean value) in the upper 2 bits. This is the
+// format used by the multiplayer API. Other types are stored as in encode_variant().
+class VariantEncoder {
+	LocalVector<uint8_t> buffer;
+	bool full_objects = false;
+	bool compact = false;
+
+public:
+	enum CompactMode {
+		COMPACT_MODE_8 = 0 << 6,
+		COMPACT_MODE_16 = 1 << 6,
+		COMPACT_MODE_32 = 2 << 6,
+		COMPACT_MODE_64 = 3 << 6,
+		COMPACT_TYPE_MASK = 0x3F,
+		COMPACT_MODE_MASK = 0xC0,
+		COMPACT_BOOL_MASK = 0x80,
+	};
+
+	Error append(const Variant &p_variant);
+	Error append_array(const Variant **p_variants, int p_count);
+
+	const uint8_t *get_data() const { return buffer.ptr(); }
+	int get_size() const { return buffer.size(); }
+	// Keeps the allocated memory around for the next batch.
+	void clear() { buffer.clear(); }
+
+	VariantEncoder(bool p_full_objects = false, bool p_compact = false) :
+			full_objects(p_full_objects), compact(p_compact) {}
+};
+
+// Reads Variants written back to back (e.g. by VariantEncoder) directly from
+// a caller owned buffer, without copying it.
+class VariantDecoder {
+	const uint8_t *data = nullptr;
+	int size = 0;
+	int position = 0;
+	bool allow_objects = false;
+	bool compact = false;
+
+public:
+	Error next(Variant &r_variant);
+
+	int get_position() const { return position; }
+	int get_remaining() const { return size - position; }
+	bool is_at_end() const { return position >= size; }
+
+	VariantDecoder(const uint8_t *p_data, int p_size, bool p_allow_objects = false, bool p_compact = false) :
+			data(p_data), size(p_size), allow_objects(p_allow_objects), compact(p_compact) {}
+};
+
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count);
 
 #endif // MARSHALLS_H
@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/image.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
@@ -98,11 +99,11 @@ enum {
 	FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
 };
 
-void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
+void ResourceLoaderBinary::_advance_padding(Ref<FileAccess> &p_f, uint32_t p_len) {
 	uint32_t extra = 4 - (p_len % 4);
 	if (extra < 4) {
 		for (uint32_t i = 0; i < extra; i++) {
-			f->get_8(); //pad to 32
+			p_f->get_8(); //pad to 32
 		}
 	}
 }
@@ -151,27 +152,35 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	return OK;
 }
 
-StringName ResourceLoaderBinary::_get_string() {
-	uint32_t id = f->get_32();
+StringName ResourceLoaderBinary::_get_string(Ref<FileAccess> &p_f) {
+	uint32_t id = p_f->get_32();
 	if (id & 0x80000000) {
 		uint32_t len = id & 0x7FFFFFFF;
-		if ((int)len > str_buf.size()) {
-			str_buf.resize(len);
-		}
 		if (len == 0) {
 			return StringName();
 		}
-		f->get_buffer((uint8_t *)&str_buf[0], len);
 		String s;
-		s.parse_utf8(&str_buf[0]);
+		const char *mapped = (const char *)p_f->get_buffer_mapped(len);
+		if (mapped) {
+			s.parse_utf8(mapped, len);
+			return s;
+		}
+		// Decoding tasks read from their own file, and can't share str_buf.
+		Vector<char> task_buf;
+		Vector<char> &buf = p_f == f ? str_buf : task_buf;
+		if ((int)len > buf.size()) {
+			buf.resize(len);
+		}
+		p_f->get_buffer((uint8_t *)&buf.write[0], len);
+		s.parse_utf8(&buf[0]);
 		return s;
 	}
 
 	return string_map[id];
 }
 
-Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
-	uint32_t prop_type = f->get_32();
+Error ResourceLoaderBinary::parse_variant(Ref<FileAccess> &p_f, Variant &r_v) {
+	uint32_t prop_type = p_f->get_32();
 	print_bl("find property of type: " + itos(prop_type));
 
 	switch (prop_type) {
@@ -179,185 +188,185 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			r_v = Variant();
 		} break;
 		case VARIANT_BOOL: {
-			r_v = bool(f->get_32());
+			r_v = bool(p_f->get_32());
 		} break;
 		case VARIANT_INT: {
-			r_v = int(f->get_32());
+			r_v = int(p_f->get_32());
 		} break;
 		case VARIANT_INT64: {
-			r_v = int64_t(f->get_64());
+			r_v = int64_t(p_f->get_64());
 		} break;
 		case VARIANT_FLOAT: {
-			r_v = f->get_real();
+			r_v = p_f->get_real();
 		} break;
 		case VARIANT_DOUBLE: {
-			r_v = f->get_double();
+			r_v = p_f->get_double();
 		} break;
 		case VARIANT_STRING: {
-			r_v = get_unicode_string();
+			r_v = get_unicode_string(p_f);
 		} break;
 		case VARIANT_VECTOR2: {
 			Vector2 v;
-			v.x = f->get_real();
-			v.y = f->get_real();
+			v.x = p_f->get_real();
+			v.y = p_f->get_real();
 			r_v = v;
 
 		} break;
 		case VARIANT_VECTOR2I: {
 			Vector2i v;
-			v.x = f->get_32();
-			v.y = f->get_32();
+			v.x = p_f->get_32();
+			v.y = p_f->get_32();
 			r_v = v;
 
 		} break;
 		case VARIANT_RECT2: {
 			Rect2 v;
-			v.position.x = f->get_real();
-			v.position.y = f->get_real();
-			v.size.x = f->get_real();
-			v.size.y = f->get_real();
+			v.position.x = p_f->get_real();
+			v.position.y = p_f->get_real();
+			v.size.x = p_f->get_real();
+			v.size.y = p_f->get_real();
 			r_v = v;
 
 		} break;
 		case VARIANT_RECT2I: {
 			Rect2i v;
-			v.position.x = f->get_32();
-			v.position.y = f->get_32();
-			v.size.x = f->get_32();
-			v.size.y = f->get_32();
+			v.position.x = p_f->get_32();
+			v.position.y = p_f->get_32();
+			v.size.x = p_f->get_32();
+			v.size.y = p_f->get_32();
 			r_v = v;
 
 		} break;
 		case VARIANT_VECTOR3: {
 			Vector3 v;
-			v.x = f->get_real();
-			v.y = f->get_real();
-			v.z = f->get_real();
+			v.x = p_f->get_real();
+			v.y = p_f->get_real();
+			v.z = p_f->get_real();
 			r_v = v;
 		} break;
 		case VARIANT_VECTOR3I: {
 			Vector3i v;
-			v.x = f->get_32();
-			v.y = f->get_32();
-			v.z = f->get_32();
+			v.x = p_f->get_32();
+			v.y = p_f->get_32();
+			v.z = p_f->get_32();
 			r_v = v;
 		} break;
 		case VARIANT_VECTOR4: {
 			Vector4 v;
-			v.x = f->get_real();
-			v.y = f->get_real();
-			v.z = f->get_real();
-			v.w = f->get_real();
+			v.x = p_f->get_real();
+			v.y = p_f->get_real();
+			v.z = p_f->get_real();
+			v.w = p_f->get_real();
 			r_v = v;
 		} break;
 		case VARIANT_VECTOR4I: {
 			Vector4i v;
-			v.x = f->get_32();
-			v.y = f->get_32();
-			v.z = f->get_32();
-			v.w = f->get_32();
+			v.x = p_f->get_32();
+			v.y = p_f->get_32();
+			v.z = p_f->get_32();
+			v.w = p_f->get_32();
 			r_v = v;
 		} break;
 		case VARIANT_PLANE: {
 			Plane v;
-			v.normal.x = f->get_real();
-			v.normal.y = f->get_real();
-			v.normal.z = f->get_real();
-			v.d = f->get_real();
+			v.normal.x = p_f->get_real();
+			v.normal.y = p_f->get_real();
+			v.normal.z = p_f->get_real();
+			v.d = p_f->get_real();
 			r_v = v;
 		} break;
 		case VARIANT_QUATERNION: {
 			Quaternion v;
-			v.x = f->get_real();
-			v.y = f->get_real();
-			v.z = f->get_real();
-			v.w = f->get_real();
+			v.x = p_f->get_real();
+			v.y = p_f->get_real();
+			v.z = p_f->get_real();
+			v.w = p_f->get_real();
 			r_v = v;
 
 		} break;
 		case VARIANT_AABB: {
 			AABB v;
-			v.position.x = f->get_real();
-			v.position.y = f->get_real();
-			v.position.z = f->get_real();
-			v.size.x = f->get_real();
-			v.size.y = f->get_real();
-			v.size.z = f->get_real();
+			v.position.x = p_f->get_real();
+			v.position.y = p_f->get_real();
+			v.position.z = p_f->get_real();
+			v.size.x = p_f->get_real();
+			v.size.y = p_f->get_real();
+			v.size.z = p_f->get_real();
 			r_v = v;
 
 		} break;
 		case VARIANT_TRANSFORM2D: {
 			Transform2D v;
-			v.columns[0].x = f->get_real();
-			v.columns[0].y = f->get_real();
-			v.columns[1].x = f->get_real();
-			v.columns[1].y = f->get_real();
-			v.columns[2].x = f->get_real();
-			v.columns[2].y = f->get_real();
+			v.columns[0].x = p_f->get_real();
+			v.columns[0].y = p_f->get_real();
+			v.columns[1].x = p_f->get_real();
+			v.columns[1].y = p_f->get_real();
+			v.columns[2].x = p_f->get_real();
+			v.columns[2].y = p_f->get_real();
 			r_v = v;
 
 		} break;
 		case VARIANT_BASIS: {
 			Basis v;
-			v.rows[0].x = f->get_real();
-			v.rows[0].y = f->get_real();
-			v.rows[0].z = f->get_real();
-			v.rows[1].x = f->get_real();
-			v.rows[1].y = f->get_real();
-			v.rows[1].z = f->get_real();
-			v.rows[2].x = f->get_real();
-			v.rows[2].y = f->get_real();
-			v.rows[2].z = f->get_real();
+			v.rows[0].x = p_f->get_real();
+			v.rows[0].y = p_f->get_real();
+			v.rows[0].z = p_f->get_real();
+			v.rows[1].x = p_f->get_real();
+			v.rows[1].y = p_f->get_real();
+			v.rows[1].z = p_f->get_real();
+			v.rows[2].x = p_f->get_real();
+			v.rows[2].y = p_f->get_real();
+			v.rows[2].z = p_f->get_real();
 			r_v = v;
 
 		} break;
 		case VARIANT_TRANSFORM3D: {
 			Transform3D v;
-			v.basis.rows[0].x = f->get_real();
-			v.basis.rows[0].y = f->get_real();
-			v.basis.rows[0].z = f->get_real();
-			v.basis.rows[1].x = f->get_real();
-			v.basis.rows[1].y = f->get_real();
-			v.basis.rows[1].z = f->get_real();
-			v.basis.rows[2].x = f->get_real();
-			v.basis.rows[2].y = f->get_real();
-			v.basis.rows[2].z = f->get_real();
-			v.origin.x = f->get_real();
-			v.origin.y = f->get_real();
-			v.origin.z = f->get_real();
+			v.basis.rows[0].x = p_f->get_real();
+			v.basis.rows[0].y = p_f->get_real();
+			v.basis.rows[0].z = p_f->get_real();
+			v.basis.rows[1].x = p_f->get_real();
+			v.basis.rows[1].y = p_f->get_real();
+			v.basis.rows[1].z = p_f->get_real();
+			v.basis.rows[2].x = p_f->get_real();
+			v.basis.rows[2].y = p_f->get_real();
+			v.basis.rows[2].z = p_f->get_real();
+			v.origin.x = p_f->get_real();
+			v.origin.y = p_f->get_real();
+			v.origin.z = p_f->get_real();
 			r_v = v;
 		} break;
 		case VARIANT_PROJECTION: {
 			Projection v;
-			v.columns[0].x = f->get_real();
-			v.columns[0].y = f->get_real();
-			v.columns[0].z = f->get_real();
-			v.columns[0].w = f->get_real();
-			v.columns[1].x = f->get_real();
-			v.columns[1].y = f->get_real();
-			v.columns[1].z = f->get_real();
-			v.columns[1].w = f->get_real();
-			v.columns[2].x = f->get_real();
-			v.columns[2].y = f->get_real();
-			v.columns[2].z = f->get_real();
-			v.columns[2].w = f->get_real();
-			v.columns[3].x = f->get_real();
-			v.columns[3].y = f->get_real();
-			v.columns[3].z = f->get_real();
-			v.columns[3].w = f->get_real();
+			v.columns[0].x = p_f->get_real();
+			v.columns[0].y = p_f->get_real();
+			v.columns[0].z = p_f->get_real();
+			v.columns[0].w = p_f->get_real();
+			v.columns[1].x = p_f->get_real();
+			v.columns[1].y = p_f->get_real();
+			v.columns[1].z = p_f->get_real();
+			v.columns[1].w = p_f->get_real();
+			v.columns[2].x = p_f->get_real();
+			v.columns[2].y = p_f->get_real();
+			v.columns[2].z = p_f->get_real();
+			v.columns[2].w = p_f->get_real();
+			v.columns[3].x = p_f->get_real();
+			v.columns[3].y = p_f->get_real();
+			v.columns[3].z = p_f->get_real();
+			v.columns[3].w = p_f->get_real();
 			r_v = v;
 		} break;
 		case VARIANT_COLOR: {
 			Color v; // Colors should always be in single-precision.
-			v.r = f->get_float();
-			v.g = f->get_float();
-			v.b = f->get_float();
-			v.a = f->get_float();
+			v.r = p_f->get_float();
+			v.g = p_f->get_float();
+			v.b = p_f->get_float();
+			v.a = p_f->get_float();
 			r_v = v;
 
 		} break;
 		case VARIANT_STRING_NAME: {
-			r_v = StringName(get_unicode_string());
+			r_v = StringName(get_unicode_string(p_f));
 		} break;
 
 		case VARIANT_NODE_PATH: {
@@ -365,8 +374,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<StringName> subnames;
 			bool absolute;
 
-			int name_count = f->get_16();
-			uint32_t subname_count = f->get_16();
+			int name_count = p_f->get_16();
+			uint32_t subname_count = p_f->get_16();
 			absolute = subname_count & 0x8000;
 			subname_count &= 0x7FFF;
 			if (ver_format < FORMAT_VERSION_NO_NODEPATH_PROPERTY) {
@@ -374,10 +383,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			}
 
 			for (int i = 0; i < name_count; i++) {
-				names.push_back(_get_string());
+				names.push_back(_get_string(p_f));
 			}
 			for (uint32_t i = 0; i < subname_count; i++) {
-				subnames.push_back(_get_string());
+				subnames.push_back(_get_string(p_f));
 			}
 
 			NodePath np = NodePath(names, subnames, absolute);
@@ -386,10 +395,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 		} break;
 		case VARIANT_RID: {
-			r_v = f->get_32();
+			r_v = p_f->get_32();
 		} break;
 		case VARIANT_OBJECT: {
-			uint32_t objtype = f->get_32();
+			uint32_t objtype = p_f->get_32();
 
 			switch (objtype) {
 				case OBJECT_EMPTY: {
@@ -397,7 +406,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 				} break;
 				case OBJECT_INTERNAL_RESOURCE: {
-					uint32_t index = f->get_32();
+					uint32_t index = p_f->get_32();
 					String path;
 
 					if (using_named_scene_ids) { // New format.
@@ -408,18 +417,19 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					}
 
 					//always use internal cache for loading internal resources
-					if (!internal_index_cache.has(path)) {
+					const Ref<Resource> *cached = internal_index_cache.getptr(path);
+					if (!cached) {
 						WARN_PRINT(String("Couldn't load resource (no cache): " + path).utf8().get_data());
 						r_v = Variant();
 					} else {
-						r_v = internal_index_cache[path];
+						r_v = *cached;
 					}
 				} break;
 				case OBJECT_EXTERNAL_RESOURCE: {
 					//old file format, still around for compatibility
 
-					String exttype = get_unicode_string();
-					String path = get_unicode_string();
+					String exttype = get_unicode_string(p_f);
+					String path = get_unicode_string(p_f);
 
 					if (!path.contains("://") && path.is_relative_path()) {
 						// path is relative to file being loaded, so convert to a resource path
@@ -440,13 +450,16 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 				} break;
 				case OBJECT_EXTERNAL_RESOURCE_INDEX: {
 					//new file format, just refers to an index in the external list
-					int erindex = f->get_32();
+					int erindex = p_f->get_32();
 
 					if (erindex < 0 || erindex >= external_resources.size()) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
+					} else if (external_resources[erindex].resource.is_valid()) {
+						// Already completed before decoding in parallel.
+						r_v = external_resources[erindex].resource;
 					} else {
-						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
+						const Ref<ResourceLoader::LoadToken> &load_token = external_resources[erindex].load_token;
 						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
 							Error err;
 							Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
@@ -478,28 +491,28 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 
 		case VARIANT_DICTIONARY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 			Dictionary d; //last bit means shared
 			len &= 0x7FFFFFFF;
 			for (uint32_t i = 0; i < len; i++) {
 				Variant key;
-				Error err = parse_variant(key);
+				Error err = parse_variant(p_f, key);
 				ERR_FAIL_COND_V_MSG(err, ERR_FILE_CORRUPT, "Error when trying to parse Variant.");
 				Variant value;
-				err = parse_variant(value);
+				err = parse_variant(p_f, value);
 				ERR_FAIL_COND_V_MSG(err, ERR_FILE_CORRUPT, "Error when trying to parse Variant.");
 				d[key] = value;
 			}
 			r_v = d;
 		} break;
 		case VARIANT_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 			Array a; //last bit means shared
 			len &= 0x7FFFFFFF;
 			a.resize(len);
 			for (uint32_t i = 0; i < len; i++) {
 				Variant val;
-				Error err = parse_variant(val);
+				Error err = parse_variant(p_f, val);
 				ERR_FAIL_COND_V_MSG(err, ERR_FILE_CORRUPT, "Error when trying to parse Variant.");
 				a[i] = val;
 			}
@@ -507,24 +520,24 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 		} break;
 		case VARIANT_PACKED_BYTE_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<uint8_t> array;
 			array.resize(len);
 			uint8_t *w = array.ptrw();
-			f->get_buffer(w, len);
-			_advance_padding(len);
+			p_f->get_buffer(w, len);
+			_advance_padding(p_f, len);
 
 			r_v = array;
 
 		} break;
 		case VARIANT_PACKED_INT32_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<int32_t> array;
 			array.resize(len);
 			int32_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int32_t));
+			p_f->get_buffer((uint8_t *)w, len * sizeof(int32_t));
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -538,12 +551,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			r_v = array;
 		} break;
 		case VARIANT_PACKED_INT64_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<int64_t> array;
 			array.resize(len);
 			int64_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int64_t));
+			p_f->get_buffer((uint8_t *)w, len * sizeof(int64_t));
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint64_t *ptr = (uint64_t *)w.ptr();
@@ -557,12 +570,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			r_v = array;
 		} break;
 		case VARIANT_PACKED_FLOAT32_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<float> array;
 			array.resize(len);
 			float *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(float));
+			p_f->get_buffer((uint8_t *)w, len * sizeof(float));
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -576,12 +589,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			r_v = array;
 		} break;
 		case VARIANT_PACKED_FLOAT64_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<double> array;
 			array.resize(len);
 			double *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(double));
+			p_f->get_buffer((uint8_t *)w, len * sizeof(double));
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint64_t *ptr = (uint64_t *)w.ptr();
@@ -595,52 +608,52 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			r_v = array;
 		} break;
 		case VARIANT_PACKED_STRING_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 			Vector<String> array;
 			array.resize(len);
 			String *w = array.ptrw();
 			for (uint32_t i = 0; i < len; i++) {
-				w[i] = get_unicode_string();
+				w[i] = get_unicode_string(p_f);
 			}
 
 			r_v = array;
 
 		} break;
 		case VARIANT_PACKED_VECTOR2_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<Vector2> array;
 			array.resize(len);
 			Vector2 *w = array.ptrw();
 			static_assert(sizeof(Vector2) == 2 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 2);
+			const Error err = read_reals(reinterpret_cast<real_t *>(w), p_f, len * 2);
 			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
 
 		} break;
 		case VARIANT_PACKED_VECTOR3_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<Vector3> array;
 			array.resize(len);
 			Vector3 *w = array.ptrw();
 			static_assert(sizeof(Vector3) == 3 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 3);
+			const Error err = read_reals(reinterpret_cast<real_t *>(w), p_f, len * 3);
 			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
 
 		} break;
 		case VARIANT_PACKED_COLOR_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<Color> array;
 			array.resize(len);
 			Color *w = array.ptrw();
 			// Colors always use `float` even with double-precision support enabled
 			static_assert(sizeof(Color) == 4 * sizeof(float));
-			f->get_buffer((uint8_t *)w, len * sizeof(float) * 4);
+			p_f->get_buffer((uint8_t *)w, len * sizeof(float) * 4);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -694,172 +707,321 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
+	if (use_sub_threads && internal_resources.size() > 1) {
+		return _load_internal_resources_threaded();
+	}
+
 	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
+		Ref<Resource> res;
+		MissingResource *missing_resource = nullptr;
+
+		error = _instantiate_internal_resource(i, res, missing_resource);
+		if (error) {
+			return error;
+		}
+		if (res.is_null()) {
+			continue; // Already loaded.
+		}
 
-		//maybe it is loaded already
-		String path;
-		String id;
+		int pc = f->get_32();
 
-		if (!main) {
-			path = internal_resources[i].path;
+		//set properties
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+		Dictionary missing_resource_properties;
 
-				internal_resources.write[i].path = path; // Update path.
-			}
+		for (int j = 0; j < pc; j++) {
+			StringName name = _get_string(f);
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
-				}
+			if (name == StringName()) {
+				error = ERR_FILE_CORRUPT;
+				ERR_FAIL_V(ERR_FILE_CORRUPT);
 			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
+
+			Variant value;
+
+			error = parse_variant(f, value);
+			if (error) {
+				return error;
 			}
+
+			_set_internal_resource_property(res, missing_resource, name, value, missing_resource_properties);
 		}
 
-		uint64_t offset = internal_resources[i].offset;
+		if (_finish_internal_resource(i, res, missing_resource, missing_resource_properties)) {
+			return OK;
+		}
+	}
 
-		f->seek(offset);
+	return ERR_FILE_EOF;
+}
 
-		String t = get_unicode_string();
+Error ResourceLoaderBinary::_instantiate_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource) {
+	bool main = p_index == (internal_resources.size() - 1);
 
-		Ref<Resource> res;
+	//maybe it is loaded already
+	String path;
+	String id;
 
-		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-			//use the existing one
+	if (!main) {
+		path = internal_resources[p_index].path;
+
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
+
+			internal_resources.write[p_index].path = path; // Update path.
+		}
+
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
 			Ref<Resource> cached = ResourceCache::get_ref(path);
-			if (cached->get_class() == t) {
-				cached->reset_state();
-				res = cached;
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				internal_index_cache[path] = cached;
+				return OK;
 			}
 		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
+	}
 
-		MissingResource *missing_resource = nullptr;
+	uint64_t offset = internal_resources[p_index].offset;
 
-		if (res.is_null()) {
-			//did not replace
-
-			Object *obj = ClassDB::instantiate(t);
-			if (!obj) {
-				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-					//create a missing resource
-					missing_resource = memnew(MissingResource);
-					missing_resource->set_original_class(t);
-					missing_resource->set_recording_properties(true);
-					obj = missing_resource;
-				} else {
-					error = ERR_FILE_CORRUPT;
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
-				}
-			}
+	f->seek(offset);
 
-			Resource *r = Object::cast_to<Resource>(obj);
-			if (!r) {
-				String obj_class = obj->get_class();
-				error = ERR_FILE_CORRUPT;
-				memdelete(obj); //bye
-				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
-			}
+	String t = get_unicode_string();
 
-			res = Ref<Resource>(r);
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
-				} else {
-					r->set_path_cache(path);
-				}
+	Ref<Resource> res;
+
+	if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+		//use the existing one
+		Ref<Resource> cached = ResourceCache::get_ref(path);
+		if (cached->get_class() == t) {
+			cached->reset_state();
+			res = cached;
+		}
+	}
+
+	MissingResource *missing_resource = nullptr;
+
+	if (res.is_null()) {
+		//did not replace
+
+		Object *obj = ClassDB::instantiate(t);
+		if (!obj) {
+			if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+				//create a missing resource
+				missing_resource = memnew(MissingResource);
+				missing_resource->set_original_class(t);
+				missing_resource->set_recording_properties(true);
+				obj = missing_resource;
+			} else {
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
 			}
-			r->set_scene_unique_id(id);
 		}
 
-		if (!main) {
-			internal_index_cache[path] = res;
+		Resource *r = Object::cast_to<Resource>(obj);
+		if (!r) {
+			String obj_class = obj->get_class();
+			memdelete(obj); //bye
+			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
 		}
 
-		int pc = f->get_32();
+		res = Ref<Resource>(r);
+		if (!path.is_empty()) {
+			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+			} else {
+				r->set_path_cache(path);
+			}
+		}
+		r->set_scene_unique_id(id);
+	}
 
-		//set properties
+	if (!main) {
+		internal_index_cache[path] = res;
+	}
 
-		Dictionary missing_resource_properties;
+	r_res = res;
+	r_missing_resource = missing_resource;
+	return OK;
+}
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+void ResourceLoaderBinary::_set_internal_resource_property(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const StringName &p_name, Variant &p_value, Dictionary &r_missing_resource_properties) {
+	bool set_valid = true;
+	if (p_value.get_type() == Variant::OBJECT && p_missing_resource != nullptr) {
+		// If the property being set is a missing resource (and the parent is not),
+		// then setting it will most likely not work.
+		// Instead, save it as metadata.
+
+		Ref<MissingResource> mr = p_value;
+		if (mr.is_valid()) {
+			r_missing_resource_properties[p_name] = mr;
+			set_valid = false;
+		}
+	}
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
+	if (p_value.get_type() == Variant::ARRAY) {
+		Array set_array = p_value;
+		bool is_get_valid = false;
+		Variant get_value = p_res->get(p_name, &is_get_valid);
+		if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+			Array get_array = get_value;
+			if (!set_array.is_same_typed(get_array)) {
+				p_value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
 			}
+		}
+	}
 
-			Variant value;
+	if (set_valid) {
+		p_res->set(p_name, p_value);
+	}
+}
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
-			}
+bool ResourceLoaderBinary::_finish_internal_resource(int p_index, const Ref<Resource> &p_res, MissingResource *p_missing_resource, const Dictionary &p_missing_resource_properties) {
+	if (p_missing_resource) {
+		p_missing_resource->set_recording_properties(false);
+	}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+	if (!p_missing_resource_properties.is_empty()) {
+		p_res->set_meta(META_MISSING_RESOURCES, p_missing_resource_properties);
+	}
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
+#ifdef TOOLS_ENABLED
+	p_res->set_edited(false);
+#endif
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
-				}
-			}
+	if (progress) {
+		*progress = (p_index + 1) / float(internal_resources.size());
+	}
+
+	resource_cache.push_back(p_res);
+
+	if (p_index == internal_resources.size() - 1) {
+		f.unref();
+		resource = p_res;
+		resource->set_as_translation_remapped(translation_remapped);
+		error = OK;
+		return true;
+	}
+
+	return false;
+}
+
+void ResourceLoaderBinary::_decode_internal_resource(DecodeTask *p_task) {
+	Ref<FileAccessMemory> fa;
+	fa.instantiate();
+	fa->open_custom(decode_data, decode_data_length);
+	fa->set_big_endian(f->is_big_endian());
+	fa->real_is_double = f->real_is_double;
+
+	Ref<FileAccess> task_f = fa;
+	task_f->seek(p_task->properties_offset);
+
+	int pc = task_f->get_32();
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string(task_f);
+
+		if (name == StringName()) {
+			p_task->error = ERR_FILE_CORRUPT;
+			ERR_FAIL();
+		}
 
-			if (set_valid) {
-				res->set(name, value);
+		Variant value;
+
+		p_task->error = parse_variant(task_f, value);
+		if (p_task->error) {
+			return;
+		}
+
+		p_task->properties.push_back({ name, value });
+	}
+}
+
+Error ResourceLoaderBinary::_load_internal_resources_threaded() {
+	// Complete the external resources first, so decoding tasks never wait on other loads.
+	for (int i = 0; i < external_resources.size(); i++) {
+		Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[i].load_token;
+		if (load_token.is_null()) {
+			continue;
+		}
+
+		Error err;
+		Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
+		if (res.is_valid()) {
+			external_resources.write[i].resource = res;
+			continue;
+		}
+
+		if (!ResourceLoader::is_cleaning_tasks()) {
+			if (!ResourceLoader::get_abort_on_missing_resources()) {
+				ResourceLoader::notify_dependency_error(local_path, external_resources[i].path, external_resources[i].type);
+			} else {
+				error = ERR_FILE_MISSING_DEPENDENCIES;
+				ERR_FAIL_V_MSG(error, "Can't load dependency: " + external_resources[i].path + ".");
 			}
 		}
+		load_token.unref(); // Leave references to it empty, like a broken dependency.
+	}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+	// Create all resources on this thread, so references between them can be resolved while decoding.
+	LocalVector<DecodeTask> decode_tasks;
+	decode_tasks.resize(internal_resources.size());
+	for (int i = 0; i < internal_resources.size(); i++) {
+		error = _instantiate_internal_resource(i, decode_tasks[i].resource, decode_tasks[i].missing_resource);
+		if (error) {
+			return error;
 		}
+		decode_tasks[i].properties_offset = f->get_position();
+	}
+
+	// Tasks read from memory, either the file mapping or a copy of the file.
+	Vector<uint8_t> file_data;
+	decode_data_length = f->get_length();
+	f->seek(0);
+	decode_data = f->get_buffer_mapped(decode_data_length);
+	if (!decode_data) {
+		file_data.resize(decode_data_length);
+		if (f->get_buffer(file_data.ptrw(), decode_data_length) != decode_data_length) {
+			error = ERR_FILE_CORRUPT;
+			ERR_FAIL_V_MSG(error, "Can't read binary resource file: " + local_path + ".");
+		}
+		decode_data = file_data.ptr();
+	}
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	LocalVector<WorkerThreadPool::TaskID> task_ids;
+	for (DecodeTask &task : decode_tasks) {
+		if (task.resource.is_valid()) {
+			task_ids.push_back(WorkerThreadPool::get_singleton()->add_template_task(this, &ResourceLoaderBinary::_decode_internal_resource, &task, true, "Decode Binary Sub-Resource"));
 		}
+	}
+	for (WorkerThreadPool::TaskID task_id : task_ids) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	}
 
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
+	decode_data = nullptr;
+	decode_data_length = 0;
 
-		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
+	// Properties are set in file order on this thread, as in a regular load.
+	for (uint32_t i = 0; i < decode_tasks.size(); i++) {
+		DecodeTask &task = decode_tasks[i];
+		if (task.resource.is_null()) {
+			continue; // Already loaded.
+		}
+		if (task.error) {
+			error = task.error;
+			return error;
 		}
 
-		resource_cache.push_back(res);
+		Dictionary missing_resource_properties;
+		for (DecodedProperty &property : task.properties) {
+			_set_internal_resource_property(task.resource, task.missing_resource, property.name, property.value, missing_resource_properties);
+		}
+		task.properties.reset();
 
-		if (main) {
-			f.unref();
-			resource = res;
-			resource->set_as_translation_remapped(translation_remapped);
-			error = OK;
+		if (_finish_internal_resource(i, task.resource, task.missing_resource, missing_resource_properties)) {
 			return OK;
 		}
 	}
@@ -887,17 +1049,24 @@ static String get_ustring(Ref<FileAccess> f) {
 	return s;
 }
 
-String ResourceLoaderBinary::get_unicode_string() {
-	int len = f->get_32();
-	if (len > str_buf.size()) {
-		str_buf.resize(len);
-	}
-	if (len == 0) {
+String ResourceLoaderBinary::get_unicode_string(Ref<FileAccess> &p_f) {
+	int len = p_f->get_32();
+	if (len <= 0) {
 		return String();
 	}
-	f->get_buffer((uint8_t *)&str_buf[0], len);
 	String s;
-	s.parse_utf8(&str_buf[0]);
+	const char *mapped = (const char *)p_f->get_buffer_mapped(len);
+	if (mapped) {
+		s.parse_utf8(mapped, len);
+		return s;
+	}
+	Vector<char> task_buf;
+	Vector<char> &buf = p_f == f ? str_buf : task_buf;
+	if (len > buf.size()) {
+		buf.resize(len);
+	}
+	p_f->get_buffer((uint8_t *)&buf.write[0], len);
+	s.parse_utf8(&buf[0]);
 	return s;
 }
 
@@ -34,6 +34,9 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
+
+class MissingResource;
 
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
@@ -54,13 +57,14 @@ class ResourceLoaderBinary {
 
 	Vector<StringName> string_map;
 
-	StringName _get_string();
+	StringName _get_string(Ref<FileAccess> &p_f);
 
 	struct ExtResource {
 		String path;
 		String type;
 		ResourceUID::ID uid = ResourceUID::INVALID_ID;
 		Ref<ResourceLoader::LoadToken> load_token;
+		Ref<Resource> resource; // Completed ahead of time when decoding in parallel.
 	};
 
 	bool using_named_scene_ids = false;
@@ -78,8 +82,27 @@ class ResourceLoaderBinary {
 	Vector<IntResource> internal_resources;
 	HashMap<String, Ref<Resource>> internal_index_cache;
 
-	String get_unicode_string();
-	void _advance_padding(uint32_t p_len);
+	// When loading with sub-threads, the properties of internal resources are decoded in parallel,
+	// then set on the loading thread.
+	struct DecodedProperty {
+		StringName name;
+		Variant value;
+	};
+
+	struct DecodeTask {
+		Ref<Resource> resource;
+		MissingResource *missing_resource = nullptr;
+		uint64_t properties_offset = 0;
+		LocalVector<DecodedProperty> properties;
+		Error error = OK;
+	};
+
+	const uint8_t *decode_data = nullptr;
+	uint64_t decode_data_length = 0;
+
+	String get_unicode_string(Ref<FileAccess> &p_f);
+	String get_unicode_string() { return get_unicode_string(f); }
+	void _advance_padding(Ref<FileAccess> &p_f, uint32_t p_len);
 
 	HashMap<String, String> remaps;
 	Error error = OK;
@@ -89,7 +112,13 @@ class ResourceLoaderBinary {
 
 	friend class ResourceFormatLoaderBinary;
 
-	Error parse_variant(Variant &r_v);
+	Error parse_variant(Ref<FileAccess> &p_f, Variant &r_v);
+
+	Error _instantiate_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource);
+	void _set_internal_resource_property(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const StringName &p_name, Variant &p_value, Dictionary &r_missing_resource_properties);
+	bool _finish_internal_resource(int p_index, const Ref<Resource> &p_res, MissingResource *p_missing_resource, const Dictionary &p_missing_resource_properties);
+	void _decode_internal_resource(DecodeTask *p_task);
+	Error _load_internal_resources_threaded();
 
 	HashMap<String, Ref<Resource>> dependency_cache;
 
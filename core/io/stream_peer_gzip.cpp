@@ -30,7 +30,6 @@
 
 #include "core/io/stream_peer_gzip.h"
 
-#include "core/io/zip_io.h"
 #include <zlib.h>
 
 void StreamPeerGZIP::_bind_methods() {
@@ -48,16 +47,7 @@ StreamPeerGZIP::~StreamPeerGZIP() {
 }
 
 void StreamPeerGZIP::_close() {
-	if (ctx) {
-		z_stream *strm = (z_stream *)ctx;
-		if (compressing) {
-			deflateEnd(strm);
-		} else {
-			inflateEnd(strm);
-		}
-		memfree(strm);
-		ctx = nullptr;
-	}
+	stream.clear();
 }
 
 void StreamPeerGZIP::clear() {
@@ -75,50 +65,22 @@ Error StreamPeerGZIP::start_decompression(bool p_is_deflate, int buffer_size) {
 }
 
 Error StreamPeerGZIP::_start(bool p_compress, bool p_is_deflate, int buffer_size) {
-	ERR_FAIL_COND_V(ctx != nullptr, ERR_ALREADY_IN_USE);
+	ERR_FAIL_COND_V(stream.is_started(), ERR_ALREADY_IN_USE);
 	ERR_FAIL_COND_V_MSG(buffer_size <= 0, ERR_INVALID_PARAMETER, "Invalid buffer size. It should be a positive integer.");
 	clear();
-	compressing = p_compress;
 	rb.resize(nearest_shift(buffer_size - 1));
 	buffer.resize(1024);
 
-	// Create ctx.
-	ctx = memalloc(sizeof(z_stream));
-	z_stream &strm = *(z_stream *)ctx;
-	strm.next_in = Z_NULL;
-	strm.avail_in = 0;
-	strm.zalloc = zipio_alloc;
-	strm.zfree = zipio_free;
-	strm.opaque = Z_NULL;
-	int window_bits = p_is_deflate ? 15 : (15 + 16);
-	int err = Z_OK;
-	int level = Z_DEFAULT_COMPRESSION;
-	if (compressing) {
-		err = deflateInit2(&strm, level, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY);
-	} else {
-		err = inflateInit2(&strm, window_bits);
-	}
-	ERR_FAIL_COND_V(err != Z_OK, FAILED);
+	Compression::Mode mode = p_is_deflate ? Compression::MODE_DEFLATE : Compression::MODE_GZIP;
+	Error err = p_compress ? stream.start_compression(mode, Z_DEFAULT_COMPRESSION) : stream.start_decompression(mode);
+	ERR_FAIL_COND_V(err != OK, FAILED);
 	return OK;
 }
 
 Error StreamPeerGZIP::_process(uint8_t *p_dst, int p_dst_size, const uint8_t *p_src, int p_src_size, int &r_consumed, int &r_out, bool p_close) {
-	ERR_FAIL_NULL_V(ctx, ERR_UNCONFIGURED);
-	z_stream &strm = *(z_stream *)ctx;
-	strm.avail_in = p_src_size;
-	strm.avail_out = p_dst_size;
-	strm.next_in = (Bytef *)p_src;
-	strm.next_out = (Bytef *)p_dst;
-	int flush = p_close ? Z_FINISH : Z_NO_FLUSH;
-	if (compressing) {
-		int err = deflate(&strm, flush);
-		ERR_FAIL_COND_V(err != (p_close ? Z_STREAM_END : Z_OK), FAILED);
-	} else {
-		int err = inflate(&strm, flush);
-		ERR_FAIL_COND_V(err != Z_OK && err != Z_STREAM_END, FAILED);
-	}
-	r_out = p_dst_size - strm.avail_out;
-	r_consumed = p_src_size - strm.avail_in;
+	ERR_FAIL_COND_V(!stream.is_started(), ERR_UNCONFIGURED);
+	Error err = stream.process(p_dst, p_dst_size, p_src, p_src_size, r_consumed, r_out, p_close);
+	ERR_FAIL_COND_V(err != OK, FAILED);
 	return OK;
 }
 
@@ -133,7 +95,7 @@ Error StreamPeerGZIP::put_data(const uint8_t *p_data, int p_bytes) {
 }
 
 Error StreamPeerGZIP::put_partial_data(const uint8_t *p_data, int p_bytes, int &r_sent) {
-	ERR_FAIL_NULL_V(ctx, ERR_UNCONFIGURED);
+	ERR_FAIL_COND_V(!stream.is_started(), ERR_UNCONFIGURED);
 	ERR_FAIL_COND_V(p_bytes < 0, ERR_INVALID_PARAMETER);
 
 	// Ensure we have enough space in temporary buffer.
@@ -193,18 +155,21 @@ int StreamPeerGZIP::get_available_bytes() const {
 }
 
 Error StreamPeerGZIP::finish() {
-	ERR_FAIL_COND_V(!ctx || !compressing, ERR_UNAVAILABLE);
+	ERR_FAIL_COND_V(!stream.is_started() || !stream.is_compressing(), ERR_UNAVAILABLE);
 	// Ensure we have enough space in temporary buffer.
 	if (buffer.size() < 1024) {
-		buffer.resize(1024); // 1024 should be more than enough.
+		buffer.resize(1024); // 1024 is usually enough to flush everything in one go.
 	}
-	int consumed = 0;
-	int to_write = 0;
-	Error err = _process(buffer.ptrw(), 1024, nullptr, 0, consumed, to_write, true); // compress
-	if (err != OK) {
-		return err;
+	while (!stream.is_finished()) {
+		int consumed = 0;
+		int to_write = 0;
+		Error err = _process(buffer.ptrw(), 1024, nullptr, 0, consumed, to_write, true); // compress
+		if (err != OK) {
+			return err;
+		}
+		ERR_FAIL_COND_V(to_write == 0 && !stream.is_finished(), FAILED);
+		int wrote = rb.write(buffer.ptr(), to_write);
+		ERR_FAIL_COND_V(wrote != to_write, ERR_OUT_OF_MEMORY);
 	}
-	int wrote = rb.write(buffer.ptr(), to_write);
-	ERR_FAIL_COND_V(wrote != to_write, ERR_OUT_OF_MEMORY);
 	return OK;
 }
@@ -41,8 +41,7 @@ class StreamPeerGZIP : public StreamPeer {
 	GDCLASS(StreamPeerGZIP, StreamPeer);
 
 private:
-	void *ctx = nullptr; // Will hold our z_stream instance.
-	bool compressing = true;
+	CompressionStream stream;
 
 	RingBuffer<uint8_t> rb;
 	Vector<uint8_t> buffer;
@@ -48,9 +48,13 @@ WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 
 thread_local CommandQueueMT *WorkerThreadPool::flushing_cmd_queue = nullptr;
 
+thread_local int WorkerThreadPool::current_thread_index = -1;
+
 void WorkerThreadPool::_process_task(Task *p_task) {
 #ifdef THREADS_ENABLED
-	int pool_thread_index = thread_ids[Thread::get_caller_id()];
+	// Read now, the task may be freed before the end of this function.
+	const bool low_priority = p_task->low_priority;
+	int pool_thread_index = current_thread_index;
 	ThreadData &curr_thread = threads[pool_thread_index];
 	Task *prev_task = nullptr; // In case this is recursively called.
 	bool safe_for_nodes_backup = is_current_thread_safe_for_nodes();
@@ -62,11 +66,11 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		// its pre-created threads can't have ScriptServer::thread_enter() called on them early.
 		// Therefore, we do it late at the first opportunity, so in case the task
 		// about to be run uses scripting, guarantees are held.
-		task_mutex.lock();
+		_lock_task_mutex();
 		if (!curr_thread.ready_for_scripting && ScriptServer::are_languages_initialized()) {
 			task_mutex.unlock();
 			ScriptServer::thread_enter();
-			task_mutex.lock();
+			_lock_task_mutex();
 			curr_thread.ready_for_scripting = true;
 		}
 		p_task->pool_thread_index = pool_thread_index;
@@ -116,16 +120,15 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
 
+		// Freeing happens in the same critical section as the bookkeeping below.
+		_lock_task_mutex();
+
 		if (finished_users == max_users) {
 			// Get rid of the group, because nobody else is using it.
-			task_mutex.lock();
 			group_allocator.free(p_task->group);
-			task_mutex.unlock();
 		}
 
 		// For groups, tasks get rid of themselves.
-
-		task_mutex.lock();
 		task_allocator.free(p_task);
 	} else {
 		if (p_task->native_func) {
@@ -137,7 +140,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			p_task->callable.call();
 		}
 
-		task_mutex.lock();
+		_lock_task_mutex();
 		p_task->completed = true;
 		p_task->pool_thread_index = -1;
 		if (p_task->waiting_user) {
@@ -155,10 +158,10 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 #ifdef THREADS_ENABLED
 	{
 		curr_thread.current_task = prev_task;
-		if (p_task->low_priority) {
+		if (low_priority) {
 			low_priority_threads_used--;
 
-			if (_try_promote_low_priority_task()) {
+			if (_try_promote_low_priority_task(&curr_thread)) {
 				if (prev_task) { // Otherwise, this thread will catch it.
 					_notify_threads(&curr_thread, 1, 0);
 				}
@@ -174,19 +177,23 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
+	current_thread_index = thread_data->index;
+
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Fast path, only touching the thread queues.
+		Task *task_to_process = singleton->_pop_task(thread_data, false);
+
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 			if (singleton->exit_threads) {
 				return;
 			}
 			thread_data->signaled = false;
 
-			if (singleton->task_queue.first()) {
-				task_to_process = singleton->task_queue.first()->self();
-				singleton->task_queue.remove(singleton->task_queue.first());
-			} else {
+			// Check again while holding the task mutex, so a task posted meanwhile can't be missed:
+			// posting threads push to the queues and notify while holding it.
+			task_to_process = singleton->_pop_task(thread_data, true);
+			if (!task_to_process) {
 				thread_data->cond_var.wait(lock);
 				DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
 			}
@@ -198,6 +205,59 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	}
 }
 
+void WorkerThreadPool::_push_task(ThreadData *p_thread_data, Task *p_task) {
+	p_thread_data->queue_mutex.lock();
+	p_thread_data->queue.add_last(&p_task->task_elem);
+	p_thread_data->queue_size.increment();
+	p_thread_data->queue_mutex.unlock();
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_pop_task(ThreadData *p_thread_data, bool p_wait_for_queues) {
+	// Own queue first, then steal from the following threads' queues. Each queue is FIFO,
+	// but there is no order across queues, so tasks can run in any order relative to their submission.
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 0; i < thread_count; i++) {
+		ThreadData &th = threads[(p_thread_data->index + i) % thread_count];
+		if (th.queue_size.get() == 0) {
+			continue;
+		}
+
+		if (p_wait_for_queues) {
+			th.queue_mutex.lock();
+		} else if (!th.queue_mutex.try_lock()) {
+			// Busy, try elsewhere instead of waiting.
+			queue_contentions.increment();
+			continue;
+		}
+
+		Task *task = nullptr;
+		if (th.queue.first()) {
+			task = th.queue.first()->self();
+			th.queue.remove(th.queue.first());
+			th.queue_size.decrement();
+		}
+		th.queue_mutex.unlock();
+
+		if (task) {
+			if (i != 0) {
+				stolen_tasks.increment();
+			}
+			return task;
+		}
+	}
+
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_queued_tasks() const {
+	for (const ThreadData &th : threads) {
+		if (th.queue_size.get() > 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count, bool p_high_priority) {
 	// Fall back to processing on the calling thread if there are no worker threads.
 	// Separated into its own variable to make it easier to extend this logic
@@ -214,12 +274,18 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 	uint32_t to_process = 0;
 	uint32_t to_promote = 0;
 
-	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
+	ThreadData *caller_pool_thread = current_thread_index != -1 ? &threads[current_thread_index] : nullptr;
 
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			// Pool threads keep their tasks local, others spread them across the threads.
+			if (caller_pool_thread) {
+				_push_task(caller_pool_thread, p_tasks[i]);
+			} else {
+				_push_task(&threads[queue_index], p_tasks[i]);
+				queue_index = (queue_index + 1) % threads.size();
+			}
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -300,11 +366,11 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
-bool WorkerThreadPool::_try_promote_low_priority_task() {
+bool WorkerThreadPool::_try_promote_low_priority_task(ThreadData *p_thread_data) {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
 		low_priority_task_queue.remove(low_priority_task_queue.first());
-		task_queue.add_last(&low_prio_task->task_elem);
+		_push_task(p_thread_data, low_prio_task);
 		low_priority_threads_used++;
 		return true;
 	} else {
@@ -317,7 +383,7 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *
 }
 
 WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
-	task_mutex.lock();
+	_lock_task_mutex();
 	// Get a free task
 	Task *task = task_allocator.alloc();
 	TaskID id = last_task++;
@@ -339,7 +405,7 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bo
 }
 
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
-	task_mutex.lock();
+	_lock_task_mutex();
 	const Task *const *taskp = tasks.getptr(p_task_id);
 	if (!taskp) {
 		task_mutex.unlock();
@@ -353,7 +419,7 @@ bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 }
 
 Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
-	task_mutex.lock();
+	_lock_task_mutex();
 	Task **taskp = tasks.getptr(p_task_id);
 	if (!taskp) {
 		task_mutex.unlock();
@@ -370,7 +436,7 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 		return OK;
 	}
 
-	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
+	ThreadData *caller_pool_thread = current_thread_index != -1 ? &threads[current_thread_index] : nullptr;
 	if (caller_pool_thread && p_task_id <= caller_pool_thread->current_task->self) {
 		// Deadlock prevention:
 		// When a pool thread wants to wait for an older task, the following situations can happen:
@@ -404,7 +470,7 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 		}
 	} else {
 		task->done_semaphore.wait();
-		task_mutex.lock();
+		_lock_task_mutex();
 		task->waiting_user--;
 		if (task->waiting_pool == 0 && task->waiting_user == 0) {
 			tasks.erase(p_task_id);
@@ -433,7 +499,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (!exit_threads && was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = _has_queued_tasks() ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -447,15 +513,12 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 
 			if (!exit_threads) {
 				if (p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first()) {
-					if (_try_promote_low_priority_task()) {
+					if (_try_promote_low_priority_task(p_caller_pool_thread)) {
 						_notify_threads(p_caller_pool_thread, 1, 0);
 					}
 				}
 
-				if (singleton->task_queue.first()) {
-					task_to_process = task_queue.first()->self();
-					task_queue.remove(task_queue.first());
-				}
+				task_to_process = _pop_task(p_caller_pool_thread, true);
 
 				if (!task_to_process) {
 					p_caller_pool_thread->awaited_task = p_task;
@@ -487,7 +550,7 @@ void WorkerThreadPool::yield() {
 }
 
 void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
-	task_mutex.lock();
+	_lock_task_mutex();
 	Task **taskp = tasks.getptr(p_task_id);
 	if (!taskp) {
 		task_mutex.unlock();
@@ -517,7 +580,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 		p_tasks = MAX(1u, threads.size());
 	}
 
-	task_mutex.lock();
+	_lock_task_mutex();
 	Group *group = group_allocator.alloc();
 	GroupID id = last_task++;
 	group->max = p_elements;
@@ -566,7 +629,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 }
 
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
-	task_mutex.lock();
+	_lock_task_mutex();
 	const Group *const *groupp = groups.getptr(p_group);
 	if (!groupp) {
 		task_mutex.unlock();
@@ -577,7 +640,7 @@ uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) co
 	return elements;
 }
 bool WorkerThreadPool::is_group_task_completed(GroupID p_group) const {
-	task_mutex.lock();
+	_lock_task_mutex();
 	const Group *const *groupp = groups.getptr(p_group);
 	if (!groupp) {
 		task_mutex.unlock();
@@ -590,7 +653,7 @@ bool WorkerThreadPool::is_group_task_completed(GroupID p_group) const {
 
 void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 #ifdef THREADS_ENABLED
-	task_mutex.lock();
+	_lock_task_mutex();
 	Group **groupp = groups.getptr(p_group);
 	task_mutex.unlock();
 	if (!groupp) {
@@ -611,23 +674,33 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
 
+		_lock_task_mutex(); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
 		if (finished_users == max_users) {
 			// All tasks using this group are gone (finished before the group), so clear the group too.
-			task_mutex.lock();
 			group_allocator.free(group);
-			task_mutex.unlock();
 		}
+		groups.erase(p_group);
+		task_mutex.unlock();
 	}
-
-	task_mutex.lock(); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
-	groups.erase(p_group);
-	task_mutex.unlock();
 #endif
 }
 
 int WorkerThreadPool::get_thread_index() {
-	Thread::ID tid = Thread::get_caller_id();
-	return singleton->thread_ids.has(tid) ? singleton->thread_ids[tid] : -1;
+	return current_thread_index;
+}
+
+WorkerThreadPool::ContentionStats WorkerThreadPool::get_contention_stats() const {
+	ContentionStats stats;
+	stats.task_mutex_contentions = task_mutex_contentions.get();
+	stats.queue_contentions = queue_contentions.get();
+	stats.stolen_tasks = stolen_tasks.get();
+	return stats;
+}
+
+void WorkerThreadPool::reset_contention_stats() {
+	task_mutex_contentions.set(0);
+	queue_contentions.set(0);
+	stolen_tasks.set(0);
 }
 
 void WorkerThreadPool::thread_enter_command_queue_mt_flush(CommandQueueMT *p_queue) {
@@ -653,7 +726,6 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 	for (uint32_t i = 0; i < threads.size(); i++) {
 		threads[i].index = i;
 		threads[i].thread.start(&WorkerThreadPool::_thread_function, &threads[i]);
-		thread_ids.insert(threads[i].thread.get_id(), i);
 	}
 }
 
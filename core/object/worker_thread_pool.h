@@ -105,7 +105,6 @@ private:
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
 
 	SelfList<Task>::List low_priority_task_queue;
-	SelfList<Task>::List task_queue;
 
 	BinaryMutex task_mutex;
 
@@ -121,6 +120,12 @@ private:
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 
+		// Tasks ready to run. The owner thread processes them first, but idle threads steal from here too.
+		// Only guarded by its own mutex, so taking tasks doesn't need the task mutex.
+		BinaryMutex queue_mutex;
+		SelfList<Task>::List queue;
+		SafeNumeric<uint32_t> queue_size;
+
 		ThreadData() :
 				ready_for_scripting(false),
 				signaled(false),
@@ -130,7 +135,7 @@ private:
 	TightLocalVector<ThreadData> threads;
 	bool exit_threads = false;
 
-	HashMap<Thread::ID, int> thread_ids;
+	static thread_local int current_thread_index;
 	HashMap<
 			TaskID,
 			Task *,
@@ -149,9 +154,21 @@ private:
 	uint32_t max_low_priority_threads = 0;
 	uint32_t low_priority_threads_used = 0;
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
+	uint32_t queue_index = 0; // For rotating the queues tasks from non-pool threads are posted to.
 
 	uint64_t last_task = 1;
 
+	mutable SafeNumeric<uint64_t> task_mutex_contentions;
+	mutable SafeNumeric<uint64_t> queue_contentions;
+	mutable SafeNumeric<uint64_t> stolen_tasks;
+
+	_FORCE_INLINE_ void _lock_task_mutex() const {
+		if (unlikely(!task_mutex.try_lock())) {
+			task_mutex_contentions.increment();
+			task_mutex.lock();
+		}
+	}
+
 	static void _thread_function(void *p_user);
 
 	void _process_task(Task *task);
@@ -159,7 +176,11 @@ private:
 	void _post_tasks_and_unlock(Task **p_tasks, uint32_t p_count, bool p_high_priority);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
-	bool _try_promote_low_priority_task();
+	void _push_task(ThreadData *p_thread_data, Task *p_task);
+	Task *_pop_task(ThreadData *p_thread_data, bool p_wait_for_queues);
+	bool _has_queued_tasks() const;
+
+	bool _try_promote_low_priority_task(ThreadData *p_thread_data);
 
 	static WorkerThreadPool *singleton;
 
@@ -229,6 +250,15 @@ public:
 
 	_FORCE_INLINE_ int get_thread_count() const { return threads.size(); }
 
+	struct ContentionStats {
+		uint64_t task_mutex_contentions = 0; // Times the task mutex was already taken when trying to lock it.
+		uint64_t queue_contentions = 0; // Times a thread queue was skipped because another thread was using it.
+		uint64_t stolen_tasks = 0; // Tasks processed by a thread other than the one they were queued to.
+	};
+
+	ContentionStats get_contention_stats() const;
+	void reset_contention_stats();
+
 	static WorkerThreadPool *get_singleton() { return singleton; }
 	static int get_thread_index();
 
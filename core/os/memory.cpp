@@ -31,10 +31,13 @@
 #include "memory.h"
 
 #include "core/error/error_macros.h"
+#include "core/os/spin_lock.h"
 #include "core/templates/safe_refcount.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <atomic>
 
 void *operator new(size_t p_size, const char *p_description) {
 	return Memory::alloc_static(p_size, false);
@@ -59,25 +62,272 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 #endif
 
 #ifdef DEBUG_ENABLED
-SafeNumeric<uint64_t> Memory::mem_usage;
-SafeNumeric<uint64_t> Memory::max_usage;
+// Memory usage is counted per thread, and only summed up when queried, so threads don't
+// contend on a shared counter on every allocation. Threads register their counter on first
+// use, and hand their balance over to retired_usage when they exit.
+
+struct MemoryThreadUsage {
+	std::atomic<int64_t> usage = { 0 }; // Only written by the owner thread.
+	int64_t last_peak_check = 0;
+	uint8_t state = 0; // 0: unregistered, 1: registered, 2: thread exiting.
+	MemoryThreadUsage *next = nullptr;
+};
+
+static thread_local MemoryThreadUsage thread_usage;
+static MemoryThreadUsage *thread_usage_list = nullptr;
+static SpinLock thread_usage_lock;
+static std::atomic<int64_t> retired_usage = { 0 };
+
+// Thread usage is checked against the peak every time it grows by this amount.
+static constexpr int64_t PEAK_CHECK_INTERVAL = 1024 * 1024;
+
+static SafeNumeric<uint64_t> max_usage;
+
+struct MemoryThreadUsageRetirer {
+	~MemoryThreadUsageRetirer() {
+		thread_usage_lock.lock();
+		MemoryThreadUsage **link = &thread_usage_list;
+		while (*link && *link != &thread_usage) {
+			link = &(*link)->next;
+		}
+		if (*link) {
+			*link = thread_usage.next;
+		}
+		retired_usage.fetch_add(thread_usage.usage.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		thread_usage.usage.store(0, std::memory_order_relaxed);
+		thread_usage.state = 2;
+		thread_usage_lock.unlock();
+	}
+};
+
+static int64_t _sum_thread_usage() {
+	thread_usage_lock.lock();
+	int64_t total = retired_usage.load(std::memory_order_relaxed);
+	for (MemoryThreadUsage *E = thread_usage_list; E; E = E->next) {
+		total += E->usage.load(std::memory_order_relaxed);
+	}
+	thread_usage_lock.unlock();
+	return total;
+}
+
+static void _update_peak_usage() {
+	int64_t total = _sum_thread_usage();
+	if (total > 0) {
+		max_usage.exchange_if_greater(total);
+	}
+}
+
+static void _add_thread_usage(int64_t p_bytes) {
+	MemoryThreadUsage &tu = thread_usage;
+	if (unlikely(tu.state != 1)) {
+		if (tu.state == 2) {
+			retired_usage.fetch_add(p_bytes, std::memory_order_relaxed);
+			return;
+		}
+		static thread_local MemoryThreadUsageRetirer retirer;
+		(void)retirer;
+		thread_usage_lock.lock();
+		tu.next = thread_usage_list;
+		thread_usage_list = &tu;
+		tu.state = 1;
+		thread_usage_lock.unlock();
+	}
+
+	int64_t usage = tu.usage.load(std::memory_order_relaxed) + p_bytes;
+	tu.usage.store(usage, std::memory_order_relaxed);
+
+	if (p_bytes > 0 && usage - tu.last_peak_check >= PEAK_CHECK_INTERVAL) {
+		tu.last_peak_check = usage;
+		_update_peak_usage();
+	} else if (usage < tu.last_peak_check) {
+		tu.last_peak_check = usage;
+	}
+}
 #endif
 
-SafeNumeric<uint64_t> Memory::alloc_count;
+#ifdef SMALL_ALLOCATOR_ENABLED
+// Small blocks are served from per-thread caches of free blocks, one list per size class.
+// Caches exchange blocks in batches with a central free list when they run empty or grow
+// too large, so a block can be freed from any thread. Blocks are carved from chunks that are
+// kept for the lifetime of the process.
+
+static constexpr size_t SMALL_ALLOC_GRANULARITY = alignof(max_align_t) > 16 ? alignof(max_align_t) : 16;
+static constexpr size_t SMALL_ALLOC_MAX = 512;
+static constexpr uint32_t SMALL_ALLOC_CLASSES = SMALL_ALLOC_MAX / SMALL_ALLOC_GRANULARITY;
+static constexpr size_t SMALL_ALLOC_CHUNK_SIZE = 64 * 1024;
+static constexpr uint32_t SMALL_ALLOC_BATCH = 32;
+static constexpr uint32_t SMALL_ALLOC_CACHE_MAX = 4 * SMALL_ALLOC_BATCH;
+
+struct SmallAllocBlock {
+	SmallAllocBlock *next;
+};
+
+struct SmallAllocCentralList {
+	SpinLock lock;
+	SmallAllocBlock *first = nullptr;
+};
+
+struct SmallAllocThreadCache {
+	SmallAllocBlock *first[SMALL_ALLOC_CLASSES] = {};
+	uint32_t count[SMALL_ALLOC_CLASSES] = {};
+	uint8_t state = 0; // 0: unused, 1: in use, 2: thread exiting.
+};
+
+static SmallAllocCentralList small_alloc_central[SMALL_ALLOC_CLASSES];
+static thread_local SmallAllocThreadCache small_alloc_cache;
+
+_FORCE_INLINE_ static uint32_t _small_alloc_class(size_t p_bytes) {
+	return p_bytes == 0 ? 0 : (p_bytes - 1) / SMALL_ALLOC_GRANULARITY;
+}
+
+_FORCE_INLINE_ static size_t _small_alloc_block_size(uint32_t p_class) {
+	return Memory::DATA_OFFSET + (p_class + 1) * SMALL_ALLOC_GRANULARITY;
+}
+
+static void _small_alloc_push_central(uint32_t p_class, SmallAllocBlock *p_first, SmallAllocBlock *p_last) {
+	SmallAllocCentralList &central = small_alloc_central[p_class];
+	central.lock.lock();
+	p_last->next = central.first;
+	central.first = p_first;
+	central.lock.unlock();
+}
+
+// Takes up to p_max blocks from the central list, or carves a new chunk if it's empty.
+static SmallAllocBlock *_small_alloc_pop_central(uint32_t p_class, uint32_t p_max, uint32_t &r_count) {
+	SmallAllocCentralList &central = small_alloc_central[p_class];
+	central.lock.lock();
+	SmallAllocBlock *first = central.first;
+	SmallAllocBlock *last = first;
+	r_count = first ? 1 : 0;
+	while (last && last->next && r_count < p_max) {
+		last = last->next;
+		r_count++;
+	}
+	if (first) {
+		central.first = last->next;
+		last->next = nullptr;
+	}
+	central.lock.unlock();
+
+	if (first) {
+		return first;
+	}
+
+	uint8_t *chunk = (uint8_t *)malloc(SMALL_ALLOC_CHUNK_SIZE);
+	ERR_FAIL_NULL_V(chunk, nullptr);
+
+	const size_t block_size = _small_alloc_block_size(p_class);
+	const uint32_t block_count = SMALL_ALLOC_CHUNK_SIZE / block_size;
+	for (uint32_t i = 0; i < block_count; i++) {
+		((SmallAllocBlock *)(chunk + i * block_size))->next = i + 1 < block_count ? (SmallAllocBlock *)(chunk + (i + 1) * block_size) : nullptr;
+	}
+
+	if (block_count > p_max) {
+		// Keep the rest in the central list.
+		_small_alloc_push_central(p_class, (SmallAllocBlock *)(chunk + p_max * block_size), (SmallAllocBlock *)(chunk + (block_count - 1) * block_size));
+		((SmallAllocBlock *)(chunk + (p_max - 1) * block_size))->next = nullptr;
+		r_count = p_max;
+	} else {
+		r_count = block_count;
+	}
+
+	return (SmallAllocBlock *)chunk;
+}
+
+static void _small_alloc_flush_cache() {
+	SmallAllocThreadCache &cache = small_alloc_cache;
+	for (uint32_t i = 0; i < SMALL_ALLOC_CLASSES; i++) {
+		if (cache.first[i]) {
+			SmallAllocBlock *last = cache.first[i];
+			while (last->next) {
+				last = last->next;
+			}
+			_small_alloc_push_central(i, cache.first[i], last);
+			cache.first[i] = nullptr;
+			cache.count[i] = 0;
+		}
+	}
+	cache.state = 2;
+}
+
+struct SmallAllocCacheFlusher {
+	~SmallAllocCacheFlusher() {
+		_small_alloc_flush_cache();
+	}
+};
+
+static void *_small_alloc(size_t p_bytes) {
+	const uint32_t size_class = _small_alloc_class(p_bytes);
+	SmallAllocThreadCache &cache = small_alloc_cache;
+
+	if (unlikely(cache.state != 1)) {
+		if (cache.state == 2) {
+			// The thread is exiting, don't cache anymore.
+			uint32_t count = 0;
+			return _small_alloc_pop_central(size_class, 1, count);
+		}
+		static thread_local SmallAllocCacheFlusher flusher;
+		(void)flusher;
+		cache.state = 1;
+	}
+
+	SmallAllocBlock *block = cache.first[size_class];
+	if (unlikely(!block)) {
+		uint32_t count = 0;
+		block = _small_alloc_pop_central(size_class, SMALL_ALLOC_BATCH, count);
+		ERR_FAIL_NULL_V(block, nullptr);
+		cache.count[size_class] = count;
+	}
+
+	cache.first[size_class] = block->next;
+	cache.count[size_class]--;
+	return block;
+}
+
+static void _small_free(void *p_block, size_t p_bytes) {
+	const uint32_t size_class = _small_alloc_class(p_bytes);
+	SmallAllocThreadCache &cache = small_alloc_cache;
+	SmallAllocBlock *block = (SmallAllocBlock *)p_block;
+
+	if (unlikely(cache.state != 1)) {
+		// Either the thread never allocated, or it's exiting. Give it back directly.
+		_small_alloc_push_central(size_class, block, block);
+		return;
+	}
+
+	block->next = cache.first[size_class];
+	cache.first[size_class] = block;
+	cache.count[size_class]++;
+
+	if (unlikely(cache.count[size_class] > SMALL_ALLOC_CACHE_MAX)) {
+		// Give a batch back so other threads can use it.
+		SmallAllocBlock *last = block;
+		for (uint32_t i = 1; i < SMALL_ALLOC_BATCH; i++) {
+			last = last->next;
+		}
+		cache.first[size_class] = last->next;
+		cache.count[size_class] -= SMALL_ALLOC_BATCH;
+		_small_alloc_push_central(size_class, block, last);
+	}
+}
+#endif
 
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SMALL_ALLOCATOR_ENABLED)
+	// The small allocator needs the size to know where blocks come from.
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
+#ifdef SMALL_ALLOCATOR_ENABLED
+	void *mem = p_bytes <= SMALL_ALLOC_MAX ? _small_alloc(p_bytes) : malloc(p_bytes + DATA_OFFSET);
+#else
 	void *mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+#endif
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 
-	alloc_count.increment();
-
 	if (prepad) {
 		uint8_t *s8 = (uint8_t *)mem;
 
@@ -85,8 +335,7 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 		*s = p_bytes;
 
 #ifdef DEBUG_ENABLED
-		uint64_t new_mem_usage = mem_usage.add(p_bytes);
-		max_usage.exchange_if_greater(new_mem_usage);
+		_add_thread_usage(p_bytes);
 #endif
 		return s8 + DATA_OFFSET;
 	} else {
@@ -101,7 +350,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SMALL_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -111,16 +360,37 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		mem -= DATA_OFFSET;
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
 
+#ifdef SMALL_ALLOCATOR_ENABLED
+		if (p_bytes > 0 && (*s <= SMALL_ALLOC_MAX || p_bytes <= SMALL_ALLOC_MAX)) {
+			if (*s <= SMALL_ALLOC_MAX && p_bytes <= SMALL_ALLOC_MAX && _small_alloc_class(*s) == _small_alloc_class(p_bytes)) {
+				// Still fits in the same block.
 #ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = mem_usage.add(p_bytes - *s);
-			max_usage.exchange_if_greater(new_mem_usage);
-		} else {
-			mem_usage.sub(*s - p_bytes);
+				_add_thread_usage((int64_t)p_bytes - (int64_t)*s);
+#endif
+				*s = p_bytes;
+				return p_memory;
+			}
+
+			// Moving between the small allocator and malloc, or between size classes.
+			void *new_mem = alloc_static(p_bytes, p_pad_align);
+			ERR_FAIL_NULL_V(new_mem, nullptr);
+			memcpy(new_mem, p_memory, MIN(*s, (uint64_t)p_bytes));
+			free_static(p_memory, p_pad_align);
+			return new_mem;
 		}
 #endif
 
+#ifdef DEBUG_ENABLED
+		_add_thread_usage((int64_t)p_bytes - (int64_t)*s);
+#endif
+
 		if (p_bytes == 0) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+			if (*s <= SMALL_ALLOC_MAX) {
+				_small_free(mem, *s);
+				return nullptr;
+			}
+#endif
 			free(mem);
 			return nullptr;
 		} else {
@@ -149,20 +419,28 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SMALL_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
-	alloc_count.decrement();
-
 	if (prepad) {
 		mem -= DATA_OFFSET;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SMALL_ALLOCATOR_ENABLED)
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
-		mem_usage.sub(*s);
+#endif
+
+#ifdef DEBUG_ENABLED
+		_add_thread_usage(-(int64_t)*s);
+#endif
+
+#ifdef SMALL_ALLOCATOR_ENABLED
+		if (*s <= SMALL_ALLOC_MAX) {
+			_small_free(mem, *s);
+			return;
+		}
 #endif
 
 		free(mem);
@@ -177,7 +455,8 @@ uint64_t Memory::get_mem_available() {
 
 uint64_t Memory::get_mem_usage() {
 #ifdef DEBUG_ENABLED
-	return mem_usage.get();
+	int64_t total = _sum_thread_usage();
+	return total > 0 ? total : 0;
 #else
 	return 0;
 #endif
@@ -185,6 +464,7 @@ uint64_t Memory::get_mem_usage() {
 
 uint64_t Memory::get_mem_max_usage() {
 #ifdef DEBUG_ENABLED
+	_update_peak_usage();
 	return max_usage.get();
 #else
 	return 0;
@@ -334,6 +334,10 @@ Dictionary OS::get_memory_info() const {
 	meminfo["free"] = -1;
 	meminfo["available"] = -1;
 	meminfo["stack"] = -1;
+	meminfo["resident"] = -1;
+	meminfo["page_faults_minor"] = -1;
+	meminfo["page_faults_major"] = -1;
+	meminfo["mapped_files"] = -1;
 
 	return meminfo;
 }
@@ -0,0 +1,604 @@
+/**************************************************************************/
+/*  a_hash_map.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef A_HASH_MAP_H
+#define A_HASH_MAP_H
+
+#include "core/math/math_funcs.h"
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#include <type_traits>
+
+/**
+ * An array-based HashMap implementation that uses open addressing with Robin Hood hashing.
+ *
+ * Unlike HashMap, no allocation is made per element. The key/value pairs are kept
+ * packed in a single array, in insertion order, and the table itself only stores
+ * the hashes and the indices of the pairs in two parallel arrays. Lookups thus only
+ * touch the hashes until a candidate is found, and iteration is a linear walk over
+ * the pairs.
+ *
+ * Erasing moves the last pair into the erased one's place, so insertion order is
+ * only kept until the first erase. Pointers to values and iterators are invalidated
+ * by insertions (which may grow the pair array) and erasures. Use HashMap when
+ * stable element addresses or strict ordering are needed.
+ *
+ * Like CowData, the pairs are moved in memory on growth without calling their
+ * copy constructors, so keys and values must be trivially relocatable, as are
+ * all the engine types.
+ *
+ * The assignment operator copy the pairs from one map to the other.
+ */
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class AHashMap {
+public:
+	static constexpr uint32_t MIN_CAPACITY_INDEX = 2; // Use a prime.
+	static constexpr float MAX_OCCUPANCY = 0.75;
+	static constexpr uint32_t EMPTY_HASH = 0;
+
+private:
+	typedef KeyValue<TKey, TValue> MapKeyValue;
+
+	MapKeyValue *elements = nullptr;
+	uint32_t *hashes = nullptr;
+	uint32_t *element_indices = nullptr;
+
+	uint32_t capacity_index = 0;
+	uint32_t num_elements = 0;
+
+	_FORCE_INLINE_ uint32_t _hash(const TKey &p_key) const {
+		uint32_t hash = Hasher::hash(p_key);
+
+		if (unlikely(hash == EMPTY_HASH)) {
+			hash = EMPTY_HASH + 1;
+		}
+
+		return hash;
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_element_capacity(uint32_t p_capacity_index) {
+		return MAX(1u, (uint32_t)(hash_table_size_primes[p_capacity_index] * MAX_OCCUPANCY));
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_probe_length(const uint32_t p_pos, const uint32_t p_hash, const uint32_t p_capacity, const uint64_t p_capacity_inv) {
+		const uint32_t original_pos = fastmod(p_hash, p_capacity_inv, p_capacity);
+		return fastmod(p_pos - original_pos + p_capacity, p_capacity_inv, p_capacity);
+	}
+
+	bool _lookup_pos_with_hash(const TKey &p_key, uint32_t p_hash, uint32_t &r_pos) const {
+		if (num_elements == 0) {
+			return false; // Failed lookups, no elements.
+		}
+
+		const uint32_t capacity = hash_table_size_primes[capacity_index];
+		const uint64_t capacity_inv = hash_table_size_primes_inv[capacity_index];
+		uint32_t pos = fastmod(p_hash, capacity_inv, capacity);
+		uint32_t distance = 0;
+
+		while (true) {
+			if (hashes[pos] == EMPTY_HASH) {
+				return false;
+			}
+
+			if (distance > _get_probe_length(pos, hashes[pos], capacity, capacity_inv)) {
+				return false;
+			}
+
+			if (hashes[pos] == p_hash && Comparator::compare(elements[element_indices[pos]].key, p_key)) {
+				r_pos = pos;
+				return true;
+			}
+
+			pos = fastmod((pos + 1), capacity_inv, capacity);
+			distance++;
+		}
+	}
+
+	_FORCE_INLINE_ bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		return _lookup_pos_with_hash(p_key, _hash(p_key), r_pos);
+	}
+
+	void _insert_with_hash(uint32_t p_hash, uint32_t p_element_index) {
+		const uint32_t capacity = hash_table_size_primes[capacity_index];
+		const uint64_t capacity_inv = hash_table_size_primes_inv[capacity_index];
+		uint32_t hash = p_hash;
+		uint32_t element_index = p_element_index;
+		uint32_t distance = 0;
+		uint32_t pos = fastmod(hash, capacity_inv, capacity);
+
+		while (true) {
+			if (hashes[pos] == EMPTY_HASH) {
+				hashes[pos] = hash;
+				element_indices[pos] = element_index;
+				return;
+			}
+
+			// Not an empty slot, let's check the probing length of the existing one.
+			uint32_t existing_probe_len = _get_probe_length(pos, hashes[pos], capacity, capacity_inv);
+			if (existing_probe_len < distance) {
+				SWAP(hash, hashes[pos]);
+				SWAP(element_index, element_indices[pos]);
+				distance = existing_probe_len;
+			}
+
+			pos = fastmod((pos + 1), capacity_inv, capacity);
+			distance++;
+		}
+	}
+
+	// Backward shift deletion of the table entry at p_pos. The pair itself is left untouched.
+	void _erase_pos(uint32_t p_pos) {
+		const uint32_t capacity = hash_table_size_primes[capacity_index];
+		const uint64_t capacity_inv = hash_table_size_primes_inv[capacity_index];
+		uint32_t pos = p_pos;
+		uint32_t next_pos = fastmod((pos + 1), capacity_inv, capacity);
+		while (hashes[next_pos] != EMPTY_HASH && _get_probe_length(next_pos, hashes[next_pos], capacity, capacity_inv) != 0) {
+			SWAP(hashes[next_pos], hashes[pos]);
+			SWAP(element_indices[next_pos], element_indices[pos]);
+			pos = next_pos;
+			next_pos = fastmod((pos + 1), capacity_inv, capacity);
+		}
+
+		hashes[pos] = EMPTY_HASH;
+	}
+
+	// Finds the table entry pointing to a given pair, whose hash is known.
+	uint32_t _find_pos_of_element(uint32_t p_hash, uint32_t p_element_index) const {
+		const uint32_t capacity = hash_table_size_primes[capacity_index];
+		const uint64_t capacity_inv = hash_table_size_primes_inv[capacity_index];
+		uint32_t pos = fastmod(p_hash, capacity_inv, capacity);
+		while (element_indices[pos] != p_element_index || hashes[pos] == EMPTY_HASH) {
+			pos = fastmod((pos + 1), capacity_inv, capacity);
+		}
+		return pos;
+	}
+
+	void _allocate(uint32_t p_capacity_index) {
+		capacity_index = p_capacity_index;
+		uint32_t capacity = hash_table_size_primes[capacity_index];
+
+		hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+		element_indices = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+		elements = reinterpret_cast<KeyValue<TKey, TValue> *>(Memory::alloc_static(sizeof(KeyValue<TKey, TValue>) * _get_element_capacity(capacity_index)));
+
+		for (uint32_t i = 0; i < capacity; i++) {
+			hashes[i] = EMPTY_HASH;
+		}
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity_index) {
+		// Capacity can't be 0.
+		capacity_index = MAX((uint32_t)MIN_CAPACITY_INDEX, p_new_capacity_index);
+
+		uint32_t capacity = hash_table_size_primes[capacity_index];
+
+		Memory::free_static(hashes);
+		Memory::free_static(element_indices);
+		hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+		element_indices = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+		elements = reinterpret_cast<KeyValue<TKey, TValue> *>(Memory::realloc_static(elements, sizeof(KeyValue<TKey, TValue>) * _get_element_capacity(capacity_index)));
+
+		for (uint32_t i = 0; i < capacity; i++) {
+			hashes[i] = EMPTY_HASH;
+		}
+
+		// The pairs stay where they are, only the table is rebuilt.
+		for (uint32_t i = 0; i < num_elements; i++) {
+			_insert_with_hash(_hash(elements[i].key), i);
+		}
+	}
+
+	_FORCE_INLINE_ KeyValue<TKey, TValue> *_insert(const TKey &p_key, const TValue &p_value) {
+		if (unlikely(elements == nullptr)) {
+			// Allocate on demand to save memory.
+			_allocate(capacity_index);
+		}
+
+		uint32_t hash = _hash(p_key);
+		uint32_t pos = 0;
+		bool exists = _lookup_pos_with_hash(p_key, hash, pos);
+
+		if (exists) {
+			elements[element_indices[pos]].value = p_value;
+			return &elements[element_indices[pos]];
+		} else {
+			if (num_elements + 1 > _get_element_capacity(capacity_index)) {
+				ERR_FAIL_COND_V_MSG(capacity_index + 1 == HASH_TABLE_SIZE_MAX, nullptr, "Hash table maximum capacity reached, aborting insertion.");
+				_resize_and_rehash(capacity_index + 1);
+			}
+
+			memnew_placement(&elements[num_elements], MapKeyValue(p_key, p_value));
+			_insert_with_hash(hash, num_elements);
+			num_elements++;
+			return &elements[num_elements - 1];
+		}
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return hash_table_size_primes[capacity_index]; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (elements == nullptr || num_elements == 0) {
+			return;
+		}
+
+		uint32_t capacity = hash_table_size_primes[capacity_index];
+		for (uint32_t i = 0; i < capacity; i++) {
+			hashes[i] = EMPTY_HASH;
+		}
+		if constexpr (!std::is_trivially_destructible_v<MapKeyValue>) {
+			for (uint32_t i = 0; i < num_elements; i++) {
+				elements[i].~MapKeyValue();
+			}
+		}
+
+		num_elements = 0;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "AHashMap key not found.");
+		return elements[element_indices[pos]].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "AHashMap key not found.");
+		return elements[element_indices[pos]].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return &elements[element_indices[pos]].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return &elements[element_indices[pos]].value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t _pos = 0;
+		return _lookup_pos(p_key, _pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (!exists) {
+			return false;
+		}
+
+		// p_key may be a reference to the pair's own key, don't use it from now on.
+		uint32_t element_index = element_indices[pos];
+		_erase_pos(pos);
+		elements[element_index].~MapKeyValue();
+		num_elements--;
+
+		if (element_index < num_elements) {
+			// Fill the hole with the last pair, and point its table entry to the new location.
+			uint32_t last_pos = _find_pos_of_element(_hash(elements[num_elements].key), num_elements);
+			memcpy((void *)&elements[element_index], (const void *)&elements[num_elements], sizeof(KeyValue<TKey, TValue>));
+			element_indices[last_pos] = element_index;
+		}
+
+		return true;
+	}
+
+	// Replace the key of an entry in-place, without invalidating iterators or changing the entries position during iteration.
+	// p_old_key must exist in the map and p_new_key must not, unless it is equal to p_old_key.
+	bool replace_key(const TKey &p_old_key, const TKey &p_new_key) {
+		if (p_old_key == p_new_key) {
+			return true;
+		}
+		uint32_t pos = 0;
+		ERR_FAIL_COND_V(_lookup_pos(p_new_key, pos), false);
+		ERR_FAIL_COND_V(!_lookup_pos(p_old_key, pos), false);
+		uint32_t element_index = element_indices[pos];
+		_erase_pos(pos);
+
+		const_cast<TKey &>(elements[element_index].key) = p_new_key;
+		_insert_with_hash(_hash(p_new_key), element_index);
+
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		uint32_t new_index = capacity_index;
+
+		while (hash_table_size_primes[new_index] < p_new_capacity) {
+			ERR_FAIL_COND_MSG(new_index + 1 == (uint32_t)HASH_TABLE_SIZE_MAX, nullptr);
+			new_index++;
+		}
+
+		if (new_index == capacity_index) {
+			return;
+		}
+
+		if (elements == nullptr) {
+			capacity_index = new_index;
+			return; // Unallocated yet.
+		}
+		_resize_and_rehash(new_index);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			return *E;
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return E; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			if (E) {
+				E = E == last ? nullptr : E + 1;
+			}
+			return *this;
+		}
+		_FORCE_INLINE_ ConstIterator &operator--() {
+			if (E) {
+				E = E == first ? nullptr : E - 1;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return E == b.E; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return E != b.E; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return E != nullptr;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const KeyValue<TKey, TValue> *p_E, const KeyValue<TKey, TValue> *p_first, const KeyValue<TKey, TValue> *p_last) {
+			E = p_E;
+			first = p_first;
+			last = p_last;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+		_FORCE_INLINE_ ConstIterator(const ConstIterator &p_it) {
+			E = p_it.E;
+			first = p_it.first;
+			last = p_it.last;
+		}
+		_FORCE_INLINE_ void operator=(const ConstIterator &p_it) {
+			E = p_it.E;
+			first = p_it.first;
+			last = p_it.last;
+		}
+
+	private:
+		const KeyValue<TKey, TValue> *E = nullptr;
+		const KeyValue<TKey, TValue> *first = nullptr;
+		const KeyValue<TKey, TValue> *last = nullptr;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const {
+			return *E;
+		}
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const { return E; }
+		_FORCE_INLINE_ Iterator &operator++() {
+			if (E) {
+				E = E == last ? nullptr : E + 1;
+			}
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			if (E) {
+				E = E == first ? nullptr : E - 1;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return E == b.E; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return E != b.E; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return E != nullptr;
+		}
+
+		_FORCE_INLINE_ Iterator(KeyValue<TKey, TValue> *p_E, KeyValue<TKey, TValue> *p_first, KeyValue<TKey, TValue> *p_last) {
+			E = p_E;
+			first = p_first;
+			last = p_last;
+		}
+		_FORCE_INLINE_ Iterator() {}
+		_FORCE_INLINE_ Iterator(const Iterator &p_it) {
+			E = p_it.E;
+			first = p_it.first;
+			last = p_it.last;
+		}
+		_FORCE_INLINE_ void operator=(const Iterator &p_it) {
+			E = p_it.E;
+			first = p_it.first;
+			last = p_it.last;
+		}
+
+		operator ConstIterator() const {
+			return ConstIterator(E, first, last);
+		}
+
+	private:
+		KeyValue<TKey, TValue> *E = nullptr;
+		KeyValue<TKey, TValue> *first = nullptr;
+		KeyValue<TKey, TValue> *last = nullptr;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return _make_iterator(num_elements ? elements : nullptr);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator();
+	}
+	_FORCE_INLINE_ Iterator last() {
+		return _make_iterator(num_elements ? elements + num_elements - 1 : nullptr);
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return _make_iterator(&elements[element_indices[pos]]);
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return _make_const_iterator(num_elements ? elements : nullptr);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator();
+	}
+	_FORCE_INLINE_ ConstIterator last() const {
+		return _make_const_iterator(num_elements ? elements + num_elements - 1 : nullptr);
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return _make_const_iterator(&elements[element_indices[pos]]);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND(!exists);
+		return elements[element_indices[pos]].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return _insert(p_key, TValue())->value;
+		} else {
+			return elements[element_indices[pos]].value;
+		}
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		return _make_iterator(_insert(p_key, p_value));
+	}
+
+	/* Constructors */
+
+	AHashMap(const AHashMap &p_other) {
+		capacity_index = MIN_CAPACITY_INDEX;
+		reserve(hash_table_size_primes[p_other.capacity_index]);
+
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void operator=(const AHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		if (num_elements != 0) {
+			clear();
+		}
+
+		reserve(hash_table_size_primes[p_other.capacity_index]);
+
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	AHashMap(uint32_t p_initial_capacity) {
+		// Capacity can't be 0.
+		capacity_index = 0;
+		reserve(p_initial_capacity);
+	}
+	AHashMap() {
+		capacity_index = MIN_CAPACITY_INDEX;
+	}
+
+	~AHashMap() {
+		clear();
+
+		if (elements != nullptr) {
+			Memory::free_static(elements);
+			Memory::free_static(hashes);
+			Memory::free_static(element_indices);
+		}
+	}
+
+private:
+	_FORCE_INLINE_ Iterator _make_iterator(KeyValue<TKey, TValue> *p_E) {
+		return p_E ? Iterator(p_E, elements, elements + num_elements - 1) : Iterator();
+	}
+	_FORCE_INLINE_ ConstIterator _make_const_iterator(const KeyValue<TKey, TValue> *p_E) const {
+		return p_E ? ConstIterator(p_E, elements, elements + num_elements - 1) : ConstIterator();
+	}
+};
+
+#endif // A_HASH_MAP_H
@@ -37,10 +37,13 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
+SafeNumeric<uint64_t> FileAccessUnix::mapped_bytes;
+
 void FileAccessUnix::check_errors() const {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
@@ -142,6 +145,14 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapped_data) {
+		munmap((void *)mapped_data, mapped_length);
+		mapped_bytes.sub(mapped_length);
+		mapped_data = nullptr;
+		mapped_length = 0;
+		mapped_pos = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -177,6 +188,10 @@ void FileAccessUnix::seek(uint64_t p_position) {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
 	last_error = OK;
+	if (mapped_data) {
+		mapped_pos = p_position;
+		return;
+	}
 	if (fseeko(f, p_position, SEEK_SET)) {
 		check_errors();
 	}
@@ -185,6 +200,12 @@ void FileAccessUnix::seek(uint64_t p_position) {
 void FileAccessUnix::seek_end(int64_t p_position) {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
+	if (mapped_data) {
+		ERR_FAIL_COND(p_position < 0 && (uint64_t)-p_position > mapped_length);
+		mapped_pos = mapped_length + p_position;
+		return;
+	}
+
 	if (fseeko(f, p_position, SEEK_END)) {
 		check_errors();
 	}
@@ -193,6 +214,10 @@ void FileAccessUnix::seek_end(int64_t p_position) {
 uint64_t FileAccessUnix::get_position() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
+	if (mapped_data) {
+		return mapped_pos;
+	}
+
 	int64_t pos = ftello(f);
 	if (pos < 0) {
 		check_errors();
@@ -204,6 +229,10 @@ uint64_t FileAccessUnix::get_position() const {
 uint64_t FileAccessUnix::get_length() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
+	if (mapped_data) {
+		return mapped_length;
+	}
+
 	int64_t pos = ftello(f);
 	ERR_FAIL_COND_V(pos < 0, 0);
 	ERR_FAIL_COND_V(fseeko(f, 0, SEEK_END), 0);
@@ -221,6 +250,12 @@ bool FileAccessUnix::eof_reached() const {
 uint8_t FileAccessUnix::get_8() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 	uint8_t b;
+	if (mapped_data) {
+		if (_read_mapped(&b, 1) == 0) {
+			b = '\0';
+		}
+		return b;
+	}
 	if (fread(&b, 1, 1, f) == 0) {
 		check_errors();
 		b = '\0';
@@ -232,7 +267,9 @@ uint16_t FileAccessUnix::get_16() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
 	uint16_t b = 0;
-	if (fread(&b, 1, 2, f) != 2) {
+	if (mapped_data) {
+		_read_mapped((uint8_t *)&b, 2);
+	} else if (fread(&b, 1, 2, f) != 2) {
 		check_errors();
 	}
 
@@ -247,7 +284,9 @@ uint32_t FileAccessUnix::get_32() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
 	uint32_t b = 0;
-	if (fread(&b, 1, 4, f) != 4) {
+	if (mapped_data) {
+		_read_mapped((uint8_t *)&b, 4);
+	} else if (fread(&b, 1, 4, f) != 4) {
 		check_errors();
 	}
 
@@ -262,7 +301,9 @@ uint64_t FileAccessUnix::get_64() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
 	uint64_t b = 0;
-	if (fread(&b, 1, 8, f) != 8) {
+	if (mapped_data) {
+		_read_mapped((uint8_t *)&b, 8);
+	} else if (fread(&b, 1, 8, f) != 8) {
 		check_errors();
 	}
 
@@ -277,11 +318,72 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 	ERR_FAIL_NULL_V_MSG(f, -1, "File must be opened before use.");
 
+	if (mapped_data) {
+		return _read_mapped(p_dst, p_length);
+	}
+
 	uint64_t read = fread(p_dst, 1, p_length, f);
 	check_errors();
 	return read;
 }
 
+uint64_t FileAccessUnix::_read_mapped(uint8_t *p_dst, uint64_t p_length) const {
+	uint64_t available = mapped_pos < mapped_length ? mapped_length - mapped_pos : 0;
+	uint64_t read = MIN(p_length, available);
+	if (read < p_length) {
+		// Same as fread, only reading past the end is an error.
+		last_error = ERR_FILE_EOF;
+	}
+	if (read > 0) {
+		memcpy(p_dst, mapped_data + mapped_pos, read);
+		mapped_pos += read;
+	}
+	return read;
+}
+
+bool FileAccessUnix::map_for_read() {
+	ERR_FAIL_NULL_V_MSG(f, false, "File must be opened before use.");
+
+	if (mapped_data) {
+		return true;
+	}
+	if (flags != READ) {
+		return false;
+	}
+
+	int fd = fileno(f);
+	struct stat st = {};
+	if (fd == -1 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+		return false;
+	}
+
+	int64_t pos = ftello(f);
+	if (pos < 0) {
+		return false;
+	}
+
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED) {
+		return false;
+	}
+
+	mapped_data = (const uint8_t *)data;
+	mapped_length = st.st_size;
+	mapped_pos = pos;
+	mapped_bytes.add(mapped_length);
+	return true;
+}
+
+const uint8_t *FileAccessUnix::get_buffer_mapped(uint64_t p_length) const {
+	if (!mapped_data || mapped_pos > mapped_length || p_length > mapped_length - mapped_pos) {
+		return nullptr;
+	}
+
+	const uint8_t *ptr = mapped_data + mapped_pos;
+	mapped_pos += p_length;
+	return ptr;
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
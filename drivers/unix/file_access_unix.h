@@ -33,6 +33,7 @@
 
 #include "core/io/file_access.h"
 #include "core/os/memory.h"
+#include "core/templates/safe_refcount.h"
 
 #include <stdio.h>
 
@@ -49,6 +50,14 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	// Set when the file is memory mapped for reading, all reads are then served from here.
+	const uint8_t *mapped_data = nullptr;
+	uint64_t mapped_length = 0;
+	mutable uint64_t mapped_pos = 0;
+
+	static SafeNumeric<uint64_t> mapped_bytes;
+
+	uint64_t _read_mapped(uint8_t *p_dst, uint64_t p_length) const;
 	void _close();
 
 public:
@@ -73,6 +82,9 @@ public:
 	virtual uint64_t get_64() const override;
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
 
+	virtual bool map_for_read() override;
+	virtual const uint8_t *get_buffer_mapped(uint64_t p_length) const override;
+
 	virtual Error get_error() const override; ///< get last error
 
 	virtual Error resize(int64_t p_length) override;
@@ -96,6 +108,8 @@ public:
 
 	virtual void close() override;
 
+	static uint64_t get_mapped_bytes() { return mapped_bytes.get(); } ///< total size of the files currently mapped for reading
+
 	FileAccessUnix() {}
 	virtual ~FileAccessUnix();
 };
@@ -314,6 +314,10 @@ Dictionary OS_Unix::get_memory_info() const {
 	meminfo["free"] = -1;
 	meminfo["available"] = -1;
 	meminfo["stack"] = -1;
+	meminfo["resident"] = -1;
+	meminfo["page_faults_minor"] = -1;
+	meminfo["page_faults_major"] = -1;
+	meminfo["mapped_files"] = (int64_t)FileAccessUnix::get_mapped_bytes();
 
 #if defined(__APPLE__)
 	int pagesize = 0;
@@ -481,6 +485,15 @@ Dictionary OS_Unix::get_memory_info() const {
 	if (mfree + sfree != 0) {
 		meminfo["available"] = mfree + sfree;
 	}
+
+	// Second field is the resident set size, in pages.
+	Ref<FileAccess> fs = FileAccess::open("/proc/self/statm", FileAccess::READ);
+	if (fs.is_valid()) {
+		Vector<String> stok = fs->get_line().strip_edges().split(" ");
+		if (stok.size() >= 2) {
+			meminfo["resident"] = stok[1].to_int() * sysconf(_SC_PAGESIZE);
+		}
+	}
 #endif
 
 	rlimit stackinfo = {};
@@ -490,6 +503,12 @@ Dictionary OS_Unix::get_memory_info() const {
 		meminfo["stack"] = (int64_t)stackinfo.rlim_cur;
 	}
 
+	rusage usage = {};
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+		meminfo["page_faults_minor"] = (int64_t)usage.ru_minflt;
+		meminfo["page_faults_major"] = (int64_t)usage.ru_majflt;
+	}
+
 	return meminfo;
 }
 
@@ -650,6 +650,7 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--benchmark-file <path>", "Benchmark the run time and save it to a given file in JSON format. The path should be absolute.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 #ifdef TESTS_ENABLED
 	print_help_option("--test [--help]", "Run unit tests. Use --test --help for more information.\n", CLI_OPTION_AVAILABILITY_EDITOR);
+	print_help_option("--test --benchmark [--benchmark-json <path>]", "Run the microbenchmarks instead of the unit tests, optionally saving the results to a given file in JSON format.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 #endif
 #endif
 	OS::get_singleton()->print("\n");
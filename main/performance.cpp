@@ -91,6 +91,14 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(PHYSICS_2D_CONSTRAINT_COUNT);
+	BIND_ENUM_CONSTANT(PHYSICS_2D_STEP_TIME);
+#ifndef _3D_DISABLED
+	BIND_ENUM_CONSTANT(PHYSICS_3D_CONSTRAINT_COUNT);
+	BIND_ENUM_CONSTANT(PHYSICS_3D_STEP_TIME);
+#endif // _3D_DISABLED
+	BIND_ENUM_CONSTANT(NAVIGATION_PATH_QUERY_QUEUE_DEPTH);
+	BIND_ENUM_CONSTANT(NAVIGATION_PATH_QUERY_DISPATCH_COUNT);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -141,6 +149,12 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"navigation/edges_merged",
 		"navigation/edges_connected",
 		"navigation/edges_free",
+		"physics_2d/constraints",
+		"physics_2d/step_time",
+		"physics_3d/constraints",
+		"physics_3d/step_time",
+		"navigation/path_queries_queued",
+		"navigation/path_queries_dispatched",
 
 	};
 
@@ -225,6 +239,25 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case PHYSICS_2D_CONSTRAINT_COUNT:
+			return PhysicsServer2D::get_singleton()->get_process_info(PhysicsServer2D::INFO_CONSTRAINT_COUNT);
+		case PHYSICS_2D_STEP_TIME:
+			return USEC_TO_SEC(PhysicsServer2D::get_singleton()->get_process_info(PhysicsServer2D::INFO_STEP_USEC));
+#ifdef _3D_DISABLED
+		case PHYSICS_3D_CONSTRAINT_COUNT:
+			return 0;
+		case PHYSICS_3D_STEP_TIME:
+			return 0;
+#else
+		case PHYSICS_3D_CONSTRAINT_COUNT:
+			return PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_CONSTRAINT_COUNT);
+		case PHYSICS_3D_STEP_TIME:
+			return USEC_TO_SEC(PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_STEP_USEC));
+#endif // _3D_DISABLED
+		case NAVIGATION_PATH_QUERY_QUEUE_DEPTH:
+			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_PATH_QUERY_QUEUE_DEPTH);
+		case NAVIGATION_PATH_QUERY_DISPATCH_COUNT:
+			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_PATH_QUERY_DISPATCH_COUNT);
 
 		default: {
 		}
@@ -272,6 +305,12 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
@@ -100,6 +100,12 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		PHYSICS_2D_CONSTRAINT_COUNT,
+		PHYSICS_2D_STEP_TIME,
+		PHYSICS_3D_CONSTRAINT_COUNT,
+		PHYSICS_3D_STEP_TIME,
+		NAVIGATION_PATH_QUERY_QUEUE_DEPTH,
+		NAVIGATION_PATH_QUERY_DISPATCH_COUNT,
 		MONITOR_MAX
 	};
 
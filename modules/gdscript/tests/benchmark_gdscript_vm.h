@@ -0,0 +1,143 @@
+/**************************************************************************/
+/*  benchmark_gdscript_vm.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_GDSCRIPT_VM_H
+#define BENCHMARK_GDSCRIPT_VM_H
+
+#include "../gdscript.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+// Each function stresses a small group of opcodes, typed and untyped.
+static const char *vm_benchmark_source = R"(
+extends RefCounted
+
+func int_arithmetic() -> int:
+	var total: int = 0
+	for i in 1000:
+		total += i * 3 - (i >> 1)
+	return total
+
+func untyped_arithmetic():
+	var total = 0
+	for i in 1000:
+		total += i * 3 - (i >> 1)
+	return total
+
+func float_math() -> float:
+	var total := 0.0
+	for i in 1000:
+		total += sqrt(float(i)) * 0.5
+	return total
+
+func vector_math() -> Vector3:
+	var v := Vector3.ZERO
+	for i in 1000:
+		v += Vector3(i, 1, 2).normalized() * 2.0
+	return v
+
+func array_access() -> int:
+	var array: Array[int] = []
+	array.resize(1000)
+	for i in 1000:
+		array[i] = i
+	var total := 0
+	for value in array:
+		total += value
+	return total
+
+func dictionary_access() -> int:
+	var dictionary := {}
+	for i in 1000:
+		dictionary[i] = i
+	var total := 0
+	for key in dictionary:
+		total += dictionary[key]
+	return total
+
+func _callee(p_value: int) -> int:
+	return p_value + 1
+
+func function_calls() -> int:
+	var total := 0
+	for i in 1000:
+		total = _callee(total)
+	return total
+
+func string_building() -> String:
+	var text := ""
+	for i in 100:
+		text += str(i)
+	return text
+
+func _make_entry(p_id: int, p_name: String) -> Dictionary:
+	return { "id": p_id, "name": p_name, "tags": [p_name, str(p_id)] }
+
+func allocating_calls() -> int:
+	var total := 0
+	for i in 1000:
+		var entry := _make_entry(i, "entry")
+		total += entry.tags.size()
+	return total
+)";
+
+#ifdef TOOLS_ENABLED
+BENCHMARK_SUITE("[Modules][GDScript]") {
+	TEST_CASE("VM opcodes") {
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(vm_benchmark_source);
+		// A spurious `Condition "err" is true` message is printed (despite parsing being successful and returning `OK`).
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		REQUIRE_MESSAGE(error == OK, "The benchmark script should parse successfully.");
+
+		Ref<RefCounted> instance = memnew(RefCounted);
+		instance->set_script(gdscript);
+
+		const char *functions[] = { "int_arithmetic", "untyped_arithmetic", "float_math", "vector_math", "array_access", "dictionary_access", "function_calls", "string_building", "allocating_calls" };
+		for (const char *function : functions) {
+			const StringName method = function;
+			Benchmark::run(vformat("GDScript %s()", function), [&]() {
+				Callable::CallError ce;
+				Variant result = instance->callp(method, nullptr, 0, ce);
+				Benchmark::keep(result);
+			});
+		}
+	}
+}
+#endif // TOOLS_ENABLED
+
+} // namespace GDScriptTests
+
+#endif // BENCHMARK_GDSCRIPT_VM_H
@@ -729,17 +729,16 @@ void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID>
 			continue; // Nothing to update.
 		}
 
-		Vector<const Variant *> varp;
-		varp.resize(delta.size());
-		const Variant **vptr = varp.ptrw();
-		int i = 0;
+		state_encoder.clear();
+		Error err = OK;
 		for (const Variant &v : delta) {
-			vptr[i] = &v;
-			i++;
+			err = state_encoder.append(v);
+			if (err != OK) {
+				break;
+			}
 		}
-		int size;
-		Error err = MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), nullptr, size);
 		ERR_CONTINUE_MSG(err != OK, "Unable to encode delta state.");
+		int size = state_encoder.get_size();
 
 		ERR_CONTINUE_MSG(size > delta_mtu, vformat("Synchronizer delta bigger than MTU will not be sent (%d > %d): %s", size, delta_mtu, sync->get_path()));
 
@@ -752,7 +751,7 @@ void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID>
 			ofs += encode_uint32(sync->get_net_id(), &ptr[ofs]);
 			ofs += encode_uint64(indexes, &ptr[ofs]);
 			ofs += encode_uint32(size, &ptr[ofs]);
-			MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), &ptr[ofs], size);
+			memcpy(&ptr[ofs], state_encoder.get_data(), size);
 			ofs += size;
 		}
 #ifdef DEBUG_ENABLED
@@ -829,8 +828,10 @@ void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &
 		const List<NodePath> props = sync->get_replication_config_ptr()->get_sync_properties();
 		Error err = MultiplayerSynchronizer::get_state(props, node, vars, varp);
 		ERR_CONTINUE_MSG(err != OK, "Unable to retrieve sync state.");
-		err = MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), nullptr, size);
+		state_encoder.clear();
+		err = state_encoder.append_array(varp.ptrw(), varp.size());
 		ERR_CONTINUE_MSG(err != OK, "Unable to encode sync state.");
+		size = state_encoder.get_size();
 		// TODO Handle single state above MTU.
 		ERR_CONTINUE_MSG(size > sync_mtu, vformat("Node states bigger than MTU will not be sent (%d > %d): %s", size, sync_mtu, node->get_path()));
 		if (ofs + 4 + 4 + size > sync_mtu) {
@@ -841,7 +842,7 @@ void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &
 		if (size) {
 			ofs += encode_uint32(sync->get_net_id(), &ptr[ofs]);
 			ofs += encode_uint32(size, &ptr[ofs]);
-			MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), &ptr[ofs], size);
+			memcpy(&ptr[ofs], state_encoder.get_data(), size);
 			ofs += size;
 		}
 #ifdef DEBUG_ENABLED
@@ -34,6 +34,7 @@
 #include "multiplayer_spawner.h"
 #include "multiplayer_synchronizer.h"
 
+#include "core/io/marshalls.h"
 #include "core/object/ref_counted.h"
 
 class SceneMultiplayer;
@@ -90,6 +91,7 @@ private:
 	SceneMultiplayer *multiplayer = nullptr;
 	SceneCacheInterface *multiplayer_cache = nullptr;
 	PackedByteArray packet_cache;
+	VariantEncoder state_encoder = VariantEncoder(false, true); // Same compact format as MultiplayerAPI::encode_and_compress_variant().
 	int sync_mtu = 1350; // Highly dependent on underlying protocol.
 	int delta_mtu = 65535;
 
@@ -277,6 +277,9 @@ real_t FORWARD_1_C(map_get_edge_connection_margin, RID, p_map, rid_to_rid);
 void FORWARD_2(map_set_link_connection_radius, RID, p_map, real_t, p_connection_radius, rid_to_rid, real_to_real);
 real_t FORWARD_1_C(map_get_link_connection_radius, RID, p_map, rid_to_rid);
 
+void FORWARD_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled, rid_to_rid, bool_to_bool);
+bool FORWARD_1_C(map_get_use_hierarchical_pathfinding, RID, p_map, rid_to_rid);
+
 Vector<Vector2> FORWARD_5_R_C(vector_v3_to_v2, map_get_path, RID, p_map, Vector2, p_origin, Vector2, p_destination, bool, p_optimize, uint32_t, p_layers, rid_to_rid, v2_to_v3, v2_to_v3, bool_to_bool, uint32_to_uint32);
 
 Vector2 FORWARD_2_R_C(v3_to_v2, map_get_closest_point, RID, p_map, const Vector2 &, p_point, rid_to_rid, v2_to_v3);
@@ -463,6 +466,58 @@ void GodotNavigationServer2D::query_path(const Ref<NavigationPathQueryParameters
 	p_query_result->set_path_owner_ids(_query_result.path_owner_ids);
 }
 
+// Batch of GodotNavigationServer2D::query_path_async(), solved by the 3D server.
+struct NavigationPathQueryBatch2D : public NavigationUtilities::PathQueryBatch {
+	LocalVector<Ref<NavigationPathQueryResult2D>> query_results;
+
+	virtual void publish_results() override {
+		for (uint32_t i = 0; i < query_results.size(); i++) {
+			const NavigationUtilities::PathQueryResult &result = results[i];
+			query_results[i]->set_path(vector_v3_to_v2(result.path));
+			query_results[i]->set_path_types(result.path_types);
+			query_results[i]->set_path_rids(result.path_rids);
+			query_results[i]->set_path_owner_ids(result.path_owner_ids);
+		}
+	}
+};
+
+int64_t GodotNavigationServer2D::query_path_async(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND_V_MSG(p_query_parameters.size() != p_query_results.size(), 0, "Each path query needs its own result object.");
+
+	NavigationPathQueryBatch2D *batch = memnew(NavigationPathQueryBatch2D);
+	batch->parameters.resize(p_query_parameters.size());
+	batch->query_results.resize(p_query_results.size());
+	for (int i = 0; i < p_query_parameters.size(); i++) {
+		const Ref<NavigationPathQueryParameters2D> query_parameters = p_query_parameters[i];
+		const Ref<NavigationPathQueryResult2D> query_result = p_query_results[i];
+		if (unlikely(query_parameters.is_null() || query_result.is_null())) {
+			memdelete(batch);
+			ERR_FAIL_V_MSG(0, vformat("Invalid path query parameters or result at index %d.", i));
+		}
+		batch->parameters[i] = query_parameters->get_parameters();
+		batch->query_results[i] = query_result;
+	}
+	batch->callback = p_callback;
+
+	return NavigationServer3D::get_singleton()->_query_path_async(batch);
+}
+
+bool GodotNavigationServer2D::is_path_query_completed(int64_t p_query_id) const {
+	return NavigationServer3D::get_singleton()->is_path_query_completed(p_query_id);
+}
+
+void GodotNavigationServer2D::wait_for_path_query(int64_t p_query_id) {
+	NavigationServer3D::get_singleton()->wait_for_path_query(p_query_id);
+}
+
+void GodotNavigationServer2D::set_async_path_query_budget(int p_max_queries) {
+	NavigationServer3D::get_singleton()->set_async_path_query_budget(p_max_queries);
+}
+
+int GodotNavigationServer2D::get_async_path_query_budget() const {
+	return NavigationServer3D::get_singleton()->get_async_path_query_budget();
+}
+
 RID GodotNavigationServer2D::source_geometry_parser_create() {
 #ifdef CLIPPER2_ENABLED
 	if (navmesh_generator_2d) {
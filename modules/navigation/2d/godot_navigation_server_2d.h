@@ -68,6 +68,8 @@ public:
 	virtual real_t map_get_edge_connection_margin(RID p_map) const override;
 	virtual void map_set_link_connection_radius(RID p_map, real_t p_connection_radius) override;
 	virtual real_t map_get_link_connection_radius(RID p_map) const override;
+	virtual void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) override;
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const override;
 	virtual Vector<Vector2> map_get_path(RID p_map, Vector2 p_origin, Vector2 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const override;
 	virtual Vector2 map_get_closest_point(RID p_map, const Vector2 &p_point) const override;
 	virtual RID map_get_closest_point_owner(RID p_map, const Vector2 &p_point) const override;
@@ -242,6 +244,11 @@ public:
 	virtual uint32_t obstacle_get_avoidance_layers(RID p_obstacle) const override;
 
 	virtual void query_path(const Ref<NavigationPathQueryParameters2D> &p_query_parameters, Ref<NavigationPathQueryResult2D> p_query_result) const override;
+	virtual int64_t query_path_async(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results, const Callable &p_callback = Callable()) override;
+	virtual bool is_path_query_completed(int64_t p_query_id) const override;
+	virtual void wait_for_path_query(int64_t p_query_id) override;
+	virtual void set_async_path_query_budget(int p_max_queries) override;
+	virtual int get_async_path_query_budget() const override;
 
 	virtual void init() override;
 	virtual void sync() override;
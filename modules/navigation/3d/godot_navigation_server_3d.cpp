@@ -30,6 +30,7 @@
 
 #include "godot_navigation_server_3d.h"
 
+#include "core/config/project_settings.h"
 #include "core/os/mutex.h"
 #include "scene/main/node.h"
 
@@ -82,7 +83,9 @@ using namespace NavigationUtilities;
 	}                                                                 \
 	void GodotNavigationServer3D::MERGE(_cmd_, F_NAME)(T_0 D_0, T_1 D_1)
 
-GodotNavigationServer3D::GodotNavigationServer3D() {}
+GodotNavigationServer3D::GodotNavigationServer3D() {
+	async_path_query_budget = GLOBAL_GET("navigation/pathfinding/async_path_query_budget");
+}
 
 GodotNavigationServer3D::~GodotNavigationServer3D() {
 	flush_queries();
@@ -237,6 +240,20 @@ real_t GodotNavigationServer3D::map_get_link_connection_radius(RID p_map) const
 	return map->get_link_connection_radius();
 }
 
+COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled) {
+	NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_use_hierarchical_pathfinding(p_enabled);
+}
+
+bool GodotNavigationServer3D::map_get_use_hierarchical_pathfinding(RID p_map) const {
+	NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, false);
+
+	return map->get_use_hierarchical_pathfinding();
+}
+
 Vector<Vector3> GodotNavigationServer3D::map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers) const {
 	const NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL_V(map, Vector<Vector3>());
@@ -1131,6 +1148,26 @@ void GodotNavigationServer3D::bake_from_source_geometry_data_async(const Ref<Nav
 #endif // _3D_DISABLED
 }
 
+void GodotNavigationServer3D::bake_tiles_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback) {
+#ifndef _3D_DISABLED
+	ERR_FAIL_COND_MSG(!p_navigation_mesh.is_valid(), "Invalid navigation mesh.");
+	ERR_FAIL_COND_MSG(!p_source_geometry_data.is_valid(), "Invalid NavigationMeshSourceGeometryData3D.");
+
+	ERR_FAIL_NULL(NavMeshGenerator3D::get_singleton());
+	NavMeshGenerator3D::get_singleton()->bake_tiles_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_aabb, p_callback);
+#endif // _3D_DISABLED
+}
+
+void GodotNavigationServer3D::bake_tiles_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback) {
+#ifndef _3D_DISABLED
+	ERR_FAIL_COND_MSG(!p_navigation_mesh.is_valid(), "Invalid navigation mesh.");
+	ERR_FAIL_COND_MSG(!p_source_geometry_data.is_valid(), "Invalid NavigationMeshSourceGeometryData3D.");
+
+	ERR_FAIL_NULL(NavMeshGenerator3D::get_singleton());
+	NavMeshGenerator3D::get_singleton()->bake_tiles_from_source_geometry_data_async(p_navigation_mesh, p_source_geometry_data, p_aabb, p_callback);
+#endif // _3D_DISABLED
+}
+
 bool GodotNavigationServer3D::is_baking_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) const {
 #ifdef _3D_DISABLED
 	return false;
@@ -1263,6 +1300,12 @@ void GodotNavigationServer3D::map_force_update(RID p_map) {
 	NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL(map);
 
+	{
+		// The maps can't change while asynchronous path queries are being solved.
+		MutexLock lock(path_query_mutex);
+		_wait_for_path_queries();
+	}
+
 	flush_queries();
 
 	map->sync();
@@ -1284,6 +1327,12 @@ void GodotNavigationServer3D::sync() {
 }
 
 void GodotNavigationServer3D::process(real_t p_delta_time) {
+	{
+		// Publish the path queries dispatched last frame before the maps change.
+		MutexLock lock(path_query_mutex);
+		_finish_path_queries();
+	}
+
 	flush_queries();
 
 	if (!active) {
@@ -1332,6 +1381,32 @@ void GodotNavigationServer3D::process(real_t p_delta_time) {
 	pm_edge_merge_count = _new_pm_edge_merge_count;
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
+
+	// Dispatch the queued path queries against the synchronized maps, they are solved while the frame goes on.
+	MutexLock path_query_lock(path_query_mutex);
+	LocalVector<PathQueryBatch *> batches;
+	int query_count = 0;
+	uint32_t batch_count = 0;
+	for (; batch_count < queued_path_query_batches.size(); batch_count++) {
+		PathQueryBatch *batch = queued_path_query_batches[batch_count];
+		if (async_path_query_budget > 0 && batch_count > 0 && query_count + int(batch->parameters.size()) > async_path_query_budget) {
+			break;
+		}
+		batches.push_back(batch);
+		query_count += batch->parameters.size();
+	}
+
+	int queue_depth = 0;
+	for (uint32_t i = batch_count; i < queued_path_query_batches.size(); i++) {
+		queued_path_query_batches[i - batch_count] = queued_path_query_batches[i];
+		queue_depth += queued_path_query_batches[i]->parameters.size();
+	}
+	queued_path_query_batches.resize(queued_path_query_batches.size() - batch_count);
+
+	_start_path_queries(batches);
+
+	pm_path_query_queue_depth = queue_depth;
+	pm_path_query_dispatch_count = query_count;
 }
 
 void GodotNavigationServer3D::init() {
@@ -1341,6 +1416,18 @@ void GodotNavigationServer3D::init() {
 }
 
 void GodotNavigationServer3D::finish() {
+	{
+		// Pending path queries are dropped, without calling their callbacks.
+		MutexLock lock(path_query_mutex);
+		_wait_for_path_queries();
+		for (KeyValue<int64_t, PathQueryBatch *> &E : path_query_batches) {
+			memdelete(E.value);
+		}
+		path_query_batches.clear();
+		queued_path_query_batches.clear();
+		running_path_query_batches.clear();
+	}
+
 	flush_queries();
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
@@ -1352,17 +1439,21 @@ void GodotNavigationServer3D::finish() {
 }
 
 PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &p_parameters) const {
-	PathQueryResult r_query_result;
-
 	const NavMap *map = map_owner.get_or_null(p_parameters.map);
-	ERR_FAIL_NULL_V(map, r_query_result);
+	ERR_FAIL_NULL_V(map, PathQueryResult());
+
+	return _query_map_path(map, p_parameters);
+}
+
+PathQueryResult GodotNavigationServer3D::_query_map_path(const NavMap *p_map, const PathQueryParameters &p_parameters) {
+	PathQueryResult r_query_result;
 
 	// run the pathfinding
 
 	if (p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR) {
 		// while postprocessing is still part of map.get_path() need to check and route it here for the correct "optimize" post-processing
 		if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					true,
@@ -1371,7 +1462,7 @@ PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
 		} else if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					false,
@@ -1433,6 +1524,122 @@ PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &
 	return r_query_result;
 }
 
+int64_t GodotNavigationServer3D::_query_path_async(PathQueryBatch *p_batch) {
+	ERR_FAIL_NULL_V(p_batch, 0);
+
+	MutexLock lock(path_query_mutex);
+
+	p_batch->id = ++last_path_query_id;
+	p_batch->results.resize(p_batch->parameters.size());
+	path_query_batches.insert(p_batch->id, p_batch);
+	queued_path_query_batches.push_back(p_batch);
+
+	return p_batch->id;
+}
+
+bool GodotNavigationServer3D::is_path_query_completed(int64_t p_query_id) const {
+	MutexLock lock(path_query_mutex);
+
+	return p_query_id > 0 && p_query_id <= last_path_query_id && !path_query_batches.has(p_query_id);
+}
+
+void GodotNavigationServer3D::wait_for_path_query(int64_t p_query_id) {
+	MutexLock lock(path_query_mutex);
+
+	_finish_path_queries();
+
+	HashMap<int64_t, PathQueryBatch *>::Iterator E = path_query_batches.find(p_query_id);
+	if (!E) {
+		// Already published, or never submitted.
+		return;
+	}
+
+	// Still queued, solve it on its own right away.
+	queued_path_query_batches.erase(E->value);
+	LocalVector<PathQueryBatch *> batches;
+	batches.push_back(E->value);
+	_start_path_queries(batches);
+	_finish_path_queries();
+}
+
+void GodotNavigationServer3D::set_async_path_query_budget(int p_max_queries) {
+	MutexLock lock(path_query_mutex);
+
+	async_path_query_budget = MAX(p_max_queries, 0);
+}
+
+int GodotNavigationServer3D::get_async_path_query_budget() const {
+	MutexLock lock(path_query_mutex);
+
+	return async_path_query_budget;
+}
+
+void GodotNavigationServer3D::_solve_path_query(uint32_t p_index, PathQueryTask *p_tasks) {
+	const PathQueryTask &task = p_tasks[p_index];
+	task.batch->results[task.index] = _query_map_path(task.map, task.batch->parameters[task.index]);
+}
+
+void GodotNavigationServer3D::_start_path_queries(const LocalVector<PathQueryBatch *> &p_batches) {
+	// Maps are only changed while processing the server, after the running queries are waited for.
+	// Their pointers are resolved here, so the worker threads don't access the RID owners.
+	for (PathQueryBatch *batch : p_batches) {
+		running_path_query_batches.push_back(batch);
+		for (uint32_t i = 0; i < batch->parameters.size(); i++) {
+			const NavMap *map = map_owner.get_or_null(batch->parameters[i].map);
+			if (unlikely(!map)) {
+				ERR_PRINT(vformat("Path query %d of batch %d has an invalid map.", i, batch->id));
+				continue;
+			}
+			PathQueryTask task;
+			task.map = map;
+			task.batch = batch;
+			task.index = i;
+			running_path_query_tasks.push_back(task);
+		}
+	}
+
+	if (!running_path_query_tasks.is_empty()) {
+		path_query_group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer3D::_solve_path_query, running_path_query_tasks.ptr(), running_path_query_tasks.size(), -1, true, SNAME("NavigationPathQueries"));
+	}
+}
+
+void GodotNavigationServer3D::_wait_for_path_queries() {
+	if (path_query_group_task != -1) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(path_query_group_task);
+		path_query_group_task = -1;
+	}
+	running_path_query_tasks.clear();
+}
+
+void GodotNavigationServer3D::_finish_path_queries() {
+	_wait_for_path_queries();
+
+	if (running_path_query_batches.is_empty()) {
+		return;
+	}
+
+	LocalVector<PathQueryBatch *> batches = running_path_query_batches;
+	running_path_query_batches.clear();
+
+	// Publish every batch before running any callback. A callback can wait for another batch of
+	// this list, which must then be found completed instead of being solved and freed again.
+	for (PathQueryBatch *batch : batches) {
+		batch->publish_results();
+		path_query_batches.erase(batch->id);
+	}
+
+	// The callbacks may be used to submit new queries, which is fine as the lock is recursive.
+	for (PathQueryBatch *batch : batches) {
+		if (batch->callback.is_valid()) {
+			batch->callback.call(batch->id);
+		}
+	}
+
+	for (PathQueryBatch *batch : batches) {
+		memdelete(batch);
+	}
+}
+
 RID GodotNavigationServer3D::source_geometry_parser_create() {
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
@@ -1566,6 +1773,12 @@ int GodotNavigationServer3D::get_process_info(ProcessInfo p_info) const {
 		case INFO_EDGE_FREE_COUNT: {
 			return pm_edge_free_count;
 		} break;
+		case INFO_PATH_QUERY_QUEUE_DEPTH: {
+			return pm_path_query_queue_depth;
+		} break;
+		case INFO_PATH_QUERY_DISPATCH_COUNT: {
+			return pm_path_query_dispatch_count;
+		} break;
 	}
 
 	return 0;
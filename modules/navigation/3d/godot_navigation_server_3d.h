@@ -37,6 +37,7 @@
 #include "../nav_obstacle.h"
 #include "../nav_region.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/rid_owner.h"
@@ -86,6 +87,26 @@ class GodotNavigationServer3D : public NavigationServer3D {
 	NavMeshGenerator3D *navmesh_generator_3d = nullptr;
 #endif // _3D_DISABLED
 
+	/// Asynchronous path queries.
+	/// Batches are dispatched after the maps are synchronized, and solved while the frame goes on.
+	/// The next process waits for them before changing the maps, then publishes their results.
+	struct PathQueryTask {
+		const NavMap *map = nullptr;
+		NavigationUtilities::PathQueryBatch *batch = nullptr;
+		uint32_t index = 0;
+	};
+
+	mutable Mutex path_query_mutex;
+	int64_t last_path_query_id = 0;
+	/// Batches not published yet.
+	HashMap<int64_t, NavigationUtilities::PathQueryBatch *> path_query_batches;
+	/// Batches waiting to be dispatched, in submission order.
+	LocalVector<NavigationUtilities::PathQueryBatch *> queued_path_query_batches;
+	LocalVector<NavigationUtilities::PathQueryBatch *> running_path_query_batches;
+	LocalVector<PathQueryTask> running_path_query_tasks;
+	WorkerThreadPool::GroupID path_query_group_task = -1;
+	int async_path_query_budget = 0;
+
 	// Performance Monitor
 	int pm_region_count = 0;
 	int pm_agent_count = 0;
@@ -95,6 +116,8 @@ class GodotNavigationServer3D : public NavigationServer3D {
 	int pm_edge_merge_count = 0;
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
+	int pm_path_query_queue_depth = 0;
+	int pm_path_query_dispatch_count = 0;
 
 public:
 	GodotNavigationServer3D();
@@ -129,6 +152,9 @@ public:
 	COMMAND_2(map_set_link_connection_radius, RID, p_map, real_t, p_connection_radius);
 	virtual real_t map_get_link_connection_radius(RID p_map) const override;
 
+	COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled);
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const override;
+
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const override;
 
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const override;
@@ -262,6 +288,8 @@ public:
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
+	virtual void bake_tiles_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback = Callable()) override;
+	virtual void bake_tiles_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback = Callable()) override;
 	virtual bool is_baking_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) const override;
 
 	virtual RID source_geometry_parser_create() override;
@@ -286,11 +314,23 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
 
+	virtual bool is_path_query_completed(int64_t p_query_id) const override;
+	virtual void wait_for_path_query(int64_t p_query_id) override;
+	virtual void set_async_path_query_budget(int p_max_queries) override;
+	virtual int get_async_path_query_budget() const override;
+	virtual int64_t _query_path_async(NavigationUtilities::PathQueryBatch *p_batch) override;
+
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
+
+	static NavigationUtilities::PathQueryResult _query_map_path(const NavMap *p_map, const NavigationUtilities::PathQueryParameters &p_parameters);
+	void _solve_path_query(uint32_t p_index, PathQueryTask *p_tasks);
+	void _start_path_queries(const LocalVector<NavigationUtilities::PathQueryBatch *> &p_batches);
+	void _wait_for_path_queries();
+	void _finish_path_queries();
 };
 
 #undef COMMAND_1
@@ -72,6 +72,7 @@ bool NavMeshGenerator3D::baking_use_multiple_threads = true;
 bool NavMeshGenerator3D::baking_use_high_priority_threads = true;
 HashSet<Ref<NavigationMesh>> NavMeshGenerator3D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tasks;
+HashMap<WorkerThreadPool::GroupID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tiled_tasks;
 RID_Owner<NavMeshGenerator3D::NavMeshGeometryParser3D> NavMeshGenerator3D::generator_parser_owner;
 LocalVector<NavMeshGenerator3D::NavMeshGeometryParser3D *> NavMeshGenerator3D::generator_parsers;
 
@@ -96,7 +97,7 @@ NavMeshGenerator3D::~NavMeshGenerator3D() {
 }
 
 void NavMeshGenerator3D::sync() {
-	if (generator_tasks.size() == 0) {
+	if (generator_tasks.size() == 0 && generator_tiled_tasks.size() == 0) {
 		return;
 	}
 
@@ -125,6 +126,30 @@ void NavMeshGenerator3D::sync() {
 		generator_tasks.erase(finished_task_id);
 	}
 
+	LocalVector<WorkerThreadPool::GroupID> finished_group_ids;
+
+	for (KeyValue<WorkerThreadPool::GroupID, NavMeshGeneratorTask3D *> &E : generator_tiled_tasks) {
+		if (WorkerThreadPool::get_singleton()->is_group_task_completed(E.key)) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(E.key);
+			finished_group_ids.push_back(E.key);
+
+			// The tiles were stitched into the navigation mesh by the last of them.
+			NavMeshGeneratorTask3D *generator_task = E.value;
+			generator_task->status = NavMeshGeneratorTask3D::TaskStatus::BAKING_FINISHED;
+
+			baking_navmeshes.erase(generator_task->navigation_mesh);
+			if (generator_task->callback.is_valid()) {
+				generator_emit_callback(generator_task->callback);
+			}
+			memdelete(generator_task->tiled_bake);
+			memdelete(generator_task);
+		}
+	}
+
+	for (WorkerThreadPool::GroupID finished_group_id : finished_group_ids) {
+		generator_tiled_tasks.erase(finished_group_id);
+	}
+
 	generator_task_mutex.unlock();
 	baking_navmesh_mutex.unlock();
 }
@@ -142,6 +167,14 @@ void NavMeshGenerator3D::cleanup() {
 	}
 	generator_tasks.clear();
 
+	for (KeyValue<WorkerThreadPool::GroupID, NavMeshGeneratorTask3D *> &E : generator_tiled_tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(E.key);
+		NavMeshGeneratorTask3D *generator_task = E.value;
+		memdelete(generator_task->tiled_bake);
+		memdelete(generator_task);
+	}
+	generator_tiled_tasks.clear();
+
 	generator_rid_rwlock.write_lock();
 	for (NavMeshGeometryParser3D *parser : generator_parsers) {
 		generator_parser_owner.free(parser->self);
@@ -226,6 +259,11 @@ void NavMeshGenerator3D::bake_from_source_geometry_data_async(Ref<NavigationMesh
 	baking_navmeshes.insert(p_navigation_mesh);
 	baking_navmesh_mutex.unlock();
 
+	if (p_navigation_mesh->get_tile_size() > 0.0) {
+		generator_bake_tiles_async(p_navigation_mesh, p_source_geometry_data, AABB(), false, p_callback);
+		return;
+	}
+
 	generator_task_mutex.lock();
 	NavMeshGeneratorTask3D *generator_task = memnew(NavMeshGeneratorTask3D);
 	generator_task->navigation_mesh = p_navigation_mesh;
@@ -237,6 +275,53 @@ void NavMeshGenerator3D::bake_from_source_geometry_data_async(Ref<NavigationMesh
 	generator_task_mutex.unlock();
 }
 
+void NavMeshGenerator3D::bake_tiles_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback) {
+	ERR_FAIL_COND(!p_navigation_mesh.is_valid());
+	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
+	ERR_FAIL_COND_MSG(p_navigation_mesh->get_tile_size() <= 0.0, "Baking tiles requires a NavigationMesh with a tile_size.");
+
+	if (is_baking(p_navigation_mesh)) {
+		ERR_FAIL_MSG("NavigationMesh is already baking. Wait for current bake to finish.");
+	}
+	baking_navmesh_mutex.lock();
+	baking_navmeshes.insert(p_navigation_mesh);
+	baking_navmesh_mutex.unlock();
+
+	NavMeshTiledBake3D *tiled_bake = generator_create_tiled_bake(p_navigation_mesh, p_source_geometry_data, p_aabb, true);
+	if (tiled_bake) {
+		generator_bake_tiles(tiled_bake);
+		memdelete(tiled_bake);
+	}
+
+	baking_navmesh_mutex.lock();
+	baking_navmeshes.erase(p_navigation_mesh);
+	baking_navmesh_mutex.unlock();
+
+	if (p_callback.is_valid()) {
+		generator_emit_callback(p_callback);
+	}
+}
+
+void NavMeshGenerator3D::bake_tiles_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback) {
+	ERR_FAIL_COND(!p_navigation_mesh.is_valid());
+	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
+	ERR_FAIL_COND_MSG(p_navigation_mesh->get_tile_size() <= 0.0, "Baking tiles requires a NavigationMesh with a tile_size.");
+
+	if (!use_threads) {
+		bake_tiles_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_aabb, p_callback);
+		return;
+	}
+
+	if (is_baking(p_navigation_mesh)) {
+		ERR_FAIL_MSG("NavigationMesh is already baking. Wait for current bake to finish.");
+	}
+	baking_navmesh_mutex.lock();
+	baking_navmeshes.insert(p_navigation_mesh);
+	baking_navmesh_mutex.unlock();
+
+	generator_bake_tiles_async(p_navigation_mesh, p_source_geometry_data, p_aabb, true, p_callback);
+}
+
 bool NavMeshGenerator3D::is_baking(Ref<NavigationMesh> p_navigation_mesh) {
 	baking_navmesh_mutex.lock();
 	bool baking = baking_navmeshes.has(p_navigation_mesh);
@@ -672,6 +757,15 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
+	if (p_navigation_mesh->get_tile_size() > 0.0) {
+		NavMeshTiledBake3D *tiled_bake = generator_create_tiled_bake(p_navigation_mesh, p_source_geometry_data, AABB(), false);
+		if (tiled_bake) {
+			generator_bake_tiles(tiled_bake);
+			memdelete(tiled_bake);
+		}
+		return;
+	}
+
 	const Vector<float> &vertices = p_source_geometry_data->get_vertices();
 	const Vector<int> &indices = p_source_geometry_data->get_indices();
 
@@ -679,27 +773,50 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
-	rcHeightfield *hf = nullptr;
-	rcCompactHeightfield *chf = nullptr;
-	rcContourSet *cset = nullptr;
-	rcPolyMesh *poly_mesh = nullptr;
-	rcPolyMeshDetail *detail_mesh = nullptr;
-	rcContext ctx;
-
-	// added to keep track of steps, no functionality right now
-	String bake_state = "";
-
-	bake_state = "Setting up Configuration..."; // step #1
-
 	const float *verts = vertices.ptr();
 	const int nverts = vertices.size() / 3;
 	const int *tris = indices.ptr();
 	const int ntris = indices.size() / 3;
 
+	rcConfig cfg;
+	generator_get_bake_config(p_navigation_mesh, cfg);
+
 	float bmin[3], bmax[3];
 	rcCalcBounds(verts, nverts, bmin, bmax);
 
-	rcConfig cfg;
+	cfg.bmin[0] = bmin[0];
+	cfg.bmin[1] = bmin[1];
+	cfg.bmin[2] = bmin[2];
+	cfg.bmax[0] = bmax[0];
+	cfg.bmax[1] = bmax[1];
+	cfg.bmax[2] = bmax[2];
+
+	AABB baking_aabb = p_navigation_mesh->get_filter_baking_aabb();
+	if (baking_aabb.has_volume()) {
+		Vector3 baking_aabb_offset = p_navigation_mesh->get_filter_baking_aabb_offset();
+		cfg.bmin[0] = baking_aabb.position[0] + baking_aabb_offset.x;
+		cfg.bmin[1] = baking_aabb.position[1] + baking_aabb_offset.y;
+		cfg.bmin[2] = baking_aabb.position[2] + baking_aabb_offset.z;
+		cfg.bmax[0] = cfg.bmin[0] + baking_aabb.size[0];
+		cfg.bmax[1] = cfg.bmin[1] + baking_aabb.size[1];
+		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
+	}
+
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	if (!generator_bake_heightfield(p_navigation_mesh, p_source_geometry_data, cfg, verts, nverts, tris, ntris, nav_vertices, nav_polygons)) {
+		return;
+	}
+
+	p_navigation_mesh->set_vertices(nav_vertices);
+	p_navigation_mesh->clear_polygons();
+	for (const Vector<int> &nav_polygon : nav_polygons) {
+		p_navigation_mesh->add_polygon(nav_polygon);
+	}
+}
+
+void NavMeshGenerator3D::generator_get_bake_config(const Ref<NavigationMesh> &p_navigation_mesh, rcConfig &r_config) {
+	rcConfig &cfg = r_config;
 	memset(&cfg, 0, sizeof(cfg));
 
 	cfg.cs = p_navigation_mesh->get_cell_size();
@@ -722,6 +839,9 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	if (p_navigation_mesh->get_border_size() > 0.0 && Math::fmod(p_navigation_mesh->get_border_size(), p_navigation_mesh->get_cell_size()) != 0.0) {
 		WARN_PRINT("Property border_size is ceiled to cell_size voxel units and loses precision.");
 	}
+	if (p_navigation_mesh->get_tile_size() > 0.0 && Math::fmod(p_navigation_mesh->get_tile_size(), p_navigation_mesh->get_cell_size()) != 0.0) {
+		WARN_PRINT("Property tile_size is ceiled to cell_size voxel units and loses precision.");
+	}
 	if (!Math::is_equal_approx((float)cfg.walkableHeight * cfg.ch, p_navigation_mesh->get_agent_height())) {
 		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
 	}
@@ -746,56 +866,51 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	if (p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance() < 0.1f) {
 		WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
 	}
+}
 
-	cfg.bmin[0] = bmin[0];
-	cfg.bmin[1] = bmin[1];
-	cfg.bmin[2] = bmin[2];
-	cfg.bmax[0] = bmax[0];
-	cfg.bmax[1] = bmax[1];
-	cfg.bmax[2] = bmax[2];
+bool NavMeshGenerator3D::generator_bake_heightfield(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, rcConfig &p_config, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	rcConfig &cfg = p_config;
 
-	AABB baking_aabb = p_navigation_mesh->get_filter_baking_aabb();
-	if (baking_aabb.has_volume()) {
-		Vector3 baking_aabb_offset = p_navigation_mesh->get_filter_baking_aabb_offset();
-		cfg.bmin[0] = baking_aabb.position[0] + baking_aabb_offset.x;
-		cfg.bmin[1] = baking_aabb.position[1] + baking_aabb_offset.y;
-		cfg.bmin[2] = baking_aabb.position[2] + baking_aabb_offset.z;
-		cfg.bmax[0] = cfg.bmin[0] + baking_aabb.size[0];
-		cfg.bmax[1] = cfg.bmin[1] + baking_aabb.size[1];
-		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
-	}
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+	rcContext ctx;
+
+	// added to keep track of steps, no functionality right now
+	String bake_state = "";
 
 	bake_state = "Calculating grid size..."; // step #2
 	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
 	// ~30000000 seems to be around sweetspot where Editor baking breaks
 	if ((cfg.width * cfg.height) > 30000000 && GLOBAL_GET("navigation/baking/use_crash_prevention_checks")) {
-		ERR_FAIL_MSG("Baking interrupted."
-					 "\nNavigationMesh baking process would likely crash the engine."
-					 "\nSource geometry is suspiciously big for the current Cell Size and Cell Height in the NavMesh Resource bake settings."
-					 "\nIf baking does not crash the engine or fail, the resulting NavigationMesh will create serious pathfinding performance issues."
-					 "\nIt is advised to increase Cell Size and/or Cell Height in the NavMesh Resource bake settings or reduce the size / scale of the source geometry."
-					 "\nIf you would like to try baking anyway, disable the 'navigation/baking/use_crash_prevention_checks' project setting.");
-		return;
+		ERR_FAIL_V_MSG(false, "Baking interrupted."
+							  "\nNavigationMesh baking process would likely crash the engine."
+							  "\nSource geometry is suspiciously big for the current Cell Size and Cell Height in the NavMesh Resource bake settings."
+							  "\nIf baking does not crash the engine or fail, the resulting NavigationMesh will create serious pathfinding performance issues."
+							  "\nIt is advised to increase Cell Size and/or Cell Height in the NavMesh Resource bake settings or reduce the size / scale of the source geometry."
+							  "\nIf you would like to try baking anyway, disable the 'navigation/baking/use_crash_prevention_checks' project setting.");
 	}
 
 	bake_state = "Creating heightfield..."; // step #3
 	hf = rcAllocHeightfield();
 
-	ERR_FAIL_NULL(hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+	ERR_FAIL_NULL_V(hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch), false);
 
 	bake_state = "Marking walkable triangles..."; // step #4
 	{
 		Vector<unsigned char> tri_areas;
-		tri_areas.resize(ntris);
+		tri_areas.resize(p_ntris);
 
-		ERR_FAIL_COND(tri_areas.is_empty());
+		ERR_FAIL_COND_V(tri_areas.is_empty(), false);
 
-		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
+		memset(tri_areas.ptrw(), 0, p_ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, p_verts, p_nverts, p_tris, p_ntris, tri_areas.ptrw());
 
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, p_verts, p_nverts, p_tris, tri_areas.ptr(), p_ntris, *hf, cfg.walkableClimb), false);
 	}
 
 	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
@@ -812,8 +927,8 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	chf = rcAllocCompactHeightfield();
 
-	ERR_FAIL_NULL(chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
+	ERR_FAIL_NULL_V(chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf), false);
 
 	rcFreeHeightField(hf);
 	hf = nullptr;
@@ -839,7 +954,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	bake_state = "Eroding walkable area..."; // step #6
 
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf), false);
 
 	// Carve obstacles to the eroded geometry. Those will NOT be affected by e.g. agent_radius because that step is already done.
 	if (!projected_obstructions.is_empty()) {
@@ -861,30 +976,30 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	bake_state = "Partitioning..."; // step #7
 
 	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea), false);
 	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea), false);
 	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea));
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea), false);
 	}
 
 	bake_state = "Creating contours..."; // step #8
 
 	cset = rcAllocContourSet();
 
-	ERR_FAIL_NULL(cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
+	ERR_FAIL_NULL_V(cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset), false);
 
 	bake_state = "Creating polymesh..."; // step #9
 
 	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_NULL(poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
+	ERR_FAIL_NULL_V(poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh), false);
 
 	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_NULL(detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
+	ERR_FAIL_NULL_V(detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh), false);
 
 	rcFreeCompactHeightfield(chf);
 	chf = nullptr;
@@ -893,14 +1008,12 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	bake_state = "Converting to native navigation mesh..."; // step #10
 
-	Vector<Vector3> nav_vertices;
-
+	r_vertices.resize(detail_mesh->nverts);
+	Vector3 *nav_vertices = r_vertices.ptrw();
 	for (int i = 0; i < detail_mesh->nverts; i++) {
 		const float *v = &detail_mesh->verts[i * 3];
-		nav_vertices.push_back(Vector3(v[0], v[1], v[2]));
+		nav_vertices[i] = Vector3(v[0], v[1], v[2]);
 	}
-	p_navigation_mesh->set_vertices(nav_vertices);
-	p_navigation_mesh->clear_polygons();
 
 	for (int i = 0; i < detail_mesh->nmeshes; i++) {
 		const unsigned int *detail_mesh_m = &detail_mesh->meshes[i * 4];
@@ -915,7 +1028,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 			nav_indices.write[0] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 0]));
 			nav_indices.write[1] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 2]));
 			nav_indices.write[2] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 1]));
-			p_navigation_mesh->add_polygon(nav_indices);
+			r_polygons.push_back(nav_indices);
 		}
 	}
 
@@ -927,6 +1040,316 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	detail_mesh = nullptr;
 
 	bake_state = "Baking finished."; // step #12
+
+	return true;
+}
+
+// A navigation mesh baked as a grid of tiles. The grid is aligned to the world origin, so that
+// baking a part of the navigation mesh again produces the same tiles.
+struct NavMeshGenerator3D::NavMeshTiledBake3D {
+	struct Tile {
+		// Bounds of the tile heightfield, including the border shared with the neighbor tiles.
+		rcConfig config;
+		// Source triangles overlapping the heightfield, empty when the tile is outside of the baking bounds.
+		LocalVector<int> triangles;
+
+		Vector<Vector3> vertices;
+		Vector<Vector<int>> polygons;
+	};
+
+	Ref<NavigationMesh> navigation_mesh;
+	Ref<NavigationMeshSourceGeometryData3D> source_geometry_data;
+
+	float tile_world_size = 0.0;
+	// Inclusive range of the baked tile coordinates, on the XZ plane.
+	Vector2i tile_min;
+	Vector2i tile_max;
+	LocalVector<Tile> tiles;
+
+	// When true, only the polygons of the baked tiles are replaced in the navigation mesh.
+	bool partial = false;
+	int max_threads = -1;
+	SafeNumeric<uint32_t> tiles_remaining;
+
+	Vector2i get_tile_coords(const Vector3 &p_position) const {
+		return Vector2i((int)Math::floor(p_position.x / tile_world_size), (int)Math::floor(p_position.z / tile_world_size));
+	}
+
+	bool has_tile(const Vector2i &p_coords) const {
+		return p_coords.x >= tile_min.x && p_coords.x <= tile_max.x && p_coords.y >= tile_min.y && p_coords.y <= tile_max.y;
+	}
+};
+
+NavMeshGenerator3D::NavMeshTiledBake3D *NavMeshGenerator3D::generator_create_tiled_bake(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_aabb, bool p_partial) {
+	const Vector<float> &vertices = p_source_geometry_data->get_vertices();
+	const Vector<int> &indices = p_source_geometry_data->get_indices();
+	const bool has_geometry = vertices.size() >= 3 && indices.size() >= 3;
+
+	rcConfig cfg;
+	generator_get_bake_config(p_navigation_mesh, cfg);
+
+	// Baking bounds, the tiles are clipped to them.
+	AABB bounds;
+	bool has_bounds = true;
+	const AABB baking_aabb = p_navigation_mesh->get_filter_baking_aabb();
+	if (baking_aabb.has_volume()) {
+		bounds = AABB(baking_aabb.position + p_navigation_mesh->get_filter_baking_aabb_offset(), baking_aabb.size);
+	} else if (has_geometry) {
+		float bmin[3], bmax[3];
+		rcCalcBounds(vertices.ptr(), vertices.size() / 3, bmin, bmax);
+		bounds = AABB(Vector3(bmin[0], bmin[1], bmin[2]), Vector3(bmax[0] - bmin[0], bmax[1] - bmin[1], bmax[2] - bmin[2]));
+	} else {
+		has_bounds = false;
+	}
+
+	if (has_bounds) {
+		// The border is left out of the tiles along the baking bounds, and they are snapped to the cells.
+		const real_t border = cfg.borderSize * cfg.cs;
+		Vector3 begin = bounds.position + Vector3(border, 0.0, border);
+		Vector3 end = bounds.get_end() - Vector3(border, 0.0, border);
+		begin.x = Math::floor(begin.x / cfg.cs) * cfg.cs;
+		begin.z = Math::floor(begin.z / cfg.cs) * cfg.cs;
+		end.x = Math::ceil(end.x / cfg.cs) * cfg.cs;
+		end.z = Math::ceil(end.z / cfg.cs) * cfg.cs;
+		bounds = AABB(begin, end - begin);
+		has_bounds = bounds.size.x > 0.0 && bounds.size.z > 0.0;
+	}
+
+	// Area covered by the baked tiles, on the XZ plane.
+	Rect2 area;
+	if (p_partial) {
+		// Tiles that are now outside of the baking bounds are baked too, to clear them.
+		Rect2 extent;
+		bool has_extent = false;
+		if (has_bounds) {
+			extent = Rect2(bounds.position.x, bounds.position.z, bounds.size.x, bounds.size.z);
+			has_extent = true;
+		}
+		for (const Vector3 &vertex : p_navigation_mesh->get_vertices()) {
+			if (has_extent) {
+				extent.expand_to(Vector2(vertex.x, vertex.z));
+			} else {
+				extent = Rect2(vertex.x, vertex.z, 0.0, 0.0);
+				has_extent = true;
+			}
+		}
+		const Rect2 aabb_area(p_aabb.position.x, p_aabb.position.z, p_aabb.size.x, p_aabb.size.z);
+		if (!has_extent || !extent.intersects(aabb_area, true)) {
+			return nullptr;
+		}
+		area = extent.intersection(aabb_area);
+	} else {
+		if (!has_bounds) {
+			return nullptr;
+		}
+		area = Rect2(bounds.position.x, bounds.position.z, bounds.size.x, bounds.size.z);
+	}
+
+	const int tile_cells = MAX(1, (int)Math::ceil(p_navigation_mesh->get_tile_size() / cfg.cs));
+	// Like the Recast tile samples, the heightfield of a tile includes enough of its neighbors for
+	// the erosion by the agent radius and the region partitioning to match along the tile edges.
+	const int border_cells = cfg.walkableRadius + 3;
+	const float border_size = border_cells * cfg.cs;
+
+	NavMeshTiledBake3D *tiled_bake = memnew(NavMeshTiledBake3D);
+	tiled_bake->navigation_mesh = p_navigation_mesh;
+	tiled_bake->source_geometry_data = p_source_geometry_data;
+	tiled_bake->tile_world_size = tile_cells * cfg.cs;
+	tiled_bake->tile_min = tiled_bake->get_tile_coords(Vector3(area.position.x, 0.0, area.position.y));
+	tiled_bake->tile_max = tiled_bake->get_tile_coords(Vector3(area.position.x + area.size.x, 0.0, area.position.y + area.size.y));
+	tiled_bake->partial = p_partial;
+
+	const int max_threads = GLOBAL_GET("navigation/baking/thread_model/baking_max_threads");
+	tiled_bake->max_threads = max_threads > 0 ? max_threads : -1;
+
+	const int tile_columns = tiled_bake->tile_max.x - tiled_bake->tile_min.x + 1;
+	const int tile_rows = tiled_bake->tile_max.y - tiled_bake->tile_min.y + 1;
+	tiled_bake->tiles.resize(tile_columns * tile_rows);
+	tiled_bake->tiles_remaining.set(tiled_bake->tiles.size());
+
+	LocalVector<bool> tile_has_bounds;
+	tile_has_bounds.resize(tiled_bake->tiles.size());
+	for (int z = 0; z < tile_rows; z++) {
+		for (int x = 0; x < tile_columns; x++) {
+			const uint32_t tile_index = z * tile_columns + x;
+			NavMeshTiledBake3D::Tile &tile = tiled_bake->tiles[tile_index];
+			tile.config = cfg;
+			tile_has_bounds[tile_index] = false;
+			if (!has_bounds) {
+				continue;
+			}
+
+			const float tile_begin_x = MAX((tiled_bake->tile_min.x + x) * tiled_bake->tile_world_size, (float)bounds.position.x);
+			const float tile_begin_z = MAX((tiled_bake->tile_min.y + z) * tiled_bake->tile_world_size, (float)bounds.position.z);
+			const float tile_end_x = MIN((tiled_bake->tile_min.x + x + 1) * tiled_bake->tile_world_size, (float)(bounds.position.x + bounds.size.x));
+			const float tile_end_z = MIN((tiled_bake->tile_min.y + z + 1) * tiled_bake->tile_world_size, (float)(bounds.position.z + bounds.size.z));
+			if (tile_begin_x >= tile_end_x || tile_begin_z >= tile_end_z) {
+				continue;
+			}
+			tile_has_bounds[tile_index] = true;
+
+			tile.config.borderSize = border_cells;
+			tile.config.bmin[0] = tile_begin_x - border_size;
+			tile.config.bmin[1] = bounds.position.y;
+			tile.config.bmin[2] = tile_begin_z - border_size;
+			tile.config.bmax[0] = tile_end_x + border_size;
+			tile.config.bmax[1] = bounds.position.y + bounds.size.y;
+			tile.config.bmax[2] = tile_end_z + border_size;
+		}
+	}
+
+	if (has_geometry && has_bounds) {
+		const float *verts = vertices.ptr();
+		const int *tris = indices.ptr();
+		const int ntris = indices.size() / 3;
+		for (int i = 0; i < ntris; i++) {
+			const float *v0 = &verts[tris[i * 3 + 0] * 3];
+			const float *v1 = &verts[tris[i * 3 + 1] * 3];
+			const float *v2 = &verts[tris[i * 3 + 2] * 3];
+			const Vector2i begin = tiled_bake->get_tile_coords(Vector3(MIN(MIN(v0[0], v1[0]), v2[0]) - border_size, 0.0, MIN(MIN(v0[2], v1[2]), v2[2]) - border_size));
+			const Vector2i end = tiled_bake->get_tile_coords(Vector3(MAX(MAX(v0[0], v1[0]), v2[0]) + border_size, 0.0, MAX(MAX(v0[2], v1[2]), v2[2]) + border_size));
+			for (int z = MAX(begin.y, tiled_bake->tile_min.y); z <= MIN(end.y, tiled_bake->tile_max.y); z++) {
+				for (int x = MAX(begin.x, tiled_bake->tile_min.x); x <= MIN(end.x, tiled_bake->tile_max.x); x++) {
+					const uint32_t tile_index = (z - tiled_bake->tile_min.y) * tile_columns + (x - tiled_bake->tile_min.x);
+					if (tile_has_bounds[tile_index]) {
+						tiled_bake->tiles[tile_index].triangles.push_back(i);
+					}
+				}
+			}
+		}
+	}
+
+	return tiled_bake;
+}
+
+void NavMeshGenerator3D::generator_thread_bake_tile(void *p_arg, uint32_t p_index) {
+	NavMeshTiledBake3D *tiled_bake = static_cast<NavMeshTiledBake3D *>(p_arg);
+	NavMeshTiledBake3D::Tile &tile = tiled_bake->tiles[p_index];
+
+	if (!tile.triangles.is_empty()) {
+		const Vector<float> &vertices = tiled_bake->source_geometry_data->get_vertices();
+		const int *indices = tiled_bake->source_geometry_data->get_indices().ptr();
+
+		LocalVector<int> tile_indices;
+		tile_indices.resize(tile.triangles.size() * 3);
+		for (uint32_t i = 0; i < tile.triangles.size(); i++) {
+			const int *triangle = &indices[tile.triangles[i] * 3];
+			tile_indices[i * 3 + 0] = triangle[0];
+			tile_indices[i * 3 + 1] = triangle[1];
+			tile_indices[i * 3 + 2] = triangle[2];
+		}
+
+		generator_bake_heightfield(tiled_bake->navigation_mesh, tiled_bake->source_geometry_data, tile.config, vertices.ptr(), vertices.size() / 3, tile_indices.ptr(), tile.triangles.size(), tile.vertices, tile.polygons);
+	}
+
+	// The last tile to finish puts them all together.
+	if (tiled_bake->tiles_remaining.decrement() == 0) {
+		generator_stitch_tiles(tiled_bake);
+	}
+}
+
+void NavMeshGenerator3D::generator_bake_tiles(NavMeshTiledBake3D *p_tiled_bake) {
+	// A pool thread waiting for a group task could starve the pool, the tiles are baked in sequence there.
+	if (use_threads && p_tiled_bake->tiles.size() > 1 && WorkerThreadPool::get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_thread_bake_tile, p_tiled_bake, p_tiled_bake->tiles.size(), p_tiled_bake->max_threads, baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < p_tiled_bake->tiles.size(); i++) {
+			generator_thread_bake_tile(p_tiled_bake, i);
+		}
+	}
+}
+
+void NavMeshGenerator3D::generator_bake_tiles_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_aabb, bool p_partial, const Callable &p_callback) {
+	NavMeshTiledBake3D *tiled_bake = generator_create_tiled_bake(p_navigation_mesh, p_source_geometry_data, p_aabb, p_partial);
+	if (!tiled_bake) {
+		baking_navmesh_mutex.lock();
+		baking_navmeshes.erase(p_navigation_mesh);
+		baking_navmesh_mutex.unlock();
+		if (p_callback.is_valid()) {
+			generator_emit_callback(p_callback);
+		}
+		return;
+	}
+
+	generator_task_mutex.lock();
+	NavMeshGeneratorTask3D *generator_task = memnew(NavMeshGeneratorTask3D);
+	generator_task->navigation_mesh = p_navigation_mesh;
+	generator_task->source_geometry_data = p_source_geometry_data;
+	generator_task->callback = p_callback;
+	generator_task->status = NavMeshGeneratorTask3D::TaskStatus::BAKING_STARTED;
+	generator_task->tiled_bake = tiled_bake;
+	generator_task->thread_group_id = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_thread_bake_tile, tiled_bake, tiled_bake->tiles.size(), tiled_bake->max_threads, NavMeshGenerator3D::baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles3D"));
+	generator_tiled_tasks.insert(generator_task->thread_group_id, generator_task);
+	generator_task_mutex.unlock();
+}
+
+void NavMeshGenerator3D::generator_stitch_tiles(NavMeshTiledBake3D *p_tiled_bake) {
+	Ref<NavigationMesh> navigation_mesh = p_tiled_bake->navigation_mesh;
+
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+
+	if (p_tiled_bake->partial) {
+		// Keep the polygons of the other tiles. Polygons don't cross the tile edges,
+		// so each of them belongs to the tile that contains its center.
+		const Vector<Vector3> vertices = navigation_mesh->get_vertices();
+		LocalVector<int> vertex_remap;
+		vertex_remap.resize(vertices.size());
+		for (int &index : vertex_remap) {
+			index = -1;
+		}
+
+		for (int i = 0; i < navigation_mesh->get_polygon_count(); i++) {
+			Vector<int> polygon = navigation_mesh->get_polygon(i);
+			if (polygon.is_empty()) {
+				continue;
+			}
+
+			Vector3 center;
+			bool valid = true;
+			for (int index : polygon) {
+				if (index < 0 || index >= vertices.size()) {
+					valid = false;
+					break;
+				}
+				center += vertices[index];
+			}
+			if (!valid || p_tiled_bake->has_tile(p_tiled_bake->get_tile_coords(center / polygon.size()))) {
+				continue;
+			}
+
+			int *indices = polygon.ptrw();
+			for (int j = 0; j < polygon.size(); j++) {
+				if (vertex_remap[indices[j]] == -1) {
+					vertex_remap[indices[j]] = nav_vertices.size();
+					nav_vertices.push_back(vertices[indices[j]]);
+				}
+				indices[j] = vertex_remap[indices[j]];
+			}
+			nav_polygons.push_back(polygon);
+		}
+	}
+
+	for (NavMeshTiledBake3D::Tile &tile : p_tiled_bake->tiles) {
+		const int vertex_offset = nav_vertices.size();
+		nav_vertices.append_array(tile.vertices);
+		for (Vector<int> &polygon : tile.polygons) {
+			int *indices = polygon.ptrw();
+			for (int i = 0; i < polygon.size(); i++) {
+				indices[i] += vertex_offset;
+			}
+			nav_polygons.push_back(polygon);
+		}
+		tile.vertices.clear();
+		tile.polygons.clear();
+	}
+
+	navigation_mesh->set_vertices(nav_vertices);
+	navigation_mesh->clear_polygons();
+	for (const Vector<int> &nav_polygon : nav_polygons) {
+		navigation_mesh->add_polygon(nav_polygon);
+	}
 }
 
 bool NavMeshGenerator3D::generator_emit_callback(const Callable &p_callback) {
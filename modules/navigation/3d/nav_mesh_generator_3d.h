@@ -41,6 +41,7 @@
 class Node;
 class NavigationMesh;
 class NavigationMeshSourceGeometryData3D;
+struct rcConfig;
 
 class NavMeshGenerator3D : public Object {
 	static NavMeshGenerator3D *singleton;
@@ -60,6 +61,8 @@ class NavMeshGenerator3D : public Object {
 	static bool baking_use_multiple_threads;
 	static bool baking_use_high_priority_threads;
 
+	struct NavMeshTiledBake3D;
+
 	struct NavMeshGeneratorTask3D {
 		enum TaskStatus {
 			BAKING_STARTED,
@@ -73,18 +76,29 @@ class NavMeshGenerator3D : public Object {
 		Ref<NavigationMeshSourceGeometryData3D> source_geometry_data;
 		Callable callback;
 		WorkerThreadPool::TaskID thread_task_id = WorkerThreadPool::INVALID_TASK_ID;
+		NavMeshTiledBake3D *tiled_bake = nullptr;
+		WorkerThreadPool::GroupID thread_group_id = -1;
 		NavMeshGeneratorTask3D::TaskStatus status = NavMeshGeneratorTask3D::TaskStatus::BAKING_STARTED;
 	};
 
 	static HashMap<WorkerThreadPool::TaskID, NavMeshGeneratorTask3D *> generator_tasks;
+	static HashMap<WorkerThreadPool::GroupID, NavMeshGeneratorTask3D *> generator_tiled_tasks;
 
 	static void generator_thread_bake(void *p_arg);
+	static void generator_thread_bake_tile(void *p_arg, uint32_t p_index);
 
 	static HashSet<Ref<NavigationMesh>> baking_navmeshes;
 
 	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
 	static void generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node);
 	static void generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data);
+	static void generator_get_bake_config(const Ref<NavigationMesh> &p_navigation_mesh, rcConfig &r_config);
+	static bool generator_bake_heightfield(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, rcConfig &p_config, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
+
+	static NavMeshTiledBake3D *generator_create_tiled_bake(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_aabb, bool p_partial);
+	static void generator_bake_tiles(NavMeshTiledBake3D *p_tiled_bake);
+	static void generator_bake_tiles_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_aabb, bool p_partial, const Callable &p_callback);
+	static void generator_stitch_tiles(NavMeshTiledBake3D *p_tiled_bake);
 
 	static void generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
 	static void generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
@@ -109,6 +123,8 @@ public:
 	static void parse_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
+	static void bake_tiles_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback = Callable());
+	static void bake_tiles_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback = Callable());
 	static bool is_baking(Ref<NavigationMesh> p_navigation_mesh);
 
 	static RID source_geometry_parser_create();
@@ -54,6 +54,150 @@
 		r_path_owners->push_back(poly->owner->get_owner_id()); \
 	}
 
+// Search state of NavMap::get_path(), indexed by polygon id. It is kept per thread, so queries
+// can run in parallel and repeated queries don't allocate once it has grown to the map size.
+// Entries reached by older queries are recognized by their query id and don't need clearing.
+struct NavMapPathQueryState {
+	LocalVector<gd::NavigationPoly> navigation_polys;
+	gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostLessThan, gd::NavPolyHeapIndexer> traversable_polys;
+	uint32_t query_id = 0;
+
+	void begin(uint32_t p_polygon_count) {
+		// The heap can still point into the polys left from the last query, clear it before they move.
+		traversable_polys.clear();
+		if (navigation_polys.size() < p_polygon_count) {
+			navigation_polys.resize(p_polygon_count);
+		}
+		query_id++;
+		if (query_id == 0) {
+			// Wrapped around, entries from the oldest queries could look current.
+			for (gd::NavigationPoly &navigation_poly : navigation_polys) {
+				navigation_poly.query_id = 0;
+			}
+			query_id = 1;
+		}
+	}
+
+	_FORCE_INLINE_ gd::NavigationPoly *get(const gd::Polygon *p_poly) {
+		gd::NavigationPoly *navigation_poly = &navigation_polys[p_poly->id];
+		return navigation_poly->query_id == query_id ? navigation_poly : nullptr;
+	}
+
+	_FORCE_INLINE_ gd::NavigationPoly *reach(const gd::Polygon *p_poly) {
+		gd::NavigationPoly *navigation_poly = &navigation_polys[p_poly->id];
+		*navigation_poly = gd::NavigationPoly(p_poly);
+		navigation_poly->self_id = p_poly->id;
+		navigation_poly->query_id = query_id;
+		return navigation_poly;
+	}
+};
+
+static thread_local NavMapPathQueryState path_query_state;
+
+// Clusters are small enough for the distances between their portals to be cheap to compute.
+static const uint32_t CLUSTER_MAX_POLYGONS = 64;
+
+// Search state of the portal graph in NavMap::_find_cluster_corridor(), indexed by portal node id.
+// The goal node comes after the portals. Like the polygon search state it is kept per thread.
+struct NavMap::ClusterQueryState {
+	struct Node {
+		uint32_t query_id = 0;
+		uint32_t heap_index = UINT32_MAX;
+		int back_node = -1;
+		const PolygonCluster *cluster = nullptr;
+		uint32_t portal = 0;
+		real_t traveled_distance = 0.0;
+		real_t distance_to_destination = 0.0;
+	};
+
+	struct NodeTravelCostLessThan {
+		_FORCE_INLINE_ bool operator()(const Node *p_node_a, const Node *p_node_b) const {
+			return p_node_a->traveled_distance + p_node_a->distance_to_destination < p_node_b->traveled_distance + p_node_b->distance_to_destination;
+		}
+	};
+
+	struct NodeHeapIndexer {
+		_FORCE_INLINE_ void operator()(Node *p_node, uint32_t p_heap_index) const {
+			p_node->heap_index = p_heap_index;
+		}
+	};
+
+	LocalVector<Node> nodes;
+	gd::Heap<Node *, NodeTravelCostLessThan, NodeHeapIndexer> open_nodes;
+	/// Query id of the last corridor each cluster was part of, by cluster id.
+	LocalVector<uint32_t> corridor_marks;
+	uint32_t query_id = 0;
+
+	void begin(uint32_t p_node_count, uint32_t p_cluster_count) {
+		open_nodes.clear();
+		if (nodes.size() < p_node_count) {
+			nodes.resize(p_node_count);
+		}
+		while (corridor_marks.size() < p_cluster_count) {
+			corridor_marks.push_back(0);
+		}
+		query_id++;
+		if (query_id == 0) {
+			for (Node &node : nodes) {
+				node.query_id = 0;
+			}
+			for (uint32_t &corridor_mark : corridor_marks) {
+				corridor_mark = 0;
+			}
+			query_id = 1;
+		}
+	}
+
+	_FORCE_INLINE_ Node *get(uint32_t p_node_id) {
+		Node *node = &nodes[p_node_id];
+		return node->query_id == query_id ? node : nullptr;
+	}
+
+	_FORCE_INLINE_ Node *reach(uint32_t p_node_id) {
+		Node *node = &nodes[p_node_id];
+		*node = Node();
+		node->query_id = query_id;
+		return node;
+	}
+
+	/// Reaches a node, or lowers its cost when it is cheaper to reach from the given one.
+	/// The node without cluster is the end polygon.
+	void relax(uint32_t p_node_id, const PolygonCluster *p_cluster, uint32_t p_portal, int p_back_node, real_t p_traveled_distance, const Vector3 &p_end_point) {
+		Node *node = get(p_node_id);
+		if (node) {
+			if (p_traveled_distance < node->traveled_distance) {
+				node->traveled_distance = p_traveled_distance;
+				node->back_node = p_back_node;
+				// Nodes which were already visited aren't visited again.
+				if (node->heap_index != UINT32_MAX) {
+					open_nodes.shift(node->heap_index);
+				}
+			}
+			return;
+		}
+
+		node = reach(p_node_id);
+		node->cluster = p_cluster;
+		node->portal = p_portal;
+		node->back_node = p_back_node;
+		node->traveled_distance = p_traveled_distance;
+		if (p_cluster) {
+			node->distance_to_destination = p_cluster->portals[p_portal].position.distance_to(p_end_point) * p_cluster->owner->region->get_travel_cost();
+		}
+		open_nodes.push(node);
+	}
+
+	_FORCE_INLINE_ void mark_corridor(const PolygonCluster *p_cluster) {
+		corridor_marks[p_cluster->id] = query_id;
+	}
+
+	_FORCE_INLINE_ bool is_in_corridor(const PolygonCluster *p_cluster) const {
+		return corridor_marks[p_cluster->id] == query_id;
+	}
+};
+
+thread_local NavMap::ClusterQueryState NavMap::cluster_query_state;
+
 #ifdef DEBUG_ENABLED
 #define NAVMAP_ITERATION_ZERO_ERROR_MSG() \
 	ERR_PRINT_ONCE("NavigationServer navigation map query failed because it was made before first map synchronization.\n\
@@ -103,7 +247,7 @@ void NavMap::set_use_edge_connections(bool p_enabled) {
 		return;
 	}
 	use_edge_connections = p_enabled;
-	regenerate_links = true;
+	regenerate_connections = true;
 }
 
 void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
@@ -111,7 +255,7 @@ void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
 		return;
 	}
 	edge_connection_margin = p_edge_connection_margin;
-	regenerate_links = true;
+	regenerate_connections = true;
 }
 
 void NavMap::set_link_connection_radius(real_t p_link_connection_radius) {
@@ -122,6 +266,15 @@ void NavMap::set_link_connection_radius(real_t p_link_connection_radius) {
 	regenerate_links = true;
 }
 
+void NavMap::set_use_hierarchical_pathfinding(bool p_enabled) {
+	if (use_hierarchical_pathfinding == p_enabled) {
+		return;
+	}
+	use_hierarchical_pathfinding = p_enabled;
+	// The clusters are built with the region polygons.
+	regenerate_polygons = true;
+}
+
 gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	const int x = static_cast<int>(Math::floor(p_pos.x / merge_rasterizer_cell_size));
 	const int y = static_cast<int>(Math::floor(p_pos.y / merge_rasterizer_cell_height));
@@ -154,40 +307,14 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	}
 
 	// Find the start poly and the end poly on this map.
-	const gd::Polygon *begin_poly = nullptr;
-	const gd::Polygon *end_poly = nullptr;
-	Vector3 begin_point;
-	Vector3 end_point;
-	real_t begin_d = FLT_MAX;
-	real_t end_d = FLT_MAX;
-	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
-
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
+	const NavPolygonBVH::ClosestPolygonResult begin_result = polygon_bvh.get_closest_polygon_in_layers(p_origin, p_navigation_layers);
+	const NavPolygonBVH::ClosestPolygonResult end_result = polygon_bvh.get_closest_polygon_in_layers(p_destination, p_navigation_layers);
 
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
-	}
+	const gd::Polygon *begin_poly = begin_result.polygon;
+	const gd::Polygon *end_poly = end_result.polygon;
+	Vector3 begin_point = begin_result.point;
+	Vector3 end_point = end_result.point;
+	real_t end_d = FLT_MAX;
 
 	// Check for trivial cases
 	if (!begin_poly || !end_poly) {
@@ -219,24 +346,24 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
-	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.reserve(polygons.size() * 0.75);
+	// Long paths are first searched from cluster to cluster, the polygon search then only
+	// visits the clusters on the way.
+	bool use_corridor = _find_cluster_corridor(begin_poly, end_poly, end_point, p_navigation_layers);
+	const ClusterQueryState &cluster_query = cluster_query_state;
 
-	// Add the start polygon to the reachable navigation polygons.
-	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
-	begin_navigation_poly.self_id = 0;
-	begin_navigation_poly.entry = begin_point;
-	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
-	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
-	navigation_polys.push_back(begin_navigation_poly);
+	// The search state is indexed by polygon id, so reached polygons are found without searching.
+	NavMapPathQueryState &query = path_query_state;
+	query.begin(polygons.size() + link_polygons.size());
+	LocalVector<gd::NavigationPoly> &navigation_polys = query.navigation_polys;
 
-	// List of polygon IDs to visit.
-	List<uint32_t> to_visit;
-	to_visit.push_back(0);
+	// Add the start polygon to the reachable navigation polygons.
+	gd::NavigationPoly *begin_navigation_poly = query.reach(begin_poly);
+	begin_navigation_poly->entry = begin_point;
+	begin_navigation_poly->back_navigation_edge_pathway_start = begin_point;
+	begin_navigation_poly->back_navigation_edge_pathway_end = begin_point;
 
 	// This is an implementation of the A* algorithm.
-	int least_cost_id = 0;
+	int least_cost_id = begin_poly->id;
 	int prev_least_cost_id = -1;
 	bool found_route = false;
 
@@ -256,6 +383,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					continue;
 				}
 
+				// Link polygons are not part of the clusters, they are left out of the corridor check.
+				if (use_corridor && connection.polygon->id < polygon_cluster_slots.size() && !cluster_query.is_in_corridor(polygon_cluster_slots[connection.polygon->id].cluster)) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -269,11 +401,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(least_cost_poly.entry, pathway);
 				const real_t new_distance = (least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost) + poly_enter_cost + least_cost_poly.traveled_distance;
 
-				int64_t already_visited_polygon_index = navigation_polys.find(gd::NavigationPoly(connection.polygon));
+				gd::NavigationPoly *already_visited_poly = query.get(connection.polygon);
 
-				if (already_visited_polygon_index != -1) {
+				if (already_visited_poly) {
 					// Polygon already visited, check if we can reduce the travel cost.
-					gd::NavigationPoly &avp = navigation_polys[already_visited_polygon_index];
+					gd::NavigationPoly &avp = *already_visited_poly;
 					if (new_distance < avp.traveled_distance) {
 						avp.back_navigation_poly_id = least_cost_id;
 						avp.back_navigation_edge = connection.edge;
@@ -281,30 +413,50 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 						avp.back_navigation_edge_pathway_end = connection.pathway_end;
 						avp.traveled_distance = new_distance;
 						avp.entry = new_entry;
+						avp.distance_to_destination = new_entry.distance_to(end_point) * avp.poly->owner->get_travel_cost();
+
+						// Polygons which were already visited aren't visited again.
+						if (avp.traversable_poly_index != UINT32_MAX) {
+							query.traversable_polys.shift(avp.traversable_poly_index);
+						}
 					}
 				} else {
 					// Add the neighbor polygon to the reachable ones.
-					gd::NavigationPoly new_navigation_poly = gd::NavigationPoly(connection.polygon);
-					new_navigation_poly.self_id = navigation_polys.size();
-					new_navigation_poly.back_navigation_poly_id = least_cost_id;
-					new_navigation_poly.back_navigation_edge = connection.edge;
-					new_navigation_poly.back_navigation_edge_pathway_start = connection.pathway_start;
-					new_navigation_poly.back_navigation_edge_pathway_end = connection.pathway_end;
-					new_navigation_poly.traveled_distance = new_distance;
-					new_navigation_poly.entry = new_entry;
-					navigation_polys.push_back(new_navigation_poly);
+					gd::NavigationPoly *new_navigation_poly = query.reach(connection.polygon);
+					new_navigation_poly->back_navigation_poly_id = least_cost_id;
+					new_navigation_poly->back_navigation_edge = connection.edge;
+					new_navigation_poly->back_navigation_edge_pathway_start = connection.pathway_start;
+					new_navigation_poly->back_navigation_edge_pathway_end = connection.pathway_end;
+					new_navigation_poly->traveled_distance = new_distance;
+					new_navigation_poly->entry = new_entry;
+					new_navigation_poly->distance_to_destination = new_entry.distance_to(end_point) * connection.polygon->owner->get_travel_cost();
 
 					// Add the neighbor polygon to the polygons to visit.
-					to_visit.push_back(navigation_polys.size() - 1);
+					query.traversable_polys.push(new_navigation_poly);
 				}
 			}
 		}
 
-		// Removes the least cost polygon from the list of polygons to visit so we can advance.
-		to_visit.erase(least_cost_id);
-
 		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
-		if (to_visit.size() == 0) {
+		if (query.traversable_polys.is_empty()) {
+			if (use_corridor) {
+				// The portal distances only approximate the paths through the clusters, so the corridor
+				// may not lead to the end polygon. Search the whole map instead.
+				use_corridor = false;
+				query.begin(polygons.size() + link_polygons.size());
+				begin_navigation_poly = query.reach(begin_poly);
+				begin_navigation_poly->entry = begin_point;
+				begin_navigation_poly->back_navigation_edge_pathway_start = begin_point;
+				begin_navigation_poly->back_navigation_edge_pathway_end = begin_point;
+				least_cost_id = begin_poly->id;
+				prev_least_cost_id = -1;
+
+				reachable_end = nullptr;
+				reachable_d = FLT_MAX;
+
+				continue;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -366,13 +518,13 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				return path;
 			}
 
-			// Reset open and navigation_polys
-			gd::NavigationPoly np = navigation_polys[0];
-			navigation_polys.clear();
-			navigation_polys.push_back(np);
-			to_visit.clear();
-			to_visit.push_back(0);
-			least_cost_id = 0;
+			// Reset the search, keeping only the start polygon.
+			query.begin(polygons.size() + link_polygons.size());
+			begin_navigation_poly = query.reach(begin_poly);
+			begin_navigation_poly->entry = begin_point;
+			begin_navigation_poly->back_navigation_edge_pathway_start = begin_point;
+			begin_navigation_poly->back_navigation_edge_pathway_end = begin_point;
+			least_cost_id = begin_poly->id;
 			prev_least_cost_id = -1;
 
 			reachable_end = nullptr;
@@ -380,20 +532,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			continue;
 		}
 
-		// Find the polygon with the minimum cost from the list of polygons to visit.
-		least_cost_id = -1;
-		real_t least_cost = FLT_MAX;
-		for (List<uint32_t>::Element *element = to_visit.front(); element != nullptr; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
-			real_t cost = np->traveled_distance;
-			cost += (np->entry.distance_to(end_point) * np->poly->owner->get_travel_cost());
-			if (cost < least_cost) {
-				least_cost_id = np->self_id;
-				least_cost = cost;
-			}
-		}
-
-		ERR_BREAK(least_cost_id == -1);
+		// Take the polygon with the minimum cost from the polygons to visit.
+		least_cost_id = query.traversable_polys.pop()->self_id;
 
 		// Stores the further reachable end polygon, in case our goal is not reachable.
 		if (is_reachable) {
@@ -607,47 +747,14 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 		return Vector3();
 	}
 
-	bool use_collision = p_use_collision;
 	Vector3 closest_point;
-	real_t closest_point_d = FLT_MAX;
-
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the segment
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 inters;
-			if (f.intersects_segment(p_from, p_to, &inters)) {
-				const real_t d = closest_point_d = p_from.distance_to(inters);
-				if (use_collision == false) {
-					closest_point = inters;
-					use_collision = true;
-					closest_point_d = d;
-				} else if (closest_point_d > d) {
-					closest_point = inters;
-					closest_point_d = d;
-				}
-			}
-		}
-
-		if (use_collision == false) {
-			for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
-				Vector3 a, b;
-
-				Geometry3D::get_closest_points_between_segments(
-						p_from,
-						p_to,
-						p.points[point_id].pos,
-						p.points[(point_id + 1) % p.points.size()].pos,
-						a,
-						b);
+	if (polygon_bvh.intersect_segment(p_from, p_to, closest_point)) {
+		return closest_point;
+	}
 
-				const real_t d = a.distance_to(b);
-				if (d < closest_point_d) {
-					closest_point_d = d;
-					closest_point = b;
-				}
-			}
-		}
+	// Without a collision fall back to the closest point between the segment and the polygon edges.
+	if (!p_use_collision) {
+		polygon_bvh.get_closest_edge_point_to_segment(p_from, p_to, closest_point);
 	}
 
 	return closest_point;
@@ -687,36 +794,33 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 	RWLockRead read_lock(map_rwlock);
 
 	gd::ClosestPointQueryResult result;
-	real_t closest_point_ds = FLT_MAX;
-
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
-			}
-		}
+
+	const NavPolygonBVH::ClosestPolygonResult closest = polygon_bvh.get_closest_polygon(p_point);
+	if (closest.polygon) {
+		result.point = closest.point;
+		result.normal = closest.normal;
+		result.owner = closest.polygon->owner->get_self();
 	}
 
 	return result;
 }
 
 void NavMap::add_region(NavRegion *p_region) {
+	// The region polygons are dirty, it is merged on the next sync.
 	regions.push_back(p_region);
-	regenerate_links = true;
 }
 
 void NavMap::remove_region(NavRegion *p_region) {
 	int64_t region_index = regions.find(p_region);
 	if (region_index >= 0) {
 		regions.remove_at_unordered(region_index);
-		regenerate_links = true;
+	}
+
+	// The region may be freed before the next sync, so its polygons are put aside right away.
+	HashMap<const NavRegion *, RegionPolygons *>::Iterator E = region_polygons.find(p_region);
+	if (E) {
+		removed_region_polygons.push_back(E->value);
+		region_polygons.remove(E);
 	}
 }
 
@@ -892,17 +996,17 @@ void NavMap::sync() {
 	int _new_pm_edge_connection_count = pm_edge_connection_count;
 	int _new_pm_edge_free_count = pm_edge_free_count;
 
-	// Check if we need to update the links.
+	// Check if we need to update the region polygons.
 	if (regenerate_polygons) {
 		for (NavRegion *region : regions) {
 			region->scratch_polygons();
 		}
-		regenerate_links = true;
 	}
 
+	LocalVector<NavRegion *> changed_regions;
 	for (NavRegion *region : regions) {
 		if (region->sync()) {
-			regenerate_links = true;
+			changed_regions.push_back(region);
 		}
 	}
 
@@ -912,107 +1016,337 @@ void NavMap::sync() {
 		}
 	}
 
-	if (regenerate_links) {
-		_new_pm_polygon_count = 0;
-		_new_pm_edge_count = 0;
-		_new_pm_edge_merge_count = 0;
-		_new_pm_edge_connection_count = 0;
-		_new_pm_edge_free_count = 0;
+	if (!changed_regions.is_empty() || !removed_region_polygons.is_empty() || regenerate_connections || regenerate_links) {
+		// Remove the connections entering the links first, the polygons holding them may be freed below.
+		for (gd::Polygon *polygon : link_entry_polygons) {
+			Vector<gd::Edge::Connection> &connections = polygon->edges[0].connections;
+			for (int i = connections.size() - 1; i >= 0; i--) {
+				if (connections[i].edge == -1) {
+					connections.remove_at(i);
+				}
+			}
+		}
+		link_entry_polygons.clear();
+		for (PolygonCluster *cluster : link_portal_clusters) {
+			cluster->portals.resize(cluster->edge_portal_count);
+		}
+		link_portal_clusters.clear();
 
-		// Remove regions connections.
-		for (NavRegion *region : regions) {
+		// Replace the polygons of the changed regions, the unchanged ones are kept as they are.
+		LocalVector<RegionPolygons *> stale_region_polygons = removed_region_polygons;
+		removed_region_polygons.clear();
+		LocalVector<RegionPolygons *> new_region_polygons;
+
+		for (NavRegion *region : changed_regions) {
 			region->get_connections().clear();
-		}
 
-		// Resize the polygon count.
-		int count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
+			HashMap<const NavRegion *, RegionPolygons *>::Iterator E = region_polygons.find(region);
+			if (E) {
+				stale_region_polygons.push_back(E->value);
+				region_polygons.remove(E);
+			}
+
+			if (!region->get_enabled() || region->get_polygons().is_empty()) {
 				continue;
 			}
-			count += region->get_polygons().size();
+			new_region_polygons.push_back(_create_region_polygons(region));
 		}
-		polygons.resize(count);
 
-		// Copy all region polygons in the map.
-		count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
+		const bool polygons_changed = !stale_region_polygons.is_empty() || !new_region_polygons.is_empty();
+
+		// Unchanged regions next to a changed one may gain or lose merged edges and edge connections,
+		// so they are merged and connected again too. The others keep their connections.
+		LocalVector<RegionPolygons *> relinked_region_polygons;
+		if (regenerate_connections) {
+			for (const KeyValue<const NavRegion *, RegionPolygons *> &E : region_polygons) {
+				relinked_region_polygons.push_back(E.value);
+			}
+		} else if (polygons_changed) {
+			LocalVector<AABB> changed_aabbs;
+			const real_t neighbor_margin = _get_region_neighbor_margin();
+			for (const RegionPolygons *stale : stale_region_polygons) {
+				changed_aabbs.push_back(stale->aabb.grow(neighbor_margin));
+			}
+			for (const RegionPolygons *created : new_region_polygons) {
+				changed_aabbs.push_back(created->aabb.grow(neighbor_margin));
 			}
-			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[count + n] = polygons_source[n];
+
+			for (const KeyValue<const NavRegion *, RegionPolygons *> &E : region_polygons) {
+				for (const AABB &changed_aabb : changed_aabbs) {
+					if (changed_aabb.intersects_inclusive(E.value->aabb)) {
+						relinked_region_polygons.push_back(E.value);
+						break;
+					}
+				}
 			}
-			count += region->get_polygons().size();
 		}
 
-		_new_pm_polygon_count = polygons.size();
+		for (RegionPolygons *created : new_region_polygons) {
+			region_polygons.insert(created->region, created);
+			relinked_region_polygons.push_back(created);
+		}
 
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
-
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
-				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
-					_new_pm_edge_count += 1;
+		// Nothing points to the stale polygons anymore once the regions around them are relinked.
+		for (RegionPolygons *stale : stale_region_polygons) {
+			memdelete(stale);
+		}
+
+		if (polygons_changed) {
+			// Polygon ids follow the region order.
+			polygons.clear();
+			polygon_cluster_slots.clear();
+			LocalVector<const NavPolygonBVH *> region_bvhs;
+			for (const NavRegion *region : regions) {
+				HashMap<const NavRegion *, RegionPolygons *>::Iterator E = region_polygons.find(region);
+				if (!E) {
+					continue;
 				}
-				if (connections[ek].size() <= 1) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+				RegionPolygons *region_polys = E->value;
+				for (uint32_t i = 0; i < region_polys->polygons.size(); i++) {
+					gd::Polygon &polygon = region_polys->polygons[i];
+					polygon.id = polygons.size();
+					polygons.push_back(&polygon);
+					if (use_hierarchical_pathfinding) {
+						ClusterSlot cluster_slot;
+						cluster_slot.cluster = &region_polys->clusters[region_polys->polygon_clusters[i]];
+						cluster_slot.slot = region_polys->polygon_slots[i];
+						polygon_cluster_slots.push_back(cluster_slot);
+					}
 				}
+				region_bvhs.push_back(&region_polys->bvh);
+			}
+			polygon_bvh.build(region_bvhs);
+		}
+
+		// All boundary edges have to be merged before connecting the free ones, merging decides which ones are free.
+		LocalVector<LocalVector<RegionPolygons *>> neighbors;
+		neighbors.resize(relinked_region_polygons.size());
+		for (uint32_t i = 0; i < relinked_region_polygons.size(); i++) {
+			_get_neighbor_region_polygons(relinked_region_polygons[i], neighbors[i]);
+			_merge_boundary_edges(relinked_region_polygons[i], neighbors[i]);
+		}
+		for (uint32_t i = 0; i < relinked_region_polygons.size(); i++) {
+			_connect_free_edges(relinked_region_polygons[i], neighbors[i]);
+		}
+		if (use_hierarchical_pathfinding) {
+			for (RegionPolygons *relinked : relinked_region_polygons) {
+				_update_boundary_portals(relinked);
+			}
+		}
+
+		_update_links();
+		_update_cluster_ids();
+
+		_new_pm_polygon_count = polygons.size();
+		_new_pm_edge_count = 0;
+		_new_pm_edge_merge_count = 0;
+		_new_pm_edge_connection_count = 0;
+		_new_pm_edge_free_count = 0;
+		int boundary_merge_count = 0;
+		for (const KeyValue<const NavRegion *, RegionPolygons *> &E : region_polygons) {
+			_new_pm_edge_count += E.value->edge_count;
+			_new_pm_edge_merge_count += E.value->edge_merge_count;
+			_new_pm_edge_connection_count += E.value->edge_connection_count;
+			_new_pm_edge_free_count += E.value->edge_free_count;
+			boundary_merge_count += E.value->boundary_merge_count;
+		}
+		// Edges merged between regions are counted on both sides.
+		_new_pm_edge_count -= boundary_merge_count / 2;
+		_new_pm_edge_merge_count += boundary_merge_count / 2;
+
+		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
+		iteration_id = iteration_id % UINT32_MAX + 1;
+	}
+
+	// Do we have modified obstacle positions?
+	for (NavObstacle *obstacle : obstacles) {
+		if (obstacle->check_dirty()) {
+			obstacles_dirty = true;
+		}
+	}
+	// Do we have modified agent arrays?
+	for (NavAgent *agent : agents) {
+		if (agent->check_dirty()) {
+			agents_dirty = true;
+		}
+	}
+
+	// Update avoidance worlds.
+	if (obstacles_dirty || agents_dirty) {
+		_update_rvo_simulation();
+	}
+
+	regenerate_polygons = false;
+	regenerate_connections = false;
+	regenerate_links = false;
+	obstacles_dirty = false;
+	agents_dirty = false;
+
+	// Performance Monitor.
+	pm_region_count = _new_pm_region_count;
+	pm_agent_count = _new_pm_agent_count;
+	pm_link_count = _new_pm_link_count;
+	pm_polygon_count = _new_pm_polygon_count;
+	pm_edge_count = _new_pm_edge_count;
+	pm_edge_merge_count = _new_pm_edge_merge_count;
+	pm_edge_connection_count = _new_pm_edge_connection_count;
+	pm_edge_free_count = _new_pm_edge_free_count;
+}
+
+real_t NavMap::_get_region_neighbor_margin() const {
+	// Edges are merged when their points share a rasterizer cell and connected when they are closer than the margin.
+	return MAX(edge_connection_margin, MAX(merge_rasterizer_cell_size, merge_rasterizer_cell_height));
+}
+
+NavMap::RegionPolygons *NavMap::_create_region_polygons(NavRegion *p_region) {
+	RegionPolygons *new_region_polygons = memnew(RegionPolygons);
+	new_region_polygons->region = p_region;
+	new_region_polygons->polygons = p_region->get_polygons();
+
+	// Group all edges per key.
+	HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
+	for (gd::Polygon &poly : new_region_polygons->polygons) {
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			int next_point = (p + 1) % poly.points.size();
+			gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
+			if (!connection) {
+				connection = connections.insert(ek, Vector<gd::Edge::Connection>());
+				new_region_polygons->edge_count += 1;
+			}
+			if (connection->value.size() <= 1) {
+				// Add the polygon/edge tuple to this key.
+				gd::Edge::Connection new_connection;
+				new_connection.polygon = &poly;
+				new_connection.edge = p;
+				new_connection.pathway_start = poly.points[p].pos;
+				new_connection.pathway_end = poly.points[next_point].pos;
+				connection->value.push_back(new_connection);
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
 			}
 		}
+	}
+
+	for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
+		if (E.value.size() == 2) {
+			// Connect edge that are shared in different polygons.
+			gd::Edge::Connection &c1 = E.value.write[0];
+			gd::Edge::Connection &c2 = E.value.write[1];
+			c1.polygon->edges[c1.edge].connections.push_back(c2);
+			c2.polygon->edges[c2.edge].connections.push_back(c1);
+			// Note: The pathway_start/end are full for those connection and do not need to be modified.
+			new_region_polygons->edge_merge_count += 1;
+		} else {
+			CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
+			// Merged or connected with other regions in _merge_boundary_edges() and _connect_free_edges().
+			BoundaryEdge boundary_edge;
+			boundary_edge.key = E.key;
+			boundary_edge.connection = E.value[0];
+			new_region_polygons->boundary_edge_indices.insert(E.key, new_region_polygons->boundary_edges.size());
+			new_region_polygons->boundary_edges.push_back(boundary_edge);
+		}
+	}
 
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
-			if (E.value.size() == 2) {
-				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				_new_pm_edge_merge_count += 1;
+	bool first_point = true;
+	for (const gd::Polygon &poly : new_region_polygons->polygons) {
+		for (const gd::Point &point : poly.points) {
+			if (first_point) {
+				new_region_polygons->aabb = AABB(point.pos, Vector3());
+				first_point = false;
 			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				if (use_edge_connections && E.value[0].polygon->owner->get_use_edge_connections()) {
-					free_edges.push_back(E.value[0]);
-				}
+				new_region_polygons->aabb.expand_to(point.pos);
+			}
+		}
+	}
+
+	new_region_polygons->bvh.build(new_region_polygons->polygons);
+
+	if (use_hierarchical_pathfinding) {
+		_create_region_clusters(new_region_polygons);
+	}
+
+	return new_region_polygons;
+}
+
+void NavMap::_get_neighbor_region_polygons(const RegionPolygons *p_region_polygons, LocalVector<RegionPolygons *> &r_neighbors) const {
+	const AABB aabb = p_region_polygons->aabb.grow(_get_region_neighbor_margin());
+	for (const KeyValue<const NavRegion *, RegionPolygons *> &E : region_polygons) {
+		if (E.value != p_region_polygons && aabb.intersects_inclusive(E.value->aabb)) {
+			r_neighbors.push_back(E.value);
+		}
+	}
+}
+
+void NavMap::_merge_boundary_edges(RegionPolygons *p_region_polygons, const LocalVector<RegionPolygons *> &p_neighbors) {
+	p_region_polygons->boundary_merge_count = 0;
+
+	for (BoundaryEdge &boundary_edge : p_region_polygons->boundary_edges) {
+		// Boundary edges only have connections to other regions (and links, which are added back afterwards).
+		gd::Edge &edge = boundary_edge.connection.polygon->edges[boundary_edge.connection.edge];
+		edge.connections.clear();
+		boundary_edge.free = true;
+
+		for (const RegionPolygons *neighbor : p_neighbors) {
+			HashMap<gd::EdgeKey, uint32_t, gd::EdgeKey>::ConstIterator other_edge_index = neighbor->boundary_edge_indices.find(boundary_edge.key);
+			if (!other_edge_index) {
+				continue;
+			}
+			if (!boundary_edge.free) {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+				break;
 			}
+			// The other side pushes the connection to this edge when it is merged.
+			edge.connections.push_back(neighbor->boundary_edges[other_edge_index->value].connection);
+			boundary_edge.free = false;
+			p_region_polygons->boundary_merge_count += 1;
 		}
+	}
+}
 
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		_new_pm_edge_free_count = free_edges.size();
+void NavMap::_connect_free_edges(RegionPolygons *p_region_polygons, const LocalVector<RegionPolygons *> &p_neighbors) {
+	NavRegion *region = p_region_polygons->region;
+	region->get_connections().clear();
+	p_region_polygons->edge_free_count = 0;
+	p_region_polygons->edge_connection_count = 0;
 
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+	if (!use_edge_connections || !region->get_use_edge_connections()) {
+		return;
+	}
+
+	// Find the compatible near edges.
+	//
+	// Note:
+	// Considering that the edges must be compatible (for obvious reasons)
+	// to be connected, create new polygons to remove that small gap is
+	// not really useful and would result in wasteful computation during
+	// connection, integration and path finding.
+	//
+	// Only the connections leaving this region are added here, the neighbors add the ones
+	// going the other way when they are connected.
+	for (const BoundaryEdge &boundary_edge : p_region_polygons->boundary_edges) {
+		if (!boundary_edge.free) {
+			continue;
+		}
+		p_region_polygons->edge_free_count += 1;
 
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
+		const gd::Edge::Connection &free_edge = boundary_edge.connection;
+		Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
+		Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+
+		for (const RegionPolygons *neighbor : p_neighbors) {
+			if (!neighbor->region->get_use_edge_connections()) {
+				continue;
+			}
+
+			for (const BoundaryEdge &other_boundary_edge : neighbor->boundary_edges) {
+				if (!other_boundary_edge.free) {
 					continue;
 				}
+				const gd::Edge::Connection &other_edge = other_boundary_edge.connection;
 
 				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
 				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
@@ -1055,161 +1389,436 @@ void NavMap::sync() {
 				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
 
 				// Add the connection to the region_connection map.
-				((NavRegion *)free_edge.polygon->owner)->get_connections().push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
+				region->get_connections().push_back(new_connection);
+				p_region_polygons->edge_connection_count += 1;
 			}
 		}
+	}
+}
 
-		uint32_t link_poly_idx = 0;
-		link_polygons.resize(links.size());
+void NavMap::_update_links() {
+	// Links are few and cheap to connect, they are all connected again when anything changes.
+	uint32_t link_poly_idx = 0;
+	link_polygons.resize(links.size());
 
-		// Search for polygons within range of a nav link.
-		for (const NavLink *link : links) {
-			if (!link->get_enabled()) {
-				continue;
+	// Search for polygons within range of a nav link.
+	for (const NavLink *link : links) {
+		if (!link->get_enabled()) {
+			continue;
+		}
+		const Vector3 start = link->get_start_position();
+		const Vector3 end = link->get_end_position();
+
+		// Find the closest polygons within the search radius of the start and end points.
+		const NavPolygonBVH::ClosestPolygonResult closest_start = polygon_bvh.get_closest_polygon(start, link_connection_radius);
+		const NavPolygonBVH::ClosestPolygonResult closest_end = polygon_bvh.get_closest_polygon(end, link_connection_radius);
+
+		gd::Polygon *closest_start_polygon = closest_start.polygon ? polygons[closest_start.polygon_index] : nullptr;
+		const Vector3 closest_start_point = closest_start.point;
+
+		gd::Polygon *closest_end_polygon = closest_end.polygon ? polygons[closest_end.polygon_index] : nullptr;
+		const Vector3 closest_end_point = closest_end.point;
+
+		// If we have both a start and end point, then create a synthetic polygon to route through.
+		if (closest_start_polygon && closest_end_polygon) {
+			gd::Polygon &new_polygon = link_polygons[link_poly_idx];
+			new_polygon.id = polygons.size() + link_poly_idx;
+			new_polygon.owner = link;
+			link_poly_idx++;
+
+			new_polygon.edges.clear();
+			new_polygon.edges.resize(4);
+			new_polygon.points.clear();
+			new_polygon.points.reserve(4);
+
+			// Build a set of vertices that create a thin polygon going from the start to the end point.
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+
+			Vector3 center;
+			for (int p = 0; p < 4; ++p) {
+				center += new_polygon.points[p].pos;
 			}
-			const Vector3 start = link->get_start_position();
-			const Vector3 end = link->get_end_position();
-
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
-			Vector3 closest_start_point;
-
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
-			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
+			new_polygon.center = center / real_t(new_polygon.points.size());
+			new_polygon.clockwise = true;
+
+			// Setup connections to go forward in the link.
+			{
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[0].pos;
+				entry_connection.pathway_end = new_polygon.points[1].pos;
+				closest_start_polygon->edges[0].connections.push_back(entry_connection);
+				link_entry_polygons.push_back(closest_start_polygon);
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_end_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[2].pos;
+				exit_connection.pathway_end = new_polygon.points[3].pos;
+				new_polygon.edges[2].connections.push_back(exit_connection);
+			}
+
+			// If the link is bi-directional, create connections from the end to the start.
+			if (link->is_bidirectional()) {
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[2].pos;
+				entry_connection.pathway_end = new_polygon.points[3].pos;
+				closest_end_polygon->edges[0].connections.push_back(entry_connection);
+				link_entry_polygons.push_back(closest_end_polygon);
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_start_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[0].pos;
+				exit_connection.pathway_end = new_polygon.points[1].pos;
+				new_polygon.edges[0].connections.push_back(exit_connection);
+			}
+
+			// The link also joins the clusters at its ends, unless it stays in the same one.
+			if (!polygon_cluster_slots.is_empty()) {
+				const ClusterSlot &start_slot = polygon_cluster_slots[closest_start_polygon->id];
+				const ClusterSlot &end_slot = polygon_cluster_slots[closest_end_polygon->id];
+				if (start_slot.cluster != end_slot.cluster) {
+					ClusterPortal start_portal;
+					start_portal.target = end_slot.cluster;
+					start_portal.link = link;
+					start_portal.link_departure = true;
+					start_portal.position = closest_start_point;
+					start_portal.slot = start_slot.slot;
+					_compute_portal_distances(*start_slot.cluster, start_portal);
+					start_slot.cluster->portals.push_back(start_portal);
+					link_portal_clusters.push_back(start_slot.cluster);
+
+					ClusterPortal end_portal;
+					end_portal.target = start_slot.cluster;
+					end_portal.link = link;
+					end_portal.link_departure = link->is_bidirectional();
+					end_portal.position = closest_end_point;
+					end_portal.slot = end_slot.slot;
+					_compute_portal_distances(*end_slot.cluster, end_portal);
+					end_slot.cluster->portals.push_back(end_portal);
+					link_portal_clusters.push_back(end_slot.cluster);
 				}
 			}
+		}
+	}
 
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
+	// Drop the polygons of disabled or unconnected links, nothing points to them anymore.
+	link_polygons.resize(link_poly_idx);
+}
+
+void NavMap::_create_region_clusters(RegionPolygons *p_region_polygons) {
+	LocalVector<gd::Polygon> &region_polys = p_region_polygons->polygons;
+	LocalVector<PolygonCluster> &clusters = p_region_polygons->clusters;
+	LocalVector<uint32_t> &polygon_clusters = p_region_polygons->polygon_clusters;
+	LocalVector<uint32_t> &polygon_slots = p_region_polygons->polygon_slots;
+	const uint32_t polygon_count = region_polys.size();
+
+	polygon_clusters.resize(polygon_count);
+	polygon_slots.resize(polygon_count);
+	for (uint32_t &cluster_index : polygon_clusters) {
+		cluster_index = UINT32_MAX;
+	}
+
+	// Grow each cluster breadth first from the first polygon left, this keeps them compact.
+	// Only the polygons of the region are connected at this point.
+	LocalVector<uint32_t> open;
+	for (uint32_t seed = 0; seed < polygon_count; seed++) {
+		if (polygon_clusters[seed] != UINT32_MAX) {
+			continue;
+		}
+		const uint32_t cluster_index = clusters.size();
+		clusters.push_back(PolygonCluster());
+		PolygonCluster &cluster = clusters[cluster_index];
+		cluster.index = cluster_index;
+		cluster.owner = p_region_polygons;
+
+		open.clear();
+		open.push_back(seed);
+		polygon_clusters[seed] = cluster_index;
+		uint32_t next = 0;
+		while (next < open.size() && cluster.polygons.size() < CLUSTER_MAX_POLYGONS) {
+			const uint32_t polygon_index = open[next++];
+			polygon_slots[polygon_index] = cluster.polygons.size();
+			cluster.polygons.push_back(&region_polys[polygon_index]);
+
+			for (const gd::Edge &edge : region_polys[polygon_index].edges) {
+				for (const gd::Edge::Connection &connection : edge.connections) {
+					const uint32_t other_index = connection.polygon - region_polys.ptr();
+					if (polygon_clusters[other_index] == UINT32_MAX) {
+						polygon_clusters[other_index] = cluster_index;
+						open.push_back(other_index);
 					}
 				}
 			}
+		}
+		// The polygons found past the size limit are left to the next clusters.
+		for (; next < open.size(); next++) {
+			polygon_clusters[open[next]] = UINT32_MAX;
+		}
+	}
 
-			// If we have both a start and end point, then create a synthetic polygon to route through.
-			if (closest_start_polygon && closest_end_polygon) {
-				gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
-				new_polygon.owner = link;
-
-				new_polygon.edges.clear();
-				new_polygon.edges.resize(4);
-				new_polygon.points.clear();
-				new_polygon.points.reserve(4);
-
-				// Build a set of vertices that create a thin polygon going from the start to the end point.
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-
-				Vector3 center;
-				for (int p = 0; p < 4; ++p) {
-					center += new_polygon.points[p].pos;
-				}
-				new_polygon.center = center / real_t(new_polygon.points.size());
-				new_polygon.clockwise = true;
-
-				// Setup connections to go forward in the link.
-				{
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[0].pos;
-					entry_connection.pathway_end = new_polygon.points[1].pos;
-					closest_start_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_end_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[2].pos;
-					exit_connection.pathway_end = new_polygon.points[3].pos;
-					new_polygon.edges[2].connections.push_back(exit_connection);
+	// Portals between the clusters of the region, the other ones are added when the region is connected.
+	LocalVector<PortalEdge> portal_edges;
+	for (uint32_t polygon_index = 0; polygon_index < polygon_count; polygon_index++) {
+		const uint32_t cluster_index = polygon_clusters[polygon_index];
+		for (const gd::Edge &edge : region_polys[polygon_index].edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t other_cluster_index = polygon_clusters[connection.polygon - region_polys.ptr()];
+				if (other_cluster_index == cluster_index) {
+					continue;
 				}
+				PortalEdge portal_edge;
+				portal_edge.cluster = cluster_index;
+				portal_edge.target = &clusters[other_cluster_index];
+				portal_edge.position = (connection.pathway_start + connection.pathway_end) * 0.5;
+				portal_edge.slot = polygon_slots[polygon_index];
+				portal_edges.push_back(portal_edge);
+			}
+		}
+	}
+	_add_edge_portals(p_region_polygons, portal_edges);
 
-				// If the link is bi-directional, create connections from the end to the start.
-				if (link->is_bidirectional()) {
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[2].pos;
-					entry_connection.pathway_end = new_polygon.points[3].pos;
-					closest_end_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_start_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[0].pos;
-					exit_connection.pathway_end = new_polygon.points[1].pos;
-					new_polygon.edges[0].connections.push_back(exit_connection);
-				}
+	for (PolygonCluster &cluster : clusters) {
+		cluster.region_portal_count = cluster.portals.size();
+		cluster.edge_portal_count = cluster.portals.size();
+	}
+}
+
+void NavMap::_update_boundary_portals(RegionPolygons *p_region_polygons) {
+	for (PolygonCluster &cluster : p_region_polygons->clusters) {
+		cluster.portals.resize(cluster.region_portal_count);
+	}
+
+	// The boundary edges hold all the connections to other regions.
+	LocalVector<PortalEdge> portal_edges;
+	for (const BoundaryEdge &boundary_edge : p_region_polygons->boundary_edges) {
+		const gd::Edge::Connection &source = boundary_edge.connection;
+		const uint32_t polygon_index = source.polygon - p_region_polygons->polygons.ptr();
+		for (const gd::Edge::Connection &connection : source.polygon->edges[source.edge].connections) {
+			if (connection.edge == -1 || connection.polygon->id >= polygon_cluster_slots.size()) {
+				continue;
 			}
+			PortalEdge portal_edge;
+			portal_edge.cluster = p_region_polygons->polygon_clusters[polygon_index];
+			portal_edge.target = polygon_cluster_slots[connection.polygon->id].cluster;
+			portal_edge.position = (connection.pathway_start + connection.pathway_end) * 0.5;
+			portal_edge.slot = p_region_polygons->polygon_slots[polygon_index];
+			portal_edges.push_back(portal_edge);
 		}
+	}
+	_add_edge_portals(p_region_polygons, portal_edges);
 
-		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
-		iteration_id = iteration_id % UINT32_MAX + 1;
+	for (PolygonCluster &cluster : p_region_polygons->clusters) {
+		cluster.edge_portal_count = cluster.portals.size();
 	}
+}
 
-	// Do we have modified obstacle positions?
-	for (NavObstacle *obstacle : obstacles) {
-		if (obstacle->check_dirty()) {
-			obstacles_dirty = true;
+struct NavMapPortalEdgeLessThan {
+	template <typename T>
+	_FORCE_INLINE_ bool operator()(const T &p_a, const T &p_b) const {
+		if (p_a.cluster != p_b.cluster) {
+			return p_a.cluster < p_b.cluster;
 		}
+		return p_a.target < p_b.target;
 	}
-	// Do we have modified agent arrays?
-	for (NavAgent *agent : agents) {
-		if (agent->check_dirty()) {
-			agents_dirty = true;
+};
+
+void NavMap::_add_edge_portals(RegionPolygons *p_region_polygons, LocalVector<PortalEdge> &p_portal_edges) {
+	// Group the edges going from the same cluster to the same other cluster.
+	p_portal_edges.sort_custom<NavMapPortalEdgeLessThan>();
+
+	uint32_t group_begin = 0;
+	while (group_begin < p_portal_edges.size()) {
+		const PortalEdge &first = p_portal_edges[group_begin];
+		uint32_t group_end = group_begin + 1;
+		Vector3 average = first.position;
+		while (group_end < p_portal_edges.size() && p_portal_edges[group_end].cluster == first.cluster && p_portal_edges[group_end].target == first.target) {
+			average += p_portal_edges[group_end].position;
+			group_end++;
 		}
+		average /= real_t(group_end - group_begin);
+
+		// The average can be off the navigation mesh, use the closest edge instead.
+		uint32_t closest = group_begin;
+		real_t closest_distance = FLT_MAX;
+		for (uint32_t i = group_begin; i < group_end; i++) {
+			const real_t distance = p_portal_edges[i].position.distance_squared_to(average);
+			if (distance < closest_distance) {
+				closest = i;
+				closest_distance = distance;
+			}
+		}
+
+		PolygonCluster &cluster = p_region_polygons->clusters[first.cluster];
+		cluster.portals.push_back(ClusterPortal());
+		ClusterPortal &portal = cluster.portals[cluster.portals.size() - 1];
+		portal.target = first.target;
+		portal.position = p_portal_edges[closest].position;
+		portal.slot = p_portal_edges[closest].slot;
+		_compute_portal_distances(cluster, portal);
+
+		group_begin = group_end;
 	}
+}
 
-	// Update avoidance worlds.
-	if (obstacles_dirty || agents_dirty) {
-		_update_rvo_simulation();
+void NavMap::_compute_portal_distances(const PolygonCluster &p_cluster, ClusterPortal &r_portal) const {
+	// Dijkstra over the polygon centers, clusters are small enough to pick the closest polygon by scanning.
+	const RegionPolygons *region_polys = p_cluster.owner;
+	const uint32_t polygon_count = p_cluster.polygons.size();
+	LocalVector<real_t> &distances = r_portal.distances;
+	distances.resize(polygon_count);
+	for (real_t &distance : distances) {
+		distance = FLT_MAX;
 	}
+	bool visited[CLUSTER_MAX_POLYGONS] = {};
 
-	regenerate_polygons = false;
-	regenerate_links = false;
-	obstacles_dirty = false;
-	agents_dirty = false;
+	distances[r_portal.slot] = r_portal.position.distance_to(p_cluster.polygons[r_portal.slot]->center);
+	while (true) {
+		uint32_t current = UINT32_MAX;
+		for (uint32_t slot = 0; slot < polygon_count; slot++) {
+			if (!visited[slot] && distances[slot] != FLT_MAX && (current == UINT32_MAX || distances[slot] < distances[current])) {
+				current = slot;
+			}
+		}
+		if (current == UINT32_MAX) {
+			break;
+		}
+		visited[current] = true;
 
-	// Performance Monitor.
-	pm_region_count = _new_pm_region_count;
-	pm_agent_count = _new_pm_agent_count;
-	pm_link_count = _new_pm_link_count;
-	pm_polygon_count = _new_pm_polygon_count;
-	pm_edge_count = _new_pm_edge_count;
-	pm_edge_merge_count = _new_pm_edge_merge_count;
-	pm_edge_connection_count = _new_pm_edge_connection_count;
-	pm_edge_free_count = _new_pm_edge_free_count;
+		const gd::Polygon *polygon = p_cluster.polygons[current];
+		for (const gd::Edge &edge : polygon->edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				// Skip the connections leaving the region, to other regions or links.
+				if (connection.polygon->owner != region_polys->region) {
+					continue;
+				}
+				const uint32_t polygon_index = connection.polygon - region_polys->polygons.ptr();
+				if (region_polys->polygon_clusters[polygon_index] != p_cluster.index) {
+					continue;
+				}
+				const uint32_t slot = region_polys->polygon_slots[polygon_index];
+				const real_t distance = distances[current] + polygon->center.distance_to(connection.polygon->center);
+				if (distance < distances[slot]) {
+					distances[slot] = distance;
+				}
+			}
+		}
+	}
+}
+
+void NavMap::_update_cluster_ids() {
+	cluster_count = 0;
+	cluster_portal_count = 0;
+	if (polygon_cluster_slots.is_empty()) {
+		return;
+	}
+	for (KeyValue<const NavRegion *, RegionPolygons *> &E : region_polygons) {
+		for (PolygonCluster &cluster : E.value->clusters) {
+			cluster.id = cluster_count++;
+			cluster.first_portal_node = cluster_portal_count;
+			cluster_portal_count += cluster.portals.size();
+		}
+	}
+}
+
+bool NavMap::_find_cluster_corridor(const gd::Polygon *p_begin_poly, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers) const {
+	if (p_begin_poly->id >= polygon_cluster_slots.size() || p_end_poly->id >= polygon_cluster_slots.size()) {
+		return false;
+	}
+	const ClusterSlot &begin_slot = polygon_cluster_slots[p_begin_poly->id];
+	const ClusterSlot &end_slot = polygon_cluster_slots[p_end_poly->id];
+	if (begin_slot.cluster == end_slot.cluster) {
+		// Short path, searching the polygons directly is cheaper.
+		return false;
+	}
+
+	// This is an implementation of the A* algorithm over the portals, the end polygon is the node after them.
+	ClusterQueryState &query = cluster_query_state;
+	const uint32_t goal_node_id = cluster_portal_count;
+	query.begin(cluster_portal_count + 1, cluster_count);
+
+	const PolygonCluster *begin_cluster = begin_slot.cluster;
+	const real_t begin_travel_cost = begin_cluster->owner->region->get_travel_cost();
+	for (uint32_t i = 0; i < begin_cluster->portals.size(); i++) {
+		const ClusterPortal &portal = begin_cluster->portals[i];
+		if (portal.target && (!portal.link || portal.link_departure)) {
+			query.relax(begin_cluster->first_portal_node + i, begin_cluster, i, -1, portal.distances[begin_slot.slot] * begin_travel_cost, p_end_point);
+		}
+	}
+
+	bool found_route = false;
+	while (!query.open_nodes.is_empty()) {
+		const ClusterQueryState::Node *node = query.open_nodes.pop();
+		if (node->cluster == nullptr) {
+			found_route = true;
+			break;
+		}
+
+		const PolygonCluster *cluster = node->cluster;
+		const ClusterPortal &portal = cluster->portals[node->portal];
+		const real_t travel_cost = cluster->owner->region->get_travel_cost();
+		const int node_id = cluster->first_portal_node + node->portal;
+		const real_t traveled_distance = node->traveled_distance;
+
+		if (cluster == end_slot.cluster) {
+			query.relax(goal_node_id, nullptr, 0, node_id, traveled_distance + portal.distances[end_slot.slot] * travel_cost, p_end_point);
+		}
+
+		// Move to the other portals leading out of the cluster.
+		for (uint32_t i = 0; i < cluster->portals.size(); i++) {
+			const ClusterPortal &other = cluster->portals[i];
+			if (i == node->portal || !other.target || (other.link && !other.link_departure)) {
+				continue;
+			}
+			const real_t distance = portal.distances[other.slot] + cluster->polygons[other.slot]->center.distance_to(other.position);
+			query.relax(cluster->first_portal_node + i, cluster, i, node_id, traveled_distance + distance * travel_cost, p_end_point);
+		}
+
+		// Cross the portal, arriving at the portal of the other side that leads back here.
+		const PolygonCluster *target = portal.target;
+		if (!target || (portal.link && !portal.link_departure)) {
+			continue;
+		}
+		if ((p_navigation_layers & target->owner->region->get_navigation_layers()) == 0) {
+			continue;
+		}
+		if (portal.link && (p_navigation_layers & portal.link->get_navigation_layers()) == 0) {
+			continue;
+		}
+		for (uint32_t i = 0; i < target->portals.size(); i++) {
+			const ClusterPortal &arrival = target->portals[i];
+			if (arrival.target != cluster || arrival.link != portal.link) {
+				continue;
+			}
+			real_t crossing_cost = 0.0;
+			if (portal.link) {
+				crossing_cost += portal.position.distance_to(arrival.position) * portal.link->get_travel_cost() + portal.link->get_enter_cost();
+			}
+			if (target->owner != cluster->owner) {
+				crossing_cost += target->owner->region->get_enter_cost();
+			}
+			query.relax(target->first_portal_node + i, target, i, node_id, traveled_distance + crossing_cost, p_end_point);
+			break;
+		}
+	}
+
+	if (!found_route) {
+		return false;
+	}
+
+	// Keep the clusters on the way, the polygon search is limited to them.
+	query.mark_corridor(begin_cluster);
+	for (int node_id = query.nodes[goal_node_id].back_node; node_id != -1; node_id = query.nodes[node_id].back_node) {
+		query.mark_corridor(query.nodes[node_id].cluster);
+	}
+	return true;
 }
 
 void NavMap::_update_rvo_obstacles_tree_2d() {
@@ -1423,4 +2032,10 @@ NavMap::NavMap() {
 }
 
 NavMap::~NavMap() {
+	for (KeyValue<const NavRegion *, RegionPolygons *> &E : region_polygons) {
+		memdelete(E.value);
+	}
+	for (RegionPolygons *removed : removed_region_polygons) {
+		memdelete(removed);
+	}
 }
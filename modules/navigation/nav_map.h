@@ -31,6 +31,7 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_polygon_bvh.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
@@ -71,18 +72,125 @@ class NavMap : public NavRid {
 	/// This value is used to limit how far links search to find polygons to connect to.
 	real_t link_connection_radius = 1.0;
 
+	/// Long paths are searched over clusters of polygons first, see PolygonCluster.
+	bool use_hierarchical_pathfinding = false;
+
 	bool regenerate_polygons = true;
+	bool regenerate_connections = true;
 	bool regenerate_links = true;
 
+	struct RegionPolygons;
+	struct PolygonCluster;
+
+	/// Where paths leave a cluster for another one. All the edges shared by two clusters
+	/// make a single portal, placed on the edge closest to their average position.
+	struct ClusterPortal {
+		/// Cluster on the other side.
+		PolygonCluster *target = nullptr;
+		/// Link leading to the other side, null when the clusters share edges.
+		const NavLink *link = nullptr;
+		/// Whether the link can be taken from this side.
+		bool link_departure = false;
+		Vector3 position;
+		/// Cluster polygon the portal is placed on.
+		uint32_t slot = 0;
+		/// Travel distance from the portal to the center of each cluster polygon, by slot.
+		LocalVector<real_t> distances;
+	};
+
+	/// Connected polygons of a region, small enough to precompute the travel distances
+	/// between its portals. Paths are first searched from portal to portal, then only
+	/// the polygons of the clusters on the way are searched.
+	struct PolygonCluster {
+		/// Id of this cluster in its map.
+		uint32_t id = 0;
+		/// Index of this cluster in its region.
+		uint32_t index = 0;
+		/// Search node id of the first portal, the others follow.
+		uint32_t first_portal_node = 0;
+		RegionPolygons *owner = nullptr;
+		LocalVector<gd::Polygon *> polygons;
+		/// Portals to the clusters of the same region, then to other regions, then through links.
+		LocalVector<ClusterPortal> portals;
+		uint32_t region_portal_count = 0;
+		uint32_t edge_portal_count = 0;
+	};
+
+	/// Edge between two clusters, grouped with the others between the same clusters into a portal.
+	struct PortalEdge {
+		uint32_t cluster = 0;
+		PolygonCluster *target = nullptr;
+		Vector3 position;
+		uint32_t slot = 0;
+	};
+
+	/// Cluster of a polygon and the slot of the polygon in it.
+	struct ClusterSlot {
+		PolygonCluster *cluster = nullptr;
+		uint32_t slot = 0;
+	};
+
+	/// Search state of the portal graph, see get_path().
+	struct ClusterQueryState;
+	static thread_local ClusterQueryState cluster_query_state;
+
+	/// Edge of a region polygon that is not merged with another polygon of the same region.
+	/// Only those can merge or connect with the edges of other regions.
+	struct BoundaryEdge {
+		gd::EdgeKey key;
+		gd::Edge::Connection connection;
+		bool free = true;
+	};
+
+	/// Polygons of an enabled region as merged in the map.
+	/// They are rebuilt only when the region changes, so the connections that point to them
+	/// from unchanged regions stay valid and don't need to be rebuilt either.
+	struct RegionPolygons {
+		NavRegion *region = nullptr;
+		LocalVector<gd::Polygon> polygons;
+		LocalVector<BoundaryEdge> boundary_edges;
+		HashMap<gd::EdgeKey, uint32_t, gd::EdgeKey> boundary_edge_indices;
+		AABB aabb;
+		NavPolygonBVH bvh;
+
+		/// Only built with hierarchical pathfinding. The clusters are never resized, the portals point to them.
+		LocalVector<PolygonCluster> clusters;
+		/// Cluster index and slot of each polygon, by polygon index.
+		LocalVector<uint32_t> polygon_clusters;
+		LocalVector<uint32_t> polygon_slots;
+
+		// Performance Monitor
+		int edge_count = 0;
+		int edge_merge_count = 0;
+		int boundary_merge_count = 0;
+		int edge_free_count = 0;
+		int edge_connection_count = 0;
+	};
+
 	/// Map regions
 	LocalVector<NavRegion *> regions;
+	HashMap<const NavRegion *, RegionPolygons *> region_polygons;
+	/// Polygons of the regions removed since the last sync.
+	LocalVector<RegionPolygons *> removed_region_polygons;
 
 	/// Map links
 	LocalVector<NavLink *> links;
 	LocalVector<gd::Polygon> link_polygons;
+	/// Region polygons with connections entering a link.
+	LocalVector<gd::Polygon *> link_entry_polygons;
+
+	/// Map polygons by id.
+	LocalVector<gd::Polygon *> polygons;
+
+	/// Clusters of the region polygons by polygon id, empty without hierarchical pathfinding.
+	LocalVector<ClusterSlot> polygon_cluster_slots;
+	/// Clusters with portals through links, those are dropped whenever links are updated.
+	LocalVector<PolygonCluster *> link_portal_clusters;
+	uint32_t cluster_count = 0;
+	uint32_t cluster_portal_count = 0;
 
-	/// Map polygons
-	LocalVector<gd::Polygon> polygons;
+	/// Spatial index of the map polygons, combined from the region ones.
+	NavPolygonBVH polygon_bvh;
 
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
@@ -163,6 +271,11 @@ public:
 		return link_connection_radius;
 	}
 
+	void set_use_hierarchical_pathfinding(bool p_enabled);
+	bool get_use_hierarchical_pathfinding() const {
+		return use_hierarchical_pathfinding;
+	}
+
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
 	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
@@ -230,6 +343,20 @@ private:
 	void _update_rvo_agents_tree_3d();
 
 	void _update_merge_rasterizer_cell_dimensions();
+
+	real_t _get_region_neighbor_margin() const;
+	RegionPolygons *_create_region_polygons(NavRegion *p_region);
+	void _get_neighbor_region_polygons(const RegionPolygons *p_region_polygons, LocalVector<RegionPolygons *> &r_neighbors) const;
+	void _merge_boundary_edges(RegionPolygons *p_region_polygons, const LocalVector<RegionPolygons *> &p_neighbors);
+	void _connect_free_edges(RegionPolygons *p_region_polygons, const LocalVector<RegionPolygons *> &p_neighbors);
+	void _update_links();
+
+	void _create_region_clusters(RegionPolygons *p_region_polygons);
+	void _update_boundary_portals(RegionPolygons *p_region_polygons);
+	void _add_edge_portals(RegionPolygons *p_region_polygons, LocalVector<PortalEdge> &p_portal_edges);
+	void _compute_portal_distances(const PolygonCluster &p_cluster, ClusterPortal &r_portal) const;
+	void _update_cluster_ids();
+	bool _find_cluster_corridor(const gd::Polygon *p_begin_poly, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers) const;
 };
 
 #endif // NAV_MAP_H
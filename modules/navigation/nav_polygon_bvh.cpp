@@ -0,0 +1,453 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_polygon_bvh.h"
+
+#include "nav_base.h"
+
+#include "core/math/face3.h"
+#include "core/math/geometry_3d.h"
+#include "core/templates/sort_array.h"
+
+// Lower bound of the distance between a segment and anything inside an AABB, using the AABB bounding sphere.
+static _FORCE_INLINE_ real_t _get_segment_distance_lower_bound(const AABB &p_aabb, const Vector3 *p_segment) {
+	const Vector3 center = p_aabb.get_center();
+	const real_t distance = center.distance_to(Geometry3D::get_closest_point_to_segment(center, p_segment));
+	return MAX(real_t(0.0), distance - p_aabb.size.length() * real_t(0.5));
+}
+
+uint32_t NavPolygonBVH::_create_node_from_items(uint32_t p_from, uint32_t p_size, uint32_t p_depth, uint32_t &r_max_depth) {
+	if (p_depth > r_max_depth) {
+		r_max_depth = p_depth;
+	}
+
+	const uint32_t node_index = nodes.size();
+	nodes.push_back(Node());
+
+	Item *items_w = items.ptr() + p_from;
+
+	AABB aabb = items_w[0].aabb;
+	AABB center_aabb(items_w[0].center, Vector3());
+	for (uint32_t i = 1; i < p_size; i++) {
+		aabb.merge_with(items_w[i].aabb);
+		center_aabb.expand_to(items_w[i].center);
+	}
+
+	// Item ranges never mix owners, see build().
+	nodes[node_index].aabb = aabb;
+	nodes[node_index].owner = items_w[0].polygon->owner;
+
+	if (p_size <= MAX_LEAF_ITEMS) {
+		nodes[node_index].first_or_right = p_from;
+		nodes[node_index].item_count = p_size;
+		return node_index;
+	}
+
+	const uint32_t half = p_size / 2;
+
+	switch (center_aabb.get_longest_axis_index()) {
+		case Vector3::AXIS_X: {
+			SortArray<Item, CenterCmp<Item, Vector3::AXIS_X>> sort_x;
+			sort_x.nth_element(0, p_size, half, items_w);
+		} break;
+		case Vector3::AXIS_Y: {
+			SortArray<Item, CenterCmp<Item, Vector3::AXIS_Y>> sort_y;
+			sort_y.nth_element(0, p_size, half, items_w);
+		} break;
+		case Vector3::AXIS_Z: {
+			SortArray<Item, CenterCmp<Item, Vector3::AXIS_Z>> sort_z;
+			sort_z.nth_element(0, p_size, half, items_w);
+		} break;
+	}
+
+	_create_node_from_items(p_from, half, p_depth + 1, r_max_depth);
+	const uint32_t right = _create_node_from_items(p_from + half, p_size - half, p_depth + 1, r_max_depth);
+	nodes[node_index].first_or_right = right;
+
+	return node_index;
+}
+
+uint32_t NavPolygonBVH::_create_node_from_owners(OwnerRange *p_ranges, uint32_t p_size, uint32_t p_depth, uint32_t &r_max_depth) {
+	if (p_size == 1) {
+		if (p_ranges[0].tree) {
+			return _append_tree(*p_ranges[0].tree, p_depth, r_max_depth);
+		}
+		return _create_node_from_items(p_ranges[0].from, p_ranges[0].size, p_depth, r_max_depth);
+	}
+
+	if (p_depth > r_max_depth) {
+		r_max_depth = p_depth;
+	}
+
+	const uint32_t node_index = nodes.size();
+	nodes.push_back(Node());
+
+	AABB center_aabb(p_ranges[0].center, Vector3());
+	for (uint32_t i = 1; i < p_size; i++) {
+		center_aabb.expand_to(p_ranges[i].center);
+	}
+
+	const uint32_t half = p_size / 2;
+
+	switch (center_aabb.get_longest_axis_index()) {
+		case Vector3::AXIS_X: {
+			SortArray<OwnerRange, CenterCmp<OwnerRange, Vector3::AXIS_X>> sort_x;
+			sort_x.nth_element(0, p_size, half, p_ranges);
+		} break;
+		case Vector3::AXIS_Y: {
+			SortArray<OwnerRange, CenterCmp<OwnerRange, Vector3::AXIS_Y>> sort_y;
+			sort_y.nth_element(0, p_size, half, p_ranges);
+		} break;
+		case Vector3::AXIS_Z: {
+			SortArray<OwnerRange, CenterCmp<OwnerRange, Vector3::AXIS_Z>> sort_z;
+			sort_z.nth_element(0, p_size, half, p_ranges);
+		} break;
+	}
+
+	const uint32_t left = _create_node_from_owners(p_ranges, half, p_depth + 1, r_max_depth);
+	const uint32_t right = _create_node_from_owners(p_ranges + half, p_size - half, p_depth + 1, r_max_depth);
+
+	Node &node = nodes[node_index];
+	node.aabb = nodes[left].aabb.merge(nodes[right].aabb);
+	node.owner = nodes[left].owner == nodes[right].owner ? nodes[left].owner : nullptr;
+	node.first_or_right = right;
+
+	return node_index;
+}
+
+uint32_t NavPolygonBVH::_append_tree(const NavPolygonBVH &p_tree, uint32_t p_depth, uint32_t &r_max_depth) {
+	if (p_depth + p_tree.depth > r_max_depth) {
+		r_max_depth = p_depth + p_tree.depth;
+	}
+
+	const uint32_t node_offset = nodes.size();
+	const uint32_t item_offset = items.size();
+
+	for (const Item &item : p_tree.items) {
+		items.push_back(item);
+	}
+	for (const Node &tree_node : p_tree.nodes) {
+		Node node = tree_node;
+		node.first_or_right += node.item_count > 0 ? item_offset : node_offset;
+		nodes.push_back(node);
+	}
+
+	return node_offset;
+}
+
+void NavPolygonBVH::_finish_build(uint32_t p_max_depth) {
+	if (unlikely(p_max_depth >= MAX_DEPTH)) {
+		clear();
+		ERR_FAIL_MSG(vformat("Navigation polygon BVH is too deep (%d levels).", p_max_depth));
+	}
+	depth = p_max_depth;
+}
+
+void NavPolygonBVH::build(const LocalVector<gd::Polygon> &p_polygons) {
+	clear();
+
+	// The polygons of one owner are expected to be contiguous, like the ones of a region.
+	LocalVector<OwnerRange> owner_ranges;
+	items.reserve(p_polygons.size());
+
+	for (uint32_t polygon_index = 0; polygon_index < p_polygons.size(); polygon_index++) {
+		const gd::Polygon &polygon = p_polygons[polygon_index];
+		if (polygon.points.size() < 3) {
+			continue;
+		}
+
+		Item item;
+		item.aabb = AABB(polygon.points[0].pos, Vector3());
+		for (uint32_t point_id = 1; point_id < polygon.points.size(); point_id++) {
+			item.aabb.expand_to(polygon.points[point_id].pos);
+		}
+		item.center = item.aabb.get_center();
+		item.polygon = &polygon;
+
+		if (owner_ranges.is_empty() || items[owner_ranges[owner_ranges.size() - 1].from].polygon->owner != polygon.owner) {
+			OwnerRange owner_range;
+			owner_range.aabb = item.aabb;
+			owner_range.from = items.size();
+			owner_ranges.push_back(owner_range);
+		} else {
+			owner_ranges[owner_ranges.size() - 1].aabb.merge_with(item.aabb);
+		}
+		owner_ranges[owner_ranges.size() - 1].size++;
+
+		items.push_back(item);
+	}
+
+	if (items.is_empty()) {
+		return;
+	}
+
+	for (OwnerRange &owner_range : owner_ranges) {
+		owner_range.center = owner_range.aabb.get_center();
+	}
+
+	nodes.reserve(owner_ranges.size() + (items.size() / MAX_LEAF_ITEMS + 1) * 2);
+
+	uint32_t max_depth = 0;
+	_create_node_from_owners(owner_ranges.ptr(), owner_ranges.size(), 0, max_depth);
+	_finish_build(max_depth);
+}
+
+void NavPolygonBVH::build(const LocalVector<const NavPolygonBVH *> &p_trees) {
+	clear();
+
+	LocalVector<OwnerRange> owner_ranges;
+	uint32_t node_count = 0;
+	uint32_t item_count = 0;
+
+	for (const NavPolygonBVH *tree : p_trees) {
+		if (tree->is_empty()) {
+			continue;
+		}
+		OwnerRange owner_range;
+		owner_range.aabb = tree->nodes[0].aabb;
+		owner_range.center = owner_range.aabb.get_center();
+		owner_range.tree = tree;
+		owner_ranges.push_back(owner_range);
+
+		node_count += tree->nodes.size();
+		item_count += tree->items.size();
+	}
+
+	if (owner_ranges.is_empty()) {
+		return;
+	}
+
+	nodes.reserve(owner_ranges.size() + node_count);
+	items.reserve(item_count);
+
+	uint32_t max_depth = 0;
+	_create_node_from_owners(owner_ranges.ptr(), owner_ranges.size(), 0, max_depth);
+	_finish_build(max_depth);
+}
+
+void NavPolygonBVH::clear() {
+	nodes.clear();
+	items.clear();
+	depth = 0;
+}
+
+void NavPolygonBVH::_get_closest_polygon(const Vector3 &p_point, uint32_t p_navigation_layers, bool p_use_navigation_layers, ClosestPolygonResult &r_result) const {
+	if (nodes.is_empty()) {
+		return;
+	}
+
+	uint32_t stack[MAX_DEPTH + 2];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const uint32_t node_index = stack[--stack_size];
+		const Node &node = nodes[node_index];
+
+		// Skip whole regions with incompatible layers.
+		if (p_use_navigation_layers && node.owner && (p_navigation_layers & node.owner->get_navigation_layers()) == 0) {
+			continue;
+		}
+
+		if (node.item_count == 0) {
+			const uint32_t left = node_index + 1;
+			const uint32_t right = node.first_or_right;
+			const real_t left_distance_squared = _get_distance_squared_to_aabb(nodes[left].aabb, p_point);
+			const real_t right_distance_squared = _get_distance_squared_to_aabb(nodes[right].aabb, p_point);
+
+			// Push the closest child last so it is visited first, it likely shrinks the search radius the most.
+			if (left_distance_squared <= right_distance_squared) {
+				if (right_distance_squared <= r_result.distance_squared) {
+					stack[stack_size++] = right;
+				}
+				if (left_distance_squared <= r_result.distance_squared) {
+					stack[stack_size++] = left;
+				}
+			} else {
+				if (left_distance_squared <= r_result.distance_squared) {
+					stack[stack_size++] = left;
+				}
+				if (right_distance_squared <= r_result.distance_squared) {
+					stack[stack_size++] = right;
+				}
+			}
+			continue;
+		}
+
+		for (uint32_t item_index = node.first_or_right; item_index < node.first_or_right + node.item_count; item_index++) {
+			const Item &item = items[item_index];
+			if (_get_distance_squared_to_aabb(item.aabb, p_point) > r_result.distance_squared) {
+				continue;
+			}
+
+			const gd::Polygon &polygon = *item.polygon;
+			for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+				const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+				const Vector3 point = face.get_closest_point_to(p_point);
+				const real_t distance_squared = point.distance_squared_to(p_point);
+
+				// On ties keep the polygon that comes first in the map, like a linear scan of the polygons would.
+				if (distance_squared < r_result.distance_squared || (distance_squared == r_result.distance_squared && r_result.polygon && polygon.id < r_result.polygon_index)) {
+					r_result.polygon = item.polygon;
+					r_result.polygon_index = polygon.id;
+					r_result.point = point;
+					r_result.normal = face.get_plane().normal;
+					r_result.distance_squared = distance_squared;
+				}
+			}
+		}
+	}
+}
+
+NavPolygonBVH::ClosestPolygonResult NavPolygonBVH::get_closest_polygon(const Vector3 &p_point, real_t p_max_distance) const {
+	ClosestPolygonResult result;
+	if (p_max_distance < FLT_MAX) {
+		result.distance_squared = p_max_distance * p_max_distance;
+	}
+	_get_closest_polygon(p_point, 0, false, result);
+	return result;
+}
+
+NavPolygonBVH::ClosestPolygonResult NavPolygonBVH::get_closest_polygon_in_layers(const Vector3 &p_point, uint32_t p_navigation_layers) const {
+	ClosestPolygonResult result;
+	_get_closest_polygon(p_point, p_navigation_layers, true, result);
+	return result;
+}
+
+bool NavPolygonBVH::intersect_segment(const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_point) const {
+	if (nodes.is_empty()) {
+		return false;
+	}
+
+	bool found = false;
+	real_t closest_distance_squared = FLT_MAX;
+
+	uint32_t stack[MAX_DEPTH + 2];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const uint32_t node_index = stack[--stack_size];
+		const Node &node = nodes[node_index];
+
+		if (!node.aabb.intersects_segment(p_from, p_to) || _get_distance_squared_to_aabb(node.aabb, p_from) > closest_distance_squared) {
+			continue;
+		}
+
+		if (node.item_count == 0) {
+			stack[stack_size++] = node.first_or_right;
+			stack[stack_size++] = node_index + 1;
+			continue;
+		}
+
+		for (uint32_t item_index = node.first_or_right; item_index < node.first_or_right + node.item_count; item_index++) {
+			const Item &item = items[item_index];
+			if (!item.aabb.intersects_segment(p_from, p_to)) {
+				continue;
+			}
+
+			const gd::Polygon &polygon = *item.polygon;
+			for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+				const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+				Vector3 intersection;
+				if (face.intersects_segment(p_from, p_to, &intersection)) {
+					const real_t distance_squared = p_from.distance_squared_to(intersection);
+					if (distance_squared < closest_distance_squared) {
+						closest_distance_squared = distance_squared;
+						r_point = intersection;
+						found = true;
+					}
+				}
+			}
+		}
+	}
+
+	return found;
+}
+
+bool NavPolygonBVH::get_closest_edge_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_point) const {
+	if (nodes.is_empty()) {
+		return false;
+	}
+
+	const Vector3 segment[2] = { p_from, p_to };
+
+	bool found = false;
+	real_t closest_distance = FLT_MAX;
+	uint32_t closest_polygon_index = UINT32_MAX;
+
+	uint32_t stack[MAX_DEPTH + 2];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const uint32_t node_index = stack[--stack_size];
+		const Node &node = nodes[node_index];
+
+		if (_get_segment_distance_lower_bound(node.aabb, segment) > closest_distance) {
+			continue;
+		}
+
+		if (node.item_count == 0) {
+			stack[stack_size++] = node.first_or_right;
+			stack[stack_size++] = node_index + 1;
+			continue;
+		}
+
+		for (uint32_t item_index = node.first_or_right; item_index < node.first_or_right + node.item_count; item_index++) {
+			const Item &item = items[item_index];
+			if (_get_segment_distance_lower_bound(item.aabb, segment) > closest_distance) {
+				continue;
+			}
+
+			const gd::Polygon &polygon = *item.polygon;
+			for (uint32_t point_id = 0; point_id < polygon.points.size(); point_id++) {
+				Vector3 a, b;
+				Geometry3D::get_closest_points_between_segments(
+						p_from,
+						p_to,
+						polygon.points[point_id].pos,
+						polygon.points[(point_id + 1) % polygon.points.size()].pos,
+						a,
+						b);
+
+				const real_t distance = a.distance_to(b);
+				if (distance < closest_distance || (distance == closest_distance && found && polygon.id < closest_polygon_index)) {
+					closest_distance = distance;
+					closest_polygon_index = polygon.id;
+					r_point = b;
+					found = true;
+				}
+			}
+		}
+	}
+
+	return found;
+}
@@ -0,0 +1,132 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_POLYGON_BVH_H
+#define NAV_POLYGON_BVH_H
+
+#include "nav_utils.h"
+
+#include "core/math/aabb.h"
+
+class NavBase;
+
+/// Static bounding volume hierarchy over the polygons of a navigation map.
+/// It replaces the linear polygon scans of the map closest point queries.
+///
+/// The polygons of each owner (region) are kept in their own sub-tree, so
+/// owners whose navigation layers don't match a query can be skipped as a whole
+/// without storing the layers in the tree (they can change without a rebuild).
+/// `NavMap::sync()` builds one tree per region when the region changes and
+/// combines them into the map tree, without sorting the polygons again.
+class NavPolygonBVH {
+public:
+	struct ClosestPolygonResult {
+		const gd::Polygon *polygon = nullptr;
+		uint32_t polygon_index = UINT32_MAX;
+		Vector3 point;
+		Vector3 normal;
+		real_t distance_squared = FLT_MAX;
+	};
+
+private:
+	enum {
+		MAX_LEAF_ITEMS = 4,
+		MAX_DEPTH = 64,
+	};
+
+	struct Item {
+		AABB aabb;
+		Vector3 center; // Used for sorting.
+		const gd::Polygon *polygon = nullptr;
+	};
+
+	struct OwnerRange {
+		AABB aabb;
+		Vector3 center; // Used for sorting.
+		uint32_t from = 0;
+		uint32_t size = 0;
+		/// When combining trees, the tree that is copied in place of the item range.
+		const NavPolygonBVH *tree = nullptr;
+	};
+
+	template <typename T, int AXIS>
+	struct CenterCmp {
+		_FORCE_INLINE_ bool operator()(const T &p_left, const T &p_right) const {
+			return p_left.center[AXIS] < p_right.center[AXIS];
+		}
+	};
+
+	struct Node {
+		AABB aabb;
+		/// Region or link that owns all the polygons below this node, nullptr when mixed.
+		const NavBase *owner = nullptr;
+		/// For leaves the first item, otherwise the index of the right child (the left child always follows its parent).
+		uint32_t first_or_right = 0;
+		/// Item count, 0 for internal nodes.
+		uint32_t item_count = 0;
+	};
+
+	LocalVector<Node> nodes;
+	LocalVector<Item> items;
+	uint32_t depth = 0;
+
+	uint32_t _create_node_from_items(uint32_t p_from, uint32_t p_size, uint32_t p_depth, uint32_t &r_max_depth);
+	uint32_t _create_node_from_owners(OwnerRange *p_ranges, uint32_t p_size, uint32_t p_depth, uint32_t &r_max_depth);
+	uint32_t _append_tree(const NavPolygonBVH &p_tree, uint32_t p_depth, uint32_t &r_max_depth);
+	void _finish_build(uint32_t p_max_depth);
+
+	_FORCE_INLINE_ static real_t _get_distance_squared_to_aabb(const AABB &p_aabb, const Vector3 &p_point) {
+		return p_point.clamp(p_aabb.position, p_aabb.position + p_aabb.size).distance_squared_to(p_point);
+	}
+
+	void _get_closest_polygon(const Vector3 &p_point, uint32_t p_navigation_layers, bool p_use_navigation_layers, ClosestPolygonResult &r_result) const;
+
+public:
+	void build(const LocalVector<gd::Polygon> &p_polygons);
+	/// Combines the trees of several owners, their nodes are copied as they are.
+	void build(const LocalVector<const NavPolygonBVH *> &p_trees);
+	void clear();
+
+	bool is_empty() const { return nodes.is_empty(); }
+	uint32_t get_node_count() const { return nodes.size(); }
+
+	/// Closest polygon to a point, ignoring navigation layers.
+	/// Only polygons closer than `p_max_distance` are considered.
+	ClosestPolygonResult get_closest_polygon(const Vector3 &p_point, real_t p_max_distance = FLT_MAX) const;
+	/// Closest polygon to a point among the ones owned by regions or links with compatible navigation layers.
+	ClosestPolygonResult get_closest_polygon_in_layers(const Vector3 &p_point, uint32_t p_navigation_layers) const;
+
+	/// Closest point to `p_from` where the segment crosses a polygon face.
+	bool intersect_segment(const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_point) const;
+	/// Closest point of all the polygon edges to the segment.
+	bool get_closest_edge_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_point) const;
+};
+
+#endif // NAV_POLYGON_BVH_H
@@ -98,6 +98,9 @@ struct Edge {
 };
 
 struct Polygon {
+	/// Id of this polygon in its map, region polygons come first and link polygons after them.
+	uint32_t id = 0;
+
 	/// Navigation region or link that contains this polygon.
 	const NavBase *owner = nullptr;
 
@@ -118,9 +121,14 @@ struct Polygon {
 
 struct NavigationPoly {
 	uint32_t self_id = 0;
+	/// The path query which last reached this poly, older data is stale.
+	uint32_t query_id = 0;
 	/// This poly.
 	const Polygon *poly;
 
+	/// Position in the heap of polys to visit, UINT32_MAX when not in it.
+	uint32_t traversable_poly_index = UINT32_MAX;
+
 	/// Those 4 variables are used to travel the path backwards.
 	int back_navigation_poly_id = -1;
 	int back_navigation_edge = -1;
@@ -129,8 +137,14 @@ struct NavigationPoly {
 
 	/// The entry position of this poly.
 	Vector3 entry;
-	/// The distance to the destination.
+	/// The distance traveled from the start.
 	real_t traveled_distance = 0.0;
+	/// The estimated cost left to reach the destination.
+	real_t distance_to_destination = 0.0;
+
+	real_t total_travel_cost() const {
+		return traveled_distance + distance_to_destination;
+	}
 
 	NavigationPoly() { poly = nullptr; }
 
@@ -146,6 +160,97 @@ struct NavigationPoly {
 	}
 };
 
+struct NavPolyTravelCostLessThan {
+	_FORCE_INLINE_ bool operator()(const NavigationPoly *p_poly_a, const NavigationPoly *p_poly_b) const {
+		return p_poly_a->total_travel_cost() < p_poly_b->total_travel_cost();
+	}
+};
+
+struct NavPolyHeapIndexer {
+	_FORCE_INLINE_ void operator()(NavigationPoly *p_poly, uint32_t p_heap_index) const {
+		p_poly->traversable_poly_index = p_heap_index;
+	}
+};
+
+/// Binary heap keeping its least element on top. The indexer is told where each element
+/// moves to, so an element can be shifted up in place after its cost decreased.
+template <typename T, typename LessThan, typename Indexer>
+class Heap {
+	LocalVector<T> buffer;
+	LessThan less_than;
+	Indexer indexer;
+
+	void _shift_up(uint32_t p_index) {
+		T element = buffer[p_index];
+		while (p_index > 0) {
+			uint32_t parent = (p_index - 1) / 2;
+			if (!less_than(element, buffer[parent])) {
+				break;
+			}
+			buffer[p_index] = buffer[parent];
+			indexer(buffer[p_index], p_index);
+			p_index = parent;
+		}
+		buffer[p_index] = element;
+		indexer(element, p_index);
+	}
+
+	void _shift_down(uint32_t p_index) {
+		T element = buffer[p_index];
+		const uint32_t size = buffer.size();
+		while (true) {
+			uint32_t child = p_index * 2 + 1;
+			if (child >= size) {
+				break;
+			}
+			if (child + 1 < size && less_than(buffer[child + 1], buffer[child])) {
+				child++;
+			}
+			if (!less_than(buffer[child], element)) {
+				break;
+			}
+			buffer[p_index] = buffer[child];
+			indexer(buffer[p_index], p_index);
+			p_index = child;
+		}
+		buffer[p_index] = element;
+		indexer(element, p_index);
+	}
+
+public:
+	void push(const T &p_element) {
+		buffer.push_back(p_element);
+		_shift_up(buffer.size() - 1);
+	}
+
+	T pop() {
+		T top = buffer[0];
+		indexer(top, UINT32_MAX);
+		const T last = buffer[buffer.size() - 1];
+		buffer.resize(buffer.size() - 1);
+		if (!buffer.is_empty()) {
+			buffer[0] = last;
+			_shift_down(0);
+		}
+		return top;
+	}
+
+	/// Restores the heap order after the cost of the element at `p_index` decreased.
+	void shift(uint32_t p_index) {
+		_shift_up(p_index);
+	}
+
+	void clear() {
+		for (const T &element : buffer) {
+			indexer(element, UINT32_MAX);
+		}
+		buffer.clear();
+	}
+
+	uint32_t size() const { return buffer.size(); }
+	bool is_empty() const { return buffer.is_empty(); }
+};
+
 struct ClosestPointQueryResult {
 	Vector3 point;
 	Vector3 normal;
@@ -266,13 +266,14 @@ Error MultiplayerAPI::decode_and_decompress_variants(Vector<Variant> &r_variants
 		return OK;
 	}
 
+	VariantDecoder decoder(p_buffer, p_len, p_allow_object_decoding, true);
+	Variant *variants = r_variants.ptrw();
 	for (int i = 0; i < argc; i++) {
-		ERR_FAIL_COND_V_MSG(r_len >= p_len, ERR_INVALID_DATA, "Invalid packet received. Size too small.");
+		ERR_FAIL_COND_V_MSG(decoder.is_at_end(), ERR_INVALID_DATA, "Invalid packet received. Size too small.");
 
-		int vlen;
-		Error err = MultiplayerAPI::decode_and_decompress_variant(r_variants.write[i], &p_buffer[r_len], p_len - r_len, &vlen, p_allow_object_decoding);
+		Error err = decoder.next(variants[i]);
 		ERR_FAIL_COND_V_MSG(err != OK, err, "Invalid packet received. Unable to decode state variable.");
-		r_len += vlen;
+		r_len = decoder.get_position();
 	}
 	return OK;
 }
@@ -161,6 +161,13 @@ void PhysicsServer2DExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_space_get_contacts, "space");
 	GDVIRTUAL_BIND(_space_get_contact_count, "space");
 
+	GDVIRTUAL_BIND(_space_save_snapshot, "space");
+	GDVIRTUAL_BIND(_space_restore_snapshot, "space", "snapshot");
+
+	GDVIRTUAL_BIND(_space_set_profiling_enabled, "space", "enabled");
+	GDVIRTUAL_BIND(_space_is_profiling_enabled, "space");
+	GDVIRTUAL_BIND(_space_get_profile, "space");
+
 	/* AREA API */
 
 	GDVIRTUAL_BIND(_area_create);
@@ -327,6 +334,26 @@ void PhysicsServer2DExtension::_bind_methods() {
 
 	GDVIRTUAL_BIND(_joint_get_type, "joint");
 
+	/* PROJECTILE BATCH API */
+
+	GDVIRTUAL_BIND(_projectile_batch_create);
+
+	GDVIRTUAL_BIND(_projectile_batch_set_space, "batch", "space");
+	GDVIRTUAL_BIND(_projectile_batch_get_space, "batch");
+
+	GDVIRTUAL_BIND(_projectile_batch_set_radius, "batch", "radius");
+	GDVIRTUAL_BIND(_projectile_batch_get_radius, "batch");
+
+	GDVIRTUAL_BIND(_projectile_batch_set_collision_mask, "batch", "mask");
+	GDVIRTUAL_BIND(_projectile_batch_get_collision_mask, "batch");
+
+	GDVIRTUAL_BIND(_projectile_batch_set_projectiles, "batch", "positions", "velocities");
+	GDVIRTUAL_BIND(_projectile_batch_get_positions, "batch");
+	GDVIRTUAL_BIND(_projectile_batch_get_velocities, "batch");
+
+	GDVIRTUAL_BIND(_projectile_batch_get_hit_count, "batch");
+	GDVIRTUAL_BIND(_projectile_batch_get_hits, "batch", "hits", "hit_max");
+
 	/* MISC */
 
 	GDVIRTUAL_BIND(_free_rid, "rid");
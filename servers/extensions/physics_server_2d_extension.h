@@ -185,6 +185,10 @@ typedef PhysicsServer2D::MotionResult PhysicsServer2DExtensionMotionResult;
 
 GDVIRTUAL_NATIVE_PTR(PhysicsServer2DExtensionMotionResult)
 
+typedef PhysicsServer2D::ProjectileHit PhysicsServer2DExtensionProjectileHit;
+
+GDVIRTUAL_NATIVE_PTR(PhysicsServer2DExtensionProjectileHit)
+
 class PhysicsServer2DExtension : public PhysicsServer2D {
 	GDCLASS(PhysicsServer2DExtension, PhysicsServer2D);
 
@@ -237,6 +241,13 @@ public:
 	EXBIND1RC(Vector<Vector2>, space_get_contacts, RID)
 	EXBIND1RC(int, space_get_contact_count, RID)
 
+	EXBIND1R(PackedByteArray, space_save_snapshot, RID)
+	EXBIND2R(Error, space_restore_snapshot, RID, const PackedByteArray &)
+
+	EXBIND2(space_set_profiling_enabled, RID, bool)
+	EXBIND1RC(bool, space_is_profiling_enabled, RID)
+	EXBIND1RC(Dictionary, space_get_profile, RID)
+
 	/* AREA API */
 
 	//EXBIND0RID(area);
@@ -430,6 +441,33 @@ public:
 
 	EXBIND1RC(JointType, joint_get_type, RID)
 
+	/* PROJECTILE BATCH API */
+
+	EXBIND0R(RID, projectile_batch_create)
+
+	EXBIND2(projectile_batch_set_space, RID, RID)
+	EXBIND1RC(RID, projectile_batch_get_space, RID)
+
+	EXBIND2(projectile_batch_set_radius, RID, real_t)
+	EXBIND1RC(real_t, projectile_batch_get_radius, RID)
+
+	EXBIND2(projectile_batch_set_collision_mask, RID, uint32_t)
+	EXBIND1RC(uint32_t, projectile_batch_get_collision_mask, RID)
+
+	EXBIND3(projectile_batch_set_projectiles, RID, const Vector<Vector2> &, const Vector<Vector2> &)
+	EXBIND1RC(Vector<Vector2>, projectile_batch_get_positions, RID)
+	EXBIND1RC(Vector<Vector2>, projectile_batch_get_velocities, RID)
+
+	EXBIND1RC(int, projectile_batch_get_hit_count, RID)
+
+	GDVIRTUAL3RC(int, _projectile_batch_get_hits, RID, GDExtensionPtr<PhysicsServer2DExtensionProjectileHit>, int)
+
+	virtual int projectile_batch_get_hits(RID p_batch, ProjectileHit *r_hits, int p_hit_max) const override {
+		int ret = 0;
+		GDVIRTUAL_REQUIRED_CALL(_projectile_batch_get_hits, p_batch, r_hits, p_hit_max, ret);
+		return ret;
+	}
+
 	/* MISC */
 
 	GDVIRTUAL1(_free_rid, RID)
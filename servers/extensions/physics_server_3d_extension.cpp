@@ -167,6 +167,17 @@ void PhysicsServer3DExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_space_get_contacts, "space");
 	GDVIRTUAL_BIND(_space_get_contact_count, "space");
 
+	GDVIRTUAL_BIND(_space_save_snapshot, "space");
+	GDVIRTUAL_BIND(_space_restore_snapshot, "space", "snapshot");
+
+	GDVIRTUAL_BIND(_space_set_publish_state, "space", "enable");
+	GDVIRTUAL_BIND(_space_is_publishing_state, "space");
+	GDVIRTUAL_BIND(_space_get_published_direct_state, "space");
+
+	GDVIRTUAL_BIND(_space_set_profiling_enabled, "space", "enabled");
+	GDVIRTUAL_BIND(_space_is_profiling_enabled, "space");
+	GDVIRTUAL_BIND(_space_get_profile, "space");
+
 	/* AREA API */
 
 	GDVIRTUAL_BIND(_area_create);
@@ -207,6 +218,8 @@ void PhysicsServer3DExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_area_set_monitor_callback, "area", "callback");
 	GDVIRTUAL_BIND(_area_set_area_monitor_callback, "area", "callback");
 
+	GDVIRTUAL_BIND(_area_get_published_overlaps, "area");
+
 	/* BODY API */
 
 	ClassDB::bind_method(D_METHOD("body_test_motion_is_excluding_body", "body"), &PhysicsServer3DExtension::body_test_motion_is_excluding_body);
@@ -257,6 +270,7 @@ void PhysicsServer3DExtension::_bind_methods() {
 
 	GDVIRTUAL_BIND(_body_set_state, "body", "state", "value");
 	GDVIRTUAL_BIND(_body_get_state, "body", "state");
+	GDVIRTUAL_BIND(_body_get_published_state, "body", "state");
 
 	GDVIRTUAL_BIND(_body_apply_central_impulse, "body", "impulse");
 	GDVIRTUAL_BIND(_body_apply_impulse, "body", "impulse", "position");
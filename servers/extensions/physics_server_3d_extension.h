@@ -243,6 +243,17 @@ public:
 	EXBIND1RC(Vector<Vector3>, space_get_contacts, RID)
 	EXBIND1RC(int, space_get_contact_count, RID)
 
+	EXBIND1R(PackedByteArray, space_save_snapshot, RID)
+	EXBIND2R(Error, space_restore_snapshot, RID, const PackedByteArray &)
+
+	EXBIND2(space_set_publish_state, RID, bool)
+	EXBIND1RC(bool, space_is_publishing_state, RID)
+	EXBIND1R(PhysicsDirectSpaceState3D *, space_get_published_direct_state, RID)
+
+	EXBIND2(space_set_profiling_enabled, RID, bool)
+	EXBIND1RC(bool, space_is_profiling_enabled, RID)
+	EXBIND1RC(Dictionary, space_get_profile, RID)
+
 	/* AREA API */
 
 	//EXBIND0RID(area);
@@ -284,6 +295,8 @@ public:
 	EXBIND2(area_set_monitor_callback, RID, const Callable &)
 	EXBIND2(area_set_area_monitor_callback, RID, const Callable &)
 
+	EXBIND1RC(TypedArray<RID>, area_get_published_overlaps, RID)
+
 	/* BODY API */
 
 	//EXBIND2RID(body,BodyMode,bool);
@@ -332,6 +345,7 @@ public:
 
 	EXBIND3(body_set_state, RID, BodyState, const Variant &)
 	EXBIND2RC(Variant, body_get_state, RID, BodyState)
+	EXBIND2RC(Variant, body_get_published_state, RID, BodyState)
 
 	EXBIND2(body_apply_central_impulse, RID, const Vector3 &)
 	EXBIND3(body_apply_impulse, RID, const Vector3 &, const Vector3 &)
@@ -32,6 +32,7 @@
 #define NAVIGATION_UTILITIES_H
 
 #include "core/math/vector3.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/typed_array.h"
 
 namespace NavigationUtilities {
@@ -77,6 +78,21 @@ struct PathQueryResult {
 	PackedInt64Array path_owner_ids;
 };
 
+// Path queries submitted together with `query_path_async()` of the 2D or 3D navigation server.
+// The queries are solved on the WorkerThreadPool, then the batch hands the results
+// over to the query result objects of the server that created it.
+struct PathQueryBatch {
+	int64_t id = 0;
+	LocalVector<PathQueryParameters> parameters;
+	LocalVector<PathQueryResult> results;
+	Callable callback;
+
+	// Called on the thread processing the navigation server, once all the queries are solved.
+	virtual void publish_results() = 0;
+
+	virtual ~PathQueryBatch() {}
+};
+
 } //namespace NavigationUtilities
 
 #endif // NAVIGATION_UTILITIES_H
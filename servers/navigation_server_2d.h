@@ -90,6 +90,10 @@ public:
 	/// Returns the link connection radius of this map.
 	virtual real_t map_get_link_connection_radius(RID p_map) const = 0;
 
+	/// Set whether long paths are searched over clusters of polygons first.
+	virtual void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) = 0;
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const = 0;
+
 	/// Returns the navigation path to reach the destination from the origin.
 	virtual Vector<Vector2> map_get_path(RID p_map, Vector2 p_origin, Vector2 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const = 0;
 
@@ -294,6 +298,15 @@ public:
 	/// Returns a customized navigation path using a query parameters object
 	virtual void query_path(const Ref<NavigationPathQueryParameters2D> &p_query_parameters, Ref<NavigationPathQueryResult2D> p_query_result) const = 0;
 
+	/// Solves a batch of path queries in parallel, against the maps as synchronized in the frame it is dispatched.
+	/// The results are filled in a later frame, when the returned id is reported as completed or passed to the callback.
+	virtual int64_t query_path_async(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results, const Callable &p_callback = Callable()) = 0;
+	virtual bool is_path_query_completed(int64_t p_query_id) const = 0;
+	virtual void wait_for_path_query(int64_t p_query_id) = 0;
+
+	virtual void set_async_path_query_budget(int p_max_queries) = 0;
+	virtual int get_async_path_query_budget() const = 0;
+
 	virtual void init() = 0;
 	virtual void sync() = 0;
 	virtual void finish() = 0;
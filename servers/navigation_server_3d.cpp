@@ -55,6 +55,8 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_edge_connection_margin", "map"), &NavigationServer3D::map_get_edge_connection_margin);
 	ClassDB::bind_method(D_METHOD("map_set_link_connection_radius", "map", "radius"), &NavigationServer3D::map_set_link_connection_radius);
 	ClassDB::bind_method(D_METHOD("map_get_link_connection_radius", "map"), &NavigationServer3D::map_get_link_connection_radius);
+	ClassDB::bind_method(D_METHOD("map_set_use_hierarchical_pathfinding", "map", "enabled"), &NavigationServer3D::map_set_use_hierarchical_pathfinding);
+	ClassDB::bind_method(D_METHOD("map_get_use_hierarchical_pathfinding", "map"), &NavigationServer3D::map_get_use_hierarchical_pathfinding);
 	ClassDB::bind_method(D_METHOD("map_get_path", "map", "origin", "destination", "optimize", "navigation_layers"), &NavigationServer3D::map_get_path, DEFVAL(1));
 	ClassDB::bind_method(D_METHOD("map_get_closest_point_to_segment", "map", "start", "end", "use_collision"), &NavigationServer3D::map_get_closest_point_to_segment, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("map_get_closest_point", "map", "to_point"), &NavigationServer3D::map_get_closest_point);
@@ -72,6 +74,11 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_random_point", "map", "navigation_layers", "uniformly"), &NavigationServer3D::map_get_random_point);
 
 	ClassDB::bind_method(D_METHOD("query_path", "parameters", "result"), &NavigationServer3D::query_path);
+	ClassDB::bind_method(D_METHOD("query_path_async", "parameters", "results", "callback"), &NavigationServer3D::query_path_async, DEFVAL(Callable()));
+	ClassDB::bind_method(D_METHOD("is_path_query_completed", "query_id"), &NavigationServer3D::is_path_query_completed);
+	ClassDB::bind_method(D_METHOD("wait_for_path_query", "query_id"), &NavigationServer3D::wait_for_path_query);
+	ClassDB::bind_method(D_METHOD("set_async_path_query_budget", "max_queries"), &NavigationServer3D::set_async_path_query_budget);
+	ClassDB::bind_method(D_METHOD("get_async_path_query_budget"), &NavigationServer3D::get_async_path_query_budget);
 
 	ClassDB::bind_method(D_METHOD("region_create"), &NavigationServer3D::region_create);
 	ClassDB::bind_method(D_METHOD("region_set_enabled", "region", "enabled"), &NavigationServer3D::region_set_enabled);
@@ -185,6 +192,8 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("parse_source_geometry_data", "navigation_mesh", "source_geometry_data", "root_node", "callback"), &NavigationServer3D::parse_source_geometry_data, DEFVAL(Callable()));
 	ClassDB::bind_method(D_METHOD("bake_from_source_geometry_data", "navigation_mesh", "source_geometry_data", "callback"), &NavigationServer3D::bake_from_source_geometry_data, DEFVAL(Callable()));
 	ClassDB::bind_method(D_METHOD("bake_from_source_geometry_data_async", "navigation_mesh", "source_geometry_data", "callback"), &NavigationServer3D::bake_from_source_geometry_data_async, DEFVAL(Callable()));
+	ClassDB::bind_method(D_METHOD("bake_tiles_from_source_geometry_data", "navigation_mesh", "source_geometry_data", "aabb", "callback"), &NavigationServer3D::bake_tiles_from_source_geometry_data, DEFVAL(Callable()));
+	ClassDB::bind_method(D_METHOD("bake_tiles_from_source_geometry_data_async", "navigation_mesh", "source_geometry_data", "aabb", "callback"), &NavigationServer3D::bake_tiles_from_source_geometry_data_async, DEFVAL(Callable()));
 	ClassDB::bind_method(D_METHOD("is_baking_navigation_mesh", "navigation_mesh"), &NavigationServer3D::is_baking_navigation_mesh);
 #endif // _3D_DISABLED
 
@@ -216,6 +225,8 @@ void NavigationServer3D::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(INFO_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(INFO_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(INFO_PATH_QUERY_QUEUE_DEPTH);
+	BIND_ENUM_CONSTANT(INFO_PATH_QUERY_DISPATCH_COUNT);
 }
 
 NavigationServer3D *NavigationServer3D::get_singleton() {
@@ -230,6 +241,7 @@ NavigationServer3D::NavigationServer3D() {
 	GLOBAL_DEF("navigation/2d/use_edge_connections", true);
 	GLOBAL_DEF_BASIC("navigation/2d/default_edge_connection_margin", 1.0);
 	GLOBAL_DEF_BASIC("navigation/2d/default_link_connection_radius", 4.0);
+	GLOBAL_DEF("navigation/2d/use_hierarchical_pathfinding", false);
 
 	GLOBAL_DEF_BASIC(PropertyInfo(Variant::FLOAT, "navigation/3d/default_cell_size", PROPERTY_HINT_RANGE, "0.001,100,0.001,or_greater"), 0.25);
 	GLOBAL_DEF_BASIC("navigation/3d/default_cell_height", 0.25);
@@ -238,13 +250,17 @@ NavigationServer3D::NavigationServer3D() {
 	GLOBAL_DEF("navigation/3d/use_edge_connections", true);
 	GLOBAL_DEF_BASIC("navigation/3d/default_edge_connection_margin", 0.25);
 	GLOBAL_DEF_BASIC("navigation/3d/default_link_connection_radius", 1.0);
+	GLOBAL_DEF("navigation/3d/use_hierarchical_pathfinding", false);
 
 	GLOBAL_DEF("navigation/avoidance/thread_model/avoidance_use_multiple_threads", true);
 	GLOBAL_DEF("navigation/avoidance/thread_model/avoidance_use_high_priority_threads", true);
 
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "navigation/pathfinding/async_path_query_budget", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), 0);
+
 	GLOBAL_DEF("navigation/baking/use_crash_prevention_checks", true);
 	GLOBAL_DEF("navigation/baking/thread_model/baking_use_multiple_threads", true);
 	GLOBAL_DEF("navigation/baking/thread_model/baking_use_high_priority_threads", true);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "navigation/baking/thread_model/baking_max_threads", PROPERTY_HINT_RANGE, "0,256,1,or_greater"), 0);
 
 #ifdef DEBUG_ENABLED
 	debug_navigation_edge_connection_color = GLOBAL_DEF("debug/shapes/navigation/edge_connection_color", Color(1.0, 0.0, 1.0, 1.0));
@@ -942,6 +958,42 @@ void NavigationServer3D::query_path(const Ref<NavigationPathQueryParameters3D> &
 	p_query_result->set_path_owner_ids(_query_result.path_owner_ids);
 }
 
+// Batch of NavigationServer3D::query_path_async().
+struct NavigationPathQueryBatch3D : public NavigationUtilities::PathQueryBatch {
+	LocalVector<Ref<NavigationPathQueryResult3D>> query_results;
+
+	virtual void publish_results() override {
+		for (uint32_t i = 0; i < query_results.size(); i++) {
+			const NavigationUtilities::PathQueryResult &result = results[i];
+			query_results[i]->set_path(result.path);
+			query_results[i]->set_path_types(result.path_types);
+			query_results[i]->set_path_rids(result.path_rids);
+			query_results[i]->set_path_owner_ids(result.path_owner_ids);
+		}
+	}
+};
+
+int64_t NavigationServer3D::query_path_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND_V_MSG(p_query_parameters.size() != p_query_results.size(), 0, "Each path query needs its own result object.");
+
+	NavigationPathQueryBatch3D *batch = memnew(NavigationPathQueryBatch3D);
+	batch->parameters.resize(p_query_parameters.size());
+	batch->query_results.resize(p_query_results.size());
+	for (int i = 0; i < p_query_parameters.size(); i++) {
+		const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		const Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+		if (unlikely(query_parameters.is_null() || query_result.is_null())) {
+			memdelete(batch);
+			ERR_FAIL_V_MSG(0, vformat("Invalid path query parameters or result at index %d.", i));
+		}
+		batch->parameters[i] = query_parameters->get_parameters();
+		batch->query_results[i] = query_result;
+	}
+	batch->callback = p_callback;
+
+	return _query_path_async(batch);
+}
+
 ///////////////////////////////////////////////////////
 
 NavigationServer3DCallback NavigationServer3DManager::create_callback = nullptr;
@@ -102,6 +102,10 @@ public:
 	/// Returns the link connection radius of this map.
 	virtual real_t map_get_link_connection_radius(RID p_map) const = 0;
 
+	/// Set whether long paths are searched over clusters of polygons first.
+	virtual void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) = 0;
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const = 0;
+
 	/// Returns the navigation path to reach the destination from the origin.
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const = 0;
 
@@ -344,10 +348,28 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const = 0;
 
+	/// Solves a batch of path queries in parallel, against the maps as synchronized in the frame it is dispatched.
+	/// The results are filled in a later frame, when the returned id is reported as completed or passed to the callback.
+	virtual int64_t query_path_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable());
+	virtual bool is_path_query_completed(int64_t p_query_id) const = 0;
+	/// Solves the batch right away if needed and publishes its results.
+	/// Note: This function is not thread safe, like `process()`.
+	virtual void wait_for_path_query(int64_t p_query_id) = 0;
+
+	/// Maximum number of asynchronous path queries dispatched per frame, 0 for no limit.
+	/// Batches are never split, at least one is dispatched each frame.
+	virtual void set_async_path_query_budget(int p_max_queries) = 0;
+	virtual int get_async_path_query_budget() const = 0;
+
+	/// Takes ownership of the batch and returns its id.
+	virtual int64_t _query_path_async(NavigationUtilities::PathQueryBatch *p_batch) = 0;
+
 #ifndef _3D_DISABLED
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
+	virtual void bake_tiles_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback = Callable()) = 0;
+	virtual void bake_tiles_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_aabb, const Callable &p_callback = Callable()) = 0;
 	virtual bool is_baking_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) const = 0;
 #endif // _3D_DISABLED
 
@@ -369,6 +391,8 @@ public:
 		INFO_EDGE_MERGE_COUNT,
 		INFO_EDGE_CONNECTION_COUNT,
 		INFO_EDGE_FREE_COUNT,
+		INFO_PATH_QUERY_QUEUE_DEPTH,
+		INFO_PATH_QUERY_DISPATCH_COUNT,
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) const = 0;
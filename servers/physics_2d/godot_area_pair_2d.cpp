@@ -31,6 +31,12 @@
 #include "godot_area_pair_2d.h"
 #include "godot_collision_solver_2d.h"
 
+bool GodotAreaPair2D::get_pair_shape_types(int &r_type_A, int &r_type_B) const {
+	r_type_A = body->get_shape(body_shape)->get_type();
+	r_type_B = area->get_shape(area_shape)->get_type();
+	return true;
+}
+
 bool GodotAreaPair2D::setup(real_t p_step) {
 	bool result = false;
 	if (area->collides_with(body) && GodotCollisionSolver2D::solve(body->get_shape(body_shape), body->get_transform() * body->get_shape_transform(body_shape), Vector2(), area->get_shape(area_shape), area->get_transform() * area->get_shape_transform(area_shape), Vector2(), nullptr, this)) {
@@ -119,6 +125,12 @@ GodotAreaPair2D::~GodotAreaPair2D() {
 
 //////////////////////////////////
 
+bool GodotArea2Pair2D::get_pair_shape_types(int &r_type_A, int &r_type_B) const {
+	r_type_A = area_a->get_shape(shape_a)->get_type();
+	r_type_B = area_b->get_shape(shape_b)->get_type();
+	return true;
+}
+
 bool GodotArea2Pair2D::setup(real_t p_step) {
 	bool result_a = area_a->collides_with(area_b);
 	bool result_b = area_b->collides_with(area_a);
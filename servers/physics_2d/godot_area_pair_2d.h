@@ -46,6 +46,8 @@ class GodotAreaPair2D : public GodotConstraint2D {
 	bool body_has_attached_area = false;
 
 public:
+	virtual bool get_pair_shape_types(int &r_type_A, int &r_type_B) const override;
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -67,6 +69,8 @@ class GodotArea2Pair2D : public GodotConstraint2D {
 	bool area_b_monitorable;
 
 public:
+	virtual bool get_pair_shape_types(int &r_type_A, int &r_type_B) const override;
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -300,6 +300,24 @@ public:
 	void set_state(PhysicsServer2D::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PhysicsServer2D::BodyState p_state) const;
 
+	// Dynamic state saved and restored by space snapshots, see GodotSpace2D::save_snapshot().
+	struct SnapshotState {
+		Transform2D transform;
+		Transform2D new_transform;
+		Vector2 linear_velocity;
+		real_t angular_velocity = 0.0;
+		Vector2 prev_linear_velocity;
+		real_t prev_angular_velocity = 0.0;
+		Vector2 applied_force;
+		real_t applied_torque = 0.0;
+		real_t still_time = 0.0;
+		bool first_time_kinematic = false;
+	};
+
+	void get_snapshot_state(SnapshotState &r_state) const;
+	// Doesn't activate or deactivate the body, the space restores the active list on its own to keep its order.
+	void set_snapshot_state(const SnapshotState &p_state);
+
 	_FORCE_INLINE_ void set_continuous_collision_detection_mode(PhysicsServer2D::CCDMode p_mode) { continuous_cd_mode = p_mode; }
 	_FORCE_INLINE_ PhysicsServer2D::CCDMode get_continuous_collision_detection_mode() const { return continuous_cd_mode; }
 
@@ -315,8 +333,11 @@ public:
 	_FORCE_INLINE_ real_t get_friction() const { return friction; }
 	_FORCE_INLINE_ real_t get_bounce() const { return bounce; }
 
+	// Safe to run for different bodies in parallel, as long as finish_integration()
+	// is called afterwards from a single thread.
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
+	void finish_integration();
 
 	_FORCE_INLINE_ Vector2 get_velocity_in_local_point(const Vector2 &rel_pos) const {
 		return linear_velocity + Vector2(-angular_velocity * rel_pos.y, angular_velocity * rel_pos.x);
@@ -245,6 +245,12 @@ real_t combine_friction(GodotBody2D *A, GodotBody2D *B) {
 	return ABS(MIN(A->get_friction(), B->get_friction()));
 }
 
+bool GodotBodyPair2D::get_pair_shape_types(int &r_type_A, int &r_type_B) const {
+	r_type_A = A->get_shape(shape_A)->get_type();
+	r_type_B = B->get_shape(shape_B)->get_type();
+	return true;
+}
+
 bool GodotBodyPair2D::setup(real_t p_step) {
 	check_ccd = false;
 
@@ -591,6 +597,72 @@ void GodotBodyPair2D::solve(real_t p_step) {
 	}
 }
 
+GodotConstraint2D::StateKey GodotBodyPair2D::get_state_key() const {
+	StateKey key;
+	key.object_A = A->get_self().get_id();
+	key.object_B = B->get_self().get_id();
+	key.shape_A = shape_A;
+	key.shape_B = shape_B;
+	return key;
+}
+
+void GodotBodyPair2D::save_state(LocalVector<uint8_t> &r_state) const {
+	// Only what survives from one step to the next is needed, the rest is computed again in pre_solve().
+	state_write(r_state, sep_axis);
+	state_write(r_state, collided);
+	state_write(r_state, oneway_disabled);
+	state_write(r_state, (uint8_t)contact_count);
+	for (int i = 0; i < contact_count; i++) {
+		const Contact &c = contacts[i];
+		state_write(r_state, c.position);
+		state_write(r_state, c.normal);
+		state_write(r_state, c.local_A);
+		state_write(r_state, c.local_B);
+		state_write(r_state, c.acc_impulse);
+		state_write(r_state, c.acc_normal_impulse);
+		state_write(r_state, c.acc_tangent_impulse);
+		state_write(r_state, c.acc_bias_impulse);
+		state_write(r_state, c.acc_bias_impulse_center_of_mass);
+		state_write(r_state, c.depth);
+		state_write(r_state, c.active);
+		state_write(r_state, c.used);
+	}
+}
+
+bool GodotBodyPair2D::load_state(const uint8_t *p_state, uint32_t p_size) {
+	const uint8_t *end = p_state + p_size;
+	uint8_t count = 0;
+	bool valid = state_read(p_state, end, sep_axis) && state_read(p_state, end, collided) && state_read(p_state, end, oneway_disabled) && state_read(p_state, end, count) && count <= MAX_CONTACTS;
+	for (int i = 0; valid && i < count; i++) {
+		Contact &c = contacts[i];
+		valid = state_read(p_state, end, c.position) &&
+				state_read(p_state, end, c.normal) &&
+				state_read(p_state, end, c.local_A) &&
+				state_read(p_state, end, c.local_B) &&
+				state_read(p_state, end, c.acc_impulse) &&
+				state_read(p_state, end, c.acc_normal_impulse) &&
+				state_read(p_state, end, c.acc_tangent_impulse) &&
+				state_read(p_state, end, c.acc_bias_impulse) &&
+				state_read(p_state, end, c.acc_bias_impulse_center_of_mass) &&
+				state_read(p_state, end, c.depth) &&
+				state_read(p_state, end, c.active) &&
+				state_read(p_state, end, c.used);
+	}
+	if (!valid || p_state != end) {
+		reset_state();
+		return false;
+	}
+	contact_count = count;
+	return true;
+}
+
+void GodotBodyPair2D::reset_state() {
+	sep_axis = Vector2();
+	collided = false;
+	oneway_disabled = false;
+	contact_count = 0;
+}
+
 GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B) :
 		GodotConstraint2D(_arr, 2) {
 	A = p_A;
@@ -90,6 +90,13 @@ class GodotBodyPair2D : public GodotConstraint2D {
 	_FORCE_INLINE_ void _contact_added_callback(const Vector2 &p_point_A, const Vector2 &p_point_B);
 
 public:
+	virtual StateKey get_state_key() const override;
+	virtual void save_state(LocalVector<uint8_t> &r_state) const override;
+	virtual bool load_state(const uint8_t *p_state, uint32_t p_size) override;
+	virtual void reset_state() override;
+
+	virtual bool get_pair_shape_types(int &r_type_A, int &r_type_B) const override;
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
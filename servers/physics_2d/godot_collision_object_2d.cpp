@@ -162,6 +162,24 @@ void GodotCollisionObject2D::_update_shapes() {
 		return;
 	}
 
+	_update_shape_aabbs();
+	_move_shapes_in_broadphase();
+}
+
+void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion) {
+	if (!space) {
+		return;
+	}
+
+	_update_shape_aabbs_with_motion(p_motion);
+	_move_shapes_in_broadphase();
+}
+
+void GodotCollisionObject2D::_update_shape_aabbs() {
+	if (!space) {
+		return;
+	}
+
 	for (int i = 0; i < shapes.size(); i++) {
 		Shape &s = shapes.write[i];
 		if (s.disabled) {
@@ -174,17 +192,11 @@ void GodotCollisionObject2D::_update_shapes() {
 		shape_aabb = xform.xform(shape_aabb);
 		shape_aabb.grow_by((s.aabb_cache.size.x + s.aabb_cache.size.y) * 0.5 * 0.05);
 		s.aabb_cache = shape_aabb;
-
-		if (s.bpid == 0) {
-			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
-			space->get_broadphase()->set_static(s.bpid, _static);
-		}
-
-		space->get_broadphase()->move(s.bpid, shape_aabb);
 	}
+	broadphase_update_pending = true;
 }
 
-void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion) {
+void GodotCollisionObject2D::_update_shape_aabbs_with_motion(const Vector2 &p_motion) {
 	if (!space) {
 		return;
 	}
@@ -201,13 +213,31 @@ void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion)
 		shape_aabb = xform.xform(shape_aabb);
 		shape_aabb = shape_aabb.merge(Rect2(shape_aabb.position + p_motion, shape_aabb.size)); //use motion
 		s.aabb_cache = shape_aabb;
+	}
+	broadphase_update_pending = true;
+}
+
+void GodotCollisionObject2D::_move_shapes_in_broadphase() {
+	broadphase_update_pending = false;
+
+	for (int i = 0; i < shapes.size(); i++) {
+		Shape &s = shapes.write[i];
+		if (s.disabled) {
+			continue;
+		}
 
 		if (s.bpid == 0) {
-			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
+			s.bpid = space->get_broadphase()->create(this, i, s.aabb_cache, _static);
 			space->get_broadphase()->set_static(s.bpid, _static);
 		}
 
-		space->get_broadphase()->move(s.bpid, shape_aabb);
+		space->get_broadphase()->move(s.bpid, s.aabb_cache);
+	}
+}
+
+void GodotCollisionObject2D::update_broadphase() {
+	if (broadphase_update_pending && space) {
+		_move_shapes_in_broadphase();
 	}
 }
 
@@ -75,10 +75,19 @@ private:
 
 	SelfList<GodotCollisionObject2D> pending_shape_update_list;
 
+	bool broadphase_update_pending = false;
+
 	void _update_shapes();
+	void _move_shapes_in_broadphase();
 
 protected:
 	void _update_shapes_with_motion(const Vector2 &p_motion);
+
+	// Like _update_shapes() and _update_shapes_with_motion(), but only compute the shape AABBs,
+	// so they are safe to call from worker threads. See update_broadphase().
+	void _update_shape_aabbs();
+	void _update_shape_aabbs_with_motion(const Vector2 &p_motion);
+
 	void _unregister_shapes();
 
 	_FORCE_INLINE_ void _set_transform(const Transform2D &p_transform, bool p_update_shapes = true) {
@@ -96,6 +105,10 @@ protected:
 	GodotCollisionObject2D(Type p_type);
 
 public:
+	// Moves the shapes in the broadphase after their AABBs were updated from a worker thread.
+	// Not thread-safe.
+	void update_broadphase();
+
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
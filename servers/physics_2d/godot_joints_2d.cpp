@@ -256,6 +256,25 @@ void GodotPinJoint2D::solve(real_t p_step) {
 	P += impulse;
 }
 
+void GodotPinJoint2D::save_state(LocalVector<uint8_t> &r_state) const {
+	state_write(r_state, P);
+	state_write(r_state, j_acc);
+}
+
+bool GodotPinJoint2D::load_state(const uint8_t *p_state, uint32_t p_size) {
+	const uint8_t *end = p_state + p_size;
+	if (!state_read(p_state, end, P) || !state_read(p_state, end, j_acc) || p_state != end) {
+		reset_state();
+		return false;
+	}
+	return true;
+}
+
+void GodotPinJoint2D::reset_state() {
+	P = Vector2();
+	j_acc = 0.0;
+}
+
 void GodotPinJoint2D::set_param(PhysicsServer2D::PinJointParam p_param, real_t p_value) {
 	switch (p_param) {
 		case PhysicsServer2D::PIN_JOINT_SOFTNESS: {
@@ -470,6 +489,23 @@ void GodotGrooveJoint2D::solve(real_t p_step) {
 	}
 }
 
+void GodotGrooveJoint2D::save_state(LocalVector<uint8_t> &r_state) const {
+	state_write(r_state, jn_acc);
+}
+
+bool GodotGrooveJoint2D::load_state(const uint8_t *p_state, uint32_t p_size) {
+	const uint8_t *end = p_state + p_size;
+	if (!state_read(p_state, end, jn_acc) || p_state != end) {
+		reset_state();
+		return false;
+	}
+	return true;
+}
+
+void GodotGrooveJoint2D::reset_state() {
+	jn_acc = Vector2();
+}
+
 GodotGrooveJoint2D::GodotGrooveJoint2D(const Vector2 &p_a_groove1, const Vector2 &p_a_groove2, const Vector2 &p_b_anchor, GodotBody2D *p_body_a, GodotBody2D *p_body_b) :
 		GodotJoint2D(_arr, 2) {
 	A = p_body_a;
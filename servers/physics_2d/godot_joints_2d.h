@@ -105,6 +105,10 @@ class GodotPinJoint2D : public GodotJoint2D {
 public:
 	virtual PhysicsServer2D::JointType get_type() const override { return PhysicsServer2D::JOINT_TYPE_PIN; }
 
+	virtual void save_state(LocalVector<uint8_t> &r_state) const override;
+	virtual bool load_state(const uint8_t *p_state, uint32_t p_size) override;
+	virtual void reset_state() override;
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -145,6 +149,10 @@ class GodotGrooveJoint2D : public GodotJoint2D {
 public:
 	virtual PhysicsServer2D::JointType get_type() const override { return PhysicsServer2D::JOINT_TYPE_GROOVE; }
 
+	virtual void save_state(LocalVector<uint8_t> &r_state) const override;
+	virtual bool load_state(const uint8_t *p_state, uint32_t p_size) override;
+	virtual void reset_state() override;
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
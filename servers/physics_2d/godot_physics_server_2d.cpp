@@ -276,6 +276,43 @@ int GodotPhysicsServer2D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+PackedByteArray GodotPhysicsServer2D::space_save_snapshot(RID p_space) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, PackedByteArray());
+	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync) || space->is_locked(), PackedByteArray(), "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->save_snapshot();
+}
+
+Error GodotPhysicsServer2D::space_restore_snapshot(RID p_space, const PackedByteArray &p_snapshot) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync) || space->is_locked(), ERR_LOCKED, "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->restore_snapshot(p_snapshot.ptr(), p_snapshot.size());
+}
+
+void GodotPhysicsServer2D::space_set_profiling_enabled(RID p_space, bool p_enabled) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL(space);
+
+	space->set_profiling(p_enabled);
+}
+
+bool GodotPhysicsServer2D::space_is_profiling_enabled(RID p_space) const {
+	const GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+
+	return space->is_profiling();
+}
+
+Dictionary GodotPhysicsServer2D::space_get_profile(RID p_space) const {
+	const GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, Dictionary());
+
+	return space->get_profile_info();
+}
+
 PhysicsDirectSpaceState2D *GodotPhysicsServer2D::space_get_direct_state(RID p_space) {
 	GodotSpace2D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_NULL_V(space, nullptr);
@@ -1219,6 +1256,102 @@ PhysicsServer2D::JointType GodotPhysicsServer2D::joint_get_type(RID p_joint) con
 	return joint->get_type();
 }
 
+/* PROJECTILE BATCH API */
+
+RID GodotPhysicsServer2D::projectile_batch_create() {
+	GodotProjectileBatch2D *batch = memnew(GodotProjectileBatch2D);
+	RID rid = projectile_batch_owner.make_rid(batch);
+	batch->set_self(rid);
+	return rid;
+}
+
+void GodotPhysicsServer2D::projectile_batch_set_space(RID p_batch, RID p_space) {
+	GodotProjectileBatch2D *batch = projectile_batch_owner.get_or_null(p_batch);
+	ERR_FAIL_NULL(batch);
+
+	GodotSpace2D *space = nullptr;
+	if (p_space.is_valid()) {
+		space = space_owner.get_or_null(p_space);
+		ERR_FAIL_NULL(space);
+	}
+
+	batch->set_space(space);
+}
+
+RID GodotPhysicsServer2D::projectile_batch_get_space(RID p_batch) const {
+	GodotProjectileBatch2D *batch = projectile_batch_owner.get_or_null(p_batch);
+	ERR_FAIL_NULL_V(batch, RID());
+
+	GodotSpace2D *space = batch->get_space();
+	if (!space) {
+		return RID();
+	}
+	return space->get_self();
+}
+
+void GodotPhysicsServer2D::projectile_batch_set_radius(RID p_batch, real_t p_radius) {
+	GodotProjectileBatch2D *batch = projectile_batch_owner.get_or_null(p_batch);
+	ERR_FAIL_NULL(batch);
+
+	batch->set_radius(p_radius);
+}
+
+real_t GodotPhysicsServer2D::projectile_batch_get_radius(RID p_batch) const {
+	GodotProjectileBatch2D *batch = projectile_batch_owner.get_or_null(p_batch);
+	ERR_FAIL_NULL_V(batch, 0);
+
+	return batch->get_radius();
+}
+
+void GodotPhysicsServer2D::projectile_batch_set_collision_mask(RID p_batch, uint32_t p_mask) {
+	GodotProjectileBatch2D *batch = projectile_batch_owner.get_or_null(p_batch);
+	ERR_FAIL_NULL(batch);
+
+	batch->set_collision_mask(p_mask);
+}
+
+uint32_t GodotPhysicsServer2D::projectile_batch_get_collision_mask(RID p_batch) const {
+	GodotProjectileBatch2D *batch = projectile_batch_owner.get_or_null(p_batch);
+	ERR_FAIL_NULL_V(batch, 0);
+
+	return batch->get_collision_mask();
+}
+
+void GodotPhysicsServer2D::projectile_batch_set_projectiles(RID p_batch, const Vector<Vector2> &p_positions, const Vector<Vector2> &p_velocities) {
+	GodotProjectileBatch2D *batch = projectile_batch_owner.get_or_null(p_batch);
+	ERR_FAIL_NULL(batch);
+
+	batch->set_projectiles(p_positions, p_velocities);
+}
+
+Vector<Vector2> GodotPhysicsServer2D::projectile_batch_get_positions(RID p_batch) const {
+	GodotProjectileBatch2D *batch = projectile_batch_owner.get_or_null(p_batch);
+	ERR_FAIL_NULL_V(batch, Vector<Vector2>());
+
+	return batch->get_positions();
+}
+
+Vector<Vector2> GodotPhysicsServer2D::projectile_batch_get_velocities(RID p_batch) const {
+	GodotProjectileBatch2D *batch = projectile_batch_owner.get_or_null(p_batch);
+	ERR_FAIL_NULL_V(batch, Vector<Vector2>());
+
+	return batch->get_velocities();
+}
+
+int GodotPhysicsServer2D::projectile_batch_get_hit_count(RID p_batch) const {
+	GodotProjectileBatch2D *batch = projectile_batch_owner.get_or_null(p_batch);
+	ERR_FAIL_NULL_V(batch, 0);
+
+	return batch->get_hit_count();
+}
+
+int GodotPhysicsServer2D::projectile_batch_get_hits(RID p_batch, ProjectileHit *r_hits, int p_hit_max) const {
+	GodotProjectileBatch2D *batch = projectile_batch_owner.get_or_null(p_batch);
+	ERR_FAIL_NULL_V(batch, 0);
+
+	return batch->get_hits(r_hits, p_hit_max);
+}
+
 void GodotPhysicsServer2D::free(RID p_rid) {
 	_update_shapes(); // just in case
 
@@ -1263,6 +1396,10 @@ void GodotPhysicsServer2D::free(RID p_rid) {
 			co->set_space(nullptr);
 		}
 
+		while (space->get_projectile_batch_list().first()) {
+			space->get_projectile_batch_list().first()->self()->set_space(nullptr);
+		}
+
 		active_spaces.erase(space);
 		free(space->get_default_area()->get_self());
 		space_owner.free(p_rid);
@@ -1273,6 +1410,14 @@ void GodotPhysicsServer2D::free(RID p_rid) {
 		joint_owner.free(p_rid);
 		memdelete(joint);
 
+	} else if (projectile_batch_owner.owns(p_rid)) {
+		GodotProjectileBatch2D *batch = projectile_batch_owner.get_or_null(p_rid);
+
+		batch->set_space(nullptr);
+
+		projectile_batch_owner.free(p_rid);
+		memdelete(batch);
+
 	} else {
 		ERR_FAIL_MSG("Invalid ID.");
 	}
@@ -1297,11 +1442,17 @@ void GodotPhysicsServer2D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	constraint_count = 0;
+	step_usec = 0;
 	for (const GodotSpace2D *E : active_spaces) {
 		stepper->step(const_cast<GodotSpace2D *>(E), p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
+		constraint_count += E->get_constraint_count();
+		for (int i = 0; i < GodotSpace2D::ELAPSED_TIME_MAX; i++) {
+			step_usec += E->get_elapsed_time(GodotSpace2D::ElapsedTime(i));
+		}
 	}
 }
 
@@ -1327,13 +1478,6 @@ void GodotPhysicsServer2D::flush_queries() {
 
 	if (EngineDebugger::is_profiling("servers")) {
 		uint64_t total_time[GodotSpace2D::ELAPSED_TIME_MAX];
-		static const char *time_name[GodotSpace2D::ELAPSED_TIME_MAX] = {
-			"integrate_forces",
-			"generate_islands",
-			"setup_constraints",
-			"solve_constraints",
-			"integrate_velocities"
-		};
 
 		for (int i = 0; i < GodotSpace2D::ELAPSED_TIME_MAX; i++) {
 			total_time[i] = 0;
@@ -1348,7 +1492,7 @@ void GodotPhysicsServer2D::flush_queries() {
 		Array values;
 		values.resize(GodotSpace2D::ELAPSED_TIME_MAX * 2);
 		for (int i = 0; i < GodotSpace2D::ELAPSED_TIME_MAX; i++) {
-			values[i * 2 + 0] = time_name[i];
+			values[i * 2 + 0] = GodotSpace2D::get_elapsed_time_name(GodotSpace2D::ElapsedTime(i));
 			values[i * 2 + 1] = USEC_TO_SEC(total_time[i]);
 		}
 		values.push_back("flush_queries");
@@ -1356,6 +1500,20 @@ void GodotPhysicsServer2D::flush_queries() {
 
 		values.push_front("physics_2d");
 		EngineDebugger::profiler_add_frame_data("servers", values);
+
+		// Spaces being profiled are also reported on their own.
+		for (const GodotSpace2D *E : active_spaces) {
+			if (!E->is_profiling()) {
+				continue;
+			}
+			Array space_values;
+			space_values.push_back(vformat("physics_2d_space_%d", E->get_self().get_id()));
+			for (int i = 0; i < GodotSpace2D::ELAPSED_TIME_MAX; i++) {
+				space_values.push_back(GodotSpace2D::get_elapsed_time_name(GodotSpace2D::ElapsedTime(i)));
+				space_values.push_back(USEC_TO_SEC(E->get_elapsed_time(GodotSpace2D::ElapsedTime(i))));
+			}
+			EngineDebugger::profiler_add_frame_data("servers", space_values);
+		}
 	}
 }
 
@@ -1385,6 +1543,12 @@ int GodotPhysicsServer2D::get_process_info(ProcessInfo p_info) {
 		case INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case INFO_CONSTRAINT_COUNT: {
+			return constraint_count;
+		} break;
+		case INFO_STEP_USEC: {
+			return (int)step_usec;
+		} break;
 	}
 
 	return 0;
@@ -50,6 +50,8 @@ class GodotPhysicsServer2D : public PhysicsServer2D {
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int constraint_count = 0;
+	uint64_t step_usec = 0;
 
 	bool using_threads = false;
 
@@ -63,6 +65,7 @@ class GodotPhysicsServer2D : public PhysicsServer2D {
 	mutable RID_PtrOwner<GodotArea2D, true> area_owner;
 	mutable RID_PtrOwner<GodotBody2D, true> body_owner;
 	mutable RID_PtrOwner<GodotJoint2D, true> joint_owner;
+	mutable RID_PtrOwner<GodotProjectileBatch2D, true> projectile_batch_owner;
 
 	static GodotPhysicsServer2D *godot_singleton;
 
@@ -116,6 +119,13 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual PackedByteArray space_save_snapshot(RID p_space) override;
+	virtual Error space_restore_snapshot(RID p_space, const PackedByteArray &p_snapshot) override;
+
+	virtual void space_set_profiling_enabled(RID p_space, bool p_enabled) override;
+	virtual bool space_is_profiling_enabled(RID p_space) const override;
+	virtual Dictionary space_get_profile(RID p_space) const override;
+
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) override;
 
@@ -284,6 +294,26 @@ public:
 
 	virtual JointType joint_get_type(RID p_joint) const override;
 
+	/* PROJECTILE BATCH API */
+
+	virtual RID projectile_batch_create() override;
+
+	virtual void projectile_batch_set_space(RID p_batch, RID p_space) override;
+	virtual RID projectile_batch_get_space(RID p_batch) const override;
+
+	virtual void projectile_batch_set_radius(RID p_batch, real_t p_radius) override;
+	virtual real_t projectile_batch_get_radius(RID p_batch) const override;
+
+	virtual void projectile_batch_set_collision_mask(RID p_batch, uint32_t p_mask) override;
+	virtual uint32_t projectile_batch_get_collision_mask(RID p_batch) const override;
+
+	virtual void projectile_batch_set_projectiles(RID p_batch, const Vector<Vector2> &p_positions, const Vector<Vector2> &p_velocities) override;
+	virtual Vector<Vector2> projectile_batch_get_positions(RID p_batch) const override;
+	virtual Vector<Vector2> projectile_batch_get_velocities(RID p_batch) const override;
+
+	virtual int projectile_batch_get_hit_count(RID p_batch) const override;
+	virtual int projectile_batch_get_hits(RID p_batch, ProjectileHit *r_hits, int p_hit_max) const override;
+
 	/* MISC */
 
 	virtual void free(RID p_rid) override;
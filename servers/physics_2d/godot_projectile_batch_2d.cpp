@@ -0,0 +1,80 @@
+/**************************************************************************/
+/*  godot_projectile_batch_2d.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_projectile_batch_2d.h"
+
+#include "godot_space_2d.h"
+
+void GodotProjectileBatch2D::set_space(GodotSpace2D *p_space) {
+	if (space == p_space) {
+		return;
+	}
+
+	if (space) {
+		space->remove_projectile_batch(&space_list);
+	}
+
+	space = p_space;
+	hits.clear();
+
+	if (space) {
+		space->add_projectile_batch(&space_list);
+	}
+}
+
+void GodotProjectileBatch2D::set_radius(real_t p_radius) {
+	ERR_FAIL_COND(p_radius < 0.0);
+	radius = p_radius;
+	circle_shape.set_data(radius);
+}
+
+void GodotProjectileBatch2D::set_projectiles(const Vector<Vector2> &p_positions, const Vector<Vector2> &p_velocities) {
+	ERR_FAIL_COND(p_positions.size() != p_velocities.size());
+	positions = p_positions;
+	velocities = p_velocities;
+	hits.clear();
+}
+
+int GodotProjectileBatch2D::get_hits(PhysicsServer2D::ProjectileHit *r_hits, int p_hit_max) const {
+	int count = MIN((int)hits.size(), p_hit_max);
+	for (int i = 0; i < count; i++) {
+		r_hits[i] = hits[i];
+	}
+	return count;
+}
+
+GodotProjectileBatch2D::GodotProjectileBatch2D() :
+		space_list(this) {
+	circle_shape.set_data(radius);
+}
+
+GodotProjectileBatch2D::~GodotProjectileBatch2D() {
+	set_space(nullptr);
+}
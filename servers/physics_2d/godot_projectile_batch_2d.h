@@ -0,0 +1,116 @@
+/**************************************************************************/
+/*  godot_projectile_batch_2d.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_PROJECTILE_BATCH_2D_H
+#define GODOT_PROJECTILE_BATCH_2D_H
+
+#include "godot_shape_2d.h"
+
+#include "core/templates/local_vector.h"
+#include "core/templates/self_list.h"
+#include "servers/physics_server_2d.h"
+
+class GodotSpace2D;
+class GodotCollisionObject2D;
+
+// Many small projectiles that are not collision objects themselves. They are moved in bulk
+// by the space at the end of each step, and stop at the first static or kinematic body they
+// hit. They don't take part in the broadphase pairs, and aren't seen by areas or queries.
+class GodotProjectileBatch2D {
+	RID self;
+	GodotSpace2D *space = nullptr;
+	SelfList<GodotProjectileBatch2D> space_list;
+
+	uint32_t collision_mask = 1;
+	real_t radius = 0.0;
+	GodotCircleShape2D circle_shape; // Swept for a non-zero radius, segments are used otherwise.
+
+	Vector<Vector2> positions;
+	Vector<Vector2> velocities;
+
+	// Hits of the last step, ordered by projectile.
+	LocalVector<PhysicsServer2D::ProjectileHit> hits;
+
+	// Moving projectiles are sorted so that nearby ones end up in the same chunk, which is
+	// culled once against the broadphase. Kept around, so stepping doesn't allocate once warmed up.
+	struct StepProjectile {
+		uint64_t key = 0;
+		uint32_t index = 0;
+
+		bool operator<(const StepProjectile &p_other) const {
+			return key == p_other.key ? index < p_other.index : key < p_other.key;
+		}
+	};
+
+	struct StepChunk {
+		uint32_t projectile_begin = 0;
+		uint32_t projectile_end = 0;
+		uint32_t object_begin = 0;
+		uint32_t object_end = 0;
+		bool overflow = false; // Too many candidates, projectiles are culled one by one instead.
+	};
+
+	LocalVector<StepProjectile> step_projectiles;
+	LocalVector<StepChunk> step_chunks;
+	LocalVector<Rect2> step_aabbs;
+	LocalVector<GodotCollisionObject2D *> step_objects;
+	LocalVector<int> step_subindices;
+	LocalVector<PhysicsServer2D::ProjectileHit> step_hits; // One per projectile, used when threaded.
+	real_t step_delta = 0.0;
+	Vector2 *step_positions = nullptr;
+	Vector2 *step_velocities = nullptr;
+
+	friend class GodotSpace2D;
+
+public:
+	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
+	_FORCE_INLINE_ RID get_self() const { return self; }
+
+	void set_space(GodotSpace2D *p_space);
+	_FORCE_INLINE_ GodotSpace2D *get_space() const { return space; }
+
+	void set_radius(real_t p_radius);
+	_FORCE_INLINE_ real_t get_radius() const { return radius; }
+
+	_FORCE_INLINE_ void set_collision_mask(uint32_t p_mask) { collision_mask = p_mask; }
+	_FORCE_INLINE_ uint32_t get_collision_mask() const { return collision_mask; }
+
+	void set_projectiles(const Vector<Vector2> &p_positions, const Vector<Vector2> &p_velocities);
+	_FORCE_INLINE_ const Vector<Vector2> &get_positions() const { return positions; }
+	_FORCE_INLINE_ const Vector<Vector2> &get_velocities() const { return velocities; }
+
+	_FORCE_INLINE_ int get_hit_count() const { return hits.size(); }
+	int get_hits(PhysicsServer2D::ProjectileHit *r_hits, int p_hit_max) const;
+
+	GodotProjectileBatch2D();
+	~GodotProjectileBatch2D();
+};
+
+#endif // GODOT_PROJECTILE_BATCH_2D_H
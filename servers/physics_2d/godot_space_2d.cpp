@@ -33,11 +33,13 @@
 #include "godot_collision_solver_2d.h"
 #include "godot_physics_server_2d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/templates/pair.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
+#define QUERY_BATCH_CHUNK_SIZE 64
 
 _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject2D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (!(p_object->get_collision_layer() & p_collision_mask)) {
@@ -55,6 +57,198 @@ _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject2D *p_object, u
 	return true;
 }
 
+// Removes the broadphase results a query can't collide with, keeping the others in order.
+static int _filter_query_results(GodotCollisionObject2D **r_objects, int *r_subindices, int p_amount, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, const HashSet<RID> &p_exclude) {
+	int valid_amount = 0;
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(r_objects[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+			continue;
+		}
+
+		if (p_exclude.has(r_objects[i]->get_self())) {
+			continue;
+		}
+
+		r_objects[valid_amount] = r_objects[i];
+		r_subindices[valid_amount] = r_subindices[i];
+		valid_amount++;
+	}
+	return valid_amount;
+}
+
+static bool _intersect_ray_with_objects(const Vector2 &p_from, const Vector2 &p_to, bool p_hit_from_inside, GodotCollisionObject2D *const *p_objects, const int *p_subindices, int p_amount, PhysicsDirectSpaceState2D::RayResult &r_result) {
+	Vector2 begin, end;
+	Vector2 normal;
+	begin = p_from;
+	end = p_to;
+	normal = (end - begin).normalized();
+
+	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
+
+	bool collided = false;
+	Vector2 res_point, res_normal;
+	int res_shape = -1;
+	const GodotCollisionObject2D *res_obj = nullptr;
+	real_t min_d = 1e10;
+
+	for (int i = 0; i < p_amount; i++) {
+		const GodotCollisionObject2D *col_obj = p_objects[i];
+
+		int shape_idx = p_subindices[i];
+		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
+
+		Vector2 local_from = inv_xform.xform(begin);
+		Vector2 local_to = inv_xform.xform(end);
+
+		const GodotShape2D *shape = col_obj->get_shape(shape_idx);
+
+		Vector2 shape_point, shape_normal;
+
+		if (shape->contains_point(local_from)) {
+			if (p_hit_from_inside) {
+				// Hit shape at starting point.
+				min_d = 0;
+				res_point = begin;
+				res_normal = Vector2();
+				res_shape = shape_idx;
+				res_obj = col_obj;
+				collided = true;
+				break;
+			} else {
+				// Ignore shape when starting inside.
+				continue;
+			}
+		}
+
+		if (shape->intersect_segment(local_from, local_to, shape_point, shape_normal)) {
+			Transform2D xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
+			shape_point = xform.xform(shape_point);
+
+			real_t ld = normal.dot(shape_point);
+
+			if (ld < min_d) {
+				min_d = ld;
+				res_point = shape_point;
+				res_normal = inv_xform.basis_xform_inv(shape_normal).normalized();
+				res_shape = shape_idx;
+				res_obj = col_obj;
+				collided = true;
+			}
+		}
+	}
+
+	if (!collided) {
+		return false;
+	}
+	ERR_FAIL_NULL_V(res_obj, false); // Shouldn't happen but silences warning.
+
+	r_result.collider_id = res_obj->get_instance_id();
+	if (r_result.collider_id.is_valid()) {
+		r_result.collider = ObjectDB::get_instance(r_result.collider_id);
+	}
+	r_result.normal = res_normal;
+	r_result.position = res_point;
+	r_result.rid = res_obj->get_self();
+	r_result.shape = res_shape;
+
+	return true;
+}
+
+static Rect2 _get_cast_motion_aabb(const GodotShape2D *p_shape, const Transform2D &p_transform, const Vector2 &p_motion, real_t p_margin) {
+	Rect2 aabb = p_transform.xform(p_shape->get_aabb());
+	aabb = aabb.merge(Rect2(aabb.position + p_motion, aabb.size)); //motion
+	aabb = aabb.grow(p_margin);
+	return aabb;
+}
+
+static void _cast_motion_with_objects(GodotShape2D *p_shape, const Transform2D &p_transform, const Vector2 &p_motion, real_t p_margin, GodotCollisionObject2D *const *p_objects, const int *p_subindices, int p_amount, real_t &p_closest_safe, real_t &p_closest_unsafe, int *r_closest_index = nullptr) {
+	real_t best_safe = 1;
+	real_t best_unsafe = 1;
+	int best_index = -1;
+
+	for (int i = 0; i < p_amount; i++) {
+		const GodotCollisionObject2D *col_obj = p_objects[i];
+		int shape_idx = p_subindices[i];
+
+		Transform2D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
+		//test initial overlap, does it collide if going all the way?
+		if (!GodotCollisionSolver2D::solve(p_shape, p_transform, p_motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_margin)) {
+			continue;
+		}
+
+		//test initial overlap, ignore objects it's inside of.
+		if (GodotCollisionSolver2D::solve(p_shape, p_transform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_margin)) {
+			continue;
+		}
+
+		Vector2 mnormal = p_motion.normalized();
+
+		//just do kinematic solving
+		real_t low = 0.0;
+		real_t hi = 1.0;
+		real_t fraction_coeff = 0.5;
+		for (int j = 0; j < 8; j++) { //steps should be customizable..
+			real_t fraction = low + (hi - low) * fraction_coeff;
+
+			Vector2 sep = mnormal; //important optimization for this to work fast enough
+			bool collided = GodotCollisionSolver2D::solve(p_shape, p_transform, p_motion * fraction, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, &sep, p_margin);
+
+			if (collided) {
+				hi = fraction;
+				if ((j == 0) || (low > 0.0)) { // Did it not collide before?
+					// When alternating or first iteration, use dichotomy.
+					fraction_coeff = 0.5;
+				} else {
+					// When colliding again, converge faster towards low fraction
+					// for more accurate results with long motions that collide near the start.
+					fraction_coeff = 0.25;
+				}
+			} else {
+				low = fraction;
+				if ((j == 0) || (hi < 1.0)) { // Did it collide before?
+					// When alternating or first iteration, use dichotomy.
+					fraction_coeff = 0.5;
+				} else {
+					// When not colliding again, converge faster towards high fraction
+					// for more accurate results with long motions that collide near the end.
+					fraction_coeff = 0.75;
+				}
+			}
+		}
+
+		if (low < best_safe) {
+			best_safe = low;
+			best_unsafe = hi;
+			best_index = i;
+		}
+	}
+
+	p_closest_safe = best_safe;
+	p_closest_unsafe = best_unsafe;
+	if (r_closest_index) {
+		*r_closest_index = best_index;
+	}
+}
+
+// Interleaves the lower 15 bits of p_value with a zero bit each.
+static _FORCE_INLINE_ uint64_t _spread_morton_bits(uint32_t p_value) {
+	uint64_t v = p_value & 0x7FFF;
+	v = (v | (v << 8)) & 0x00FF00FF;
+	v = (v | (v << 4)) & 0x0F0F0F0F;
+	v = (v | (v << 2)) & 0x33333333;
+	v = (v | (v << 1)) & 0x55555555;
+	return v;
+}
+
+static _FORCE_INLINE_ uint64_t _get_morton_code(const Vector2 &p_point, const Rect2 &p_bounds) {
+	uint64_t code = 0;
+	for (int i = 0; i < 2; i++) {
+		real_t t = p_bounds.size[i] > CMP_EPSILON ? (p_point[i] - p_bounds.position[i]) / p_bounds.size[i] : 0.0;
+		code |= _spread_morton_bits((uint32_t)CLAMP(t * 32767.0, 0.0, 32767.0)) << i;
+	}
+	return code;
+}
+
 int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -117,91 +311,128 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_par
 bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
 	ERR_FAIL_COND_V(space->locked, false);
 
-	Vector2 begin, end;
-	Vector2 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
-	normal = (end - begin).normalized();
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	amount = _filter_query_results(space->intersection_query_results, space->intersection_query_subindex_results, amount, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
-	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
-
-	bool collided = false;
-	Vector2 res_point, res_normal;
-	int res_shape = -1;
-	const GodotCollisionObject2D *res_obj = nullptr;
-	real_t min_d = 1e10;
-
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
-			continue;
-		}
+	return _intersect_ray_with_objects(p_parameters.from, p_parameters.to, p_parameters.hit_from_inside, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
-			continue;
-		}
+void GodotPhysicsDirectSpaceState2D::_build_query_batch(int p_count, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, const HashSet<RID> &p_exclude) {
+	// Sort the queries along a Morton curve over the start and end of their bounds.
+	Rect2 bounds = batch_aabbs[0];
+	for (int i = 1; i < p_count; i++) {
+		bounds = bounds.merge(batch_aabbs[i]);
+	}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+	batch_queries.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		const Rect2 &aabb = batch_aabbs[i];
+		batch_queries[i].key = (_get_morton_code(aabb.position, bounds) << 30) | _get_morton_code(aabb.get_end(), bounds);
+		batch_queries[i].index = i;
+	}
+	batch_queries.sort();
 
-		int shape_idx = space->intersection_query_subindex_results[i];
-		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
+	// Cull each chunk of neighboring queries once.
+	batch_chunks.clear();
+	batch_objects.clear();
+	batch_subindices.clear();
 
-		Vector2 local_from = inv_xform.xform(begin);
-		Vector2 local_to = inv_xform.xform(end);
+	for (uint32_t query_begin = 0; query_begin < (uint32_t)p_count; query_begin += QUERY_BATCH_CHUNK_SIZE) {
+		BatchChunk chunk;
+		chunk.query_begin = query_begin;
+		chunk.query_end = MIN(query_begin + QUERY_BATCH_CHUNK_SIZE, (uint32_t)p_count);
 
-		const GodotShape2D *shape = col_obj->get_shape(shape_idx);
+		Rect2 chunk_aabb = batch_aabbs[batch_queries[chunk.query_begin].index];
+		for (uint32_t i = chunk.query_begin + 1; i < chunk.query_end; i++) {
+			chunk_aabb = chunk_aabb.merge(batch_aabbs[batch_queries[i].index]);
+		}
 
-		Vector2 shape_point, shape_normal;
+		int amount = space->broadphase->cull_aabb(chunk_aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+		if (amount >= GodotSpace2D::INTERSECTION_QUERY_MAX) {
+			// Some candidates could be missing.
+			chunk.overflow = true;
+			amount = 0;
+		}
+		amount = _filter_query_results(space->intersection_query_results, space->intersection_query_subindex_results, amount, p_collision_mask, p_collide_with_bodies, p_collide_with_areas, p_exclude);
 
-		if (shape->contains_point(local_from)) {
-			if (p_parameters.hit_from_inside) {
-				// Hit shape at starting point.
-				min_d = 0;
-				res_point = begin;
-				res_normal = Vector2();
-				res_shape = shape_idx;
-				res_obj = col_obj;
-				collided = true;
-				break;
-			} else {
-				// Ignore shape when starting inside.
-				continue;
-			}
+		chunk.object_begin = batch_objects.size();
+		for (int i = 0; i < amount; i++) {
+			batch_objects.push_back(space->intersection_query_results[i]);
+			batch_subindices.push_back(space->intersection_query_subindex_results[i]);
 		}
+		chunk.object_end = batch_objects.size();
 
-		if (shape->intersect_segment(local_from, local_to, shape_point, shape_normal)) {
-			Transform2D xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
-			shape_point = xform.xform(shape_point);
+		batch_chunks.push_back(chunk);
+	}
+}
 
-			real_t ld = normal.dot(shape_point);
+void GodotPhysicsDirectSpaceState2D::_intersect_ray_batch_chunk(uint32_t p_chunk_index, RayBatch *p_batch) {
+	const BatchChunk &chunk = batch_chunks[p_chunk_index];
+	if (chunk.overflow) {
+		return;
+	}
 
-			if (ld < min_d) {
-				min_d = ld;
-				res_point = shape_point;
-				res_normal = inv_xform.basis_xform_inv(shape_normal).normalized();
-				res_shape = shape_idx;
-				res_obj = col_obj;
-				collided = true;
+	LocalVector<GodotCollisionObject2D *> objects;
+	LocalVector<int> subindices;
+	objects.reserve(chunk.object_end - chunk.object_begin);
+	subindices.reserve(chunk.object_end - chunk.object_begin);
+
+	for (uint32_t i = chunk.query_begin; i < chunk.query_end; i++) {
+		uint32_t query_index = batch_queries[i].index;
+		const Vector2 &from = p_batch->from[query_index];
+		const Vector2 &to = p_batch->to[query_index];
+
+		objects.clear();
+		subindices.clear();
+		for (uint32_t j = chunk.object_begin; j < chunk.object_end; j++) {
+			if (batch_objects[j]->get_shape_aabb(batch_subindices[j]).intersects_segment(from, to)) {
+				objects.push_back(batch_objects[j]);
+				subindices.push_back(batch_subindices[j]);
 			}
 		}
+
+		p_batch->hits[query_index] = _intersect_ray_with_objects(from, to, p_batch->parameters->hit_from_inside, objects.ptr(), subindices.ptr(), objects.size(), p_batch->results[query_index]);
 	}
+}
 
-	if (!collided) {
-		return false;
+void GodotPhysicsDirectSpaceState2D::intersect_ray_batch(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+	if (p_count <= 0) {
+		return;
 	}
-	ERR_FAIL_NULL_V(res_obj, false); // Shouldn't happen but silences warning.
 
-	r_result.collider_id = res_obj->get_instance_id();
-	if (r_result.collider_id.is_valid()) {
-		r_result.collider = ObjectDB::get_instance(r_result.collider_id);
+	batch_aabbs.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		Rect2 aabb(p_from[i], Vector2());
+		aabb.expand_to(p_to[i]);
+		batch_aabbs[i] = aabb;
 	}
-	r_result.normal = res_normal;
-	r_result.position = res_point;
-	r_result.rid = res_obj->get_self();
-	r_result.shape = res_shape;
 
-	return true;
+	_build_query_batch(p_count, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_intersect_ray_batch_chunk, &batch, batch_chunks.size(), -1, true, SNAME("Physics2DRayBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Warning: This doesn't run on threads, because it uses the space's query buffers.
+	RayParameters parameters = p_parameters;
+	for (const BatchChunk &chunk : batch_chunks) {
+		if (!chunk.overflow) {
+			continue;
+		}
+		for (uint32_t i = chunk.query_begin; i < chunk.query_end; i++) {
+			uint32_t query_index = batch_queries[i].index;
+			parameters.from = p_from[query_index];
+			parameters.to = p_to[query_index];
+			r_hits[query_index] = intersect_ray(parameters, r_results[query_index]);
+		}
+	}
 }
 
 int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
@@ -257,83 +488,83 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
 
-	Rect2 aabb = p_parameters.transform.xform(shape->get_aabb());
-	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
-	aabb = aabb.grow(p_parameters.margin);
+	Rect2 aabb = _get_cast_motion_aabb(shape, p_parameters.transform, p_parameters.motion, p_parameters.margin);
 
 	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	amount = _filter_query_results(space->intersection_query_results, space->intersection_query_subindex_results, amount, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
 
-	real_t best_safe = 1;
-	real_t best_unsafe = 1;
+	_cast_motion_with_objects(shape, p_parameters.transform, p_parameters.motion, p_parameters.margin, space->intersection_query_results, space->intersection_query_subindex_results, amount, p_closest_safe, p_closest_unsafe);
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
-			continue;
-		}
+	return true;
+}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
-			continue; //ignore excluded
+void GodotPhysicsDirectSpaceState2D::_cast_motion_batch_chunk(uint32_t p_chunk_index, MotionBatch *p_batch) {
+	const BatchChunk &chunk = batch_chunks[p_chunk_index];
+	if (chunk.overflow) {
+		return;
+	}
+
+	LocalVector<GodotCollisionObject2D *> objects;
+	LocalVector<int> subindices;
+	objects.reserve(chunk.object_end - chunk.object_begin);
+	subindices.reserve(chunk.object_end - chunk.object_begin);
+
+	for (uint32_t i = chunk.query_begin; i < chunk.query_end; i++) {
+		uint32_t query_index = batch_queries[i].index;
+		const Rect2 &aabb = batch_aabbs[query_index];
+
+		objects.clear();
+		subindices.clear();
+		for (uint32_t j = chunk.object_begin; j < chunk.object_end; j++) {
+			if (batch_objects[j]->get_shape_aabb(batch_subindices[j]).intersects(aabb)) {
+				objects.push_back(batch_objects[j]);
+				subindices.push_back(batch_subindices[j]);
+			}
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		_cast_motion_with_objects(p_batch->shape, p_batch->transforms[query_index], p_batch->motions[query_index], p_batch->parameters->margin, objects.ptr(), subindices.ptr(), objects.size(), p_batch->closest_safe[query_index], p_batch->closest_unsafe[query_index]);
+	}
+}
 
-		Transform2D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
-		//test initial overlap, does it collide if going all the way?
-		if (!GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
-			continue;
-		}
+void GodotPhysicsDirectSpaceState2D::cast_motion_batch(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	if (p_count <= 0) {
+		return;
+	}
 
-		//test initial overlap, ignore objects it's inside of.
-		if (GodotCollisionSolver2D::solve(shape, p_parameters.transform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
-			continue;
-		}
+	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
 
-		Vector2 mnormal = p_parameters.motion.normalized();
+	batch_aabbs.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		batch_aabbs[i] = _get_cast_motion_aabb(shape, p_transforms[i], p_motions[i], p_parameters.margin);
+	}
 
-		//just do kinematic solving
-		real_t low = 0.0;
-		real_t hi = 1.0;
-		real_t fraction_coeff = 0.5;
-		for (int j = 0; j < 8; j++) { //steps should be customizable..
-			real_t fraction = low + (hi - low) * fraction_coeff;
+	_build_query_batch(p_count, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
 
-			Vector2 sep = mnormal; //important optimization for this to work fast enough
-			bool collided = GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion * fraction, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, &sep, p_parameters.margin);
+	MotionBatch batch;
+	batch.shape = shape;
+	batch.parameters = &p_parameters;
+	batch.transforms = p_transforms;
+	batch.motions = p_motions;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
 
-			if (collided) {
-				hi = fraction;
-				if ((j == 0) || (low > 0.0)) { // Did it not collide before?
-					// When alternating or first iteration, use dichotomy.
-					fraction_coeff = 0.5;
-				} else {
-					// When colliding again, converge faster towards low fraction
-					// for more accurate results with long motions that collide near the start.
-					fraction_coeff = 0.25;
-				}
-			} else {
-				low = fraction;
-				if ((j == 0) || (hi < 1.0)) { // Did it collide before?
-					// When alternating or first iteration, use dichotomy.
-					fraction_coeff = 0.5;
-				} else {
-					// When not colliding again, converge faster towards high fraction
-					// for more accurate results with long motions that collide near the end.
-					fraction_coeff = 0.75;
-				}
-			}
-		}
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_cast_motion_batch_chunk, &batch, batch_chunks.size(), -1, true, SNAME("Physics2DCastMotionBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
-		if (low < best_safe) {
-			best_safe = low;
-			best_unsafe = hi;
+	// Warning: This doesn't run on threads, because it uses the space's query buffers.
+	ShapeParameters parameters = p_parameters;
+	for (const BatchChunk &chunk : batch_chunks) {
+		if (!chunk.overflow) {
+			continue;
+		}
+		for (uint32_t i = chunk.query_begin; i < chunk.query_end; i++) {
+			uint32_t query_index = batch_queries[i].index;
+			parameters.transform = p_transforms[query_index];
+			parameters.motion = p_motions[query_index];
+			cast_motion(parameters, r_closest_safe[query_index], r_closest_unsafe[query_index]);
 		}
 	}
-
-	p_closest_safe = best_safe;
-	p_closest_unsafe = best_unsafe;
-
-	return true;
 }
 
 bool GodotPhysicsDirectSpaceState2D::collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) {
@@ -1116,6 +1347,18 @@ const SelfList<GodotArea2D>::List &GodotSpace2D::get_moved_area_list() const {
 	return area_moved_list;
 }
 
+void GodotSpace2D::add_projectile_batch(SelfList<GodotProjectileBatch2D> *p_batch) {
+	projectile_batch_list.add(p_batch);
+}
+
+void GodotSpace2D::remove_projectile_batch(SelfList<GodotProjectileBatch2D> *p_batch) {
+	projectile_batch_list.remove(p_batch);
+}
+
+const SelfList<GodotProjectileBatch2D>::List &GodotSpace2D::get_projectile_batch_list() const {
+	return projectile_batch_list;
+}
+
 void GodotSpace2D::call_queries() {
 	while (state_query_list.first()) {
 		GodotBody2D *b = state_query_list.first()->self();
@@ -1139,6 +1382,512 @@ void GodotSpace2D::setup() {
 	}
 }
 
+// Rigid bodies are left out, so that hits don't depend on the order in which bodies
+// and projectiles move within a step.
+_FORCE_INLINE_ static bool _can_projectile_hit(const GodotCollisionObject2D *p_object, uint32_t p_collision_mask) {
+	if (p_object->get_type() != GodotCollisionObject2D::TYPE_BODY || !(p_object->get_collision_layer() & p_collision_mask)) {
+		return false;
+	}
+
+	return static_cast<const GodotBody2D *>(p_object)->get_mode() <= PhysicsServer2D::BODY_MODE_KINEMATIC;
+}
+
+static int _filter_projectile_candidates(GodotCollisionObject2D **r_objects, int *r_subindices, int p_amount, uint32_t p_collision_mask) {
+	int valid_amount = 0;
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_projectile_hit(r_objects[i], p_collision_mask)) {
+			continue;
+		}
+
+		r_objects[valid_amount] = r_objects[i];
+		r_subindices[valid_amount] = r_subindices[i];
+		valid_amount++;
+	}
+	return valid_amount;
+}
+
+void GodotSpace2D::_step_projectile(GodotProjectileBatch2D *p_batch, uint32_t p_index, GodotCollisionObject2D *const *p_candidates, const int *p_candidate_subindices, int p_candidate_count, LocalVector<GodotCollisionObject2D *> &r_objects, LocalVector<int> &r_subindices) {
+	const Vector2 from = p_batch->step_positions[p_index];
+	const Vector2 motion = p_batch->step_velocities[p_index] * p_batch->step_delta;
+	const Rect2 &aabb = p_batch->step_aabbs[p_index];
+
+	r_objects.clear();
+	r_subindices.clear();
+	for (int i = 0; i < p_candidate_count; i++) {
+		if (p_candidates[i]->get_shape_aabb(p_candidate_subindices[i]).intersects(aabb)) {
+			r_objects.push_back(p_candidates[i]);
+			r_subindices.push_back(p_candidate_subindices[i]);
+		}
+	}
+
+	PhysicsServer2D::ProjectileHit &hit = p_batch->step_hits[p_index];
+
+	if (r_objects.is_empty()) {
+		p_batch->step_positions[p_index] = from + motion;
+		return;
+	}
+
+	if (p_batch->radius == 0.0) {
+		PhysicsDirectSpaceState2D::RayResult result;
+		if (!_intersect_ray_with_objects(from, from + motion, false, r_objects.ptr(), r_subindices.ptr(), r_objects.size(), result)) {
+			p_batch->step_positions[p_index] = from + motion;
+			return;
+		}
+
+		hit.projectile = p_index;
+		hit.position = result.position;
+		hit.normal = result.normal;
+		hit.collider_id = result.collider_id;
+		hit.collider = result.rid;
+		hit.collider_shape = result.shape;
+
+		p_batch->step_positions[p_index] = result.position;
+		p_batch->step_velocities[p_index] = Vector2();
+		return;
+	}
+
+	Transform2D xform(0.0, from);
+	real_t closest_safe = 1.0;
+	real_t closest_unsafe = 1.0;
+	int closest_index = -1;
+	_cast_motion_with_objects(&p_batch->circle_shape, xform, motion, 0.0, r_objects.ptr(), r_subindices.ptr(), r_objects.size(), closest_safe, closest_unsafe, &closest_index);
+
+	if (closest_index < 0) {
+		p_batch->step_positions[p_index] = from + motion;
+		return;
+	}
+
+	const GodotCollisionObject2D *col_obj = r_objects[closest_index];
+	int shape_idx = r_subindices[closest_index];
+
+	// Find the contact where the circle first overlaps the collider.
+	_RestCallbackData2D rcd;
+	rcd.object = col_obj;
+	rcd.shape = shape_idx;
+	xform.columns[2] = from + motion * closest_unsafe;
+	GodotCollisionSolver2D::solve(&p_batch->circle_shape, xform, Vector2(), col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), Vector2(), _rest_cbk_result, &rcd);
+
+	hit.projectile = p_index;
+	if (rcd.best_len > 0.0) {
+		hit.position = rcd.best_contact;
+		hit.normal = rcd.best_normal;
+	} else {
+		hit.normal = -motion.normalized();
+		hit.position = xform.columns[2] - hit.normal * p_batch->radius;
+	}
+	hit.collider_id = col_obj->get_instance_id();
+	hit.collider = col_obj->get_self();
+	hit.collider_shape = shape_idx;
+
+	p_batch->step_positions[p_index] = from + motion * closest_safe;
+	p_batch->step_velocities[p_index] = Vector2();
+}
+
+void GodotSpace2D::_step_projectile_chunk(uint32_t p_chunk_index, GodotProjectileBatch2D *p_batch) {
+	const GodotProjectileBatch2D::StepChunk &chunk = p_batch->step_chunks[p_chunk_index];
+	if (chunk.overflow) {
+		return;
+	}
+
+	LocalVector<GodotCollisionObject2D *> hit_candidates;
+	LocalVector<int> hit_subindices;
+	hit_candidates.reserve(chunk.object_end - chunk.object_begin);
+	hit_subindices.reserve(chunk.object_end - chunk.object_begin);
+
+	GodotCollisionObject2D *const *candidates = p_batch->step_objects.ptr() + chunk.object_begin;
+	const int *candidate_subindices = p_batch->step_subindices.ptr() + chunk.object_begin;
+	int candidate_count = chunk.object_end - chunk.object_begin;
+
+	for (uint32_t i = chunk.projectile_begin; i < chunk.projectile_end; i++) {
+		_step_projectile(p_batch, p_batch->step_projectiles[i].index, candidates, candidate_subindices, candidate_count, hit_candidates, hit_subindices);
+	}
+}
+
+void GodotSpace2D::_step_projectile_batch(GodotProjectileBatch2D *p_batch, real_t p_step) {
+	p_batch->hits.clear();
+
+	int count = p_batch->positions.size();
+	if (count == 0) {
+		return;
+	}
+
+	p_batch->step_delta = p_step;
+	p_batch->step_positions = p_batch->positions.ptrw();
+	p_batch->step_velocities = p_batch->velocities.ptrw();
+	p_batch->step_aabbs.resize(count);
+	p_batch->step_hits.resize(count);
+	p_batch->step_projectiles.clear();
+
+	// Stopped projectiles (with a zero velocity) are skipped.
+	Rect2 bounds;
+	for (int i = 0; i < count; i++) {
+		p_batch->step_hits[i].projectile = -1;
+
+		const Vector2 &from = p_batch->step_positions[i];
+		const Vector2 &velocity = p_batch->step_velocities[i];
+		if (velocity == Vector2()) {
+			continue;
+		}
+
+		Rect2 aabb(from, Vector2());
+		aabb.expand_to(from + velocity * p_step);
+		aabb = aabb.grow(p_batch->radius);
+		p_batch->step_aabbs[i] = aabb;
+
+		bounds = p_batch->step_projectiles.is_empty() ? aabb : bounds.merge(aabb);
+
+		GodotProjectileBatch2D::StepProjectile projectile;
+		projectile.index = i;
+		p_batch->step_projectiles.push_back(projectile);
+	}
+
+	uint32_t moving_count = p_batch->step_projectiles.size();
+	if (moving_count == 0) {
+		return;
+	}
+
+	// Sort the projectiles along a Morton curve over the start and end of their bounds.
+	for (GodotProjectileBatch2D::StepProjectile &projectile : p_batch->step_projectiles) {
+		const Rect2 &aabb = p_batch->step_aabbs[projectile.index];
+		projectile.key = (_get_morton_code(aabb.position, bounds) << 30) | _get_morton_code(aabb.get_end(), bounds);
+	}
+	p_batch->step_projectiles.sort();
+
+	// Cull each chunk of neighboring projectiles once.
+	p_batch->step_chunks.clear();
+	p_batch->step_objects.clear();
+	p_batch->step_subindices.clear();
+
+	for (uint32_t projectile_begin = 0; projectile_begin < moving_count; projectile_begin += QUERY_BATCH_CHUNK_SIZE) {
+		GodotProjectileBatch2D::StepChunk chunk;
+		chunk.projectile_begin = projectile_begin;
+		chunk.projectile_end = MIN(projectile_begin + QUERY_BATCH_CHUNK_SIZE, moving_count);
+
+		Rect2 chunk_aabb = p_batch->step_aabbs[p_batch->step_projectiles[chunk.projectile_begin].index];
+		for (uint32_t i = chunk.projectile_begin + 1; i < chunk.projectile_end; i++) {
+			chunk_aabb = chunk_aabb.merge(p_batch->step_aabbs[p_batch->step_projectiles[i].index]);
+		}
+
+		int amount = broadphase->cull_aabb(chunk_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+		if (amount >= INTERSECTION_QUERY_MAX) {
+			// Some candidates could be missing.
+			chunk.overflow = true;
+			amount = 0;
+		}
+		amount = _filter_projectile_candidates(intersection_query_results, intersection_query_subindex_results, amount, p_batch->collision_mask);
+
+		chunk.object_begin = p_batch->step_objects.size();
+		for (int i = 0; i < amount; i++) {
+			p_batch->step_objects.push_back(intersection_query_results[i]);
+			p_batch->step_subindices.push_back(intersection_query_subindex_results[i]);
+		}
+		chunk.object_end = p_batch->step_objects.size();
+
+		p_batch->step_chunks.push_back(chunk);
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotSpace2D::_step_projectile_chunk, p_batch, p_batch->step_chunks.size(), -1, true, SNAME("Physics2DStepProjectiles"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Warning: This doesn't run on threads, because it uses the space's query buffers.
+	LocalVector<GodotCollisionObject2D *> hit_candidates;
+	LocalVector<int> hit_subindices;
+	for (const GodotProjectileBatch2D::StepChunk &chunk : p_batch->step_chunks) {
+		if (!chunk.overflow) {
+			continue;
+		}
+		for (uint32_t i = chunk.projectile_begin; i < chunk.projectile_end; i++) {
+			uint32_t index = p_batch->step_projectiles[i].index;
+			int amount = broadphase->cull_aabb(p_batch->step_aabbs[index], intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+			amount = _filter_projectile_candidates(intersection_query_results, intersection_query_subindex_results, amount, p_batch->collision_mask);
+			_step_projectile(p_batch, index, intersection_query_results, intersection_query_subindex_results, amount, hit_candidates, hit_subindices);
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		if (p_batch->step_hits[i].projectile >= 0) {
+			p_batch->hits.push_back(p_batch->step_hits[i]);
+		}
+	}
+
+	p_batch->step_positions = nullptr;
+	p_batch->step_velocities = nullptr;
+}
+
+void GodotSpace2D::step_projectile_batches(real_t p_step) {
+	for (SelfList<GodotProjectileBatch2D> *E = projectile_batch_list.first(); E; E = E->next()) {
+		_step_projectile_batch(E->self(), p_step);
+	}
+}
+
+// Snapshots use the native byte order and real_t size, they are meant to be restored
+// by the same build (e.g. in rollback networking), not stored or sent across platforms.
+static const uint32_t SNAPSHOT_MAGIC = 0x50535347; // "GSSP"
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+template <typename T>
+static _FORCE_INLINE_ void _snapshot_write(LocalVector<uint8_t> &r_data, const T &p_value) {
+	GodotConstraint2D::state_write(r_data, p_value);
+}
+
+template <typename T>
+static _FORCE_INLINE_ bool _snapshot_read(const uint8_t *&r_data, const uint8_t *p_end, T &r_value) {
+	return GodotConstraint2D::state_read(r_data, p_end, r_value);
+}
+
+static _FORCE_INLINE_ void _snapshot_patch(LocalVector<uint8_t> &r_data, uint32_t p_offset, uint32_t p_value) {
+	memcpy(r_data.ptr() + p_offset, &p_value, sizeof(uint32_t));
+}
+
+void GodotSpace2D::_gather_snapshot_constraints() {
+	// Each constraint is referenced by all of its bodies, list it only once but keep the
+	// order in which the bodies reference them, so it's the same for equal spaces.
+	// Constraints which can't be found again by key (e.g. area pairs) are left out.
+	snapshot_constraint_list.clear();
+	snapshot_constraint_indices.clear();
+	for (GodotCollisionObject2D *E : objects) {
+		if (E->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+		for (const Pair<GodotConstraint2D *, int> &F : static_cast<GodotBody2D *>(E)->get_constraint_list()) {
+			if (!snapshot_constraint_indices.has(F.first) && F.first->get_state_key().object_A != 0) {
+				snapshot_constraint_indices.insert(F.first, snapshot_constraint_list.size());
+				snapshot_constraint_list.push_back(F.first);
+			}
+		}
+	}
+}
+
+void GodotSpace2D::_restore_snapshot_constraint_order(GodotBody2D *p_body, const SnapshotBody &p_snapshot) {
+	// Islands are built, and so constraints are solved, in the order bodies reference them.
+	// Pairs removed and created again since the snapshot was saved would be solved in a
+	// different order otherwise, so the results wouldn't match when simulating again.
+	snapshot_constraint_order.clear();
+	bool sorted = true;
+	for (const Pair<GodotConstraint2D *, int> &F : p_body->get_constraint_list()) {
+		SnapshotConstraintOrder order;
+		order.constraint = F.first;
+		order.position = F.second;
+		// Constraints that weren't in the snapshot go last, in their current order.
+		order.rank = p_snapshot.constraint_count + snapshot_constraint_order.size();
+
+		const SnapshotConstraint *constraint = snapshot_constraints.getptr(F.first->get_state_key());
+		if (constraint) {
+			for (uint32_t i = 0; i < p_snapshot.constraint_count; i++) {
+				if (snapshot_body_constraints[p_snapshot.constraints_from + i] == constraint->index) {
+					order.rank = i;
+					break;
+				}
+			}
+		}
+
+		if (!snapshot_constraint_order.is_empty() && order.rank < snapshot_constraint_order[snapshot_constraint_order.size() - 1].rank) {
+			sorted = false;
+		}
+		snapshot_constraint_order.push_back(order);
+	}
+
+	if (sorted) {
+		return;
+	}
+
+	snapshot_constraint_order.sort();
+	p_body->clear_constraint_list();
+	for (const SnapshotConstraintOrder &E : snapshot_constraint_order) {
+		p_body->add_constraint(E.constraint, E.position);
+	}
+}
+
+Vector<uint8_t> GodotSpace2D::save_snapshot() {
+	snapshot_data.clear();
+	_snapshot_write(snapshot_data, SNAPSHOT_MAGIC);
+	_snapshot_write(snapshot_data, SNAPSHOT_VERSION);
+	_snapshot_write(snapshot_data, (uint32_t)sizeof(real_t));
+
+	_gather_snapshot_constraints();
+	_snapshot_write(snapshot_data, (uint32_t)snapshot_constraint_list.size());
+	for (const GodotConstraint2D *constraint : snapshot_constraint_list) {
+		GodotConstraint2D::StateKey key = constraint->get_state_key();
+		_snapshot_write(snapshot_data, key.object_A);
+		_snapshot_write(snapshot_data, key.object_B);
+		_snapshot_write(snapshot_data, key.shape_A);
+		_snapshot_write(snapshot_data, key.shape_B);
+
+		uint32_t size_offset = snapshot_data.size();
+		_snapshot_write(snapshot_data, (uint32_t)0);
+		constraint->save_state(snapshot_data);
+		_snapshot_patch(snapshot_data, size_offset, snapshot_data.size() - size_offset - sizeof(uint32_t));
+	}
+
+	uint32_t count_offset = snapshot_data.size();
+	uint32_t count = 0;
+	_snapshot_write(snapshot_data, count);
+
+	GodotBody2D::SnapshotState state;
+	for (GodotCollisionObject2D *E : objects) {
+		if (E->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+		GodotBody2D *body = static_cast<GodotBody2D *>(E);
+		body->get_snapshot_state(state);
+		_snapshot_write(snapshot_data, body->get_self().get_id());
+		_snapshot_write(snapshot_data, state.transform);
+		_snapshot_write(snapshot_data, state.new_transform);
+		_snapshot_write(snapshot_data, state.linear_velocity);
+		_snapshot_write(snapshot_data, state.angular_velocity);
+		_snapshot_write(snapshot_data, state.prev_linear_velocity);
+		_snapshot_write(snapshot_data, state.prev_angular_velocity);
+		_snapshot_write(snapshot_data, state.applied_force);
+		_snapshot_write(snapshot_data, state.applied_torque);
+		_snapshot_write(snapshot_data, state.still_time);
+		_snapshot_write(snapshot_data, state.first_time_kinematic);
+
+		uint32_t constraint_count_offset = snapshot_data.size();
+		uint32_t constraint_count = 0;
+		_snapshot_write(snapshot_data, constraint_count);
+		for (const Pair<GodotConstraint2D *, int> &F : body->get_constraint_list()) {
+			const uint32_t *index = snapshot_constraint_indices.getptr(F.first);
+			if (index) {
+				_snapshot_write(snapshot_data, *index);
+				constraint_count++;
+			}
+		}
+		_snapshot_patch(snapshot_data, constraint_count_offset, constraint_count);
+		count++;
+	}
+	_snapshot_patch(snapshot_data, count_offset, count);
+
+	// The active list decides in which order bodies are integrated and islands are built,
+	// so it's stored in order instead of as a flag on each body.
+	count_offset = snapshot_data.size();
+	count = 0;
+	_snapshot_write(snapshot_data, count);
+	for (const SelfList<GodotBody2D> *E = active_list.first(); E; E = E->next()) {
+		_snapshot_write(snapshot_data, E->self()->get_self().get_id());
+		count++;
+	}
+	_snapshot_patch(snapshot_data, count_offset, count);
+
+	Vector<uint8_t> snapshot;
+	snapshot.resize(snapshot_data.size());
+	memcpy(snapshot.ptrw(), snapshot_data.ptr(), snapshot_data.size());
+	return snapshot;
+}
+
+Error GodotSpace2D::restore_snapshot(const uint8_t *p_data, int p_size) {
+	ERR_FAIL_COND_V(locked, ERR_LOCKED);
+
+	const uint8_t *r = p_data;
+	const uint8_t *end = p_data + p_size;
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t real_size = 0;
+	ERR_FAIL_COND_V_MSG(!_snapshot_read(r, end, magic) || magic != SNAPSHOT_MAGIC, ERR_FILE_UNRECOGNIZED, "Invalid physics space snapshot.");
+	ERR_FAIL_COND_V_MSG(!_snapshot_read(r, end, version) || version != SNAPSHOT_VERSION || !_snapshot_read(r, end, real_size) || real_size != sizeof(real_t), ERR_FILE_UNRECOGNIZED, "Physics space snapshot was saved by an incompatible build.");
+
+	// Read everything first, so a corrupt snapshot leaves the space untouched.
+	uint32_t count = 0;
+	bool valid = _snapshot_read(r, end, count);
+	snapshot_constraints.clear();
+	for (uint32_t i = 0; valid && i < count; i++) {
+		GodotConstraint2D::StateKey key;
+		SnapshotConstraint constraint;
+		constraint.index = i;
+		valid = _snapshot_read(r, end, key.object_A) &&
+				_snapshot_read(r, end, key.object_B) &&
+				_snapshot_read(r, end, key.shape_A) &&
+				_snapshot_read(r, end, key.shape_B) &&
+				_snapshot_read(r, end, constraint.size) &&
+				constraint.size <= (uint32_t)(end - r);
+		if (valid) {
+			constraint.data = r;
+			r += constraint.size;
+			snapshot_constraints.insert(key, constraint);
+		}
+	}
+	ERR_FAIL_COND_V(!valid, ERR_FILE_CORRUPT);
+
+	ERR_FAIL_COND_V(!_snapshot_read(r, end, count) || count > (end - r) / sizeof(uint64_t), ERR_FILE_CORRUPT);
+	snapshot_bodies.resize(count);
+	snapshot_body_constraints.clear();
+	for (uint32_t i = 0; valid && i < count; i++) {
+		SnapshotBody &body = snapshot_bodies[i];
+		valid = _snapshot_read(r, end, body.id) &&
+				_snapshot_read(r, end, body.state.transform) &&
+				_snapshot_read(r, end, body.state.new_transform) &&
+				_snapshot_read(r, end, body.state.linear_velocity) &&
+				_snapshot_read(r, end, body.state.angular_velocity) &&
+				_snapshot_read(r, end, body.state.prev_linear_velocity) &&
+				_snapshot_read(r, end, body.state.prev_angular_velocity) &&
+				_snapshot_read(r, end, body.state.applied_force) &&
+				_snapshot_read(r, end, body.state.applied_torque) &&
+				_snapshot_read(r, end, body.state.still_time) &&
+				_snapshot_read(r, end, body.state.first_time_kinematic) &&
+				_snapshot_read(r, end, body.constraint_count) &&
+				body.constraint_count <= (end - r) / sizeof(uint32_t);
+		if (valid) {
+			body.constraints_from = snapshot_body_constraints.size();
+			snapshot_body_constraints.resize(body.constraints_from + body.constraint_count);
+			for (uint32_t j = 0; j < body.constraint_count; j++) {
+				_snapshot_read(r, end, snapshot_body_constraints[body.constraints_from + j]);
+			}
+		}
+	}
+	ERR_FAIL_COND_V(!valid, ERR_FILE_CORRUPT);
+
+	ERR_FAIL_COND_V(!_snapshot_read(r, end, count) || count != (end - r) / sizeof(uint64_t) || (end - r) % sizeof(uint64_t) != 0, ERR_FILE_CORRUPT);
+	snapshot_active_bodies.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		_snapshot_read(r, end, snapshot_active_bodies[i]);
+	}
+
+	snapshot_body_map.clear();
+	for (GodotCollisionObject2D *E : objects) {
+		if (E->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			snapshot_body_map.insert(E->get_self().get_id(), static_cast<GodotBody2D *>(E));
+		}
+	}
+
+	// Bodies created after the snapshot was saved are left as they are, and the ones
+	// removed since then are skipped.
+	for (const SnapshotBody &E : snapshot_bodies) {
+		GodotBody2D **body = snapshot_body_map.getptr(E.id);
+		if (body) {
+			(*body)->set_active(false);
+			(*body)->set_snapshot_state(E.state);
+		}
+	}
+	for (uint64_t id : snapshot_active_bodies) {
+		GodotBody2D **body = snapshot_body_map.getptr(id);
+		if (body) {
+			(*body)->set_active(true);
+		}
+	}
+
+	// Create the pairs for the restored transforms right away, so their contacts can be restored as well.
+	update();
+
+	_gather_snapshot_constraints();
+	for (GodotConstraint2D *constraint : snapshot_constraint_list) {
+		const SnapshotConstraint *E = snapshot_constraints.getptr(constraint->get_state_key());
+		if (!E) {
+			constraint->reset_state();
+			continue;
+		}
+		ERR_CONTINUE_MSG(!constraint->load_state(E->data, E->size), "Invalid constraint state in physics space snapshot.");
+	}
+
+	for (const SnapshotBody &E : snapshot_bodies) {
+		GodotBody2D **body = snapshot_body_map.getptr(E.id);
+		if (body) {
+			_restore_snapshot_constraint_order(*body, E);
+		}
+	}
+
+	return OK;
+}
+
 void GodotSpace2D::update() {
 	broadphase->update();
 }
@@ -1215,6 +1964,68 @@ GodotPhysicsDirectSpaceState2D *GodotSpace2D::get_direct_state() {
 	return direct_access;
 }
 
+const char *GodotSpace2D::get_elapsed_time_name(ElapsedTime p_time) {
+	static const char *time_name[ELAPSED_TIME_MAX] = {
+		"integrate_forces",
+		"broadphase",
+		"generate_islands",
+		"setup_constraints",
+		"solve_constraints",
+		"integrate_velocities",
+		"step_projectiles"
+	};
+	return time_name[p_time];
+}
+
+void GodotSpace2D::set_profiling(bool p_enable) {
+	profiling = p_enable;
+	profile.clear();
+}
+
+Dictionary GodotSpace2D::get_profile_info() const {
+	Dictionary info;
+
+	Dictionary phase_times;
+	uint64_t step_time = 0;
+	for (int i = 0; i < ELAPSED_TIME_MAX; i++) {
+		phase_times[get_elapsed_time_name(ElapsedTime(i))] = USEC_TO_SEC(elapsed_time[i]);
+		step_time += elapsed_time[i];
+	}
+	info["phase_times"] = phase_times;
+	info["step_time"] = USEC_TO_SEC(step_time);
+	info["active_objects"] = active_objects;
+	info["collision_pairs"] = collision_pairs;
+	info["island_count"] = island_count;
+	info["constraint_count"] = step_constraint_count;
+	info["solver_iterations"] = solver_iterations;
+
+	if (!profiling) {
+		return info;
+	}
+
+	info["rigid_bodies"] = profile.rigid_bodies;
+	info["sleeping_bodies"] = profile.sleeping_bodies;
+
+	PackedInt32Array island_sizes;
+	island_sizes.resize(Profile::ISLAND_SIZE_BUCKETS);
+	for (int i = 0; i < Profile::ISLAND_SIZE_BUCKETS; i++) {
+		island_sizes.write[i] = profile.island_sizes[i];
+	}
+	info["island_sizes"] = island_sizes;
+
+	Dictionary pair_tests;
+	for (int i = 0; i < Profile::SHAPE_TYPE_COUNT; i++) {
+		for (int j = i; j < Profile::SHAPE_TYPE_COUNT; j++) {
+			if (profile.pair_tests[i][j] > 0) {
+				pair_tests[Vector2i(i, j)] = profile.pair_tests[i][j];
+			}
+		}
+	}
+	info["pair_tests"] = pair_tests;
+
+	return info;
+}
+
 GodotSpace2D::GodotSpace2D() {
 	body_linear_velocity_sleep_threshold = GLOBAL_GET("physics/2d/sleep_threshold_linear");
 	body_angular_velocity_sleep_threshold = GLOBAL_GET("physics/2d/sleep_threshold_angular");
@@ -37,21 +37,72 @@
 #include "godot_body_pair_2d.h"
 #include "godot_broad_phase_2d.h"
 #include "godot_collision_object_2d.h"
+#include "godot_projectile_batch_2d.h"
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
 	GDCLASS(GodotPhysicsDirectSpaceState2D, PhysicsDirectSpaceState2D);
 
+	// Batched queries are sorted so that nearby queries end up in the same chunk. Each chunk
+	// is culled once against the broadphase, then its queries run on the WorkerThreadPool
+	// against the chunk's candidates only.
+	struct BatchQuery {
+		uint64_t key = 0;
+		uint32_t index = 0;
+
+		bool operator<(const BatchQuery &p_other) const {
+			return key == p_other.key ? index < p_other.index : key < p_other.key;
+		}
+	};
+
+	struct BatchChunk {
+		uint32_t query_begin = 0;
+		uint32_t query_end = 0;
+		uint32_t object_begin = 0;
+		uint32_t object_end = 0;
+		bool overflow = false; // Too many candidates, queries are run one by one instead.
+	};
+
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector2 *from = nullptr;
+		const Vector2 *to = nullptr;
+		RayResult *results = nullptr;
+		bool *hits = nullptr;
+	};
+
+	struct MotionBatch {
+		GodotShape2D *shape = nullptr;
+		const ShapeParameters *parameters = nullptr;
+		const Transform2D *transforms = nullptr;
+		const Vector2 *motions = nullptr;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+	};
+
+	LocalVector<BatchQuery> batch_queries;
+	LocalVector<BatchChunk> batch_chunks;
+	LocalVector<Rect2> batch_aabbs;
+	LocalVector<GodotCollisionObject2D *> batch_objects;
+	LocalVector<int> batch_subindices;
+
+	void _build_query_batch(int p_count, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, const HashSet<RID> &p_exclude);
+	void _intersect_ray_batch_chunk(uint32_t p_chunk_index, RayBatch *p_batch);
+	void _cast_motion_batch_chunk(uint32_t p_chunk_index, MotionBatch *p_batch);
+
 public:
 	GodotSpace2D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual void intersect_ray_batch(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) override;
+	virtual void cast_motion_batch(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 
@@ -62,14 +113,31 @@ class GodotSpace2D {
 public:
 	enum ElapsedTime {
 		ELAPSED_TIME_INTEGRATE_FORCES,
+		ELAPSED_TIME_BROADPHASE,
 		ELAPSED_TIME_GENERATE_ISLANDS,
 		ELAPSED_TIME_SETUP_CONSTRAINTS,
 		ELAPSED_TIME_SOLVE_CONSTRAINTS,
 		ELAPSED_TIME_INTEGRATE_VELOCITIES,
+		ELAPSED_TIME_STEP_PROJECTILES,
 		ELAPSED_TIME_MAX
 
 	};
 
+	// Detailed counters of the last step, only gathered while profiling is enabled for the space.
+	struct Profile {
+		enum {
+			ISLAND_SIZE_BUCKETS = 16, // Powers of two, the last bucket also counts all larger islands.
+			SHAPE_TYPE_COUNT = PhysicsServer2D::SHAPE_CUSTOM + 1,
+		};
+
+		uint32_t pair_tests[SHAPE_TYPE_COUNT][SHAPE_TYPE_COUNT] = {};
+		uint32_t island_sizes[ISLAND_SIZE_BUCKETS] = {};
+		int rigid_bodies = 0;
+		int sleeping_bodies = 0;
+
+		void clear() { *this = Profile(); }
+	};
+
 private:
 	struct ExcludedShapeSW {
 		GodotShape2D *local_shape = nullptr;
@@ -79,6 +147,9 @@ private:
 
 	uint64_t elapsed_time[ELAPSED_TIME_MAX] = {};
 
+	bool profiling = false;
+	Profile profile;
+
 	GodotPhysicsDirectSpaceState2D *direct_access = nullptr;
 	RID self;
 
@@ -88,6 +159,7 @@ private:
 	SelfList<GodotBody2D>::List state_query_list;
 	SelfList<GodotArea2D>::List monitor_query_list;
 	SelfList<GodotArea2D>::List area_moved_list;
+	SelfList<GodotProjectileBatch2D>::List projectile_batch_list;
 
 	static void *_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_data, void *p_self);
@@ -122,12 +194,52 @@ private:
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int step_constraint_count = 0;
 
 	int _cull_aabb_for_body(GodotBody2D *p_body, const Rect2 &p_aabb);
 
+	void _step_projectile(GodotProjectileBatch2D *p_batch, uint32_t p_index, GodotCollisionObject2D *const *p_candidates, const int *p_candidate_subindices, int p_candidate_count, LocalVector<GodotCollisionObject2D *> &r_objects, LocalVector<int> &r_subindices);
+	void _step_projectile_chunk(uint32_t p_chunk_index, GodotProjectileBatch2D *p_batch);
+	void _step_projectile_batch(GodotProjectileBatch2D *p_batch, real_t p_step);
+
 	Vector<Vector2> contact_debug;
 	int contact_debug_count = 0;
 
+	struct SnapshotBody {
+		uint64_t id = 0;
+		GodotBody2D::SnapshotState state;
+		uint32_t constraints_from = 0;
+		uint32_t constraint_count = 0;
+	};
+
+	struct SnapshotConstraint {
+		uint32_t index = 0;
+		const uint8_t *data = nullptr;
+		uint32_t size = 0;
+	};
+
+	struct SnapshotConstraintOrder {
+		uint32_t rank = 0;
+		GodotConstraint2D *constraint = nullptr;
+		int position = 0;
+
+		bool operator<(const SnapshotConstraintOrder &p_other) const { return rank < p_other.rank; }
+	};
+
+	// Kept around, so saving or restoring a snapshot every frame doesn't allocate once warmed up.
+	LocalVector<uint8_t> snapshot_data;
+	LocalVector<SnapshotBody> snapshot_bodies;
+	LocalVector<uint32_t> snapshot_body_constraints;
+	LocalVector<uint64_t> snapshot_active_bodies;
+	HashMap<GodotConstraint2D::StateKey, SnapshotConstraint, GodotConstraint2D::StateKey> snapshot_constraints;
+	HashMap<uint64_t, GodotBody2D *> snapshot_body_map;
+	HashMap<GodotConstraint2D *, uint32_t> snapshot_constraint_indices;
+	LocalVector<GodotConstraint2D *> snapshot_constraint_list;
+	LocalVector<SnapshotConstraintOrder> snapshot_constraint_order;
+
+	void _gather_snapshot_constraints();
+	void _restore_snapshot_constraint_order(GodotBody2D *p_body, const SnapshotBody &p_snapshot);
+
 	friend class GodotPhysicsDirectSpaceState2D;
 
 public:
@@ -152,6 +264,13 @@ public:
 	void area_add_to_monitor_query_list(SelfList<GodotArea2D> *p_area);
 	void area_remove_from_monitor_query_list(SelfList<GodotArea2D> *p_area);
 
+	void add_projectile_batch(SelfList<GodotProjectileBatch2D> *p_batch);
+	void remove_projectile_batch(SelfList<GodotProjectileBatch2D> *p_batch);
+	const SelfList<GodotProjectileBatch2D>::List &get_projectile_batch_list() const;
+
+	// Moves the projectiles of all batches, at the end of the step.
+	void step_projectile_batches(real_t p_step);
+
 	GodotBroadPhase2D *get_broadphase();
 
 	void add_object(GodotCollisionObject2D *p_object);
@@ -190,6 +309,14 @@ public:
 
 	int get_collision_pairs() const { return collision_pairs; }
 
+	void set_constraint_count(int p_constraint_count) { step_constraint_count = p_constraint_count; }
+	int get_constraint_count() const { return step_constraint_count; }
+
+	// Snapshots hold the dynamic state of the bodies in the space and the solver state of their
+	// constraints, so a previous frame can be restored and simulated again (e.g. for rollback).
+	Vector<uint8_t> save_snapshot();
+	Error restore_snapshot(const uint8_t *p_data, int p_size);
+
 	bool test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::MotionParameters &p_parameters, PhysicsServer2D::MotionResult *r_result);
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
@@ -206,6 +333,12 @@ public:
 
 	void set_elapsed_time(ElapsedTime p_time, uint64_t p_msec) { elapsed_time[p_time] = p_msec; }
 	uint64_t get_elapsed_time(ElapsedTime p_time) const { return elapsed_time[p_time]; }
+	static const char *get_elapsed_time_name(ElapsedTime p_time);
+
+	void set_profiling(bool p_enable);
+	_FORCE_INLINE_ bool is_profiling() const { return profiling; }
+	_FORCE_INLINE_ Profile &get_profile() { return profile; }
+	Dictionary get_profile_info() const;
 
 	GodotSpace2D();
 	~GodotSpace2D();
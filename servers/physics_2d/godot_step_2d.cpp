@@ -72,6 +72,21 @@ void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D
 	}
 }
 
+void GodotStep2D::_fill_active_bodies(const SelfList<GodotBody2D>::List &p_body_list) {
+	active_bodies.clear();
+	for (const SelfList<GodotBody2D> *b = p_body_list.first(); b; b = b->next()) {
+		active_bodies.push_back(b->self());
+	}
+}
+
+void GodotStep2D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep2D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
 void GodotStep2D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint2D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -101,26 +116,33 @@ void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const
 	}
 }
 
-void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) const {
+void GodotStep2D::_test_island_sleep(uint32_t p_island_index, void *p_userdata) {
+	const LocalVector<GodotBody2D *> &body_island = body_islands[p_island_index];
+
 	bool can_sleep = true;
 
-	uint32_t body_count = p_body_island.size();
+	uint32_t body_count = body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody2D *body = p_body_island[body_index];
+		GodotBody2D *body = body_island[body_index];
 
 		if (!body->sleep_test(delta)) {
 			can_sleep = false;
 		}
 	}
 
+	body_island_can_sleep[p_island_index] = can_sleep;
+}
+
+void GodotStep2D::_check_suspend(const LocalVector<GodotBody2D *> &p_body_island, bool p_can_sleep) const {
 	// Put all to sleep or wake up everyone.
+	uint32_t body_count = p_body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
 		GodotBody2D *body = p_body_island[body_index];
 
 		bool active = body->is_active();
 
-		if (active == can_sleep) {
-			body->set_active(!can_sleep);
+		if (active == p_can_sleep) {
+			body->set_active(!p_can_sleep);
 		}
 	}
 }
@@ -142,23 +164,32 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_fill_active_bodies(*body_list);
 
-	const SelfList<GodotBody2D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics2DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
+	}
+
+	/* UPDATE BROADPHASE */
+
+	// Moving shapes in the broadphase isn't thread-safe, so it's done afterwards in list order.
+	for (GodotBody2D *body : active_bodies) {
+		body->update_broadphase();
 	}
 
-	p_space->set_active_objects(active_count);
+	p_space->set_active_objects((int)active_bodies.size());
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_BROADPHASE, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -192,7 +223,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	const SelfList<GodotBody2D> *b = body_list->first();
 
 	uint32_t body_island_count = 0;
 
@@ -230,6 +261,19 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	}
 
 	p_space->set_island_count((int)island_count);
+	p_space->set_constraint_count((int)all_constraints.size());
+
+	if (p_space->is_profiling()) {
+		GodotSpace2D::Profile &profile = p_space->get_profile();
+		profile.clear();
+		for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
+			uint32_t bucket = 0;
+			while ((body_islands[island_index].size() >> (bucket + 1)) > 0 && bucket < GodotSpace2D::Profile::ISLAND_SIZE_BUCKETS - 1) {
+				++bucket;
+			}
+			++profile.island_sizes[bucket];
+		}
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -240,9 +284,21 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
+	if (p_space->is_profiling()) {
+		// Counted afterwards, so the threaded setup doesn't need to synchronize.
+		GodotSpace2D::Profile &profile = p_space->get_profile();
+		for (const GodotConstraint2D *constraint : all_constraints) {
+			int type_A = 0;
+			int type_B = 0;
+			if (constraint->get_pair_shape_types(type_A, type_B)) {
+				++profile.pair_tests[MIN(type_A, type_B)][MAX(type_A, type_B)];
+			}
+		}
+	}
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
@@ -271,27 +327,61 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody2D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+	// Bodies can be woken up while setting up constraints, so the active list is gathered again.
+	_fill_active_bodies(*body_list);
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics2DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Warning: This doesn't run on threads, because it updates the broadphase and the space lists.
+	for (GodotBody2D *body : active_bodies) {
+		body->finish_integration(); // May deactivate the body.
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
 
+	body_island_can_sleep.resize(body_island_count);
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_test_island_sleep, nullptr, body_island_count, -1, true, SNAME("Physics2DTestIslandSleep"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		_check_suspend(body_islands[island_index], body_island_can_sleep[island_index]);
 	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime);
-		//profile_begtime=profile_endtime;
+		profile_begtime = profile_endtime;
 	}
 
 	all_constraints.clear();
 
+	/* STEP PROJECTILES */
+
+	// After the bodies moved, so projectiles are tested against their new transforms.
+	p_space->step_projectile_batches(p_delta);
+
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_STEP_PROJECTILES, profile_endtime - profile_begtime);
+	}
+
+	if (p_space->is_profiling()) {
+		GodotSpace2D::Profile &profile = p_space->get_profile();
+		for (const GodotCollisionObject2D *object : p_space->get_objects()) {
+			if (object->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+				continue;
+			}
+			const GodotBody2D *body = static_cast<const GodotBody2D *>(object);
+			if (body->get_mode() >= PhysicsServer2D::BODY_MODE_RIGID) {
+				++profile.rigid_bodies;
+				if (!body->is_active()) {
+					++profile.sleeping_bodies;
+				}
+			}
+		}
+	}
+
 	p_space->unlock();
 	_step++;
 }
@@ -300,6 +390,7 @@ GodotStep2D::GodotStep2D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	active_bodies.reserve(BODY_ISLAND_SIZE_RESERVE);
 }
 
 GodotStep2D::~GodotStep2D() {
@@ -32,6 +32,16 @@
 
 #include "godot_collision_solver_3d.h"
 
+const GodotCollisionObject3D *GodotAreaPair3D::get_area_overlap(const GodotArea3D *p_area) const {
+	return colliding ? body : nullptr;
+}
+
+bool GodotAreaPair3D::get_pair_shape_types(int &r_type_A, int &r_type_B) const {
+	r_type_A = body->get_shape(body_shape)->get_type();
+	r_type_B = area->get_shape(area_shape)->get_type();
+	return true;
+}
+
 bool GodotAreaPair3D::setup(real_t p_step) {
 	bool result = false;
 	if (area->collides_with(body) && GodotCollisionSolver3D::solve_static(body->get_shape(body_shape), body->get_transform() * body->get_shape_transform(body_shape), area->get_shape(area_shape), area->get_transform() * area->get_shape_transform(area_shape), nullptr, this)) {
@@ -120,6 +130,20 @@ GodotAreaPair3D::~GodotAreaPair3D() {
 
 ////////////////////////////////////////////////////
 
+const GodotCollisionObject3D *GodotArea2Pair3D::get_area_overlap(const GodotArea3D *p_area) const {
+	// Like the monitor callbacks, only report monitorable areas.
+	if (p_area == area_a) {
+		return colliding_a && area_b_monitorable ? area_b : nullptr;
+	}
+	return colliding_b && area_a_monitorable ? area_a : nullptr;
+}
+
+bool GodotArea2Pair3D::get_pair_shape_types(int &r_type_A, int &r_type_B) const {
+	r_type_A = area_a->get_shape(shape_a)->get_type();
+	r_type_B = area_b->get_shape(shape_b)->get_type();
+	return true;
+}
+
 bool GodotArea2Pair3D::setup(real_t p_step) {
 	bool result_a = area_a->collides_with(area_b);
 	bool result_b = area_b->collides_with(area_a);
@@ -205,6 +229,16 @@ GodotArea2Pair3D::~GodotArea2Pair3D() {
 
 ////////////////////////////////////////////////////
 
+const GodotCollisionObject3D *GodotAreaSoftBodyPair3D::get_area_overlap(const GodotArea3D *p_area) const {
+	return colliding ? soft_body : nullptr;
+}
+
+bool GodotAreaSoftBodyPair3D::get_pair_shape_types(int &r_type_A, int &r_type_B) const {
+	r_type_A = soft_body->get_shape(soft_body_shape)->get_type();
+	r_type_B = area->get_shape(area_shape)->get_type();
+	return true;
+}
+
 bool GodotAreaSoftBodyPair3D::setup(real_t p_step) {
 	bool result = false;
 	if (
@@ -47,6 +47,9 @@ class GodotAreaPair3D : public GodotConstraint3D {
 	bool body_has_attached_area = false;
 
 public:
+	virtual const GodotCollisionObject3D *get_area_overlap(const GodotArea3D *p_area) const override;
+	virtual bool get_pair_shape_types(int &r_type_A, int &r_type_B) const override;
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -68,6 +71,9 @@ class GodotArea2Pair3D : public GodotConstraint3D {
 	bool area_b_monitorable;
 
 public:
+	virtual const GodotCollisionObject3D *get_area_overlap(const GodotArea3D *p_area) const override;
+	virtual bool get_pair_shape_types(int &r_type_A, int &r_type_B) const override;
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -87,6 +93,9 @@ class GodotAreaSoftBodyPair3D : public GodotConstraint3D {
 	bool body_has_attached_area = false;
 
 public:
+	virtual const GodotCollisionObject3D *get_area_overlap(const GodotArea3D *p_area) const override;
+	virtual bool get_pair_shape_types(int &r_type_A, int &r_type_B) const override;
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
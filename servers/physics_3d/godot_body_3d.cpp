@@ -52,6 +52,35 @@ void GodotBody3D::_update_transform_dependent() {
 	_inv_inertia_tensor = tb * diag * tbt;
 }
 
+void GodotBody3D::_island_changed() {
+	get_space()->island_dissolve(island_id);
+}
+
+void GodotBody3D::_connections_changed() {
+	// A change of mode or space can merge or split the islands of every body this one is
+	// connected to, not only its own.
+	GodotSpace3D *current_space = get_space();
+	if (island_id >= 0) {
+		current_space->island_dissolve(island_id);
+	}
+
+	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
+		GodotConstraint3D *constraint = E.key;
+		for (int i = 0; i < constraint->get_body_count(); i++) {
+			GodotBody3D *body = constraint->get_body_ptr()[i];
+			if (body->get_island_id() >= 0 && body->get_space() == current_space) {
+				current_space->island_dissolve(body->get_island_id());
+			}
+		}
+		for (int i = 0; i < constraint->get_soft_body_count(); i++) {
+			GodotSoftBody3D *soft_body = constraint->get_soft_body_ptr(i);
+			if (soft_body->get_island_id() >= 0 && soft_body->get_space() == current_space) {
+				current_space->island_dissolve(soft_body->get_island_id());
+			}
+		}
+	}
+}
+
 void GodotBody3D::update_mass_properties() {
 	// Update shapes and motions.
 
@@ -297,6 +326,9 @@ Variant GodotBody3D::get_param(PhysicsServer3D::BodyParameter p_param) const {
 
 void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 	PhysicsServer3D::BodyMode prev = mode;
+	if (p_mode != prev && get_space()) {
+		_connections_changed();
+	}
 	mode = p_mode;
 
 	switch (p_mode) {
@@ -415,6 +447,36 @@ void GodotBody3D::set_state(PhysicsServer3D::BodyState p_state, const Variant &p
 	}
 }
 
+void GodotBody3D::get_snapshot_state(SnapshotState &r_state) const {
+	r_state.transform = get_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.still_time = still_time;
+	r_state.first_time_kinematic = first_time_kinematic;
+}
+
+void GodotBody3D::set_snapshot_state(const SnapshotState &p_state) {
+	if (p_state.transform != get_transform()) {
+		_set_transform(p_state.transform);
+		_set_inv_transform(p_state.transform.affine_inverse());
+		_update_transform_dependent();
+	}
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	still_time = p_state.still_time;
+	first_time_kinematic = p_state.first_time_kinematic;
+}
+
 Variant GodotBody3D::get_state(PhysicsServer3D::BodyState p_state) const {
 	switch (p_state) {
 		case PhysicsServer3D::BODY_STATE_TRANSFORM: {
@@ -439,6 +501,9 @@ Variant GodotBody3D::get_state(PhysicsServer3D::BodyState p_state) const {
 
 void GodotBody3D::set_space(GodotSpace3D *p_space) {
 	if (get_space()) {
+		if (island_id >= 0) {
+			_island_changed();
+		}
 		if (mass_properties_update_list.in_list()) {
 			get_space()->body_remove_from_mass_properties_update_list(&mass_properties_update_list);
 		}
@@ -458,6 +523,8 @@ void GodotBody3D::set_space(GodotSpace3D *p_space) {
 		if (active && !active_list.in_list()) {
 			get_space()->body_add_to_active_list(&active_list);
 		}
+
+		_connections_changed();
 	}
 }
 
@@ -664,7 +731,7 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector3();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		_update_shape_aabbs_with_motion(motion);
 	}
 
 	contact_count = 0;
@@ -675,10 +742,6 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 		return;
 	}
 
-	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-	}
-
 	//apply axis lock linear
 	for (int i = 0; i < 3; i++) {
 		if (is_axis_locked((PhysicsServer3D::BodyAxis)(1 << i))) {
@@ -698,9 +761,6 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 	if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
-		if (contacts.size() == 0 && linear_velocity == Vector3() && angular_velocity == Vector3()) {
-			set_active(false); //stopped moving, deactivate
-		}
 
 		return;
 	}
@@ -728,12 +788,31 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	transform_new.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform_new);
+	_set_transform(transform_new, false);
 	_set_inv_transform(get_transform().inverse());
+	_update_shape_aabbs();
 
 	_update_transform_dependent();
 }
 
+void GodotBody3D::finish_integration() {
+	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
+		return;
+	}
+
+	if (fi_callback_data || body_state_callback.is_valid()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	update_broadphase();
+
+	if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
+		if (contacts.size() == 0 && linear_velocity == Vector3() && angular_velocity == Vector3()) {
+			set_active(false); //stopped moving, deactivate
+		}
+	}
+}
+
 void GodotBody3D::wakeup_neighbours() {
 	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
 		const GodotConstraint3D *c = E.key;
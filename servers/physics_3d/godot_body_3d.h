@@ -145,8 +145,11 @@ class GodotBody3D : public GodotCollisionObject3D {
 	GodotPhysicsDirectBodyState3D *direct_state = nullptr;
 
 	uint64_t island_step = 0;
+	int island_id = -1;
 
 	void _update_transform_dependent();
+	void _island_changed();
+	void _connections_changed();
 
 	friend class GodotPhysicsDirectBodyState3D; // i give up, too many functions to expose
 
@@ -195,10 +198,28 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
-	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint, int p_pos) { constraint_map[p_constraint] = p_pos; }
-	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) { constraint_map.erase(p_constraint); }
+	_FORCE_INLINE_ int get_island_id() const { return island_id; }
+	_FORCE_INLINE_ void set_island_id(int p_island_id) { island_id = p_island_id; }
+
+	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint, int p_pos) {
+		constraint_map[p_constraint] = p_pos;
+		if (island_id >= 0) {
+			_island_changed();
+		}
+	}
+	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) {
+		constraint_map.erase(p_constraint);
+		if (island_id >= 0) {
+			_island_changed();
+		}
+	}
 	const HashMap<GodotConstraint3D *, int> &get_constraint_map() const { return constraint_map; }
-	_FORCE_INLINE_ void clear_constraint_map() { constraint_map.clear(); }
+	_FORCE_INLINE_ void clear_constraint_map() {
+		constraint_map.clear();
+		if (island_id >= 0) {
+			_island_changed();
+		}
+	}
 
 	_FORCE_INLINE_ void set_omit_force_integration(bool p_omit_force_integration) { omit_force_integration = p_omit_force_integration; }
 	_FORCE_INLINE_ bool get_omit_force_integration() const { return omit_force_integration; }
@@ -282,6 +303,7 @@ public:
 
 	void set_active(bool p_active);
 	_FORCE_INLINE_ bool is_active() const { return active; }
+	_FORCE_INLINE_ bool is_able_to_sleep() const { return can_sleep; }
 
 	_FORCE_INLINE_ void wakeup() {
 		if ((!get_space()) || mode == PhysicsServer3D::BODY_MODE_STATIC || mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
@@ -299,6 +321,24 @@ public:
 	void set_state(PhysicsServer3D::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PhysicsServer3D::BodyState p_state) const;
 
+	// Dynamic state saved and restored by space snapshots, see GodotSpace3D::save_snapshot().
+	struct SnapshotState {
+		Transform3D transform;
+		Transform3D new_transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 prev_linear_velocity;
+		Vector3 prev_angular_velocity;
+		Vector3 applied_force;
+		Vector3 applied_torque;
+		real_t still_time = 0.0;
+		bool first_time_kinematic = false;
+	};
+
+	void get_snapshot_state(SnapshotState &r_state) const;
+	// Doesn't activate or deactivate the body, the space restores the active list on its own to keep its order.
+	void set_snapshot_state(const SnapshotState &p_state);
+
 	_FORCE_INLINE_ void set_continuous_collision_detection(bool p_enable) { continuous_cd = p_enable; }
 	_FORCE_INLINE_ bool is_continuous_collision_detection_enabled() const { return continuous_cd; }
 
@@ -316,8 +356,11 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
+	// Safe to run for different bodies in parallel, as long as finish_integration()
+	// is called afterwards from a single thread.
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
+	void finish_integration();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
@@ -105,6 +105,13 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
+	virtual StateKey get_state_key() const override;
+	virtual void save_state(LocalVector<uint8_t> &r_state) const override;
+	virtual bool load_state(const uint8_t *p_state, uint32_t p_size) override;
+	virtual void reset_state() override;
+
+	virtual bool get_pair_shape_types(int &r_type_A, int &r_type_B) const override;
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -133,6 +140,8 @@ class GodotBodySoftBodyPair3D : public GodotBodyContact3D {
 	void validate_contacts();
 
 public:
+	virtual bool get_pair_shape_types(int &r_type_A, int &r_type_B) const override;
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -0,0 +1,721 @@
+/**************************************************************************/
+/*  godot_collision_kernels_3d.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_collision_kernels_3d.h"
+
+// SSE2 and NEON are part of the x86-64 and ARM64 baselines, so they can be used whenever they're
+// enabled at build time. They're only used with single precision, as they handle 4 floats at once.
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLLISION_KERNELS_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define COLLISION_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+// Kernels going through points keep a running result for each of these lanes, and only merge them
+// at the end. The scalar kernels do the same, so the results don't depend on the backend.
+#define KERNEL_LANES 4
+
+/* Shared by all backends, for the remaining elements and to merge the lanes. */
+
+static _FORCE_INLINE_ void _project_box_axis(const Transform3D &p_transform, const Vector3 &p_half_extents, const Vector3 &p_axis, real_t &r_min, real_t &r_max) {
+	// Same as GodotBoxShape3D::project_range().
+	Vector3 local_normal = p_transform.basis.xform_inv(p_axis);
+
+	real_t length = local_normal.abs().dot(p_half_extents);
+	real_t distance = p_axis.dot(p_transform.origin);
+
+	r_min = distance - length;
+	r_max = distance + length;
+}
+
+static _FORCE_INLINE_ void _project_capsule_axis(const Transform3D &p_transform, real_t p_radius, real_t p_height, const Vector3 &p_axis, real_t &r_min, real_t &r_max) {
+	// Same as GodotCapsuleShape3D::project_range().
+	Vector3 n = p_transform.basis.xform_inv(p_axis).normalized();
+	real_t h = p_height * 0.5 - p_radius;
+
+	n *= p_radius;
+	n.y += (n.y > 0) ? h : -h;
+
+	r_max = p_axis.dot(p_transform.xform(n));
+	r_min = p_axis.dot(p_transform.xform(-n));
+}
+
+static _FORCE_INLINE_ bool _is_minkowski_edge(const Vector3 &p_u, const Vector3 &p_v, const Vector3 &p_e, const GodotCollisionKernels3D::EdgeBatch &p_edges, int p_index) {
+	const Vector3 u(p_edges.u[0][p_index], p_edges.u[1][p_index], p_edges.u[2][p_index]);
+	const Vector3 v(p_edges.v[0][p_index], p_edges.v[1][p_index], p_edges.v[2][p_index]);
+	const Vector3 e(p_edges.e[0][p_index], p_edges.e[1][p_index], p_edges.e[2][p_index]);
+
+	// Test if arcs AB and CD intersect on the unit sphere, with A and B the face normals of the
+	// first edge, and C and D the negated face normals of the other one.
+	real_t CBA = u.dot(p_e);
+	real_t DBA = v.dot(p_e);
+	real_t ADC = p_u.dot(-e);
+	real_t BDC = p_v.dot(-e);
+
+	return (CBA * DBA < 0.0f) && (ADC * BDC < 0.0f) && (CBA * BDC > 0.0f);
+}
+
+static _FORCE_INLINE_ void _merge_range_lanes(const real_t *p_lane_min, const real_t *p_lane_max, real_t &r_min, real_t &r_max) {
+	r_min = p_lane_min[0];
+	r_max = p_lane_max[0];
+	for (int i = 1; i < KERNEL_LANES; i++) {
+		if (p_lane_max[i] > r_max) {
+			r_max = p_lane_max[i];
+		}
+		if (p_lane_min[i] < r_min) {
+			r_min = p_lane_min[i];
+		}
+	}
+}
+
+static _FORCE_INLINE_ void _project_points_tail(const Vector3 &p_axis, const Transform3D &p_transform, const Vector3 *p_points, int p_from, int p_count, bool p_has_range, real_t &r_min, real_t &r_max) {
+	for (int i = p_from; i < p_count; i++) {
+		real_t d = p_axis.dot(p_transform.xform(p_points[i]));
+
+		if (!p_has_range || d > r_max) {
+			r_max = d;
+		}
+		if (!p_has_range || d < r_min) {
+			r_min = d;
+		}
+		p_has_range = true;
+	}
+}
+
+static _FORCE_INLINE_ int _merge_support_lanes(const real_t *p_lane_support, const int *p_lane_index, real_t &r_support) {
+	// Ties go to the lowest index, so the first point furthest along is found, like with a single lane.
+	int best = p_lane_index[0];
+	r_support = p_lane_support[0];
+	for (int i = 1; i < KERNEL_LANES; i++) {
+		if (p_lane_support[i] > r_support || (p_lane_support[i] == r_support && p_lane_index[i] < best)) {
+			best = p_lane_index[i];
+			r_support = p_lane_support[i];
+		}
+	}
+	return best;
+}
+
+static _FORCE_INLINE_ int _find_support_tail(const Vector3 &p_direction, const Vector3 *p_points, int p_from, int p_count, int p_best, real_t p_support) {
+	for (int i = p_from; i < p_count; i++) {
+		real_t s = p_direction.dot(p_points[i]);
+		if (p_best < 0 || s > p_support) {
+			p_best = i;
+			p_support = s;
+		}
+	}
+	return p_best;
+}
+
+/* Scalar */
+
+static void _project_box_scalar(const Transform3D &p_transform, const Vector3 &p_half_extents, const GodotCollisionKernels3D::AxisBatch &p_axes, real_t *r_min, real_t *r_max) {
+	for (int i = 0; i < p_axes.count; i++) {
+		_project_box_axis(p_transform, p_half_extents, p_axes.get(i), r_min[i], r_max[i]);
+	}
+}
+
+static void _project_capsule_scalar(const Transform3D &p_transform, real_t p_radius, real_t p_height, const GodotCollisionKernels3D::AxisBatch &p_axes, real_t *r_min, real_t *r_max) {
+	for (int i = 0; i < p_axes.count; i++) {
+		_project_capsule_axis(p_transform, p_radius, p_height, p_axes.get(i), r_min[i], r_max[i]);
+	}
+}
+
+static void _project_points_scalar(const Vector3 &p_axis, const Transform3D &p_transform, const Vector3 *p_points, int p_count, real_t &r_min, real_t &r_max) {
+	int i = 0;
+	bool has_range = false;
+	if (p_count >= KERNEL_LANES) {
+		real_t lane_min[KERNEL_LANES];
+		real_t lane_max[KERNEL_LANES];
+		for (int j = 0; j < KERNEL_LANES; j++) {
+			lane_min[j] = lane_max[j] = p_axis.dot(p_transform.xform(p_points[j]));
+		}
+		for (i = KERNEL_LANES; i + KERNEL_LANES <= p_count; i += KERNEL_LANES) {
+			for (int j = 0; j < KERNEL_LANES; j++) {
+				real_t d = p_axis.dot(p_transform.xform(p_points[i + j]));
+				if (d > lane_max[j]) {
+					lane_max[j] = d;
+				}
+				if (d < lane_min[j]) {
+					lane_min[j] = d;
+				}
+			}
+		}
+		_merge_range_lanes(lane_min, lane_max, r_min, r_max);
+		has_range = true;
+	}
+	_project_points_tail(p_axis, p_transform, p_points, i, p_count, has_range, r_min, r_max);
+}
+
+static int _find_support_scalar(const Vector3 &p_direction, const Vector3 *p_points, int p_count) {
+	int i = 0;
+	int best = -1;
+	real_t support = 0.0;
+	if (p_count >= KERNEL_LANES) {
+		real_t lane_support[KERNEL_LANES];
+		int lane_index[KERNEL_LANES];
+		for (int j = 0; j < KERNEL_LANES; j++) {
+			lane_support[j] = p_direction.dot(p_points[j]);
+			lane_index[j] = j;
+		}
+		for (i = KERNEL_LANES; i + KERNEL_LANES <= p_count; i += KERNEL_LANES) {
+			for (int j = 0; j < KERNEL_LANES; j++) {
+				real_t s = p_direction.dot(p_points[i + j]);
+				if (s > lane_support[j]) {
+					lane_support[j] = s;
+					lane_index[j] = i + j;
+				}
+			}
+		}
+		best = _merge_support_lanes(lane_support, lane_index, support);
+	}
+	return _find_support_tail(p_direction, p_points, i, p_count, best, support);
+}
+
+static int _find_minkowski_edges_scalar(const Vector3 &p_u, const Vector3 &p_v, const Vector3 &p_e, const GodotCollisionKernels3D::EdgeBatch &p_edges, int *r_indices) {
+	int count = 0;
+	for (int i = 0; i < p_edges.count; i++) {
+		if (_is_minkowski_edge(p_u, p_v, p_e, p_edges, i)) {
+			r_indices[count++] = i;
+		}
+	}
+	return count;
+}
+
+#ifdef COLLISION_KERNELS_SSE2
+
+/* SSE2 */
+
+// Loads 4 packed Vector3 and splits them into their components.
+static _FORCE_INLINE_ void _load_points_sse2(const Vector3 *p_points, __m128 &r_x, __m128 &r_y, __m128 &r_z) {
+	const float *f = &p_points[0].x;
+	const __m128 a = _mm_loadu_ps(f); // x0 y0 z0 x1
+	const __m128 b = _mm_loadu_ps(f + 4); // y1 z1 x2 y2
+	const __m128 c = _mm_loadu_ps(f + 8); // z2 x3 y3 z3
+
+	r_x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+	r_y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+	r_z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+// (a * x + b * y) + c * z, in the same order as Vector3::dot().
+static _FORCE_INLINE_ __m128 _dot_sse2(__m128 p_a, __m128 p_b, __m128 p_c, __m128 p_x, __m128 p_y, __m128 p_z) {
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(p_a, p_x), _mm_mul_ps(p_b, p_y)), _mm_mul_ps(p_c, p_z));
+}
+
+static _FORCE_INLINE_ __m128 _select_sse2(__m128 p_mask, __m128 p_a, __m128 p_b) {
+	return _mm_or_ps(_mm_and_ps(p_mask, p_a), _mm_andnot_ps(p_mask, p_b));
+}
+
+static void _project_box_sse2(const Transform3D &p_transform, const Vector3 &p_half_extents, const GodotCollisionKernels3D::AxisBatch &p_axes, real_t *r_min, real_t *r_max) {
+	const Basis &b = p_transform.basis;
+	const __m128 sign_mask = _mm_set1_ps(-0.0f);
+
+	int i = 0;
+	for (; i + KERNEL_LANES <= p_axes.count; i += KERNEL_LANES) {
+		const __m128 x = _mm_loadu_ps(p_axes.x + i);
+		const __m128 y = _mm_loadu_ps(p_axes.y + i);
+		const __m128 z = _mm_loadu_ps(p_axes.z + i);
+
+		// Basis::xform_inv().
+		const __m128 lx = _dot_sse2(_mm_set1_ps(b.rows[0][0]), _mm_set1_ps(b.rows[1][0]), _mm_set1_ps(b.rows[2][0]), x, y, z);
+		const __m128 ly = _dot_sse2(_mm_set1_ps(b.rows[0][1]), _mm_set1_ps(b.rows[1][1]), _mm_set1_ps(b.rows[2][1]), x, y, z);
+		const __m128 lz = _dot_sse2(_mm_set1_ps(b.rows[0][2]), _mm_set1_ps(b.rows[1][2]), _mm_set1_ps(b.rows[2][2]), x, y, z);
+
+		const __m128 length = _dot_sse2(_mm_andnot_ps(sign_mask, lx), _mm_andnot_ps(sign_mask, ly), _mm_andnot_ps(sign_mask, lz), _mm_set1_ps(p_half_extents.x), _mm_set1_ps(p_half_extents.y), _mm_set1_ps(p_half_extents.z));
+		const __m128 distance = _dot_sse2(x, y, z, _mm_set1_ps(p_transform.origin.x), _mm_set1_ps(p_transform.origin.y), _mm_set1_ps(p_transform.origin.z));
+
+		_mm_storeu_ps(r_min + i, _mm_sub_ps(distance, length));
+		_mm_storeu_ps(r_max + i, _mm_add_ps(distance, length));
+	}
+	for (; i < p_axes.count; i++) {
+		_project_box_axis(p_transform, p_half_extents, p_axes.get(i), r_min[i], r_max[i]);
+	}
+}
+
+static void _project_capsule_sse2(const Transform3D &p_transform, real_t p_radius, real_t p_height, const GodotCollisionKernels3D::AxisBatch &p_axes, real_t *r_min, real_t *r_max) {
+	const Basis &b = p_transform.basis;
+	const real_t h = p_height * 0.5 - p_radius;
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 radius = _mm_set1_ps(p_radius);
+	const __m128 ox = _mm_set1_ps(p_transform.origin.x);
+	const __m128 oy = _mm_set1_ps(p_transform.origin.y);
+	const __m128 oz = _mm_set1_ps(p_transform.origin.z);
+
+	int i = 0;
+	for (; i + KERNEL_LANES <= p_axes.count; i += KERNEL_LANES) {
+		const __m128 x = _mm_loadu_ps(p_axes.x + i);
+		const __m128 y = _mm_loadu_ps(p_axes.y + i);
+		const __m128 z = _mm_loadu_ps(p_axes.z + i);
+
+		// Basis::xform_inv(), then Vector3::normalized().
+		__m128 nx = _dot_sse2(_mm_set1_ps(b.rows[0][0]), _mm_set1_ps(b.rows[1][0]), _mm_set1_ps(b.rows[2][0]), x, y, z);
+		__m128 ny = _dot_sse2(_mm_set1_ps(b.rows[0][1]), _mm_set1_ps(b.rows[1][1]), _mm_set1_ps(b.rows[2][1]), x, y, z);
+		__m128 nz = _dot_sse2(_mm_set1_ps(b.rows[0][2]), _mm_set1_ps(b.rows[1][2]), _mm_set1_ps(b.rows[2][2]), x, y, z);
+		const __m128 length_squared = _dot_sse2(nx, ny, nz, nx, ny, nz);
+		const __m128 not_zero = _mm_cmpneq_ps(length_squared, zero);
+		const __m128 length = _mm_sqrt_ps(length_squared);
+		nx = _mm_and_ps(not_zero, _mm_div_ps(nx, length));
+		ny = _mm_and_ps(not_zero, _mm_div_ps(ny, length));
+		nz = _mm_and_ps(not_zero, _mm_div_ps(nz, length));
+
+		nx = _mm_mul_ps(nx, radius);
+		ny = _mm_mul_ps(ny, radius);
+		nz = _mm_mul_ps(nz, radius);
+		ny = _mm_add_ps(ny, _select_sse2(_mm_cmpgt_ps(ny, zero), _mm_set1_ps(h), _mm_set1_ps(-h)));
+
+		// Transform3D::xform() of both ends.
+		const __m128 tx = _dot_sse2(_mm_set1_ps(b.rows[0][0]), _mm_set1_ps(b.rows[0][1]), _mm_set1_ps(b.rows[0][2]), nx, ny, nz);
+		const __m128 ty = _dot_sse2(_mm_set1_ps(b.rows[1][0]), _mm_set1_ps(b.rows[1][1]), _mm_set1_ps(b.rows[1][2]), nx, ny, nz);
+		const __m128 tz = _dot_sse2(_mm_set1_ps(b.rows[2][0]), _mm_set1_ps(b.rows[2][1]), _mm_set1_ps(b.rows[2][2]), nx, ny, nz);
+		const __m128 sign_mask = _mm_set1_ps(-0.0f);
+		const __m128 mnx = _mm_xor_ps(nx, sign_mask);
+		const __m128 mny = _mm_xor_ps(ny, sign_mask);
+		const __m128 mnz = _mm_xor_ps(nz, sign_mask);
+		const __m128 mtx = _dot_sse2(_mm_set1_ps(b.rows[0][0]), _mm_set1_ps(b.rows[0][1]), _mm_set1_ps(b.rows[0][2]), mnx, mny, mnz);
+		const __m128 mty = _dot_sse2(_mm_set1_ps(b.rows[1][0]), _mm_set1_ps(b.rows[1][1]), _mm_set1_ps(b.rows[1][2]), mnx, mny, mnz);
+		const __m128 mtz = _dot_sse2(_mm_set1_ps(b.rows[2][0]), _mm_set1_ps(b.rows[2][1]), _mm_set1_ps(b.rows[2][2]), mnx, mny, mnz);
+
+		_mm_storeu_ps(r_max + i, _dot_sse2(x, y, z, _mm_add_ps(tx, ox), _mm_add_ps(ty, oy), _mm_add_ps(tz, oz)));
+		_mm_storeu_ps(r_min + i, _dot_sse2(x, y, z, _mm_add_ps(mtx, ox), _mm_add_ps(mty, oy), _mm_add_ps(mtz, oz)));
+	}
+	for (; i < p_axes.count; i++) {
+		_project_capsule_axis(p_transform, p_radius, p_height, p_axes.get(i), r_min[i], r_max[i]);
+	}
+}
+
+// The axis dotted with the transformed points, in the same order as Vector3::dot() and Transform3D::xform().
+static _FORCE_INLINE_ __m128 _project_points_sse2(const Vector3 &p_axis, const Transform3D &p_transform, const Vector3 *p_points) {
+	const Basis &b = p_transform.basis;
+	__m128 x, y, z;
+	_load_points_sse2(p_points, x, y, z);
+
+	const __m128 tx = _mm_add_ps(_dot_sse2(_mm_set1_ps(b.rows[0][0]), _mm_set1_ps(b.rows[0][1]), _mm_set1_ps(b.rows[0][2]), x, y, z), _mm_set1_ps(p_transform.origin.x));
+	const __m128 ty = _mm_add_ps(_dot_sse2(_mm_set1_ps(b.rows[1][0]), _mm_set1_ps(b.rows[1][1]), _mm_set1_ps(b.rows[1][2]), x, y, z), _mm_set1_ps(p_transform.origin.y));
+	const __m128 tz = _mm_add_ps(_dot_sse2(_mm_set1_ps(b.rows[2][0]), _mm_set1_ps(b.rows[2][1]), _mm_set1_ps(b.rows[2][2]), x, y, z), _mm_set1_ps(p_transform.origin.z));
+	return _dot_sse2(_mm_set1_ps(p_axis.x), _mm_set1_ps(p_axis.y), _mm_set1_ps(p_axis.z), tx, ty, tz);
+}
+
+static void _project_points_sse2(const Vector3 &p_axis, const Transform3D &p_transform, const Vector3 *p_points, int p_count, real_t &r_min, real_t &r_max) {
+	int i = 0;
+	bool has_range = false;
+	if (p_count >= KERNEL_LANES) {
+		__m128 max = _project_points_sse2(p_axis, p_transform, p_points);
+		__m128 min = max;
+		for (i = KERNEL_LANES; i + KERNEL_LANES <= p_count; i += KERNEL_LANES) {
+			const __m128 d = _project_points_sse2(p_axis, p_transform, p_points + i);
+			max = _select_sse2(_mm_cmpgt_ps(d, max), d, max);
+			min = _select_sse2(_mm_cmplt_ps(d, min), d, min);
+		}
+
+		real_t lane_min[KERNEL_LANES];
+		real_t lane_max[KERNEL_LANES];
+		_mm_storeu_ps(lane_min, min);
+		_mm_storeu_ps(lane_max, max);
+		_merge_range_lanes(lane_min, lane_max, r_min, r_max);
+		has_range = true;
+	}
+	_project_points_tail(p_axis, p_transform, p_points, i, p_count, has_range, r_min, r_max);
+}
+
+static int _find_support_sse2(const Vector3 &p_direction, const Vector3 *p_points, int p_count) {
+	int i = 0;
+	int best = -1;
+	real_t support = 0.0;
+	if (p_count >= KERNEL_LANES) {
+		const __m128 dx = _mm_set1_ps(p_direction.x);
+		const __m128 dy = _mm_set1_ps(p_direction.y);
+		const __m128 dz = _mm_set1_ps(p_direction.z);
+		const __m128i step = _mm_set1_epi32(KERNEL_LANES);
+
+		__m128 x, y, z;
+		_load_points_sse2(p_points, x, y, z);
+		__m128 lane_support = _dot_sse2(dx, dy, dz, x, y, z);
+		__m128i lane_index = _mm_setr_epi32(0, 1, 2, 3);
+		__m128i index = lane_index;
+		for (i = KERNEL_LANES; i + KERNEL_LANES <= p_count; i += KERNEL_LANES) {
+			index = _mm_add_epi32(index, step);
+			_load_points_sse2(p_points + i, x, y, z);
+			const __m128 s = _dot_sse2(dx, dy, dz, x, y, z);
+			const __m128 better = _mm_cmpgt_ps(s, lane_support);
+			lane_support = _select_sse2(better, s, lane_support);
+			lane_index = _mm_castps_si128(_select_sse2(better, _mm_castsi128_ps(index), _mm_castsi128_ps(lane_index)));
+		}
+
+		real_t supports[KERNEL_LANES];
+		int indices[KERNEL_LANES];
+		_mm_storeu_ps(supports, lane_support);
+		_mm_storeu_si128((__m128i *)indices, lane_index);
+		best = _merge_support_lanes(supports, indices, support);
+	}
+	return _find_support_tail(p_direction, p_points, i, p_count, best, support);
+}
+
+static int _find_minkowski_edges_sse2(const Vector3 &p_u, const Vector3 &p_v, const Vector3 &p_e, const GodotCollisionKernels3D::EdgeBatch &p_edges, int *r_indices) {
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 sign_mask = _mm_set1_ps(-0.0f);
+	const __m128 ux = _mm_set1_ps(p_u.x);
+	const __m128 uy = _mm_set1_ps(p_u.y);
+	const __m128 uz = _mm_set1_ps(p_u.z);
+	const __m128 vx = _mm_set1_ps(p_v.x);
+	const __m128 vy = _mm_set1_ps(p_v.y);
+	const __m128 vz = _mm_set1_ps(p_v.z);
+	const __m128 ex = _mm_set1_ps(p_e.x);
+	const __m128 ey = _mm_set1_ps(p_e.y);
+	const __m128 ez = _mm_set1_ps(p_e.z);
+
+	int count = 0;
+	int i = 0;
+	for (; i + KERNEL_LANES <= p_edges.count; i += KERNEL_LANES) {
+		const __m128 mex = _mm_xor_ps(_mm_loadu_ps(p_edges.e[0] + i), sign_mask);
+		const __m128 mey = _mm_xor_ps(_mm_loadu_ps(p_edges.e[1] + i), sign_mask);
+		const __m128 mez = _mm_xor_ps(_mm_loadu_ps(p_edges.e[2] + i), sign_mask);
+
+		const __m128 CBA = _dot_sse2(_mm_loadu_ps(p_edges.u[0] + i), _mm_loadu_ps(p_edges.u[1] + i), _mm_loadu_ps(p_edges.u[2] + i), ex, ey, ez);
+		const __m128 DBA = _dot_sse2(_mm_loadu_ps(p_edges.v[0] + i), _mm_loadu_ps(p_edges.v[1] + i), _mm_loadu_ps(p_edges.v[2] + i), ex, ey, ez);
+		const __m128 ADC = _dot_sse2(ux, uy, uz, mex, mey, mez);
+		const __m128 BDC = _dot_sse2(vx, vy, vz, mex, mey, mez);
+
+		const __m128 face = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(_mm_mul_ps(CBA, DBA), zero), _mm_cmplt_ps(_mm_mul_ps(ADC, BDC), zero)), _mm_cmpgt_ps(_mm_mul_ps(CBA, BDC), zero));
+		const int mask = _mm_movemask_ps(face);
+		for (int j = 0; mask && j < KERNEL_LANES; j++) {
+			if (mask & (1 << j)) {
+				r_indices[count++] = i + j;
+			}
+		}
+	}
+	for (; i < p_edges.count; i++) {
+		if (_is_minkowski_edge(p_u, p_v, p_e, p_edges, i)) {
+			r_indices[count++] = i;
+		}
+	}
+	return count;
+}
+
+#endif // COLLISION_KERNELS_SSE2
+
+#ifdef COLLISION_KERNELS_NEON
+
+/* NEON */
+
+// (a * x + b * y) + c * z, in the same order as Vector3::dot().
+static _FORCE_INLINE_ float32x4_t _dot_neon(float32x4_t p_a, float32x4_t p_b, float32x4_t p_c, float32x4_t p_x, float32x4_t p_y, float32x4_t p_z) {
+	return vaddq_f32(vaddq_f32(vmulq_f32(p_a, p_x), vmulq_f32(p_b, p_y)), vmulq_f32(p_c, p_z));
+}
+
+static void _project_box_neon(const Transform3D &p_transform, const Vector3 &p_half_extents, const GodotCollisionKernels3D::AxisBatch &p_axes, real_t *r_min, real_t *r_max) {
+	const Basis &b = p_transform.basis;
+
+	int i = 0;
+	for (; i + KERNEL_LANES <= p_axes.count; i += KERNEL_LANES) {
+		const float32x4_t x = vld1q_f32(p_axes.x + i);
+		const float32x4_t y = vld1q_f32(p_axes.y + i);
+		const float32x4_t z = vld1q_f32(p_axes.z + i);
+
+		// Basis::xform_inv().
+		const float32x4_t lx = _dot_neon(vdupq_n_f32(b.rows[0][0]), vdupq_n_f32(b.rows[1][0]), vdupq_n_f32(b.rows[2][0]), x, y, z);
+		const float32x4_t ly = _dot_neon(vdupq_n_f32(b.rows[0][1]), vdupq_n_f32(b.rows[1][1]), vdupq_n_f32(b.rows[2][1]), x, y, z);
+		const float32x4_t lz = _dot_neon(vdupq_n_f32(b.rows[0][2]), vdupq_n_f32(b.rows[1][2]), vdupq_n_f32(b.rows[2][2]), x, y, z);
+
+		const float32x4_t length = _dot_neon(vabsq_f32(lx), vabsq_f32(ly), vabsq_f32(lz), vdupq_n_f32(p_half_extents.x), vdupq_n_f32(p_half_extents.y), vdupq_n_f32(p_half_extents.z));
+		const float32x4_t distance = _dot_neon(x, y, z, vdupq_n_f32(p_transform.origin.x), vdupq_n_f32(p_transform.origin.y), vdupq_n_f32(p_transform.origin.z));
+
+		vst1q_f32(r_min + i, vsubq_f32(distance, length));
+		vst1q_f32(r_max + i, vaddq_f32(distance, length));
+	}
+	for (; i < p_axes.count; i++) {
+		_project_box_axis(p_transform, p_half_extents, p_axes.get(i), r_min[i], r_max[i]);
+	}
+}
+
+static void _project_capsule_neon(const Transform3D &p_transform, real_t p_radius, real_t p_height, const GodotCollisionKernels3D::AxisBatch &p_axes, real_t *r_min, real_t *r_max) {
+	const Basis &b = p_transform.basis;
+	const real_t h = p_height * 0.5 - p_radius;
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t radius = vdupq_n_f32(p_radius);
+	const float32x4_t ox = vdupq_n_f32(p_transform.origin.x);
+	const float32x4_t oy = vdupq_n_f32(p_transform.origin.y);
+	const float32x4_t oz = vdupq_n_f32(p_transform.origin.z);
+
+	int i = 0;
+	for (; i + KERNEL_LANES <= p_axes.count; i += KERNEL_LANES) {
+		const float32x4_t x = vld1q_f32(p_axes.x + i);
+		const float32x4_t y = vld1q_f32(p_axes.y + i);
+		const float32x4_t z = vld1q_f32(p_axes.z + i);
+
+		// Basis::xform_inv(), then Vector3::normalized().
+		float32x4_t nx = _dot_neon(vdupq_n_f32(b.rows[0][0]), vdupq_n_f32(b.rows[1][0]), vdupq_n_f32(b.rows[2][0]), x, y, z);
+		float32x4_t ny = _dot_neon(vdupq_n_f32(b.rows[0][1]), vdupq_n_f32(b.rows[1][1]), vdupq_n_f32(b.rows[2][1]), x, y, z);
+		float32x4_t nz = _dot_neon(vdupq_n_f32(b.rows[0][2]), vdupq_n_f32(b.rows[1][2]), vdupq_n_f32(b.rows[2][2]), x, y, z);
+		const float32x4_t length_squared = _dot_neon(nx, ny, nz, nx, ny, nz);
+		const uint32x4_t is_zero = vceqq_f32(length_squared, zero);
+		const float32x4_t length = vsqrtq_f32(length_squared);
+		nx = vbslq_f32(is_zero, zero, vdivq_f32(nx, length));
+		ny = vbslq_f32(is_zero, zero, vdivq_f32(ny, length));
+		nz = vbslq_f32(is_zero, zero, vdivq_f32(nz, length));
+
+		nx = vmulq_f32(nx, radius);
+		ny = vmulq_f32(ny, radius);
+		nz = vmulq_f32(nz, radius);
+		ny = vaddq_f32(ny, vbslq_f32(vcgtq_f32(ny, zero), vdupq_n_f32(h), vdupq_n_f32(-h)));
+
+		// Transform3D::xform() of both ends.
+		const float32x4_t tx = _dot_neon(vdupq_n_f32(b.rows[0][0]), vdupq_n_f32(b.rows[0][1]), vdupq_n_f32(b.rows[0][2]), nx, ny, nz);
+		const float32x4_t ty = _dot_neon(vdupq_n_f32(b.rows[1][0]), vdupq_n_f32(b.rows[1][1]), vdupq_n_f32(b.rows[1][2]), nx, ny, nz);
+		const float32x4_t tz = _dot_neon(vdupq_n_f32(b.rows[2][0]), vdupq_n_f32(b.rows[2][1]), vdupq_n_f32(b.rows[2][2]), nx, ny, nz);
+		const float32x4_t mnx = vnegq_f32(nx);
+		const float32x4_t mny = vnegq_f32(ny);
+		const float32x4_t mnz = vnegq_f32(nz);
+		const float32x4_t mtx = _dot_neon(vdupq_n_f32(b.rows[0][0]), vdupq_n_f32(b.rows[0][1]), vdupq_n_f32(b.rows[0][2]), mnx, mny, mnz);
+		const float32x4_t mty = _dot_neon(vdupq_n_f32(b.rows[1][0]), vdupq_n_f32(b.rows[1][1]), vdupq_n_f32(b.rows[1][2]), mnx, mny, mnz);
+		const float32x4_t mtz = _dot_neon(vdupq_n_f32(b.rows[2][0]), vdupq_n_f32(b.rows[2][1]), vdupq_n_f32(b.rows[2][2]), mnx, mny, mnz);
+
+		vst1q_f32(r_max + i, _dot_neon(x, y, z, vaddq_f32(tx, ox), vaddq_f32(ty, oy), vaddq_f32(tz, oz)));
+		vst1q_f32(r_min + i, _dot_neon(x, y, z, vaddq_f32(mtx, ox), vaddq_f32(mty, oy), vaddq_f32(mtz, oz)));
+	}
+	for (; i < p_axes.count; i++) {
+		_project_capsule_axis(p_transform, p_radius, p_height, p_axes.get(i), r_min[i], r_max[i]);
+	}
+}
+
+// The axis dotted with the transformed points, in the same order as Vector3::dot() and Transform3D::xform().
+static _FORCE_INLINE_ float32x4_t _project_points_neon(const Vector3 &p_axis, const Transform3D &p_transform, const Vector3 *p_points) {
+	const Basis &b = p_transform.basis;
+	const float32x4x3_t p = vld3q_f32(&p_points[0].x);
+
+	const float32x4_t tx = vaddq_f32(_dot_neon(vdupq_n_f32(b.rows[0][0]), vdupq_n_f32(b.rows[0][1]), vdupq_n_f32(b.rows[0][2]), p.val[0], p.val[1], p.val[2]), vdupq_n_f32(p_transform.origin.x));
+	const float32x4_t ty = vaddq_f32(_dot_neon(vdupq_n_f32(b.rows[1][0]), vdupq_n_f32(b.rows[1][1]), vdupq_n_f32(b.rows[1][2]), p.val[0], p.val[1], p.val[2]), vdupq_n_f32(p_transform.origin.y));
+	const float32x4_t tz = vaddq_f32(_dot_neon(vdupq_n_f32(b.rows[2][0]), vdupq_n_f32(b.rows[2][1]), vdupq_n_f32(b.rows[2][2]), p.val[0], p.val[1], p.val[2]), vdupq_n_f32(p_transform.origin.z));
+	return _dot_neon(vdupq_n_f32(p_axis.x), vdupq_n_f32(p_axis.y), vdupq_n_f32(p_axis.z), tx, ty, tz);
+}
+
+static void _project_points_neon(const Vector3 &p_axis, const Transform3D &p_transform, const Vector3 *p_points, int p_count, real_t &r_min, real_t &r_max) {
+	int i = 0;
+	bool has_range = false;
+	if (p_count >= KERNEL_LANES) {
+		float32x4_t max = _project_points_neon(p_axis, p_transform, p_points);
+		float32x4_t min = max;
+		for (i = KERNEL_LANES; i + KERNEL_LANES <= p_count; i += KERNEL_LANES) {
+			const float32x4_t d = _project_points_neon(p_axis, p_transform, p_points + i);
+			max = vbslq_f32(vcgtq_f32(d, max), d, max);
+			min = vbslq_f32(vcltq_f32(d, min), d, min);
+		}
+
+		real_t lane_min[KERNEL_LANES];
+		real_t lane_max[KERNEL_LANES];
+		vst1q_f32(lane_min, min);
+		vst1q_f32(lane_max, max);
+		_merge_range_lanes(lane_min, lane_max, r_min, r_max);
+		has_range = true;
+	}
+	_project_points_tail(p_axis, p_transform, p_points, i, p_count, has_range, r_min, r_max);
+}
+
+static int _find_support_neon(const Vector3 &p_direction, const Vector3 *p_points, int p_count) {
+	int i = 0;
+	int best = -1;
+	real_t support = 0.0;
+	if (p_count >= KERNEL_LANES) {
+		const float32x4_t dx = vdupq_n_f32(p_direction.x);
+		const float32x4_t dy = vdupq_n_f32(p_direction.y);
+		const float32x4_t dz = vdupq_n_f32(p_direction.z);
+		const int32x4_t step = vdupq_n_s32(KERNEL_LANES);
+
+		float32x4x3_t p = vld3q_f32(&p_points[0].x);
+		float32x4_t lane_support = _dot_neon(dx, dy, dz, p.val[0], p.val[1], p.val[2]);
+		const int32_t first_indices[KERNEL_LANES] = { 0, 1, 2, 3 };
+		int32x4_t lane_index = vld1q_s32(first_indices);
+		int32x4_t index = lane_index;
+		for (i = KERNEL_LANES; i + KERNEL_LANES <= p_count; i += KERNEL_LANES) {
+			index = vaddq_s32(index, step);
+			p = vld3q_f32(&p_points[i].x);
+			const float32x4_t s = _dot_neon(dx, dy, dz, p.val[0], p.val[1], p.val[2]);
+			const uint32x4_t better = vcgtq_f32(s, lane_support);
+			lane_support = vbslq_f32(better, s, lane_support);
+			lane_index = vbslq_s32(better, index, lane_index);
+		}
+
+		real_t supports[KERNEL_LANES];
+		int32_t indices[KERNEL_LANES];
+		vst1q_f32(supports, lane_support);
+		vst1q_s32(indices, lane_index);
+		best = _merge_support_lanes(supports, indices, support);
+	}
+	return _find_support_tail(p_direction, p_points, i, p_count, best, support);
+}
+
+static int _find_minkowski_edges_neon(const Vector3 &p_u, const Vector3 &p_v, const Vector3 &p_e, const GodotCollisionKernels3D::EdgeBatch &p_edges, int *r_indices) {
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t ux = vdupq_n_f32(p_u.x);
+	const float32x4_t uy = vdupq_n_f32(p_u.y);
+	const float32x4_t uz = vdupq_n_f32(p_u.z);
+	const float32x4_t vx = vdupq_n_f32(p_v.x);
+	const float32x4_t vy = vdupq_n_f32(p_v.y);
+	const float32x4_t vz = vdupq_n_f32(p_v.z);
+	const float32x4_t ex = vdupq_n_f32(p_e.x);
+	const float32x4_t ey = vdupq_n_f32(p_e.y);
+	const float32x4_t ez = vdupq_n_f32(p_e.z);
+
+	int count = 0;
+	int i = 0;
+	for (; i + KERNEL_LANES <= p_edges.count; i += KERNEL_LANES) {
+		const float32x4_t mex = vnegq_f32(vld1q_f32(p_edges.e[0] + i));
+		const float32x4_t mey = vnegq_f32(vld1q_f32(p_edges.e[1] + i));
+		const float32x4_t mez = vnegq_f32(vld1q_f32(p_edges.e[2] + i));
+
+		const float32x4_t CBA = _dot_neon(vld1q_f32(p_edges.u[0] + i), vld1q_f32(p_edges.u[1] + i), vld1q_f32(p_edges.u[2] + i), ex, ey, ez);
+		const float32x4_t DBA = _dot_neon(vld1q_f32(p_edges.v[0] + i), vld1q_f32(p_edges.v[1] + i), vld1q_f32(p_edges.v[2] + i), ex, ey, ez);
+		const float32x4_t ADC = _dot_neon(ux, uy, uz, mex, mey, mez);
+		const float32x4_t BDC = _dot_neon(vx, vy, vz, mex, mey, mez);
+
+		const uint32x4_t face = vandq_u32(vandq_u32(vcltq_f32(vmulq_f32(CBA, DBA), zero), vcltq_f32(vmulq_f32(ADC, BDC), zero)), vcgtq_f32(vmulq_f32(CBA, BDC), zero));
+		if (vmaxvq_u32(face) == 0) {
+			continue;
+		}
+		uint32_t lanes[KERNEL_LANES];
+		vst1q_u32(lanes, face);
+		for (int j = 0; j < KERNEL_LANES; j++) {
+			if (lanes[j]) {
+				r_indices[count++] = i + j;
+			}
+		}
+	}
+	for (; i < p_edges.count; i++) {
+		if (_is_minkowski_edge(p_u, p_v, p_e, p_edges, i)) {
+			r_indices[count++] = i;
+		}
+	}
+	return count;
+}
+
+#endif // COLLISION_KERNELS_NEON
+
+/* Backend selection */
+
+#if defined(COLLISION_KERNELS_SSE2)
+GodotCollisionKernels3D::Backend GodotCollisionKernels3D::backend = BACKEND_SSE2;
+GodotCollisionKernels3D::ProjectBoxFunc GodotCollisionKernels3D::project_box = _project_box_sse2;
+GodotCollisionKernels3D::ProjectCapsuleFunc GodotCollisionKernels3D::project_capsule = _project_capsule_sse2;
+GodotCollisionKernels3D::ProjectPointsFunc GodotCollisionKernels3D::project_points = _project_points_sse2;
+GodotCollisionKernels3D::FindSupportFunc GodotCollisionKernels3D::find_support = _find_support_sse2;
+GodotCollisionKernels3D::FindMinkowskiEdgesFunc GodotCollisionKernels3D::find_minkowski_edges = _find_minkowski_edges_sse2;
+#elif defined(COLLISION_KERNELS_NEON)
+GodotCollisionKernels3D::Backend GodotCollisionKernels3D::backend = BACKEND_NEON;
+GodotCollisionKernels3D::ProjectBoxFunc GodotCollisionKernels3D::project_box = _project_box_neon;
+GodotCollisionKernels3D::ProjectCapsuleFunc GodotCollisionKernels3D::project_capsule = _project_capsule_neon;
+GodotCollisionKernels3D::ProjectPointsFunc GodotCollisionKernels3D::project_points = _project_points_neon;
+GodotCollisionKernels3D::FindSupportFunc GodotCollisionKernels3D::find_support = _find_support_neon;
+GodotCollisionKernels3D::FindMinkowskiEdgesFunc GodotCollisionKernels3D::find_minkowski_edges = _find_minkowski_edges_neon;
+#else
+GodotCollisionKernels3D::Backend GodotCollisionKernels3D::backend = BACKEND_SCALAR;
+GodotCollisionKernels3D::ProjectBoxFunc GodotCollisionKernels3D::project_box = _project_box_scalar;
+GodotCollisionKernels3D::ProjectCapsuleFunc GodotCollisionKernels3D::project_capsule = _project_capsule_scalar;
+GodotCollisionKernels3D::ProjectPointsFunc GodotCollisionKernels3D::project_points = _project_points_scalar;
+GodotCollisionKernels3D::FindSupportFunc GodotCollisionKernels3D::find_support = _find_support_scalar;
+GodotCollisionKernels3D::FindMinkowskiEdgesFunc GodotCollisionKernels3D::find_minkowski_edges = _find_minkowski_edges_scalar;
+#endif
+
+bool GodotCollisionKernels3D::is_backend_supported(Backend p_backend) {
+	switch (p_backend) {
+		case BACKEND_SCALAR:
+			return true;
+		case BACKEND_SSE2:
+#ifdef COLLISION_KERNELS_SSE2
+			return true;
+#else
+			return false;
+#endif
+		case BACKEND_NEON:
+#ifdef COLLISION_KERNELS_NEON
+			return true;
+#else
+			return false;
+#endif
+	}
+	return false;
+}
+
+GodotCollisionKernels3D::Backend GodotCollisionKernels3D::get_best_backend() {
+#if defined(COLLISION_KERNELS_SSE2)
+	return BACKEND_SSE2;
+#elif defined(COLLISION_KERNELS_NEON)
+	return BACKEND_NEON;
+#else
+	return BACKEND_SCALAR;
+#endif
+}
+
+void GodotCollisionKernels3D::set_backend(Backend p_backend) {
+	ERR_FAIL_COND_MSG(!is_backend_supported(p_backend), "This collision kernel backend isn't supported by this build.");
+
+	backend = p_backend;
+	switch (p_backend) {
+		case BACKEND_SCALAR: {
+			project_box = _project_box_scalar;
+			project_capsule = _project_capsule_scalar;
+			project_points = _project_points_scalar;
+			find_support = _find_support_scalar;
+			find_minkowski_edges = _find_minkowski_edges_scalar;
+		} break;
+		case BACKEND_SSE2: {
+#ifdef COLLISION_KERNELS_SSE2
+			project_box = _project_box_sse2;
+			project_capsule = _project_capsule_sse2;
+			project_points = _project_points_sse2;
+			find_support = _find_support_sse2;
+			find_minkowski_edges = _find_minkowski_edges_sse2;
+#endif
+		} break;
+		case BACKEND_NEON: {
+#ifdef COLLISION_KERNELS_NEON
+			project_box = _project_box_neon;
+			project_capsule = _project_capsule_neon;
+			project_points = _project_points_neon;
+			find_support = _find_support_neon;
+			find_minkowski_edges = _find_minkowski_edges_neon;
+#endif
+		} break;
+	}
+}
+
+const char *GodotCollisionKernels3D::get_backend_name(Backend p_backend) {
+	switch (p_backend) {
+		case BACKEND_SCALAR:
+			return "Scalar";
+		case BACKEND_SSE2:
+			return "SSE2";
+		case BACKEND_NEON:
+			return "NEON";
+	}
+	return "Unknown";
+}
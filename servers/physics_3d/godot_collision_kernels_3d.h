@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  godot_collision_kernels_3d.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_COLLISION_KERNELS_3D_H
+#define GODOT_COLLISION_KERNELS_3D_H
+
+#include "core/math/transform_3d.h"
+
+// Narrowphase kernels which project shapes on several axes, or go through several points, at once.
+// SSE2 and NEON versions are used when the build supports them, and the backend can be changed at
+// runtime. The scalar versions go through the data in the same order and do the same operations,
+// so every backend gives the same results.
+class GodotCollisionKernels3D {
+public:
+	enum Backend {
+		BACKEND_SCALAR,
+		BACKEND_SSE2,
+		BACKEND_NEON,
+	};
+
+	// Axes are stored by component, so several of them can be loaded at once.
+	struct AxisBatch {
+		static constexpr int MAX_AXES = 32;
+
+		real_t x[MAX_AXES];
+		real_t y[MAX_AXES];
+		real_t z[MAX_AXES];
+		int count = 0;
+
+		_FORCE_INLINE_ bool is_full() const { return count == MAX_AXES; }
+		_FORCE_INLINE_ void push_back(const Vector3 &p_axis) {
+			x[count] = p_axis.x;
+			y[count] = p_axis.y;
+			z[count] = p_axis.z;
+			count++;
+		}
+		_FORCE_INLINE_ Vector3 get(int p_index) const { return Vector3(x[p_index], y[p_index], z[p_index]); }
+		_FORCE_INLINE_ void set(int p_index, const Vector3 &p_axis) {
+			x[p_index] = p_axis.x;
+			y[p_index] = p_axis.y;
+			z[p_index] = p_axis.z;
+		}
+	};
+
+	// Edges of a convex shape stored by component. `u` and `v` are the normals of the two faces
+	// sharing the edge and `e` its direction, all in world space.
+	struct EdgeBatch {
+		const real_t *u[3] = {};
+		const real_t *v[3] = {};
+		const real_t *e[3] = {};
+		int count = 0;
+	};
+
+	// Same as GodotBoxShape3D::project_range() for each axis.
+	typedef void (*ProjectBoxFunc)(const Transform3D &p_transform, const Vector3 &p_half_extents, const AxisBatch &p_axes, real_t *r_min, real_t *r_max);
+	// Same as GodotCapsuleShape3D::project_range() for each axis.
+	typedef void (*ProjectCapsuleFunc)(const Transform3D &p_transform, real_t p_radius, real_t p_height, const AxisBatch &p_axes, real_t *r_min, real_t *r_max);
+	// Range of the points on the axis once transformed.
+	typedef void (*ProjectPointsFunc)(const Vector3 &p_axis, const Transform3D &p_transform, const Vector3 *p_points, int p_count, real_t &r_min, real_t &r_max);
+	// Index of the first point furthest along the direction.
+	typedef int (*FindSupportFunc)(const Vector3 &p_direction, const Vector3 *p_points, int p_count);
+	// Writes the indices of the edges which form a face of the Minkowski difference with the given
+	// edge (i.e. whose cross product with it is worth testing as an axis), and returns their count.
+	typedef int (*FindMinkowskiEdgesFunc)(const Vector3 &p_u, const Vector3 &p_v, const Vector3 &p_e, const EdgeBatch &p_edges, int *r_indices);
+
+private:
+	static Backend backend;
+
+public:
+	static ProjectBoxFunc project_box;
+	static ProjectCapsuleFunc project_capsule;
+	static ProjectPointsFunc project_points;
+	static FindSupportFunc find_support;
+	static FindMinkowskiEdgesFunc find_minkowski_edges;
+
+	static bool is_backend_supported(Backend p_backend);
+	static Backend get_best_backend();
+	static void set_backend(Backend p_backend);
+	static Backend get_backend() { return backend; }
+	static const char *get_backend_name(Backend p_backend);
+};
+
+#endif // GODOT_COLLISION_KERNELS_3D_H
@@ -157,6 +157,24 @@ void GodotCollisionObject3D::_update_shapes() {
 		return;
 	}
 
+	_update_shape_aabbs();
+	_move_shapes_in_broadphase();
+}
+
+void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion) {
+	if (!space) {
+		return;
+	}
+
+	_update_shape_aabbs_with_motion(p_motion);
+	_move_shapes_in_broadphase();
+}
+
+void GodotCollisionObject3D::_update_shape_aabbs() {
+	if (!space) {
+		return;
+	}
+
 	for (int i = 0; i < shapes.size(); i++) {
 		Shape &s = shapes.write[i];
 		if (s.disabled) {
@@ -172,17 +190,11 @@ void GodotCollisionObject3D::_update_shapes() {
 
 		Vector3 scale = xform.get_basis().get_scale();
 		s.area_cache = s.shape->get_volume() * scale.x * scale.y * scale.z;
-
-		if (s.bpid == 0) {
-			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
-			space->get_broadphase()->set_static(s.bpid, _static);
-		}
-
-		space->get_broadphase()->move(s.bpid, shape_aabb);
 	}
+	broadphase_update_pending = true;
 }
 
-void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion) {
+void GodotCollisionObject3D::_update_shape_aabbs_with_motion(const Vector3 &p_motion) {
 	if (!space) {
 		return;
 	}
@@ -199,13 +211,31 @@ void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion)
 		shape_aabb = xform.xform(shape_aabb);
 		shape_aabb.merge_with(AABB(shape_aabb.position + p_motion, shape_aabb.size)); //use motion
 		s.aabb_cache = shape_aabb;
+	}
+	broadphase_update_pending = true;
+}
+
+void GodotCollisionObject3D::_move_shapes_in_broadphase() {
+	broadphase_update_pending = false;
+
+	for (int i = 0; i < shapes.size(); i++) {
+		Shape &s = shapes.write[i];
+		if (s.disabled) {
+			continue;
+		}
 
 		if (s.bpid == 0) {
-			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
+			s.bpid = space->get_broadphase()->create(this, i, s.aabb_cache, _static);
 			space->get_broadphase()->set_static(s.bpid, _static);
 		}
 
-		space->get_broadphase()->move(s.bpid, shape_aabb);
+		space->get_broadphase()->move(s.bpid, s.aabb_cache);
+	}
+}
+
+void GodotCollisionObject3D::update_broadphase() {
+	if (broadphase_update_pending && space) {
+		_move_shapes_in_broadphase();
 	}
 }
 
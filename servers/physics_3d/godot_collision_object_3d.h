@@ -79,10 +79,21 @@ private:
 
 	SelfList<GodotCollisionObject3D> pending_shape_update_list;
 
+	bool broadphase_update_pending = false;
+
+	uint32_t published_slot = UINT32_MAX;
+
 	void _update_shapes();
+	void _move_shapes_in_broadphase();
 
 protected:
 	void _update_shapes_with_motion(const Vector3 &p_motion);
+
+	// Like _update_shapes() and _update_shapes_with_motion(), but only compute the shape AABBs,
+	// so they are safe to call from worker threads. See update_broadphase().
+	void _update_shape_aabbs();
+	void _update_shape_aabbs_with_motion(const Vector3 &p_motion);
+
 	void _unregister_shapes();
 
 	_FORCE_INLINE_ void _set_transform(const Transform3D &p_transform, bool p_update_shapes = true) {
@@ -107,6 +118,10 @@ protected:
 	GodotCollisionObject3D(Type p_type);
 
 public:
+	// Moves the shapes in the broadphase after their AABBs were updated from a worker thread.
+	// Not thread-safe.
+	void update_broadphase();
+
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
@@ -145,6 +160,10 @@ public:
 	_FORCE_INLINE_ const Transform3D &get_inv_transform() const { return inv_transform; }
 	_FORCE_INLINE_ GodotSpace3D *get_space() const { return space; }
 
+	// Where GodotPublishedState3D keeps the object, only used by the physics thread.
+	_FORCE_INLINE_ void set_published_slot(uint32_t p_slot) { published_slot = p_slot; }
+	_FORCE_INLINE_ uint32_t get_published_slot() const { return published_slot; }
+
 	_FORCE_INLINE_ void set_ray_pickable(bool p_enable) { ray_pickable = p_enable; }
 	_FORCE_INLINE_ bool is_ray_pickable() const { return ray_pickable; }
 
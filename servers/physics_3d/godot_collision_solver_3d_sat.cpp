@@ -31,6 +31,7 @@
 #include "godot_collision_solver_3d_sat.h"
 
 #include "gjk_epa.h"
+#include "godot_collision_kernels_3d.h"
 
 #include "core/math/geometry_3d.h"
 
@@ -623,31 +624,24 @@ class SeparatorAxisTest {
 	real_t margin_A = 0.0;
 	real_t margin_B = 0.0;
 	Vector3 separator_axis;
+	GodotCollisionKernels3D::AxisBatch queued_axes;
 
-public:
-	Vector3 best_axis;
-
-	_FORCE_INLINE_ bool test_previous_axis() {
-		if (callback && callback->prev_axis && *callback->prev_axis != Vector3()) {
-			return test_axis(*callback->prev_axis);
-		} else {
-			return true;
-		}
+	static _FORCE_INLINE_ void _project_axes(const GodotBoxShape3D *p_box, const Transform3D &p_transform, const GodotCollisionKernels3D::AxisBatch &p_axes, real_t *r_min, real_t *r_max) {
+		GodotCollisionKernels3D::project_box(p_transform, p_box->get_half_extents(), p_axes, r_min, r_max);
 	}
 
-	_FORCE_INLINE_ bool test_axis(const Vector3 &p_axis) {
-		Vector3 axis = p_axis;
+	static _FORCE_INLINE_ void _project_axes(const GodotCapsuleShape3D *p_capsule, const Transform3D &p_transform, const GodotCollisionKernels3D::AxisBatch &p_axes, real_t *r_min, real_t *r_max) {
+		GodotCollisionKernels3D::project_capsule(p_transform, p_capsule->get_radius(), p_capsule->get_height(), p_axes, r_min, r_max);
+	}
 
-		if (axis.is_zero_approx()) {
-			// strange case, try an upwards separator
-			axis = Vector3(0.0, 1.0, 0.0);
+	template <typename Shape>
+	static _FORCE_INLINE_ void _project_axes(const Shape *p_shape, const Transform3D &p_transform, const GodotCollisionKernels3D::AxisBatch &p_axes, real_t *r_min, real_t *r_max) {
+		for (int i = 0; i < p_axes.count; i++) {
+			p_shape->project_range(p_axes.get(i), p_transform, r_min[i], r_max[i]);
 		}
+	}
 
-		real_t min_A = 0.0, max_A = 0.0, min_B = 0.0, max_B = 0.0;
-
-		shape_A->project_range(axis, *transform_A, min_A, max_A);
-		shape_B->project_range(axis, *transform_B, min_B, max_B);
-
+	_FORCE_INLINE_ bool _test_range(const Vector3 &p_axis, real_t min_A, real_t max_A, real_t min_B, real_t max_B) {
 		if (withMargin) {
 			min_A -= margin_A;
 			max_A += margin_A;
@@ -662,7 +656,7 @@ public:
 		max_B -= (min_A + max_A) * 0.5;
 
 		if (min_B > 0.0 || max_B < 0.0) {
-			separator_axis = axis;
+			separator_axis = p_axis;
 			return false; // doesn't contain 0
 		}
 
@@ -675,12 +669,82 @@ public:
 		if (max_B < min_B) {
 			if (max_B < best_depth) {
 				best_depth = max_B;
-				best_axis = axis;
+				best_axis = p_axis;
 			}
 		} else {
 			if (min_B < best_depth) {
 				best_depth = min_B;
-				best_axis = -axis; // keep it as A axis
+				best_axis = -p_axis; // keep it as A axis
+			}
+		}
+
+		return true;
+	}
+
+public:
+	Vector3 best_axis;
+
+	_FORCE_INLINE_ bool test_previous_axis() {
+		if (callback && callback->prev_axis && *callback->prev_axis != Vector3()) {
+			return test_axis(*callback->prev_axis);
+		} else {
+			return true;
+		}
+	}
+
+	_FORCE_INLINE_ bool test_axis(const Vector3 &p_axis) {
+		Vector3 axis = p_axis;
+
+		if (axis.is_zero_approx()) {
+			// strange case, try an upwards separator
+			axis = Vector3(0.0, 1.0, 0.0);
+		}
+
+		real_t min_A = 0.0, max_A = 0.0, min_B = 0.0, max_B = 0.0;
+
+		shape_A->project_range(axis, *transform_A, min_A, max_A);
+		shape_B->project_range(axis, *transform_B, min_B, max_B);
+
+		return _test_range(axis, min_A, max_A, min_B, max_B);
+	}
+
+	// Same as test_axis(), but the axis is only tested once enough of them are queued, or when
+	// flush_axes() is called, so shapes can be projected on several axes at once. Axes are still
+	// tested in order, so the result is the same. Call flush_axes() before generating contacts.
+	_FORCE_INLINE_ bool queue_axis(const Vector3 &p_axis) {
+		if (queued_axes.is_full() && !flush_axes()) {
+			return false;
+		}
+		queued_axes.push_back(p_axis);
+		return true;
+	}
+
+	bool flush_axes() {
+		GodotCollisionKernels3D::AxisBatch &axes = queued_axes;
+		const int count = axes.count;
+		if (count == 0) {
+			return true;
+		}
+
+		for (int i = 0; i < count; i++) {
+			if (axes.get(i).is_zero_approx()) {
+				// strange case, try an upwards separator
+				axes.set(i, Vector3(0.0, 1.0, 0.0));
+			}
+		}
+
+		real_t min_A[GodotCollisionKernels3D::AxisBatch::MAX_AXES];
+		real_t max_A[GodotCollisionKernels3D::AxisBatch::MAX_AXES];
+		real_t min_B[GodotCollisionKernels3D::AxisBatch::MAX_AXES];
+		real_t max_B[GodotCollisionKernels3D::AxisBatch::MAX_AXES];
+
+		_project_axes(shape_A, *transform_A, axes, min_A, max_A);
+		_project_axes(shape_B, *transform_B, axes, min_B, max_B);
+
+		axes.count = 0;
+		for (int i = 0; i < count; i++) {
+			if (!_test_range(axes.get(i), min_A[i], max_A[i], min_B[i], max_B[i])) {
+				return false;
 			}
 		}
 
@@ -1084,7 +1148,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1094,7 +1158,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_b.basis.get_column(i).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1109,7 +1173,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 			}
 			axis.normalize();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.queue_axis(axis)) {
 				return;
 			}
 		}
@@ -1140,7 +1204,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 
 		Vector3 axis_ab = (support_a - support_b);
 
-		if (!separator.test_axis(axis_ab.normalized())) {
+		if (!separator.queue_axis(axis_ab.normalized())) {
 			return;
 		}
 
@@ -1150,19 +1214,23 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 			//a ->b
 			Vector3 axis_a = p_transform_a.basis.get_column(i);
 
-			if (!separator.test_axis(axis_ab.cross(axis_a).cross(axis_a).normalized())) {
+			if (!separator.queue_axis(axis_ab.cross(axis_a).cross(axis_a).normalized())) {
 				return;
 			}
 
 			//b ->a
 			Vector3 axis_b = p_transform_b.basis.get_column(i);
 
-			if (!separator.test_axis(axis_ab.cross(axis_b).cross(axis_b).normalized())) {
+			if (!separator.queue_axis(axis_ab.cross(axis_b).cross(axis_b).normalized())) {
 				return;
 			}
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -1181,7 +1249,7 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1198,7 +1266,7 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 			continue;
 		}
 
-		if (!separator.test_axis(axis.normalized())) {
+		if (!separator.queue_axis(axis.normalized())) {
 			return;
 		}
 	}
@@ -1221,7 +1289,7 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 				//Vector3 axis = (point - cyl_axis * cyl_axis.dot(point)).normalized();
 				Vector3 axis = Plane(cyl_axis).project(point).normalized();
 
-				if (!separator.test_axis(axis)) {
+				if (!separator.queue_axis(axis)) {
 					return;
 				}
 			}
@@ -1246,7 +1314,7 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 		// use point to test axis
 		Vector3 point_axis = (sphere_pos - cpoint).normalized();
 
-		if (!separator.test_axis(point_axis)) {
+		if (!separator.queue_axis(point_axis)) {
 			return;
 		}
 
@@ -1255,12 +1323,16 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 		for (int j = 0; j < 3; j++) {
 			Vector3 axis = point_axis.cross(p_transform_a.basis.get_column(j)).cross(p_transform_a.basis.get_column(j)).normalized();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.queue_axis(axis)) {
 				return;
 			}
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -1401,7 +1473,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1413,7 +1485,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 	for (int i = 0; i < face_count; i++) {
 		Vector3 axis = b_xform_normal.xform(faces[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1427,7 +1499,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 
 			Vector3 axis = e1.cross(e2).normalized();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.queue_axis(axis)) {
 				return;
 			}
 		}
@@ -1449,7 +1521,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 
 			Vector3 axis_ab = support_a - vtxb;
 
-			if (!separator.test_axis(axis_ab.normalized())) {
+			if (!separator.queue_axis(axis_ab.normalized())) {
 				return;
 			}
 
@@ -1459,7 +1531,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 				//a ->b
 				Vector3 axis_a = p_transform_a.basis.get_column(i);
 
-				if (!separator.test_axis(axis_ab.cross(axis_a).cross(axis_a).normalized())) {
+				if (!separator.queue_axis(axis_ab.cross(axis_a).cross(axis_a).normalized())) {
 					return;
 				}
 			}
@@ -1483,7 +1555,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 						Vector3 p2 = p_transform_b.xform(vertices[edges[e].vertex_b]);
 						Vector3 n = (p2 - p1);
 
-						if (!separator.test_axis((point - p2).cross(n).cross(n).normalized())) {
+						if (!separator.queue_axis((point - p2).cross(n).cross(n).normalized())) {
 							return;
 						}
 					}
@@ -1492,6 +1564,10 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -1712,7 +1788,7 @@ static void _collision_capsule_convex_polygon(const GodotShape3D *p_a, const Tra
 	for (int i = 0; i < face_count; i++) {
 		Vector3 axis = b_xform_normal.xform(faces[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1724,7 +1800,7 @@ static void _collision_capsule_convex_polygon(const GodotShape3D *p_a, const Tra
 		Vector3 edge_axis = p_transform_b.basis.xform(vertices[edges[i].vertex_a]) - p_transform_b.basis.xform(vertices[edges[i].vertex_b]);
 		Vector3 axis = edge_axis.cross(p_transform_a.basis.get_column(1)).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1744,12 +1820,16 @@ static void _collision_capsule_convex_polygon(const GodotShape3D *p_a, const Tra
 
 			Vector3 axis = n1.cross(n2).cross(n2).normalized();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.queue_axis(axis)) {
 				return;
 			}
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -2025,16 +2105,6 @@ static void _collision_cylinder_face(const GodotShape3D *p_a, const Transform3D
 	separator.generate_contacts();
 }
 
-static _FORCE_INLINE_ bool is_minkowski_face(const Vector3 &A, const Vector3 &B, const Vector3 &B_x_A, const Vector3 &C, const Vector3 &D, const Vector3 &D_x_C) {
-	// Test if arcs AB and CD intersect on the unit sphere
-	real_t CBA = C.dot(B_x_A);
-	real_t DBA = D.dot(B_x_A);
-	real_t ADC = A.dot(D_x_C);
-	real_t BDC = B.dot(D_x_C);
-
-	return (CBA * DBA < 0.0f) && (ADC * BDC < 0.0f) && (CBA * BDC > 0.0f);
-}
-
 template <bool withMargin>
 static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, const Transform3D &p_transform_a, const GodotShape3D *p_b, const Transform3D &p_transform_b, _CollectorCallback *p_collector, real_t p_margin_a, real_t p_margin_b) {
 	const GodotConvexPolygonShape3D *convex_polygon_A = static_cast<const GodotConvexPolygonShape3D *>(p_a);
@@ -2071,7 +2141,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 	for (int i = 0; i < face_count_A; i++) {
 		Vector3 axis = a_xform_normal.xform(faces_A[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -2083,13 +2153,42 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 	for (int i = 0; i < face_count_B; i++) {
 		Vector3 axis = b_xform_normal.xform(faces_B[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
 
 	// A<->B edges
 
+	// The edges of B are put in world space once, and stored by component so the ones which form
+	// a face of the Minkowski difference with an edge of A can be found several at once.
+	thread_local LocalVector<real_t> edge_data_B;
+	thread_local LocalVector<int> minkowski_edges;
+	edge_data_B.resize(edge_count_B * 9);
+	minkowski_edges.resize(edge_count_B);
+
+	GodotCollisionKernels3D::EdgeBatch edge_batch_B;
+	for (int k = 0; k < 3; k++) {
+		edge_batch_B.u[k] = edge_data_B.ptr() + edge_count_B * k;
+		edge_batch_B.v[k] = edge_data_B.ptr() + edge_count_B * (3 + k);
+		edge_batch_B.e[k] = edge_data_B.ptr() + edge_count_B * (6 + k);
+	}
+	edge_batch_B.count = edge_count_B;
+
+	for (int j = 0; j < edge_count_B; j++) {
+		Vector3 p2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_a]);
+		Vector3 q2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_b]);
+		Vector3 e2 = q2 - p2;
+		Vector3 u2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_a].plane.normal).normalized();
+		Vector3 v2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_b].plane.normal).normalized();
+
+		for (int k = 0; k < 3; k++) {
+			edge_data_B[edge_count_B * k + j] = u2[k];
+			edge_data_B[edge_count_B * (3 + k) + j] = v2[k];
+			edge_data_B[edge_count_B * (6 + k) + j] = e2[k];
+		}
+	}
+
 	for (int i = 0; i < edge_count_A; i++) {
 		Vector3 p1 = p_transform_a.xform(vertices_A[edges_A[i].vertex_a]);
 		Vector3 q1 = p_transform_a.xform(vertices_A[edges_A[i].vertex_b]);
@@ -2097,19 +2196,14 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 		Vector3 u1 = p_transform_a.basis.xform(faces_A[edges_A[i].face_a].plane.normal).normalized();
 		Vector3 v1 = p_transform_a.basis.xform(faces_A[edges_A[i].face_b].plane.normal).normalized();
 
-		for (int j = 0; j < edge_count_B; j++) {
-			Vector3 p2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_a]);
-			Vector3 q2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_b]);
-			Vector3 e2 = q2 - p2;
-			Vector3 u2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_a].plane.normal).normalized();
-			Vector3 v2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_b].plane.normal).normalized();
-
-			if (is_minkowski_face(u1, v1, -e1, -u2, -v2, -e2)) {
-				Vector3 axis = e1.cross(e2).normalized();
+		int minkowski_edge_count = GodotCollisionKernels3D::find_minkowski_edges(u1, v1, e1, edge_batch_B, minkowski_edges.ptr());
+		for (int j = 0; j < minkowski_edge_count; j++) {
+			int edge = minkowski_edges[j];
+			Vector3 e2(edge_batch_B.e[0][edge], edge_batch_B.e[1][edge], edge_batch_B.e[2][edge]);
+			Vector3 axis = e1.cross(e2).normalized();
 
-				if (!separator.test_axis(axis)) {
-					return;
-				}
+			if (!separator.queue_axis(axis)) {
+				return;
 			}
 		}
 	}
@@ -2120,7 +2214,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 			Vector3 va = p_transform_a.xform(vertices_A[i]);
 
 			for (int j = 0; j < vertex_count_B; j++) {
-				if (!separator.test_axis((va - p_transform_b.xform(vertices_B[j])).normalized())) {
+				if (!separator.queue_axis((va - p_transform_b.xform(vertices_B[j])).normalized())) {
 					return;
 				}
 			}
@@ -2135,7 +2229,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 			for (int j = 0; j < vertex_count_B; j++) {
 				Vector3 e3 = p_transform_b.xform(vertices_B[j]);
 
-				if (!separator.test_axis((e1 - e3).cross(n).cross(n).normalized())) {
+				if (!separator.queue_axis((e1 - e3).cross(n).cross(n).normalized())) {
 					return;
 				}
 			}
@@ -2149,13 +2243,17 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 			for (int j = 0; j < vertex_count_A; j++) {
 				Vector3 e3 = p_transform_a.xform(vertices_A[j]);
 
-				if (!separator.test_axis((e1 - e3).cross(n).cross(n).normalized())) {
+				if (!separator.queue_axis((e1 - e3).cross(n).cross(n).normalized())) {
 					return;
 				}
 			}
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -31,7 +31,12 @@
 #ifndef GODOT_CONSTRAINT_3D_H
 #define GODOT_CONSTRAINT_3D_H
 
+#include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
+
+class GodotArea3D;
 class GodotBody3D;
+class GodotCollisionObject3D;
 class GodotSoftBody3D;
 
 class GodotConstraint3D {
@@ -71,6 +76,63 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	// Identifies a constraint across space snapshots. Joints use their own RID,
+	// body pairs use the RIDs and shape indices of both bodies.
+	struct StateKey {
+		uint64_t object_A = 0;
+		uint64_t object_B = 0;
+		int32_t shape_A = -1;
+		int32_t shape_B = -1;
+
+		static uint32_t hash(const StateKey &p_key) {
+			uint32_t h = hash_murmur3_one_64(p_key.object_A);
+			h = hash_murmur3_one_64(p_key.object_B, h);
+			h = hash_murmur3_one_32(p_key.shape_A, h);
+			h = hash_murmur3_one_32(p_key.shape_B, h);
+			return hash_fmix32(h);
+		}
+		bool operator==(const StateKey &p_key) const {
+			return object_A == p_key.object_A && object_B == p_key.object_B && shape_A == p_key.shape_A && shape_B == p_key.shape_B;
+		}
+	};
+
+	// Plain values are stored with their native layout, snapshots are only meant
+	// to be restored by the same build that saved them.
+	template <typename T>
+	static void state_write(LocalVector<uint8_t> &r_state, const T &p_value) {
+		uint32_t ofs = r_state.size();
+		r_state.resize(ofs + sizeof(T));
+		memcpy(r_state.ptr() + ofs, &p_value, sizeof(T));
+	}
+
+	template <typename T>
+	static bool state_read(const uint8_t *&r_state, const uint8_t *p_end, T &r_value) {
+		if (p_end - r_state < (int64_t)sizeof(T)) {
+			return false;
+		}
+		memcpy(&r_value, r_state, sizeof(T));
+		r_state += sizeof(T);
+		return true;
+	}
+
+	virtual StateKey get_state_key() const {
+		StateKey key;
+		key.object_A = self.get_id();
+		return key;
+	}
+
+	// Solver state carried over between steps (e.g. accumulated impulses used for
+	// warm starting), saved and restored along with the bodies by space snapshots.
+	virtual void save_state(LocalVector<uint8_t> &r_state) const {}
+	virtual bool load_state(const uint8_t *p_state, uint32_t p_size) { return p_size == 0; }
+	virtual void reset_state() {}
+
+	// For area pairs, the object p_area currently overlaps through this pair, if any.
+	virtual const GodotCollisionObject3D *get_area_overlap(const GodotArea3D *p_area) const { return nullptr; }
+
+	// For pairs, the types of the shapes tested by the narrowphase, used for profiling.
+	virtual bool get_pair_shape_types(int &r_type_A, int &r_type_B) const { return false; }
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
@@ -105,12 +105,14 @@ RID GodotPhysicsServer3D::custom_shape_create() {
 void GodotPhysicsServer3D::shape_set_data(RID p_shape, const Variant &p_data) {
 	GodotShape3D *shape = shape_owner.get_or_null(p_shape);
 	ERR_FAIL_NULL(shape);
+	RWLockWrite published_lock(published_state.get_lock()); // Published queries may be using it.
 	shape->set_data(p_data);
 };
 
 void GodotPhysicsServer3D::shape_set_custom_solver_bias(RID p_shape, real_t p_bias) {
 	GodotShape3D *shape = shape_owner.get_or_null(p_shape);
 	ERR_FAIL_NULL(shape);
+	RWLockWrite published_lock(published_state.get_lock());
 	shape->set_custom_bias(p_bias);
 }
 
@@ -214,6 +216,64 @@ int GodotPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+PackedByteArray GodotPhysicsServer3D::space_save_snapshot(RID p_space) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, PackedByteArray());
+	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync) || space->is_locked(), PackedByteArray(), "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->save_snapshot();
+}
+
+Error GodotPhysicsServer3D::space_restore_snapshot(RID p_space, const PackedByteArray &p_snapshot) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync) || space->is_locked(), ERR_LOCKED, "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->restore_snapshot(p_snapshot.ptr(), p_snapshot.size());
+}
+
+void GodotPhysicsServer3D::space_set_publish_state(RID p_space, bool p_enable) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL(space);
+
+	published_state.set_space_publishing(space, p_enable);
+}
+
+bool GodotPhysicsServer3D::space_is_publishing_state(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+
+	return published_state.is_space_publishing(space);
+}
+
+PhysicsDirectSpaceState3D *GodotPhysicsServer3D::space_get_published_direct_state(RID p_space) {
+	// Don't require the space to be initialized, it may still be waiting in the command queue.
+	ERR_FAIL_COND_V(!space_owner.owns(p_space), nullptr);
+
+	return published_state.get_direct_state(p_space);
+}
+
+void GodotPhysicsServer3D::space_set_profiling_enabled(RID p_space, bool p_enabled) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL(space);
+
+	space->set_profiling(p_enabled);
+}
+
+bool GodotPhysicsServer3D::space_is_profiling_enabled(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+
+	return space->is_profiling();
+}
+
+Dictionary GodotPhysicsServer3D::space_get_profile(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, Dictionary());
+
+	return space->get_profile_info();
+}
+
 RID GodotPhysicsServer3D::area_create() {
 	GodotArea3D *area = memnew(GodotArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -437,6 +497,10 @@ void GodotPhysicsServer3D::area_set_area_monitor_callback(RID p_area, const Call
 	area->set_area_monitor_callback(p_callback.is_valid() ? p_callback : Callable());
 }
 
+TypedArray<RID> GodotPhysicsServer3D::area_get_published_overlaps(RID p_area) const {
+	return published_state.get_area_overlaps(p_area);
+}
+
 /* BODY API */
 
 RID GodotPhysicsServer3D::body_create() {
@@ -691,6 +755,10 @@ Variant GodotPhysicsServer3D::body_get_state(RID p_body, BodyState p_state) cons
 	return body->get_state(p_state);
 }
 
+Variant GodotPhysicsServer3D::body_get_published_state(RID p_body, BodyState p_state) const {
+	return published_state.get_body_state(p_body, p_state);
+}
+
 void GodotPhysicsServer3D::body_apply_central_impulse(RID p_body, const Vector3 &p_impulse) {
 	GodotBody3D *body = body_owner.get_or_null(p_body);
 	ERR_FAIL_NULL(body);
@@ -1565,6 +1633,10 @@ void GodotPhysicsServer3D::free(RID p_rid) {
 		}
 
 		shape_owner.free(p_rid);
+		{
+			RWLockWrite published_lock(published_state.get_lock());
+			published_state.remove_shape(shape);
+		}
 		memdelete(shape);
 	} else if (body_owner.owns(p_rid)) {
 		GodotBody3D *body = body_owner.get_or_null(p_rid);
@@ -1608,6 +1680,7 @@ void GodotPhysicsServer3D::free(RID p_rid) {
 		free(space->get_static_global_body());
 
 		space_owner.free(p_rid);
+		published_state.remove_space(p_rid);
 		memdelete(space);
 	} else if (joint_owner.owns(p_rid)) {
 		GodotJoint3D *joint = joint_owner.get_or_null(p_rid);
@@ -1640,12 +1713,20 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	constraint_count = 0;
+	step_usec = 0;
 	for (const GodotSpace3D *E : active_spaces) {
 		stepper->step(const_cast<GodotSpace3D *>(E), p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
+		constraint_count += E->get_constraint_count();
+		for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
+			step_usec += E->get_elapsed_time(GodotSpace3D::ElapsedTime(i));
+		}
 	}
+
+	published_state.publish();
 #endif
 }
 
@@ -1673,13 +1754,6 @@ void GodotPhysicsServer3D::flush_queries() {
 
 	if (EngineDebugger::is_profiling("servers")) {
 		uint64_t total_time[GodotSpace3D::ELAPSED_TIME_MAX];
-		static const char *time_name[GodotSpace3D::ELAPSED_TIME_MAX] = {
-			"integrate_forces",
-			"generate_islands",
-			"setup_constraints",
-			"solve_constraints",
-			"integrate_velocities"
-		};
 
 		for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
 			total_time[i] = 0;
@@ -1694,7 +1768,7 @@ void GodotPhysicsServer3D::flush_queries() {
 		Array values;
 		values.resize(GodotSpace3D::ELAPSED_TIME_MAX * 2);
 		for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
-			values[i * 2 + 0] = time_name[i];
+			values[i * 2 + 0] = GodotSpace3D::get_elapsed_time_name(GodotSpace3D::ElapsedTime(i));
 			values[i * 2 + 1] = USEC_TO_SEC(total_time[i]);
 		}
 		values.push_back("flush_queries");
@@ -1702,6 +1776,20 @@ void GodotPhysicsServer3D::flush_queries() {
 
 		values.push_front("physics_3d");
 		EngineDebugger::profiler_add_frame_data("servers", values);
+
+		// Spaces being profiled are also reported on their own.
+		for (const GodotSpace3D *E : active_spaces) {
+			if (!E->is_profiling()) {
+				continue;
+			}
+			Array space_values;
+			space_values.push_back(vformat("physics_3d_space_%d", E->get_self().get_id()));
+			for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
+				space_values.push_back(GodotSpace3D::get_elapsed_time_name(GodotSpace3D::ElapsedTime(i)));
+				space_values.push_back(USEC_TO_SEC(E->get_elapsed_time(GodotSpace3D::ElapsedTime(i))));
+			}
+			EngineDebugger::profiler_add_frame_data("servers", space_values);
+		}
 	}
 #endif
 }
@@ -1725,6 +1813,12 @@ int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
 		case INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case INFO_CONSTRAINT_COUNT: {
+			return constraint_count;
+		} break;
+		case INFO_STEP_USEC: {
+			return (int)step_usec;
+		} break;
 	}
 
 	return 0;
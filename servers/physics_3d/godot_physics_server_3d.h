@@ -32,6 +32,7 @@
 #define GODOT_PHYSICS_SERVER_3D_H
 
 #include "godot_joint_3d.h"
+#include "godot_published_state_3d.h"
 #include "godot_shape_3d.h"
 #include "godot_space_3d.h"
 #include "godot_step_3d.h"
@@ -43,11 +44,14 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	GDCLASS(GodotPhysicsServer3D, PhysicsServer3D);
 
 	friend class GodotPhysicsDirectSpaceState3D;
+	friend class GodotPublishedDirectSpaceState3D;
 	bool active = true;
 
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int constraint_count = 0;
+	uint64_t step_usec = 0;
 
 	bool using_threads = false;
 	bool doing_sync = false;
@@ -63,6 +67,8 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	mutable RID_PtrOwner<GodotSoftBody3D, true> soft_body_owner;
 	mutable RID_PtrOwner<GodotJoint3D, true> joint_owner;
 
+	GodotPublishedState3D published_state;
+
 	//void _clear_query(QuerySW *p_query);
 	friend class GodotCollisionObject3D;
 	SelfList<GodotCollisionObject3D>::List pending_shape_update_list;
@@ -117,6 +123,17 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual PackedByteArray space_save_snapshot(RID p_space) override;
+	virtual Error space_restore_snapshot(RID p_space, const PackedByteArray &p_snapshot) override;
+
+	virtual void space_set_publish_state(RID p_space, bool p_enable) override;
+	virtual bool space_is_publishing_state(RID p_space) const override;
+	virtual PhysicsDirectSpaceState3D *space_get_published_direct_state(RID p_space) override;
+
+	virtual void space_set_profiling_enabled(RID p_space, bool p_enabled) override;
+	virtual bool space_is_profiling_enabled(RID p_space) const override;
+	virtual Dictionary space_get_profile(RID p_space) const override;
+
 	/* AREA API */
 
 	virtual RID area_create() override;
@@ -159,6 +176,8 @@ public:
 	virtual void area_set_monitor_callback(RID p_area, const Callable &p_callback) override;
 	virtual void area_set_area_monitor_callback(RID p_area, const Callable &p_callback) override;
 
+	virtual TypedArray<RID> area_get_published_overlaps(RID p_area) const override;
+
 	/* BODY API */
 
 	// create a body of a given type
@@ -208,6 +227,7 @@ public:
 
 	virtual void body_set_state(RID p_body, BodyState p_state, const Variant &p_variant) override;
 	virtual Variant body_get_state(RID p_body, BodyState p_state) const override;
+	virtual Variant body_get_published_state(RID p_body, BodyState p_state) const override;
 
 	virtual void body_apply_central_impulse(RID p_body, const Vector3 &p_impulse) override;
 	virtual void body_apply_impulse(RID p_body, const Vector3 &p_impulse, const Vector3 &p_position = Vector3()) override;
@@ -0,0 +1,907 @@
+/**************************************************************************/
+/*  godot_published_state_3d.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_published_state_3d.h"
+
+#include "godot_collision_solver_3d.h"
+#include "godot_physics_server_3d.h"
+
+#include "core/templates/sort_array.h"
+
+#define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
+#define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
+
+typedef GodotPublishedState3D::Object PublishedObject;
+typedef GodotPublishedState3D::Shape PublishedShape;
+
+struct _PublishedCullResult {
+	uint32_t *objects = nullptr;
+	int count = 0;
+
+	_FORCE_INLINE_ bool operator()(void *p_data) {
+		objects[count++] = (uint32_t)(uintptr_t)p_data;
+		return count >= GodotPublishedState3D::INTERSECTION_QUERY_MAX;
+	}
+};
+
+static bool _can_query(const PublishedObject &p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, const HashSet<RID> &p_exclude) {
+	if (!(p_object.collision_layer & p_collision_mask)) {
+		return false;
+	}
+
+	if (p_object.type == GodotCollisionObject3D::TYPE_AREA ? !p_collide_with_areas : !p_collide_with_bodies) {
+		return false;
+	}
+
+	return !p_exclude.has(p_object.self);
+}
+
+static Vector3 _get_velocity_at(const PublishedObject &p_object, const Vector3 &p_position) {
+	if (p_object.type != GodotCollisionObject3D::TYPE_BODY) {
+		return Vector3();
+	}
+	Vector3 rel_vec = p_position - (p_object.transform.origin + p_object.center_of_mass);
+	return p_object.linear_velocity + p_object.angular_velocity.cross(rel_vec);
+}
+
+int GodotPublishedDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	RWLockRead read_lock(published->lock);
+
+	const GodotPublishedState3D::Buffer *buffer = nullptr;
+	DynamicBVH *bvh = nullptr;
+	if (!published->_get_space(space, buffer, bvh)) {
+		return 0;
+	}
+
+	uint32_t objects[GodotPublishedState3D::INTERSECTION_QUERY_MAX];
+	_PublishedCullResult cull;
+	cull.objects = objects;
+	bvh->aabb_query(AABB(p_parameters.position, Vector3()), cull);
+
+	int cc = 0;
+
+	for (int i = 0; i < cull.count && cc < p_result_max; i++) {
+		const PublishedObject &object = buffer->objects[objects[i]];
+		if (!_can_query(object, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude)) {
+			continue;
+		}
+
+		for (uint32_t j = 0; j < object.shape_count && cc < p_result_max; j++) {
+			const PublishedShape &shape = buffer->shapes[object.shape_from + j];
+			if (!shape.shape || !shape.aabb.has_point(p_parameters.position)) {
+				continue;
+			}
+
+			if (!shape.shape->intersect_point(shape.transform.affine_inverse().xform(p_parameters.position))) {
+				continue;
+			}
+
+			r_results[cc].collider_id = object.instance_id;
+			if (r_results[cc].collider_id.is_valid()) {
+				r_results[cc].collider = ObjectDB::get_instance(r_results[cc].collider_id);
+			} else {
+				r_results[cc].collider = nullptr;
+			}
+			r_results[cc].rid = object.self;
+			r_results[cc].shape = shape.index;
+
+			cc++;
+		}
+	}
+
+	return cc;
+}
+
+bool GodotPublishedDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	RWLockRead read_lock(published->lock);
+
+	const GodotPublishedState3D::Buffer *buffer = nullptr;
+	DynamicBVH *bvh = nullptr;
+	if (!published->_get_space(space, buffer, bvh)) {
+		return false;
+	}
+
+	uint32_t objects[GodotPublishedState3D::INTERSECTION_QUERY_MAX];
+	_PublishedCullResult cull;
+	cull.objects = objects;
+	bvh->ray_query(p_parameters.from, p_parameters.to, cull);
+
+	const Vector3 &begin = p_parameters.from;
+	const Vector3 &end = p_parameters.to;
+	Vector3 normal = (end - begin).normalized();
+
+	bool collided = false;
+	bool inside = false;
+	Vector3 res_point, res_normal;
+	int res_face_index = -1;
+	int res_shape = -1;
+	const PublishedObject *res_obj = nullptr;
+	real_t min_d = 1e10;
+
+	for (int i = 0; i < cull.count && !inside; i++) {
+		const PublishedObject &object = buffer->objects[objects[i]];
+		if (!_can_query(object, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude)) {
+			continue;
+		}
+
+		if (p_parameters.pick_ray && !object.ray_pickable) {
+			continue;
+		}
+
+		for (uint32_t j = 0; j < object.shape_count; j++) {
+			const PublishedShape &shape = buffer->shapes[object.shape_from + j];
+			if (!shape.shape || !shape.aabb.intersects_segment(begin, end)) {
+				continue;
+			}
+
+			Transform3D inv_xform = shape.transform.affine_inverse();
+			Vector3 local_from = inv_xform.xform(begin);
+			Vector3 local_to = inv_xform.xform(end);
+
+			Vector3 shape_point, shape_normal;
+			int shape_face_index = -1;
+
+			if (shape.shape->intersect_point(local_from)) {
+				if (p_parameters.hit_from_inside) {
+					// Hit shape at starting point.
+					min_d = 0;
+					res_point = begin;
+					res_normal = Vector3();
+					res_shape = shape.index;
+					res_obj = &object;
+					collided = true;
+					inside = true;
+					break;
+				} else {
+					// Ignore shape when starting inside.
+					continue;
+				}
+			}
+
+			if (shape.shape->intersect_segment(local_from, local_to, shape_point, shape_normal, shape_face_index, p_parameters.hit_back_faces)) {
+				shape_point = shape.transform.xform(shape_point);
+
+				real_t ld = normal.dot(shape_point);
+
+				if (ld < min_d) {
+					min_d = ld;
+					res_point = shape_point;
+					res_normal = inv_xform.basis.xform_inv(shape_normal).normalized();
+					res_face_index = shape_face_index;
+					res_shape = shape.index;
+					res_obj = &object;
+					collided = true;
+				}
+			}
+		}
+	}
+
+	if (!collided) {
+		return false;
+	}
+	ERR_FAIL_NULL_V(res_obj, false); // Shouldn't happen but silences warning.
+
+	r_result.collider_id = res_obj->instance_id;
+	if (r_result.collider_id.is_valid()) {
+		r_result.collider = ObjectDB::get_instance(r_result.collider_id);
+	} else {
+		r_result.collider = nullptr;
+	}
+	r_result.normal = res_normal;
+	r_result.face_index = res_face_index;
+	r_result.position = res_point;
+	r_result.rid = res_obj->self;
+	r_result.shape = res_shape;
+
+	return true;
+}
+
+int GodotPublishedDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
+
+	RWLockRead read_lock(published->lock);
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, 0);
+
+	const GodotPublishedState3D::Buffer *buffer = nullptr;
+	DynamicBVH *bvh = nullptr;
+	if (!published->_get_space(space, buffer, bvh)) {
+		return 0;
+	}
+
+	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+
+	uint32_t objects[GodotPublishedState3D::INTERSECTION_QUERY_MAX];
+	_PublishedCullResult cull;
+	cull.objects = objects;
+	bvh->aabb_query(aabb, cull);
+
+	int cc = 0;
+
+	for (int i = 0; i < cull.count && cc < p_result_max; i++) {
+		const PublishedObject &object = buffer->objects[objects[i]];
+		if (!_can_query(object, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude)) {
+			continue;
+		}
+
+		for (uint32_t j = 0; j < object.shape_count && cc < p_result_max; j++) {
+			const PublishedShape &col_shape = buffer->shapes[object.shape_from + j];
+			if (!col_shape.shape || !col_shape.aabb.intersects_inclusive(aabb)) {
+				continue;
+			}
+
+			if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_shape.shape, col_shape.transform, nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+				continue;
+			}
+
+			if (r_results) {
+				r_results[cc].collider_id = object.instance_id;
+				if (r_results[cc].collider_id.is_valid()) {
+					r_results[cc].collider = ObjectDB::get_instance(r_results[cc].collider_id);
+				} else {
+					r_results[cc].collider = nullptr;
+				}
+				r_results[cc].rid = object.self;
+				r_results[cc].shape = col_shape.index;
+			}
+
+			cc++;
+		}
+	}
+
+	return cc;
+}
+
+bool GodotPublishedDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
+	RWLockRead read_lock(published->lock);
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	p_closest_safe = 1;
+	p_closest_unsafe = 1;
+
+	const GodotPublishedState3D::Buffer *buffer = nullptr;
+	DynamicBVH *bvh = nullptr;
+	if (!published->_get_space(space, buffer, bvh)) {
+		return true;
+	}
+
+	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+	aabb = aabb.merge(AABB(aabb.position + p_parameters.motion, aabb.size)); //motion
+	aabb = aabb.grow(p_parameters.margin);
+
+	uint32_t objects[GodotPublishedState3D::INTERSECTION_QUERY_MAX];
+	_PublishedCullResult cull;
+	cull.objects = objects;
+	bvh->aabb_query(aabb, cull);
+
+	real_t best_safe = 1;
+	real_t best_unsafe = 1;
+
+	Transform3D xform_inv = p_parameters.transform.affine_inverse();
+	GodotMotionShape3D mshape;
+	mshape.shape = shape;
+	mshape.motion = xform_inv.basis.xform(p_parameters.motion);
+
+	bool best_first = true;
+
+	Vector3 motion_normal = p_parameters.motion.normalized();
+
+	Vector3 closest_A, closest_B;
+
+	for (int i = 0; i < cull.count; i++) {
+		const PublishedObject &object = buffer->objects[objects[i]];
+		if (!_can_query(object, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude)) {
+			continue;
+		}
+
+		for (uint32_t j = 0; j < object.shape_count; j++) {
+			const PublishedShape &col_shape = buffer->shapes[object.shape_from + j];
+			if (!col_shape.shape || !col_shape.aabb.intersects_inclusive(aabb)) {
+				continue;
+			}
+
+			Vector3 point_A, point_B;
+			Vector3 sep_axis = motion_normal;
+
+			mshape.motion = xform_inv.basis.xform(p_parameters.motion);
+			//test initial overlap, does it collide if going all the way?
+			if (GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_shape.shape, col_shape.transform, point_A, point_B, aabb, &sep_axis)) {
+				continue;
+			}
+
+			//test initial overlap, ignore objects it's inside of.
+			sep_axis = motion_normal;
+
+			if (!GodotCollisionSolver3D::solve_distance(shape, p_parameters.transform, col_shape.shape, col_shape.transform, point_A, point_B, aabb, &sep_axis)) {
+				continue;
+			}
+
+			//just do kinematic solving
+			real_t low = 0.0;
+			real_t hi = 1.0;
+			real_t fraction_coeff = 0.5;
+			for (int k = 0; k < 8; k++) {
+				real_t fraction = low + (hi - low) * fraction_coeff;
+
+				mshape.motion = xform_inv.basis.xform(p_parameters.motion * fraction);
+
+				Vector3 lA, lB;
+				Vector3 sep = motion_normal;
+				bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_shape.shape, col_shape.transform, lA, lB, aabb, &sep);
+
+				if (collided) {
+					hi = fraction;
+					// Converge faster towards low fraction when colliding again.
+					fraction_coeff = ((k == 0) || (low > 0.0)) ? 0.5 : 0.25;
+				} else {
+					point_A = lA;
+					point_B = lB;
+					low = fraction;
+					// Converge faster towards high fraction when not colliding again.
+					fraction_coeff = ((k == 0) || (hi < 1.0)) ? 0.5 : 0.75;
+				}
+			}
+
+			if (low < best_safe) {
+				best_first = true; //force reset
+				best_safe = low;
+				best_unsafe = hi;
+			}
+
+			if (r_info && (best_first || (point_A.distance_squared_to(point_B) < closest_A.distance_squared_to(closest_B) && low <= best_safe))) {
+				closest_A = point_A;
+				closest_B = point_B;
+				r_info->collider_id = object.instance_id;
+				r_info->rid = object.self;
+				r_info->shape = col_shape.index;
+				r_info->point = closest_B;
+				r_info->normal = (closest_A - closest_B).normalized();
+				r_info->linear_velocity = _get_velocity_at(object, closest_B);
+				best_first = false;
+			}
+		}
+	}
+
+	p_closest_safe = best_safe;
+	p_closest_unsafe = best_unsafe;
+
+	return true;
+}
+
+bool GodotPublishedDirectSpaceState3D::collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) {
+	r_result_count = 0;
+	if (p_result_max <= 0) {
+		return false;
+	}
+
+	RWLockRead read_lock(published->lock);
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	const GodotPublishedState3D::Buffer *buffer = nullptr;
+	DynamicBVH *bvh = nullptr;
+	if (!published->_get_space(space, buffer, bvh)) {
+		return false;
+	}
+
+	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+	aabb = aabb.grow(p_parameters.margin);
+
+	uint32_t objects[GodotPublishedState3D::INTERSECTION_QUERY_MAX];
+	_PublishedCullResult cull;
+	cull.objects = objects;
+	bvh->aabb_query(aabb, cull);
+
+	bool collided = false;
+
+	GodotPhysicsServer3D::CollCbkData cbk;
+	cbk.max = p_result_max;
+	cbk.amount = 0;
+	cbk.ptr = r_results;
+
+	for (int i = 0; i < cull.count; i++) {
+		const PublishedObject &object = buffer->objects[objects[i]];
+		if (!_can_query(object, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude)) {
+			continue;
+		}
+
+		for (uint32_t j = 0; j < object.shape_count; j++) {
+			const PublishedShape &col_shape = buffer->shapes[object.shape_from + j];
+			if (!col_shape.shape || !col_shape.aabb.intersects_inclusive(aabb)) {
+				continue;
+			}
+
+			if (GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_shape.shape, col_shape.transform, GodotPhysicsServer3D::_shape_col_cbk, &cbk, nullptr, p_parameters.margin)) {
+				collided = true;
+			}
+		}
+	}
+
+	r_result_count = cbk.amount;
+
+	return collided;
+}
+
+struct _PublishedRestData {
+	const PublishedObject *object = nullptr;
+	int shape = 0;
+	real_t min_allowed_depth = 0.0;
+
+	const PublishedObject *best_object = nullptr;
+	int best_shape = 0;
+	Vector3 best_contact;
+	Vector3 best_normal;
+	real_t best_len = 0.0;
+};
+
+static void _published_rest_cbk_result(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
+	_PublishedRestData *rd = static_cast<_PublishedRestData *>(p_userdata);
+
+	real_t len = (p_point_B - p_point_A).length();
+	if (len < rd->min_allowed_depth || len <= rd->best_len) {
+		return;
+	}
+
+	rd->best_len = len;
+	rd->best_contact = p_point_B;
+	rd->best_normal = normal;
+	rd->best_object = rd->object;
+	rd->best_shape = rd->shape;
+}
+
+bool GodotPublishedDirectSpaceState3D::rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) {
+	RWLockRead read_lock(published->lock);
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	const GodotPublishedState3D::Buffer *buffer = nullptr;
+	DynamicBVH *bvh = nullptr;
+	if (!published->_get_space(space, buffer, bvh)) {
+		return false;
+	}
+
+	real_t margin = MAX(p_parameters.margin, TEST_MOTION_MARGIN_MIN_VALUE);
+
+	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+	aabb = aabb.grow(margin);
+
+	uint32_t objects[GodotPublishedState3D::INTERSECTION_QUERY_MAX];
+	_PublishedCullResult cull;
+	cull.objects = objects;
+	bvh->aabb_query(aabb, cull);
+
+	_PublishedRestData rcd;
+
+	// Allowed depth can't be lower than motion length, in order to handle contacts at low speed.
+	real_t motion_length = p_parameters.motion.length();
+	real_t min_contact_depth = margin * TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR;
+	rcd.min_allowed_depth = MIN(motion_length, min_contact_depth);
+
+	for (int i = 0; i < cull.count; i++) {
+		const PublishedObject &object = buffer->objects[objects[i]];
+		if (!_can_query(object, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude)) {
+			continue;
+		}
+
+		for (uint32_t j = 0; j < object.shape_count; j++) {
+			const PublishedShape &col_shape = buffer->shapes[object.shape_from + j];
+			if (!col_shape.shape || !col_shape.aabb.intersects_inclusive(aabb)) {
+				continue;
+			}
+
+			rcd.object = &object;
+			rcd.shape = col_shape.index;
+			GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_shape.shape, col_shape.transform, _published_rest_cbk_result, &rcd, nullptr, margin);
+		}
+	}
+
+	if (rcd.best_len == 0 || !rcd.best_object) {
+		return false;
+	}
+
+	r_info->collider_id = rcd.best_object->instance_id;
+	r_info->shape = rcd.best_shape;
+	r_info->normal = rcd.best_normal;
+	r_info->point = rcd.best_contact;
+	r_info->rid = rcd.best_object->self;
+	r_info->linear_velocity = _get_velocity_at(*rcd.best_object, rcd.best_contact);
+
+	return true;
+}
+
+Vector3 GodotPublishedDirectSpaceState3D::get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const {
+	RWLockRead read_lock(published->lock);
+
+	const PublishedObject *object = published->_get_object(p_object);
+	ERR_FAIL_NULL_V_MSG(object, Vector3(), "Object is not in a space that publishes its state.");
+
+	GodotPublishedState3D::SpaceData *const *space_data = published->spaces.getptr(space);
+	ERR_FAIL_COND_V(!space_data || object->space != *space_data, Vector3());
+
+	const GodotPublishedState3D::Buffer &buffer = published->buffers[published->front];
+
+	real_t min_distance = 1e20;
+	Vector3 min_point;
+
+	bool shapes_found = false;
+
+	for (uint32_t i = 0; i < object->shape_count; i++) {
+		const PublishedShape &shape = buffer.shapes[object->shape_from + i];
+		if (!shape.shape) {
+			continue;
+		}
+
+		Vector3 point = shape.shape->get_closest_point_to(shape.transform.affine_inverse().xform(p_point));
+		point = shape.transform.xform(point);
+
+		real_t dist = point.distance_to(p_point);
+		if (dist < min_distance) {
+			min_distance = dist;
+			min_point = point;
+		}
+		shapes_found = true;
+	}
+
+	if (!shapes_found) {
+		return object->transform.origin; //no shapes found, use distance to origin.
+	} else {
+		return min_point;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const GodotPublishedState3D::Object *GodotPublishedState3D::_get_object(const RID &p_self) const {
+	const uint32_t *slot = slot_map.getptr(p_self);
+	if (!slot) {
+		return nullptr;
+	}
+	return &buffers[front].objects[*slot];
+}
+
+bool GodotPublishedState3D::_get_space(const RID &p_space, const Buffer *&r_buffer, DynamicBVH *&r_bvh) {
+	SpaceData **space_data = spaces.getptr(p_space);
+	if (!space_data) {
+		return false;
+	}
+	r_buffer = &buffers[front];
+	r_bvh = &(*space_data)->bvh[front];
+	return true;
+}
+
+uint32_t GodotPublishedState3D::_get_slot(GodotCollisionObject3D *p_object, SpaceData *p_space) {
+	uint32_t index = p_object->get_published_slot();
+	if (index >= slots.size() || slots[index].self != p_object->get_self()) {
+		if (free_slots.size()) {
+			index = free_slots[free_slots.size() - 1];
+			free_slots.resize(free_slots.size() - 1);
+		} else {
+			index = slots.size();
+			slots.push_back(Slot());
+		}
+		slots[index].self = p_object->get_self();
+		p_object->set_published_slot(index);
+		added_slots.push_back(index);
+	}
+
+	Slot &slot = slots[index];
+	slot.space = p_space;
+	slot.pass = pass;
+	return index;
+}
+
+void GodotPublishedState3D::_write_object(uint32_t p_buffer, uint32_t p_slot, const GodotCollisionObject3D *p_object, SpaceData *p_space) {
+	Buffer &buffer = buffers[p_buffer];
+	if (buffer.objects.size() <= p_slot) {
+		buffer.objects.resize(p_slot + 1);
+	}
+
+	Object &object = buffer.objects[p_slot];
+	object.self = p_object->get_self();
+	object.instance_id = p_object->get_instance_id();
+	object.type = p_object->get_type();
+	object.collision_layer = p_object->get_collision_layer();
+	object.ray_pickable = p_object->is_ray_pickable();
+	object.transform = p_object->get_transform();
+
+	object.overlap_from = buffer.overlaps.size();
+	if (object.type == GodotCollisionObject3D::TYPE_BODY) {
+		const GodotBody3D *body = static_cast<const GodotBody3D *>(p_object);
+		object.linear_velocity = body->get_linear_velocity();
+		object.angular_velocity = body->get_angular_velocity();
+		object.center_of_mass = body->get_center_of_mass();
+		object.sleeping = !body->is_active();
+		object.can_sleep = body->is_able_to_sleep();
+	} else {
+		const GodotArea3D *area = static_cast<const GodotArea3D *>(p_object);
+		for (const GodotConstraint3D *E : area->get_constraints()) {
+			const GodotCollisionObject3D *other = E->get_area_overlap(area);
+			if (other) {
+				buffer.overlaps.push_back(other->get_self());
+			}
+		}
+
+		// An object overlapping with several shapes has a pair for each of them.
+		RID *overlaps = buffer.overlaps.ptr() + object.overlap_from;
+		uint32_t count = buffer.overlaps.size() - object.overlap_from;
+		SortArray<RID> sorter;
+		sorter.sort(overlaps, count);
+		uint32_t unique_count = 0;
+		for (uint32_t i = 0; i < count; i++) {
+			if (unique_count == 0 || overlaps[unique_count - 1] != overlaps[i]) {
+				overlaps[unique_count++] = overlaps[i];
+			}
+		}
+		buffer.overlaps.resize(object.overlap_from + unique_count);
+	}
+	object.overlap_count = buffer.overlaps.size() - object.overlap_from;
+
+	AABB aabb;
+	object.shape_from = buffer.shapes.size();
+	for (int i = 0; i < p_object->get_shape_count(); i++) {
+		if (p_object->is_shape_disabled(i)) {
+			continue;
+		}
+
+		Shape shape;
+		shape.shape = p_object->get_shape(i);
+		shape.transform = p_object->get_transform() * p_object->get_shape_transform(i);
+		shape.aabb = p_object->get_shape_aabb(i);
+		shape.index = i;
+		aabb = buffer.shapes.size() == object.shape_from ? shape.aabb : aabb.merge(shape.aabb);
+		buffer.shapes.push_back(shape);
+	}
+	object.shape_count = buffer.shapes.size() - object.shape_from;
+
+	// Keep the object's leaf in the broadphase of its space for this buffer.
+	if (object.space != p_space || object.shape_count == 0) {
+		if (object.leaf.is_valid()) {
+			object.space->bvh[p_buffer].remove(object.leaf);
+			object.leaf = DynamicBVH::ID();
+		}
+		object.space = p_space;
+	}
+	if (object.shape_count > 0) {
+		if (object.leaf.is_valid()) {
+			p_space->bvh[p_buffer].update(object.leaf, aabb);
+		} else {
+			object.leaf = p_space->bvh[p_buffer].insert(aabb, (void *)(uintptr_t)p_slot);
+		}
+	}
+}
+
+void GodotPublishedState3D::_clear_object(uint32_t p_buffer, uint32_t p_slot) {
+	Buffer &buffer = buffers[p_buffer];
+	if (p_slot >= buffer.objects.size()) {
+		return;
+	}
+
+	Object &object = buffer.objects[p_slot];
+	if (object.leaf.is_valid()) {
+		object.space->bvh[p_buffer].remove(object.leaf);
+		object.leaf = DynamicBVH::ID();
+	}
+	object.space = nullptr;
+	object.self = RID();
+}
+
+void GodotPublishedState3D::_remove_space_data(SpaceData *p_space) {
+	for (uint32_t i = 0; i < slots.size(); i++) {
+		Slot &slot = slots[i];
+		if (slot.space != p_space) {
+			continue;
+		}
+		slot_map.erase(slot.self);
+		slot = Slot();
+		free_slots.push_back(i);
+	}
+
+	// The leaves go away with the space's broadphase, but objects that moved to another
+	// space may still point to it in one of the buffers.
+	for (uint32_t i = 0; i < 2; i++) {
+		for (Object &object : buffers[i].objects) {
+			if (object.space == p_space) {
+				object.space = nullptr;
+				object.leaf = DynamicBVH::ID();
+			}
+		}
+	}
+
+	memdelete(p_space);
+}
+
+void GodotPublishedState3D::set_space_publishing(GodotSpace3D *p_space, bool p_enable) {
+	RWLockWrite write_lock(lock);
+
+	SpaceData **space_data = spaces.getptr(p_space->get_self());
+	if (p_enable == (space_data != nullptr)) {
+		return;
+	}
+
+	if (p_enable) {
+		SpaceData *new_space_data = memnew(SpaceData);
+		new_space_data->space = p_space;
+		spaces.insert(p_space->get_self(), new_space_data);
+	} else {
+		_remove_space_data(*space_data);
+		spaces.erase(p_space->get_self());
+	}
+}
+
+bool GodotPublishedState3D::is_space_publishing(const GodotSpace3D *p_space) const {
+	RWLockRead read_lock(lock);
+	return spaces.has(p_space->get_self());
+}
+
+void GodotPublishedState3D::remove_space(const RID &p_space) {
+	RWLockWrite write_lock(lock);
+
+	SpaceData **space_data = spaces.getptr(p_space);
+	if (space_data) {
+		_remove_space_data(*space_data);
+		spaces.erase(p_space);
+	}
+
+	GodotPublishedDirectSpaceState3D **direct_state = direct_states.getptr(p_space);
+	if (direct_state) {
+		memdelete(*direct_state);
+		direct_states.erase(p_space);
+	}
+}
+
+void GodotPublishedState3D::remove_shape(const GodotShape3D *p_shape) {
+	for (uint32_t i = 0; i < 2; i++) {
+		for (Shape &shape : buffers[i].shapes) {
+			if (shape.shape == p_shape) {
+				shape.shape = nullptr;
+			}
+		}
+	}
+}
+
+void GodotPublishedState3D::publish() {
+	if (spaces.is_empty()) {
+		return;
+	}
+
+	pass++;
+
+	uint32_t back = 1 - front;
+	buffers[back].shapes.clear();
+	buffers[back].overlaps.clear();
+
+	for (const KeyValue<RID, SpaceData *> &E : spaces) {
+		for (GodotCollisionObject3D *object : E.value->space->get_objects()) {
+			if (object->get_type() == GodotCollisionObject3D::TYPE_SOFT_BODY) {
+				continue;
+			}
+			_write_object(back, _get_slot(object, E.value), object, E.value);
+		}
+	}
+
+	// Release the slots of objects that were freed or left their space.
+	for (uint32_t i = 0; i < slots.size(); i++) {
+		Slot &slot = slots[i];
+		if (slot.self.is_valid() && slot.pass != pass) {
+			removed_slots.push_back(slot.self);
+			slot = Slot();
+			free_slots.push_back(i);
+		}
+		if (!slot.self.is_valid()) {
+			_clear_object(back, i);
+		}
+	}
+
+	RWLockWrite write_lock(lock);
+
+	for (const RID &self : removed_slots) {
+		slot_map.erase(self);
+	}
+	for (uint32_t index : added_slots) {
+		slot_map.insert(slots[index].self, index);
+	}
+	removed_slots.clear();
+	added_slots.clear();
+
+	front = back;
+}
+
+Variant GodotPublishedState3D::get_body_state(const RID &p_body, PhysicsServer3D::BodyState p_state) const {
+	RWLockRead read_lock(lock);
+
+	const Object *object = _get_object(p_body);
+	ERR_FAIL_COND_V_MSG(!object || object->type != GodotCollisionObject3D::TYPE_BODY, Variant(), "Body is not in a space that publishes its state.");
+
+	switch (p_state) {
+		case PhysicsServer3D::BODY_STATE_TRANSFORM: {
+			return object->transform;
+		} break;
+		case PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY: {
+			return object->linear_velocity;
+		} break;
+		case PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY: {
+			return object->angular_velocity;
+		} break;
+		case PhysicsServer3D::BODY_STATE_SLEEPING: {
+			return object->sleeping;
+		} break;
+		case PhysicsServer3D::BODY_STATE_CAN_SLEEP: {
+			return object->can_sleep;
+		} break;
+	}
+
+	return Variant();
+}
+
+TypedArray<RID> GodotPublishedState3D::get_area_overlaps(const RID &p_area) const {
+	RWLockRead read_lock(lock);
+
+	const Object *object = _get_object(p_area);
+	ERR_FAIL_COND_V_MSG(!object || object->type != GodotCollisionObject3D::TYPE_AREA, TypedArray<RID>(), "Area is not in a space that publishes its state.");
+
+	TypedArray<RID> overlaps;
+	overlaps.resize(object->overlap_count);
+	const RID *ptr = buffers[front].overlaps.ptr() + object->overlap_from;
+	for (uint32_t i = 0; i < object->overlap_count; i++) {
+		overlaps[i] = ptr[i];
+	}
+	return overlaps;
+}
+
+PhysicsDirectSpaceState3D *GodotPublishedState3D::get_direct_state(const RID &p_space) {
+	RWLockWrite write_lock(lock);
+
+	GodotPublishedDirectSpaceState3D **direct_state = direct_states.getptr(p_space);
+	if (direct_state) {
+		return *direct_state;
+	}
+
+	GodotPublishedDirectSpaceState3D *new_direct_state = memnew(GodotPublishedDirectSpaceState3D);
+	new_direct_state->published = this;
+	new_direct_state->space = p_space;
+	direct_states.insert(p_space, new_direct_state);
+	return new_direct_state;
+}
+
+GodotPublishedState3D::~GodotPublishedState3D() {
+	for (const KeyValue<RID, SpaceData *> &E : spaces) {
+		memdelete(E.value);
+	}
+	for (const KeyValue<RID, GodotPublishedDirectSpaceState3D *> &E : direct_states) {
+		memdelete(E.value);
+	}
+}
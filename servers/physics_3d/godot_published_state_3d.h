@@ -0,0 +1,174 @@
+/**************************************************************************/
+/*  godot_published_state_3d.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_PUBLISHED_STATE_3D_H
+#define GODOT_PUBLISHED_STATE_3D_H
+
+#include "godot_collision_object_3d.h"
+
+#include "core/math/dynamic_bvh.h"
+#include "core/os/rw_lock.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/typed_array.h"
+#include "servers/physics_server_3d.h"
+
+class GodotSpace3D;
+class GodotPublishedState3D;
+
+// Runs space queries against the state a space published in its last step, instead of
+// its live state. Unlike GodotPhysicsDirectSpaceState3D, it can be used from any thread
+// at any time, including while the space is being stepped on the physics thread.
+class GodotPublishedDirectSpaceState3D : public PhysicsDirectSpaceState3D {
+	GDCLASS(GodotPublishedDirectSpaceState3D, PhysicsDirectSpaceState3D);
+
+public:
+	GodotPublishedState3D *published = nullptr;
+	RID space;
+
+	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
+	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
+	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
+	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
+	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
+	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
+};
+
+// Double-buffered copy of the bodies and areas of the spaces that publish their state.
+// The physics thread writes the back buffer at the end of each step and then swaps it
+// with the front one, which is what readers see. Readers hold the read lock only while
+// they read, so they never wait for a step, only for a swap or a shape change.
+class GodotPublishedState3D {
+	friend class GodotPublishedDirectSpaceState3D;
+
+public:
+	enum {
+		INTERSECTION_QUERY_MAX = 2048
+	};
+
+	struct SpaceData {
+		GodotSpace3D *space = nullptr;
+		DynamicBVH bvh[2]; // One per buffer, with a leaf per object.
+	};
+
+	struct Shape {
+		GodotShape3D *shape = nullptr; // Cleared when the shape is freed.
+		Transform3D transform;
+		AABB aabb;
+		int index = 0;
+	};
+
+	struct Object {
+		RID self;
+		ObjectID instance_id;
+		GodotCollisionObject3D::Type type = GodotCollisionObject3D::TYPE_BODY;
+		uint32_t collision_layer = 0;
+		bool ray_pickable = false;
+		bool sleeping = false;
+		bool can_sleep = false;
+
+		Transform3D transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 center_of_mass;
+
+		uint32_t shape_from = 0;
+		uint32_t shape_count = 0;
+		uint32_t overlap_from = 0;
+		uint32_t overlap_count = 0;
+
+		// Space the object was last written for in this buffer, and its leaf there.
+		SpaceData *space = nullptr;
+		DynamicBVH::ID leaf;
+	};
+
+	struct Buffer {
+		LocalVector<Object> objects; // Indexed by slot.
+		LocalVector<Shape> shapes;
+		LocalVector<RID> overlaps;
+	};
+
+private:
+	struct Slot {
+		RID self;
+		SpaceData *space = nullptr;
+		uint64_t pass = 0;
+	};
+
+	mutable RWLock lock;
+
+	Buffer buffers[2];
+	uint32_t front = 0;
+	uint64_t pass = 0;
+
+	// Slots are only handed out by the physics thread. The map readers use to find them
+	// is only changed while the lock is held for writing.
+	LocalVector<Slot> slots;
+	LocalVector<uint32_t> free_slots;
+	HashMap<RID, uint32_t> slot_map;
+	LocalVector<uint32_t> added_slots;
+	LocalVector<RID> removed_slots;
+
+	HashMap<RID, SpaceData *> spaces;
+	HashMap<RID, GodotPublishedDirectSpaceState3D *> direct_states;
+
+	uint32_t _get_slot(GodotCollisionObject3D *p_object, SpaceData *p_space);
+	void _write_object(uint32_t p_buffer, uint32_t p_slot, const GodotCollisionObject3D *p_object, SpaceData *p_space);
+	void _clear_object(uint32_t p_buffer, uint32_t p_slot);
+	void _remove_space_data(SpaceData *p_space);
+
+	// Only for readers holding the read lock.
+	const Object *_get_object(const RID &p_self) const;
+	bool _get_space(const RID &p_space, const Buffer *&r_buffer, DynamicBVH *&r_bvh);
+
+public:
+	// Locked for writing around anything that changes or frees the shapes of published
+	// objects, which published queries use directly.
+	_FORCE_INLINE_ RWLock &get_lock() { return lock; }
+
+	void set_space_publishing(GodotSpace3D *p_space, bool p_enable);
+	bool is_space_publishing(const GodotSpace3D *p_space) const;
+	void remove_space(const RID &p_space);
+	// The lock must be held for writing.
+	void remove_shape(const GodotShape3D *p_shape);
+
+	// Called by the physics thread at the end of each step.
+	void publish();
+
+	// Thread-safe, these can be called at any time.
+	Variant get_body_state(const RID &p_body, PhysicsServer3D::BodyState p_state) const;
+	TypedArray<RID> get_area_overlaps(const RID &p_area) const;
+	PhysicsDirectSpaceState3D *get_direct_state(const RID &p_space);
+
+	~GodotPublishedState3D();
+};
+
+#endif // GODOT_PUBLISHED_STATE_3D_H
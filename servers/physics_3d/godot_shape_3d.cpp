@@ -29,6 +29,7 @@
 /**************************************************************************/
 
 #include "godot_shape_3d.h"
+#include "godot_collision_kernels_3d.h"
 
 #include "core/io/image.h"
 #include "core/math/convex_hull.h"
@@ -837,16 +838,7 @@ void GodotConvexPolygonShape3D::project_range(const Vector3 &p_normal, const Tra
 		r_min = p_normal.dot(p_transform.xform(get_support(-n)));
 		r_max = p_normal.dot(p_transform.xform(get_support(n)));
 	} else {
-		for (uint32_t i = 0; i < vertex_count; i++) {
-			real_t d = p_normal.dot(p_transform.xform(vrts[i]));
-
-			if (i == 0 || d > r_max) {
-				r_max = d;
-			}
-			if (i == 0 || d < r_min) {
-				r_min = d;
-			}
-		}
+		GodotCollisionKernels3D::project_points(p_normal, p_transform, vrts, vertex_count, r_min, r_max);
 	}
 }
 
@@ -859,19 +851,11 @@ Vector3 GodotConvexPolygonShape3D::get_support(const Vector3 &p_normal) const {
 	// Get the array of vertices
 	const Vector3 *const vertices_array = mesh.vertices.ptr();
 
-	// Start with an initial assumption of the first extreme vertex.
-	int best_vertex = extreme_vertices[0];
+	// Start with the best of the extreme vertices, which are stored contiguously so they can be
+	// checked several at once.
+	int best_vertex = extreme_vertices[GodotCollisionKernels3D::find_support(p_normal, extreme_vertex_points.ptr(), extreme_vertex_points.size())];
 	real_t max_support = p_normal.dot(vertices_array[best_vertex]);
 
-	// Check the remaining extreme vertices for a better vertex.
-	for (const int &vert : extreme_vertices) {
-		real_t s = p_normal.dot(vertices_array[vert]);
-		if (s > max_support) {
-			best_vertex = vert;
-			max_support = s;
-		}
-	}
-
 	// If we checked all vertices in the mesh then we're done.
 	if (extreme_vertices.size() == mesh.vertices.size()) {
 		return vertices_array[best_vertex];
@@ -1100,6 +1084,7 @@ void GodotConvexPolygonShape3D::_setup(const Vector<Vector3> &p_vertices) {
 		ERR_PRINT("Failed to build convex hull");
 	}
 	extreme_vertices.resize(0);
+	extreme_vertex_points.resize(0);
 	vertex_neighbors.resize(0);
 
 	AABB _aabb;
@@ -1124,15 +1109,7 @@ void GodotConvexPolygonShape3D::_setup(const Vector<Vector3> &p_vertices) {
 				if (x != 0 || y != 0 || z != 0) {
 					Vector3 dir(x, y, z);
 					dir.normalize();
-					real_t max_support = 0.0;
-					int best_vertex = -1;
-					for (uint32_t i = 0; i < mesh.vertices.size(); i++) {
-						real_t s = dir.dot(mesh.vertices[i]);
-						if (best_vertex == -1 || s > max_support) {
-							best_vertex = i;
-							max_support = s;
-						}
-					}
+					int best_vertex = GodotCollisionKernels3D::find_support(dir, mesh.vertices.ptr(), mesh.vertices.size());
 					if (extreme_vertices.find(best_vertex) == -1)
 						extreme_vertices.push_back(best_vertex);
 				}
@@ -1140,6 +1117,13 @@ void GodotConvexPolygonShape3D::_setup(const Vector<Vector3> &p_vertices) {
 		}
 	}
 
+	if (!mesh.vertices.is_empty()) {
+		extreme_vertex_points.resize(extreme_vertices.size());
+		for (uint32_t i = 0; i < extreme_vertices.size(); i++) {
+			extreme_vertex_points[i] = mesh.vertices[extreme_vertices[i]];
+		}
+	}
+
 	// Record all the neighbors of each vertex.  This is used in get_support().
 
 	if (extreme_vertices.size() < mesh.vertices.size()) {
@@ -1285,39 +1269,88 @@ GodotFaceShape3D::GodotFaceShape3D() {
 }
 
 Vector<Vector3> GodotConcavePolygonShape3D::get_faces() const {
-	Vector<Vector3> rfaces;
-	rfaces.resize(faces.size() * 3);
+	// Vertices are stored three per face, in the original order.
+	return vertices;
+}
 
-	for (int i = 0; i < faces.size(); i++) {
-		Face f = faces.get(i);
+_FORCE_INLINE_ uint16_t GodotConcavePolygonShape3D::_quantize_min(real_t p_value, int p_axis) const {
+	real_t q = Math::floor((p_value - bvh_origin[p_axis]) * bvh_scale[p_axis]);
+	uint32_t result = (uint32_t)CLAMP(q, (real_t)0, (real_t)BVH_QUANTIZED_MAX);
+	// Make sure rounding errors don't leave the value outside of the dequantized bounds.
+	while (result > 0 && bvh_origin[p_axis] + result * bvh_inv_scale[p_axis] > p_value) {
+		result--;
+	}
+	return result;
+}
 
-		for (int j = 0; j < 3; j++) {
-			rfaces.set(i * 3 + j, vertices.get(f.indices[j]));
-		}
+_FORCE_INLINE_ uint16_t GodotConcavePolygonShape3D::_quantize_max(real_t p_value, int p_axis) const {
+	real_t q = Math::ceil((p_value - bvh_origin[p_axis]) * bvh_scale[p_axis]);
+	uint32_t result = (uint32_t)CLAMP(q, (real_t)0, (real_t)BVH_QUANTIZED_MAX);
+	while (result < BVH_QUANTIZED_MAX && bvh_origin[p_axis] + result * bvh_inv_scale[p_axis] < p_value) {
+		result++;
 	}
+	return result;
+}
 
-	return rfaces;
+_FORCE_INLINE_ AABB GodotConcavePolygonShape3D::_get_node_aabb(const BVH &p_node) const {
+	const Vector3 min = bvh_origin + Vector3(p_node.min[0], p_node.min[1], p_node.min[2]) * bvh_inv_scale;
+	const Vector3 max = bvh_origin + Vector3(p_node.max[0], p_node.max[1], p_node.max[2]) * bvh_inv_scale;
+	return AABB(min, max - min);
+}
+
+_FORCE_INLINE_ void GodotConcavePolygonShape3D::_set_face(GodotFaceShape3D *r_face, const Face &p_face) const {
+	const Vector3 *vr = vertices.ptr();
+	r_face->normal = p_face.normal;
+	r_face->vertex[0] = vr[p_face.indices[0]];
+	r_face->vertex[1] = vr[p_face.indices[1]];
+	r_face->vertex[2] = vr[p_face.indices[2]];
 }
 
 void GodotConcavePolygonShape3D::project_range(const Vector3 &p_normal, const Transform3D &p_transform, real_t &r_min, real_t &r_max) const {
-	int count = vertices.size();
-	if (count == 0) {
+	if (bvh_node_count == 0) {
 		r_min = 0;
 		r_max = 0;
 		return;
 	}
-	const Vector3 *vptr = vertices.ptr();
 
-	for (int i = 0; i < count; i++) {
-		real_t d = p_normal.dot(p_transform.xform(vptr[i]));
+	// Project in shape space, and skip the subtrees whose bounds project inside of the range found so far.
+	const Vector3 local_normal = p_transform.basis.xform_inv(p_normal);
+	const Vector3 abs_normal = local_normal.abs();
+	const real_t offset = p_normal.dot(p_transform.origin);
 
-		if (i == 0 || d > r_max) {
-			r_max = d;
-		}
-		if (i == 0 || d < r_min) {
-			r_min = d;
+	const Vector3 *vr = vertices.ptr();
+	const Face *fr = faces.ptr();
+
+	r_min = r_max = local_normal.dot(vr[0]);
+
+	uint32_t i = 0;
+	while (i < bvh_node_count) {
+		const BVH &node = bvh[i];
+		const AABB node_aabb = _get_node_aabb(node);
+		const real_t center = local_normal.dot(node_aabb.get_center());
+		const real_t radius = abs_normal.dot(node_aabb.size * 0.5);
+		const bool inside = center - radius >= r_min && center + radius <= r_max;
+
+		if (node.data & BVH_LEAF) {
+			if (!inside) {
+				const uint32_t from = node.data & BVH_LEAF_FACE_MASK;
+				const uint32_t to = from + ((node.data & ~BVH_LEAF) >> BVH_LEAF_COUNT_SHIFT) + 1;
+				for (uint32_t j = from; j < to; j++) {
+					for (int k = 0; k < 3; k++) {
+						const real_t d = local_normal.dot(vr[fr[j].indices[k]]);
+						r_min = MIN(r_min, d);
+						r_max = MAX(r_max, d);
+					}
+				}
+			}
+			i++;
+		} else {
+			i = inside ? node.data : i + 1;
 		}
 	}
+
+	r_min += offset;
+	r_max += offset;
 }
 
 Vector3 GodotConcavePolygonShape3D::get_support(const Vector3 &p_normal) const {
@@ -1345,151 +1378,155 @@ Vector3 GodotConcavePolygonShape3D::get_support(const Vector3 &p_normal) const {
 	return vptr[vert_support_idx];
 }
 
-void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
-
-	if (!params_bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
-		return;
-	}
-
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-
-		Vector3 res;
-		Vector3 normal;
-		int face_index = params_bvh->face_index;
-		if (face->intersect_segment(p_params->from, p_params->to, res, normal, face_index, true)) {
-			real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
-			if ((d > 0) && (d < p_params->min_d)) {
-				p_params->min_d = d;
-				p_params->result = res;
-				p_params->normal = normal;
-				p_params->face_index = face_index;
-				p_params->collisions++;
-			}
-		}
-	} else {
-		if (params_bvh->left >= 0) {
-			_cull_segment(params_bvh->left, p_params);
-		}
-		if (params_bvh->right >= 0) {
-			_cull_segment(params_bvh->right, p_params);
-		}
-	}
-}
-
 bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_result, Vector3 &r_normal, int &r_face_index, bool p_hit_back_faces) const {
-	if (faces.size() == 0) {
+	if (bvh_node_count == 0) {
 		return false;
 	}
 
-	// unlock data
 	const Face *fr = faces.ptr();
-	const Vector3 *vr = vertices.ptr();
-	const BVH *br = bvh.ptr();
 
 	GodotFaceShape3D face;
 	face.backface_collision = backface_collision && p_hit_back_faces;
 
-	_SegmentCullParams params;
-	params.from = p_begin;
-	params.to = p_end;
-	params.dir = (p_end - p_begin).normalized();
-
-	params.faces = fr;
-	params.vertices = vr;
-	params.bvh = br;
-
-	params.face = &face;
-
-	// cull
-	_cull_segment(0, &params);
-
-	if (params.collisions > 0) {
-		r_result = params.result;
-		r_normal = params.normal;
-		r_face_index = params.face_index;
-		return true;
-	} else {
+	const Vector3 rel = p_end - p_begin;
+	const real_t length = rel.length();
+	if (length == 0) {
 		return false;
 	}
-}
+	const Vector3 dir = rel / length;
 
-bool GodotConcavePolygonShape3D::intersect_point(const Vector3 &p_point) const {
-	return false; //face is flat
-}
-
-Vector3 GodotConcavePolygonShape3D::get_closest_point_to(const Vector3 &p_point) const {
-	return Vector3();
-}
-
-bool GodotConcavePolygonShape3D::_cull(int p_idx, _CullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
-
-	if (!p_params->aabb.intersects(params_bvh->aabb)) {
-		return false;
+	// Slab test parameters along the segment, where the segment is [0, max_t]. max_t shrinks
+	// to the closest hit found so far, so long segments stop visiting nodes behind it.
+	Vector3 inv_rel;
+	bool parallel[3];
+	for (int i = 0; i < 3; i++) {
+		parallel[i] = rel[i] == 0;
+		inv_rel[i] = parallel[i] ? 0 : 1.0 / rel[i];
 	}
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-		if (p_params->callback(p_params->userdata, face)) {
-			return true;
-		}
-	} else {
-		if (params_bvh->left >= 0) {
-			if (_cull(params_bvh->left, p_params)) {
-				return true;
+	real_t min_d = 1e20;
+	real_t max_t = 1.0;
+	bool collided = false;
+
+	uint32_t i = 0;
+	while (i < bvh_node_count) {
+		const BVH &node = bvh[i];
+		const AABB node_aabb = _get_node_aabb(node);
+		const Vector3 node_end = node_aabb.position + node_aabb.size;
+
+		real_t t_min = 0;
+		real_t t_max = max_t;
+		for (int j = 0; j < 3 && t_min <= t_max; j++) {
+			if (parallel[j]) {
+				if (p_begin[j] < node_aabb.position[j] || p_begin[j] > node_end[j]) {
+					t_min = 1;
+					t_max = 0;
+				}
+				continue;
 			}
+			real_t t0 = (node_aabb.position[j] - p_begin[j]) * inv_rel[j];
+			real_t t1 = (node_end[j] - p_begin[j]) * inv_rel[j];
+			if (t0 > t1) {
+				SWAP(t0, t1);
+			}
+			t_min = MAX(t_min, t0);
+			t_max = MIN(t_max, t1);
 		}
-
-		if (params_bvh->right >= 0) {
-			if (_cull(params_bvh->right, p_params)) {
-				return true;
+		const bool overlap = t_min <= t_max;
+
+		if (node.data & BVH_LEAF) {
+			if (overlap) {
+				const uint32_t from = node.data & BVH_LEAF_FACE_MASK;
+				const uint32_t to = from + ((node.data & ~BVH_LEAF) >> BVH_LEAF_COUNT_SHIFT) + 1;
+				for (uint32_t j = from; j < to; j++) {
+					_set_face(&face, fr[j]);
+
+					Vector3 res;
+					Vector3 normal;
+					int face_index = fr[j].indices[0] / 3;
+					if (face.intersect_segment(p_begin, p_end, res, normal, face_index, true)) {
+						real_t d = dir.dot(res) - dir.dot(p_begin);
+						if ((d > 0) && (d < min_d)) {
+							min_d = d;
+							// Allow some slack, the hit position comes from a different computation.
+							max_t = MIN((real_t)1.0, d / length + (real_t)CMP_EPSILON);
+							r_result = res;
+							r_normal = normal;
+							r_face_index = face_index;
+							collided = true;
+						}
+					}
+				}
 			}
+			i++;
+		} else {
+			i = overlap ? i + 1 : node.data;
 		}
 	}
 
-	return false;
+	return collided;
+}
+
+bool GodotConcavePolygonShape3D::intersect_point(const Vector3 &p_point) const {
+	return false; //face is flat
+}
+
+Vector3 GodotConcavePolygonShape3D::get_closest_point_to(const Vector3 &p_point) const {
+	return Vector3();
 }
 
 void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callback, void *p_userdata, bool p_invert_backface_collision) const {
 	// make matrix local to concave
-	if (faces.size() == 0) {
+	if (bvh_node_count == 0 || !p_local_aabb.intersects(get_aabb())) {
 		return;
 	}
 
-	AABB local_aabb = p_local_aabb;
-
-	// unlock data
 	const Face *fr = faces.ptr();
 	const Vector3 *vr = vertices.ptr();
-	const BVH *br = bvh.ptr();
 
 	GodotFaceShape3D face; // use this to send in the callback
 	face.backface_collision = backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
-	_CullParams params;
-	params.aabb = local_aabb;
-	params.face = &face;
-	params.faces = fr;
-	params.vertices = vr;
-	params.bvh = br;
-	params.callback = p_callback;
-	params.userdata = p_userdata;
-
-	// cull
-	_cull(0, &params);
+	// Nodes are tested in quantized space, faces against the actual AABB.
+	const Vector3 aabb_end = p_local_aabb.position + p_local_aabb.size;
+	uint16_t min[3];
+	uint16_t max[3];
+	for (int i = 0; i < 3; i++) {
+		min[i] = _quantize_min(p_local_aabb.position[i], i);
+		max[i] = _quantize_max(aabb_end[i], i);
+	}
+
+	uint32_t i = 0;
+	while (i < bvh_node_count) {
+		const BVH &node = bvh[i];
+		const bool overlap = node.min[0] <= max[0] && node.max[0] >= min[0] &&
+				node.min[1] <= max[1] && node.max[1] >= min[1] &&
+				node.min[2] <= max[2] && node.max[2] >= min[2];
+
+		if (node.data & BVH_LEAF) {
+			if (overlap) {
+				const uint32_t from = node.data & BVH_LEAF_FACE_MASK;
+				const uint32_t to = from + ((node.data & ~BVH_LEAF) >> BVH_LEAF_COUNT_SHIFT) + 1;
+				for (uint32_t j = from; j < to; j++) {
+					const Face &f = fr[j];
+					AABB face_aabb(vr[f.indices[0]], Vector3());
+					face_aabb.expand_to(vr[f.indices[1]]);
+					face_aabb.expand_to(vr[f.indices[2]]);
+					if (!p_local_aabb.intersects(face_aabb)) {
+						continue;
+					}
+					_set_face(&face, f);
+					if (p_callback(p_userdata, &face)) {
+						return;
+					}
+				}
+			}
+			i++;
+		} else {
+			i = overlap ? i + 1 : node.data;
+		}
+	}
 }
 
 Vector3 GodotConcavePolygonShape3D::get_moment_of_inertia(real_t p_mass) const {
@@ -1502,114 +1539,146 @@ Vector3 GodotConcavePolygonShape3D::get_moment_of_inertia(real_t p_mass) const {
 			(p_mass / 3.0) * (extents.x * extents.x + extents.y * extents.y));
 }
 
+size_t GodotConcavePolygonShape3D::get_memory_usage() const {
+	return faces.size() * sizeof(Face) + vertices.size() * sizeof(Vector3) + bvh_storage.size() * sizeof(BVH);
+}
+
 struct _Volume_BVH_Element {
 	AABB aabb;
 	Vector3 center;
 	int face_index = 0;
 };
 
-struct _Volume_BVH_CompareX {
-	_FORCE_INLINE_ bool operator()(const _Volume_BVH_Element &a, const _Volume_BVH_Element &b) const {
-		return a.center.x < b.center.x;
-	}
-};
-
-struct _Volume_BVH_CompareY {
-	_FORCE_INLINE_ bool operator()(const _Volume_BVH_Element &a, const _Volume_BVH_Element &b) const {
-		return a.center.y < b.center.y;
-	}
+struct _Volume_BVH_Bin {
+	AABB aabb;
+	uint32_t count = 0;
 };
 
-struct _Volume_BVH_CompareZ {
-	_FORCE_INLINE_ bool operator()(const _Volume_BVH_Element &a, const _Volume_BVH_Element &b) const {
-		return a.center.z < b.center.z;
-	}
-};
+static _FORCE_INLINE_ real_t _volume_bvh_area(const AABB &p_aabb) {
+	// Half the surface area, only used to compare costs.
+	return p_aabb.size.x * p_aabb.size.y + p_aabb.size.y * p_aabb.size.z + p_aabb.size.z * p_aabb.size.x;
+}
 
-struct _Volume_BVH {
-	AABB aabb;
-	_Volume_BVH *left = nullptr;
-	_Volume_BVH *right = nullptr;
+static const int BVH_SAH_BINS = 16;
+// Past this depth, splits are made at the median, so the depth stays bounded with degenerate input.
+static const int BVH_SAH_MAX_DEPTH = 64;
 
-	int face_index = 0;
-};
+uint32_t GodotConcavePolygonShape3D::_build_bvh(_Volume_BVH_Element *p_elements, uint32_t p_from, uint32_t p_count, int p_depth, LocalVector<BVH> &r_nodes) const {
+	_Volume_BVH_Element *elements = p_elements + p_from;
 
-_Volume_BVH *_volume_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int &count) {
-	_Volume_BVH *bvh = memnew(_Volume_BVH);
-
-	if (p_size == 1) {
-		//leaf
-		bvh->aabb = p_elements[0].aabb;
-		bvh->left = nullptr;
-		bvh->right = nullptr;
-		bvh->face_index = p_elements->face_index;
-		count++;
-		return bvh;
-	} else {
-		bvh->face_index = -1;
+	AABB node_aabb = elements[0].aabb;
+	AABB center_aabb(elements[0].center, Vector3());
+	for (uint32_t i = 1; i < p_count; i++) {
+		node_aabb.merge_with(elements[i].aabb);
+		center_aabb.expand_to(elements[i].center);
 	}
 
-	AABB aabb;
-	for (int i = 0; i < p_size; i++) {
-		if (i == 0) {
-			aabb = p_elements[i].aabb;
-		} else {
-			aabb.merge_with(p_elements[i].aabb);
+	const uint32_t index = r_nodes.size();
+	r_nodes.push_back(BVH());
+	{
+		BVH &node = r_nodes[index];
+		const Vector3 end = node_aabb.position + node_aabb.size;
+		for (int i = 0; i < 3; i++) {
+			node.min[i] = _quantize_min(node_aabb.position[i], i);
+			node.max[i] = _quantize_max(end[i], i);
 		}
 	}
-	bvh->aabb = aabb;
-	switch (aabb.get_longest_axis_index()) {
-		case 0: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareX> sort_x;
-			sort_x.sort(p_elements, p_size);
 
-		} break;
-		case 1: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareY> sort_y;
-			sort_y.sort(p_elements, p_size);
-		} break;
-		case 2: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareZ> sort_z;
-			sort_z.sort(p_elements, p_size);
-		} break;
+	if (p_count <= BVH_MAX_LEAF_FACES) {
+		r_nodes[index].data = BVH_LEAF | ((p_count - 1) << BVH_LEAF_COUNT_SHIFT) | p_from;
+		return index;
 	}
 
-	int split = p_size / 2;
-	bvh->left = _volume_build_bvh(p_elements, split, count);
-	bvh->right = _volume_build_bvh(&p_elements[split], p_size - split, count);
-
-	//printf("branch at %p - %i: %i\n",bvh,count,bvh->face_index);
-	count++;
-	return bvh;
-}
-
-void GodotConcavePolygonShape3D::_fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
-	int idx = p_idx;
+	// Binned surface area heuristic: try the bin boundaries along each axis, and keep the
+	// split that minimizes the area of both sides weighted by their face count.
+	int best_axis = -1;
+	int best_split = 0;
+	real_t best_cost = INFINITY;
 
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
+	if (p_depth < BVH_SAH_MAX_DEPTH) {
+		for (int axis = 0; axis < 3; axis++) {
+			const real_t extent = center_aabb.size[axis];
+			if (extent <= CMP_EPSILON) {
+				continue;
+			}
+			const real_t bin_scale = BVH_SAH_BINS / extent;
+
+			_Volume_BVH_Bin bins[BVH_SAH_BINS];
+			for (uint32_t i = 0; i < p_count; i++) {
+				const int bin = MIN(BVH_SAH_BINS - 1, int((elements[i].center[axis] - center_aabb.position[axis]) * bin_scale));
+				if (bins[bin].count == 0) {
+					bins[bin].aabb = elements[i].aabb;
+				} else {
+					bins[bin].aabb.merge_with(elements[i].aabb);
+				}
+				bins[bin].count++;
+			}
 
-	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
-		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
+			// Sweep from the right to get the cost of every right side, then from the left.
+			real_t right_area[BVH_SAH_BINS];
+			uint32_t right_count[BVH_SAH_BINS];
+			AABB right_aabb;
+			uint32_t count = 0;
+			for (int i = BVH_SAH_BINS - 1; i > 0; i--) {
+				if (bins[i].count) {
+					right_aabb = count ? right_aabb.merge(bins[i].aabb) : bins[i].aabb;
+					count += bins[i].count;
+				}
+				right_area[i] = count ? _volume_bvh_area(right_aabb) : 0;
+				right_count[i] = count;
+			}
 
-	} else {
-		p_bvh_array[p_idx].left = -1;
+			AABB left_aabb;
+			count = 0;
+			for (int i = 0; i < BVH_SAH_BINS - 1; i++) {
+				if (bins[i].count) {
+					left_aabb = count ? left_aabb.merge(bins[i].aabb) : bins[i].aabb;
+					count += bins[i].count;
+				}
+				if (count == 0 || right_count[i + 1] == 0) {
+					continue;
+				}
+				const real_t cost = _volume_bvh_area(left_aabb) * count + right_area[i + 1] * right_count[i + 1];
+				if (cost < best_cost) {
+					best_cost = cost;
+					best_axis = axis;
+					best_split = i + 1;
+				}
+			}
+		}
 	}
 
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
-		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
-
-	} else {
-		p_bvh_array[p_idx].right = -1;
+	uint32_t split = p_count / 2;
+	if (best_axis >= 0) {
+		const real_t bin_scale = BVH_SAH_BINS / center_aabb.size[best_axis];
+		uint32_t left = 0;
+		for (uint32_t i = 0; i < p_count; i++) {
+			const int bin = MIN(BVH_SAH_BINS - 1, int((elements[i].center[best_axis] - center_aabb.position[best_axis]) * bin_scale));
+			if (bin < best_split) {
+				SWAP(elements[i], elements[left]);
+				left++;
+			}
+		}
+		if (left > 0 && left < p_count) {
+			split = left;
+		}
 	}
 
-	memdelete(p_bvh_tree);
+	_build_bvh(p_elements, p_from, split, p_depth + 1, r_nodes);
+	_build_bvh(p_elements, p_from + split, p_count - split, p_depth + 1, r_nodes);
+
+	// The vector may have been reallocated by the children.
+	r_nodes[index].data = r_nodes.size();
+	return index;
 }
 
 void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_backface_collision) {
+	faces.clear();
+	vertices.clear();
+	bvh_storage.reset();
+	bvh = nullptr;
+	bvh_node_count = 0;
+
 	int src_face_count = p_faces.size();
 	if (src_face_count == 0) {
 		configure(AABB());
@@ -1617,52 +1686,65 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 	}
 	ERR_FAIL_COND(src_face_count % 3);
 	src_face_count /= 3;
+	ERR_FAIL_COND_MSG((uint32_t)src_face_count > BVH_LEAF_FACE_MASK + 1, "Too many faces in concave polygon shape.");
 
 	const Vector3 *facesr = p_faces.ptr();
 
-	Vector<_Volume_BVH_Element> bvh_array;
-	bvh_array.resize(src_face_count);
-
-	_Volume_BVH_Element *bvh_arrayw = bvh_array.ptrw();
-
-	faces.resize(src_face_count);
-	Face *facesw = faces.ptrw();
-
-	vertices.resize(src_face_count * 3);
+	LocalVector<_Volume_BVH_Element> bvh_elements;
+	bvh_elements.resize(src_face_count);
 
-	Vector3 *verticesw = vertices.ptrw();
+	vertices = p_faces;
 
 	AABB _aabb;
 
 	for (int i = 0; i < src_face_count; i++) {
-		Face3 face(facesr[i * 3 + 0], facesr[i * 3 + 1], facesr[i * 3 + 2]);
-
-		bvh_arrayw[i].aabb = face.get_aabb();
-		bvh_arrayw[i].center = bvh_arrayw[i].aabb.get_center();
-		bvh_arrayw[i].face_index = i;
-		facesw[i].indices[0] = i * 3 + 0;
-		facesw[i].indices[1] = i * 3 + 1;
-		facesw[i].indices[2] = i * 3 + 2;
-		facesw[i].normal = face.get_plane().normal;
-		verticesw[i * 3 + 0] = face.vertex[0];
-		verticesw[i * 3 + 1] = face.vertex[1];
-		verticesw[i * 3 + 2] = face.vertex[2];
+		AABB face_aabb(facesr[i * 3 + 0], Vector3());
+		face_aabb.expand_to(facesr[i * 3 + 1]);
+		face_aabb.expand_to(facesr[i * 3 + 2]);
+
+		bvh_elements[i].aabb = face_aabb;
+		bvh_elements[i].center = face_aabb.get_center();
+		bvh_elements[i].face_index = i;
 		if (i == 0) {
-			_aabb = bvh_arrayw[i].aabb;
+			_aabb = face_aabb;
 		} else {
-			_aabb.merge_with(bvh_arrayw[i].aabb);
+			_aabb.merge_with(face_aabb);
 		}
 	}
 
-	int count = 0;
-	_Volume_BVH *bvh_tree = _volume_build_bvh(bvh_arrayw, src_face_count, count);
+	bvh_origin = _aabb.position;
+	for (int i = 0; i < 3; i++) {
+		const bool flat = _aabb.size[i] <= 0;
+		bvh_scale[i] = flat ? 0 : BVH_QUANTIZED_MAX / _aabb.size[i];
+		bvh_inv_scale[i] = flat ? 0 : _aabb.size[i] / BVH_QUANTIZED_MAX;
+	}
 
-	bvh.resize(count + 1);
+	LocalVector<BVH> nodes;
+	nodes.reserve(src_face_count / 2);
+	_build_bvh(bvh_elements.ptr(), 0, src_face_count, 0, nodes);
+	bvh_node_count = nodes.size();
 
-	BVH *bvh_arrayw2 = bvh.ptrw();
+	// Pad the storage so the nodes can start on a cache line.
+	const uint32_t pad = 64 / sizeof(BVH) - 1;
+	bvh_storage.resize(bvh_node_count + pad);
+	uint32_t offset = 0;
+	while (offset < pad && (uintptr_t(bvh_storage.ptr() + offset) & 63)) {
+		offset++;
+	}
+	memcpy(bvh_storage.ptr() + offset, nodes.ptr(), bvh_node_count * sizeof(BVH));
+	bvh = bvh_storage.ptr() + offset;
 
-	int idx = 0;
-	_fill_bvh(bvh_tree, bvh_arrayw2, idx);
+	// Store the faces in leaf order, so each leaf reads a contiguous range.
+	faces.resize(src_face_count);
+	Face *facesw = faces.ptrw();
+	for (int i = 0; i < src_face_count; i++) {
+		const int src = bvh_elements[i].face_index;
+		Face3 face(facesr[src * 3 + 0], facesr[src * 3 + 1], facesr[src * 3 + 2]);
+		facesw[i].indices[0] = src * 3 + 0;
+		facesw[i].indices[1] = src * 3 + 1;
+		facesw[i].indices[2] = src * 3 + 2;
+		facesw[i].normal = face.get_plane().normal;
+	}
 
 	backface_collision = p_backface_collision;
 
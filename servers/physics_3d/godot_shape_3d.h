@@ -278,6 +278,7 @@ public:
 struct GodotConvexPolygonShape3D : public GodotShape3D {
 	Geometry3D::MeshData mesh;
 	LocalVector<int> extreme_vertices;
+	LocalVector<Vector3> extreme_vertex_points; // Same as extreme_vertices, but with the positions.
 	LocalVector<LocalVector<int>> vertex_neighbors;
 
 	void _setup(const Vector<Vector3> &p_vertices);
@@ -302,7 +303,7 @@ public:
 	GodotConvexPolygonShape3D();
 };
 
-struct _Volume_BVH;
+struct _Volume_BVH_Element;
 struct GodotFaceShape3D;
 
 struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
@@ -313,51 +314,48 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 		int indices[3] = {};
 	};
 
+	// Faces are sorted in BVH leaf order. Vertices are kept in the order they were given in,
+	// three per face, so `indices[0] / 3` is the index of the face in the source data.
 	Vector<Face> faces;
 	Vector<Vector3> vertices;
 
+	// Bounding volume hierarchy built with the surface area heuristic. Bounds are quantized
+	// to 16 bits relative to the shape AABB, so a node takes 16 bytes and four of them fit in
+	// a cache line. Nodes are stored in depth-first order: the first child of a node directly
+	// follows it, and internal nodes store the index of the next node after their subtree, so
+	// queries don't need a stack. Leaves reference up to BVH_MAX_LEAF_FACES consecutive faces.
 	struct BVH {
-		AABB aabb;
-		int left = 0;
-		int right = 0;
-
-		int face_index = 0;
+		uint16_t min[3] = {};
+		uint16_t max[3] = {};
+		// Internal nodes: index of the next node after the subtree.
+		// Leaves: BVH_LEAF | (face count - 1) << BVH_LEAF_COUNT_SHIFT | first face.
+		uint32_t data = 0;
 	};
 
-	Vector<BVH> bvh;
-
-	struct _CullParams {
-		AABB aabb;
-		QueryCallback callback = nullptr;
-		void *userdata = nullptr;
-		const Face *faces = nullptr;
-		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
-		GodotFaceShape3D *face = nullptr;
-	};
+	static constexpr uint32_t BVH_LEAF = 1u << 31;
+	static constexpr uint32_t BVH_LEAF_COUNT_SHIFT = 28;
+	static constexpr uint32_t BVH_LEAF_FACE_MASK = (1u << BVH_LEAF_COUNT_SHIFT) - 1;
+	static constexpr uint32_t BVH_MAX_LEAF_FACES = 4;
+	static constexpr uint32_t BVH_QUANTIZED_MAX = 65535;
 
-	struct _SegmentCullParams {
-		Vector3 from;
-		Vector3 to;
-		Vector3 dir;
-		const Face *faces = nullptr;
-		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
-		GodotFaceShape3D *face = nullptr;
+	// Over-allocated by a few nodes, so that the nodes in use can start on a cache line.
+	LocalVector<BVH, uint32_t, false, true> bvh_storage;
+	const BVH *bvh = nullptr;
+	uint32_t bvh_node_count = 0;
 
-		Vector3 result;
-		Vector3 normal;
-		int face_index = -1;
-		real_t min_d = 1e20;
-		int collisions = 0;
-	};
+	// Maps from shape space to quantized space and back.
+	Vector3 bvh_origin;
+	Vector3 bvh_scale;
+	Vector3 bvh_inv_scale;
 
 	bool backface_collision = false;
 
-	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
-	bool _cull(int p_idx, _CullParams *p_params) const;
+	_FORCE_INLINE_ uint16_t _quantize_min(real_t p_value, int p_axis) const;
+	_FORCE_INLINE_ uint16_t _quantize_max(real_t p_value, int p_axis) const;
+	_FORCE_INLINE_ AABB _get_node_aabb(const BVH &p_node) const;
+	_FORCE_INLINE_ void _set_face(GodotFaceShape3D *r_face, const Face &p_face) const;
 
-	void _fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
+	uint32_t _build_bvh(_Volume_BVH_Element *p_elements, uint32_t p_from, uint32_t p_count, int p_depth, LocalVector<BVH> &r_nodes) const;
 
 	void _setup(const Vector<Vector3> &p_faces, bool p_backface_collision);
 
@@ -380,6 +378,9 @@ public:
 	virtual void set_data(const Variant &p_data) override;
 	virtual Variant get_data() const override;
 
+	// Memory taken by the faces, vertices and BVH, to compare acceleration structures.
+	size_t get_memory_usage() const;
+
 	GodotConcavePolygonShape3D();
 };
 
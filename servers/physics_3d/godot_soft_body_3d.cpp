@@ -33,9 +33,20 @@
 #include "godot_space_3d.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/rb_map.h"
 #include "servers/rendering_server.h"
 
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFT_BODY_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SOFT_BODY_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
 // Based on Bullet soft body.
 
 /*
@@ -54,6 +65,88 @@ subject to the following restrictions:
 */
 ///btSoftBody implementation by Nathanael Presson
 
+// Node positions and velocities are updated as flat arrays of reals, 4 at a time when possible.
+
+// r = a + b * s
+static void _stream_add_scaled(real_t *r, const real_t *a, const real_t *b, real_t s, uint32_t p_count) {
+	uint32_t i = 0;
+#if defined(SOFT_BODY_SSE2)
+	const __m128 scale = _mm_set1_ps(s);
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_mul_ps(_mm_loadu_ps(b + i), scale)));
+	}
+#elif defined(SOFT_BODY_NEON)
+	const float32x4_t scale = vdupq_n_f32(s);
+	for (; i + 4 <= p_count; i += 4) {
+		vst1q_f32(r + i, vaddq_f32(vld1q_f32(a + i), vmulq_f32(vld1q_f32(b + i), scale)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r[i] = a[i] + b[i] * s;
+	}
+}
+
+// r = (a - b) * s
+static void _stream_sub_scaled(real_t *r, const real_t *a, const real_t *b, real_t s, uint32_t p_count) {
+	uint32_t i = 0;
+#if defined(SOFT_BODY_SSE2)
+	const __m128 scale = _mm_set1_ps(s);
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r + i, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)), scale));
+	}
+#elif defined(SOFT_BODY_NEON)
+	const float32x4_t scale = vdupq_n_f32(s);
+	for (; i + 4 <= p_count; i += 4) {
+		vst1q_f32(r + i, vmulq_f32(vsubq_f32(vld1q_f32(a + i), vld1q_f32(b + i)), scale));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r[i] = (a[i] - b[i]) * s;
+	}
+}
+
+void GodotSoftBody3D::Nodes::resize(uint32_t p_size) {
+	s.resize(p_size);
+	x.resize(p_size);
+	q.resize(p_size);
+	f.resize(p_size);
+	v.resize(p_size);
+	bv.resize(p_size);
+	n.resize(p_size);
+	area.resize(p_size);
+	im.resize(p_size);
+	leaf.resize(p_size);
+}
+
+void GodotSoftBody3D::Nodes::clear() {
+	s.clear();
+	x.clear();
+	q.clear();
+	f.clear();
+	v.clear();
+	bv.clear();
+	n.clear();
+	area.clear();
+	im.clear();
+	leaf.clear();
+}
+
+void GodotSoftBody3D::Links::resize(uint32_t p_size) {
+	a.resize(p_size);
+	b.resize(p_size);
+	rl.resize(p_size);
+	c0.resize(p_size);
+	c1.resize(p_size);
+}
+
+void GodotSoftBody3D::Links::clear() {
+	a.clear();
+	b.clear();
+	rl.clear();
+	c0.clear();
+	c1.clear();
+}
+
 GodotSoftBody3D::GodotSoftBody3D() :
 		GodotCollisionObject3D(TYPE_SOFT_BODY),
 		active_list(this) {
@@ -110,8 +203,15 @@ Variant GodotSoftBody3D::get_state(PhysicsServer3D::BodyState p_state) const {
 	return Variant();
 }
 
+void GodotSoftBody3D::_island_changed() {
+	get_space()->island_dissolve(island_id);
+}
+
 void GodotSoftBody3D::set_space(GodotSpace3D *p_space) {
 	if (get_space()) {
+		if (island_id >= 0) {
+			_island_changed();
+		}
 		get_space()->soft_body_remove_from_active_list(&active_list);
 
 		deinitialize_shape();
@@ -154,34 +254,36 @@ void GodotSoftBody3D::update_rendering_server(PhysicsServer3DRenderingServerHand
 	const uint32_t vertex_count = map_visual_to_physics.size();
 	for (uint32_t i = 0; i < vertex_count; ++i) {
 		const uint32_t node_index = map_visual_to_physics[i];
-		const Node &node = nodes[node_index];
 
-		p_rendering_server_handler->set_vertex(i, node.x);
-		p_rendering_server_handler->set_normal(i, node.n);
+		p_rendering_server_handler->set_vertex(i, nodes.x[node_index]);
+		p_rendering_server_handler->set_normal(i, nodes.n[node_index]);
 	}
 
 	p_rendering_server_handler->set_aabb(bounds);
 }
 
 void GodotSoftBody3D::update_normals_and_centroids() {
-	for (Node &node : nodes) {
-		node.n = Vector3();
+	for (Vector3 &normal : nodes.n) {
+		normal = Vector3();
 	}
 
 	for (Face &face : faces) {
-		const Vector3 n = vec3_cross(face.n[0]->x - face.n[2]->x, face.n[0]->x - face.n[1]->x);
-		face.n[0]->n += n;
-		face.n[1]->n += n;
-		face.n[2]->n += n;
+		const Vector3 &x0 = nodes.x[face.n[0]];
+		const Vector3 &x1 = nodes.x[face.n[1]];
+		const Vector3 &x2 = nodes.x[face.n[2]];
+		const Vector3 n = vec3_cross(x0 - x2, x0 - x1);
+		nodes.n[face.n[0]] += n;
+		nodes.n[face.n[1]] += n;
+		nodes.n[face.n[2]] += n;
 		face.normal = n;
 		face.normal.normalize();
-		face.centroid = 0.33333333333 * (face.n[0]->x + face.n[1]->x + face.n[2]->x);
+		face.centroid = 0.33333333333 * (x0 + x1 + x2);
 	}
 
-	for (Node &node : nodes) {
-		real_t len = node.n.length();
+	for (Vector3 &normal : nodes.n) {
+		real_t len = normal.length();
 		if (len > CMP_EPSILON) {
-			node.n /= len;
+			normal /= len;
 		}
 	}
 }
@@ -201,15 +303,15 @@ void GodotSoftBody3D::update_bounds() {
 	bool first = true;
 	bool moved = false;
 	for (uint32_t node_index = 0; node_index < nodes_count; ++node_index) {
-		const Node &node = nodes[node_index];
-		if (!prev_bounds.has_point(node.x)) {
+		const Vector3 &x = nodes.x[node_index];
+		if (!prev_bounds.has_point(x)) {
 			moved = true;
 		}
 		if (first) {
-			bounds.position = node.x;
+			bounds.position = x;
 			first = false;
 		} else {
-			bounds.expand_to(node.x);
+			bounds.expand_to(x);
 		}
 	}
 
@@ -229,9 +331,9 @@ void GodotSoftBody3D::update_area() {
 
 	// Face area.
 	for (Face &face : faces) {
-		const Vector3 &x0 = face.n[0]->x;
-		const Vector3 &x1 = face.n[1]->x;
-		const Vector3 &x2 = face.n[2]->x;
+		const Vector3 &x0 = nodes.x[face.n[0]];
+		const Vector3 &x1 = nodes.x[face.n[1]];
+		const Vector3 &x2 = nodes.x[face.n[2]];
 
 		const Vector3 a = x1 - x0;
 		const Vector3 b = x2 - x0;
@@ -246,38 +348,38 @@ void GodotSoftBody3D::update_area() {
 		memset(counts.ptr(), 0, counts.size() * sizeof(int));
 	}
 
-	for (Node &node : nodes) {
-		node.area = 0.0;
+	for (real_t &area : nodes.area) {
+		area = 0.0;
 	}
 
 	for (const Face &face : faces) {
 		for (int j = 0; j < 3; ++j) {
-			const int index = (int)(face.n[j] - &nodes[0]);
+			const uint32_t index = face.n[j];
 			counts[index]++;
-			face.n[j]->area += Math::abs(face.ra);
+			nodes.area[index] += Math::abs(face.ra);
 		}
 	}
 
 	for (i = 0, ni = nodes.size(); i < ni; ++i) {
 		if (counts[i] > 0) {
-			nodes[i].area /= (real_t)counts[i];
+			nodes.area[i] /= (real_t)counts[i];
 		} else {
-			nodes[i].area = 0.0;
+			nodes.area[i] = 0.0;
 		}
 	}
 }
 
 void GodotSoftBody3D::reset_link_rest_lengths() {
-	for (Link &link : links) {
-		link.rl = (link.n[0]->x - link.n[1]->x).length();
-		link.c1 = link.rl * link.rl;
+	for (uint32_t i = 0; i < links.size(); i++) {
+		links.rl[i] = (nodes.x[links.a[i]] - nodes.x[links.b[i]]).length();
+		links.c1[i] = links.rl[i] * links.rl[i];
 	}
 }
 
 void GodotSoftBody3D::update_link_constants() {
 	real_t inv_linear_stiffness = 1.0 / linear_stiffness;
-	for (Link &link : links) {
-		link.c0 = (link.n[0]->im + link.n[1]->im) * inv_linear_stiffness;
+	for (uint32_t i = 0; i < links.size(); i++) {
+		links.c0[i] = (nodes.im[links.a[i]] + nodes.im[links.b[i]]) * inv_linear_stiffness;
 	}
 }
 
@@ -289,15 +391,13 @@ void GodotSoftBody3D::apply_nodes_transform(const Transform3D &p_transform) {
 	uint32_t node_count = nodes.size();
 	Vector3 leaf_size = Vector3(collision_margin, collision_margin, collision_margin) * 2.0;
 	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
-		Node &node = nodes[node_index];
-
-		node.x = p_transform.xform(node.x);
-		node.q = node.x;
-		node.v = Vector3();
-		node.bv = Vector3();
+		nodes.x[node_index] = p_transform.xform(nodes.x[node_index]);
+		nodes.q[node_index] = nodes.x[node_index];
+		nodes.v[node_index] = Vector3();
+		nodes.bv[node_index] = Vector3();
 
-		AABB node_aabb(node.x, leaf_size);
-		node_tree.update(node.leaf, node_aabb);
+		AABB node_aabb(nodes.x[node_index], leaf_size);
+		node_tree.update(nodes.leaf[node_index], node_aabb);
 	}
 
 	face_tree.clear();
@@ -318,7 +418,7 @@ Vector3 GodotSoftBody3D::get_vertex_position(int p_index) const {
 	uint32_t node_index = map_visual_to_physics[p_index];
 
 	ERR_FAIL_COND_V(node_index >= nodes.size(), Vector3());
-	return nodes[node_index].x;
+	return nodes.x[node_index];
 }
 
 void GodotSoftBody3D::set_vertex_position(int p_index, const Vector3 &p_position) {
@@ -332,9 +432,8 @@ void GodotSoftBody3D::set_vertex_position(int p_index, const Vector3 &p_position
 	uint32_t node_index = map_visual_to_physics[p_index];
 
 	ERR_FAIL_COND(node_index >= nodes.size());
-	Node &node = nodes[node_index];
-	node.q = node.x;
-	node.x = p_position;
+	nodes.q[node_index] = nodes.x[node_index];
+	nodes.x[node_index] = p_position;
 }
 
 void GodotSoftBody3D::pin_vertex(int p_index) {
@@ -351,8 +450,7 @@ void GodotSoftBody3D::pin_vertex(int p_index) {
 		uint32_t node_index = map_visual_to_physics[p_index];
 
 		ERR_FAIL_COND(node_index >= nodes.size());
-		Node &node = nodes[node_index];
-		node.im = 0.0;
+		nodes.im[node_index] = 0.0;
 	}
 }
 
@@ -371,8 +469,7 @@ void GodotSoftBody3D::unpin_vertex(int p_index) {
 				ERR_FAIL_COND(node_index >= nodes.size());
 				real_t inv_node_mass = nodes.size() * inv_total_mass;
 
-				Node &node = nodes[node_index];
-				node.im = inv_node_mass;
+				nodes.im[node_index] = inv_node_mass;
 			}
 
 			return;
@@ -391,8 +488,7 @@ void GodotSoftBody3D::unpin_all_vertices() {
 			uint32_t node_index = map_visual_to_physics[pinned_vertex];
 
 			ERR_CONTINUE(node_index >= nodes.size());
-			Node &node = nodes[node_index];
-			node.im = inv_node_mass;
+			nodes.im[node_index] = inv_node_mass;
 		}
 	}
 
@@ -418,34 +514,32 @@ uint32_t GodotSoftBody3D::get_node_count() const {
 
 real_t GodotSoftBody3D::get_node_inv_mass(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), 0.0);
-	return nodes[p_node_index].im;
+	return nodes.im[p_node_index];
 }
 
 Vector3 GodotSoftBody3D::get_node_position(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), Vector3());
-	return nodes[p_node_index].x;
+	return nodes.x[p_node_index];
 }
 
 Vector3 GodotSoftBody3D::get_node_velocity(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), Vector3());
-	return nodes[p_node_index].v;
+	return nodes.v[p_node_index];
 }
 
 Vector3 GodotSoftBody3D::get_node_biased_velocity(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), Vector3());
-	return nodes[p_node_index].bv;
+	return nodes.bv[p_node_index];
 }
 
 void GodotSoftBody3D::apply_node_impulse(uint32_t p_node_index, const Vector3 &p_impulse) {
 	ERR_FAIL_UNSIGNED_INDEX(p_node_index, nodes.size());
-	Node &node = nodes[p_node_index];
-	node.v += p_impulse * node.im;
+	nodes.v[p_node_index] += p_impulse * nodes.im[p_node_index];
 }
 
 void GodotSoftBody3D::apply_node_bias_impulse(uint32_t p_node_index, const Vector3 &p_impulse) {
 	ERR_FAIL_UNSIGNED_INDEX(p_node_index, nodes.size());
-	Node &node = nodes[p_node_index];
-	node.bv += p_impulse * node.im;
+	nodes.bv[p_node_index] += p_impulse * nodes.im[p_node_index];
 }
 
 uint32_t GodotSoftBody3D::get_face_count() const {
@@ -455,9 +549,9 @@ uint32_t GodotSoftBody3D::get_face_count() const {
 void GodotSoftBody3D::get_face_points(uint32_t p_face_index, Vector3 &r_point_1, Vector3 &r_point_2, Vector3 &r_point_3) const {
 	ERR_FAIL_UNSIGNED_INDEX(p_face_index, faces.size());
 	const Face &face = faces[p_face_index];
-	r_point_1 = face.n[0]->x;
-	r_point_2 = face.n[1]->x;
-	r_point_3 = face.n[2]->x;
+	r_point_1 = nodes.x[face.n[0]];
+	r_point_2 = nodes.x[face.n[1]];
+	r_point_3 = nodes.x[face.n[2]];
 }
 
 Vector3 GodotSoftBody3D::get_face_normal(uint32_t p_face_index) const {
@@ -528,16 +622,18 @@ bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Ve
 	real_t inv_node_mass = node_count * inv_total_mass;
 	Vector3 leaf_size = Vector3(collision_margin, collision_margin, collision_margin) * 2.0;
 	for (uint32_t i = 0; i < node_count; ++i) {
-		Node &node = nodes[i];
-		node.s = vertices[i];
-		node.x = node.s;
-		node.q = node.s;
-		node.im = inv_node_mass;
+		nodes.s[i] = vertices[i];
+		nodes.x[i] = vertices[i];
+		nodes.q[i] = vertices[i];
+		nodes.f[i] = Vector3();
+		nodes.v[i] = Vector3();
+		nodes.bv[i] = Vector3();
+		nodes.n[i] = Vector3();
+		nodes.area[i] = 0.0;
+		nodes.im[i] = inv_node_mass;
 
-		AABB node_aabb(node.x, leaf_size);
-		node.leaf = node_tree.insert(node_aabb, &node);
-
-		node.index = i;
+		AABB node_aabb(vertices[i], leaf_size);
+		nodes.leaf[i] = node_tree.insert(node_aabb, (void *)(uintptr_t)i);
 	}
 
 	// Create links and faces from triangles.
@@ -571,12 +667,11 @@ bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Ve
 		uint32_t node_index = map_visual_to_physics[pinned_vertex];
 
 		ERR_CONTINUE(node_index >= node_count);
-		Node &node = nodes[node_index];
-		node.im = 0.0;
+		nodes.im[node_index] = 0.0;
 	}
 
 	generate_bending_constraints(2);
-	reoptimize_link_order();
+	color_links();
 
 	update_constants();
 	update_normals_and_centroids();
@@ -607,9 +702,9 @@ void GodotSoftBody3D::generate_bending_constraints(int p_distance) {
 				}
 			}
 		}
-		for (Link &link : links) {
-			const int ia = (int)(link.n[0] - &nodes[0]);
-			const int ib = (int)(link.n[1] - &nodes[0]);
+		for (uint32_t link_index = 0; link_index < links.size(); link_index++) {
+			const int ia = links.a[link_index];
+			const int ib = links.b[link_index];
 			int idx = ib * n + ia;
 			int idx_inv = ia * n + ib;
 			adj[idx] = 1;
@@ -623,9 +718,9 @@ void GodotSoftBody3D::generate_bending_constraints(int p_distance) {
 			// Build node links.
 			node_links.resize(nodes.size());
 
-			for (Link &link : links) {
-				const int ia = (int)(link.n[0] - &nodes[0]);
-				const int ib = (int)(link.n[1] - &nodes[0]);
+			for (uint32_t link_index = 0; link_index < links.size(); link_index++) {
+				const int ia = links.a[link_index];
+				const int ib = links.b[link_index];
 				if (node_links[ia].find(ib) == -1) {
 					node_links[ia].push_back(ib);
 				}
@@ -683,142 +778,71 @@ void GodotSoftBody3D::generate_bending_constraints(int p_distance) {
 	}
 }
 
-//===================================================================
-//
-//
-// This function takes in a list of interdependent Links and tries
-// to maximize the distance between calculation
-// of dependent links. This increases the amount of parallelism that can
-// be exploited by out-of-order instruction processors with large but
-// (inevitably) finite instruction windows.
-//
-//===================================================================
-
-// A small structure to track lists of dependent link calculations.
-class LinkDeps {
-public:
-	// A link calculation that is dependent on this one.
-	// Positive values = "input A" while negative values = "input B".
-	int value;
-	// Next dependence in the list.
-	LinkDeps *next;
-};
-typedef LinkDeps *LinkDepsPtr;
-
-void GodotSoftBody3D::reoptimize_link_order() {
-	const int reop_not_dependent = -1;
-	const int reop_node_complete = -2;
-
-	uint32_t link_count = links.size();
-	uint32_t node_count = nodes.size();
+void GodotSoftBody3D::color_links() {
+	link_color_offsets.clear();
 
-	if (link_count < 1 || node_count < 2) {
+	const uint32_t link_count = links.size();
+	if (link_count == 0) {
 		return;
 	}
 
-	uint32_t i;
-	Link *lr;
-	int ar, br;
-	Node *node0 = &(nodes[0]);
-	Node *node1 = &(nodes[1]);
-	LinkDepsPtr link_dep;
-	int ready_list_head, ready_list_tail, link_num, link_dep_frees, dep_link;
-
-	// Allocate temporary buffers.
-	int *node_written_at = memnew_arr(int, node_count + 1); // What link calculation produced this node's current values?
-	int *link_dep_A = memnew_arr(int, link_count); // Link calculation input is dependent upon prior calculation #N
-	int *link_dep_B = memnew_arr(int, link_count);
-	int *ready_list = memnew_arr(int, link_count); // List of ready-to-process link calculations (# of links, maximum)
-	LinkDeps *link_dep_free_list = memnew_arr(LinkDeps, 2 * link_count); // Dependent-on-me list elements (2x# of links, maximum)
-	LinkDepsPtr *link_dep_list_starts = memnew_arr(LinkDepsPtr, link_count); // Start nodes of dependent-on-me lists, one for each link
-
-	// Copy the original, unsorted links to a side buffer.
-	Link *link_buffer = memnew_arr(Link, link_count);
-	memcpy(link_buffer, &(links[0]), sizeof(Link) * link_count);
-
-	// Clear out the node setup and ready list.
-	for (i = 0; i < node_count + 1; i++) {
-		node_written_at[i] = reop_not_dependent;
-	}
-	for (i = 0; i < link_count; i++) {
-		link_dep_list_starts[i] = nullptr;
-	}
-	ready_list_head = ready_list_tail = link_dep_frees = 0;
-
-	// Initial link analysis to set up data structures.
-	for (i = 0; i < link_count; i++) {
-		// Note which prior link calculations we are dependent upon & build up dependence lists.
-		lr = &(links[i]);
-		ar = (lr->n[0] - node0) / (node1 - node0);
-		br = (lr->n[1] - node0) / (node1 - node0);
-		if (node_written_at[ar] > reop_not_dependent) {
-			link_dep_A[i] = node_written_at[ar];
-			link_dep = &link_dep_free_list[link_dep_frees++];
-			link_dep->value = i;
-			link_dep->next = link_dep_list_starts[node_written_at[ar]];
-			link_dep_list_starts[node_written_at[ar]] = link_dep;
-		} else {
-			link_dep_A[i] = reop_not_dependent;
-		}
-		if (node_written_at[br] > reop_not_dependent) {
-			link_dep_B[i] = node_written_at[br];
-			link_dep = &link_dep_free_list[link_dep_frees++];
-			link_dep->value = -(int)(i + 1);
-			link_dep->next = link_dep_list_starts[node_written_at[br]];
-			link_dep_list_starts[node_written_at[br]] = link_dep;
-		} else {
-			link_dep_B[i] = reop_not_dependent;
-		}
-
-		// Add this link to the initial ready list, if it is not dependent on any other links.
-		if ((link_dep_A[i] == reop_not_dependent) && (link_dep_B[i] == reop_not_dependent)) {
-			ready_list[ready_list_tail++] = i;
-			link_dep_A[i] = link_dep_B[i] = reop_node_complete; // Probably not needed now.
+	// Greedily give each link the first color which none of the other links of its nodes has.
+	// Colors used by the links of each node are kept as a bit mask.
+	LocalVector<uint64_t> node_colors;
+	node_colors.resize(nodes.size());
+	memset(node_colors.ptr(), 0, node_colors.size() * sizeof(uint64_t));
+
+	LocalVector<uint32_t> link_colors;
+	link_colors.resize(link_count);
+	uint32_t color_sizes[MAX_LINK_COLORS + 1] = {};
+	uint32_t color_count = 0;
+	for (uint32_t i = 0; i < link_count; i++) {
+		const uint64_t used_colors = node_colors[links.a[i]] | node_colors[links.b[i]];
+		uint32_t color = MAX_LINK_COLORS;
+		if (used_colors != UINT64_MAX) {
+			color = 0;
+			while (used_colors & (uint64_t(1) << color)) {
+				color++;
+			}
+			node_colors[links.a[i]] |= uint64_t(1) << color;
+			node_colors[links.b[i]] |= uint64_t(1) << color;
+			color_count = MAX(color_count, color + 1);
 		}
+		link_colors[i] = color;
+		color_sizes[color]++;
+	}
 
-		// Update the nodes to mark which ones are calculated by this link.
-		node_written_at[ar] = node_written_at[br] = i;
-	}
-
-	// Process the ready list and create the sorted list of links:
-	// -- By treating the ready list as a queue, we maximize the distance between any
-	//    inter-dependent node calculations.
-	// -- All other (non-related) nodes in the ready list will automatically be inserted
-	//    in between each set of inter-dependent link calculations by this loop.
-	i = 0;
-	while (ready_list_head != ready_list_tail) {
-		// Use ready list to select the next link to process.
-		link_num = ready_list[ready_list_head++];
-		// Copy the next-to-calculate link back into the original link array.
-		links[i++] = link_buffer[link_num];
-
-		// Free up any link inputs that are dependent on this one.
-		link_dep = link_dep_list_starts[link_num];
-		while (link_dep) {
-			dep_link = link_dep->value;
-			if (dep_link >= 0) {
-				link_dep_A[dep_link] = reop_not_dependent;
-			} else {
-				dep_link = -dep_link - 1;
-				link_dep_B[dep_link] = reop_not_dependent;
+	// Links which didn't fit in any color go in a last range of their own.
+	color_sizes[color_count] = color_sizes[MAX_LINK_COLORS];
+	if (color_count < MAX_LINK_COLORS) {
+		for (uint32_t i = 0; i < link_count; i++) {
+			if (link_colors[i] == MAX_LINK_COLORS) {
+				link_colors[i] = color_count;
 			}
-			// Add this dependent link calculation to the ready list if *both* inputs are clear.
-			if ((link_dep_A[dep_link] == reop_not_dependent) && (link_dep_B[dep_link] == reop_not_dependent)) {
-				ready_list[ready_list_tail++] = dep_link;
-				link_dep_A[dep_link] = link_dep_B[dep_link] = reop_node_complete; // Probably not needed now.
-			}
-			link_dep = link_dep->next;
 		}
 	}
 
-	// Delete the temporary buffers.
-	memdelete_arr(node_written_at);
-	memdelete_arr(link_dep_A);
-	memdelete_arr(link_dep_B);
-	memdelete_arr(ready_list);
-	memdelete_arr(link_dep_free_list);
-	memdelete_arr(link_dep_list_starts);
-	memdelete_arr(link_buffer);
+	link_color_offsets.resize(color_count + 2);
+	link_color_offsets[0] = 0;
+	for (uint32_t color = 0; color <= color_count; color++) {
+		link_color_offsets[color + 1] = link_color_offsets[color] + color_sizes[color];
+	}
+
+	// Sort the links by color, keeping their order within each color.
+	Links sorted_links;
+	sorted_links.resize(link_count);
+	LocalVector<uint32_t> color_ends;
+	color_ends.resize(color_count + 1);
+	memcpy(color_ends.ptr(), link_color_offsets.ptr(), color_ends.size() * sizeof(uint32_t));
+	for (uint32_t i = 0; i < link_count; i++) {
+		const uint32_t index = color_ends[link_colors[i]]++;
+		sorted_links.a[index] = links.a[i];
+		sorted_links.b[index] = links.b[i];
+		sorted_links.rl[index] = links.rl[i];
+		sorted_links.c0[index] = links.c0[i];
+		sorted_links.c1[index] = links.c1[i];
+	}
+	links = sorted_links;
 }
 
 void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
@@ -826,15 +850,11 @@ void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
 		return;
 	}
 
-	Node *node1 = &nodes[p_node1];
-	Node *node2 = &nodes[p_node2];
-
-	Link link;
-	link.n[0] = node1;
-	link.n[1] = node2;
-	link.rl = (node1->x - node2->x).length();
-
-	links.push_back(link);
+	links.a.push_back(p_node1);
+	links.b.push_back(p_node2);
+	links.rl.push_back((nodes.x[p_node1] - nodes.x[p_node2]).length());
+	links.c0.push_back(0.0);
+	links.c1.push_back(0.0);
 }
 
 void GodotSoftBody3D::append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3) {
@@ -848,14 +868,10 @@ void GodotSoftBody3D::append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p
 		return;
 	}
 
-	Node *node1 = &nodes[p_node1];
-	Node *node2 = &nodes[p_node2];
-	Node *node3 = &nodes[p_node3];
-
 	Face face;
-	face.n[0] = node1;
-	face.n[1] = node2;
-	face.n[2] = node3;
+	face.n[0] = p_node1;
+	face.n[1] = p_node2;
+	face.n[2] = p_node3;
 
 	face.index = faces.size();
 
@@ -873,10 +889,8 @@ void GodotSoftBody3D::set_total_mass(real_t p_val) {
 	real_t mass_factor = total_mass * inv_total_mass;
 	total_mass = p_val;
 
-	uint32_t node_count = nodes.size();
-	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
-		Node &node = nodes[node_index];
-		node.im *= mass_factor;
+	for (real_t &im : nodes.im) {
+		im *= mass_factor;
 	}
 
 	update_constants();
@@ -903,9 +917,10 @@ void GodotSoftBody3D::set_drag_coefficient(real_t p_val) {
 }
 
 void GodotSoftBody3D::add_velocity(const Vector3 &p_velocity) {
-	for (Node &node : nodes) {
-		if (node.im > 0) {
-			node.v += p_velocity;
+	const uint32_t node_count = nodes.size();
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		if (nodes.im[node_index] > 0) {
+			nodes.v[node_index] += p_velocity;
 		}
 	}
 }
@@ -918,14 +933,14 @@ void GodotSoftBody3D::apply_forces(const LocalVector<GodotArea3D *> &p_wind_area
 	int32_t j;
 
 	real_t volume = 0.0;
-	const Vector3 &org = nodes[0].x;
+	const Vector3 &org = nodes.x[0];
 
 	// Iterate over faces (try not to iterate elsewhere if possible).
 	for (const Face &face : faces) {
 		Vector3 wind_force(0, 0, 0);
 
 		// Compute volume.
-		volume += vec3_dot(face.n[0]->x - org, vec3_cross(face.n[1]->x - org, face.n[2]->x - org));
+		volume += vec3_dot(nodes.x[face.n[0]] - org, vec3_cross(nodes.x[face.n[1]] - org, nodes.x[face.n[2]] - org));
 
 		// Compute nodal forces from area winds.
 		if (!p_wind_areas.is_empty()) {
@@ -934,8 +949,7 @@ void GodotSoftBody3D::apply_forces(const LocalVector<GodotArea3D *> &p_wind_area
 			}
 
 			for (j = 0; j < 3; j++) {
-				Node *current_node = face.n[j];
-				current_node->f += wind_force;
+				nodes.f[face.n[j]] += wind_force;
 			}
 		}
 	}
@@ -944,9 +958,10 @@ void GodotSoftBody3D::apply_forces(const LocalVector<GodotArea3D *> &p_wind_area
 	// Apply nodal pressure forces.
 	if (pressure_coefficient > CMP_EPSILON) {
 		real_t ivolumetp = 1.0 / Math::abs(volume) * pressure_coefficient;
-		for (Node &node : nodes) {
-			if (node.im > 0) {
-				node.f += node.n * (node.area * ivolumetp);
+		const uint32_t node_count = nodes.size();
+		for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+			if (nodes.im[node_index] > 0) {
+				nodes.f[node_index] += nodes.n[node_index] * (nodes.area[node_index] * ivolumetp);
 			}
 		}
 	}
@@ -1029,27 +1044,28 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	real_t clamp_delta_v = max_displacement * inv_delta;
 
 	// Integrate.
-	for (Node &node : nodes) {
-		node.q = node.x;
-		Vector3 delta_v = node.f * node.im * p_delta;
+	const uint32_t node_count = nodes.size();
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		nodes.q[node_index] = nodes.x[node_index];
+		Vector3 delta_v = nodes.f[node_index] * nodes.im[node_index] * p_delta;
 		for (int c = 0; c < 3; c++) {
 			delta_v[c] = CLAMP(delta_v[c], -clamp_delta_v, clamp_delta_v);
 		}
-		node.v += delta_v;
-		node.x += node.v * p_delta;
-		node.f = Vector3();
+		nodes.v[node_index] += delta_v;
+		nodes.x[node_index] += nodes.v[node_index] * p_delta;
+		nodes.f[node_index] = Vector3();
 	}
 
 	// Bounds and tree update.
 	update_bounds();
 
 	// Node tree update.
-	for (const Node &node : nodes) {
-		AABB node_aabb(node.x, Vector3());
-		node_aabb.expand_to(node.x + node.v * p_delta);
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		AABB node_aabb(nodes.x[node_index], Vector3());
+		node_aabb.expand_to(nodes.x[node_index] + nodes.v[node_index] * p_delta);
 		node_aabb.grow_by(collision_margin);
 
-		node_tree.update(node.leaf, node_aabb);
+		node_tree.update(nodes.leaf[node_index], node_aabb);
 	}
 
 	// Face tree update.
@@ -1062,48 +1078,80 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	face_tree.optimize_incremental(1);
 }
 
-void GodotSoftBody3D::solve_constraints(real_t p_delta) {
-	const real_t inv_delta = 1.0 / p_delta;
-
-	for (Link &link : links) {
-		link.c3 = link.n[1]->q - link.n[0]->q;
-		link.c2 = 1 / (link.c3.length_squared() * link.c0);
+void GodotSoftBody3D::solve_constraints(real_t p_delta, bool p_parallel) {
+	if (nodes.is_empty()) {
+		return;
 	}
 
+	const real_t inv_delta = 1.0 / p_delta;
+	const uint32_t real_count = nodes.size() * 3;
+	real_t *x = (real_t *)nodes.x.ptr();
+	real_t *q = (real_t *)nodes.q.ptr();
+	real_t *v = (real_t *)nodes.v.ptr();
+	real_t *bv = (real_t *)nodes.bv.ptr();
+
 	// Solve velocities.
-	for (Node &node : nodes) {
-		node.x = node.q + node.v * p_delta;
-	}
+	_stream_add_scaled(x, q, v, p_delta, real_count);
 
 	// Solve positions.
 	for (int isolve = 0; isolve < iteration_count; ++isolve) {
-		const real_t ti = isolve / (real_t)iteration_count;
-		solve_links(1.0, ti);
-	}
-	const real_t vc = (1.0 - damping_coefficient) * inv_delta;
-	for (Node &node : nodes) {
-		node.x += node.bv * p_delta;
-		node.bv = Vector3();
+		if (!p_parallel) {
+			// Colors are contiguous, so this solves them in the same order.
+			solve_links(1.0, 0, links.size());
+			continue;
+		}
 
-		node.v = (node.x - node.q) * vc;
+		const uint32_t range_count = link_color_offsets.size() - 1;
+		for (uint32_t color = 0; color < range_count; color++) {
+			LinkSolve solve;
+			solve.kst = 1.0;
+			solve.begin = link_color_offsets[color];
+			solve.end = link_color_offsets[color + 1];
+
+			// The last range holds the links which didn't fit in any color.
+			const uint32_t batch_count = (solve.end - solve.begin + LINK_BATCH_SIZE - 1) / LINK_BATCH_SIZE;
+			if (color == range_count - 1 || batch_count < 2) {
+				solve_links(solve.kst, solve.begin, solve.end);
+				continue;
+			}
 
-		node.q = node.x;
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotSoftBody3D::_solve_link_batch, &solve, batch_count, -1, true, SNAME("Physics3DSoftBodyLinks"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		}
 	}
 
+	const real_t vc = (1.0 - damping_coefficient) * inv_delta;
+	_stream_add_scaled(x, x, bv, p_delta, real_count);
+	memset(bv, 0, real_count * sizeof(real_t));
+	_stream_sub_scaled(v, x, q, vc, real_count);
+	memcpy(q, x, real_count * sizeof(real_t));
+
 	update_normals_and_centroids();
 }
 
-void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
-	for (Link &link : links) {
-		if (link.c0 > 0) {
-			Node &node_a = *link.n[0];
-			Node &node_b = *link.n[1];
-			const Vector3 del = node_b.x - node_a.x;
+void GodotSoftBody3D::_solve_link_batch(uint32_t p_batch_index, LinkSolve *p_solve) {
+	const uint32_t begin = p_solve->begin + p_batch_index * LINK_BATCH_SIZE;
+	solve_links(p_solve->kst, begin, MIN(begin + LINK_BATCH_SIZE, p_solve->end));
+}
+
+void GodotSoftBody3D::solve_links(real_t p_kst, uint32_t p_begin, uint32_t p_end) {
+	const uint32_t *link_a = links.a.ptr();
+	const uint32_t *link_b = links.b.ptr();
+	const real_t *c0 = links.c0.ptr();
+	const real_t *c1 = links.c1.ptr();
+	const real_t *im = nodes.im.ptr();
+	Vector3 *x = nodes.x.ptr();
+
+	for (uint32_t i = p_begin; i < p_end; i++) {
+		if (c0[i] > 0) {
+			const uint32_t a = link_a[i];
+			const uint32_t b = link_b[i];
+			const Vector3 del = x[b] - x[a];
 			const real_t len = del.length_squared();
-			if (link.c1 + len > CMP_EPSILON) {
-				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * kst;
-				node_a.x -= del * (k * node_a.im);
-				node_b.x += del * (k * node_b.im);
+			if (c1[i] + len > CMP_EPSILON) {
+				const real_t k = ((c1[i] - len) / (c0[i] * (c1[i] + len))) * p_kst;
+				x[a] -= del * (k * im[a]);
+				x[b] += del * (k * im[b]);
 			}
 		}
 	}
@@ -1156,9 +1204,9 @@ void GodotSoftBody3D::initialize_face_tree() {
 	for (Face &face : faces) {
 		AABB face_aabb;
 
-		face_aabb.position = face.n[0]->x;
-		face_aabb.expand_to(face.n[1]->x);
-		face_aabb.expand_to(face.n[2]->x);
+		face_aabb.position = nodes.x[face.n[0]];
+		face_aabb.expand_to(nodes.x[face.n[1]]);
+		face_aabb.expand_to(nodes.x[face.n[2]]);
 
 		face_aabb.grow_by(collision_margin);
 
@@ -1170,17 +1218,17 @@ void GodotSoftBody3D::update_face_tree(real_t p_delta) {
 	for (const Face &face : faces) {
 		AABB face_aabb;
 
-		const Node *node0 = face.n[0];
-		face_aabb.position = node0->x;
-		face_aabb.expand_to(node0->x + node0->v * p_delta);
+		const uint32_t node0 = face.n[0];
+		face_aabb.position = nodes.x[node0];
+		face_aabb.expand_to(nodes.x[node0] + nodes.v[node0] * p_delta);
 
-		const Node *node1 = face.n[1];
-		face_aabb.expand_to(node1->x);
-		face_aabb.expand_to(node1->x + node1->v * p_delta);
+		const uint32_t node1 = face.n[1];
+		face_aabb.expand_to(nodes.x[node1]);
+		face_aabb.expand_to(nodes.x[node1] + nodes.v[node1] * p_delta);
 
-		const Node *node2 = face.n[2];
-		face_aabb.expand_to(node2->x);
-		face_aabb.expand_to(node2->x + node2->v * p_delta);
+		const uint32_t node2 = face.n[2];
+		face_aabb.expand_to(nodes.x[node2]);
+		face_aabb.expand_to(nodes.x[node2] + nodes.v[node2] * p_delta);
 
 		face_aabb.grow_by(collision_margin);
 
@@ -1217,6 +1265,7 @@ void GodotSoftBody3D::destroy() {
 	nodes.clear();
 	links.clear();
 	faces.clear();
+	link_color_offsets.clear();
 
 	bounds = AABB();
 	deinitialize_shape();
@@ -46,41 +46,67 @@ class GodotConstraint3D;
 class GodotSoftBody3D : public GodotCollisionObject3D {
 	RID soft_mesh;
 
-	struct Node {
-		Vector3 s; // Source position
-		Vector3 x; // Position
-		Vector3 q; // Previous step position/Test position
-		Vector3 f; // Force accumulator
-		Vector3 v; // Velocity
-		Vector3 bv; // Biased Velocity
-		Vector3 n; // Normal
-		real_t area = 0.0; // Area
-		real_t im = 0.0; // 1/mass
-		DynamicBVH::ID leaf; // Leaf data
-		uint32_t index = 0;
+	// Nodes and links are stored by field, so the solver goes through contiguous arrays.
+	struct Nodes {
+		LocalVector<Vector3> s; // Source position
+		LocalVector<Vector3> x; // Position
+		LocalVector<Vector3> q; // Previous step position/Test position
+		LocalVector<Vector3> f; // Force accumulator
+		LocalVector<Vector3> v; // Velocity
+		LocalVector<Vector3> bv; // Biased Velocity
+		LocalVector<Vector3> n; // Normal
+		LocalVector<real_t> area; // Area
+		LocalVector<real_t> im; // 1/mass
+		LocalVector<DynamicBVH::ID> leaf; // Leaf data
+
+		_FORCE_INLINE_ uint32_t size() const { return x.size(); }
+		_FORCE_INLINE_ bool is_empty() const { return x.is_empty(); }
+		void resize(uint32_t p_size);
+		void clear();
 	};
 
-	struct Link {
-		Vector3 c3; // gradient
-		Node *n[2] = { nullptr, nullptr }; // Node pointers
-		real_t rl = 0.0; // Rest length
-		real_t c0 = 0.0; // (ima+imb)*kLST
-		real_t c1 = 0.0; // rl^2
-		real_t c2 = 0.0; // |gradient|^2/c0
+	struct Links {
+		LocalVector<uint32_t> a; // First node
+		LocalVector<uint32_t> b; // Second node
+		LocalVector<real_t> rl; // Rest length
+		LocalVector<real_t> c0; // (ima+imb)*kLST
+		LocalVector<real_t> c1; // rl^2
+
+		_FORCE_INLINE_ uint32_t size() const { return a.size(); }
+		_FORCE_INLINE_ bool is_empty() const { return a.is_empty(); }
+		void resize(uint32_t p_size);
+		void clear();
 	};
 
 	struct Face {
 		Vector3 centroid;
-		Node *n[3] = { nullptr, nullptr, nullptr }; // Node pointers
+		uint32_t n[3] = { 0, 0, 0 }; // Node indices
 		Vector3 normal; // Normal
 		real_t ra = 0.0; // Rest area
 		DynamicBVH::ID leaf; // Leaf data
 		uint32_t index = 0;
 	};
 
-	LocalVector<Node> nodes;
-	LocalVector<Link> links;
+	// Links are sorted by color, and links of the same color don't share any node, so each color
+	// can be solved on several threads. The links of color i go from link_color_offsets[i] to
+	// link_color_offsets[i + 1]. Links which didn't fit in any color come last, and are solved on
+	// a single thread.
+	static constexpr uint32_t MAX_LINK_COLORS = 64;
+	// Soft bodies with fewer links are solved on a single thread.
+	static constexpr uint32_t PARALLEL_LINK_COUNT = 4096;
+	// Number of links of a color solved by each task.
+	static constexpr uint32_t LINK_BATCH_SIZE = 1024;
+
+	struct LinkSolve {
+		real_t kst = 0.0;
+		uint32_t begin = 0;
+		uint32_t end = 0;
+	};
+
+	Nodes nodes;
+	Links links;
 	LocalVector<Face> faces;
+	LocalVector<uint32_t> link_color_offsets;
 
 	DynamicBVH node_tree;
 	DynamicBVH face_tree;
@@ -110,6 +136,9 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 	VSet<RID> exceptions;
 
 	uint64_t island_step = 0;
+	int island_id = -1;
+
+	void _island_changed();
 
 	_FORCE_INLINE_ Vector3 _compute_area_windforce(const GodotArea3D *p_area, const Face *p_face);
 
@@ -121,10 +150,25 @@ public:
 	void set_state(PhysicsServer3D::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PhysicsServer3D::BodyState p_state) const;
 
-	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint) { constraints.insert(p_constraint); }
-	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) { constraints.erase(p_constraint); }
+	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint) {
+		constraints.insert(p_constraint);
+		if (island_id >= 0) {
+			_island_changed();
+		}
+	}
+	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) {
+		constraints.erase(p_constraint);
+		if (island_id >= 0) {
+			_island_changed();
+		}
+	}
 	_FORCE_INLINE_ const HashSet<GodotConstraint3D *> &get_constraints() const { return constraints; }
-	_FORCE_INLINE_ void clear_constraints() { constraints.clear(); }
+	_FORCE_INLINE_ void clear_constraints() {
+		constraints.clear();
+		if (island_id >= 0) {
+			_island_changed();
+		}
+	}
 
 	_FORCE_INLINE_ void add_exception(const RID &p_exception) { exceptions.insert(p_exception); }
 	_FORCE_INLINE_ void remove_exception(const RID &p_exception) { exceptions.erase(p_exception); }
@@ -134,6 +178,9 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
+	_FORCE_INLINE_ int get_island_id() const { return island_id; }
+	_FORCE_INLINE_ void set_island_id(int p_island_id) { island_id = p_island_id; }
+
 	_FORCE_INLINE_ void add_area(GodotArea3D *p_area) {
 		int index = areas.find(AreaCMP(p_area));
 		if (index > -1) {
@@ -202,9 +249,11 @@ public:
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
 	void predict_motion(real_t p_delta);
-	void solve_constraints(real_t p_delta);
+	// With p_parallel, links are solved on the WorkerThreadPool, so this must not be called from it.
+	void solve_constraints(real_t p_delta, bool p_parallel = false);
+	_FORCE_INLINE_ bool has_parallel_links() const { return links.size() >= PARALLEL_LINK_COUNT; }
 
-	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return static_cast<Node *>(p_node)->index; }
+	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return (uint32_t)(uintptr_t)p_node; }
 	_FORCE_INLINE_ uint32_t get_face_index(void *p_face) const { return static_cast<Face *>(p_face)->index; }
 
 	// Return true to stop the query.
@@ -233,11 +282,12 @@ private:
 
 	bool create_from_trimesh(const Vector<int> &p_indices, const Vector<Vector3> &p_vertices);
 	void generate_bending_constraints(int p_distance);
-	void reoptimize_link_order();
+	void color_links();
 	void append_link(uint32_t p_node1, uint32_t p_node2);
 	void append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3);
 
-	void solve_links(real_t kst, real_t ti);
+	void solve_links(real_t p_kst, uint32_t p_begin, uint32_t p_end);
+	void _solve_link_batch(uint32_t p_batch_index, LinkSolve *p_solve);
 
 	void initialize_face_tree();
 	void update_face_tree(real_t p_delta);
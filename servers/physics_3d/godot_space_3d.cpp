@@ -34,9 +34,11 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
+#define QUERY_BATCH_CHUNK_SIZE 64
 
 _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject3D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (!(p_object->get_collision_layer() & p_collision_mask)) {
@@ -58,64 +60,36 @@ _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject3D *p_object, u
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	ERR_FAIL_COND_V(space->locked, false);
-	int amount = space->broadphase->cull_point(p_parameters.position, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-	int cc = 0;
-
-	//Transform3D ai = p_xform.affine_inverse();
-
-	for (int i = 0; i < amount; i++) {
-		if (cc >= p_result_max) {
-			break;
-		}
-
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+// Removes the broadphase results a query can't collide with, keeping the others in order.
+static int _filter_query_results(GodotCollisionObject3D **r_objects, int *r_subindices, int p_amount, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray, const HashSet<RID> &p_exclude) {
+	int valid_amount = 0;
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(r_objects[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
 			continue;
 		}
 
-		//area can't be picked by ray (default)
-
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_pick_ray && !(r_objects[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
-
-		Transform3D inv_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
-		inv_xform.affine_invert();
-
-		if (!col_obj->get_shape(shape_idx)->intersect_point(inv_xform.xform(p_parameters.position))) {
+		if (p_exclude.has(r_objects[i]->get_self())) {
 			continue;
 		}
 
-		r_results[cc].collider_id = col_obj->get_instance_id();
-		if (r_results[cc].collider_id.is_valid()) {
-			r_results[cc].collider = ObjectDB::get_instance(r_results[cc].collider_id);
-		} else {
-			r_results[cc].collider = nullptr;
-		}
-		r_results[cc].rid = col_obj->get_self();
-		r_results[cc].shape = shape_idx;
-
-		cc++;
+		r_objects[valid_amount] = r_objects[i];
+		r_subindices[valid_amount] = r_subindices[i];
+		valid_amount++;
 	}
-
-	return cc;
+	return valid_amount;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
+static bool _intersect_ray_with_objects(const Vector3 &p_from, const Vector3 &p_to, bool p_hit_from_inside, bool p_hit_back_faces, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, PhysicsDirectSpaceState3D::RayResult &r_result) {
 	Vector3 begin, end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
 	bool collided = false;
@@ -125,22 +99,10 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
-			continue;
-		}
-
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
-			continue;
-		}
-
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
-			continue;
-		}
-
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+	for (int i = 0; i < p_amount; i++) {
+		const GodotCollisionObject3D *col_obj = p_objects[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_subindices[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -152,7 +114,7 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 		int shape_face_index = -1;
 
 		if (shape->intersect_point(local_from)) {
-			if (p_parameters.hit_from_inside) {
+			if (p_hit_from_inside) {
 				// Hit shape at starting point.
 				min_d = 0;
 				res_point = begin;
@@ -167,7 +129,7 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 			}
 		}
 
-		if (shape->intersect_segment(local_from, local_to, shape_point, shape_normal, shape_face_index, p_parameters.hit_back_faces)) {
+		if (shape->intersect_segment(local_from, local_to, shape_point, shape_normal, shape_face_index, p_hit_back_faces)) {
 			Transform3D xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 			shape_point = xform.xform(shape_point);
 
@@ -205,110 +167,45 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	if (p_result_max <= 0) {
-		return 0;
-	}
-
-	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, 0);
-
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
-
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
-	int cc = 0;
-
-	//Transform3D ai = p_xform.affine_inverse();
-
-	for (int i = 0; i < amount; i++) {
-		if (cc >= p_result_max) {
-			break;
-		}
-
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
-			continue;
-		}
-
-		//area can't be picked by ray (default)
-
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
-			continue;
-		}
-
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
-
-		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
-			continue;
-		}
-
-		if (r_results) {
-			r_results[cc].collider_id = col_obj->get_instance_id();
-			if (r_results[cc].collider_id.is_valid()) {
-				r_results[cc].collider = ObjectDB::get_instance(r_results[cc].collider_id);
-			} else {
-				r_results[cc].collider = nullptr;
-			}
-			r_results[cc].rid = col_obj->get_self();
-			r_results[cc].shape = shape_idx;
-		}
-
-		cc++;
-	}
-
-	return cc;
+static AABB _get_cast_motion_aabb(const GodotShape3D *p_shape, const Transform3D &p_transform, const Vector3 &p_motion, real_t p_margin) {
+	AABB aabb = p_transform.xform(p_shape->get_aabb());
+	aabb = aabb.merge(AABB(aabb.position + p_motion, aabb.size)); //motion
+	aabb = aabb.grow(p_margin);
+	return aabb;
 }
 
-bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
-	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, false);
-
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
-	aabb = aabb.merge(AABB(aabb.position + p_parameters.motion, aabb.size)); //motion
-	aabb = aabb.grow(p_parameters.margin);
-
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
+static void _cast_motion_with_objects(GodotShape3D *p_shape, const Transform3D &p_transform, const Vector3 &p_motion, const AABB &p_aabb, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, real_t &p_closest_safe, real_t &p_closest_unsafe, PhysicsDirectSpaceState3D::ShapeRestInfo *r_info) {
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
-	Transform3D xform_inv = p_parameters.transform.affine_inverse();
+	Transform3D xform_inv = p_transform.affine_inverse();
 	GodotMotionShape3D mshape;
-	mshape.shape = shape;
-	mshape.motion = xform_inv.basis.xform(p_parameters.motion);
+	mshape.shape = p_shape;
+	mshape.motion = xform_inv.basis.xform(p_motion);
 
 	bool best_first = true;
 
-	Vector3 motion_normal = p_parameters.motion.normalized();
+	Vector3 motion_normal = p_motion.normalized();
 
 	Vector3 closest_A, closest_B;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
-			continue;
-		}
-
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
-			continue; //ignore excluded
-		}
-
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+	for (int i = 0; i < p_amount; i++) {
+		const GodotCollisionObject3D *col_obj = p_objects[i];
+		int shape_idx = p_subindices[i];
 
 		Vector3 point_A, point_B;
 		Vector3 sep_axis = motion_normal;
 
 		Transform3D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, p_aabb, &sep_axis)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
 		sep_axis = motion_normal;
 
-		if (!GodotCollisionSolver3D::solve_distance(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (!GodotCollisionSolver3D::solve_distance(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, p_aabb, &sep_axis)) {
 			continue;
 		}
 
@@ -319,11 +216,11 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 		for (int j = 0; j < 8; j++) { //steps should be customizable..
 			real_t fraction = low + (hi - low) * fraction_coeff;
 
-			mshape.motion = xform_inv.basis.xform(p_parameters.motion * fraction);
+			mshape.motion = xform_inv.basis.xform(p_motion * fraction);
 
 			Vector3 lA, lB;
 			Vector3 sep = motion_normal; //important optimization for this to work fast enough
-			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
+			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, p_aabb, &sep);
 
 			if (collided) {
 				hi = fraction;
@@ -375,10 +272,338 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 
 	p_closest_safe = best_safe;
 	p_closest_unsafe = best_unsafe;
+}
+
+// Interleaves the lower 10 bits of p_value with two zero bits each.
+static _FORCE_INLINE_ uint64_t _spread_morton_bits(uint32_t p_value) {
+	uint64_t v = p_value & 0x3FF;
+	v = (v | (v << 16)) & 0x030000FF;
+	v = (v | (v << 8)) & 0x0300F00F;
+	v = (v | (v << 4)) & 0x030C30C3;
+	v = (v | (v << 2)) & 0x09249249;
+	return v;
+}
+
+static _FORCE_INLINE_ uint64_t _get_morton_code(const Vector3 &p_point, const AABB &p_bounds) {
+	uint64_t code = 0;
+	for (int i = 0; i < 3; i++) {
+		real_t t = p_bounds.size[i] > CMP_EPSILON ? (p_point[i] - p_bounds.position[i]) / p_bounds.size[i] : 0.0;
+		code |= _spread_morton_bits((uint32_t)CLAMP(t * 1023.0, 0.0, 1023.0)) << i;
+	}
+	return code;
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	ERR_FAIL_COND_V(space->locked, false);
+	int amount = space->broadphase->cull_point(p_parameters.position, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int cc = 0;
+
+	//Transform3D ai = p_xform.affine_inverse();
+
+	for (int i = 0; i < amount; i++) {
+		if (cc >= p_result_max) {
+			break;
+		}
+
+		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+			continue;
+		}
+
+		//area can't be picked by ray (default)
+
+		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+			continue;
+		}
+
+		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		int shape_idx = space->intersection_query_subindex_results[i];
+
+		Transform3D inv_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
+		inv_xform.affine_invert();
+
+		if (!col_obj->get_shape(shape_idx)->intersect_point(inv_xform.xform(p_parameters.position))) {
+			continue;
+		}
+
+		r_results[cc].collider_id = col_obj->get_instance_id();
+		if (r_results[cc].collider_id.is_valid()) {
+			r_results[cc].collider = ObjectDB::get_instance(r_results[cc].collider_id);
+		} else {
+			r_results[cc].collider = nullptr;
+		}
+		r_results[cc].rid = col_obj->get_self();
+		r_results[cc].shape = shape_idx;
+
+		cc++;
+	}
+
+	return cc;
+}
+
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	amount = _filter_query_results(space->intersection_query_results, space->intersection_query_subindex_results, amount, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.pick_ray, p_parameters.exclude);
+
+	return _intersect_ray_with_objects(p_parameters.from, p_parameters.to, p_parameters.hit_from_inside, p_parameters.hit_back_faces, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
+
+void GodotPhysicsDirectSpaceState3D::_build_query_batch(int p_count, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray, const HashSet<RID> &p_exclude) {
+	// Sort the queries along a Morton curve over the start and end of their bounds.
+	AABB bounds = batch_aabbs[0];
+	for (int i = 1; i < p_count; i++) {
+		bounds.merge_with(batch_aabbs[i]);
+	}
+
+	batch_queries.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		const AABB &aabb = batch_aabbs[i];
+		batch_queries[i].key = (_get_morton_code(aabb.position, bounds) << 30) | _get_morton_code(aabb.get_end(), bounds);
+		batch_queries[i].index = i;
+	}
+	batch_queries.sort();
+
+	// Cull each chunk of neighboring queries once.
+	batch_chunks.clear();
+	batch_objects.clear();
+	batch_subindices.clear();
+
+	for (uint32_t query_begin = 0; query_begin < (uint32_t)p_count; query_begin += QUERY_BATCH_CHUNK_SIZE) {
+		BatchChunk chunk;
+		chunk.query_begin = query_begin;
+		chunk.query_end = MIN(query_begin + QUERY_BATCH_CHUNK_SIZE, (uint32_t)p_count);
+
+		AABB chunk_aabb = batch_aabbs[batch_queries[chunk.query_begin].index];
+		for (uint32_t i = chunk.query_begin + 1; i < chunk.query_end; i++) {
+			chunk_aabb.merge_with(batch_aabbs[batch_queries[i].index]);
+		}
+
+		int amount = space->broadphase->cull_aabb(chunk_aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+		if (amount >= GodotSpace3D::INTERSECTION_QUERY_MAX) {
+			// Some candidates could be missing.
+			chunk.overflow = true;
+			amount = 0;
+		}
+		amount = _filter_query_results(space->intersection_query_results, space->intersection_query_subindex_results, amount, p_collision_mask, p_collide_with_bodies, p_collide_with_areas, p_pick_ray, p_exclude);
+
+		chunk.object_begin = batch_objects.size();
+		for (int i = 0; i < amount; i++) {
+			batch_objects.push_back(space->intersection_query_results[i]);
+			batch_subindices.push_back(space->intersection_query_subindex_results[i]);
+		}
+		chunk.object_end = batch_objects.size();
+
+		batch_chunks.push_back(chunk);
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_batch_chunk(uint32_t p_chunk_index, RayBatch *p_batch) {
+	const BatchChunk &chunk = batch_chunks[p_chunk_index];
+	if (chunk.overflow) {
+		return;
+	}
+
+	LocalVector<GodotCollisionObject3D *> objects;
+	LocalVector<int> subindices;
+	objects.reserve(chunk.object_end - chunk.object_begin);
+	subindices.reserve(chunk.object_end - chunk.object_begin);
+
+	for (uint32_t i = chunk.query_begin; i < chunk.query_end; i++) {
+		uint32_t query_index = batch_queries[i].index;
+		const Vector3 &from = p_batch->from[query_index];
+		const Vector3 &to = p_batch->to[query_index];
+
+		objects.clear();
+		subindices.clear();
+		for (uint32_t j = chunk.object_begin; j < chunk.object_end; j++) {
+			if (batch_objects[j]->get_shape_aabb(batch_subindices[j]).intersects_segment(from, to)) {
+				objects.push_back(batch_objects[j]);
+				subindices.push_back(batch_subindices[j]);
+			}
+		}
+
+		p_batch->hits[query_index] = _intersect_ray_with_objects(from, to, p_batch->parameters->hit_from_inside, p_batch->parameters->hit_back_faces, objects.ptr(), subindices.ptr(), objects.size(), p_batch->results[query_index]);
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+	if (p_count <= 0) {
+		return;
+	}
+
+	batch_aabbs.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		AABB aabb(p_from[i], Vector3());
+		aabb.expand_to(p_to[i]);
+		batch_aabbs[i] = aabb;
+	}
+
+	_build_query_batch(p_count, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.pick_ray, p_parameters.exclude);
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_batch_chunk, &batch, batch_chunks.size(), -1, true, SNAME("Physics3DRayBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Warning: This doesn't run on threads, because it uses the space's query buffers.
+	RayParameters parameters = p_parameters;
+	for (const BatchChunk &chunk : batch_chunks) {
+		if (!chunk.overflow) {
+			continue;
+		}
+		for (uint32_t i = chunk.query_begin; i < chunk.query_end; i++) {
+			uint32_t query_index = batch_queries[i].index;
+			parameters.from = p_from[query_index];
+			parameters.to = p_to[query_index];
+			r_hits[query_index] = intersect_ray(parameters, r_results[query_index]);
+		}
+	}
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, 0);
+
+	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	int cc = 0;
+
+	//Transform3D ai = p_xform.affine_inverse();
+
+	for (int i = 0; i < amount; i++) {
+		if (cc >= p_result_max) {
+			break;
+		}
+
+		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+			continue;
+		}
+
+		//area can't be picked by ray (default)
+
+		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+			continue;
+		}
+
+		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		int shape_idx = space->intersection_query_subindex_results[i];
+
+		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+			continue;
+		}
+
+		if (r_results) {
+			r_results[cc].collider_id = col_obj->get_instance_id();
+			if (r_results[cc].collider_id.is_valid()) {
+				r_results[cc].collider = ObjectDB::get_instance(r_results[cc].collider_id);
+			} else {
+				r_results[cc].collider = nullptr;
+			}
+			r_results[cc].rid = col_obj->get_self();
+			r_results[cc].shape = shape_idx;
+		}
+
+		cc++;
+	}
+
+	return cc;
+}
+
+bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	AABB aabb = _get_cast_motion_aabb(shape, p_parameters.transform, p_parameters.motion, p_parameters.margin);
+
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	amount = _filter_query_results(space->intersection_query_results, space->intersection_query_subindex_results, amount, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, false, p_parameters.exclude);
+
+	_cast_motion_with_objects(shape, p_parameters.transform, p_parameters.motion, aabb, space->intersection_query_results, space->intersection_query_subindex_results, amount, p_closest_safe, p_closest_unsafe, r_info);
 
 	return true;
 }
 
+void GodotPhysicsDirectSpaceState3D::_cast_motion_batch_chunk(uint32_t p_chunk_index, MotionBatch *p_batch) {
+	const BatchChunk &chunk = batch_chunks[p_chunk_index];
+	if (chunk.overflow) {
+		return;
+	}
+
+	LocalVector<GodotCollisionObject3D *> objects;
+	LocalVector<int> subindices;
+	objects.reserve(chunk.object_end - chunk.object_begin);
+	subindices.reserve(chunk.object_end - chunk.object_begin);
+
+	for (uint32_t i = chunk.query_begin; i < chunk.query_end; i++) {
+		uint32_t query_index = batch_queries[i].index;
+		const AABB &aabb = batch_aabbs[query_index];
+
+		objects.clear();
+		subindices.clear();
+		for (uint32_t j = chunk.object_begin; j < chunk.object_end; j++) {
+			if (batch_objects[j]->get_shape_aabb(batch_subindices[j]).intersects(aabb)) {
+				objects.push_back(batch_objects[j]);
+				subindices.push_back(batch_subindices[j]);
+			}
+		}
+
+		_cast_motion_with_objects(p_batch->shape, p_batch->transforms[query_index], p_batch->motions[query_index], aabb, objects.ptr(), subindices.ptr(), objects.size(), p_batch->closest_safe[query_index], p_batch->closest_unsafe[query_index], nullptr);
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::cast_motion_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	if (p_count <= 0) {
+		return;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	batch_aabbs.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		batch_aabbs[i] = _get_cast_motion_aabb(shape, p_transforms[i], p_motions[i], p_parameters.margin);
+	}
+
+	_build_query_batch(p_count, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, false, p_parameters.exclude);
+
+	MotionBatch batch;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.motions = p_motions;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_cast_motion_batch_chunk, &batch, batch_chunks.size(), -1, true, SNAME("Physics3DCastMotionBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Warning: This doesn't run on threads, because it uses the space's query buffers.
+	ShapeParameters parameters = p_parameters;
+	for (const BatchChunk &chunk : batch_chunks) {
+		if (!chunk.overflow) {
+			continue;
+		}
+		for (uint32_t i = chunk.query_begin; i < chunk.query_end; i++) {
+			uint32_t query_index = batch_queries[i].index;
+			parameters.transform = p_transforms[query_index];
+			parameters.motion = p_motions[query_index];
+			cast_motion(parameters, r_closest_safe[query_index], r_closest_unsafe[query_index]);
+		}
+	}
+}
+
 bool GodotPhysicsDirectSpaceState3D::collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) {
 	if (p_result_max <= 0) {
 		return false;
@@ -1160,6 +1385,54 @@ void GodotSpace3D::soft_body_remove_from_active_list(SelfList<GodotSoftBody3D> *
 	active_soft_body_list.remove(p_soft_body);
 }
 
+int GodotSpace3D::island_create() {
+	if (!free_islands.is_empty()) {
+		int island = free_islands[free_islands.size() - 1];
+		free_islands.resize(free_islands.size() - 1);
+		return island;
+	}
+	islands.push_back(Island());
+	return islands.size() - 1;
+}
+
+void GodotSpace3D::island_dissolve(int p_island) {
+	Island &island = islands[p_island];
+	for (GodotBody3D *body : island.bodies) {
+		body->set_island_id(-1);
+	}
+	for (GodotBody3D *body : island.kinematic_bodies) {
+		body->set_island_id(-1);
+	}
+	for (GodotSoftBody3D *soft_body : island.soft_bodies) {
+		soft_body->set_island_id(-1);
+	}
+
+	// Keep the memory around, the island is most likely generated again on the next step.
+	island.bodies.clear();
+	island.kinematic_bodies.clear();
+	island.soft_bodies.clear();
+	island.constraints.clear();
+	island.step = 0;
+
+	free_islands.push_back(p_island);
+}
+
+void GodotSpace3D::islands_clear() {
+	for (uint32_t i = 0; i < islands.size(); i++) {
+		for (GodotBody3D *body : islands[i].bodies) {
+			body->set_island_id(-1);
+		}
+		for (GodotBody3D *body : islands[i].kinematic_bodies) {
+			body->set_island_id(-1);
+		}
+		for (GodotSoftBody3D *soft_body : islands[i].soft_bodies) {
+			soft_body->set_island_id(-1);
+		}
+	}
+	islands.clear();
+	free_islands.clear();
+}
+
 void GodotSpace3D::call_queries() {
 	while (state_query_list.first()) {
 		GodotBody3D *b = state_query_list.first()->self();
@@ -1182,6 +1455,280 @@ void GodotSpace3D::setup() {
 	}
 }
 
+// Snapshots use the native byte order and real_t size, they are meant to be restored
+// by the same build (e.g. in rollback networking), not stored or sent across platforms.
+static const uint32_t SNAPSHOT_MAGIC = 0x50535347; // "GSSP"
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+template <typename T>
+static _FORCE_INLINE_ void _snapshot_write(LocalVector<uint8_t> &r_data, const T &p_value) {
+	GodotConstraint3D::state_write(r_data, p_value);
+}
+
+template <typename T>
+static _FORCE_INLINE_ bool _snapshot_read(const uint8_t *&r_data, const uint8_t *p_end, T &r_value) {
+	return GodotConstraint3D::state_read(r_data, p_end, r_value);
+}
+
+static _FORCE_INLINE_ void _snapshot_patch(LocalVector<uint8_t> &r_data, uint32_t p_offset, uint32_t p_value) {
+	memcpy(r_data.ptr() + p_offset, &p_value, sizeof(uint32_t));
+}
+
+void GodotSpace3D::_gather_snapshot_constraints() {
+	// Each constraint is referenced by all of its bodies, list it only once but keep the
+	// order in which the bodies reference them, so it's the same for equal spaces.
+	// Constraints which can't be found again by key (e.g. area pairs) are left out.
+	snapshot_constraint_list.clear();
+	snapshot_constraint_indices.clear();
+	for (GodotCollisionObject3D *E : objects) {
+		if (E->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		for (const KeyValue<GodotConstraint3D *, int> &F : static_cast<GodotBody3D *>(E)->get_constraint_map()) {
+			if (!snapshot_constraint_indices.has(F.key) && F.key->get_state_key().object_A != 0) {
+				snapshot_constraint_indices.insert(F.key, snapshot_constraint_list.size());
+				snapshot_constraint_list.push_back(F.key);
+			}
+		}
+	}
+}
+
+void GodotSpace3D::_restore_snapshot_constraint_order(GodotBody3D *p_body, const SnapshotBody &p_snapshot) {
+	// Islands are built, and so constraints are solved, in the order bodies reference them.
+	// Pairs removed and created again since the snapshot was saved would be solved in a
+	// different order otherwise, so the results wouldn't match when simulating again.
+	snapshot_constraint_order.clear();
+	bool sorted = true;
+	for (const KeyValue<GodotConstraint3D *, int> &F : p_body->get_constraint_map()) {
+		SnapshotConstraintOrder order;
+		order.constraint = F.key;
+		order.position = F.value;
+		// Constraints that weren't in the snapshot go last, in their current order.
+		order.rank = p_snapshot.constraint_count + snapshot_constraint_order.size();
+
+		const SnapshotConstraint *constraint = snapshot_constraints.getptr(F.key->get_state_key());
+		if (constraint) {
+			for (uint32_t i = 0; i < p_snapshot.constraint_count; i++) {
+				if (snapshot_body_constraints[p_snapshot.constraints_from + i] == constraint->index) {
+					order.rank = i;
+					break;
+				}
+			}
+		}
+
+		if (!snapshot_constraint_order.is_empty() && order.rank < snapshot_constraint_order[snapshot_constraint_order.size() - 1].rank) {
+			sorted = false;
+		}
+		snapshot_constraint_order.push_back(order);
+	}
+
+	if (sorted) {
+		return;
+	}
+
+	snapshot_constraint_order.sort();
+	p_body->clear_constraint_map();
+	for (const SnapshotConstraintOrder &E : snapshot_constraint_order) {
+		p_body->add_constraint(E.constraint, E.position);
+	}
+}
+
+Vector<uint8_t> GodotSpace3D::save_snapshot() {
+	snapshot_data.clear();
+	_snapshot_write(snapshot_data, SNAPSHOT_MAGIC);
+	_snapshot_write(snapshot_data, SNAPSHOT_VERSION);
+	_snapshot_write(snapshot_data, (uint32_t)sizeof(real_t));
+
+	_gather_snapshot_constraints();
+	_snapshot_write(snapshot_data, (uint32_t)snapshot_constraint_list.size());
+	for (const GodotConstraint3D *constraint : snapshot_constraint_list) {
+		GodotConstraint3D::StateKey key = constraint->get_state_key();
+		_snapshot_write(snapshot_data, key.object_A);
+		_snapshot_write(snapshot_data, key.object_B);
+		_snapshot_write(snapshot_data, key.shape_A);
+		_snapshot_write(snapshot_data, key.shape_B);
+
+		uint32_t size_offset = snapshot_data.size();
+		_snapshot_write(snapshot_data, (uint32_t)0);
+		constraint->save_state(snapshot_data);
+		_snapshot_patch(snapshot_data, size_offset, snapshot_data.size() - size_offset - sizeof(uint32_t));
+	}
+
+	uint32_t count_offset = snapshot_data.size();
+	uint32_t count = 0;
+	_snapshot_write(snapshot_data, count);
+
+	GodotBody3D::SnapshotState state;
+	for (GodotCollisionObject3D *E : objects) {
+		if (E->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		GodotBody3D *body = static_cast<GodotBody3D *>(E);
+		body->get_snapshot_state(state);
+		_snapshot_write(snapshot_data, body->get_self().get_id());
+		_snapshot_write(snapshot_data, state.transform);
+		_snapshot_write(snapshot_data, state.new_transform);
+		_snapshot_write(snapshot_data, state.linear_velocity);
+		_snapshot_write(snapshot_data, state.angular_velocity);
+		_snapshot_write(snapshot_data, state.prev_linear_velocity);
+		_snapshot_write(snapshot_data, state.prev_angular_velocity);
+		_snapshot_write(snapshot_data, state.applied_force);
+		_snapshot_write(snapshot_data, state.applied_torque);
+		_snapshot_write(snapshot_data, state.still_time);
+		_snapshot_write(snapshot_data, state.first_time_kinematic);
+
+		uint32_t constraint_count_offset = snapshot_data.size();
+		uint32_t constraint_count = 0;
+		_snapshot_write(snapshot_data, constraint_count);
+		for (const KeyValue<GodotConstraint3D *, int> &F : body->get_constraint_map()) {
+			const uint32_t *index = snapshot_constraint_indices.getptr(F.key);
+			if (index) {
+				_snapshot_write(snapshot_data, *index);
+				constraint_count++;
+			}
+		}
+		_snapshot_patch(snapshot_data, constraint_count_offset, constraint_count);
+		count++;
+	}
+	_snapshot_patch(snapshot_data, count_offset, count);
+
+	// The active list decides in which order bodies are integrated and islands are built,
+	// so it's stored in order instead of as a flag on each body.
+	count_offset = snapshot_data.size();
+	count = 0;
+	_snapshot_write(snapshot_data, count);
+	for (const SelfList<GodotBody3D> *E = active_list.first(); E; E = E->next()) {
+		_snapshot_write(snapshot_data, E->self()->get_self().get_id());
+		count++;
+	}
+	_snapshot_patch(snapshot_data, count_offset, count);
+
+	// The order of the constraints in the kept islands depends on how they were generated in
+	// earlier steps, so they're generated again from the saved state, the same as after a restore.
+	islands_clear();
+
+	Vector<uint8_t> snapshot;
+	snapshot.resize(snapshot_data.size());
+	memcpy(snapshot.ptrw(), snapshot_data.ptr(), snapshot_data.size());
+	return snapshot;
+}
+
+Error GodotSpace3D::restore_snapshot(const uint8_t *p_data, int p_size) {
+	ERR_FAIL_COND_V(locked, ERR_LOCKED);
+
+	const uint8_t *r = p_data;
+	const uint8_t *end = p_data + p_size;
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t real_size = 0;
+	ERR_FAIL_COND_V_MSG(!_snapshot_read(r, end, magic) || magic != SNAPSHOT_MAGIC, ERR_FILE_UNRECOGNIZED, "Invalid physics space snapshot.");
+	ERR_FAIL_COND_V_MSG(!_snapshot_read(r, end, version) || version != SNAPSHOT_VERSION || !_snapshot_read(r, end, real_size) || real_size != sizeof(real_t), ERR_FILE_UNRECOGNIZED, "Physics space snapshot was saved by an incompatible build.");
+
+	// Read everything first, so a corrupt snapshot leaves the space untouched.
+	uint32_t count = 0;
+	bool valid = _snapshot_read(r, end, count);
+	snapshot_constraints.clear();
+	for (uint32_t i = 0; valid && i < count; i++) {
+		GodotConstraint3D::StateKey key;
+		SnapshotConstraint constraint;
+		constraint.index = i;
+		valid = _snapshot_read(r, end, key.object_A) &&
+				_snapshot_read(r, end, key.object_B) &&
+				_snapshot_read(r, end, key.shape_A) &&
+				_snapshot_read(r, end, key.shape_B) &&
+				_snapshot_read(r, end, constraint.size) &&
+				constraint.size <= (uint32_t)(end - r);
+		if (valid) {
+			constraint.data = r;
+			r += constraint.size;
+			snapshot_constraints.insert(key, constraint);
+		}
+	}
+	ERR_FAIL_COND_V(!valid, ERR_FILE_CORRUPT);
+
+	ERR_FAIL_COND_V(!_snapshot_read(r, end, count) || count > (end - r) / sizeof(uint64_t), ERR_FILE_CORRUPT);
+	snapshot_bodies.resize(count);
+	snapshot_body_constraints.clear();
+	for (uint32_t i = 0; valid && i < count; i++) {
+		SnapshotBody &body = snapshot_bodies[i];
+		valid = _snapshot_read(r, end, body.id) &&
+				_snapshot_read(r, end, body.state.transform) &&
+				_snapshot_read(r, end, body.state.new_transform) &&
+				_snapshot_read(r, end, body.state.linear_velocity) &&
+				_snapshot_read(r, end, body.state.angular_velocity) &&
+				_snapshot_read(r, end, body.state.prev_linear_velocity) &&
+				_snapshot_read(r, end, body.state.prev_angular_velocity) &&
+				_snapshot_read(r, end, body.state.applied_force) &&
+				_snapshot_read(r, end, body.state.applied_torque) &&
+				_snapshot_read(r, end, body.state.still_time) &&
+				_snapshot_read(r, end, body.state.first_time_kinematic) &&
+				_snapshot_read(r, end, body.constraint_count) &&
+				body.constraint_count <= (end - r) / sizeof(uint32_t);
+		if (valid) {
+			body.constraints_from = snapshot_body_constraints.size();
+			snapshot_body_constraints.resize(body.constraints_from + body.constraint_count);
+			for (uint32_t j = 0; j < body.constraint_count; j++) {
+				_snapshot_read(r, end, snapshot_body_constraints[body.constraints_from + j]);
+			}
+		}
+	}
+	ERR_FAIL_COND_V(!valid, ERR_FILE_CORRUPT);
+
+	ERR_FAIL_COND_V(!_snapshot_read(r, end, count) || count != (end - r) / sizeof(uint64_t) || (end - r) % sizeof(uint64_t) != 0, ERR_FILE_CORRUPT);
+	snapshot_active_bodies.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		_snapshot_read(r, end, snapshot_active_bodies[i]);
+	}
+
+	snapshot_body_map.clear();
+	for (GodotCollisionObject3D *E : objects) {
+		if (E->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			snapshot_body_map.insert(E->get_self().get_id(), static_cast<GodotBody3D *>(E));
+		}
+	}
+
+	// Bodies created after the snapshot was saved are left as they are, and the ones
+	// removed since then are skipped.
+	for (const SnapshotBody &E : snapshot_bodies) {
+		GodotBody3D **body = snapshot_body_map.getptr(E.id);
+		if (body) {
+			(*body)->set_active(false);
+			(*body)->set_snapshot_state(E.state);
+		}
+	}
+	for (uint64_t id : snapshot_active_bodies) {
+		GodotBody3D **body = snapshot_body_map.getptr(id);
+		if (body) {
+			(*body)->set_active(true);
+		}
+	}
+
+	// Create the pairs for the restored transforms right away, so their contacts can be restored as well.
+	update();
+
+	_gather_snapshot_constraints();
+	for (GodotConstraint3D *constraint : snapshot_constraint_list) {
+		const SnapshotConstraint *E = snapshot_constraints.getptr(constraint->get_state_key());
+		if (!E) {
+			constraint->reset_state();
+			continue;
+		}
+		ERR_CONTINUE_MSG(!constraint->load_state(E->data, E->size), "Invalid constraint state in physics space snapshot.");
+	}
+
+	for (const SnapshotBody &E : snapshot_bodies) {
+		GodotBody3D **body = snapshot_body_map.getptr(E.id);
+		if (body) {
+			_restore_snapshot_constraint_order(*body, E);
+		}
+	}
+
+	islands_clear();
+
+	return OK;
+}
+
 void GodotSpace3D::update() {
 	broadphase->update();
 }
@@ -1253,6 +1800,67 @@ GodotPhysicsDirectSpaceState3D *GodotSpace3D::get_direct_state() {
 	return direct_access;
 }
 
+const char *GodotSpace3D::get_elapsed_time_name(ElapsedTime p_time) {
+	static const char *time_name[ELAPSED_TIME_MAX] = {
+		"integrate_forces",
+		"broadphase",
+		"generate_islands",
+		"setup_constraints",
+		"solve_constraints",
+		"integrate_velocities"
+	};
+	return time_name[p_time];
+}
+
+void GodotSpace3D::set_profiling(bool p_enable) {
+	profiling = p_enable;
+	profile.clear();
+}
+
+Dictionary GodotSpace3D::get_profile_info() const {
+	Dictionary info;
+
+	Dictionary phase_times;
+	uint64_t step_time = 0;
+	for (int i = 0; i < ELAPSED_TIME_MAX; i++) {
+		phase_times[get_elapsed_time_name(ElapsedTime(i))] = USEC_TO_SEC(elapsed_time[i]);
+		step_time += elapsed_time[i];
+	}
+	info["phase_times"] = phase_times;
+	info["step_time"] = USEC_TO_SEC(step_time);
+	info["active_objects"] = active_objects;
+	info["collision_pairs"] = collision_pairs;
+	info["island_count"] = island_count;
+	info["constraint_count"] = step_constraint_count;
+	info["solver_iterations"] = solver_iterations;
+
+	if (!profiling) {
+		return info;
+	}
+
+	info["rigid_bodies"] = profile.rigid_bodies;
+	info["sleeping_bodies"] = profile.sleeping_bodies;
+
+	PackedInt32Array island_sizes;
+	island_sizes.resize(Profile::ISLAND_SIZE_BUCKETS);
+	for (int i = 0; i < Profile::ISLAND_SIZE_BUCKETS; i++) {
+		island_sizes.write[i] = profile.island_sizes[i];
+	}
+	info["island_sizes"] = island_sizes;
+
+	Dictionary pair_tests;
+	for (int i = 0; i < Profile::SHAPE_TYPE_COUNT; i++) {
+		for (int j = i; j < Profile::SHAPE_TYPE_COUNT; j++) {
+			if (profile.pair_tests[i][j] > 0) {
+				pair_tests[Vector2i(i, j)] = profile.pair_tests[i][j];
+			}
+		}
+	}
+	info["pair_tests"] = pair_tests;
+
+	return info;
+}
+
 GodotSpace3D::GodotSpace3D() {
 	body_linear_velocity_sleep_threshold = GLOBAL_GET("physics/3d/sleep_threshold_linear");
 	body_angular_velocity_sleep_threshold = GLOBAL_GET("physics/3d/sleep_threshold_angular");
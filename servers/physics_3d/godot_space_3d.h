@@ -41,18 +41,67 @@
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	// Batched queries are sorted so that nearby queries end up in the same chunk. Each chunk
+	// is culled once against the broadphase, then its queries run on the WorkerThreadPool
+	// against the chunk's candidates only.
+	struct BatchQuery {
+		uint64_t key = 0;
+		uint32_t index = 0;
+
+		bool operator<(const BatchQuery &p_other) const {
+			return key == p_other.key ? index < p_other.index : key < p_other.key;
+		}
+	};
+
+	struct BatchChunk {
+		uint32_t query_begin = 0;
+		uint32_t query_end = 0;
+		uint32_t object_begin = 0;
+		uint32_t object_end = 0;
+		bool overflow = false; // Too many candidates, queries are run one by one instead.
+	};
+
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		RayResult *results = nullptr;
+		bool *hits = nullptr;
+	};
+
+	struct MotionBatch {
+		GodotShape3D *shape = nullptr;
+		const Transform3D *transforms = nullptr;
+		const Vector3 *motions = nullptr;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+	};
+
+	LocalVector<BatchQuery> batch_queries;
+	LocalVector<BatchChunk> batch_chunks;
+	LocalVector<AABB> batch_aabbs;
+	LocalVector<GodotCollisionObject3D *> batch_objects;
+	LocalVector<int> batch_subindices;
+
+	void _build_query_batch(int p_count, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray, const HashSet<RID> &p_exclude);
+	void _intersect_ray_batch_chunk(uint32_t p_chunk_index, RayBatch *p_batch);
+	void _cast_motion_batch_chunk(uint32_t p_chunk_index, MotionBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual void intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
+	virtual void cast_motion_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
@@ -62,8 +111,19 @@ public:
 
 class GodotSpace3D {
 public:
+	// Islands are kept between steps. Adding or removing a constraint, or changing the mode of a
+	// body, dissolves the islands it touches, which are then generated again on the next step.
+	struct Island {
+		LocalVector<GodotBody3D *> bodies; // Rigid bodies, tested for sleeping.
+		LocalVector<GodotBody3D *> kinematic_bodies;
+		LocalVector<GodotSoftBody3D *> soft_bodies;
+		LocalVector<GodotConstraint3D *> constraints;
+		uint64_t step = 0;
+	};
+
 	enum ElapsedTime {
 		ELAPSED_TIME_INTEGRATE_FORCES,
+		ELAPSED_TIME_BROADPHASE,
 		ELAPSED_TIME_GENERATE_ISLANDS,
 		ELAPSED_TIME_SETUP_CONSTRAINTS,
 		ELAPSED_TIME_SOLVE_CONSTRAINTS,
@@ -72,9 +132,27 @@ public:
 
 	};
 
+	// Detailed counters of the last step, only gathered while profiling is enabled for the space.
+	struct Profile {
+		enum {
+			ISLAND_SIZE_BUCKETS = 16, // Powers of two, the last bucket also counts all larger islands.
+			SHAPE_TYPE_COUNT = PhysicsServer3D::SHAPE_CUSTOM + 1,
+		};
+
+		uint32_t pair_tests[SHAPE_TYPE_COUNT][SHAPE_TYPE_COUNT] = {};
+		uint32_t island_sizes[ISLAND_SIZE_BUCKETS] = {};
+		int rigid_bodies = 0;
+		int sleeping_bodies = 0;
+
+		void clear() { *this = Profile(); }
+	};
+
 private:
 	uint64_t elapsed_time[ELAPSED_TIME_MAX] = {};
 
+	bool profiling = false;
+	Profile profile;
+
 	GodotPhysicsDirectSpaceState3D *direct_access = nullptr;
 	RID self;
 
@@ -115,15 +193,54 @@ private:
 
 	real_t last_step = 0.001;
 
+	LocalVector<Island> islands;
+	LocalVector<int> free_islands;
+
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int step_constraint_count = 0;
 
 	RID static_global_body;
 
 	Vector<Vector3> contact_debug;
 	int contact_debug_count = 0;
 
+	struct SnapshotBody {
+		uint64_t id = 0;
+		GodotBody3D::SnapshotState state;
+		uint32_t constraints_from = 0;
+		uint32_t constraint_count = 0;
+	};
+
+	struct SnapshotConstraint {
+		uint32_t index = 0;
+		const uint8_t *data = nullptr;
+		uint32_t size = 0;
+	};
+
+	struct SnapshotConstraintOrder {
+		uint32_t rank = 0;
+		GodotConstraint3D *constraint = nullptr;
+		int position = 0;
+
+		bool operator<(const SnapshotConstraintOrder &p_other) const { return rank < p_other.rank; }
+	};
+
+	// Kept around, so saving or restoring a snapshot every frame doesn't allocate once warmed up.
+	LocalVector<uint8_t> snapshot_data;
+	LocalVector<SnapshotBody> snapshot_bodies;
+	LocalVector<uint32_t> snapshot_body_constraints;
+	LocalVector<uint64_t> snapshot_active_bodies;
+	HashMap<GodotConstraint3D::StateKey, SnapshotConstraint, GodotConstraint3D::StateKey> snapshot_constraints;
+	HashMap<uint64_t, GodotBody3D *> snapshot_body_map;
+	HashMap<GodotConstraint3D *, uint32_t> snapshot_constraint_indices;
+	LocalVector<GodotConstraint3D *> snapshot_constraint_list;
+	LocalVector<SnapshotConstraintOrder> snapshot_constraint_order;
+
+	void _gather_snapshot_constraints();
+	void _restore_snapshot_constraint_order(GodotBody3D *p_body, const SnapshotBody &p_snapshot);
+
 	friend class GodotPhysicsDirectSpaceState3D;
 
 	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb);
@@ -183,6 +300,11 @@ public:
 	void set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_value);
 	real_t get_param(PhysicsServer3D::SpaceParameter p_param) const;
 
+	int island_create();
+	void island_dissolve(int p_island);
+	void islands_clear();
+	_FORCE_INLINE_ Island &get_island(int p_island) { return islands[p_island]; }
+
 	void set_island_count(int p_island_count) { island_count = p_island_count; }
 	int get_island_count() const { return island_count; }
 
@@ -191,6 +313,9 @@ public:
 
 	int get_collision_pairs() const { return collision_pairs; }
 
+	void set_constraint_count(int p_constraint_count) { step_constraint_count = p_constraint_count; }
+	int get_constraint_count() const { return step_constraint_count; }
+
 	GodotPhysicsDirectSpaceState3D *get_direct_state();
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
@@ -208,6 +333,17 @@ public:
 
 	void set_elapsed_time(ElapsedTime p_time, uint64_t p_msec) { elapsed_time[p_time] = p_msec; }
 	uint64_t get_elapsed_time(ElapsedTime p_time) const { return elapsed_time[p_time]; }
+	static const char *get_elapsed_time_name(ElapsedTime p_time);
+
+	void set_profiling(bool p_enable);
+	_FORCE_INLINE_ bool is_profiling() const { return profiling; }
+	_FORCE_INLINE_ Profile &get_profile() { return profile; }
+	Dictionary get_profile_info() const;
+
+	// Snapshots hold the dynamic state of the bodies in the space and the solver state of their
+	// constraints, so a previous frame can be restored and simulated again (e.g. for rollback).
+	Vector<uint8_t> save_snapshot();
+	Error restore_snapshot(const uint8_t *p_data, int p_size);
 
 	bool test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result);
 
@@ -38,26 +38,49 @@
 #define BODY_ISLAND_COUNT_RESERVE 128
 #define BODY_ISLAND_SIZE_RESERVE 512
 #define ISLAND_COUNT_RESERVE 128
-#define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
-void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
+bool GodotStep3D::_is_constraint_visited(const GodotConstraint3D *p_constraint, const GodotCollisionObject3D *p_object) const {
+	// A constraint is added to the island by the first of its bodies to be visited,
+	// the others are marked by then.
+	for (int i = 0; i < p_constraint->get_body_count(); i++) {
+		const GodotBody3D *body = p_constraint->get_body_ptr()[i];
+		if (body != p_object && body->get_island_step() == _step) {
+			return true;
+		}
+	}
+	for (int i = 0; i < p_constraint->get_soft_body_count(); i++) {
+		const GodotSoftBody3D *soft_body = p_constraint->get_soft_body_ptr(i);
+		if (soft_body != p_object && soft_body->get_island_step() == _step) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void GodotStep3D::_populate_island(GodotSpace3D *p_space, GodotBody3D *p_body, int p_island) {
+	if (p_body->get_island_id() >= 0) {
+		// The body was part of an island which got connected to this one.
+		p_space->island_dissolve(p_body->get_island_id());
+	}
+
 	p_body->set_island_step(_step);
+	p_body->set_island_id(p_island);
 
+	GodotSpace3D::Island &island = p_space->get_island(p_island);
 	if (p_body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
 		// Only rigid bodies are tested for activation.
-		p_body_island.push_back(p_body);
+		island.bodies.push_back(p_body);
+	} else {
+		island.kinematic_bodies.push_back(p_body);
 	}
 
 	for (const KeyValue<GodotConstraint3D *, int> &E : p_body->get_constraint_map()) {
 		GodotConstraint3D *constraint = const_cast<GodotConstraint3D *>(E.key);
-		if (constraint->get_island_step() == _step) {
+		if (_is_constraint_visited(constraint, p_body)) {
 			continue; // Already processed.
 		}
-		constraint->set_island_step(_step);
-		p_constraint_island.push_back(constraint);
-
-		all_constraints.push_back(constraint);
+		island.constraints.push_back(constraint);
 
 		// Find connected rigid bodies.
 		for (int i = 0; i < constraint->get_body_count(); i++) {
@@ -71,7 +94,10 @@ void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D
 			if (other_body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
 				continue; // Static bodies don't connect islands.
 			}
-			_populate_island(other_body, p_body_island, p_constraint_island);
+			if (other_body->get_space() != p_space) {
+				continue; // Islands only hold bodies from their own space.
+			}
+			_populate_island(p_space, other_body, p_island);
 		}
 
 		// Find connected soft bodies.
@@ -80,23 +106,32 @@ void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D
 			if (soft_body->get_island_step() == _step) {
 				continue; // Already processed.
 			}
-			_populate_island_soft_body(soft_body, p_body_island, p_constraint_island);
+			if (soft_body->get_space() != p_space) {
+				continue; // Islands only hold bodies from their own space.
+			}
+			_populate_island_soft_body(p_space, soft_body, p_island);
 		}
 	}
 }
 
-void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
+void GodotStep3D::_populate_island_soft_body(GodotSpace3D *p_space, GodotSoftBody3D *p_soft_body, int p_island) {
+	if (p_soft_body->get_island_id() >= 0) {
+		// The soft body was part of an island which got connected to this one.
+		p_space->island_dissolve(p_soft_body->get_island_id());
+	}
+
 	p_soft_body->set_island_step(_step);
+	p_soft_body->set_island_id(p_island);
+
+	GodotSpace3D::Island &island = p_space->get_island(p_island);
+	island.soft_bodies.push_back(p_soft_body);
 
 	for (const GodotConstraint3D *E : p_soft_body->get_constraints()) {
 		GodotConstraint3D *constraint = const_cast<GodotConstraint3D *>(E);
-		if (constraint->get_island_step() == _step) {
+		if (_is_constraint_visited(constraint, p_soft_body)) {
 			continue; // Already processed.
 		}
-		constraint->set_island_step(_step);
-		p_constraint_island.push_back(constraint);
-
-		all_constraints.push_back(constraint);
+		island.constraints.push_back(constraint);
 
 		// Find connected rigid bodies.
 		for (int i = 0; i < constraint->get_body_count(); i++) {
@@ -107,11 +142,75 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 			if (body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
 				continue; // Static bodies don't connect islands.
 			}
-			_populate_island(body, p_body_island, p_constraint_island);
+			if (body->get_space() != p_space) {
+				continue; // Islands only hold bodies from their own space.
+			}
+			_populate_island(p_space, body, p_island);
+		}
+	}
+}
+
+void GodotStep3D::_add_island(GodotSpace3D *p_space, int p_island, uint32_t &r_island_count, uint32_t &r_body_island_count) {
+	GodotSpace3D::Island &island = p_space->get_island(p_island);
+	if (island.step == _step) {
+		return; // Already added.
+	}
+	island.step = _step;
+
+	if (!island.bodies.is_empty()) {
+		++r_body_island_count;
+		if (body_islands.size() < r_body_island_count) {
+			body_islands.resize(r_body_island_count);
+		}
+		LocalVector<GodotBody3D *> &body_island = body_islands[r_body_island_count - 1];
+		body_island.clear();
+		body_island.reserve(island.bodies.size());
+		for (GodotBody3D *body : island.bodies) {
+			body_island.push_back(body);
+		}
+	}
+
+	++r_island_count;
+	if (constraint_islands.size() < r_island_count) {
+		constraint_islands.resize(r_island_count);
+	}
+	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[r_island_count - 1];
+	constraint_island.clear();
+	constraint_island.reserve(island.constraints.size());
+	for (GodotConstraint3D *constraint : island.constraints) {
+		if (constraint->get_island_step() == _step) {
+			continue; // Already processed with a moving area.
 		}
+		constraint->set_island_step(_step);
+		constraint_island.push_back(constraint);
+
+		all_constraints.push_back(constraint);
+	}
+
+	if (constraint_island.is_empty()) {
+		--r_island_count;
 	}
 }
 
+void GodotStep3D::_fill_active_bodies(const SelfList<GodotBody3D>::List &p_body_list) {
+	active_bodies.clear();
+	for (const SelfList<GodotBody3D> *b = p_body_list.first(); b; b = b->next()) {
+		active_bodies.push_back(b->self());
+	}
+}
+
+void GodotStep3D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep3D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
+void GodotStep3D::_solve_soft_body_constraints(uint32_t p_soft_body_index, void *p_userdata) {
+	small_soft_bodies[p_soft_body_index]->solve_constraints(delta);
+}
+
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -158,26 +257,33 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
-void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
+void GodotStep3D::_test_island_sleep(uint32_t p_island_index, void *p_userdata) {
+	const LocalVector<GodotBody3D *> &body_island = body_islands[p_island_index];
+
 	bool can_sleep = true;
 
-	uint32_t body_count = p_body_island.size();
+	uint32_t body_count = body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody3D *body = p_body_island[body_index];
+		GodotBody3D *body = body_island[body_index];
 
 		if (!body->sleep_test(delta)) {
 			can_sleep = false;
 		}
 	}
 
+	body_island_can_sleep[p_island_index] = can_sleep;
+}
+
+void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island, bool p_can_sleep) const {
 	// Put all to sleep or wake up everyone.
+	uint32_t body_count = p_body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
 		GodotBody3D *body = p_body_island[body_index];
 
 		bool active = body->is_active();
 
-		if (active == can_sleep) {
-			body->set_active(!can_sleep);
+		if (active == p_can_sleep) {
+			body->set_active(!p_can_sleep);
 		}
 	}
 }
@@ -201,32 +307,44 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_fill_active_bodies(*body_list);
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
+	}
+
+	/* UPDATE BROADPHASE */
 
-	const SelfList<GodotBody3D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	// Moving shapes in the broadphase isn't thread-safe, so it's done afterwards in list order.
+	for (GodotBody3D *body : active_bodies) {
+		body->update_broadphase();
 	}
 
 	/* UPDATE SOFT BODY MOTION */
 
+	// Warning: This doesn't run on threads, because updating the soft body bounds can add
+	// or move its shape in the broadphase.
+	active_soft_bodies.clear();
 	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
 	while (sb) {
+		active_soft_bodies.push_back(sb->self());
 		sb->self()->predict_motion(p_delta);
 		sb = sb->next();
-		active_count++;
 	}
 
-	p_space->set_active_objects(active_count);
+	p_space->set_active_objects((int)(active_bodies.size() + active_soft_bodies.size()));
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_BROADPHASE, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -258,83 +376,45 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		p_space->area_remove_from_moved_list((SelfList<GodotArea3D> *)aml.first()); //faster to remove here
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
-
-	b = body_list->first();
-
-	uint32_t body_island_count = 0;
-
-	while (b) {
-		GodotBody3D *body = b->self();
-
-		if (body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
-
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island(body, body_island, constraint_island);
+	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID AND SOFT BODIES */
 
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
-
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
+	// Islands are kept between steps, only the bodies which lost theirs need to be visited again.
+	// Islands are built before any is added, so one merged into a new island is never added twice.
+	for (GodotBody3D *body : active_bodies) {
+		if (body->get_island_id() < 0) {
+			_populate_island(p_space, body, p_space->island_create());
+		}
+	}
+	for (GodotSoftBody3D *soft_body : active_soft_bodies) {
+		if (soft_body->get_island_id() < 0) {
+			_populate_island_soft_body(p_space, soft_body, p_space->island_create());
 		}
-		b = b->next();
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
-
-	sb = soft_body_list->first();
-	while (sb) {
-		GodotSoftBody3D *soft_body = sb->self();
-
-		if (soft_body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
-
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island_soft_body(soft_body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
+	// Islands where all bodies are sleeping aren't visited at all.
+	uint32_t body_island_count = 0;
+	for (GodotBody3D *body : active_bodies) {
+		_add_island(p_space, body->get_island_id(), island_count, body_island_count);
+	}
+	for (GodotSoftBody3D *soft_body : active_soft_bodies) {
+		_add_island(p_space, soft_body->get_island_id(), island_count, body_island_count);
+	}
 
-			if (constraint_island.is_empty()) {
-				--island_count;
+	p_space->set_island_count((int)island_count);
+	p_space->set_constraint_count((int)all_constraints.size());
+
+	if (p_space->is_profiling()) {
+		GodotSpace3D::Profile &profile = p_space->get_profile();
+		profile.clear();
+		for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
+			uint32_t bucket = 0;
+			while ((body_islands[island_index].size() >> (bucket + 1)) > 0 && bucket < GodotSpace3D::Profile::ISLAND_SIZE_BUCKETS - 1) {
+				++bucket;
 			}
+			++profile.island_sizes[bucket];
 		}
-		sb = sb->next();
 	}
 
-	p_space->set_island_count((int)island_count);
-
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_GENERATE_ISLANDS, profile_endtime - profile_begtime);
@@ -344,9 +424,21 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
+	if (p_space->is_profiling()) {
+		// Counted afterwards, so the threaded setup doesn't need to synchronize.
+		GodotSpace3D::Profile &profile = p_space->get_profile();
+		for (const GodotConstraint3D *constraint : all_constraints) {
+			int type_A = 0;
+			int type_B = 0;
+			if (constraint->get_pair_shape_types(type_A, type_B)) {
+				++profile.pair_tests[MIN(type_A, type_B)][MAX(type_A, type_B)];
+			}
+		}
+	}
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
@@ -375,27 +467,43 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+	// Bodies can be woken up while setting up constraints, so the active list is gathered again.
+	_fill_active_bodies(*body_list);
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Warning: This doesn't run on threads, because it updates the broadphase and the space lists.
+	for (GodotBody3D *body : active_bodies) {
+		body->finish_integration();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
 
+	body_island_can_sleep.resize(body_island_count);
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_test_island_sleep, nullptr, body_island_count, -1, true, SNAME("Physics3DTestIslandSleep"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		_check_suspend(body_islands[island_index], body_island_can_sleep[island_index]);
 	}
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
 
-	sb = soft_body_list->first();
-	while (sb) {
-		sb->self()->solve_constraints(p_delta);
-		sb = sb->next();
+	// Soft bodies with many links solve them on threads, one soft body after the other, as tasks
+	// can't wait for other tasks. Smaller soft bodies are solved in parallel with each other.
+	small_soft_bodies.clear();
+	for (GodotSoftBody3D *soft_body : active_soft_bodies) {
+		if (soft_body->has_parallel_links()) {
+			soft_body->solve_constraints(delta, true);
+		} else {
+			small_soft_bodies.push_back(soft_body);
+		}
 	}
 
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_soft_body_constraints, nullptr, small_soft_bodies.size(), -1, true, SNAME("Physics3DSoftBodyConstraints"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime);
@@ -404,6 +512,22 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	all_constraints.clear();
 
+	if (p_space->is_profiling()) {
+		GodotSpace3D::Profile &profile = p_space->get_profile();
+		for (const GodotCollisionObject3D *object : p_space->get_objects()) {
+			if (object->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+				continue;
+			}
+			const GodotBody3D *body = static_cast<const GodotBody3D *>(object);
+			if (body->get_mode() >= PhysicsServer3D::BODY_MODE_RIGID) {
+				++profile.rigid_bodies;
+				if (!body->is_active()) {
+					++profile.sleeping_bodies;
+				}
+			}
+		}
+	}
+
 	p_space->unlock();
 	_step++;
 }
@@ -412,6 +536,7 @@ GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	active_bodies.reserve(BODY_ISLAND_SIZE_RESERVE);
 }
 
 GodotStep3D::~GodotStep3D() {
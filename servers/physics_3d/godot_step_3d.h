@@ -44,13 +44,25 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
+	LocalVector<GodotBody3D *> active_bodies;
+	LocalVector<GodotSoftBody3D *> active_soft_bodies;
+	LocalVector<GodotSoftBody3D *> small_soft_bodies;
+	LocalVector<uint8_t> body_island_can_sleep;
 
-	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
-	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _fill_active_bodies(const SelfList<GodotBody3D>::List &p_body_list);
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _solve_soft_body_constraints(uint32_t p_soft_body_index, void *p_userdata = nullptr);
+
+	bool _is_constraint_visited(const GodotConstraint3D *p_constraint, const GodotCollisionObject3D *p_object) const;
+	void _populate_island(GodotSpace3D *p_space, GodotBody3D *p_body, int p_island);
+	void _populate_island_soft_body(GodotSpace3D *p_space, GodotSoftBody3D *p_soft_body, int p_island);
+	void _add_island(GodotSpace3D *p_space, int p_island, uint32_t &r_island_count, uint32_t &r_body_island_count);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
-	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
+	void _test_island_sleep(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island, bool p_can_sleep) const;
 
 public:
 	void step(GodotSpace3D *p_space, real_t p_delta);
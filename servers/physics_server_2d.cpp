@@ -452,6 +452,111 @@ Dictionary PhysicsDirectSpaceState2D::_get_rest_info(const Ref<PhysicsShapeQuery
 PhysicsDirectSpaceState2D::PhysicsDirectSpaceState2D() {
 }
 
+Dictionary PhysicsDirectSpaceState2D::_intersect_ray_batch(const Ref<PhysicsRayQueryParameters2D> &p_ray_query, const PackedVector2Array &p_from, const PackedVector2Array &p_to) {
+	ERR_FAIL_COND_V(!p_ray_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V(p_from.size() != p_to.size(), Dictionary());
+
+	int count = p_from.size();
+
+	Vector<RayResult> results;
+	results.resize(count);
+	Vector<bool> hits;
+	hits.resize(count);
+
+	intersect_ray_batch(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptrw(), hits.ptrw());
+
+	PackedByteArray hit;
+	hit.resize(count);
+	PackedVector2Array position;
+	position.resize(count);
+	PackedVector2Array normal;
+	normal.resize(count);
+	PackedInt64Array collider_id;
+	collider_id.resize(count);
+	PackedInt32Array shape;
+	shape.resize(count);
+	TypedArray<RID> rid;
+	rid.resize(count);
+
+	for (int i = 0; i < count; i++) {
+		const RayResult &result = results[i];
+		if (!hits[i]) {
+			hit.write[i] = 0;
+			collider_id.write[i] = 0;
+			shape.write[i] = -1;
+			continue;
+		}
+		hit.write[i] = 1;
+		position.write[i] = result.position;
+		normal.write[i] = result.normal;
+		collider_id.write[i] = (int64_t)result.collider_id;
+		shape.write[i] = result.shape;
+		rid[i] = result.rid;
+	}
+
+	Dictionary d;
+	d["hit"] = hit;
+	d["position"] = position;
+	d["normal"] = normal;
+	d["collider_id"] = collider_id;
+	d["shape"] = shape;
+	d["rid"] = rid;
+
+	return d;
+}
+
+Vector<real_t> PhysicsDirectSpaceState2D::_cast_motion_batch(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, const PackedVector2Array &p_origins, const PackedVector2Array &p_motions) {
+	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Vector<real_t>());
+	ERR_FAIL_COND_V(p_origins.size() != p_motions.size(), Vector<real_t>());
+
+	int count = p_origins.size();
+
+	const ShapeParameters &parameters = p_shape_query->get_parameters();
+	Vector<Transform2D> transforms;
+	transforms.resize(count);
+	Transform2D *transforms_ptrw = transforms.ptrw();
+	for (int i = 0; i < count; i++) {
+		transforms_ptrw[i] = parameters.transform;
+		transforms_ptrw[i].set_origin(p_origins[i]);
+	}
+
+	Vector<real_t> closest_safe;
+	closest_safe.resize(count);
+	Vector<real_t> closest_unsafe;
+	closest_unsafe.resize(count);
+
+	cast_motion_batch(parameters, transforms.ptr(), p_motions.ptr(), count, closest_safe.ptrw(), closest_unsafe.ptrw());
+
+	Vector<real_t> ret;
+	ret.resize(count * 2);
+	real_t *ret_ptrw = ret.ptrw();
+	for (int i = 0; i < count; i++) {
+		ret_ptrw[i * 2 + 0] = closest_safe[i];
+		ret_ptrw[i * 2 + 1] = closest_unsafe[i];
+	}
+	return ret;
+}
+
+void PhysicsDirectSpaceState2D::intersect_ray_batch(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	RayParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_hits[i] = intersect_ray(parameters, r_results[i]);
+	}
+}
+
+void PhysicsDirectSpaceState2D::cast_motion_batch(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform = p_transforms[i];
+		parameters.motion = p_motions[i];
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+		cast_motion(parameters, r_closest_safe[i], r_closest_unsafe[i]);
+	}
+}
+
 void PhysicsDirectSpaceState2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "parameters", "max_results"), &PhysicsDirectSpaceState2D::_intersect_point, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState2D::_intersect_ray);
@@ -459,6 +564,8 @@ void PhysicsDirectSpaceState2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState2D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState2D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState2D::_get_rest_info);
+	ClassDB::bind_method(D_METHOD("intersect_ray_batch", "parameters", "from", "to"), &PhysicsDirectSpaceState2D::_intersect_ray_batch);
+	ClassDB::bind_method(D_METHOD("cast_motion_batch", "parameters", "origins", "motions"), &PhysicsDirectSpaceState2D::_cast_motion_batch);
 }
 
 ///////////////////////////////
@@ -617,6 +724,47 @@ bool PhysicsServer2D::_body_test_motion(RID p_body, const Ref<PhysicsTestMotionP
 	return body_test_motion(p_body, p_parameters->get_parameters(), result_ptr);
 }
 
+Dictionary PhysicsServer2D::_projectile_batch_get_hits(RID p_batch) const {
+	int count = projectile_batch_get_hit_count(p_batch);
+
+	Vector<ProjectileHit> hits;
+	hits.resize(count);
+	count = projectile_batch_get_hits(p_batch, hits.ptrw(), count);
+
+	PackedInt32Array projectile;
+	projectile.resize(count);
+	PackedVector2Array position;
+	position.resize(count);
+	PackedVector2Array normal;
+	normal.resize(count);
+	PackedInt64Array collider_id;
+	collider_id.resize(count);
+	TypedArray<RID> rid;
+	rid.resize(count);
+	PackedInt32Array shape;
+	shape.resize(count);
+
+	for (int i = 0; i < count; i++) {
+		const ProjectileHit &hit = hits[i];
+		projectile.write[i] = hit.projectile;
+		position.write[i] = hit.position;
+		normal.write[i] = hit.normal;
+		collider_id.write[i] = (int64_t)hit.collider_id;
+		rid[i] = hit.collider;
+		shape.write[i] = hit.collider_shape;
+	}
+
+	Dictionary d;
+	d["projectile"] = projectile;
+	d["position"] = position;
+	d["normal"] = normal;
+	d["collider_id"] = collider_id;
+	d["rid"] = rid;
+	d["shape"] = shape;
+
+	return d;
+}
+
 void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("world_boundary_shape_create"), &PhysicsServer2D::world_boundary_shape_create);
 	ClassDB::bind_method(D_METHOD("separation_ray_shape_create"), &PhysicsServer2D::separation_ray_shape_create);
@@ -638,6 +786,12 @@ void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer2D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer2D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer2D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_save_snapshot", "space"), &PhysicsServer2D::space_save_snapshot);
+	ClassDB::bind_method(D_METHOD("space_restore_snapshot", "space", "snapshot"), &PhysicsServer2D::space_restore_snapshot);
+
+	ClassDB::bind_method(D_METHOD("space_set_profiling_enabled", "space", "enabled"), &PhysicsServer2D::space_set_profiling_enabled);
+	ClassDB::bind_method(D_METHOD("space_is_profiling_enabled", "space"), &PhysicsServer2D::space_is_profiling_enabled);
+	ClassDB::bind_method(D_METHOD("space_get_profile", "space"), &PhysicsServer2D::space_get_profile);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer2D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer2D::area_set_space);
@@ -787,6 +941,26 @@ void PhysicsServer2D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("joint_get_type", "joint"), &PhysicsServer2D::joint_get_type);
 
+	/* PROJECTILE BATCH API */
+
+	ClassDB::bind_method(D_METHOD("projectile_batch_create"), &PhysicsServer2D::projectile_batch_create);
+
+	ClassDB::bind_method(D_METHOD("projectile_batch_set_space", "batch", "space"), &PhysicsServer2D::projectile_batch_set_space);
+	ClassDB::bind_method(D_METHOD("projectile_batch_get_space", "batch"), &PhysicsServer2D::projectile_batch_get_space);
+
+	ClassDB::bind_method(D_METHOD("projectile_batch_set_radius", "batch", "radius"), &PhysicsServer2D::projectile_batch_set_radius);
+	ClassDB::bind_method(D_METHOD("projectile_batch_get_radius", "batch"), &PhysicsServer2D::projectile_batch_get_radius);
+
+	ClassDB::bind_method(D_METHOD("projectile_batch_set_collision_mask", "batch", "mask"), &PhysicsServer2D::projectile_batch_set_collision_mask);
+	ClassDB::bind_method(D_METHOD("projectile_batch_get_collision_mask", "batch"), &PhysicsServer2D::projectile_batch_get_collision_mask);
+
+	ClassDB::bind_method(D_METHOD("projectile_batch_set_projectiles", "batch", "positions", "velocities"), &PhysicsServer2D::projectile_batch_set_projectiles);
+	ClassDB::bind_method(D_METHOD("projectile_batch_get_positions", "batch"), &PhysicsServer2D::projectile_batch_get_positions);
+	ClassDB::bind_method(D_METHOD("projectile_batch_get_velocities", "batch"), &PhysicsServer2D::projectile_batch_get_velocities);
+
+	ClassDB::bind_method(D_METHOD("projectile_batch_get_hit_count", "batch"), &PhysicsServer2D::projectile_batch_get_hit_count);
+	ClassDB::bind_method(D_METHOD("projectile_batch_get_hits", "batch"), &PhysicsServer2D::_projectile_batch_get_hits);
+
 	ClassDB::bind_method(D_METHOD("free_rid", "rid"), &PhysicsServer2D::free);
 
 	ClassDB::bind_method(D_METHOD("set_active", "active"), &PhysicsServer2D::set_active);
@@ -887,6 +1061,8 @@ void PhysicsServer2D::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_ACTIVE_OBJECTS);
 	BIND_ENUM_CONSTANT(INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(INFO_CONSTRAINT_COUNT);
+	BIND_ENUM_CONSTANT(INFO_STEP_USEC);
 }
 
 PhysicsServer2D::PhysicsServer2D() {
@@ -123,6 +123,8 @@ class PhysicsDirectSpaceState2D : public Object {
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query);
 	TypedArray<Vector2> _collide_shape(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query);
+	Dictionary _intersect_ray_batch(const Ref<PhysicsRayQueryParameters2D> &p_ray_query, const PackedVector2Array &p_from, const PackedVector2Array &p_to);
+	Vector<real_t> _cast_motion_batch(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, const PackedVector2Array &p_origins, const PackedVector2Array &p_motions);
 
 protected:
 	static void _bind_methods();
@@ -151,6 +153,11 @@ public:
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
 
+	// Casts p_count rays from p_from[i] to p_to[i], all filtered with p_parameters (its own from and to are ignored).
+	// r_hits[i] tells whether the ray hit anything, in which case r_results[i] is filled.
+	// The default implementation calls intersect_ray() for each ray.
+	virtual void intersect_ray_batch(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits);
+
 	struct ShapeResult {
 		RID rid;
 		ObjectID collider_id;
@@ -195,6 +202,9 @@ public:
 
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) = 0;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) = 0;
+	// Casts the shape of p_parameters with p_transforms[i] along p_motions[i] (its own transform and motion are ignored).
+	// The default implementation calls cast_motion() for each cast.
+	virtual void cast_motion_batch(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe);
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) = 0;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) = 0;
 
@@ -210,6 +220,7 @@ class PhysicsServer2D : public Object {
 	static PhysicsServer2D *singleton;
 
 	virtual bool _body_test_motion(RID p_body, const Ref<PhysicsTestMotionParameters2D> &p_parameters, const Ref<PhysicsTestMotionResult2D> &p_result = Ref<PhysicsTestMotionResult2D>());
+	Dictionary _projectile_batch_get_hits(RID p_batch) const;
 
 protected:
 	static void _bind_methods();
@@ -276,6 +287,14 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	virtual PackedByteArray space_save_snapshot(RID p_space) = 0;
+	virtual Error space_restore_snapshot(RID p_space, const PackedByteArray &p_snapshot) = 0;
+
+	// Profiling a space gathers detailed counters while it steps, at some cost.
+	virtual void space_set_profiling_enabled(RID p_space, bool p_enabled) = 0;
+	virtual bool space_is_profiling_enabled(RID p_space) const = 0;
+	virtual Dictionary space_get_profile(RID p_space) const = 0;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -580,6 +599,38 @@ public:
 
 	virtual JointType joint_get_type(RID p_joint) const = 0;
 
+	/* PROJECTILE BATCH API */
+
+	// A batch holds many small moving circles (or points, with a zero radius) that are moved
+	// in bulk every step, and stopped at the first static or kinematic body they hit.
+	struct ProjectileHit {
+		int projectile = -1;
+		Vector2 position;
+		Vector2 normal;
+		ObjectID collider_id;
+		RID collider;
+		int collider_shape = 0;
+	};
+
+	virtual RID projectile_batch_create() = 0;
+
+	virtual void projectile_batch_set_space(RID p_batch, RID p_space) = 0;
+	virtual RID projectile_batch_get_space(RID p_batch) const = 0;
+
+	virtual void projectile_batch_set_radius(RID p_batch, real_t p_radius) = 0;
+	virtual real_t projectile_batch_get_radius(RID p_batch) const = 0;
+
+	virtual void projectile_batch_set_collision_mask(RID p_batch, uint32_t p_mask) = 0;
+	virtual uint32_t projectile_batch_get_collision_mask(RID p_batch) const = 0;
+
+	virtual void projectile_batch_set_projectiles(RID p_batch, const Vector<Vector2> &p_positions, const Vector<Vector2> &p_velocities) = 0;
+	virtual Vector<Vector2> projectile_batch_get_positions(RID p_batch) const = 0;
+	virtual Vector<Vector2> projectile_batch_get_velocities(RID p_batch) const = 0;
+
+	// Hits of the last step, ordered by projectile index.
+	virtual int projectile_batch_get_hit_count(RID p_batch) const = 0;
+	virtual int projectile_batch_get_hits(RID p_batch, ProjectileHit *r_hits, int p_hit_max) const = 0;
+
 	/* QUERY API */
 
 	enum AreaBodyStatus {
@@ -604,7 +655,9 @@ public:
 	enum ProcessInfo {
 		INFO_ACTIVE_OBJECTS,
 		INFO_COLLISION_PAIRS,
-		INFO_ISLAND_COUNT
+		INFO_ISLAND_COUNT,
+		INFO_CONSTRAINT_COUNT,
+		INFO_STEP_USEC,
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
@@ -122,6 +122,21 @@ public:
 		return physics_server_2d->space_get_contact_count(p_space);
 	}
 
+	// These functions only work on physics process, like space_get_direct_state().
+	virtual PackedByteArray space_save_snapshot(RID p_space) override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), PackedByteArray());
+		return physics_server_2d->space_save_snapshot(p_space);
+	}
+
+	virtual Error space_restore_snapshot(RID p_space, const PackedByteArray &p_snapshot) override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), ERR_UNAVAILABLE);
+		return physics_server_2d->space_restore_snapshot(p_space, p_snapshot);
+	}
+
+	FUNC2(space_set_profiling_enabled, RID, bool);
+	FUNC1RC(bool, space_is_profiling_enabled, RID);
+	FUNC1RC(Dictionary, space_get_profile, RID);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
@@ -302,6 +317,31 @@ public:
 
 	FUNC1RC(JointType, joint_get_type, RID);
 
+	/* PROJECTILE BATCH API */
+
+	FUNCRID(projectile_batch)
+
+	FUNC2(projectile_batch_set_space, RID, RID);
+	FUNC1RC(RID, projectile_batch_get_space, RID);
+
+	FUNC2(projectile_batch_set_radius, RID, real_t);
+	FUNC1RC(real_t, projectile_batch_get_radius, RID);
+
+	FUNC2(projectile_batch_set_collision_mask, RID, uint32_t);
+	FUNC1RC(uint32_t, projectile_batch_get_collision_mask, RID);
+
+	FUNC3(projectile_batch_set_projectiles, RID, const Vector<Vector2> &, const Vector<Vector2> &);
+	FUNC1RC(Vector<Vector2>, projectile_batch_get_positions, RID);
+	FUNC1RC(Vector<Vector2>, projectile_batch_get_velocities, RID);
+
+	FUNC1RC(int, projectile_batch_get_hit_count, RID);
+
+	// This function only works on physics process, like space_get_direct_state().
+	virtual int projectile_batch_get_hits(RID p_batch, ProjectileHit *r_hits, int p_hit_max) const override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), 0);
+		return physics_server_2d->projectile_batch_get_hits(p_batch, r_hits, p_hit_max);
+	}
+
 	/* MISC */
 
 	FUNC1(free, RID);
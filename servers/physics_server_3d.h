@@ -129,6 +129,8 @@ private:
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
 	TypedArray<Vector3> _collide_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
+	Dictionary _intersect_ray_batch(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to);
+	Vector<real_t> _cast_motion_batch(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions);
 
 protected:
 	static void _bind_methods();
@@ -161,6 +163,11 @@ public:
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
 
+	// Casts p_count rays from p_from[i] to p_to[i], all filtered with p_parameters (its own from and to are ignored).
+	// r_hits[i] tells whether the ray hit anything, in which case r_results[i] is filled.
+	// The default implementation calls intersect_ray() for each ray.
+	virtual void intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits);
+
 	struct ShapeResult {
 		RID rid;
 		ObjectID collider_id;
@@ -202,6 +209,9 @@ public:
 
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) = 0;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) = 0;
+	// Casts the shape of p_parameters with p_transforms[i] along p_motions[i] (its own transform and motion are ignored).
+	// The default implementation calls cast_motion() for each cast.
+	virtual void cast_motion_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe);
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) = 0;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) = 0;
 
@@ -308,6 +318,20 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	virtual PackedByteArray space_save_snapshot(RID p_space) = 0;
+	virtual Error space_restore_snapshot(RID p_space, const PackedByteArray &p_snapshot) = 0;
+
+	// Spaces publishing their state keep a copy of it from the end of their last step,
+	// which the published getters and direct state read from any thread without waiting.
+	virtual void space_set_publish_state(RID p_space, bool p_enable) = 0;
+	virtual bool space_is_publishing_state(RID p_space) const = 0;
+	virtual PhysicsDirectSpaceState3D *space_get_published_direct_state(RID p_space) = 0;
+
+	// Profiling a space gathers detailed counters while it steps, at some cost.
+	virtual void space_set_profiling_enabled(RID p_space, bool p_enabled) = 0;
+	virtual bool space_is_profiling_enabled(RID p_space) const = 0;
+	virtual Dictionary space_get_profile(RID p_space) const = 0;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -377,6 +401,8 @@ public:
 	virtual void area_set_monitor_callback(RID p_area, const Callable &p_callback) = 0;
 	virtual void area_set_area_monitor_callback(RID p_area, const Callable &p_callback) = 0;
 
+	virtual TypedArray<RID> area_get_published_overlaps(RID p_area) const = 0;
+
 	virtual void area_set_ray_pickable(RID p_area, bool p_enable) = 0;
 
 	/* BODY API */
@@ -465,6 +491,7 @@ public:
 
 	virtual void body_set_state(RID p_body, BodyState p_state, const Variant &p_variant) = 0;
 	virtual Variant body_get_state(RID p_body, BodyState p_state) const = 0;
+	virtual Variant body_get_published_state(RID p_body, BodyState p_state) const = 0;
 
 	virtual void body_apply_central_impulse(RID p_body, const Vector3 &p_impulse) = 0;
 	virtual void body_apply_impulse(RID p_body, const Vector3 &p_impulse, const Vector3 &p_position = Vector3()) = 0;
@@ -807,7 +834,9 @@ public:
 	enum ProcessInfo {
 		INFO_ACTIVE_OBJECTS,
 		INFO_COLLISION_PAIRS,
-		INFO_ISLAND_COUNT
+		INFO_ISLAND_COUNT,
+		INFO_CONSTRAINT_COUNT,
+		INFO_STEP_USEC,
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
@@ -35,6 +35,7 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/thread.h"
 #include "core/templates/command_queue_mt.h"
+#include "core/variant/typed_array.h"
 #include "servers/physics_server_3d.h"
 
 #ifdef DEBUG_SYNC
@@ -44,7 +45,7 @@
 #endif
 
 #ifdef DEBUG_ENABLED
-#define MAIN_THREAD_SYNC_WARN WARN_PRINT("Call to " + String(__FUNCTION__) + " causing PhysicsServer3D synchronizations on every frame. This significantly affects performance.");
+#define MAIN_THREAD_SYNC_WARN WARN_PRINT("Call to " + String(__FUNCTION__) + " causing PhysicsServer3D synchronizations on every frame. This significantly affects performance. Consider reading the state published with space_set_publish_state() instead.");
 #endif
 
 class PhysicsServer3DWrapMT : public PhysicsServer3D {
@@ -126,6 +127,29 @@ public:
 		return physics_server_3d->space_get_contact_count(p_space);
 	}
 
+	// These functions only work on physics process, like space_get_direct_state().
+	virtual PackedByteArray space_save_snapshot(RID p_space) override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), PackedByteArray());
+		return physics_server_3d->space_save_snapshot(p_space);
+	}
+
+	virtual Error space_restore_snapshot(RID p_space, const PackedByteArray &p_snapshot) override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), ERR_UNAVAILABLE);
+		return physics_server_3d->space_restore_snapshot(p_space, p_snapshot);
+	}
+
+	FUNC2(space_set_publish_state, RID, bool);
+	FUNC1RC(bool, space_is_publishing_state, RID);
+
+	// The published state is thread-safe, reading it doesn't wait for the physics thread.
+	virtual PhysicsDirectSpaceState3D *space_get_published_direct_state(RID p_space) override {
+		return physics_server_3d->space_get_published_direct_state(p_space);
+	}
+
+	FUNC2(space_set_profiling_enabled, RID, bool);
+	FUNC1RC(bool, space_is_profiling_enabled, RID);
+	FUNC1RC(Dictionary, space_get_profile, RID);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
@@ -166,6 +190,10 @@ public:
 	FUNC2(area_set_monitor_callback, RID, const Callable &);
 	FUNC2(area_set_area_monitor_callback, RID, const Callable &);
 
+	virtual TypedArray<RID> area_get_published_overlaps(RID p_area) const override {
+		return physics_server_3d->area_get_published_overlaps(p_area);
+	}
+
 	/* BODY API */
 
 	//FUNC2RID(body,BodyMode,bool);
@@ -216,6 +244,10 @@ public:
 	FUNC3(body_set_state, RID, BodyState, const Variant &);
 	FUNC2RC(Variant, body_get_state, RID, BodyState);
 
+	virtual Variant body_get_published_state(RID p_body, BodyState p_state) const override {
+		return physics_server_3d->body_get_published_state(p_body, p_state);
+	}
+
 	FUNC2(body_apply_torque_impulse, RID, const Vector3 &);
 	FUNC2(body_apply_central_impulse, RID, const Vector3 &);
 	FUNC3(body_apply_impulse, RID, const Vector3 &, const Vector3 &);
@@ -0,0 +1,169 @@
+/**************************************************************************/
+/*  benchmark_image.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_IMAGE_H
+#define BENCHMARK_IMAGE_H
+
+#include "core/io/image.h"
+#include "core/io/image_kernels.h"
+#include "core/math/random_pcg.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace BenchmarkImage {
+
+static Ref<Image> _make_image(int p_size, Image::Format p_format) {
+	Vector<uint8_t> data;
+	data.resize(p_size * p_size * 4);
+	RandomPCG rng(42);
+	uint8_t *ptrw = data.ptrw();
+	for (int i = 0; i < data.size(); i++) {
+		ptrw[i] = rng.rand() & 0xFF;
+	}
+	Ref<Image> image = Image::create_from_data(p_size, p_size, false, Image::FORMAT_RGBA8, data);
+	image->convert(p_format);
+	return image;
+}
+
+static Ref<Image> _resized(const Ref<Image> &p_image, int p_size, Image::Interpolation p_interpolation) {
+	Ref<Image> image = p_image->duplicate();
+	image->resize(p_size, p_size, p_interpolation);
+	return image;
+}
+
+static Ref<Image> _with_mipmaps(const Ref<Image> &p_image) {
+	Ref<Image> image = p_image->duplicate();
+	image->generate_mipmaps();
+	return image;
+}
+
+static Ref<Image> _converted(const Ref<Image> &p_image, Image::Format p_format) {
+	Ref<Image> image = p_image->duplicate();
+	image->convert(p_format);
+	return image;
+}
+
+BENCHMARK_SUITE("[Image]") {
+	TEST_CASE("Resize") {
+		const int SIZE = 512;
+		const Image::Interpolation interpolations[] = { Image::INTERPOLATE_NEAREST, Image::INTERPOLATE_BILINEAR, Image::INTERPOLATE_CUBIC, Image::INTERPOLATE_LANCZOS };
+		const char *interpolation_names[] = { "nearest", "bilinear", "cubic", "lanczos" };
+		const Image::Format formats[] = { Image::FORMAT_RGBA8, Image::FORMAT_RGBAF };
+
+		for (Image::Format format : formats) {
+			const Ref<Image> image = _make_image(SIZE, format);
+			for (int i = 0; i < 4; i++) {
+				Benchmark::run(vformat("Image::resize %s %dx%d to %dx%d (%s)", Image::get_format_name(format), SIZE, SIZE, SIZE / 2, SIZE / 2, interpolation_names[i]), [&]() {
+					Benchmark::keep(_resized(image, SIZE / 2, interpolations[i]));
+				});
+				Benchmark::run(vformat("Image::resize %s %dx%d to %dx%d (%s)", Image::get_format_name(format), SIZE, SIZE, SIZE * 3 / 2, SIZE * 3 / 2, interpolation_names[i]), [&]() {
+					Benchmark::keep(_resized(image, SIZE * 3 / 2, interpolations[i]));
+				});
+			}
+		}
+	}
+
+	TEST_CASE("Mipmap generation") {
+		const int SIZE = 1024;
+		const Image::Format formats[] = { Image::FORMAT_RGB8, Image::FORMAT_RGBA8, Image::FORMAT_RGBAF };
+
+		for (Image::Format format : formats) {
+			const Ref<Image> image = _make_image(SIZE, format);
+			Benchmark::run(vformat("Image::generate_mipmaps %s %dx%d", Image::get_format_name(format), SIZE, SIZE), [&]() {
+				Benchmark::keep(_with_mipmaps(image));
+			});
+		}
+	}
+
+	TEST_CASE("Format conversion") {
+		const int SIZE = 512;
+		const Ref<Image> rgba8 = _make_image(SIZE, Image::FORMAT_RGBA8);
+		const Ref<Image> rgbaf = _make_image(SIZE, Image::FORMAT_RGBAF);
+
+		Benchmark::run(vformat("Image::convert RGBA8 to RGB8 %dx%d", SIZE, SIZE), [&]() {
+			Benchmark::keep(_converted(rgba8, Image::FORMAT_RGB8));
+		});
+		Benchmark::run(vformat("Image::convert RGBA8 to RGBAF %dx%d", SIZE, SIZE), [&]() {
+			Benchmark::keep(_converted(rgba8, Image::FORMAT_RGBAF));
+		});
+		Benchmark::run(vformat("Image::convert RGBAF to RGBA8 %dx%d", SIZE, SIZE), [&]() {
+			Benchmark::keep(_converted(rgbaf, Image::FORMAT_RGBA8));
+		});
+		Benchmark::run(vformat("Image::convert RGBA8 to RGBAH %dx%d", SIZE, SIZE), [&]() {
+			Benchmark::keep(_converted(rgba8, Image::FORMAT_RGBAH));
+		});
+	}
+
+	TEST_CASE("Row kernel backends") {
+		const int SIZE = 512;
+		const ImageKernels::Backend backends[] = {
+			ImageKernels::BACKEND_SCALAR,
+			ImageKernels::BACKEND_SSE2,
+			ImageKernels::BACKEND_NEON,
+		};
+		const Image::Format formats[] = { Image::FORMAT_RGBA8, Image::FORMAT_RGBAF };
+
+		const ImageKernels::Backend best_backend = ImageKernels::get_best_backend();
+		for (Image::Format format : formats) {
+			const Ref<Image> image = _make_image(SIZE, format);
+
+			// Every backend must give the same results as the scalar one, down to the last bit.
+			ImageKernels::set_backend(ImageKernels::BACKEND_SCALAR);
+			const Vector<uint8_t> expected_mipmaps = _with_mipmaps(image)->get_data();
+			const Vector<uint8_t> expected_downscale = _resized(image, SIZE / 3, Image::INTERPOLATE_LANCZOS)->get_data();
+			const Vector<uint8_t> expected_upscale = _resized(image, SIZE * 3 / 2, Image::INTERPOLATE_LANCZOS)->get_data();
+
+			for (ImageKernels::Backend backend : backends) {
+				if (!ImageKernels::is_backend_supported(backend)) {
+					continue;
+				}
+				ImageKernels::set_backend(backend);
+				const String suffix = vformat("%s, %s", Image::get_format_name(format), ImageKernels::get_backend_name(backend));
+
+				CHECK_MESSAGE(_with_mipmaps(image)->get_data() == expected_mipmaps, vformat("Mipmaps with the %s backend differ from the scalar ones.", suffix));
+				CHECK_MESSAGE(_resized(image, SIZE / 3, Image::INTERPOLATE_LANCZOS)->get_data() == expected_downscale, vformat("Lanczos downscale with the %s backend differs from the scalar one.", suffix));
+				CHECK_MESSAGE(_resized(image, SIZE * 3 / 2, Image::INTERPOLATE_LANCZOS)->get_data() == expected_upscale, vformat("Lanczos upscale with the %s backend differs from the scalar one.", suffix));
+
+				Benchmark::run(vformat("Image::generate_mipmaps %dx%d (%s)", SIZE, SIZE, suffix), [&]() {
+					Benchmark::keep(_with_mipmaps(image));
+				});
+				Benchmark::run(vformat("Image::resize lanczos %dx%d to %dx%d (%s)", SIZE, SIZE, SIZE / 3, SIZE / 3, suffix), [&]() {
+					Benchmark::keep(_resized(image, SIZE / 3, Image::INTERPOLATE_LANCZOS));
+				});
+			}
+		}
+		ImageKernels::set_backend(best_backend);
+	}
+}
+
+} // namespace BenchmarkImage
+
+#endif // BENCHMARK_IMAGE_H
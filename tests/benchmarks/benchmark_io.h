@@ -0,0 +1,153 @@
+/**************************************************************************/
+/*  benchmark_io.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_IO_H
+#define BENCHMARK_IO_H
+
+#include "core/io/compression.h"
+#include "core/io/marshalls.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace BenchmarkIO {
+
+// Small, similar payloads, like game state updates sent over the network.
+static Vector<uint8_t> _make_message(int p_index) {
+	CharString text = ("{\"player\":" + itos(p_index) + ",\"position\":[" + itos(p_index * 7 % 1000) + "," + itos(p_index * 13 % 1000) + "],\"health\":" + itos(100 - p_index % 100) + ",\"state\":\"running\"}").utf8();
+	Vector<uint8_t> message;
+	message.resize(text.length());
+	memcpy(message.ptrw(), text.get_data(), text.length());
+	return message;
+}
+
+BENCHMARK_SUITE("[IO]") {
+	TEST_CASE("Compression of small messages") {
+		const int MESSAGE_COUNT = 256;
+		Vector<Vector<uint8_t>> messages;
+		for (int i = 0; i < MESSAGE_COUNT; i++) {
+			messages.push_back(_make_message(i));
+		}
+		Vector<uint8_t> compressed;
+		compressed.resize(Compression::get_max_compressed_buffer_size(1024, Compression::MODE_ZSTD));
+
+		Compression::Mode modes[] = { Compression::MODE_DEFLATE, Compression::MODE_ZSTD };
+		const char *mode_names[] = { "deflate", "zstd" };
+		for (int m = 0; m < 2; m++) {
+			const Compression::Mode mode = modes[m];
+			Benchmark::run(vformat("Compression::compress 256 messages (%s)", mode_names[m]), [&]() {
+				for (const Vector<uint8_t> &message : messages) {
+					int size = Compression::compress(compressed.ptrw(), message.ptr(), message.size(), mode);
+					Benchmark::keep(size);
+				}
+			});
+
+			CompressionStream stream;
+			stream.start_compression(mode, Compression::get_default_level(mode));
+			Benchmark::run(vformat("CompressionStream::compress 256 messages (%s)", mode_names[m]), [&]() {
+				for (const Vector<uint8_t> &message : messages) {
+					int size = stream.compress(compressed.ptrw(), compressed.size(), message.ptr(), message.size());
+					Benchmark::keep(size);
+				}
+			});
+		}
+
+		CompressionStream dictionary_stream;
+		dictionary_stream.start_compression(Compression::MODE_ZSTD, Compression::get_default_level(Compression::MODE_ZSTD));
+		dictionary_stream.set_dictionary(Compression::train_zstd_dictionary(messages, 4096));
+		Benchmark::run("CompressionStream::compress 256 messages (zstd, dictionary)", [&]() {
+			for (const Vector<uint8_t> &message : messages) {
+				int size = dictionary_stream.compress(compressed.ptrw(), compressed.size(), message.ptr(), message.size());
+				Benchmark::keep(size);
+			}
+		});
+	}
+
+	TEST_CASE("Variant encoding") {
+		Vector<Variant> state;
+		for (int i = 0; i < 64; i++) {
+			state.push_back(Vector3(i, i * 2, i * 3));
+			state.push_back(i);
+			state.push_back(i * 0.5);
+			state.push_back(i % 2 == 0);
+		}
+
+		Benchmark::run("encode_variant 256 values (measure, then write)", [&]() {
+			int total = 0;
+			for (const Variant &value : state) {
+				int len = 0;
+				encode_variant(value, nullptr, len);
+				total += len;
+			}
+			Vector<uint8_t> buffer;
+			buffer.resize(total);
+			int ofs = 0;
+			for (const Variant &value : state) {
+				int len = 0;
+				encode_variant(value, buffer.ptrw() + ofs, len);
+				ofs += len;
+			}
+			Benchmark::keep(buffer);
+		});
+
+		VariantEncoder encoder;
+		Benchmark::run("VariantEncoder 256 values", [&]() {
+			encoder.clear();
+			for (const Variant &value : state) {
+				encoder.append(value);
+			}
+			Benchmark::keep(encoder);
+		});
+
+		VariantEncoder compact_encoder(false, true);
+		Benchmark::run("VariantEncoder 256 values (compact)", [&]() {
+			compact_encoder.clear();
+			for (const Variant &value : state) {
+				compact_encoder.append(value);
+			}
+			Benchmark::keep(compact_encoder);
+		});
+
+		Vector<Variant> decoded;
+		decoded.resize(state.size());
+		Benchmark::run("VariantDecoder 256 values", [&]() {
+			VariantDecoder decoder(encoder.get_data(), encoder.get_size());
+			Variant *ptrw = decoded.ptrw();
+			for (int i = 0; i < decoded.size(); i++) {
+				decoder.next(ptrw[i]);
+			}
+			Benchmark::keep(decoded);
+		});
+	}
+}
+
+} // namespace BenchmarkIO
+
+#endif // BENCHMARK_IO_H
@@ -0,0 +1,154 @@
+/**************************************************************************/
+/*  benchmark_memory.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_MEMORY_H
+#define BENCHMARK_MEMORY_H
+
+#include "core/os/memory.h"
+#include "core/variant/array.h"
+#include "core/variant/dictionary.h"
+#include "scene/2d/node_2d.h"
+#include "scene/resources/packed_scene.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+// Allocation heavy cases. The small-object allocator is selected at build time
+// (`small_allocator=yes`), so it is compared on and off by running these with
+// `--benchmark-json` on a build with it and one without. The JSON results record
+// which allocator was used.
+
+namespace BenchmarkMemory {
+
+BENCHMARK_SUITE("[Memory]") {
+	TEST_CASE("Small allocations") {
+		const int BLOCK_COUNT = 1000;
+		void *blocks[BLOCK_COUNT];
+		Benchmark::run("memalloc and memfree 1000 blocks of 16-512 bytes", [&]() {
+			for (int i = 0; i < BLOCK_COUNT; i++) {
+				blocks[i] = memalloc(16 + (i * 37) % 497);
+			}
+			for (int i = 0; i < BLOCK_COUNT; i++) {
+				memfree(blocks[i]);
+			}
+		});
+
+		// Freed in another order than allocated, like objects with unrelated lifetimes.
+		Benchmark::run("memalloc and memfree 1000 blocks of 16-512 bytes, interleaved", [&]() {
+			for (int i = 0; i < BLOCK_COUNT; i++) {
+				blocks[i] = memalloc(16 + (i * 37) % 497);
+			}
+			for (int i = 0; i < BLOCK_COUNT; i += 2) {
+				memfree(blocks[i]);
+			}
+			for (int i = 0; i < BLOCK_COUNT; i += 2) {
+				blocks[i] = memalloc(16 + (i * 53) % 497);
+			}
+			for (int i = 0; i < BLOCK_COUNT; i++) {
+				memfree(blocks[i]);
+			}
+		});
+	}
+
+	TEST_CASE("Variant arrays") {
+		Benchmark::run("Array of 1000 Strings", []() {
+			Array array;
+			for (int i = 0; i < 1000; i++) {
+				array.push_back(itos(i));
+			}
+			Benchmark::keep(array);
+		});
+		Benchmark::run("Array of 1000 Transform3Ds", []() {
+			Array array;
+			for (int i = 0; i < 1000; i++) {
+				array.push_back(Transform3D(Basis(), Vector3(i, 0, 0)));
+			}
+			Benchmark::keep(array);
+		});
+		Benchmark::run("Array of 1000 small Dictionaries", []() {
+			Array array;
+			for (int i = 0; i < 1000; i++) {
+				Dictionary entry;
+				entry["id"] = i;
+				entry["name"] = "entry";
+				array.push_back(entry);
+			}
+			Benchmark::keep(array);
+		});
+
+		Array source;
+		for (int i = 0; i < 1000; i++) {
+			Array entry;
+			entry.push_back(i);
+			entry.push_back(itos(i));
+			entry.push_back(Vector2(i, i));
+			source.push_back(entry);
+		}
+		Benchmark::run("Array::duplicate of 1000 nested Arrays (deep)", [&source]() {
+			Array copy = source.duplicate(true);
+			Benchmark::keep(copy);
+		});
+	}
+
+	TEST_CASE("[SceneTree] Scene instantiation") {
+		// A scene of 10 branches of 20 nodes, with a few properties set on each.
+		Node *root = memnew(Node2D);
+		root->set_name("Root");
+		for (int i = 0; i < 10; i++) {
+			Node2D *branch = memnew(Node2D);
+			branch->set_name("Branch" + itos(i));
+			root->add_child(branch);
+			branch->set_owner(root);
+			for (int j = 0; j < 20; j++) {
+				Node2D *leaf = memnew(Node2D);
+				leaf->set_name("Leaf" + itos(j));
+				leaf->set_position(Vector2(i, j));
+				leaf->set_rotation(j * 0.1);
+				leaf->add_to_group("leaves", true);
+				branch->add_child(leaf);
+				leaf->set_owner(root);
+			}
+		}
+
+		Ref<PackedScene> packed_scene;
+		packed_scene.instantiate();
+		REQUIRE(packed_scene->pack(root) == OK);
+		memdelete(root);
+
+		Benchmark::run("PackedScene::instantiate and free 211 nodes", [&packed_scene]() {
+			Node *instance = packed_scene->instantiate();
+			memdelete(instance);
+		});
+	}
+}
+
+} // namespace BenchmarkMemory
+
+#endif // BENCHMARK_MEMORY_H
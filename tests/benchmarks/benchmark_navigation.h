@@ -0,0 +1,300 @@
+/**************************************************************************/
+/*  benchmark_navigation.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_NAVIGATION_H
+#define BENCHMARK_NAVIGATION_H
+
+#ifndef _3D_DISABLED
+
+#include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "scene/resources/3d/navigation_mesh_source_geometry_data_3d.h"
+#include "scene/resources/navigation_mesh.h"
+#include "servers/navigation_server_3d.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace BenchmarkNavigation {
+
+// A flat grid of quads, with every fourth column of cells removed except
+// for a gap at alternating ends, so that long paths have to zigzag.
+static Ref<NavigationMesh> _make_maze_mesh(int p_size) {
+	Ref<NavigationMesh> mesh;
+	mesh.instantiate();
+
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= p_size; z++) {
+		for (int x = 0; x <= p_size; x++) {
+			vertices.push_back(Vector3(x, 0, z));
+		}
+	}
+	mesh->set_vertices(vertices);
+
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			if (x % 4 == 3) {
+				const bool gap = (x / 4) % 2 ? z == 0 : z == p_size - 1;
+				if (!gap) {
+					continue;
+				}
+			}
+			const int i = z * (p_size + 1) + x;
+			Vector<int> polygon;
+			polygon.push_back(i);
+			polygon.push_back(i + 1);
+			polygon.push_back(i + p_size + 2);
+			polygon.push_back(i + p_size + 1);
+			mesh->add_polygon(polygon);
+		}
+	}
+	return mesh;
+}
+
+// Rolling terrain made of 1m quads, with a square pillar every 8m to carve holes.
+static Ref<NavigationMeshSourceGeometryData3D> _make_terrain_geometry(int p_size) {
+	Ref<NavigationMeshSourceGeometryData3D> source_geometry;
+	source_geometry.instantiate();
+
+	PackedVector3Array faces;
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			Vector3 corners[4];
+			for (int i = 0; i < 4; i++) {
+				const real_t cx = x + (i & 1);
+				const real_t cz = z + (i >> 1);
+				corners[i] = Vector3(cx, Math::sin(cx * 0.2) * Math::cos(cz * 0.15) * 2.0, cz);
+			}
+			faces.push_back(corners[0]);
+			faces.push_back(corners[1]);
+			faces.push_back(corners[3]);
+			faces.push_back(corners[0]);
+			faces.push_back(corners[3]);
+			faces.push_back(corners[2]);
+
+			if (x % 8 == 4 && z % 8 == 4) {
+				// Walls of a pillar, the navigation mesh gets a hole around it.
+				const Vector3 base = corners[0] - Vector3(0, 1, 0);
+				const Vector3 sides[4] = { Vector3(1, 0, 0), Vector3(0, 0, 1), Vector3(-1, 0, 0), Vector3(0, 0, -1) };
+				Vector3 corner = base;
+				for (int i = 0; i < 4; i++) {
+					const Vector3 next = corner + sides[i];
+					faces.push_back(corner);
+					faces.push_back(corner + Vector3(0, 4, 0));
+					faces.push_back(next + Vector3(0, 4, 0));
+					faces.push_back(corner);
+					faces.push_back(next + Vector3(0, 4, 0));
+					faces.push_back(next);
+					corner = next;
+				}
+			}
+		}
+	}
+	source_geometry->add_faces(faces, Transform3D());
+	return source_geometry;
+}
+
+BENCHMARK_SUITE("[Navigation]") {
+	TEST_CASE("NavMap queries") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// The start, end and closest point lookups go through the polygon BVH,
+		// so their cost should grow much slower than the polygon count.
+		const int SIZES[] = { 16, 32, 64, 128, 256 };
+		for (const int SIZE : SIZES) {
+			RID map = navigation_server->map_create();
+			navigation_server->map_set_active(map, true);
+			RID region = navigation_server->region_create();
+			navigation_server->region_set_map(region, map);
+			Ref<NavigationMesh> mesh = _make_maze_mesh(SIZE);
+			const int polygon_count = mesh->get_polygon_count();
+			navigation_server->region_set_navigation_mesh(region, mesh);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			const Vector3 start(0.5, 0, 0.5);
+			const Vector3 end(SIZE - 0.5, 0, SIZE - 0.5);
+			if (SIZE == 64) {
+				Benchmark::run(vformat("NavigationServer3D::map_get_path across %dx%d maze", SIZE, SIZE), [&]() {
+					Vector<Vector3> path = navigation_server->map_get_path(map, start, end, true);
+					Benchmark::keep(path);
+				});
+			}
+			Benchmark::run(vformat("NavigationServer3D::map_get_path short on %d polygons", polygon_count), [&]() {
+				Vector<Vector3> path = navigation_server->map_get_path(map, start, Vector3(2.5, 0, 2.5), true);
+				Benchmark::keep(path);
+			});
+
+			int query = 0;
+			Benchmark::run(vformat("NavigationServer3D::map_get_closest_point on %d polygons", polygon_count), [&]() {
+				query = (query + 7) % (SIZE * SIZE);
+				Vector3 point = navigation_server->map_get_closest_point(map, Vector3(query % SIZE + 0.3, 1, query / SIZE + 0.6));
+				Benchmark::keep(point);
+			});
+			Benchmark::run(vformat("NavigationServer3D::map_get_closest_point_to_segment on %d polygons", polygon_count), [&]() {
+				query = (query + 7) % (SIZE * SIZE);
+				const Vector3 from(query % SIZE + 0.3, 2, query / SIZE + 0.6);
+				Vector3 point = navigation_server->map_get_closest_point_to_segment(map, from, from + Vector3(1.5, -4, 0.5));
+				Benchmark::keep(point);
+			});
+
+			navigation_server->free(region);
+			navigation_server->free(map);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+		}
+	}
+
+	TEST_CASE("NavMap long queries on a large map") {
+		// About 100k polygons.
+		const int SIZE = 368;
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		RID map = navigation_server->map_create();
+		// A single region has nothing to connect to, don't spend the sync looking for it.
+		navigation_server->map_set_use_edge_connections(map, false);
+		navigation_server->map_set_active(map, true);
+		RID region = navigation_server->region_create();
+		navigation_server->region_set_map(region, map);
+		Ref<NavigationMesh> mesh = _make_maze_mesh(SIZE);
+		CHECK(mesh->get_polygon_count() > 100000);
+		navigation_server->region_set_navigation_mesh(region, mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		// Corner to corner, through every gap of the maze.
+		const Vector3 start(0.5, 0, 0.5);
+		const Vector3 end(SIZE - 0.5, 0, SIZE - 0.5);
+		Vector<Vector3> path = navigation_server->map_get_path(map, start, end, true);
+		REQUIRE(path.size() > 2);
+		CHECK(path[0].is_equal_approx(start));
+		CHECK(path[path.size() - 1].is_equal_approx(end));
+
+		Benchmark::run(vformat("NavigationServer3D::map_get_path across %dx%d maze", SIZE, SIZE), [&]() {
+			Benchmark::keep(navigation_server->map_get_path(map, start, end, true));
+		});
+		Benchmark::run(vformat("NavigationServer3D::map_get_path across %dx%d maze, not optimized", SIZE, SIZE), [&]() {
+			Benchmark::keep(navigation_server->map_get_path(map, start, end, false));
+		});
+
+		// From one side of a wall to the other, most of the map is visited before the gap is found.
+		const Vector3 wall_start(SIZE / 2 - 1.5, 0, SIZE / 2 + 0.5);
+		const Vector3 wall_end(SIZE / 2 + 1.5, 0, SIZE / 2 + 0.5);
+		Benchmark::run(vformat("NavigationServer3D::map_get_path around a wall of %dx%d maze", SIZE, SIZE), [&]() {
+			Benchmark::keep(navigation_server->map_get_path(map, wall_start, wall_end, true));
+		});
+
+		// The same queries searched over polygon clusters first.
+		navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		Vector<Vector3> hierarchical_path = navigation_server->map_get_path(map, start, end, true);
+		REQUIRE(hierarchical_path.size() > 2);
+		CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(end));
+
+		Benchmark::run(vformat("NavigationServer3D::map_get_path across %dx%d maze, hierarchical", SIZE, SIZE), [&]() {
+			Benchmark::keep(navigation_server->map_get_path(map, start, end, true));
+		});
+		Benchmark::run(vformat("NavigationServer3D::map_get_path around a wall of %dx%d maze, hierarchical", SIZE, SIZE), [&]() {
+			Benchmark::keep(navigation_server->map_get_path(map, wall_start, wall_end, true));
+		});
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("NavMap sync while streaming regions") {
+		// A grid of maze chunks, about 50k polygons in total.
+		const int CHUNK_SIZE = 16;
+		const int CHUNK_COUNT = 16;
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		Ref<NavigationMesh> mesh = _make_maze_mesh(CHUNK_SIZE);
+		LocalVector<RID> regions;
+		for (int z = 0; z < CHUNK_COUNT; z++) {
+			for (int x = 0; x < CHUNK_COUNT; x++) {
+				RID region = navigation_server->region_create();
+				navigation_server->region_set_map(region, map);
+				navigation_server->region_set_transform(region, Transform3D(Basis(), Vector3(x * CHUNK_SIZE, 0, z * CHUNK_SIZE)));
+				navigation_server->region_set_navigation_mesh(region, mesh);
+				regions.push_back(region);
+			}
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		// Replacing the navigation mesh of a chunk makes it dirty, like streaming a new one in.
+		int chunk = 0;
+		Benchmark::run(vformat("NavigationServer3D::process swapping one of %dx%d chunks", CHUNK_COUNT, CHUNK_COUNT), [&]() {
+			chunk = (chunk + 37) % regions.size();
+			navigation_server->region_set_navigation_mesh(regions[chunk], mesh);
+			navigation_server->process(0.0);
+		});
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("NavMesh tiled baking on a large level") {
+		const int SIZE = 128;
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = _make_terrain_geometry(SIZE);
+		Ref<NavigationMesh> navigation_mesh;
+		navigation_mesh.instantiate();
+
+		Benchmark::run(vformat("NavigationServer3D::bake_from_source_geometry_data %dx%dm in one piece", SIZE, SIZE), [&]() {
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry);
+		});
+
+		navigation_mesh->set_tile_size(16.0);
+		const int max_threads = WorkerThreadPool::get_singleton()->get_thread_count();
+		for (int threads = 1; threads <= max_threads; threads *= 2) {
+			ProjectSettings::get_singleton()->set_setting("navigation/baking/thread_model/baking_max_threads", threads);
+			Benchmark::run(vformat("NavigationServer3D::bake_from_source_geometry_data %dx%dm in 16m tiles with %d threads", SIZE, SIZE, threads), [&]() {
+				navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry);
+			});
+		}
+		ProjectSettings::get_singleton()->set_setting("navigation/baking/thread_model/baking_max_threads", 0);
+		CHECK_NE(navigation_mesh->get_polygon_count(), 0);
+
+		// Like a destroyed wall, which only touches the four tiles around it.
+		const AABB changed_area(Vector3(SIZE / 2 - 2, -4, SIZE / 2 - 2), Vector3(4, 8, 4));
+		Benchmark::run(vformat("NavigationServer3D::bake_tiles_from_source_geometry_data 4 of %d tiles", (SIZE / 16) * (SIZE / 16)), [&]() {
+			navigation_server->bake_tiles_from_source_geometry_data(navigation_mesh, source_geometry, changed_area);
+		});
+	}
+}
+
+} // namespace BenchmarkNavigation
+
+#endif // _3D_DISABLED
+
+#endif // BENCHMARK_NAVIGATION_H
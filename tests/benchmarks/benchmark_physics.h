@@ -0,0 +1,1193 @@
+/**************************************************************************/
+/*  benchmark_physics.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_PHYSICS_H
+#define BENCHMARK_PHYSICS_H
+
+#include "core/math/random_pcg.h"
+#include "servers/physics_server_2d.h"
+#ifndef _3D_DISABLED
+#include "servers/physics_3d/godot_collision_kernels_3d.h"
+#include "servers/physics_3d/godot_collision_solver_3d.h"
+#include "servers/physics_3d/godot_physics_server_3d.h"
+#include "servers/physics_3d/godot_shape_3d.h"
+#include "servers/physics_server_3d.h"
+#include "servers/physics_server_3d_wrap_mt.h"
+#include "servers/rendering_server.h"
+#endif // _3D_DISABLED
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace BenchmarkPhysics {
+
+const int BODY_COUNT = 512;
+const int GRID_SIZE = 8;
+const int QUERY_COUNT = 4096;
+const int SNAPSHOT_BODY_COUNT = 5000;
+const int SNAPSHOT_GRID_SIZE = 50;
+const int RESIMULATED_FRAMES = 10;
+const int TERRAIN_SIZE = 512;
+const int STACK_GRID_SIZE = 50;
+const int STACK_HEIGHT = 4;
+const int SHAPE_PAIR_COUNT = 4096;
+const int CONVEX_POINT_COUNT = 64;
+const int CLOTH_SIZE = 72;
+const int CLOTH_STEPS = 30;
+const int PROJECTILE_COUNT = 30000;
+const int PROJECTILE_STEPS = 10;
+
+#ifndef _3D_DISABLED
+// Everything the narrowphase reports for a pair of shapes, to compare the collision kernel backends.
+struct NarrowphaseResult {
+	bool collided = false;
+	Vector3 separation_axis;
+	LocalVector<Vector3> contacts;
+
+	bool operator==(const NarrowphaseResult &p_other) const {
+		if (collided != p_other.collided || separation_axis != p_other.separation_axis || contacts.size() != p_other.contacts.size()) {
+			return false;
+		}
+		for (uint32_t i = 0; i < contacts.size(); i++) {
+			if (contacts[i] != p_other.contacts[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+static void _narrowphase_contact(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &p_normal, void *p_userdata) {
+	LocalVector<Vector3> *contacts = (LocalVector<Vector3> *)p_userdata;
+	contacts->push_back(p_point_A);
+	contacts->push_back(p_point_B);
+}
+
+static void _solve_pairs(const GodotShape3D *p_shape_A, const GodotShape3D *p_shape_B, const Vector<Transform3D> &p_transforms, LocalVector<NarrowphaseResult> &r_results) {
+	r_results.resize(p_transforms.size() / 2);
+	for (uint32_t i = 0; i < r_results.size(); i++) {
+		NarrowphaseResult &result = r_results[i];
+		result.contacts.clear();
+		result.separation_axis = Vector3();
+		result.collided = GodotCollisionSolver3D::solve_static(p_shape_A, p_transforms[i * 2 + 0], p_shape_B, p_transforms[i * 2 + 1], _narrowphase_contact, &result.contacts, &result.separation_axis);
+	}
+}
+
+static void _solve_distances(const GodotShape3D *p_shape_A, const GodotShape3D *p_shape_B, const Vector<Transform3D> &p_transforms, LocalVector<NarrowphaseResult> &r_results) {
+	r_results.resize(p_transforms.size() / 2);
+	for (uint32_t i = 0; i < r_results.size(); i++) {
+		NarrowphaseResult &result = r_results[i];
+		result.contacts.resize(2);
+		result.separation_axis = Vector3();
+		result.collided = !GodotCollisionSolver3D::solve_distance(p_shape_A, p_transforms[i * 2 + 0], p_shape_B, p_transforms[i * 2 + 1], result.contacts[0], result.contacts[1], AABB(), &result.separation_axis);
+	}
+}
+
+static HashSet<RID> area_overlaps;
+
+static void _area_monitor_overlaps(int p_status, const RID &p_body, ObjectID p_instance, int p_body_shape, int p_area_shape) {
+	if (p_status == PhysicsServer3D::AREA_BODY_ADDED) {
+		area_overlaps.insert(p_body);
+	} else {
+		area_overlaps.erase(p_body);
+	}
+}
+#endif // _3D_DISABLED
+
+static int area_monitor_event_count = 0;
+
+static void _area_monitor(int p_status, const RID &p_body, ObjectID p_instance, int p_body_shape, int p_area_shape) {
+	area_monitor_event_count++;
+}
+
+// Steps a full physics frame, the same way `Main::iteration()` does.
+template <typename S>
+static void _step(S *p_server) {
+	p_server->sync();
+	p_server->flush_queries();
+	p_server->end_sync();
+	p_server->step(1.0 / 60.0);
+}
+
+BENCHMARK_SUITE("[Physics]") {
+	TEST_CASE("2D step with falling boxes") {
+		PhysicsServer2D *ps = PhysicsServer2DManager::get_singleton()->new_default_server();
+		ps->init();
+
+		RID space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		RID floor_shape = ps->world_boundary_shape_create();
+		Array floor_data;
+		floor_data.push_back(Vector2(0, -1));
+		floor_data.push_back(0.0);
+		ps->shape_set_data(floor_shape, floor_data);
+		RID floor = ps->body_create();
+		ps->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+		ps->body_add_shape(floor, floor_shape);
+		ps->body_set_space(floor, space);
+
+		RID box_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(box_shape, Vector2(8, 8));
+		LocalVector<RID> bodies;
+		for (int i = 0; i < BODY_COUNT; i++) {
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+			ps->body_add_shape(body, box_shape);
+			ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2((i % (GRID_SIZE * GRID_SIZE)) * 20, -20 - (i / (GRID_SIZE * GRID_SIZE)) * 20)));
+			ps->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+		ps->set_active(true);
+
+		Benchmark::run(vformat("PhysicsServer2D step (%d boxes)", BODY_COUNT), [ps]() {
+			_step(ps);
+		});
+
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(floor);
+		ps->free(box_shape);
+		ps->free(floor_shape);
+		ps->free(space);
+		ps->finish();
+		memdelete(ps);
+	}
+
+	TEST_CASE("2D batched queries against static boxes") {
+		PhysicsServer2D *ps = PhysicsServer2DManager::get_singleton()->new_default_server();
+		ps->init();
+
+		RID space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		RID box_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(box_shape, Vector2(8, 8));
+		LocalVector<RID> bodies;
+		for (int i = 0; i < BODY_COUNT; i++) {
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer2D::BODY_MODE_STATIC);
+			ps->body_add_shape(body, box_shape);
+			ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2((i % 32) * 40, (i / 32) * 40)));
+			ps->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+		RID circle_shape = ps->circle_shape_create();
+		ps->shape_set_data(circle_shape, 4.0);
+
+		PhysicsDirectSpaceState2D *space_state = ps->space_get_direct_state(space);
+
+		// Short rays and casts scattered over the boxes, in random order.
+		Vector<Vector2> from;
+		Vector<Vector2> to;
+		Vector<Transform2D> transforms;
+		Vector<Vector2> motions;
+		RandomPCG rng(42);
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			const Vector2 origin(rng.randf() * 32 * 40, rng.randf() * 16 * 40);
+			const Vector2 motion = Vector2(rng.randf() - 0.5, rng.randf() - 0.5) * 80;
+			from.push_back(origin);
+			to.push_back(origin + motion);
+			transforms.push_back(Transform2D(0, origin));
+			motions.push_back(motion);
+		}
+
+		PhysicsDirectSpaceState2D::RayParameters ray_parameters;
+		Vector<PhysicsDirectSpaceState2D::RayResult> ray_results;
+		ray_results.resize(QUERY_COUNT);
+		Vector<bool> hits;
+		hits.resize(QUERY_COUNT);
+
+		// Both ways must find the same hits.
+		space_state->intersect_ray_batch(ray_parameters, from.ptr(), to.ptr(), QUERY_COUNT, ray_results.ptrw(), hits.ptrw());
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			ray_parameters.from = from[i];
+			ray_parameters.to = to[i];
+			PhysicsDirectSpaceState2D::RayResult result;
+			CHECK(space_state->intersect_ray(ray_parameters, result) == hits[i]);
+		}
+
+		Benchmark::run(vformat("intersect_ray (%d rays)", QUERY_COUNT), [&]() {
+			for (int i = 0; i < QUERY_COUNT; i++) {
+				ray_parameters.from = from[i];
+				ray_parameters.to = to[i];
+				Benchmark::keep(space_state->intersect_ray(ray_parameters, ray_results.write[i]));
+			}
+		});
+
+		Benchmark::run(vformat("intersect_ray_batch (%d rays)", QUERY_COUNT), [&]() {
+			space_state->intersect_ray_batch(ray_parameters, from.ptr(), to.ptr(), QUERY_COUNT, ray_results.ptrw(), hits.ptrw());
+		});
+
+		PhysicsDirectSpaceState2D::ShapeParameters shape_parameters;
+		shape_parameters.shape_rid = circle_shape;
+		Vector<real_t> closest_safe;
+		closest_safe.resize(QUERY_COUNT);
+		Vector<real_t> closest_unsafe;
+		closest_unsafe.resize(QUERY_COUNT);
+
+		Benchmark::run(vformat("cast_motion (%d casts)", QUERY_COUNT), [&]() {
+			for (int i = 0; i < QUERY_COUNT; i++) {
+				shape_parameters.transform = transforms[i];
+				shape_parameters.motion = motions[i];
+				space_state->cast_motion(shape_parameters, closest_safe.write[i], closest_unsafe.write[i]);
+			}
+		});
+
+		Benchmark::run(vformat("cast_motion_batch (%d casts)", QUERY_COUNT), [&]() {
+			space_state->cast_motion_batch(shape_parameters, transforms.ptr(), motions.ptr(), QUERY_COUNT, closest_safe.ptrw(), closest_unsafe.ptrw());
+		});
+
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(circle_shape);
+		ps->free(box_shape);
+		ps->free(space);
+		ps->finish();
+		memdelete(ps);
+	}
+
+	TEST_CASE("2D snapshot and restore of resting boxes") {
+		PhysicsServer2D *ps = PhysicsServer2DManager::get_singleton()->new_default_server();
+		ps->init();
+
+		RID space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		RID floor_shape = ps->world_boundary_shape_create();
+		Array floor_data;
+		floor_data.push_back(Vector2(0, -1));
+		floor_data.push_back(0.0);
+		ps->shape_set_data(floor_shape, floor_data);
+		RID floor = ps->body_create();
+		ps->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+		ps->body_add_shape(floor, floor_shape);
+		ps->body_set_space(floor, space);
+
+		// Short stacks, so most boxes have contacts to warm start.
+		RID box_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(box_shape, Vector2(8, 8));
+		LocalVector<RID> bodies;
+		for (int i = 0; i < SNAPSHOT_BODY_COUNT; i++) {
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+			ps->body_add_shape(body, box_shape);
+			ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2((i % (SNAPSHOT_GRID_SIZE * 2)) * 17, -8 - (i / (SNAPSHOT_GRID_SIZE * 2)) * 16)));
+			ps->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+		ps->set_active(true);
+		for (int i = 0; i < 30; i++) {
+			_step(ps);
+		}
+
+		// Simulating again from a restored snapshot must give the exact same results.
+		PackedByteArray snapshot = ps->space_save_snapshot(space);
+		LocalVector<Transform2D> transforms;
+		for (int i = 0; i < RESIMULATED_FRAMES; i++) {
+			_step(ps);
+		}
+		for (const RID &body : bodies) {
+			transforms.push_back(ps->body_get_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM));
+		}
+		CHECK(ps->space_restore_snapshot(space, snapshot) == OK);
+		for (int i = 0; i < RESIMULATED_FRAMES; i++) {
+			_step(ps);
+		}
+		for (uint32_t i = 0; i < bodies.size(); i++) {
+			CHECK(Transform2D(ps->body_get_state(bodies[i], PhysicsServer2D::BODY_STATE_TRANSFORM)) == transforms[i]);
+		}
+
+		Benchmark::run(vformat("space_save_snapshot (%d boxes)", SNAPSHOT_BODY_COUNT), [&]() {
+			snapshot = ps->space_save_snapshot(space);
+		});
+
+		Benchmark::run(vformat("space_restore_snapshot (%d boxes)", SNAPSHOT_BODY_COUNT), [&]() {
+			Benchmark::keep(ps->space_restore_snapshot(space, snapshot));
+		});
+
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(floor);
+		ps->free(box_shape);
+		ps->free(floor_shape);
+		ps->free(space);
+		ps->finish();
+		memdelete(ps);
+	}
+
+	TEST_CASE("2D projectiles against static boxes") {
+		PhysicsServer2D *ps = PhysicsServer2DManager::get_singleton()->new_default_server();
+		ps->init();
+
+		RID space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		RID box_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(box_shape, Vector2(8, 8));
+		LocalVector<RID> bodies;
+		for (int i = 0; i < BODY_COUNT; i++) {
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer2D::BODY_MODE_STATIC);
+			ps->body_add_shape(body, box_shape);
+			ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2((i % 32) * 40, (i / 32) * 40)));
+			ps->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+
+		// Fast projectiles scattered over the boxes, flying in random directions.
+		Vector<Vector2> positions;
+		Vector<Vector2> velocities;
+		RandomPCG rng(42);
+		for (int i = 0; i < PROJECTILE_COUNT; i++) {
+			positions.push_back(Vector2(rng.randf() * 32 * 40, rng.randf() * 16 * 40));
+			velocities.push_back(Vector2(600, 0).rotated(rng.randf() * Math_TAU));
+		}
+
+		RID batch = ps->projectile_batch_create();
+		ps->projectile_batch_set_space(batch, space);
+		ps->projectile_batch_set_projectiles(batch, positions, velocities);
+		ps->set_active(true);
+		_step(ps);
+
+		// Segment projectiles must stop where a ray along their motion first hits.
+		int hit_count = ps->projectile_batch_get_hit_count(batch);
+		CHECK(hit_count > 0);
+		Vector<PhysicsServer2D::ProjectileHit> hits;
+		hits.resize(hit_count);
+		CHECK(ps->projectile_batch_get_hits(batch, hits.ptrw(), hit_count) == hit_count);
+		Vector<Vector2> stepped_positions = ps->projectile_batch_get_positions(batch);
+
+		PhysicsDirectSpaceState2D *space_state = ps->space_get_direct_state(space);
+		PhysicsDirectSpaceState2D::RayParameters ray_parameters;
+		int hit_index = 0;
+		for (int i = 0; i < PROJECTILE_COUNT; i++) {
+			ray_parameters.from = positions[i];
+			ray_parameters.to = positions[i] + velocities[i] * (real_t)(1.0 / 60.0);
+			PhysicsDirectSpaceState2D::RayResult result;
+			if (!space_state->intersect_ray(ray_parameters, result)) {
+				CHECK(stepped_positions[i] == ray_parameters.to);
+				continue;
+			}
+			REQUIRE(hit_index < hit_count);
+			CHECK(hits[hit_index].projectile == i);
+			CHECK(hits[hit_index].collider == result.rid);
+			CHECK(stepped_positions[i] == result.position);
+			hit_index++;
+		}
+		CHECK(hit_index == hit_count);
+
+		Benchmark::run(vformat("projectile batch with segments (%d projectiles, %d steps)", PROJECTILE_COUNT, PROJECTILE_STEPS), [&]() {
+			ps->projectile_batch_set_projectiles(batch, positions, velocities);
+			for (int i = 0; i < PROJECTILE_STEPS; i++) {
+				_step(ps);
+			}
+		});
+
+		ps->projectile_batch_set_radius(batch, 2.0);
+		Benchmark::run(vformat("projectile batch with circles (%d projectiles, %d steps)", PROJECTILE_COUNT, PROJECTILE_STEPS), [&]() {
+			ps->projectile_batch_set_projectiles(batch, positions, velocities);
+			for (int i = 0; i < PROJECTILE_STEPS; i++) {
+				_step(ps);
+			}
+		});
+		ps->free(batch);
+
+		// The same circles as areas, moved every step like a script would.
+		RID circle_shape = ps->circle_shape_create();
+		ps->shape_set_data(circle_shape, 2.0);
+		LocalVector<RID> areas;
+		for (int i = 0; i < PROJECTILE_COUNT; i++) {
+			RID area = ps->area_create();
+			ps->area_add_shape(area, circle_shape);
+			ps->area_set_collision_layer(area, 0);
+			ps->area_set_collision_mask(area, 1);
+			ps->area_set_monitor_callback(area, callable_mp_static(&_area_monitor));
+			ps->area_set_transform(area, Transform2D(0, positions[i]));
+			ps->area_set_space(area, space);
+			areas.push_back(area);
+		}
+
+		area_monitor_event_count = 0;
+		for (uint32_t i = 0; i < areas.size(); i++) {
+			ps->area_set_transform(areas[i], Transform2D(0, positions[i] + velocities[i] * (real_t)(1.0 / 60.0)));
+		}
+		_step(ps);
+		_step(ps);
+		CHECK(area_monitor_event_count > 0);
+
+		Benchmark::run(vformat("Area2D (%d areas, %d steps)", PROJECTILE_COUNT, PROJECTILE_STEPS), [&]() {
+			for (int step = 0; step < PROJECTILE_STEPS; step++) {
+				for (uint32_t i = 0; i < areas.size(); i++) {
+					ps->area_set_transform(areas[i], Transform2D(0, positions[i] + velocities[i] * (real_t)(step / 60.0)));
+				}
+				_step(ps);
+			}
+		});
+
+		for (const RID &area : areas) {
+			ps->free(area);
+		}
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(circle_shape);
+		ps->free(box_shape);
+		ps->free(space);
+		ps->finish();
+		memdelete(ps);
+	}
+
+#ifndef _3D_DISABLED
+	TEST_CASE("3D step with falling boxes") {
+		PhysicsServer3D *ps = PhysicsServer3DManager::get_singleton()->new_default_server();
+		ps->init();
+
+		RID space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		RID floor_shape = ps->world_boundary_shape_create();
+		ps->shape_set_data(floor_shape, Plane(Vector3(0, 1, 0), 0));
+		RID floor = ps->body_create();
+		ps->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		ps->body_add_shape(floor, floor_shape);
+		ps->body_set_space(floor, space);
+
+		RID box_shape = ps->box_shape_create();
+		ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+		LocalVector<RID> bodies;
+		for (int i = 0; i < BODY_COUNT; i++) {
+			const Vector3 position((i % GRID_SIZE) * 1.25, 1 + (i / (GRID_SIZE * GRID_SIZE)) * 1.25, ((i / GRID_SIZE) % GRID_SIZE) * 1.25);
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+			ps->body_add_shape(body, box_shape);
+			ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), position));
+			ps->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+		ps->set_active(true);
+
+		Benchmark::run(vformat("PhysicsServer3D step (%d boxes)", BODY_COUNT), [ps]() {
+			_step(ps);
+		});
+
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(floor);
+		ps->free(box_shape);
+		ps->free(floor_shape);
+		ps->free(space);
+		ps->finish();
+		memdelete(ps);
+	}
+
+	TEST_CASE("3D step with resting stacks that can't sleep") {
+		PhysicsServer3D *ps = PhysicsServer3DManager::get_singleton()->new_default_server();
+		ps->init();
+
+		RID space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		RID floor_shape = ps->world_boundary_shape_create();
+		ps->shape_set_data(floor_shape, Plane(Vector3(0, 1, 0), 0));
+		RID floor = ps->body_create();
+		ps->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		ps->body_add_shape(floor, floor_shape);
+		ps->body_set_space(floor, space);
+
+		// Every stack is its own island, and they all stay active without ever changing.
+		RID box_shape = ps->box_shape_create();
+		ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+		LocalVector<RID> bodies;
+		for (int i = 0; i < STACK_GRID_SIZE * STACK_GRID_SIZE * STACK_HEIGHT; i++) {
+			const int stack = i / STACK_HEIGHT;
+			const Vector3 position((stack % STACK_GRID_SIZE) * 1.5, 0.5 + (i % STACK_HEIGHT), (stack / STACK_GRID_SIZE) * 1.5);
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+			ps->body_add_shape(body, box_shape);
+			ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), position));
+			ps->body_set_state(body, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+			ps->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+		ps->set_active(true);
+		for (int i = 0; i < 60; i++) {
+			_step(ps);
+		}
+		CHECK(ps->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT) == STACK_GRID_SIZE * STACK_GRID_SIZE);
+
+		Benchmark::run(vformat("PhysicsServer3D step (%d boxes in %d stacks)", bodies.size(), STACK_GRID_SIZE * STACK_GRID_SIZE), [ps]() {
+			_step(ps);
+		});
+
+		ps->space_set_profiling_enabled(space, true);
+		_step(ps);
+		Dictionary profile = ps->space_get_profile(space);
+		CHECK(int(profile["island_count"]) == STACK_GRID_SIZE * STACK_GRID_SIZE);
+		CHECK(int(profile["rigid_bodies"]) == (int)bodies.size());
+		CHECK(int(profile["sleeping_bodies"]) == 0);
+		int island_size_bucket = 0;
+		while ((STACK_HEIGHT >> (island_size_bucket + 1)) > 0) {
+			island_size_bucket++;
+		}
+		PackedInt32Array island_sizes = profile["island_sizes"];
+		CHECK(island_sizes[island_size_bucket] == STACK_GRID_SIZE * STACK_GRID_SIZE);
+		Dictionary pair_tests = profile["pair_tests"];
+		CHECK(int(pair_tests[Vector2i(PhysicsServer3D::SHAPE_BOX, PhysicsServer3D::SHAPE_BOX)]) >= STACK_GRID_SIZE * STACK_GRID_SIZE * (STACK_HEIGHT - 1));
+		CHECK(int(pair_tests[Vector2i(PhysicsServer3D::SHAPE_WORLD_BOUNDARY, PhysicsServer3D::SHAPE_BOX)]) >= STACK_GRID_SIZE * STACK_GRID_SIZE);
+
+		Benchmark::run(vformat("PhysicsServer3D step (%d boxes in %d stacks, profiling)", bodies.size(), STACK_GRID_SIZE * STACK_GRID_SIZE), [ps]() {
+			_step(ps);
+		});
+		ps->space_set_profiling_enabled(space, false);
+
+		// Removing the second box of a stack splits its island in two, the others are kept.
+		ps->free(bodies[1]);
+		bodies.remove_at(1);
+		_step(ps);
+		CHECK(ps->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT) == STACK_GRID_SIZE * STACK_GRID_SIZE + 1);
+
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(floor);
+		ps->free(box_shape);
+		ps->free(floor_shape);
+		ps->free(space);
+		ps->finish();
+		memdelete(ps);
+	}
+
+	TEST_CASE("3D batched queries against static boxes") {
+		PhysicsServer3D *ps = PhysicsServer3DManager::get_singleton()->new_default_server();
+		ps->init();
+
+		RID space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		RID box_shape = ps->box_shape_create();
+		ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+		LocalVector<RID> bodies;
+		for (int i = 0; i < BODY_COUNT; i++) {
+			const Vector3 position((i % GRID_SIZE) * 2.0, (i / (GRID_SIZE * GRID_SIZE)) * 2.0, ((i / GRID_SIZE) % GRID_SIZE) * 2.0);
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+			ps->body_add_shape(body, box_shape);
+			ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), position));
+			ps->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+		RID sphere_shape = ps->sphere_shape_create();
+		ps->shape_set_data(sphere_shape, 0.25);
+
+		PhysicsDirectSpaceState3D *space_state = ps->space_get_direct_state(space);
+
+		// Short rays and casts scattered over the boxes, in random order.
+		Vector<Vector3> from;
+		Vector<Vector3> to;
+		Vector<Transform3D> transforms;
+		Vector<Vector3> motions;
+		RandomPCG rng(42);
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			const Vector3 origin = Vector3(rng.randf(), rng.randf(), rng.randf()) * GRID_SIZE * 2.0;
+			const Vector3 motion = Vector3(rng.randf() - 0.5, rng.randf() - 0.5, rng.randf() - 0.5) * 4.0;
+			from.push_back(origin);
+			to.push_back(origin + motion);
+			transforms.push_back(Transform3D(Basis(), origin));
+			motions.push_back(motion);
+		}
+
+		PhysicsDirectSpaceState3D::RayParameters ray_parameters;
+		Vector<PhysicsDirectSpaceState3D::RayResult> ray_results;
+		ray_results.resize(QUERY_COUNT);
+		Vector<bool> hits;
+		hits.resize(QUERY_COUNT);
+
+		// Both ways must find the same hits.
+		space_state->intersect_ray_batch(ray_parameters, from.ptr(), to.ptr(), QUERY_COUNT, ray_results.ptrw(), hits.ptrw());
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			ray_parameters.from = from[i];
+			ray_parameters.to = to[i];
+			PhysicsDirectSpaceState3D::RayResult result;
+			CHECK(space_state->intersect_ray(ray_parameters, result) == hits[i]);
+		}
+
+		Benchmark::run(vformat("intersect_ray (%d rays)", QUERY_COUNT), [&]() {
+			for (int i = 0; i < QUERY_COUNT; i++) {
+				ray_parameters.from = from[i];
+				ray_parameters.to = to[i];
+				Benchmark::keep(space_state->intersect_ray(ray_parameters, ray_results.write[i]));
+			}
+		});
+
+		Benchmark::run(vformat("intersect_ray_batch (%d rays)", QUERY_COUNT), [&]() {
+			space_state->intersect_ray_batch(ray_parameters, from.ptr(), to.ptr(), QUERY_COUNT, ray_results.ptrw(), hits.ptrw());
+		});
+
+		PhysicsDirectSpaceState3D::ShapeParameters shape_parameters;
+		shape_parameters.shape_rid = sphere_shape;
+		Vector<real_t> closest_safe;
+		closest_safe.resize(QUERY_COUNT);
+		Vector<real_t> closest_unsafe;
+		closest_unsafe.resize(QUERY_COUNT);
+
+		Benchmark::run(vformat("cast_motion (%d casts)", QUERY_COUNT), [&]() {
+			for (int i = 0; i < QUERY_COUNT; i++) {
+				shape_parameters.transform = transforms[i];
+				shape_parameters.motion = motions[i];
+				space_state->cast_motion(shape_parameters, closest_safe.write[i], closest_unsafe.write[i]);
+			}
+		});
+
+		Benchmark::run(vformat("cast_motion_batch (%d casts)", QUERY_COUNT), [&]() {
+			space_state->cast_motion_batch(shape_parameters, transforms.ptr(), motions.ptr(), QUERY_COUNT, closest_safe.ptrw(), closest_unsafe.ptrw());
+		});
+
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(sphere_shape);
+		ps->free(box_shape);
+		ps->free(space);
+		ps->finish();
+		memdelete(ps);
+	}
+
+	TEST_CASE("3D snapshot and restore of resting boxes") {
+		PhysicsServer3D *ps = PhysicsServer3DManager::get_singleton()->new_default_server();
+		ps->init();
+
+		RID space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		RID floor_shape = ps->world_boundary_shape_create();
+		ps->shape_set_data(floor_shape, Plane(Vector3(0, 1, 0), 0));
+		RID floor = ps->body_create();
+		ps->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		ps->body_add_shape(floor, floor_shape);
+		ps->body_set_space(floor, space);
+
+		// Two layers, so most boxes have contacts to warm start.
+		RID box_shape = ps->box_shape_create();
+		ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+		LocalVector<RID> bodies;
+		for (int i = 0; i < SNAPSHOT_BODY_COUNT; i++) {
+			const Vector3 position((i % SNAPSHOT_GRID_SIZE) * 1.05, 0.5 + (i / (SNAPSHOT_GRID_SIZE * SNAPSHOT_GRID_SIZE)), ((i / SNAPSHOT_GRID_SIZE) % SNAPSHOT_GRID_SIZE) * 1.05);
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+			ps->body_add_shape(body, box_shape);
+			ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), position));
+			ps->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+		ps->set_active(true);
+		for (int i = 0; i < 30; i++) {
+			_step(ps);
+		}
+
+		// Simulating again from a restored snapshot must give the exact same results.
+		PackedByteArray snapshot = ps->space_save_snapshot(space);
+		LocalVector<Transform3D> transforms;
+		for (int i = 0; i < RESIMULATED_FRAMES; i++) {
+			_step(ps);
+		}
+		for (const RID &body : bodies) {
+			transforms.push_back(ps->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM));
+		}
+		CHECK(ps->space_restore_snapshot(space, snapshot) == OK);
+		for (int i = 0; i < RESIMULATED_FRAMES; i++) {
+			_step(ps);
+		}
+		for (uint32_t i = 0; i < bodies.size(); i++) {
+			CHECK(Transform3D(ps->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM)) == transforms[i]);
+		}
+
+		Benchmark::run(vformat("space_save_snapshot (%d boxes)", SNAPSHOT_BODY_COUNT), [&]() {
+			snapshot = ps->space_save_snapshot(space);
+		});
+
+		Benchmark::run(vformat("space_restore_snapshot (%d boxes)", SNAPSHOT_BODY_COUNT), [&]() {
+			Benchmark::keep(ps->space_restore_snapshot(space, snapshot));
+		});
+
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(floor);
+		ps->free(box_shape);
+		ps->free(floor_shape);
+		ps->free(space);
+		ps->finish();
+		memdelete(ps);
+	}
+
+	TEST_CASE("3D published state read while stepping on a separate thread") {
+		// The server the engine uses when physics/3d/run_on_separate_thread is enabled.
+		PhysicsServer3D *ps = memnew(PhysicsServer3DWrapMT(memnew(GodotPhysicsServer3D(true)), true));
+		ps->init();
+
+		RID space = ps->space_create();
+		ps->space_set_active(space, true);
+		ps->space_set_publish_state(space, true);
+
+		RID floor_shape = ps->world_boundary_shape_create();
+		ps->shape_set_data(floor_shape, Plane(Vector3(0, 1, 0), 0));
+		RID floor = ps->body_create();
+		ps->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		ps->body_add_shape(floor, floor_shape);
+		ps->body_set_space(floor, space);
+
+		// Boxes that can't sleep, so every step costs the same.
+		RID box_shape = ps->box_shape_create();
+		ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+		LocalVector<RID> bodies;
+		for (int i = 0; i < SNAPSHOT_BODY_COUNT; i++) {
+			const Vector3 position((i % SNAPSHOT_GRID_SIZE) * 1.05, 0.5 + (i / (SNAPSHOT_GRID_SIZE * SNAPSHOT_GRID_SIZE)), ((i / SNAPSHOT_GRID_SIZE) % SNAPSHOT_GRID_SIZE) * 1.05);
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+			ps->body_add_shape(body, box_shape);
+			ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), position));
+			ps->body_set_state(body, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+			ps->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+
+		RID area_shape = ps->box_shape_create();
+		ps->shape_set_data(area_shape, Vector3(10, 2, 10));
+		RID area = ps->area_create();
+		ps->area_add_shape(area, area_shape);
+		ps->area_set_monitor_callback(area, callable_mp_static(&_area_monitor_overlaps));
+		ps->area_set_space(area, space);
+
+		ps->set_active(true);
+		for (int i = 0; i < 30; i++) {
+			_step(ps);
+		}
+
+		// Once the physics thread is done, the published state must be the current one.
+		ps->sync();
+		ps->flush_queries();
+		for (const RID &body : bodies) {
+			CHECK(Transform3D(ps->body_get_published_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)) == Transform3D(ps->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)));
+			CHECK(Vector3(ps->body_get_published_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) == Vector3(ps->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)));
+		}
+		TypedArray<RID> overlaps = ps->area_get_published_overlaps(area);
+		CHECK(overlaps.size() > 0);
+		CHECK(overlaps.size() == (int)area_overlaps.size());
+		for (int i = 0; i < overlaps.size(); i++) {
+			CHECK(area_overlaps.has(overlaps[i]));
+		}
+
+		// Downward rays over the boxes.
+		Vector<Vector3> from;
+		Vector<Vector3> to;
+		RandomPCG rng(42);
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			const Vector3 origin(rng.randf() * SNAPSHOT_GRID_SIZE * 1.05, 5.0, rng.randf() * SNAPSHOT_GRID_SIZE * 1.05);
+			from.push_back(origin);
+			to.push_back(origin - Vector3(0, 10, 0));
+		}
+
+		PhysicsDirectSpaceState3D *space_state = ps->space_get_direct_state(space);
+		PhysicsDirectSpaceState3D *published_space_state = ps->space_get_published_direct_state(space);
+		PhysicsDirectSpaceState3D::RayParameters ray_parameters;
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			ray_parameters.from = from[i];
+			ray_parameters.to = to[i];
+			PhysicsDirectSpaceState3D::RayResult result;
+			PhysicsDirectSpaceState3D::RayResult published_result;
+			CHECK(space_state->intersect_ray(ray_parameters, result) == published_space_state->intersect_ray(ray_parameters, published_result));
+			CHECK(result.rid == published_result.rid);
+			CHECK(result.position == published_result.position);
+		}
+		ps->end_sync();
+
+		// A frame as `Main::iteration()` runs it, with the game reading the bodies while the
+		// physics thread steps. Reading the live state waits for the step to finish.
+		Benchmark::run(vformat("Frame reading %d transforms with body_get_state", SNAPSHOT_BODY_COUNT), [&]() {
+			ps->step(1.0 / 60.0);
+			for (const RID &body : bodies) {
+				Benchmark::keep(Transform3D(ps->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)));
+			}
+			ps->sync();
+			ps->flush_queries();
+			ps->end_sync();
+		});
+
+		Benchmark::run(vformat("Frame reading %d transforms with body_get_published_state", SNAPSHOT_BODY_COUNT), [&]() {
+			ps->step(1.0 / 60.0);
+			for (const RID &body : bodies) {
+				Benchmark::keep(Transform3D(ps->body_get_published_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM)));
+			}
+			ps->sync();
+			ps->flush_queries();
+			ps->end_sync();
+		});
+
+		Benchmark::run(vformat("Frame casting %d rays against the published state", QUERY_COUNT), [&]() {
+			ps->step(1.0 / 60.0);
+			PhysicsDirectSpaceState3D::RayResult result;
+			for (int i = 0; i < QUERY_COUNT; i++) {
+				ray_parameters.from = from[i];
+				ray_parameters.to = to[i];
+				Benchmark::keep(published_space_state->intersect_ray(ray_parameters, result));
+			}
+			ps->sync();
+			ps->flush_queries();
+			ps->end_sync();
+		});
+
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(area);
+		ps->free(floor);
+		ps->free(area_shape);
+		ps->free(box_shape);
+		ps->free(floor_shape);
+		ps->free(space);
+		ps->finish();
+		memdelete(ps);
+		area_overlaps.clear();
+	}
+
+	TEST_CASE("3D concave polygon shape queries on a large terrain") {
+		// Two triangles per cell of a bumpy heightfield, like a terrain collision mesh.
+		Vector<Vector3> faces;
+		faces.resize(TERRAIN_SIZE * TERRAIN_SIZE * 6);
+		Vector3 *w = faces.ptrw();
+		for (int z = 0; z < TERRAIN_SIZE; z++) {
+			for (int x = 0; x < TERRAIN_SIZE; x++) {
+				const Vector3 a(x, Math::sin(x * 0.1) * Math::cos(z * 0.1) * 8.0, z);
+				const Vector3 b(x + 1, Math::sin((x + 1) * 0.1) * Math::cos(z * 0.1) * 8.0, z);
+				const Vector3 c(x, Math::sin(x * 0.1) * Math::cos((z + 1) * 0.1) * 8.0, z + 1);
+				const Vector3 d(x + 1, Math::sin((x + 1) * 0.1) * Math::cos((z + 1) * 0.1) * 8.0, z + 1);
+				*w++ = a;
+				*w++ = b;
+				*w++ = c;
+				*w++ = b;
+				*w++ = d;
+				*w++ = c;
+			}
+		}
+		const int face_count = faces.size() / 3;
+
+		Dictionary data;
+		data["faces"] = faces;
+		data["backface_collision"] = false;
+		GodotConcavePolygonShape3D *shape = memnew(GodotConcavePolygonShape3D);
+		shape->set_data(data);
+		print_line(vformat("GodotConcavePolygonShape3D: %d triangles, %.1f bytes per triangle.", face_count, double(shape->get_memory_usage()) / face_count));
+
+		// Long rays grazing over the terrain, and small boxes around it.
+		RandomPCG rng(42);
+		Vector<Vector3> from;
+		Vector<Vector3> to;
+		Vector<AABB> boxes;
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			from.push_back(Vector3(rng.randf() * TERRAIN_SIZE, 12.0, rng.randf() * TERRAIN_SIZE));
+			to.push_back(Vector3(rng.randf() * TERRAIN_SIZE, -12.0, rng.randf() * TERRAIN_SIZE));
+			boxes.push_back(AABB(Vector3(rng.randf() * TERRAIN_SIZE, rng.randf() * 16.0 - 8.0, rng.randf() * TERRAIN_SIZE), Vector3(2, 2, 2)));
+		}
+
+		// Compare a few queries against testing every triangle.
+		const Vector3 *r = faces.ptr();
+		for (int i = 0; i < 32; i++) {
+			Vector3 result;
+			Vector3 normal;
+			int face_index = -1;
+			const bool hit = shape->intersect_segment(from[i], to[i], result, normal, face_index, true);
+
+			real_t closest = 1e20;
+			int closest_index = -1;
+			for (int j = 0; j < face_count; j++) {
+				Vector3 res;
+				if (Geometry3D::segment_intersects_triangle(from[i], to[i], r[j * 3 + 0], r[j * 3 + 1], r[j * 3 + 2], &res) && from[i].distance_to(res) < closest) {
+					closest = from[i].distance_to(res);
+					closest_index = j;
+				}
+			}
+			CHECK(hit == (closest_index >= 0));
+			if (hit && closest_index >= 0) {
+				CHECK(from[i].distance_to(result) == doctest::Approx(closest));
+			}
+
+			int count = 0;
+			shape->cull(
+					boxes[i], [](void *p_userdata, GodotShape3D *p_convex) {
+						(*(int *)p_userdata)++;
+						return false;
+					},
+					&count, false);
+			int expected = 0;
+			for (int j = 0; j < face_count; j++) {
+				AABB face_aabb(r[j * 3 + 0], Vector3());
+				face_aabb.expand_to(r[j * 3 + 1]);
+				face_aabb.expand_to(r[j * 3 + 2]);
+				expected += boxes[i].intersects(face_aabb) ? 1 : 0;
+			}
+			CHECK(count == expected);
+
+			const Vector3 axis = (to[i] - from[i]).normalized();
+			const Transform3D transform(Basis(Vector3(0, 1, 0), i * 0.1), from[i]);
+			real_t min = 0.0;
+			real_t max = 0.0;
+			shape->project_range(axis, transform, min, max);
+			real_t expected_min = 1e20;
+			real_t expected_max = -1e20;
+			for (int j = 0; j < face_count * 3; j++) {
+				const real_t d = axis.dot(transform.xform(r[j]));
+				expected_min = MIN(expected_min, d);
+				expected_max = MAX(expected_max, d);
+			}
+			CHECK(min == doctest::Approx(expected_min));
+			CHECK(max == doctest::Approx(expected_max));
+		}
+
+		Benchmark::run(vformat("GodotConcavePolygonShape3D intersect_segment (%d long rays)", QUERY_COUNT), [&]() {
+			for (int i = 0; i < QUERY_COUNT; i++) {
+				Vector3 result;
+				Vector3 normal;
+				int face_index = -1;
+				Benchmark::keep(shape->intersect_segment(from[i], to[i], result, normal, face_index, true));
+			}
+		});
+
+		Benchmark::run(vformat("GodotConcavePolygonShape3D cull (%d boxes)", QUERY_COUNT), [&]() {
+			int count = 0;
+			for (int i = 0; i < QUERY_COUNT; i++) {
+				shape->cull(
+						boxes[i], [](void *p_userdata, GodotShape3D *p_convex) {
+							(*(int *)p_userdata)++;
+							return false;
+						},
+						&count, false);
+			}
+			Benchmark::keep(count);
+		});
+
+		Benchmark::run("GodotConcavePolygonShape3D project_range (256 axes)", [&]() {
+			for (int i = 0; i < 256; i++) {
+				real_t min = 0.0;
+				real_t max = 0.0;
+				shape->project_range((to[i] - from[i]).normalized(), Transform3D(), min, max);
+				Benchmark::keep(min);
+			}
+		});
+
+		Benchmark::run(vformat("GodotConcavePolygonShape3D build (%d triangles)", face_count), [&]() {
+			shape->set_data(data);
+		});
+
+		memdelete(shape);
+	}
+
+	TEST_CASE("3D narrowphase shape pairs") {
+		GodotBoxShape3D *box = memnew(GodotBoxShape3D);
+		box->set_data(Vector3(0.5, 0.75, 1.0));
+
+		GodotCapsuleShape3D *capsule = memnew(GodotCapsuleShape3D);
+		Dictionary capsule_data;
+		capsule_data["radius"] = 0.5;
+		capsule_data["height"] = 2.0;
+		capsule->set_data(capsule_data);
+
+		// A rock-like hull.
+		RandomPCG rng(42);
+		Vector<Vector3> convex_points;
+		for (int i = 0; i < CONVEX_POINT_COUNT; i++) {
+			convex_points.push_back(Vector3(rng.randf() - 0.5, rng.randf() - 0.5, rng.randf() - 0.5).normalized() * (0.8 + rng.randf() * 0.4));
+		}
+		GodotConvexPolygonShape3D *convex = memnew(GodotConvexPolygonShape3D);
+		convex->set_data(convex_points);
+
+		// Pairs of transforms close enough that most shapes overlap, and further apart ones for distance queries.
+		Vector<Transform3D> overlapping;
+		Vector<Transform3D> separated;
+		for (int i = 0; i < SHAPE_PAIR_COUNT * 2; i++) {
+			const Basis basis = Basis::from_euler(Vector3(rng.randf(), rng.randf(), rng.randf()) * Math_TAU);
+			const Vector3 direction = Vector3(rng.randf() - 0.5, rng.randf() - 0.5, rng.randf() - 0.5).normalized();
+			overlapping.push_back(Transform3D(basis, direction * rng.randf() * 2.0));
+			separated.push_back(Transform3D(basis, direction * (4.0 + rng.randf() * 2.0) * (i % 2)));
+		}
+
+		struct ShapePair {
+			const char *name;
+			const GodotShape3D *shape_A;
+			const GodotShape3D *shape_B;
+			bool distance;
+		};
+		const ShapePair pairs[] = {
+			{ "box-box", box, box, false },
+			{ "box-capsule", box, capsule, false },
+			{ "capsule-capsule", capsule, capsule, false },
+			{ "box-convex", box, convex, false },
+			{ "capsule-convex", capsule, convex, false },
+			{ "convex-convex", convex, convex, false },
+			{ "convex-convex GJK distance", convex, convex, true },
+		};
+		const GodotCollisionKernels3D::Backend backends[] = {
+			GodotCollisionKernels3D::BACKEND_SCALAR,
+			GodotCollisionKernels3D::BACKEND_SSE2,
+			GodotCollisionKernels3D::BACKEND_NEON,
+		};
+
+		const GodotCollisionKernels3D::Backend best_backend = GodotCollisionKernels3D::get_best_backend();
+		LocalVector<NarrowphaseResult> expected;
+		LocalVector<NarrowphaseResult> results;
+		for (const ShapePair &pair : pairs) {
+			const Vector<Transform3D> &transforms = pair.distance ? separated : overlapping;
+
+			// Every backend must give the same results as the scalar one, down to the last bit.
+			GodotCollisionKernels3D::set_backend(GodotCollisionKernels3D::BACKEND_SCALAR);
+			if (pair.distance) {
+				_solve_distances(pair.shape_A, pair.shape_B, transforms, expected);
+			} else {
+				_solve_pairs(pair.shape_A, pair.shape_B, transforms, expected);
+			}
+
+			int collided = 0;
+			for (const NarrowphaseResult &result : expected) {
+				collided += result.collided ? 1 : 0;
+			}
+			print_line(vformat("%s: %d of %d pairs collide.", pair.name, collided, SHAPE_PAIR_COUNT));
+
+			for (GodotCollisionKernels3D::Backend backend : backends) {
+				if (!GodotCollisionKernels3D::is_backend_supported(backend)) {
+					continue;
+				}
+				GodotCollisionKernels3D::set_backend(backend);
+
+				if (pair.distance) {
+					_solve_distances(pair.shape_A, pair.shape_B, transforms, results);
+				} else {
+					_solve_pairs(pair.shape_A, pair.shape_B, transforms, results);
+				}
+				int mismatches = 0;
+				for (uint32_t i = 0; i < expected.size(); i++) {
+					mismatches += results[i] == expected[i] ? 0 : 1;
+				}
+				CHECK_MESSAGE(mismatches == 0, vformat("%s with the %s backend differs from the scalar one.", pair.name, GodotCollisionKernels3D::get_backend_name(backend)));
+
+				Benchmark::run(vformat("Narrowphase %s (%d pairs, %s)", pair.name, SHAPE_PAIR_COUNT, GodotCollisionKernels3D::get_backend_name(backend)), [&]() {
+					if (pair.distance) {
+						_solve_distances(pair.shape_A, pair.shape_B, transforms, results);
+					} else {
+						_solve_pairs(pair.shape_A, pair.shape_B, transforms, results);
+					}
+					Benchmark::keep(results[0].collided);
+				});
+			}
+		}
+		GodotCollisionKernels3D::set_backend(best_backend);
+
+		memdelete(convex);
+		memdelete(capsule);
+		memdelete(box);
+	}
+
+	// Soft bodies need meshes, so this uses the RenderingServer which comes with SceneTree cases.
+	TEST_CASE("[SceneTree] 3D step with hanging cloths") {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+
+		// A cloth of CLOTH_SIZE * CLOTH_SIZE vertices, hanging from its top row.
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		for (int y = 0; y < CLOTH_SIZE; y++) {
+			for (int x = 0; x < CLOTH_SIZE; x++) {
+				vertices.push_back(Vector3(x * 0.1, -y * 0.1, 0.0));
+			}
+		}
+		for (int y = 0; y < CLOTH_SIZE - 1; y++) {
+			for (int x = 0; x < CLOTH_SIZE - 1; x++) {
+				const int i = y * CLOTH_SIZE + x;
+				indices.push_back(i);
+				indices.push_back(i + 1);
+				indices.push_back(i + CLOTH_SIZE);
+				indices.push_back(i + 1);
+				indices.push_back(i + CLOTH_SIZE + 1);
+				indices.push_back(i + CLOTH_SIZE);
+			}
+		}
+		Array arrays;
+		arrays.resize(RS::ARRAY_MAX);
+		arrays[RS::ARRAY_VERTEX] = vertices;
+		arrays[RS::ARRAY_INDEX] = indices;
+		RID mesh = RS::get_singleton()->mesh_create();
+		RS::get_singleton()->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+
+		// The same cloth in two spaces, which must stay identical as links are solved on threads.
+		RID spaces[2];
+		RID cloths[2];
+		for (int i = 0; i < 2; i++) {
+			spaces[i] = ps->space_create();
+			ps->space_set_active(spaces[i], true);
+
+			cloths[i] = ps->soft_body_create();
+			ps->soft_body_set_space(cloths[i], spaces[i]);
+			for (int x = 0; x < CLOTH_SIZE; x++) {
+				ps->soft_body_pin_point(cloths[i], x, true);
+			}
+			ps->soft_body_set_mesh(cloths[i], mesh);
+		}
+
+		for (int i = 0; i < CLOTH_STEPS; i++) {
+			_step(ps);
+		}
+
+		const int vertex_count = CLOTH_SIZE * CLOTH_SIZE;
+		int mismatches = 0;
+		for (int i = 0; i < vertex_count; i++) {
+			mismatches += ps->soft_body_get_point_global_position(cloths[0], i) == ps->soft_body_get_point_global_position(cloths[1], i) ? 0 : 1;
+		}
+		CHECK(mismatches == 0);
+		CHECK(ps->soft_body_get_point_global_position(cloths[0], CLOTH_SIZE - 1) == vertices[CLOTH_SIZE - 1]);
+		CHECK(ps->soft_body_get_point_global_position(cloths[0], vertex_count - 1).y < vertices[vertex_count - 1].y);
+
+		Benchmark::run(vformat("3D step (2 cloths of %d vertices)", vertex_count), [&]() {
+			_step(ps);
+		});
+
+		for (int i = 0; i < 2; i++) {
+			ps->free(cloths[i]);
+			ps->free(spaces[i]);
+		}
+		RS::get_singleton()->free(mesh);
+	}
+#endif // _3D_DISABLED
+}
+
+} // namespace BenchmarkPhysics
+
+#endif // BENCHMARK_PHYSICS_H
@@ -0,0 +1,180 @@
+/**************************************************************************/
+/*  benchmark_templates.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_TEMPLATES_H
+#define BENCHMARK_TEMPLATES_H
+
+#include "core/string/string_name.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/oa_hash_map.h"
+#include "core/templates/rb_map.h"
+#include "core/templates/sort_array.h"
+#include "core/templates/vector.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace BenchmarkTemplates {
+
+const int ELEMENT_COUNT = 10000;
+
+// Keys spread over the hash space, but deterministic between runs.
+static _FORCE_INLINE_ int _key(int p_index) {
+	return (int)hash_murmur3_one_32(p_index);
+}
+
+template <typename M, typename K>
+static _FORCE_INLINE_ int _map_get(const M &p_map, const K &p_key) {
+	return p_map[p_key];
+}
+
+template <typename K>
+static _FORCE_INLINE_ int _map_get(const OAHashMap<K, int> &p_map, const K &p_key) {
+	return *p_map.lookup_ptr(p_key);
+}
+
+template <typename M>
+static _FORCE_INLINE_ int _map_sum(const M &p_map) {
+	int sum = 0;
+	for (const auto &E : p_map) {
+		sum += E.value;
+	}
+	return sum;
+}
+
+template <typename K>
+static _FORCE_INLINE_ int _map_sum(const OAHashMap<K, int> &p_map) {
+	int sum = 0;
+	for (typename OAHashMap<K, int>::Iterator it = p_map.iter(); it.valid; it = p_map.next_iter(it)) {
+		sum += *it.value;
+	}
+	return sum;
+}
+
+// Keys are built once, so the StringName cases don't measure interning.
+static void _make_keys(LocalVector<int> &r_keys, int p_from) {
+	for (int i = 0; i < ELEMENT_COUNT; i++) {
+		r_keys.push_back(_key(p_from + i));
+	}
+}
+
+static void _make_keys(LocalVector<StringName> &r_keys, int p_from) {
+	for (int i = 0; i < ELEMENT_COUNT; i++) {
+		r_keys.push_back(StringName("key_" + itos(_key(p_from + i))));
+	}
+}
+
+template <typename M, typename K>
+static void _bench_map(const String &p_name) {
+	LocalVector<K> keys;
+	LocalVector<K> missing_keys;
+	_make_keys(keys, 0);
+	_make_keys(missing_keys, ELEMENT_COUNT);
+
+	Benchmark::run(p_name + " insert", [&keys]() {
+		M map;
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			map.insert(keys[i], i);
+		}
+		Benchmark::keep(map);
+	});
+
+	M map;
+	for (int i = 0; i < ELEMENT_COUNT; i++) {
+		map.insert(keys[i], i);
+	}
+	Benchmark::run(p_name + " lookup", [&map, &keys]() {
+		int sum = 0;
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			sum += _map_get(map, keys[i]);
+		}
+		Benchmark::keep(sum);
+	});
+	Benchmark::run(p_name + " lookup (missing)", [&map, &missing_keys]() {
+		int found = 0;
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			found += map.has(missing_keys[i]);
+		}
+		Benchmark::keep(found);
+	});
+	Benchmark::run(p_name + " iterate", [&map]() {
+		Benchmark::keep(_map_sum(map));
+	});
+}
+
+BENCHMARK_SUITE("[Templates]") {
+	TEST_CASE("Hash maps") {
+		_bench_map<HashMap<int, int>, int>("HashMap<int, int> 10k");
+		_bench_map<AHashMap<int, int>, int>("AHashMap<int, int> 10k");
+		_bench_map<OAHashMap<int, int>, int>("OAHashMap<int, int> 10k");
+		_bench_map<RBMap<int, int>, int>("RBMap<int, int> 10k");
+	}
+
+	TEST_CASE("Hash maps with StringName keys") {
+		_bench_map<HashMap<StringName, int>, StringName>("HashMap<StringName, int> 10k");
+		_bench_map<AHashMap<StringName, int>, StringName>("AHashMap<StringName, int> 10k");
+		_bench_map<OAHashMap<StringName, int>, StringName>("OAHashMap<StringName, int> 10k");
+		_bench_map<RBMap<StringName, int>, StringName>("RBMap<StringName, int> 10k");
+	}
+
+	TEST_CASE("Vectors") {
+		Benchmark::run("Vector<int> push_back 10k", []() {
+			Vector<int> vector;
+			for (int i = 0; i < ELEMENT_COUNT; i++) {
+				vector.push_back(i);
+			}
+			Benchmark::keep(vector);
+		});
+		Benchmark::run("LocalVector<int> push_back 10k", []() {
+			LocalVector<int> vector;
+			for (int i = 0; i < ELEMENT_COUNT; i++) {
+				vector.push_back(i);
+			}
+			Benchmark::keep(vector);
+		});
+
+		LocalVector<int> values;
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			values.push_back(_key(i));
+		}
+		Benchmark::run("SortArray<int> 10k", [&values]() {
+			LocalVector<int> copy = values;
+			SortArray<int> sorter;
+			sorter.sort(copy.ptr(), copy.size());
+			Benchmark::keep(copy);
+		});
+	}
+}
+
+} // namespace BenchmarkTemplates
+
+#endif // BENCHMARK_TEMPLATES_H
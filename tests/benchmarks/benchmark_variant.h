@@ -0,0 +1,180 @@
+/**************************************************************************/
+/*  benchmark_variant.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_VARIANT_H
+#define BENCHMARK_VARIANT_H
+
+#include "core/string/string_name.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace BenchmarkVariant {
+
+BENCHMARK_SUITE("[Variant]") {
+	TEST_CASE("Operators") {
+		const Variant a = 3;
+		const Variant b = 4.5;
+		Benchmark::run("Variant int + float (evaluate)", [&]() {
+			bool valid = false;
+			Variant r;
+			Variant::evaluate(Variant::OP_ADD, a, b, r, valid);
+			Benchmark::keep(r);
+		});
+
+		Variant::ValidatedOperatorEvaluator add = Variant::get_validated_operator_evaluator(Variant::OP_ADD, Variant::VECTOR3, Variant::VECTOR3);
+		const Variant v1 = Vector3(1, 2, 3);
+		const Variant v2 = Vector3(4, 5, 6);
+		Benchmark::run("Variant Vector3 + Vector3 (validated)", [&]() {
+			Variant r = Vector3();
+			add(&v1, &v2, &r);
+			Benchmark::keep(r);
+		});
+	}
+
+	TEST_CASE("Calls") {
+		Variant string = "The quick brown fox jumps over the lazy dog";
+		const StringName length = "length";
+		Benchmark::run("Variant::callp String.length()", [&]() {
+			Callable::CallError ce;
+			Variant r;
+			string.callp(length, nullptr, 0, r, ce);
+			Benchmark::keep(r);
+		});
+
+		Variant vector = Vector3(1, 2, 3);
+		const Variant other = Vector3(3, 2, 1);
+		const Variant *args[1] = { &other };
+		const StringName dot = "dot";
+		Benchmark::run("Variant::callp Vector3.dot()", [&]() {
+			Callable::CallError ce;
+			Variant r;
+			vector.callp(dot, args, 1, r, ce);
+			Benchmark::keep(r);
+		});
+
+		Variant::ValidatedBuiltInMethod validated_dot = Variant::get_validated_builtin_method(Variant::VECTOR3, dot);
+		Benchmark::run("Variant Vector3.dot() (validated)", [&]() {
+			Variant r = 0.0;
+			validated_dot(&vector, args, 1, &r);
+			Benchmark::keep(r);
+		});
+	}
+
+	TEST_CASE("Construction and conversion") {
+		Benchmark::run("Variant from String and back", []() {
+			Variant v = String("benchmark");
+			String s = v;
+			Benchmark::keep(s);
+		});
+		Benchmark::run("Variant from Array of 16 ints", []() {
+			Array array;
+			for (int i = 0; i < 16; i++) {
+				array.push_back(i);
+			}
+			Variant v = array;
+			Benchmark::keep(v);
+		});
+	}
+}
+
+BENCHMARK_SUITE("[StringName]") {
+	TEST_CASE("Interning") {
+		Benchmark::run("StringName from existing String", []() {
+			StringName name = String("position");
+			Benchmark::keep(name);
+		});
+		Benchmark::run("StringName from static C string", []() {
+			StringName name = StringName("position", true);
+			Benchmark::keep(name);
+		});
+
+		LocalVector<String> strings;
+		for (int i = 0; i < 1000; i++) {
+			strings.push_back("benchmark_name_" + itos(i));
+		}
+		Benchmark::run("StringName intern and release 1000 new names", [&strings]() {
+			for (const String &string : strings) {
+				StringName name = string;
+				Benchmark::keep(name);
+			}
+		});
+
+		const StringName a = "position";
+		const StringName b = "rotation";
+		Benchmark::run("StringName compare", [&]() {
+			bool equal = a == b;
+			Benchmark::keep(equal);
+		});
+	}
+}
+
+BENCHMARK_SUITE("[String]") {
+	TEST_CASE("Operations") {
+		const String text = String("The quick brown fox jumps over the lazy dog. ").repeat(20);
+		Benchmark::run("String concatenation", [&]() {
+			String result = text + text;
+			Benchmark::keep(result);
+		});
+		Benchmark::run("String::find (late match)", [&]() {
+			int pos = text.find("lazy dog. The quick", 800);
+			Benchmark::keep(pos);
+		});
+		Benchmark::run("String::replace", [&]() {
+			String result = text.replace("fox", "cat");
+			Benchmark::keep(result);
+		});
+		Benchmark::run("String::split", [&]() {
+			Vector<String> words = text.split(" ");
+			Benchmark::keep(words);
+		});
+		Benchmark::run("String::utf8 and back", [&]() {
+			String result = String::utf8(text.utf8().get_data());
+			Benchmark::keep(result);
+		});
+		Benchmark::run("String::hash", [&]() {
+			uint32_t hash = text.hash();
+			Benchmark::keep(hash);
+		});
+		Benchmark::run("String::to_lower", [&]() {
+			String result = text.to_lower();
+			Benchmark::keep(result);
+		});
+		Benchmark::run("vformat", []() {
+			String result = vformat("%s: %d (%.2f)", "value", 42, 3.14159);
+			Benchmark::keep(result);
+		});
+	}
+}
+
+} // namespace BenchmarkVariant
+
+#endif // BENCHMARK_VARIANT_H
@@ -0,0 +1,177 @@
+/**************************************************************************/
+/*  test_compression.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_COMPRESSION_H
+#define TEST_COMPRESSION_H
+
+#include "core/io/compression.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCompression {
+
+static Vector<uint8_t> _make_message(int p_index) {
+	// Small, similar payloads, like game state updates sent over the network.
+	String state = p_index % 3 ? "running" : "idle";
+	CharString text = ("{\"player\":" + itos(p_index) + ",\"position\":[" + itos(p_index * 7 % 1000) + "," + itos(p_index * 13 % 1000) + "],\"health\":" + itos(100 - p_index % 100) + ",\"state\":\"" + state + "\",\"inventory\":[\"sword\",\"shield\",\"potion\"]}").utf8();
+	Vector<uint8_t> message;
+	message.resize(text.length());
+	memcpy(message.ptrw(), text.get_data(), text.length());
+	return message;
+}
+
+static Vector<uint8_t> _make_payload(int p_messages) {
+	Vector<uint8_t> payload;
+	for (int i = 0; i < p_messages; i++) {
+		payload.append_array(_make_message(i));
+	}
+	return payload;
+}
+
+// Feeds p_src through p_stream in small chunks, to exercise partial input and output.
+static Vector<uint8_t> _process_chunked(CompressionStream &p_stream, const Vector<uint8_t> &p_src, bool p_finish) {
+	const int CHUNK = 97;
+	uint8_t out[64];
+	Vector<uint8_t> result;
+	int offset = 0;
+	while (!p_stream.is_finished()) {
+		int to_read = MIN(CHUNK, p_src.size() - offset);
+		int consumed = 0;
+		int produced = 0;
+		Error err = p_stream.process(out, sizeof(out), p_src.ptr() + offset, to_read, consumed, produced, p_finish && offset + to_read == p_src.size());
+		REQUIRE(err == OK);
+		offset += consumed;
+		for (int i = 0; i < produced; i++) {
+			result.push_back(out[i]);
+		}
+		if (!p_finish && offset == p_src.size() && produced == 0) {
+			break;
+		}
+	}
+	return result;
+}
+
+TEST_CASE("[Compression] Streaming round trip") {
+	const Vector<uint8_t> payload = _make_payload(64);
+
+	Compression::Mode modes[] = { Compression::MODE_DEFLATE, Compression::MODE_GZIP, Compression::MODE_ZSTD };
+	for (Compression::Mode mode : modes) {
+		CompressionStream compressor;
+		REQUIRE(compressor.start_compression(mode, Compression::get_default_level(mode)) == OK);
+		Vector<uint8_t> compressed = _process_chunked(compressor, payload, true);
+		CHECK(compressor.is_finished());
+		CHECK(compressed.size() < payload.size());
+
+		// Frames produced by a stream are readable by the one-shot API.
+		Vector<uint8_t> decompressed;
+		decompressed.resize(payload.size());
+		CHECK(Compression::decompress(decompressed.ptrw(), decompressed.size(), compressed.ptr(), compressed.size(), mode) == payload.size());
+		CHECK(decompressed == payload);
+
+		CompressionStream decompressor;
+		REQUIRE(decompressor.start_decompression(mode) == OK);
+		CHECK(_process_chunked(decompressor, compressed, false) == payload);
+		CHECK(decompressor.is_finished());
+	}
+}
+
+TEST_CASE("[Compression] Reusing a stream for many small frames") {
+	Compression::Mode modes[] = { Compression::MODE_FASTLZ, Compression::MODE_DEFLATE, Compression::MODE_GZIP, Compression::MODE_ZSTD };
+	for (Compression::Mode mode : modes) {
+		CompressionStream compressor;
+		CompressionStream decompressor;
+		REQUIRE(compressor.start_compression(mode, Compression::get_default_level(mode)) == OK);
+		REQUIRE(decompressor.start_decompression(mode) == OK);
+
+		Vector<uint8_t> compressed;
+		Vector<uint8_t> decompressed;
+		for (int i = 0; i < 32; i++) {
+			if (mode == Compression::MODE_ZSTD) {
+				compressor.set_level(1 + i % 5);
+			}
+			const Vector<uint8_t> message = _make_message(i);
+			compressed.resize(Compression::get_max_compressed_buffer_size(message.size(), mode));
+			int size = compressor.compress(compressed.ptrw(), compressed.size(), message.ptr(), message.size());
+			REQUIRE(size > 0);
+
+			decompressed.resize(message.size());
+			CHECK(decompressor.decompress(decompressed.ptrw(), decompressed.size(), compressed.ptr(), size) == message.size());
+			CHECK(decompressed == message);
+		}
+	}
+}
+
+TEST_CASE("[Compression] Zstandard dictionaries") {
+	Vector<Vector<uint8_t>> samples;
+	for (int i = 0; i < 256; i++) {
+		samples.push_back(_make_message(i * 3 + 1));
+	}
+	const Vector<uint8_t> dictionary = Compression::train_zstd_dictionary(samples, 1024);
+	CHECK(dictionary.size() > 0);
+	CHECK(dictionary.size() <= 1024);
+
+	CompressionStream plain;
+	CompressionStream compressor;
+	CompressionStream decompressor;
+	REQUIRE(plain.start_compression(Compression::MODE_ZSTD, 3) == OK);
+	REQUIRE(compressor.start_compression(Compression::MODE_ZSTD, 3) == OK);
+	REQUIRE(compressor.set_dictionary(dictionary) == OK);
+	REQUIRE(decompressor.start_decompression(Compression::MODE_ZSTD) == OK);
+	REQUIRE(decompressor.set_dictionary(dictionary) == OK);
+
+	int plain_total = 0;
+	int dictionary_total = 0;
+	Vector<uint8_t> compressed;
+	Vector<uint8_t> decompressed;
+	for (int i = 0; i < 16; i++) {
+		const Vector<uint8_t> message = _make_message(i * 5);
+		compressed.resize(Compression::get_max_compressed_buffer_size(message.size(), Compression::MODE_ZSTD));
+		plain_total += plain.compress(compressed.ptrw(), compressed.size(), message.ptr(), message.size());
+		int size = compressor.compress(compressed.ptrw(), compressed.size(), message.ptr(), message.size());
+		REQUIRE(size > 0);
+		dictionary_total += size;
+
+		decompressed.resize(message.size());
+		CHECK(decompressor.decompress(decompressed.ptrw(), decompressed.size(), compressed.ptr(), size) == message.size());
+		CHECK(decompressed == message);
+	}
+	CHECK_MESSAGE(dictionary_total * 2 < plain_total, "A trained dictionary should at least halve the size of small similar messages.");
+
+	// Dictionaries are only available with Zstandard.
+	CompressionStream deflate;
+	REQUIRE(deflate.start_compression(Compression::MODE_DEFLATE, 6) == OK);
+	ERR_PRINT_OFF;
+	CHECK(deflate.set_dictionary(dictionary) == ERR_UNAVAILABLE);
+	ERR_PRINT_ON;
+}
+
+} // namespace TestCompression
+
+#endif // TEST_COMPRESSION_H
@@ -107,6 +107,43 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Memory mapped reads") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(!f.is_null());
+	const String expected = f->get_as_utf8_string();
+	const uint64_t length = f->get_length();
+
+	f->seek(6);
+	if (!f->map_for_read()) {
+		// Not supported by this platform's file access, nothing else to test.
+		CHECK(f->get_buffer_mapped(1) == nullptr);
+		return;
+	}
+
+	// Mapping keeps the position and the regular API working.
+	CHECK(f->get_position() == 6);
+	CHECK(f->get_8() == 'd');
+	f->seek(0);
+	CHECK(f->get_as_utf8_string() == expected);
+	CHECK(f->get_length() == length);
+
+	f->seek(0);
+	const uint8_t *data = f->get_buffer_mapped(5);
+	REQUIRE(data != nullptr);
+	CHECK(String::utf8((const char *)data, 5) == "Hello");
+	CHECK(f->get_position() == 5);
+
+	// Out of range views fail without moving.
+	CHECK(f->get_buffer_mapped(length) == nullptr);
+	CHECK(f->get_position() == 5);
+
+	f->seek_end(-1);
+	CHECK(f->get_8() == '\n');
+	CHECK(!f->eof_reached());
+	f->get_8();
+	CHECK(f->eof_reached());
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
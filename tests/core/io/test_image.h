@@ -32,6 +32,7 @@
 #define TEST_IMAGE_H
 
 #include "core/io/image.h"
+#include "core/io/image_kernels.h"
 #include "core/os/os.h"
 
 #include "tests/test_utils.h"
@@ -432,6 +433,42 @@ TEST_CASE("[Image] Convert image") {
 	CHECK_MESSAGE(image2->get_data() == image_data, "Image conversion to invalid type (Image::FORMAT_MAX + 1) should not alter image.");
 }
 
+TEST_CASE("[Image] Row kernel backends match the scalar one") {
+	// Odd sizes, so the SIMD kernels also go through their scalar tails.
+	Vector<uint8_t> data;
+	data.resize(37 * 21 * 4);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = (i * 37 + (i >> 5) * 11) & 0xFF;
+	}
+
+	const ImageKernels::Backend best_backend = ImageKernels::get_best_backend();
+	const Image::Format formats[] = { Image::FORMAT_RGBA8, Image::FORMAT_RGBAF };
+	for (Image::Format format : formats) {
+		Ref<Image> image = Image::create_from_data(37, 21, false, Image::FORMAT_RGBA8, data);
+		image->convert(format);
+		const String format_name = Image::get_format_name(format);
+
+		ImageKernels::set_backend(ImageKernels::BACKEND_SCALAR);
+		Ref<Image> expected_mipmaps = image->duplicate();
+		expected_mipmaps->generate_mipmaps();
+		Ref<Image> expected_lanczos = image->duplicate();
+		expected_lanczos->resize(15, 52, Image::INTERPOLATE_LANCZOS);
+
+		ImageKernels::set_backend(best_backend);
+		Ref<Image> mipmaps = image->duplicate();
+		mipmaps->generate_mipmaps();
+		Ref<Image> lanczos = image->duplicate();
+		lanczos->resize(15, 52, Image::INTERPOLATE_LANCZOS);
+
+		CHECK_MESSAGE(
+				mipmaps->get_data() == expected_mipmaps->get_data(),
+				vformat("%s mipmaps should be the same with the %s and scalar image kernels.", format_name, ImageKernels::get_backend_name(best_backend)));
+		CHECK_MESSAGE(
+				lanczos->get_data() == expected_lanczos->get_data(),
+				vformat("%s Lanczos resizing should be the same with the %s and scalar image kernels.", format_name, ImageKernels::get_backend_name(best_backend)));
+	}
+}
+
 } // namespace TestImage
 
 #endif // TEST_IMAGE_H
@@ -386,6 +386,75 @@ TEST_CASE("[Marshalls] Typed array decoding") {
 	CHECK(array[0] == Variant(uint64_t(0x0f123456789abcdef)));
 }
 
+TEST_CASE("[Marshalls] VariantEncoder matches encode_variant") {
+	Array array;
+	array.push_back(1);
+	array.push_back("two");
+	const Variant values[] = { Variant(), true, 42, int64_t(1) << 40, 0.5, 0.1, Vector3(1, 2, 3), Projection(), Color(1, 0, 0), "string", StringName("name"), array, PackedByteArray() };
+
+	VariantEncoder encoder;
+	Vector<uint8_t> expected;
+	for (const Variant &value : values) {
+		int len = 0;
+		REQUIRE(encode_variant(value, nullptr, len) == OK);
+		int ofs = expected.size();
+		expected.resize(ofs + len);
+		REQUIRE(encode_variant(value, expected.ptrw() + ofs, len) == OK);
+		REQUIRE(encoder.append(value) == OK);
+	}
+	REQUIRE(encoder.get_size() == expected.size());
+	CHECK(memcmp(encoder.get_data(), expected.ptr(), expected.size()) == 0);
+
+	VariantDecoder decoder(encoder.get_data(), encoder.get_size());
+	for (const Variant &value : values) {
+		Variant decoded;
+		REQUIRE(decoder.next(decoded) == OK);
+		CHECK(decoded == value);
+	}
+	CHECK(decoder.is_at_end());
+	ERR_PRINT_OFF;
+	Variant extra;
+	CHECK(decoder.next(extra) == ERR_FILE_EOF);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[Marshalls] VariantEncoder compact encoding") {
+	const Variant values[] = { true, false, 0, -128, 127, 300, -70000, int64_t(1) << 40, 1.5, Vector2(1, 2), "string" };
+
+	VariantEncoder encoder(false, true);
+	// Run twice to check that clearing keeps working with the retained buffer.
+	for (int pass = 0; pass < 2; pass++) {
+		encoder.clear();
+		for (const Variant &value : values) {
+			REQUIRE(encoder.append(value) == OK);
+		}
+
+		const uint8_t *data = encoder.get_data();
+		CHECK_MESSAGE(data[0] == (Variant::BOOL | VariantEncoder::COMPACT_BOOL_MASK), "Booleans use a single byte.");
+		CHECK(data[1] == Variant::BOOL);
+		CHECK_MESSAGE(data[2] == (Variant::INT | VariantEncoder::COMPACT_MODE_8), "Small integers use 1 byte after the type.");
+		CHECK(data[3] == 0);
+
+		VariantDecoder decoder(data, encoder.get_size(), false, true);
+		for (const Variant &value : values) {
+			Variant decoded;
+			REQUIRE(decoder.next(decoded) == OK);
+			CHECK(decoded == value);
+		}
+		CHECK(decoder.is_at_end());
+	}
+
+	// Truncated data is rejected.
+	VariantDecoder truncated(encoder.get_data(), 5, false, true);
+	Variant decoded;
+	CHECK(truncated.next(decoded) == OK);
+	CHECK(truncated.next(decoded) == OK);
+	CHECK(truncated.next(decoded) == OK);
+	ERR_PRINT_OFF;
+	CHECK(truncated.next(decoded) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+}
+
 } // namespace TestMarshalls
 
 #endif // TEST_MARSHALLS_H
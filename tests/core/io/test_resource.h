@@ -166,6 +166,52 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource] Loading binary resources with sub-threads") {
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Main");
+	Array children;
+	for (int i = 0; i < 16; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name(vformat("Child %d", i));
+		PackedFloat32Array data;
+		data.resize(1000);
+		for (int j = 0; j < 1000; j++) {
+			data.set(j, i * 1000 + j);
+		}
+		child->set_meta("data", data);
+		if (i > 0) {
+			child->set_meta("previous", children[i - 1]);
+		}
+		children.push_back(child);
+	}
+	resource->set_meta("children", children);
+
+	const String save_path = OS::get_singleton()->get_cache_path().path_join("resource_sub_threads.res");
+	ResourceSaver::save(resource, save_path);
+
+	REQUIRE(ResourceLoader::load_threaded_request(save_path, "", true, ResourceFormatLoader::CACHE_MODE_IGNORE) == OK);
+	const Ref<Resource> loaded_resource = ResourceLoader::load_threaded_get(save_path);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(loaded_resource->get_name() == "Main");
+
+	const Array loaded_children = loaded_resource->get_meta("children");
+	REQUIRE(loaded_children.size() == 16);
+	for (int i = 0; i < 16; i++) {
+		const Ref<Resource> child = loaded_children[i];
+		REQUIRE(child.is_valid());
+		CHECK(child->get_name() == vformat("Child %d", i));
+		const PackedFloat32Array data = child->get_meta("data");
+		REQUIRE(data.size() == 1000);
+		CHECK(data[0] == i * 1000);
+		CHECK(data[999] == i * 1000 + 999);
+		if (i > 0) {
+			CHECK_MESSAGE(
+					Ref<Resource>(child->get_meta("previous")) == loaded_children[i - 1],
+					"References between sub-resources should point to the loaded sub-resources.");
+		}
+	}
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
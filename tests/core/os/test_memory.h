@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MEMORY_H
+#define TEST_MEMORY_H
+
+#include "core/os/memory.h"
+#include "core/os/thread.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestMemory {
+
+TEST_CASE("[Memory] Reallocation keeps contents") {
+	// Goes through small and large sizes, so blocks move between allocators when enabled.
+	const size_t sizes[] = { 1, 16, 17, 100, 512, 513, 4096, 300, 8, 0 };
+	uint8_t *mem = nullptr;
+	size_t prev_size = 0;
+
+	for (size_t size : sizes) {
+		mem = (uint8_t *)Memory::realloc_static(mem, size, true);
+		if (size == 0) {
+			CHECK(mem == nullptr);
+			break;
+		}
+		REQUIRE(mem != nullptr);
+		for (size_t i = 0; i < MIN(size, prev_size); i++) {
+			CHECK_MESSAGE(mem[i] == uint8_t(i * 7), "Contents should be kept when reallocating.");
+		}
+		for (size_t i = 0; i < size; i++) {
+			mem[i] = uint8_t(i * 7);
+		}
+		prev_size = size;
+	}
+}
+
+static void free_blocks(void *p_userdata) {
+	uint8_t **blocks = (uint8_t **)p_userdata;
+	for (int i = 0; i < 1000; i++) {
+		for (int j = 0; j < 24; j++) {
+			CHECK(blocks[i][j] == uint8_t(i));
+		}
+		memfree(blocks[i]);
+	}
+}
+
+TEST_CASE("[Memory] Free from another thread") {
+	uint8_t *blocks[1000];
+	for (int i = 0; i < 1000; i++) {
+		blocks[i] = (uint8_t *)memalloc(24);
+		memset(blocks[i], i, 24);
+	}
+
+	Thread thread;
+	thread.start(free_blocks, blocks);
+	thread.wait_to_finish();
+
+	// Blocks freed by the other thread can be reused here.
+	for (int i = 0; i < 1000; i++) {
+		blocks[i] = (uint8_t *)memalloc(24);
+		memset(blocks[i], 0xFF, 24);
+	}
+	for (int i = 0; i < 1000; i++) {
+		memfree(blocks[i]);
+	}
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Memory] Usage statistics") {
+	const uint64_t usage = Memory::get_mem_usage();
+	void *mem = memalloc(1000);
+	CHECK(Memory::get_mem_usage() >= usage + 1000);
+	CHECK(Memory::get_mem_max_usage() >= Memory::get_mem_usage());
+	memfree(mem);
+}
+#endif
+
+} // namespace TestMemory
+
+#endif // TEST_MEMORY_H
@@ -32,6 +32,7 @@
 #define TEST_WORKER_THREAD_POOL_H
 
 #include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -173,6 +174,59 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+struct StealTestData {
+	LocalVector<WorkerThreadPool::TaskID> task_ids;
+	SafeNumeric<uint32_t> done;
+};
+
+static void steal_test_count(void *p_arg) {
+	((StealTestData *)p_arg)->done.increment();
+}
+
+static void steal_test_block(void *p_arg) {
+	StealTestData *data = (StealTestData *)p_arg;
+	// Tasks posted from a pool thread go to its own queue. This thread keeps busy
+	// until they are done, so every one of them has to be stolen by another thread.
+	for (uint32_t i = 0; i < data->task_ids.size(); i++) {
+		data->task_ids[i] = WorkerThreadPool::get_singleton()->add_native_task(steal_test_count, data, true);
+	}
+	while (data->done.get() < data->task_ids.size()) {
+		OS::get_singleton()->delay_usec(100);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Contention statistics") {
+	if (WorkerThreadPool::get_singleton()->get_thread_count() < 2) {
+		MESSAGE("Skipping, stealing needs at least two pool threads.");
+		return;
+	}
+
+	WorkerThreadPool::get_singleton()->reset_contention_stats();
+	WorkerThreadPool::ContentionStats stats = WorkerThreadPool::get_singleton()->get_contention_stats();
+	CHECK(stats.task_mutex_contentions == 0);
+	CHECK(stats.queue_contentions == 0);
+	CHECK(stats.stolen_tasks == 0);
+
+	const uint32_t count = 64;
+	StealTestData data;
+	data.task_ids.resize(count);
+	WorkerThreadPool::TaskID block_id = WorkerThreadPool::get_singleton()->add_native_task(steal_test_block, &data, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(block_id);
+	for (uint32_t i = 0; i < count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(data.task_ids[i]);
+	}
+	CHECK(data.done.get() == count);
+
+	stats = WorkerThreadPool::get_singleton()->get_contention_stats();
+	CHECK_MESSAGE(stats.stolen_tasks >= count, "Every task queued behind the busy thread should have been stolen.");
+
+	WorkerThreadPool::get_singleton()->reset_contention_stats();
+	stats = WorkerThreadPool::get_singleton()->get_contention_stats();
+	CHECK(stats.task_mutex_contentions == 0);
+	CHECK(stats.queue_contentions == 0);
+	CHECK(stats.stolen_tasks == 0);
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
@@ -51,6 +51,22 @@ public:
 	Variant function1_latest_arg0{};
 };
 
+// Waits for another path query batch from its own path query callback.
+class PathQueryWaiterMock : public Object {
+	GDCLASS(PathQueryWaiterMock, Object);
+
+public:
+	void on_path_query_completed(int64_t p_query_id) {
+		NavigationServer3D::get_singleton()->wait_for_path_query(other_query_id);
+		other_query_completed = NavigationServer3D::get_singleton()->is_path_query_completed(other_query_id);
+		calls++;
+	}
+
+	int64_t other_query_id = 0;
+	bool other_query_completed = false;
+	unsigned calls = 0;
+};
+
 static inline Array build_array() {
 	return Array();
 }
@@ -697,8 +713,11 @@ TEST_SUITE("[Navigation]") {
 			CHECK_NE(navigation_server->map_get_closest_point(map, Vector3(0, 0, 0)), Vector3(0, 0, 0));
 			CHECK_NE(navigation_server->map_get_closest_point_normal(map, Vector3(0, 0, 0)), Vector3());
 			CHECK(navigation_server->map_get_closest_point_owner(map, Vector3(0, 0, 0)).is_valid());
-			// TODO: Test map_get_closest_point_to_segment() with p_use_collision=true as well.
 			CHECK_NE(navigation_server->map_get_closest_point_to_segment(map, Vector3(0, 0, 0), Vector3(1, 1, 1), false), Vector3());
+			const Vector3 segment_collision_point = navigation_server->map_get_closest_point_to_segment(map, Vector3(1, 5, 1), Vector3(1, -5, 1), true);
+			CHECK(segment_collision_point.x == doctest::Approx(1.0));
+			CHECK(segment_collision_point.z == doctest::Approx(1.0));
+			CHECK_EQ(navigation_server->map_get_closest_point_to_segment(map, Vector3(20, 5, 20), Vector3(20, -5, 20), true), Vector3());
 			CHECK_NE(navigation_server->map_get_path(map, Vector3(0, 0, 0), Vector3(10, 0, 10), true).size(), 0);
 			CHECK_NE(navigation_server->map_get_path(map, Vector3(0, 0, 0), Vector3(10, 0, 10), false).size(), 0);
 		}
@@ -759,11 +778,343 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(query_result->get_path_owner_ids().size(), 0);
 		}
 
+		SUBCASE("Asynchronous query batch should be solved during the next steps") {
+			TypedArray<NavigationPathQueryParameters3D> query_parameters;
+			TypedArray<NavigationPathQueryResult3D> query_results;
+			for (int i = 0; i < 4; i++) {
+				Ref<NavigationPathQueryParameters3D> parameters = memnew(NavigationPathQueryParameters3D);
+				parameters->set_map(map);
+				parameters->set_start_position(Vector3(i, 0, 0));
+				parameters->set_target_position(Vector3(10, 0, 10));
+				query_parameters.push_back(parameters);
+				query_results.push_back(memnew(NavigationPathQueryResult3D));
+			}
+			const int64_t query_id = navigation_server->query_path_async(query_parameters, query_results);
+			CHECK_GT(query_id, 0);
+			CHECK_FALSE(navigation_server->is_path_query_completed(query_id));
+			navigation_server->process(0.0); // Dispatches the batch.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_QUERY_DISPATCH_COUNT), 4);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_QUERY_QUEUE_DEPTH), 0);
+			navigation_server->process(0.0); // Publishes the results.
+			CHECK(navigation_server->is_path_query_completed(query_id));
+			for (int i = 0; i < query_results.size(); i++) {
+				Ref<NavigationPathQueryResult3D> result = query_results[i];
+				CHECK_NE(result->get_path().size(), 0);
+				CHECK_NE(result->get_path_rids().size(), 0);
+			}
+		}
+
+		SUBCASE("Waiting for an asynchronous query batch should publish its results right away") {
+			TypedArray<NavigationPathQueryParameters3D> query_parameters;
+			TypedArray<NavigationPathQueryResult3D> query_results;
+			Ref<NavigationPathQueryParameters3D> parameters = memnew(NavigationPathQueryParameters3D);
+			parameters->set_map(map);
+			parameters->set_start_position(Vector3(10, 0, 10));
+			parameters->set_target_position(Vector3(0, 0, 0));
+			query_parameters.push_back(parameters);
+			Ref<NavigationPathQueryResult3D> result = memnew(NavigationPathQueryResult3D);
+			query_results.push_back(result);
+			const int64_t query_id = navigation_server->query_path_async(query_parameters, query_results);
+			navigation_server->wait_for_path_query(query_id);
+			CHECK(navigation_server->is_path_query_completed(query_id));
+			CHECK_NE(result->get_path().size(), 0);
+		}
+
+		SUBCASE("Waiting for a batch from the callback of another batch of the same dispatch should not solve it again") {
+			TypedArray<NavigationPathQueryResult3D> results[2];
+			int64_t query_ids[2];
+			PathQueryWaiterMock waiter;
+			CallableMock other_callback_mock;
+			for (int i = 0; i < 2; i++) {
+				TypedArray<NavigationPathQueryParameters3D> query_parameters;
+				Ref<NavigationPathQueryParameters3D> parameters = memnew(NavigationPathQueryParameters3D);
+				parameters->set_map(map);
+				parameters->set_start_position(Vector3(10, 0, 10));
+				parameters->set_target_position(Vector3(0, 0, 0));
+				query_parameters.push_back(parameters);
+				results[i].push_back(memnew(NavigationPathQueryResult3D));
+				const Callable callback = i == 0 ? callable_mp(&waiter, &PathQueryWaiterMock::on_path_query_completed) : callable_mp(&other_callback_mock, &CallableMock::function1);
+				query_ids[i] = navigation_server->query_path_async(query_parameters, results[i], callback);
+			}
+			waiter.other_query_id = query_ids[1];
+			navigation_server->process(0.0); // Dispatches both batches.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_QUERY_DISPATCH_COUNT), 2);
+			navigation_server->process(0.0); // Publishes the results and runs the callbacks.
+			CHECK_EQ(waiter.calls, 1);
+			CHECK(waiter.other_query_completed);
+			CHECK_EQ(other_callback_mock.function1_calls, 1);
+			CHECK_EQ(other_callback_mock.function1_latest_arg0, Variant(query_ids[1]));
+			for (int i = 0; i < 2; i++) {
+				CHECK(navigation_server->is_path_query_completed(query_ids[i]));
+				Ref<NavigationPathQueryResult3D> result = results[i][0];
+				CHECK_NE(result->get_path().size(), 0);
+			}
+		}
+
 		navigation_server->free(region);
 		navigation_server->free(map);
 		navigation_server->process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should bake navigation mesh tiles") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_tile_size(2.5);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(10.0, 0.001, 10.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		const int polygon_count = navigation_mesh->get_polygon_count();
+		CHECK_NE(polygon_count, 0);
+		CHECK_NE(navigation_mesh->get_vertices().size(), 0);
+
+		SUBCASE("Baking tiles again with the same geometry should give the same polygons") {
+			navigation_server->bake_tiles_from_source_geometry_data(navigation_mesh, source_geometry, AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)));
+			CHECK_EQ(navigation_mesh->get_polygon_count(), polygon_count);
+		}
+
+		SUBCASE("Baking tiles again without geometry should only clear those tiles") {
+			Ref<NavigationMeshSourceGeometryData3D> empty_source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+			navigation_server->bake_tiles_from_source_geometry_data(navigation_mesh, empty_source_geometry, AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)));
+			CHECK_GT(navigation_mesh->get_polygon_count(), 0);
+			CHECK_LT(navigation_mesh->get_polygon_count(), polygon_count);
+
+			// The touched tiles cover [-2.5, 2.5) on both axes.
+			const Vector<Vector3> vertices = navigation_mesh->get_vertices();
+			int polygons_in_cleared_tiles = 0;
+			for (int i = 0; i < navigation_mesh->get_polygon_count(); i++) {
+				const Vector<int> polygon = navigation_mesh->get_polygon(i);
+				Vector3 center;
+				for (int index : polygon) {
+					center += vertices[index];
+				}
+				center /= polygon.size();
+				if (center.x >= -2.5 && center.x < 2.5 && center.z >= -2.5 && center.z < 2.5) {
+					polygons_in_cleared_tiles++;
+				}
+			}
+			CHECK_EQ(polygons_in_cleared_tiles, 0);
+		}
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should merge regions added to or removed from a map") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A single 2x2 quad.
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Vector<Vector3> vertices;
+		vertices.push_back(Vector3(0, 0, 0));
+		vertices.push_back(Vector3(2, 0, 0));
+		vertices.push_back(Vector3(2, 0, 2));
+		vertices.push_back(Vector3(0, 0, 2));
+		navigation_mesh->set_vertices(vertices);
+		Vector<int> polygon;
+		polygon.push_back(0);
+		polygon.push_back(1);
+		polygon.push_back(2);
+		polygon.push_back(3);
+		navigation_mesh->add_polygon(polygon);
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		RID regions[3];
+		for (int i = 0; i < 3; i++) {
+			regions[i] = navigation_server->region_create();
+			navigation_server->region_set_map(regions[i], map);
+			navigation_server->region_set_transform(regions[i], Transform3D(Basis(), Vector3(i * 2, 0, 0)));
+			navigation_server->region_set_navigation_mesh(regions[i], navigation_mesh);
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector3 start(1, 0, 1);
+		const Vector3 end(5, 0, 1);
+
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 3);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT), 10);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 2);
+		Vector<Vector3> path = navigation_server->map_get_path(map, start, end, true);
+		REQUIRE_FALSE(path.is_empty());
+		CHECK(path[path.size() - 1].is_equal_approx(end));
+
+		SUBCASE("Removing a region in the middle should disconnect its neighbors") {
+			navigation_server->free(regions[1]);
+			regions[1] = RID();
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 2);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT), 8);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 0);
+			path = navigation_server->map_get_path(map, start, end, true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].x <= 2.0);
+
+			// Streaming it back in connects the map again.
+			regions[1] = navigation_server->region_create();
+			navigation_server->region_set_map(regions[1], map);
+			navigation_server->region_set_transform(regions[1], Transform3D(Basis(), Vector3(2, 0, 0)));
+			navigation_server->region_set_navigation_mesh(regions[1], navigation_mesh);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 2);
+			path = navigation_server->map_get_path(map, start, end, true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].is_equal_approx(end));
+		}
+
+		SUBCASE("Moving a region next to a gap should connect the edges around it") {
+			// Far enough for the edges to fall in different merge cells, but within the connection margin.
+			navigation_server->map_set_edge_connection_margin(map, 0.5);
+			navigation_server->region_set_transform(regions[2], Transform3D(Basis(), Vector3(4.3, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 1);
+			CHECK_EQ(navigation_server->region_get_connections_count(regions[1]), 1);
+			CHECK_EQ(navigation_server->region_get_connections_count(regions[2]), 1);
+			CHECK_EQ(navigation_server->region_get_connections_count(regions[0]), 0);
+			path = navigation_server->map_get_path(map, start, end, true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].is_equal_approx(end));
+		}
+
+		for (int i = 0; i < 3; i++) {
+			if (regions[i].is_valid()) {
+				navigation_server->free(regions[i]);
+			}
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should search long paths over polygon clusters") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A 32x8 strip of 1x1 quads, cut by a wall with a gap at one end, several clusters long.
+		const int SIZE_X = 32;
+		const int SIZE_Z = 8;
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= SIZE_Z; z++) {
+			for (int x = 0; x <= SIZE_X; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < SIZE_Z; z++) {
+			for (int x = 0; x < SIZE_X; x++) {
+				if (x == SIZE_X / 2 && z != 0) {
+					continue;
+				}
+				const int i = z * (SIZE_X + 1) + x;
+				Vector<int> polygon;
+				polygon.push_back(i);
+				polygon.push_back(i + 1);
+				polygon.push_back(i + SIZE_X + 2);
+				polygon.push_back(i + SIZE_X + 1);
+				navigation_mesh->add_polygon(polygon);
+			}
+		}
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+		RID regions[3];
+		for (int i = 0; i < 3; i++) {
+			regions[i] = navigation_server->region_create();
+			navigation_server->region_set_map(regions[i], map);
+			navigation_server->region_set_transform(regions[i], Transform3D(Basis(), Vector3(i * SIZE_X, 0, 0)));
+			navigation_server->region_set_navigation_mesh(regions[i], navigation_mesh);
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		CHECK(navigation_server->map_get_use_hierarchical_pathfinding(map));
+
+		const Vector3 start(0.5, 0, SIZE_Z - 0.5);
+		const Vector3 end(SIZE_X * 3 - 0.5, 0, SIZE_Z - 0.5);
+		const auto path_length = [](const Vector<Vector3> &p_path) {
+			real_t length = 0.0;
+			for (int i = 1; i < p_path.size(); i++) {
+				length += p_path[i - 1].distance_to(p_path[i]);
+			}
+			return length;
+		};
+
+		Vector<Vector3> path = navigation_server->map_get_path(map, start, end, true);
+		REQUIRE_FALSE(path.is_empty());
+		CHECK(path[0].is_equal_approx(start));
+		CHECK(path[path.size() - 1].is_equal_approx(end));
+		const real_t hierarchical_length = path_length(path);
+
+		SUBCASE("Paths should be close to the ones of the flat search") {
+			navigation_server->map_set_use_hierarchical_pathfinding(map, false);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			Vector<Vector3> flat_path = navigation_server->map_get_path(map, start, end, true);
+			REQUIRE_FALSE(flat_path.is_empty());
+			CHECK(flat_path[flat_path.size() - 1].is_equal_approx(end));
+			CHECK(hierarchical_length <= path_length(flat_path) * 1.1);
+		}
+
+		SUBCASE("Paths should respect navigation layers and links") {
+			navigation_server->region_set_navigation_layers(regions[1], 2);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			path = navigation_server->map_get_path(map, start, end, true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].x < SIZE_X + 0.5);
+
+			// A link over the middle region joins the clusters at its ends.
+			RID link = navigation_server->link_create();
+			navigation_server->link_set_map(link, map);
+			navigation_server->link_set_start_position(link, Vector3(SIZE_X - 0.5, 0, 0.5));
+			navigation_server->link_set_end_position(link, Vector3(SIZE_X * 2 + 0.5, 0, 0.5));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			path = navigation_server->map_get_path(map, start, end, true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].is_equal_approx(end));
+
+			// Layers of the link are respected as well.
+			navigation_server->link_set_navigation_layers(link, 2);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			path = navigation_server->map_get_path(map, start, end, true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].x < SIZE_X + 0.5);
+
+			navigation_server->free(link);
+		}
+
+		SUBCASE("Clusters should be updated when regions change") {
+			navigation_server->free(regions[1]);
+			regions[1] = RID();
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			path = navigation_server->map_get_path(map, start, end, true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].x < SIZE_X + 0.5);
+
+			regions[1] = navigation_server->region_create();
+			navigation_server->region_set_map(regions[1], map);
+			navigation_server->region_set_transform(regions[1], Transform3D(Basis(), Vector3(SIZE_X, 0, 0)));
+			navigation_server->region_set_navigation_mesh(regions[1], navigation_mesh);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			path = navigation_server->map_get_path(map, start, end, true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].is_equal_approx(end));
+		}
+
+		for (int i = 0; i < 3; i++) {
+			if (regions[i].is_valid()) {
+				navigation_server->free(regions[i]);
+			}
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
 	/*
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
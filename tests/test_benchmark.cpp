@@ -0,0 +1,169 @@
+/**************************************************************************/
+/*  test_benchmark.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_benchmark.h"
+
+#include "core/config/engine.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/string/print_string.h"
+#include "core/templates/sort_array.h"
+
+bool Benchmark::enabled = false;
+uint64_t Benchmark::warmup_usec = 50000;
+uint64_t Benchmark::sample_usec = 10000;
+int Benchmark::sample_count = 15;
+String Benchmark::output_path;
+LocalVector<Benchmark::Result> Benchmark::results;
+
+List<String> Benchmark::parse_arguments(const List<String> &p_args) {
+	List<String> forwarded;
+
+	for (const List<String>::Element *E = p_args.front(); E; E = E->next()) {
+		const String &arg = E->get();
+		if (arg == "--benchmark") {
+			enabled = true;
+		} else if (arg == "--benchmark-json" && E->next()) {
+			E = E->next();
+			output_path = E->get();
+		} else if (arg == "--benchmark-samples" && E->next()) {
+			E = E->next();
+			sample_count = MAX(1, E->get().to_int());
+		} else if (arg == "--benchmark-sample-usec" && E->next()) {
+			E = E->next();
+			sample_usec = MAX(1, E->get().to_int());
+		} else if (arg == "--benchmark-warmup-usec" && E->next()) {
+			E = E->next();
+			warmup_usec = MAX(0, E->get().to_int());
+		} else {
+			forwarded.push_back(arg);
+		}
+	}
+
+	if (enabled) {
+		// `--no-skip` unskips every test, so only the benchmark suites may be selected, also when
+		// the caller gives their own suite filter. Test case filters are applied on top of it by doctest.
+		bool has_suite_filter = false;
+		for (String &arg : forwarded) {
+			const String prefix = arg.begins_with("-ts=") ? "-ts=" : (arg.begins_with("--test-suite=") ? "--test-suite=" : "");
+			if (prefix.is_empty()) {
+				continue;
+			}
+			has_suite_filter = true;
+			Vector<String> patterns = arg.substr(prefix.length()).split(",", false);
+			for (String &pattern : patterns) {
+				if (!pattern.contains("[Benchmark]")) {
+					// Benchmark suite names always start with it, see BENCHMARK_SUITE().
+					pattern = "[Benchmark]" + pattern;
+				}
+			}
+			arg = prefix + String(",").join(patterns);
+		}
+		if (!has_suite_filter) {
+			forwarded.push_back("--test-suite=*[Benchmark]*");
+		}
+		forwarded.push_back("--no-skip=true");
+	}
+	return forwarded;
+}
+
+void Benchmark::_add_result(const String &p_name, uint64_t p_iterations, LocalVector<uint64_t> &p_samples) {
+	SortArray<uint64_t> sorter;
+	sorter.sort(p_samples.ptr(), p_samples.size());
+
+	// Convert microseconds per sample to nanoseconds per iteration.
+	const double scale = 1000.0 / p_iterations;
+	const int count = p_samples.size();
+
+	Result result;
+	result.name = p_name;
+	result.iterations = p_iterations;
+	result.samples = count;
+	result.min = p_samples[0] * scale;
+	result.max = p_samples[count - 1] * scale;
+	result.median = (count % 2 ? p_samples[count / 2] : (p_samples[count / 2 - 1] + p_samples[count / 2]) * 0.5) * scale;
+
+	double sum = 0.0;
+	for (uint64_t sample : p_samples) {
+		sum += sample * scale;
+	}
+	result.mean = sum / count;
+
+	double variance = 0.0;
+	for (uint64_t sample : p_samples) {
+		const double delta = sample * scale - result.mean;
+		variance += delta * delta;
+	}
+	result.stddev = count > 1 ? Math::sqrt(variance / (count - 1)) : 0.0;
+
+	print_line(vformat("%-64s %12.1f ns (median) %12.1f ns (min) %6.1f%% (stddev)", p_name, result.median, result.min, result.mean > 0.0 ? result.stddev * 100.0 / result.mean : 0.0));
+	results.push_back(result);
+}
+
+void Benchmark::print_summary() {
+	print_line(vformat("%d benchmarks, %d samples each.", (int)results.size(), sample_count));
+}
+
+Error Benchmark::save_results() {
+	if (output_path.is_empty()) {
+		return OK;
+	}
+
+	Array benchmarks;
+	for (const Result &result : results) {
+		Dictionary entry;
+		entry["name"] = result.name;
+		entry["iterations"] = result.iterations;
+		entry["samples"] = result.samples;
+		entry["min_nsec"] = result.min;
+		entry["median_nsec"] = result.median;
+		entry["mean_nsec"] = result.mean;
+		entry["max_nsec"] = result.max;
+		entry["stddev_nsec"] = result.stddev;
+		benchmarks.push_back(entry);
+	}
+
+	Dictionary data;
+	data["version"] = Engine::get_singleton()->get_version_info()["string"];
+	data["processor_name"] = OS::get_singleton()->get_processor_name();
+	data["processor_count"] = OS::get_singleton()->get_processor_count();
+#ifdef SMALL_ALLOCATOR_ENABLED
+	data["small_allocator"] = true;
+#else
+	data["small_allocator"] = false;
+#endif
+	data["benchmarks"] = benchmarks;
+
+	Ref<FileAccess> f = FileAccess::open(output_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_WRITE, "Cannot write benchmark results to: " + output_path);
+	f->store_string(JSON::stringify(data, "\t", false));
+	print_line("Benchmark results saved to: " + output_path);
+	return OK;
+}
@@ -0,0 +1,125 @@
+/**************************************************************************/
+/*  test_benchmark.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BENCHMARK_H
+#define TEST_BENCHMARK_H
+
+#include "core/os/os.h"
+#include "core/string/ustring.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+
+// Benchmarks are regular doctest cases inside a suite declared with BENCHMARK_SUITE().
+// These suites are skipped by default, and are the only ones run with `--test --benchmark`,
+// also when `--test-suite` or `--test-case` filters are given.
+// Inside a case, each call to `Benchmark::run()` warms the function up, picks an iteration
+// count so that a sample lasts at least `--benchmark-sample-usec`, then takes
+// `--benchmark-samples` samples. Results are printed as they come in, and saved in JSON
+// format with `--benchmark-json <path>`.
+//
+// Example usage: `godot --headless --test --benchmark --benchmark-json results.json`.
+
+class Benchmark {
+public:
+	struct Result {
+		String name;
+		uint64_t iterations = 0; // Per sample.
+		int samples = 0;
+		// Per iteration, in nanoseconds.
+		double min = 0.0;
+		double median = 0.0;
+		double mean = 0.0;
+		double max = 0.0;
+		double stddev = 0.0;
+	};
+
+private:
+	static bool enabled;
+	static uint64_t warmup_usec;
+	static uint64_t sample_usec;
+	static int sample_count;
+	static String output_path;
+	static LocalVector<Result> results;
+
+	static void _add_result(const String &p_name, uint64_t p_iterations, LocalVector<uint64_t> &p_samples);
+
+public:
+	// Parses the benchmark options, returns the arguments that should be forwarded to doctest.
+	static List<String> parse_arguments(const List<String> &p_args);
+	static bool is_enabled() { return enabled; }
+
+	template <typename F>
+	static void run(const String &p_name, F &&p_func) {
+		OS *os = OS::get_singleton();
+
+		// Warm up caches and allocators, and estimate the cost of one iteration.
+		uint64_t iterations = 0;
+		uint64_t elapsed = 0;
+		const uint64_t begin = os->get_ticks_usec();
+		do {
+			p_func();
+			iterations++;
+			elapsed = os->get_ticks_usec() - begin;
+		} while (elapsed < warmup_usec);
+
+		const uint64_t per_sample = MAX<uint64_t>(1, iterations * sample_usec / MAX<uint64_t>(1, elapsed));
+
+		LocalVector<uint64_t> samples;
+		samples.resize(sample_count);
+		for (int i = 0; i < sample_count; i++) {
+			const uint64_t sample_begin = os->get_ticks_usec();
+			for (uint64_t j = 0; j < per_sample; j++) {
+				p_func();
+			}
+			samples[i] = os->get_ticks_usec() - sample_begin;
+		}
+
+		_add_result(p_name, per_sample, samples);
+	}
+
+	// Prevents the compiler from optimizing away the computation of `p_value`.
+	template <typename T>
+	static _FORCE_INLINE_ void keep(const T &p_value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "g"(&p_value) : "memory");
+#else
+		static const void *volatile sink;
+		sink = &p_value;
+#endif
+	}
+
+	static const LocalVector<Result> &get_results() { return results; }
+	static void print_summary();
+	static Error save_results();
+};
+
+#define BENCHMARK_SUITE(m_name) TEST_SUITE("[Benchmark]" m_name * doctest::skip())
+
+#endif // TEST_BENCHMARK_H
@@ -35,11 +35,18 @@
 #include "editor/editor_settings.h"
 #endif // TOOLS_ENABLED
 
+#include "tests/benchmarks/benchmark_image.h"
+#include "tests/benchmarks/benchmark_io.h"
+#include "tests/benchmarks/benchmark_memory.h"
+#include "tests/benchmarks/benchmark_physics.h"
+#include "tests/benchmarks/benchmark_templates.h"
+#include "tests/benchmarks/benchmark_variant.h"
 #include "tests/core/config/test_project_settings.h"
 #include "tests/core/input/test_input_event.h"
 #include "tests/core/input/test_input_event_key.h"
 #include "tests/core/input/test_input_event_mouse.h"
 #include "tests/core/input/test_shortcut.h"
+#include "tests/core/io/test_compression.h"
 #include "tests/core/io/test_config_file.h"
 #include "tests/core/io/test_file_access.h"
 #include "tests/core/io/test_http_client.h"
@@ -75,11 +82,13 @@
 #include "tests/core/object/test_method_bind.h"
 #include "tests/core/object/test_object.h"
 #include "tests/core/object/test_undo_redo.h"
+#include "tests/core/os/test_memory.h"
 #include "tests/core/os/test_os.h"
 #include "tests/core/string/test_node_path.h"
 #include "tests/core/string/test_string.h"
 #include "tests/core/string/test_translation.h"
 #include "tests/core/string/test_translation_server.h"
+#include "tests/core/templates/test_a_hash_map.h"
 #include "tests/core/templates/test_command_queue.h"
 #include "tests/core/templates/test_hash_map.h"
 #include "tests/core/templates/test_hash_set.h"
@@ -126,6 +135,7 @@
 #include "tests/test_validate_testing.h"
 
 #ifndef _3D_DISABLED
+#include "tests/benchmarks/benchmark_navigation.h"
 #include "tests/scene/test_arraymesh.h"
 #include "tests/scene/test_camera_3d.h"
 #include "tests/scene/test_navigation_agent_2d.h"
@@ -143,6 +153,7 @@
 #include "modules/modules_tests.gen.h"
 
 #include "tests/display_server_mock.h"
+#include "tests/test_benchmark.h"
 #include "tests/test_macros.h"
 
 #include "scene/theme/theme_db.h"
@@ -196,6 +207,7 @@ int test_main(int argc, char *argv[]) {
 			test_args.push_back(arg);
 		}
 	}
+	test_args = Benchmark::parse_arguments(test_args);
 
 	if (test_args.size() > 0) {
 		// Convert Godot command line arguments back to standard arguments.
@@ -218,7 +230,14 @@ int test_main(int argc, char *argv[]) {
 		delete[] doctest_args;
 	}
 
-	return test_context.run();
+	int status = test_context.run();
+	if (Benchmark::is_enabled()) {
+		Benchmark::print_summary();
+		if (Benchmark::save_results() != OK) {
+			status = EXIT_FAILURE;
+		}
+	}
+	return status;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////